@@ -75,6 +75,18 @@ ThingsBoard thingsboard  = {};
 
 Audio audio(true, I2S_DAC_CHANNEL_BOTH_EN);
 
+// Messwerte nur senden, wenn sie sich spürbar geändert haben, spätestens aber jede Minute
+static const TelemetryFilterRule telemetry_rules[] = {
+  /* key            absolut relativ  min. ms  max. ms */
+  {"hall",          5,      0,       1000,    60000},
+  {"temperature",   0.1,    0,       1000,    60000},
+  {"pressure",      0.5,    0,       1000,    60000},
+  {"altitude",      1,      0,       1000,    60000},
+  {"audio_dropouts", 1,     0,       1000,    60000},
+};
+
+TelemetryFilter telemetry_filter(telemetry_rules, sizeof(telemetry_rules) / sizeof(telemetry_rules[0]));
+
 bool measurement_enabled = true;
 bool warning_signal = false;
 
@@ -131,12 +143,17 @@ void setup() {
   xTaskCreate(
     /* pcTaskCode    */  warning_task,
     /* pcName        */  "Warnsignal ausgeben",
-    /* uxStackDepth  */  4096,
+    /* uxStackDepth  */  8192,  // playSpeech() lädt die Sprachausgabe in diesem Task herunter
     /* pvParameters  */  NULL,
     /* uxPriority    */  2,
     /* pxCreatedTask */  NULL
   );
 
+  // Audiodaten in einem eigenen Task aus dem Netzwerk lesen, damit blockierende MQTT-Aufrufe
+  // in thingsboard.loop() den Eingangspuffer der Audio-Bibliothek nicht leerlaufen lassen.
+  // audio.loop() kehrt dann sofort zurück, kann aber stehen bleiben.
+  audio.setNetworkTaskCore(0);
+
   // Kleine Statusmeldung ausgeben
   audio.setVolume(21);  // Maximum: 21
   audio.connecttospeech("Alles klar. Es kann los gehen!", "de");
@@ -197,12 +214,13 @@ void measurement_task(void *pvParameters) {
     values["temperature"] = bmp.readTemperature();       // °C
     values["pressure"]    = bmp.readPressure() / 100;    // hPa
     values["altitude"]    = bmp.readAltitude(1013.25);   // m, Wert muss an den Standort angepasst werden
+    values["audio_dropouts"] = audio.getInBuffUnderruns() + audio.getI2SUnderruns();  // sollte 0 bleiben
 
     String values_s;
     serializeJson(values, values_s);
     ESP_LOGI(TAG, "Aktuelle Messwerte: %s", values_s.c_str());
 
-    thingsboard.send_telemetry(values);
+    thingsboard.send_telemetry(values, telemetry_filter);
   }  
 }
 
@@ -212,8 +230,10 @@ void warning_task(void *pvParameters) {
     delay(1000);
     if (!warning_signal) continue;
 
+    // Die Warnung läuft über den Mixer der Audio-Bibliothek: Ein gerade laufender Stream wird
+    // währenddessen nur leiser gestellt, statt wie bei connecttospeech() abgebrochen zu werden.
     ESP_LOGW(TAG, "Achtung, Lebensgefahr. Alle sofort dem Raum verlassen!");
-    audio.connecttospeech("Achtung, Lebensgefahr. Alle sofort dem Raum verlassen!", "de");
-    delay(4000);
+    audio.playSpeech("Achtung, Lebensgefahr. Alle sofort dem Raum verlassen!", "de");
+    while (audio.isSpeaking()) delay(100);
   }
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+// Ersatz für PubSubClient, nur für host_test. Gesendete Nachrichten werden in `published`
+// gesammelt, `write_calls` zählt die Aufrufe von write() während beginPublish()/endPublish().
+// `instance` zeigt auf den zuletzt erzeugten Client, damit der Test Nachrichten zustellen kann.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "WiFi.h"
+
+typedef uint8_t byte;
+
+#define MQTT_CONNECTION_TIMEOUT     -4
+#define MQTT_CONNECTION_LOST        -3
+#define MQTT_CONNECT_FAILED         -2
+#define MQTT_DISCONNECTED           -1
+#define MQTT_CONNECTED               0
+#define MQTT_CONNECT_BAD_PROTOCOL    1
+#define MQTT_CONNECT_BAD_CLIENT_ID   2
+#define MQTT_CONNECT_UNAVAILABLE     3
+#define MQTT_CONNECT_BAD_CREDENTIALS 4
+#define MQTT_CONNECT_UNAUTHORIZED    5
+
+class PubSubClient {
+  public:
+    struct Message {
+      std::string topic;
+      std::string payload;
+    };
+
+    std::function<void(char*, uint8_t*, unsigned int)> callback;
+    std::vector<Message> published;
+    size_t write_calls = 0;
+
+    void receive(char *topic, char *payload) {
+      this->callback(topic, (uint8_t*) payload, strlen(payload));
+    }
+
+    static inline PubSubClient *instance = 0;
+
+    PubSubClient(WiFiClient&) { instance = this; }
+
+    void setSocketTimeout(uint16_t) {}
+    bool setBufferSize(uint16_t) { return true; }
+    void setCallback(std::function<void(char*, uint8_t*, unsigned int)> cb) { this->callback = cb; }
+    void setServer(const char*, uint16_t) {}
+    bool connect(const char*, const char*, const char*) { return true; }
+    bool connected() { return true; }
+    void disconnect() {}
+    int  state() { return MQTT_CONNECTED; }
+    bool subscribe(const char*) { return true; }
+    bool loop() { return true; }
+
+    bool publish(const char *topic, const char *payload) {
+      this->published.push_back({topic, payload});
+      return true;
+    }
+
+    bool beginPublish(const char *topic, unsigned int length, bool) {
+      this->published.push_back({topic, ""});
+      this->m_expected = length;
+      return true;
+    }
+
+    size_t write(uint8_t c) {
+      return this->write(&c, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) {
+      this->write_calls++;
+      this->published.back().payload.append((const char*) buffer, size);
+      return size;
+    }
+
+    int endPublish() {
+      return this->published.back().payload.size() == this->m_expected;
+    }
+
+  private:
+    size_t m_expected = 0;
+};
@@ -0,0 +1,23 @@
+// Ersatz für WiFi.h, nur für host_test
+#pragma once
+
+#include <string>
+
+struct String {
+  std::string value;
+  String(const char *s = "") : value(s) {}
+  const char* c_str() const { return value.c_str(); }
+};
+
+struct WiFiClient {};
+
+struct WiFiClass {
+  String macAddress() { return "00:00:00:00:00:00"; }
+};
+
+static WiFiClass WiFi;
+
+// Die Zeit wird vom Test vorgegeben
+extern unsigned long host_millis;
+inline unsigned long millis() { return host_millis; }
+inline void delay(unsigned long ms) { host_millis += ms; }
@@ -0,0 +1,9 @@
+// Ersatz für esp_log.h, nur für host_test
+#pragma once
+
+#include <cstdio>
+
+#define ESP_LOGE(tag, format, ...) fprintf(stderr, "E %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) fprintf(stderr, "W %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) do {} while (0)
+#define ESP_LOGD(tag, format, ...) do {} while (0)
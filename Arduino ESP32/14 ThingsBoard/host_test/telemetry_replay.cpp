@@ -0,0 +1,135 @@
+/**
+ * Wiedergabe von Telemetriedaten durch TelemetryFilter
+ * ====================================================
+ *
+ * Schickt eine Messreihe einmal ungefiltert und einmal mit den Filterregeln aus
+ * ThingsBoard-Beispiel-Komplett über send_telemetry() und vergleicht die Anzahl und Größe
+ * der gesendeten Nachrichten.
+ *
+ *   telemetry_replay [messreihe.csv]
+ *
+ * Die CSV-Datei beginnt mit einer Kopfzeile `ms,<key>,<key>,...`, danach folgt eine Zeile je
+ * Messung mit dem Zeitpunkt in Millisekunden und den Werten, so wie sie measurement_task()
+ * in einem JSON-Dokument sammelt. Ohne Datei wird eine künstliche Messreihe verwendet: eine
+ * Stunde lang jede Sekunde Hall-Sensor, Temperatur, Luftdruck und Höhe mit dem Rauschen der
+ * echten Sensoren.
+ */
+
+#include <thingsboard.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+unsigned long host_millis = 0;
+
+static const TelemetryFilterRule telemetry_rules[] = {
+  /* key            absolut relativ  min. ms  max. ms */
+  {"hall",          5,      0,       1000,    60000},
+  {"temperature",   0.1,    0,       1000,    60000},
+  {"pressure",      0.5,    0,       1000,    60000},
+  {"altitude",      1,      0,       1000,    60000},
+  {"audio_dropouts", 1,     0,       1000,    60000},
+};
+
+struct Trace {
+  std::vector<std::string>         keys;
+  std::vector<unsigned long>       times;
+  std::vector<std::vector<double>> values;
+};
+
+static bool read_trace(const char *path, Trace &trace) {
+  FILE *file = fopen(path, "r");
+  if (!file) return false;
+
+  char line[1024];
+  bool header = true;
+
+  while (fgets(line, sizeof(line), file)) {
+    std::vector<std::string> fields;
+    for (char *field = strtok(line, ",\r\n"); field; field = strtok(0, ",\r\n")) fields.push_back(field);
+    if (fields.size() < 2) continue;
+
+    if (header) {
+      trace.keys.assign(fields.begin() + 1, fields.end());
+      header = false;
+      continue;
+    }
+
+    trace.times.push_back(strtoul(fields[0].c_str(), 0, 10));
+    std::vector<double> row;
+    for (size_t i = 1; i < fields.size() && i <= trace.keys.size(); i++) row.push_back(atof(fields[i].c_str()));
+    row.resize(trace.keys.size(), 0);
+    trace.values.push_back(row);
+  }
+
+  fclose(file);
+  return !trace.times.empty();
+}
+
+static double noise(double amplitude) {
+  return amplitude * (2.0 * rand() / RAND_MAX - 1.0);
+}
+
+static void synthetic_trace(Trace &trace) {
+  trace.keys = {"hall", "temperature", "pressure", "altitude", "audio_dropouts"};
+  srand(1);
+
+  for (unsigned long s = 0; s < 3600; s++) {
+    double temperature = 21.0 + 1.5 * s / 3600 + noise(0.02);  // Heizung läuft langsam an
+    double pressure    = 1013.0 - 0.8 * s / 3600 + noise(0.06); // Luftdruck fällt leicht
+    double altitude    = 44330.0 * (1.0 - pow(pressure / 1013.25, 0.1903));
+    double hall        = (s >= 1200 && s < 1500 ? 60 : 20) + noise(8); // Magnet für fünf Minuten in der Nähe
+
+    trace.times.push_back(s * 1000);
+    trace.values.push_back({round(hall), temperature, pressure, altitude, 0});
+  }
+}
+
+static void replay(const Trace &trace, TelemetryFilter *filter, size_t &messages, size_t &bytes) {
+  ThingsBoard thingsboard("telemetry_replay");
+  PubSubClient *client = PubSubClient::instance;
+
+  for (size_t i = 0; i < trace.times.size(); i++) {
+    host_millis = trace.times[i];
+
+    JsonDocument values;
+    for (size_t k = 0; k < trace.keys.size(); k++) values[trace.keys[k]] = trace.values[i][k];
+
+    if (filter) thingsboard.send_telemetry(values, *filter);
+    else thingsboard.send_telemetry(values);
+  }
+
+  messages = client->published.size();
+  bytes = 0;
+  for (const PubSubClient::Message &message : client->published) bytes += message.payload.size();
+}
+
+int main(int argc, char **argv) {
+  Trace trace;
+
+  if (argc > 1) {
+    if (!read_trace(argv[1], trace)) {
+      fprintf(stderr, "Messreihe %s nicht lesbar\n", argv[1]);
+      return 1;
+    }
+  } else {
+    synthetic_trace(trace);
+  }
+
+  TelemetryFilter filter(telemetry_rules, sizeof(telemetry_rules) / sizeof(telemetry_rules[0]));
+
+  size_t messages = 0, bytes = 0, filtered_messages = 0, filtered_bytes = 0;
+  replay(trace, 0, messages, bytes);
+  replay(trace, &filter, filtered_messages, filtered_bytes);
+
+  printf("Messungen:          %zu (%s)\n", trace.times.size(), argc > 1 ? argv[1] : "künstliche Messreihe");
+  printf("ohne Filter:        %zu Nachrichten, %zu Bytes\n", messages, bytes);
+  printf("mit Filter:         %zu Nachrichten, %zu Bytes\n", filtered_messages, filtered_bytes);
+  printf("Werte gesendet:     %u, verworfen: %u\n", filter.passed(), filter.dropped());
+  printf("Einsparung:         %.1f %% der Nachrichten, %.1f %% der Bytes\n",
+         100.0 - 100.0 * filtered_messages / messages, 100.0 - 100.0 * filtered_bytes / bytes);
+  return 0;
+}
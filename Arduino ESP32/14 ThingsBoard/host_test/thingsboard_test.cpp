@@ -0,0 +1,262 @@
+/**
+ * Test für thingsboard.h auf einem Linux-Rechner
+ * ==============================================
+ *
+ * Prüft, dass empfangene Nachrichten ohne Heap-Speicher verarbeitet werden. Dazu werden alle
+ * Aufrufe von malloc(), calloc() und realloc() gezählt, während die Nachrichten zugestellt
+ * werden (auch `new` landet in malloc()). Außerdem wird die Speicherverwaltung ArenaAllocator
+ * direkt geprüft, ebenso das Senden großer Nachrichten in Blöcken. Bauen und Ausführen siehe
+ * CMakeLists.txt.
+ */
+
+#include <thingsboard.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+unsigned long host_millis = 0;
+
+/**
+ * Zählen der Speicheranforderungen über die internen Funktionen der glibc
+ */
+extern "C" {
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t count, size_t size);
+  void* __libc_realloc(void *ptr, size_t size);
+
+  static bool   count_allocations = false;
+  static size_t allocations       = 0;
+
+  void* malloc(size_t size) {
+    if (count_allocations) allocations++;
+    return __libc_malloc(size);
+  }
+
+  void* calloc(size_t count, size_t size) {
+    if (count_allocations) allocations++;
+    return __libc_calloc(count, size);
+  }
+
+  void* realloc(void *ptr, size_t size) {
+    if (count_allocations) allocations++;
+    return __libc_realloc(ptr, size);
+  }
+}
+
+static int failures = 0;
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      fprintf(stderr, "%s:%i: %s\n", __FILE__, __LINE__, #condition); \
+      failures++; \
+    } \
+  } while (0)
+
+static bool filled(const void *ptr, uint8_t value, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    if (((const uint8_t*) ptr)[i] != value) return false;
+  }
+  return true;
+}
+
+/**
+ * Ein Block vor dem zuletzt reservierten Block darf nicht an Ort und Stelle wachsen,
+ * da er sonst die nachfolgenden Blöcke überschreibt.
+ */
+static void test_arena_allocator() {
+  static ArenaAllocator<256> arena;
+
+  void *a = arena.allocate(16);
+  void *b = arena.allocate(16);
+  CHECK(a && b);
+  memset(a, 'a', 16);
+  memset(b, 'b', 16);
+
+  void *c = arena.reallocate(a, 24);
+  CHECK(c && c != a);
+  CHECK(filled(c, 'a', 16));
+  memset(c, 'c', 24);
+  CHECK(filled(b, 'b', 16));
+
+  // Verkleinern geht immer an Ort und Stelle
+  CHECK(arena.reallocate(b, 8) == b);
+  CHECK(filled(b, 'b', 8));
+
+  // Der letzte Block wächst an Ort und Stelle
+  void *d = arena.allocate(8);
+  memset(d, 'd', 8);
+  CHECK(arena.reallocate(d, 40) == d);
+  CHECK(filled(d, 'd', 8));
+
+  // Kein Platz mehr
+  CHECK(arena.allocate(256) == 0);
+  CHECK(arena.reallocate(d, 1000) == 0);
+  CHECK(arena.reallocate(b, 1000) == 0);
+  CHECK(filled(b, 'b', 8));
+
+  arena.reset();
+  CHECK(arena.allocate(200) != 0);
+}
+
+/**
+ * Ergebnisse der Callback-Funktionen, ohne Heap-Speicher
+ */
+static int  rpc_request_id = 0;
+static char rpc_method[32];
+static int  rpc_pin = 0;
+static bool rpc_value = false;
+static char rpc_label[128];
+static int  attribute_calls = 0;
+static int  attribute_errors = 0;
+static int  attribute_interval = 0;
+static int  rpc_response_id = 0;
+static int  rpc_response_value = 0;
+static char gateway_device[32];
+static int  gateway_request_id = 0;
+
+static const int ATTRIBUTE_KEYS = 16;
+
+static void on_rpc_request(int request_id, const char *method, JsonObject parameters) {
+  rpc_request_id = request_id;
+  snprintf(rpc_method, sizeof(rpc_method), "%s", method);
+  rpc_pin   = parameters["pin"];
+  rpc_value = parameters["value"];
+  snprintf(rpc_label, sizeof(rpc_label), "%s", (const char*) parameters["label"]);
+}
+
+static void on_attribute_values(JsonObject values) {
+  attribute_calls++;
+
+  if (values["interval"].is<int>()) {
+    attribute_interval = values["interval"];
+    return;
+  }
+
+  char key[8], expected[48];
+
+  for (int i = 0; i < ATTRIBUTE_KEYS; i++) {
+    snprintf(key, sizeof(key), "k%i", i);
+    snprintf(expected, sizeof(expected), "Wert Nummer %i mit etwas Text dahinter", i);
+
+    const char *value = values[key];
+    if (!value || strcmp(value, expected) != 0) attribute_errors++;
+  }
+}
+
+static void on_rpc_response(int request_id, JsonVariant values) {
+  rpc_response_id    = request_id;
+  rpc_response_value = values["value"];
+}
+
+static void on_gateway_rpc_request(const char *device, int request_id, const char*, JsonObject) {
+  snprintf(gateway_device, sizeof(gateway_device), "%s", device);
+  gateway_request_id = request_id;
+}
+
+/**
+ * Eine Nachricht zustellen und die dabei angeforderten Speicherblöcke zählen
+ */
+static size_t deliver(PubSubClient *client, const char *topic, const char *payload) {
+  static char topic_buffer[128];
+  static char payload_buffer[4096];
+  snprintf(topic_buffer, sizeof(topic_buffer), "%s", topic);
+  snprintf(payload_buffer, sizeof(payload_buffer), "%s", payload);
+
+  allocations = 0;
+  count_allocations = true;
+  client->receive(topic_buffer, payload_buffer);
+  count_allocations = false;
+  return allocations;
+}
+
+static void test_receive_without_heap() {
+  static ThingsBoard thingsboard("host_test");
+  thingsboard.subscribe_rpc_request(on_rpc_request);
+  thingsboard.subscribe_attribute_values(on_attribute_values);
+  thingsboard.subscribe_rpc_response(on_rpc_response);
+  thingsboard.subscribe_gateway_rpc_request(on_gateway_rpc_request);
+
+  PubSubClient *client = PubSubClient::instance;
+
+  CHECK(deliver(client, "v1/devices/me/rpc/request/42",
+    "{\"method\":\"setGpio\",\"params\":{\"pin\":4,\"value\":true,"
+    "\"label\":\"Eine etwas längere Zeichenkette, die beim Parsen kopiert werden muss\"}}") == 0);
+  CHECK(rpc_request_id == 42);
+  CHECK(strcmp(rpc_method, "setGpio") == 0);
+  CHECK(rpc_pin == 4);
+  CHECK(rpc_value);
+  CHECK(strcmp(rpc_label, "Eine etwas längere Zeichenkette, die beim Parsen kopiert werden muss") == 0);
+
+  // Viele Schlüssel und Zeichenketten, die ArduinoJson nacheinander im Puffer anlegt
+  static char attributes[4096];
+  size_t length = snprintf(attributes, sizeof(attributes), "{");
+  for (int i = 0; i < ATTRIBUTE_KEYS; i++) {
+    length += snprintf(attributes + length, sizeof(attributes) - length,
+                       "%s\"k%i\":\"Wert Nummer %i mit etwas Text dahinter\"", i ? "," : "", i, i);
+  }
+  snprintf(attributes + length, sizeof(attributes) - length, "}");
+
+  CHECK(deliver(client, "v1/devices/me/attributes", attributes) == 0);
+  CHECK(attribute_calls == 1);
+  CHECK(attribute_errors == 0);
+
+  CHECK(deliver(client, "v1/devices/me/attributes/response/1", "{\"shared\":{\"interval\":500}}") == 0);
+  CHECK(attribute_calls == 2);
+  CHECK(attribute_interval == 500);
+
+  CHECK(deliver(client, "v1/devices/me/rpc/response/7", "{\"value\":23}") == 0);
+  CHECK(rpc_response_id == 7);
+  CHECK(rpc_response_value == 23);
+
+  CHECK(deliver(client, "v1/gateway/rpc",
+    "{\"device\":\"Sensor 1\",\"data\":{\"id\":9,\"method\":\"reset\",\"params\":{}}}") == 0);
+  CHECK(strcmp(gateway_device, "Sensor 1") == 0);
+  CHECK(gateway_request_id == 9);
+
+  // Fehlerhafte Nachrichten werden verworfen, ebenfalls ohne Heap-Speicher
+  CHECK(deliver(client, "v1/devices/me/rpc/request/43", "{\"method\":") == 0);
+  CHECK(rpc_request_id == 42);
+}
+
+/**
+ * Große Nachrichten werden in Blöcken von TX_CHUNK_SIZE Bytes geschrieben und nicht Zeichen
+ * für Zeichen.
+ */
+static void test_publish_in_chunks() {
+  static ThingsBoard thingsboard("host_test");
+  PubSubClient *client = PubSubClient::instance;
+
+  JsonDocument parameters;
+  parameters["text"] = std::string(1000, 'x');
+
+  client->published.clear();
+  client->write_calls = 0;
+  CHECK(thingsboard.send_rpc_request("log", parameters) == 1);
+  CHECK(client->published.size() == 1);
+
+  JsonDocument expected;
+  expected["method"] = "log";
+  expected["params"] = parameters;
+  std::string payload;
+  serializeJson(expected, payload);
+
+  CHECK(client->published[0].topic == "v1/devices/me/rpc/request/1");
+  CHECK(client->published[0].payload == payload);
+  CHECK(client->write_calls == (payload.size() + TX_CHUNK_SIZE - 1) / TX_CHUNK_SIZE);
+}
+
+int main() {
+  test_arena_allocator();
+  test_receive_without_heap();
+  test_publish_in_chunks();
+
+  if (failures) {
+    fprintf(stderr, "%i Fehler\n", failures);
+    return 1;
+  }
+
+  printf("Alle Tests bestanden\n");
+  return 0;
+}
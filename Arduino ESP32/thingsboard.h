@@ -5,11 +5,12 @@
  * Diese Header-Datei stellt einen einfache Klasse zur Verbindung mit einem ThingsBoard-Server
  * via MQTT zur Verfügung. Sie unterstützt dabei folgende Funktionen:
  *
- *  - Senden von Telemetriedaten
+ *  - Senden von Telemetriedaten, optional gefiltert mit Totband und Sendeintervallen
  *  - Senden von Attributen
- *  - Senden von RPC-Anfragen
+ *  - Senden von RPC-Anfragen mit Zuordnung der Antworten und Timeout
  *  - Empfangen von Attributen
  *  - Empfangen von RPC-Anfragen
+ *  - Gateway-Modus für mehrere untergeordnete Geräte über eine Verbindung
  *
  * Benötigte Bibliotheken
  * ----------------------
@@ -27,14 +28,223 @@
 #include <WiFi.h>
 #include <esp_log.h>
 #include <cstring>
+#include <cmath>
 
 #define TAG "ThingsBoard"
 
-static const size_t BUFFER_SIZE = 128;
+static const size_t BUFFER_SIZE      = 128;
+static const size_t MQTT_BUFFER_SIZE = 1024;
+static const size_t RX_ARENA_SIZE    = 4096;
+static const size_t TX_CHUNK_SIZE    = 256;
+
+static const size_t        TELEMETRY_FILTER_MAX_KEYS = 16;
+
+static const size_t        RPC_MAX_PENDING         = 8;
+static const unsigned long RPC_DEFAULT_TIMEOUT_MS  = 10000;
+static const size_t        RPC_LATENCY_BUCKETS     = 8;
+static const unsigned long RPC_LATENCY_BOUNDS_MS[] = {50, 100, 200, 500, 1000, 2000, 5000};
 
 typedef void (*on_attribute_values_t)(JsonObject values);
 typedef void (*on_rpc_request_t)(int request_id, const char *method, JsonObject parameters);
-typedef void (*on_rpc_response_t)(int request_id, JsonDocument values);
+typedef void (*on_rpc_response_t)(int request_id, JsonVariant values);
+typedef void (*on_rpc_result_t)(int request_id, bool success, JsonVariant values);
+typedef void (*on_gateway_attribute_values_t)(const char *device, JsonObject values);
+typedef void (*on_gateway_rpc_request_t)(const char *device, int request_id, const char *method, JsonObject parameters);
+
+/**
+ * Statistik zu den vom Client gesendeten RPC-Anfragen. Die Antwortzeiten werden als
+ * Histogramm gezählt, wobei Eintrag `i` alle Antworten unterhalb von `RPC_LATENCY_BOUNDS_MS[i]`
+ * enthält, die nicht schon in einen vorherigen Eintrag fallen. Der letzte Eintrag zählt
+ * alle langsameren Antworten.
+ */
+struct RpcStatistics {
+  uint32_t sent        = 0;
+  uint32_t completed   = 0;
+  uint32_t timed_out   = 0;
+  uint32_t rejected    = 0;
+  uint32_t unmatched   = 0;
+  uint32_t latency_histogram[RPC_LATENCY_BUCKETS] = {};
+};
+
+/**
+ * Speicherverwaltung für ArduinoJson auf Basis eines festen Puffers. Damit können empfangene
+ * Nachrichten ohne Heap-Speicher verarbeitet werden. Einzelne Blöcke werden nicht freigegeben,
+ * stattdessen wird vor jeder neuen Nachricht der komplette Puffer mit `reset()` geleert.
+ * Lediglich der zuletzt reservierte Block kann noch an Ort und Stelle vergrößert werden, da
+ * ArduinoJson Zeichenketten auf diese Weise aufbaut. Jeder Block merkt sich hierfür seine
+ * Größe in einem kleinen Kopf vor den Nutzdaten. Andere Blöcke werden beim Vergrößern an das
+ * Ende des Puffers kopiert.
+ */
+template <size_t N>
+class ArenaAllocator : public ArduinoJson::Allocator {
+  public:
+    void reset() {
+      this->m_used = 0;
+      this->m_last = 0;
+    }
+
+    void* allocate(size_t size) override {
+      if (size > N || HEADER_SIZE + align(size) > N - this->m_used) return 0;
+
+      this->m_last  = this->m_used;
+      this->m_used += HEADER_SIZE + align(size);
+      this->block_size(this->m_last) = size;
+      return this->m_buffer + this->m_last + HEADER_SIZE;
+    }
+
+    void deallocate(void*) override {
+      // Wird erst mit reset() freigegeben
+    }
+
+    void* reallocate(void *ptr, size_t new_size) override {
+      if (!ptr) return this->allocate(new_size);
+
+      size_t offset   = (uint8_t*) ptr - this->m_buffer - HEADER_SIZE;
+      size_t old_size = this->block_size(offset);
+
+      if (offset == this->m_last) {
+        // Letzter Block: Direkt an Ort und Stelle anpassen
+        if (new_size > N || HEADER_SIZE + align(new_size) > N - offset) return 0;
+        this->m_used = offset + HEADER_SIZE + align(new_size);
+        this->block_size(offset) = new_size;
+        return ptr;
+      }
+
+      if (new_size <= old_size) {
+        // Verkleinern, der frei werdende Platz bleibt bis zum nächsten reset() ungenutzt
+        this->block_size(offset) = new_size;
+        return ptr;
+      }
+
+      void *result = this->allocate(new_size);
+      if (result) memcpy(result, ptr, old_size);
+      return result;
+    }
+
+  private:
+    static constexpr size_t align(size_t size) {
+      return (size + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+    }
+
+    static constexpr size_t HEADER_SIZE = align(sizeof(size_t));
+
+    size_t& block_size(size_t offset) {
+      return *(size_t*) (this->m_buffer + offset);
+    }
+
+    alignas(max_align_t) uint8_t m_buffer[N];
+    size_t m_used = 0;
+    size_t m_last = 0;
+};
+
+/**
+ * Filterregel für einen einzelnen Telemetriewert. Ein neuer Wert wird nur gesendet, wenn er
+ * sich gegenüber dem zuletzt gesendeten Wert um mehr als das absolute oder relative Totband
+ * geändert hat. Sind beide Totbänder 0, wird bei jeder Änderung gesendet. Unabhängig davon
+ * wird frühestens nach `min_interval_ms` und spätestens nach `max_interval_ms` erneut gesendet.
+ * Ein maximales Intervall von 0 bedeutet, dass unveränderte Werte nie wiederholt werden.
+ */
+struct TelemetryFilterRule {
+  const char    *key;
+  float          absolute_deadband;   // z.B. 0.1 für 0,1 °C
+  float          relative_deadband;   // z.B. 0.01 für 1 %
+  unsigned long  min_interval_ms;
+  unsigned long  max_interval_ms;
+};
+
+/**
+ * Filterstufe für Telemetriedaten. Sie merkt sich für jeden Schlüssel den zuletzt gesendeten
+ * Wert und entfernt mit `apply()` alle Schlüssel aus einem JSON-Dokument, die laut ihrer
+ * Regel nicht gesendet werden müssen. Schlüssel ohne Regel bleiben unverändert erhalten.
+ * Es werden höchstens `TELEMETRY_FILTER_MAX_KEYS` Regeln verwendet.
+ *
+ * Beispiel:
+ *
+ *   static const TelemetryFilterRule rules[] = {
+ *     {"temperature", 0.1, 0,    1000, 60000},
+ *     {"pressure",    0,   0.01, 1000, 60000},
+ *   };
+ *
+ *   TelemetryFilter filter(rules, 2);
+ *   thingsboard.send_telemetry(values, filter);
+ */
+class TelemetryFilter {
+  public:
+    TelemetryFilter(const TelemetryFilterRule *rules, size_t count)
+      : m_rules(rules),
+        m_count(count < TELEMETRY_FILTER_MAX_KEYS ? count : TELEMETRY_FILTER_MAX_KEYS) {
+
+      if (count > TELEMETRY_FILTER_MAX_KEYS) {
+        ESP_LOGW(TAG, "Nur die ersten %u von %u Filterregeln werden verwendet, die restlichen Werte werden ungefiltert gesendet",
+                 (unsigned) TELEMETRY_FILTER_MAX_KEYS, (unsigned) count);
+      }
+    }
+
+    /**
+     * Nicht zu sendende Werte aus dem Dokument entfernen. Liefert `true`, wenn danach noch
+     * mindestens ein Wert übrig ist und das Dokument gesendet werden sollte.
+     */
+    bool apply(JsonDocument &values) {
+      unsigned long now = millis();
+
+      for (size_t i = 0; i < this->m_count; i++) {
+        const TelemetryFilterRule &rule = this->m_rules[i];
+        State &state = this->m_state[i];
+
+        JsonVariant value = values[rule.key];
+        if (value.isNull()) continue;
+
+        double current = value.as<double>();
+
+        if (this->must_send(rule, state, current, now)) {
+          state.value   = current;
+          state.sent_at = now;
+          state.valid   = true;
+          this->m_passed++;
+        } else {
+          values.remove(rule.key);
+          this->m_dropped++;
+        }
+      }
+
+      return values.size() > 0;
+    }
+
+    /**
+     * Anzahl der durchgelassenen und verworfenen Einzelwerte.
+     */
+    uint32_t passed()  const { return this->m_passed; }
+    uint32_t dropped() const { return this->m_dropped; }
+
+  private:
+    struct State {
+      double         value   = 0;
+      unsigned long  sent_at = 0;
+      bool           valid   = false;
+    };
+
+    static bool must_send(const TelemetryFilterRule &rule, const State &state, double current, unsigned long now) {
+      if (!state.valid) return true;
+
+      unsigned long elapsed = now - state.sent_at;
+      if (elapsed < rule.min_interval_ms) return false;
+      if (rule.max_interval_ms && elapsed >= rule.max_interval_ms) return true;
+
+      double delta = fabs(current - state.value);
+
+      if (rule.absolute_deadband <= 0 && rule.relative_deadband <= 0) return delta > 0;
+      if (rule.absolute_deadband > 0 && delta > rule.absolute_deadband) return true;
+      if (rule.relative_deadband > 0 && delta > rule.relative_deadband * fabs(state.value)) return true;
+
+      return false;
+    }
+
+    const TelemetryFilterRule *m_rules;
+    size_t   m_count;
+    State    m_state[TELEMETRY_FILTER_MAX_KEYS];
+    uint32_t m_passed  = 0;
+    uint32_t m_dropped = 0;
+};
 
 /**
  * ThingsBoard Client via MQTT
@@ -48,9 +258,11 @@ class ThingsBoard {
     ThingsBoard(const char *client_id=0)
       : m_client_id(client_id),
         m_wifi_client(),
-        m_mqtt_client(m_wifi_client) {
+        m_mqtt_client(m_wifi_client),
+        m_rx_document(&m_rx_allocator) {
 
       this->m_mqtt_client.setSocketTimeout(10000);
+      this->m_mqtt_client.setBufferSize(MQTT_BUFFER_SIZE);
 
       this->m_mqtt_client.setCallback([this](char *topic, byte *payload, unsigned int length) {
         this->on_mqtt_message_received(topic, payload, length);
@@ -117,6 +329,11 @@ class ThingsBoard {
       this->m_mqtt_client.subscribe("v1/devices/me/attributes/response/+");
       this->m_mqtt_client.subscribe("v1/devices/me/rpc/request/+");
       this->m_mqtt_client.subscribe("v1/devices/me/rpc/response/+");
+
+      if (this->m_gateway) {
+        this->m_mqtt_client.subscribe("v1/gateway/attributes");
+        this->m_mqtt_client.subscribe("v1/gateway/rpc");
+      }
     }
 
     /**
@@ -132,6 +349,7 @@ class ThingsBoard {
      */
     void loop() {
       this->m_mqtt_client.loop();
+      this->expire_rpc_requests();
     }
 
     /**
@@ -144,6 +362,16 @@ class ThingsBoard {
       this->mqtt_publish("v1/devices/me/telemetry", payload);
     }
 
+    /**
+     * Telemetrie-Daten nach Anwendung eines Filters an ThingsBoard senden. Unveränderte
+     * Werte werden dabei aus dem Dokument entfernt. Bleibt kein Wert übrig, wird nichts
+     * gesendet.
+     */
+    void send_telemetry(JsonDocument values, TelemetryFilter &filter) {
+      if (!filter.apply(values)) return;
+      this->send_telemetry(values);
+    }
+
     /**
      * Neue Attribut-Werte an ThingsBoard senden.
      */
@@ -155,19 +383,72 @@ class ThingsBoard {
     }
 
     /**
-     * RPC-Anfrage an den Server schicken. Die Request ID dient der Zuordnung der Antwort
-     * zur Anfrage, falls eine Antwort kommt.
+     * RPC-Anfrage an den Server schicken. Die Request ID wird automatisch vergeben und
+     * zurückgegeben. Trifft die Antwort ein, wird die übergebene Callback-Funktion mit
+     * `success = true` aufgerufen, nach Ablauf des Timeouts hingegen mit `success = false`.
+     * Es können bis zu `RPC_MAX_PENDING` Anfragen gleichzeitig offen sein. Ist kein Platz
+     * mehr frei oder kann die Nachricht nicht gesendet werden, wird -1 zurückgegeben.
+     *
+     * Ohne Callback-Funktion wird die Antwort an die mit `subscribe_rpc_response()`
+     * registrierte Funktion weitergereicht.
      */
-    void send_rpc_request(int request_id, const char *method, JsonDocument parameters = {}) {
-      char payload[BUFFER_SIZE];
+    int send_rpc_request(const char *method, JsonDocument parameters = JsonDocument(),
+                         on_rpc_result_t callback = 0, unsigned long timeout_ms = RPC_DEFAULT_TIMEOUT_MS) {
+      PendingRpc *pending = 0;
+
+      if (callback) {
+        for (size_t i = 0; i < RPC_MAX_PENDING; i++) {
+          if (!this->m_pending_rpcs[i].callback) {
+            pending = &this->m_pending_rpcs[i];
+            break;
+          }
+        }
+
+        if (!pending) {
+          ESP_LOGW(TAG, "RPC-Anfrage %s verworfen: Zu viele offene Anfragen", method);
+          this->m_rpc_statistics.rejected++;
+          return -1;
+        }
+      }
+
+      int request_id = this->m_next_rpc_id;
+      this->m_next_rpc_id = request_id < INT32_MAX ? request_id + 1 : 1;
+
+      char topic[48];
 
       JsonDocument message;
       message["method"] = method;
-      message["params"] = parameters;
-      
-      serializeJson(message, payload);
 
-      this->mqtt_publish("v1/devices/me/attributes", payload);
+      if (parameters.isNull()) message["params"].to<JsonObject>();
+      else message["params"] = parameters;
+
+      // Direkt in die Verbindung schreiben, damit lange Parameter nicht am festen
+      // BUFFER_SIZE abgeschnitten werden.
+      snprintf(topic, sizeof(topic), "v1/devices/me/rpc/request/%i", request_id);
+
+      if (!this->mqtt_publish_json(topic, message)) {
+        ESP_LOGW(TAG, "RPC-Anfrage %s konnte nicht gesendet werden", method);
+        this->m_rpc_statistics.rejected++;
+        return -1;
+      }
+
+      if (pending) {
+        pending->request_id = request_id;
+        pending->sent_at    = millis();
+        pending->deadline   = pending->sent_at + timeout_ms;
+        pending->callback   = callback;
+      }
+
+      this->m_rpc_statistics.sent++;
+
+      return request_id;
+    }
+
+    /**
+     * Statistik zu den gesendeten RPC-Anfragen abrufen.
+     */
+    const RpcStatistics& rpc_statistics() const {
+      return this->m_rpc_statistics;
     }
 
     /**
@@ -204,15 +485,174 @@ class ThingsBoard {
     }
 
     /**
-     * Callback-Funktion für RPC-Antworten vom Server setzen.
+     * Callback-Funktion für RPC-Antworten vom Server setzen, die keiner Anfrage mit eigener
+     * Callback-Funktion zugeordnet werden können.
      * ACHTUNG: Es kann nur eine Callback-Funktion geben.
      */
     void subscribe_rpc_response(on_rpc_response_t callback) {
       this->m_on_rpc_response = callback;
     }
     
+    /**
+     * Gateway-Modus aktivieren. Das mit dem Access Token angemeldete Gerät muss hierfür
+     * in ThingsBoard als Gateway angelegt sein. Es kann dann stellvertretend für beliebig
+     * viele untergeordnete Geräte (z.B. mehrere Sensoren am I2C-Bus) Daten senden und
+     * empfangen, ohne dass jedes Gerät eine eigene Verbindung benötigt. Muss vor
+     * `connect()` aufgerufen werden.
+     */
+    void enable_gateway() {
+      this->m_gateway = true;
+    }
+
+    /**
+     * Untergeordnetes Gerät beim Server anmelden. Existiert es noch nicht, wird es von
+     * ThingsBoard automatisch mit dem angegebenen Gerätetyp angelegt.
+     */
+    void gateway_connect_device(const char *device, const char *type = "default") {
+      JsonDocument message;
+      message["device"] = device;
+      message["type"]   = type;
+
+      this->mqtt_publish_json("v1/gateway/connect", message);
+    }
+
+    /**
+     * Untergeordnetes Gerät beim Server abmelden.
+     */
+    void gateway_disconnect_device(const char *device) {
+      JsonDocument message;
+      message["device"] = device;
+
+      this->mqtt_publish_json("v1/gateway/disconnect", message);
+    }
+
+    /**
+     * Telemetrie-Daten eines untergeordneten Geräts vormerken. Die gesammelten Werte aller
+     * Geräte werden erst mit `gateway_send_telemetry()` in einer einzigen Nachricht gesendet.
+     * Optional kann ein Zeitstempel in Millisekunden seit 1970 mitgegeben werden.
+     */
+    void gateway_add_telemetry(const char *device, JsonDocument values, uint64_t timestamp = 0) {
+      JsonArray entries = this->m_gateway_telemetry[device];
+      if (entries.isNull()) entries = this->m_gateway_telemetry[device].to<JsonArray>();
+
+      if (timestamp) {
+        JsonObject entry = entries.add<JsonObject>();
+        entry["ts"]     = timestamp;
+        entry["values"] = values;
+      } else {
+        entries.add(values);
+      }
+    }
+
+    /**
+     * Alle mit `gateway_add_telemetry()` gesammelten Telemetrie-Daten senden.
+     */
+    void gateway_send_telemetry() {
+      if (this->m_gateway_telemetry.size() == 0) return;
+
+      this->mqtt_publish_json("v1/gateway/telemetry", this->m_gateway_telemetry);
+      this->m_gateway_telemetry.clear();
+    }
+
+    /**
+     * Neue Attribut-Werte eines untergeordneten Geräts an ThingsBoard senden.
+     */
+    void gateway_send_attributes(const char *device, JsonDocument values) {
+      JsonDocument message;
+      message[device] = values;
+
+      this->mqtt_publish_json("v1/gateway/attributes", message);
+    }
+
+    /**
+     * Antwort auf eine RPC-Anfrage an ein untergeordnetes Gerät senden.
+     */
+    void gateway_send_rpc_response(const char *device, int request_id, JsonDocument values) {
+      JsonDocument message;
+      message["device"] = device;
+      message["id"]     = request_id;
+      message["data"]   = values;
+
+      this->mqtt_publish_json("v1/gateway/rpc", message);
+    }
+
+    /**
+     * Callback-Funktion für Attribut-Werte untergeordneter Geräte setzen.
+     * ACHTUNG: Es kann nur eine Callback-Funktion geben.
+     */
+    void subscribe_gateway_attribute_values(on_gateway_attribute_values_t callback) {
+      this->m_on_gateway_attribute_values = callback;
+    }
+
+    /**
+     * Callback-Funktion für RPC-Anfragen an untergeordnete Geräte setzen.
+     * ACHTUNG: Es kann nur eine Callback-Funktion geben.
+     */
+    void subscribe_gateway_rpc_request(on_gateway_rpc_request_t callback) {
+      this->m_on_gateway_rpc_request = callback;
+    }
+
   private:
 
+    /**
+     * Eintrag in der Tabelle der offenen RPC-Anfragen. Freie Einträge haben keine
+     * Callback-Funktion.
+     */
+    struct PendingRpc {
+      int             request_id = 0;
+      unsigned long   sent_at    = 0;
+      unsigned long   deadline   = 0;
+      on_rpc_result_t callback   = 0;
+    };
+
+    /**
+     * Offene RPC-Anfrage mit einer empfangenen Antwort abschließen. Liefert `false`, wenn
+     * zu der Request ID keine offene Anfrage existiert.
+     */
+    bool complete_rpc_request(int request_id, JsonVariant values) {
+      for (size_t i = 0; i < RPC_MAX_PENDING; i++) {
+        PendingRpc &pending = this->m_pending_rpcs[i];
+        if (!pending.callback || pending.request_id != request_id) continue;
+
+        unsigned long latency    = millis() - pending.sent_at;
+        on_rpc_result_t callback = pending.callback;
+        pending.callback = 0;
+
+        size_t bucket = 0;
+        while (bucket < RPC_LATENCY_BUCKETS - 1 && latency >= RPC_LATENCY_BOUNDS_MS[bucket]) bucket++;
+
+        this->m_rpc_statistics.completed++;
+        this->m_rpc_statistics.latency_histogram[bucket]++;
+
+        ESP_LOGD(TAG, "Antwort auf RPC-Anfrage %i nach %lu ms", request_id, latency);
+        callback(request_id, true, values);
+        return true;
+      }
+
+      return false;
+    }
+
+    /**
+     * Abgelaufene RPC-Anfragen entfernen und deren Callback-Funktion mit `success = false`
+     * aufrufen.
+     */
+    void expire_rpc_requests() {
+      unsigned long now = millis();
+
+      for (size_t i = 0; i < RPC_MAX_PENDING; i++) {
+        PendingRpc &pending = this->m_pending_rpcs[i];
+        if (!pending.callback || (long) (now - pending.deadline) < 0) continue;
+
+        on_rpc_result_t callback = pending.callback;
+        pending.callback = 0;
+
+        this->m_rpc_statistics.timed_out++;
+
+        ESP_LOGW(TAG, "Timeout bei RPC-Anfrage %i", pending.request_id);
+        callback(pending.request_id, false, JsonVariant());
+      }
+    }
+
     /**
      * MQTT-Nachricht senden mit Protokollierung.
      */
@@ -222,33 +662,116 @@ class ThingsBoard {
     }
 
     /**
-     * Callback-Funktion für empfangene MQTT-Nachrichten.
+     * JSON-Dokument als MQTT-Nachricht senden. Das Dokument wird dabei direkt in die
+     * Verbindung geschrieben, so dass seine Größe nicht durch einen Puffer begrenzt ist.
+     * Liefert `false`, wenn die Nachricht nicht vollständig gesendet werden konnte.
+     */
+    bool mqtt_publish_json(const char *topic, const JsonDocument &message) {
+      size_t length = measureJson(message);
+      ESP_LOGD(TAG, "Sende Nachricht an Topic %s: %u Bytes", topic, (unsigned) length);
+
+      if (!this->m_mqtt_client.beginPublish(topic, length, false)) return false;
+
+      ChunkWriter writer(this->m_mqtt_client);
+      serializeJson(message, writer);
+      size_t written = writer.flush();
+
+      return this->m_mqtt_client.endPublish() && written == length;
+    }
+
+    /**
+     * Sammelt die einzelnen Zeichen von serializeJson() in einem kleinen Puffer auf dem Stack
+     * und reicht sie in Blöcken von `TX_CHUNK_SIZE` Bytes an PubSubClient weiter. Ohne den
+     * Puffer würde jedes Zeichen einzeln an den WiFiClient und damit an lwIP übergeben.
+     */
+    class ChunkWriter {
+      public:
+        ChunkWriter(PubSubClient &client) : m_client(client) {}
+
+        size_t write(uint8_t c) {
+          if (this->m_length == TX_CHUNK_SIZE) this->flush();
+          this->m_buffer[this->m_length++] = c;
+          return 1;
+        }
+
+        size_t write(const uint8_t *buffer, size_t size) {
+          for (size_t i = 0; i < size; i++) this->write(buffer[i]);
+          return size;
+        }
+
+        /**
+         * Restliche Zeichen senden. Liefert die Anzahl aller bisher gesendeten Bytes.
+         */
+        size_t flush() {
+          if (this->m_length) this->m_written += this->m_client.write(this->m_buffer, this->m_length);
+          this->m_length = 0;
+          return this->m_written;
+        }
+
+      private:
+        PubSubClient &m_client;
+        uint8_t       m_buffer[TX_CHUNK_SIZE];
+        size_t        m_length  = 0;
+        size_t        m_written = 0;
+    };
+
+    /**
+     * Prüfen, ob ein Topic mit dem gegebenen Präfix beginnt. Liefert in diesem Fall einen
+     * Zeiger auf den Rest des Topics, ansonsten einen Nullzeiger.
+     */
+    static const char* match_topic(const char *topic, const char *prefix) {
+      size_t length = strlen(prefix);
+      return strncmp(topic, prefix, length) == 0 ? topic + length : 0;
+    }
+
+    /**
+     * Callback-Funktion für empfangene MQTT-Nachrichten. Die Nachricht wird direkt aus dem
+     * Puffer von PubSubClient gelesen und in ein wiederverwendetes JSON-Dokument mit festem
+     * Speicher geparst, so dass hier kein Heap-Speicher benötigt wird.
      */
     void on_mqtt_message_received(char *topic, byte *payload, unsigned int length) {
-      char _payload[BUFFER_SIZE];
-      strncpy(_payload, (char *) payload, length);
+      ESP_LOGD(TAG, "Empfange Nachricht an Topic %s: %.*s", topic, length, (const char*) payload);
 
-      String _topic = topic;
+      this->m_rx_document.clear();
+      this->m_rx_allocator.reset();
 
-      ESP_LOGD(TAG, "Empfange Nachricht an Topic %s: %s", topic, _payload);
+      if (payload && length) {
+        DeserializationError error = deserializeJson(this->m_rx_document, payload, length);
+
+        if (error) {
+          ESP_LOGW(TAG, "Nachricht an Topic %s nicht lesbar: %s", topic, error.c_str());
+          return;
+        }
+      }
 
-      JsonDocument values;
-      if (payload) deserializeJson(values, _payload);
+      JsonDocument &values = this->m_rx_document;
+      const char *suffix = 0;
 
-      if (_topic.equals("v1/devices/me/attributes") && this->m_on_attribute_values) {
+      if (strcmp(topic, "v1/devices/me/attributes") == 0) {
         // Neue Attribut-Werte
-        this->m_on_attribute_values(values.as<JsonObject>());
-      } else if (_topic.startsWith("v1/devices/me/attributes/response/") && this->m_on_attribute_values) {
+        if (this->m_on_attribute_values) this->m_on_attribute_values(values.as<JsonObject>());
+      } else if ((suffix = match_topic(topic, "v1/devices/me/attributes/response/"))) {
         // Angeforderte Attribute
-        this->m_on_attribute_values(values["shared"]);
-      } else if (_topic.startsWith("v1/devices/me/rpc/request/") && this->m_on_rpc_request) {
+        if (this->m_on_attribute_values) this->m_on_attribute_values(values["shared"]);
+      } else if ((suffix = match_topic(topic, "v1/devices/me/rpc/request/"))) {
         // RPC-Anfrage vom Server
-        int request_id     = atoi(_topic.substring(26).c_str());
-        this->m_on_rpc_request(request_id, values["method"], values["params"]);
-      } else if (_topic.startsWith("v1/devices/me/rpc/response/") && this->m_on_rpc_response) {
+        int request_id = atoi(suffix);
+        if (this->m_on_rpc_request) this->m_on_rpc_request(request_id, values["method"], values["params"]);
+      } else if ((suffix = match_topic(topic, "v1/devices/me/rpc/response/"))) {
         // RPC-Antwort vom Server
-        int request_id = atoi(_topic.substring(27).c_str());
-        this->m_on_rpc_response(request_id, values);
+        int request_id = atoi(suffix);
+
+        if (!this->complete_rpc_request(request_id, values.as<JsonVariant>())) {
+          if (this->m_on_rpc_response) this->m_on_rpc_response(request_id, values.as<JsonVariant>());
+          else this->m_rpc_statistics.unmatched++;
+        }
+      } else if (strcmp(topic, "v1/gateway/attributes") == 0) {
+        // Neue Attribut-Werte eines untergeordneten Geräts
+        if (this->m_on_gateway_attribute_values) this->m_on_gateway_attribute_values(values["device"], values["data"]);
+      } else if (strcmp(topic, "v1/gateway/rpc") == 0) {
+        // RPC-Anfrage an ein untergeordnetes Gerät
+        JsonObject data = values["data"];
+        if (this->m_on_gateway_rpc_request) this->m_on_gateway_rpc_request(values["device"], data["id"], data["method"], data["params"]);
       }
     }
 
@@ -256,7 +779,19 @@ class ThingsBoard {
     WiFiClient   m_wifi_client;
     PubSubClient m_mqtt_client;
 
+    ArenaAllocator<RX_ARENA_SIZE> m_rx_allocator;
+    JsonDocument                  m_rx_document;
+
     on_attribute_values_t m_on_attribute_values = 0;
     on_rpc_request_t      m_on_rpc_request      = 0;
     on_rpc_response_t     m_on_rpc_response     = 0;
+
+    bool                          m_gateway                     = false;
+    JsonDocument                  m_gateway_telemetry;
+    on_gateway_attribute_values_t m_on_gateway_attribute_values = 0;
+    on_gateway_rpc_request_t      m_on_gateway_rpc_request      = 0;
+
+    PendingRpc    m_pending_rpcs[RPC_MAX_PENDING];
+    int           m_next_rpc_id = 1;
+    RpcStatistics m_rpc_statistics;
 };
\ No newline at end of file
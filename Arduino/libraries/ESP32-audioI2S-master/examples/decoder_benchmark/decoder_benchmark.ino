@@ -0,0 +1,78 @@
+// Decodes all files of a directory as fast as possible and prints the x-realtime factor and a checksum
+// of the PCM data. Nothing is sent to I2S, so the result only depends on the SD card and the decoder.
+// Compare the checksums before and after a change in one of the decoders.
+// extras/host_benchmark builds the same measurement for a Linux PC, its checksums are taken before the volume
+// stage and therefore differ from the ones printed here.
+#include "Arduino.h"
+#include "Audio.h"
+#include "SD_MMC.h"
+#include "FS.h"
+#include <vector>
+
+#define SD_MMC_D0   2
+#define SD_MMC_CLK  14
+#define SD_MMC_CMD  15
+
+class ChecksumSink : public AudioSink {
+public:
+    esp_err_t write(const void* buff, size_t size, size_t* bytesWritten) override {
+        const uint8_t* p = (const uint8_t*)buff;
+        for(size_t i = 0; i < size; i++) { m_hash = (m_hash ^ p[i]) * 16777619UL; } // FNV-1a
+        m_bytes += size;
+        *bytesWritten = size;
+        return ESP_OK;
+    }
+    void     reset()    { m_hash = 2166136261UL; m_bytes = 0; }
+    uint32_t hash()     { return m_hash; }
+    uint64_t bytes()    { return m_bytes; }
+private:
+    uint32_t m_hash = 2166136261UL;
+    uint64_t m_bytes = 0;
+};
+
+Audio              audio;
+ChecksumSink       sink;
+std::vector<char*> v_audioContent;
+const char         audioDir[] = "/corpus";
+uint32_t           t_start = 0;
+
+void nextFile() {
+    if(v_audioContent.size() == 0) { Serial.println("done"); return; }
+    const char* s = v_audioContent[v_audioContent.size() - 1];
+    Serial.printf("decoding %s\n", s);
+    sink.reset();
+    t_start = millis();
+    audio.connecttoFS(SD_MMC, s);
+    v_audioContent.pop_back();
+}
+
+void setup() {
+    Serial.begin(115200);
+    pinMode(SD_MMC_D0, INPUT_PULLUP);
+    SD_MMC.setPins(SD_MMC_CLK,SD_MMC_CMD, SD_MMC_D0);
+    if(!SD_MMC.begin( "/sdmmc", true, false, 20000)){
+        Serial.println("Card Mount Failed");
+        return;
+    }
+    File root = SD_MMC.open(audioDir);
+    File file = root.openNextFile();
+    while(file){
+        if(!file.isDirectory()) v_audioContent.insert(v_audioContent.begin(), strdup(file.path()));
+        file = root.openNextFile();
+    }
+    audio.setAudioSink(&sink);
+    nextFile();
+}
+
+void loop(){
+    audio.loop();
+    vTaskDelay(1);
+}
+
+void audio_eof_mp3(const char *info){  // end of file, all codecs
+    uint32_t t = millis() - t_start;
+    float seconds = (float)sink.bytes() / (4 * audio.getSampleRate()); // 16 bit stereo
+    Serial.printf("%s: %.1f s audio in %lu ms, %.1f x realtime, checksum %08lx\n", info, seconds,
+                  (unsigned long)t, t ? seconds * 1000 / t : 0, (unsigned long)sink.hash());
+    nextFile();
+}
@@ -0,0 +1,281 @@
+// Host counterpart of examples/decoder_benchmark: decodes audio files with the library decoders on a Linux PC
+// and prints the x-realtime factor and a FNV-1a checksum of the PCM data. The checksum is taken directly from
+// the decoder output (before volume and mixer), so it changes only if a decoder produces different samples.
+//
+//   decoder_benchmark [-r repeats] file...
+//
+// mp3, aac (ADTS), m4a, flac, ogg (vorbis, opus, flac) and opus files are recognized by their content.
+
+#include "Arduino.h"
+#include "mp3_decoder/mp3_decoder.h"
+#include "aac_decoder/aac_decoder.h"
+#include "flac_decoder/flac_decoder.h"
+#include "opus_decoder/opus_decoder.h"
+#include "vorbis_decoder/vorbis_decoder.h"
+#include <chrono>
+#include <vector>
+
+enum : uint8_t { CODEC_NONE, CODEC_MP3, CODEC_AAC, CODEC_M4A, CODEC_FLAC, CODEC_OPUS, CODEC_VORBIS };
+static const char* codecname[] = {"unknown", "MP3", "AAC", "M4A", "FLAC", "OPUS", "VORBIS"};
+
+struct Stream {
+    std::vector<uint8_t> data;
+    uint8_t  codec = CODEC_NONE;
+    uint32_t audioDataStart = 0;
+    uint32_t audioDataEnd = 0;
+    // raw block parameters, taken from the container (m4a, native flac)
+    uint8_t  channels = 0;
+    uint32_t sampleRate = 0;
+    uint8_t  bitsPerSample = 0;
+    uint8_t  objectType = 0;
+    uint32_t totalSamples = 0;
+};
+
+struct Result {
+    uint32_t hash = 2166136261UL;
+    uint64_t samples = 0; // all channels
+    uint8_t  channels = 0;
+    uint32_t sampleRate = 0;
+    uint32_t errors = 0;
+};
+
+static int16_t s_outBuff[4096 * 2];
+
+//----------------------------------------------------------------------------------------------------------------------
+static uint32_t bigEndian(const uint8_t* p, uint8_t len) {
+    uint32_t result = 0;
+    for(int i = 0; i < len; i++) result = (result << 8) | p[i];
+    return result;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static int32_t indexOf(const std::vector<uint8_t>& d, const char* str, uint32_t from, uint32_t to) {
+    size_t len = strlen(str);
+    for(uint32_t i = from; i + len <= to; i++) {
+        if(memcmp(&d[i], str, len) == 0) return i;
+    }
+    return -1;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static bool readFile(const char* path, std::vector<uint8_t>& d) {
+    FILE* f = fopen(path, "rb");
+    if(!f) return false;
+    uint8_t buf[65536];
+    size_t  n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0) d.insert(d.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static bool parseM4A(Stream& s) { // find the AudioSpecificConfig and the mdat atom, the decoder gets the raw blocks
+    const std::vector<uint8_t>& d = s.data;
+    uint32_t pos = 0;
+    while(pos + 8 <= d.size()) { // top level atoms
+        uint32_t size = bigEndian(&d[pos], 4);
+        if(size < 8 || pos + size > d.size()) size = d.size() - pos; // last atom can be open-ended
+        if(memcmp(&d[pos + 4], "moov", 4) == 0) {
+            int32_t mp4a = indexOf(d, "mp4a", pos, pos + size);
+            if(mp4a > 0) {
+                s.channels = bigEndian(&d[mp4a + 20], 2);
+                s.bitsPerSample = bigEndian(&d[mp4a + 22], 2);
+                s.sampleRate = bigEndian(&d[mp4a + 26], 4) >> 16; // 16.16 fixed point
+            }
+            int32_t esds = indexOf(d, "esds", pos, pos + size);
+            for(uint32_t i = esds; esds > 0 && i + 6 < pos + size; i++) {
+                if(d[i] != 0x05) continue; // DecoderSpecificInfo tag
+                uint32_t j = i + 1;
+                while(d[j] & 0x80) j++; // variable length
+                uint16_t ASC = bigEndian(&d[j + 1], 2);
+                s.objectType = ASC >> 11;
+                uint8_t chConfig = (ASC & 0x78) >> 3;
+                if(chConfig && chConfig < 3) s.channels = chConfig;
+                break;
+            }
+        }
+        if(memcmp(&d[pos + 4], "mdat", 4) == 0) {
+            s.audioDataStart = pos + 8;
+            s.audioDataEnd = pos + size;
+        }
+        pos += size;
+    }
+    if(!s.channels) s.channels = 2; // same guards as in Audio::findNextSync()
+    if(!s.sampleRate) s.sampleRate = 44100;
+    if(!s.objectType || s.objectType > 6) s.objectType = 2;
+    return s.audioDataStart > 0;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static bool parseFLAC(Stream& s) { // native flac, read STREAMINFO and skip all metadata blocks
+    const std::vector<uint8_t>& d = s.data;
+    uint32_t pos = 4;
+    bool     lastBlock = false;
+    while(!lastBlock && pos + 4 <= d.size()) {
+        uint8_t  blockType = d[pos] & 0x7F;
+        uint32_t blockLen = bigEndian(&d[pos + 1], 3);
+        lastBlock = d[pos] & 0x80;
+        if(blockType == 0 && pos + 4 + 18 <= d.size()) { // STREAMINFO
+            const uint8_t* p = &d[pos + 4 + 10];
+            s.sampleRate = (p[0] << 12) | (p[1] << 4) | (p[2] >> 4);
+            s.channels = ((p[2] >> 1) & 0x07) + 1;
+            s.bitsPerSample = (((p[2] & 0x01) << 4) | (p[3] >> 4)) + 1;
+            s.totalSamples = bigEndian(p + 4, 4); // lower 32 bits of 36
+        }
+        pos += 4 + blockLen;
+    }
+    s.audioDataStart = pos;
+    s.audioDataEnd = d.size();
+    return s.sampleRate > 0 && pos < d.size();
+}
+//----------------------------------------------------------------------------------------------------------------------
+static uint8_t detectCodec(Stream& s) {
+    const std::vector<uint8_t>& d = s.data;
+    s.audioDataStart = 0;
+    s.audioDataEnd = d.size();
+    if(d.size() < 64) return CODEC_NONE;
+    if(memcmp(&d[0], "OggS", 4) == 0) { // the first packet tells the codec
+        uint32_t first = 27 + d[26];
+        if(first + 8 > d.size()) return CODEC_NONE;
+        if(memcmp(&d[first], "\x01vorbis", 7) == 0) return CODEC_VORBIS;
+        if(memcmp(&d[first], "OpusHead", 8) == 0) return CODEC_OPUS;
+        if(memcmp(&d[first], "\x7F" "FLAC", 5) == 0) return CODEC_FLAC;
+        return CODEC_NONE;
+    }
+    if(memcmp(&d[0], "RIFF", 4) == 0) return CODEC_NONE; // wav is not decoded, Audio copies the samples
+    if(memcmp(&d[0], "fLaC", 4) == 0) return parseFLAC(s) ? CODEC_FLAC : CODEC_NONE;
+    if(memcmp(&d[4], "ftyp", 4) == 0) return parseM4A(s) ? CODEC_M4A : CODEC_NONE;
+    if(memcmp(&d[0], "ID3", 3) == 0) { // skip the ID3v2 tag, the size is syncsafe
+        s.audioDataStart = 10 + ((d[6] & 0x7F) << 21 | (d[7] & 0x7F) << 14 | (d[8] & 0x7F) << 7 | (d[9] & 0x7F));
+        if(s.audioDataStart >= d.size()) return CODEC_NONE;
+    }
+    const uint8_t* p = &d[s.audioDataStart];
+    if(p[0] == 0xFF && (p[1] & 0xF6) == 0xF0) return CODEC_AAC; // ADTS, layer bits are 00
+    if(MP3FindSyncWord((uint8_t*)p, d.size() - s.audioDataStart) >= 0) return CODEC_MP3;
+    return CODEC_NONE;
+}
+//----------------------------------------------------------------------------------------------------------------------
+static bool decodeStream(Stream& s, Result& r) { // same frame sizes and error handling as Audio::sendBytes()
+    MP3Decoder_t*    md = NULL;
+    AACDecoder_t*    ad = NULL;
+    FLACDecoder_t*   fd = NULL;
+    OPUSDecoder_t*   od = NULL;
+    VORBISDecoder_t* vd = NULL;
+    int32_t          frameSize = 0;
+    switch(s.codec) {
+        case CODEC_MP3:    md = MP3Decoder_AllocateBuffers();    frameSize = 1600; break;
+        case CODEC_AAC:
+        case CODEC_M4A:    ad = AACDecoder_AllocateBuffers();    frameSize = 1600; break;
+        case CODEC_FLAC:   fd = FLACDecoder_AllocateBuffers();   frameSize = 4096 * 4; break;
+        case CODEC_OPUS:   od = OPUSDecoder_AllocateBuffers();   frameSize = 1024; break;
+        case CODEC_VORBIS: vd = VORBISDecoder_AllocateBuffers(); frameSize = 4096 * 2; break;
+    }
+    if(!md && !ad && !fd && !od && !vd) { log_e("decoder could not be allocated"); return false; }
+    if(s.codec == CODEC_M4A) AACSetRawBlockParams(ad, s.channels, s.sampleRate, s.objectType);
+    if(s.codec == CODEC_FLAC && s.data[0] == 'f') {
+        FLACSetRawBlockParams(fd, s.channels, s.sampleRate, s.bitsPerSample, s.totalSamples, s.audioDataEnd - s.audioDataStart);
+    }
+
+    uint8_t* data = s.data.data();
+    uint32_t pos = s.audioDataStart;
+    bool     synced = false;
+    uint8_t  stalled = 0;
+    while(pos < s.audioDataEnd) {
+        int32_t len = _min((int32_t)(s.audioDataEnd - pos), frameSize);
+        if(!synced) {
+            int32_t nextSync = 0;
+            switch(s.codec) {
+                case CODEC_MP3:    nextSync = MP3FindSyncWord(data + pos, len); break;
+                case CODEC_AAC:    nextSync = AACFindSyncWord(data + pos, len); break;
+                case CODEC_FLAC:   nextSync = FLACFindSyncWord(fd, data + pos, len); break;
+                case CODEC_OPUS:   nextSync = OPUSFindSyncWord(od, data + pos, len); break;
+                case CODEC_VORBIS: nextSync = VORBISFindSyncWord(data + pos, len); break;
+            }
+            if(nextSync == -1) { pos += len; continue; }
+            pos += nextSync;
+            synced = true;
+            continue;
+        }
+        int32_t bytesLeft = len;
+        int32_t ret = 0;
+        switch(s.codec) {
+            case CODEC_MP3:    ret = MP3Decode(md, data + pos, &bytesLeft, s_outBuff, 0); break;
+            case CODEC_AAC:
+            case CODEC_M4A:    ret = AACDecode(ad, data + pos, &bytesLeft, s_outBuff); break;
+            case CODEC_FLAC:   ret = FLACDecode(fd, data + pos, &bytesLeft, s_outBuff); break;
+            case CODEC_OPUS:   ret = OPUSDecode(od, data + pos, &bytesLeft, s_outBuff); break;
+            case CODEC_VORBIS: ret = VORBISDecode(vd, data + pos, &bytesLeft, s_outBuff); break;
+        }
+        int32_t bytesDecoded = len - bytesLeft;
+        if(ret < 0 || (ret == 0 && bytesDecoded == 0)) { // skip one byte and seek for the next sync word
+            if(ret < 0) r.errors++;
+            if(s.codec == CODEC_OPUS && ret <= ERR_OPUS_SILK_MODE_UNSUPPORTED && ret >= ERR_OPUS_SUPER_WIDE_BAND_UNSUPPORTED) break;
+            if(s.codec == CODEC_OPUS && ret == ERR_OPUS_INVALID_SAMPLERATE) break; // these stop the song in Audio too
+            if(s.codec != CODEC_M4A) synced = false;
+            pos++;
+            continue;
+        }
+        if(bytesDecoded == 0) { // the ogg parsers can return 'more data' without consuming, call again
+            if(++stalled > 16) break;
+            continue;
+        }
+        stalled = 0;
+        pos += bytesDecoded;
+        uint32_t samples = 0; // all channels
+        switch(s.codec) {
+            case CODEC_MP3:    samples = MP3GetOutputSamps(md);
+                               r.channels = MP3GetChannels(md); r.sampleRate = MP3GetSampRate(md); break;
+            case CODEC_AAC:
+            case CODEC_M4A:    samples = AACGetOutputSamps(ad);
+                               r.channels = AACGetChannels(ad); r.sampleRate = AACGetSampRate(ad); break;
+            case CODEC_FLAC:   if(ret == FLAC_PARSE_OGG_DONE) break;
+                               samples = FLACGetOutputSamps(fd);
+                               r.channels = FLACGetChannels(fd); r.sampleRate = FLACGetSampRate(fd); break;
+            case CODEC_OPUS:   if(ret == OPUS_PARSE_OGG_DONE) break;
+                               r.channels = OPUSGetChannels(od); r.sampleRate = OPUSGetSampRate();
+                               samples = OPUSGetOutputSamps(od) * r.channels; break;
+            case CODEC_VORBIS: if(ret == VORBIS_PARSE_OGG_DONE) break;
+                               r.channels = VORBISGetChannels(vd); r.sampleRate = VORBISGetSampRate(vd);
+                               samples = VORBISGetOutputSamps(vd) * r.channels; break;
+        }
+        const uint8_t* p = (const uint8_t*)s_outBuff;
+        for(uint32_t i = 0; i < samples * 2; i++) { r.hash = (r.hash ^ p[i]) * 16777619UL; } // FNV-1a
+        r.samples += samples;
+    }
+    MP3Decoder_FreeBuffers(md);
+    AACDecoder_FreeBuffers(ad);
+    FLACDecoder_FreeBuffers(fd);
+    OPUSDecoder_FreeBuffers(od);
+    VORBISDecoder_FreeBuffers(vd);
+    return true;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    int repeats = 1;
+    int first = 1;
+    if(argc > 2 && strcmp(argv[1], "-r") == 0) { repeats = _max(atoi(argv[2]), 1); first = 3; }
+    if(first >= argc) {
+        fprintf(stderr, "usage: %s [-r repeats] file...\n", argv[0]);
+        return 2;
+    }
+    int failed = 0;
+    for(int i = first; i < argc; i++) {
+        Stream s;
+        if(!readFile(argv[i], s.data)) { fprintf(stderr, "%s: can't read\n", argv[i]); failed++; continue; }
+        s.codec = detectCodec(s);
+        if(s.codec == CODEC_NONE) { printf("%s: skipped, no supported codec\n", argv[i]); continue; }
+        Result r;
+        double best = 1e30; // fastest pass in ms, the others are warmup or disturbed by the scheduler
+        std::vector<uint8_t> file = s.data;
+        for(int n = 0; n < repeats; n++) {
+            r = Result();
+            s.data = file; // the ogg parsers join continued packets in place, every pass needs the original data
+            auto t0 = std::chrono::steady_clock::now();
+            if(!decodeStream(s, r)) { failed++; break; }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if(ms < best) best = ms;
+        }
+        if(!r.channels || !r.sampleRate) { printf("%s: %s, no audio decoded\n", argv[i], codecname[s.codec]); failed++; continue; }
+        double seconds = (double)r.samples / r.channels / r.sampleRate;
+        printf("%s: %s %uch %luHz, %.1f s audio in %.1f ms, %.1f x realtime, %lu errors, checksum %08lx\n", argv[i],
+               codecname[s.codec], r.channels, (unsigned long)r.sampleRate, seconds, best, best ? seconds * 1000 / best : 0,
+               (unsigned long)r.errors, (unsigned long)r.hash);
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+// Minimal stand-in for the Arduino/ESP-IDF headers, just enough to build the decoders on a Linux host.
+// Only used by extras/host_benchmark, never by the ESP32 build.
+#pragma once
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <alloca.h>
+#include <algorithm>
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define DRAM_ATTR
+#ifndef __unused
+    #define __unused __attribute__((unused))
+#endif
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#ifndef _min
+    #define _min(a,b) ((a)<(b)?(a):(b))
+#endif
+#ifndef _max
+    #define _max(a,b) ((a)>(b)?(a):(b))
+#endif
+
+// errors and warnings go to stderr, info and debug messages are dropped so they don't distort the timing
+#define log_e(format, ...) fprintf(stderr, "E: " format "\n", ##__VA_ARGS__)
+#define log_w(format, ...) fprintf(stderr, "W: " format "\n", ##__VA_ARGS__)
+#define log_i(format, ...) do {} while(0)
+#define log_d(format, ...) do {} while(0)
+#define log_v(format, ...) do {} while(0)
+
+// the host has no PSRAM, every heap_caps variant is plain malloc
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_8BIT     (1 << 2)
+
+inline bool  psramFound()                                             { return true; }
+inline void* ps_malloc(size_t size)                                   { return malloc(size); }
+inline void* ps_calloc(size_t n, size_t size)                         { return calloc(n, size); }
+inline void* heap_caps_malloc(size_t size, uint32_t)                  { return malloc(size); }
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t)        { return calloc(n, size); }
+inline void* heap_caps_malloc_prefer(size_t size, size_t, ...)        { return malloc(size); }
+inline void* heap_caps_calloc_prefer(size_t n, size_t size, size_t, ...) { return calloc(n, size); }
@@ -14,6 +14,8 @@
 #include "mp3_decoder/mp3_decoder.h"
 #include "opus_decoder/opus_decoder.h"
 #include "vorbis_decoder/vorbis_decoder.h"
+#include "ogg_demuxer/ogg_demuxer.h"
+#include <lwip/sockets.h>
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 AudioBuffer::AudioBuffer(size_t maxBlockSize) {
@@ -41,20 +43,29 @@ size_t AudioBuffer::init() {
         m_f_psram = true;
         m_buffSize = m_buffSizePSRAM;
         m_buffer = (uint8_t*)ps_calloc(m_buffSize, sizeof(uint8_t));
-        m_buffSize = m_buffSizePSRAM - m_resBuffSizePSRAM;
+        m_resBuffSize = min(m_resBuffSizePSRAM, m_buffSizePSRAM / 2); // setBufsize() can make the buffer small
+        m_buffSize = m_buffSizePSRAM - m_resBuffSize;
     }
     if(m_buffer == NULL) { // PSRAM not found, not configured or not enough available
         m_f_psram = false;
         m_buffer = (uint8_t*)heap_caps_calloc(m_buffSizeRAM, sizeof(uint8_t), MALLOC_CAP_DEFAULT | MALLOC_CAP_INTERNAL);
-        m_buffSize = m_buffSizeRAM - m_resBuffSizeRAM;
+        m_resBuffSize = min(m_resBuffSizeRAM, m_buffSizeRAM / 2);
+        m_buffSize = m_buffSizeRAM - m_resBuffSize;
     }
     if(!m_buffer) return 0;
     m_f_init = true;
+    changeMaxBlockSize(m_maxBlockSize);
     resetBuffer();
     return m_buffSize;
 }
 
 void AudioBuffer::changeMaxBlockSize(uint16_t mbs) {
+    // a block is read in one piece from getReadPtr(), near the end of the ring it continues in the guard region,
+    // so it must not be larger than the guard (flac without PSRAM)
+    if(m_f_init && mbs > m_resBuffSize) {
+        log_w("max block size %u reduced to %u, the input buffer is too small", mbs, (unsigned)m_resBuffSize);
+        mbs = m_resBuffSize;
+    }
     m_maxBlockSize = mbs;
     return;
 }
@@ -62,105 +73,1067 @@ void AudioBuffer::changeMaxBlockSize(uint16_t mbs) {
 uint16_t AudioBuffer::getMaxBlockSize() { return m_maxBlockSize; }
 
 size_t AudioBuffer::freeSpace() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_freeSpace = m_buffSize;
-        else m_freeSpace = 0;
+    return m_buffSize - bufferFilled();
+}
+
+size_t AudioBuffer::writeSpace() { // producer
+    size_t w = m_writeIdx.load(std::memory_order_relaxed);
+    size_t r = m_readIdx.load(std::memory_order_acquire);
+    return min(m_buffSize - filled(w, r), m_buffSize - pos(w));
+}
+
+size_t AudioBuffer::bufferFilled() {
+    size_t r = m_readIdx.load(std::memory_order_acquire);
+    size_t w = m_writeIdx.load(std::memory_order_acquire);
+    return filled(w, r);
+}
+
+size_t AudioBuffer::getMaxAvailableBytes() { // consumer
+    size_t r = m_readIdx.load(std::memory_order_relaxed);
+    size_t w = m_writeIdx.load(std::memory_order_acquire);
+    return min(filled(w, r), m_buffSize - pos(r));
+}
+
+void AudioBuffer::bytesWritten(size_t bw) { // producer
+    if(!bw) return;
+    size_t w = m_writeIdx.load(std::memory_order_relaxed);
+    size_t p = pos(w);
+    if(p + bw > m_buffSize) log_e("write beyond buffer end, pos %i, len %i, m_buffSize %i", p, bw, m_buffSize);
+    if(p < m_resBuffSize) { // keep the guard region in sync before the data is published
+        memcpy(m_endPtr + p, m_buffer + p, min(bw, m_resBuffSize - p));
+    }
+    m_writeIdx.store(advance(w, bw), std::memory_order_release);
+}
+
+void AudioBuffer::bytesWasRead(size_t br) { // consumer
+    if(!br) return;
+    size_t r = m_readIdx.load(std::memory_order_relaxed);
+    size_t f = filled(m_writeIdx.load(std::memory_order_acquire), r);
+    if(br > f) br = f; // never overtake the producer
+    m_readIdx.store(advance(r, br), std::memory_order_release);
+}
+
+uint8_t* AudioBuffer::getWritePtr() { return m_buffer + pos(m_writeIdx.load(std::memory_order_relaxed)); }
+
+uint8_t* AudioBuffer::getReadPtr() {
+    // up to m_resBuffSize bytes can be read beyond m_endPtr, the producer has already mirrored them
+    return m_buffer + pos(m_readIdx.load(std::memory_order_relaxed));
+}
+
+void AudioBuffer::resetBuffer() {
+    m_endPtr = m_buffer + m_buffSize;
+    m_readIdx.store(0, std::memory_order_relaxed);
+    m_writeIdx.store(0, std::memory_order_release);
+}
+
+uint32_t AudioBuffer::getWritePos() { return pos(m_writeIdx.load(std::memory_order_relaxed)); }
+
+uint32_t AudioBuffer::getReadPos() { return pos(m_readIdx.load(std::memory_order_relaxed)); }
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+esp_err_t I2SSink::write(const void* buff, size_t size, size_t* bytesWritten) {
+    return i2s_channel_write(m_handle, buff, size, bytesWritten, 10);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+esp_err_t WavFileSink::begin(uint32_t sampleRate, uint8_t bitsPerSample, uint8_t channels) {
+    // the data arrives as stereo in any case, 16 or 32 bits per sample
+    if(!m_file) return ESP_ERR_INVALID_STATE;
+    m_sampleRate = sampleRate;
+    m_bitsPerSample = bitsPerSample;
+    writeHeader();
+    return ESP_OK;
+}
+
+esp_err_t WavFileSink::write(const void* buff, size_t size, size_t* bytesWritten) {
+    if(!m_file) {*bytesWritten = 0; return ESP_ERR_INVALID_STATE;}
+    if(m_file.position() < 44) writeHeader(); // begin() was not called
+    *bytesWritten = m_file.write((const uint8_t*)buff, size);
+    m_dataSize += *bytesWritten;
+    if(*bytesWritten < size) return ESP_FAIL;  // file system full
+    return ESP_OK;
+}
+
+void WavFileSink::end() {
+    if(!m_file) return;
+    writeHeader(); // now with the correct sizes
+    m_file.flush();
+}
+
+void WavFileSink::writeHeader() {
+    const uint16_t channels = 2, bitsPerSample = m_bitsPerSample, blockAlign = channels * bitsPerSample / 8;
+    const uint32_t byteRate = m_sampleRate * blockAlign, riffSize = 36 + m_dataSize;
+    uint8_t h[44];
+    memcpy(h +  0, "RIFF", 4); memcpy(h +  4, &riffSize, 4);      memcpy(h +  8, "WAVE", 4);
+    memcpy(h + 12, "fmt ", 4); h[16] = 16; h[17] = h[18] = h[19] = 0; // size of the fmt chunk
+    h[20] = 1; h[21] = 0;                                          // PCM
+    memcpy(h + 22, &channels, 2);      memcpy(h + 24, &m_sampleRate, 4); memcpy(h + 28, &byteRate, 4);
+    memcpy(h + 32, &blockAlign, 2);    memcpy(h + 34, &bitsPerSample, 2);
+    memcpy(h + 36, "data", 4); memcpy(h + 40, &m_dataSize, 4);      // little endian, as the ESP32
+    m_file.seek(0);
+    m_file.write(h, sizeof(h));
+    m_file.seek(44 + m_dataSize);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool WavFileSource::open(fs::FS& fs, const char* path) {
+    close();
+    m_file = fs.open(path);
+    if(!m_file) {log_e("%s not found", path); return false;}
+    uint8_t h[16];
+    if(m_file.read(h, 12) != 12 || memcmp(h, "RIFF", 4) || memcmp(h + 8, "WAVE", 4)) {log_e("%s is not a WAV file", path); close(); return false;}
+    uint16_t format = 0, bits = 0;
+    while(m_file.read(h, 8) == 8) { // chunk id, chunk size
+        uint32_t size = h[4] | (h[5] << 8) | (h[6] << 16) | (h[7] << 24);
+        if(!memcmp(h, "data", 4)) {
+            m_dataLeft = size;
+            if(format == 1 && bits == 16 && (m_channels == 1 || m_channels == 2) && m_sampleRate) return true;
+            log_e("%s: only 16 bit PCM, mono or stereo is supported", path);
+            break;
+        }
+        if(!memcmp(h, "fmt ", 4) && size >= 16) {
+            if(m_file.read(h, 16) != 16) break;
+            format = h[0] | (h[1] << 8);
+            m_channels = h[2];
+            m_sampleRate = h[4] | (h[5] << 8) | (h[6] << 16) | (h[7] << 24);
+            bits = h[14] | (h[15] << 8);
+            size -= 16;
+        }
+        m_file.seek(m_file.position() + size + (size & 1)); // chunks are word aligned
+    }
+    close();
+    return false;
+}
+
+uint16_t WavFileSource::read(int16_t* buff, uint16_t frames) {
+    if(!m_file || !m_dataLeft) return 0;
+    uint32_t bytes = min((uint32_t)frames * m_channels * 2, m_dataLeft);
+    int32_t  n = m_file.read((uint8_t*)buff, bytes); // little endian, as the ESP32
+    if(n <= 0) {m_dataLeft = 0; return 0;}
+    m_dataLeft -= n;
+    return n / (m_channels * 2);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint16_t MemorySource::read(int16_t* buff, uint16_t frames) {
+    if(m_pos == m_frames && m_f_loop) m_pos = 0;
+    uint32_t n = min((uint32_t)frames, m_frames - m_pos);
+    memcpy(buff, m_pcm + m_pos * m_channels, n * m_channels * sizeof(int16_t));
+    m_pos += n;
+    return n;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Mp3Source::open(fs::FS& fs, const char* path) {
+    close();
+    m_file = fs.open(path);
+    if(!m_file) {log_e("%s not found", path); return false;}
+    return begin();
+}
+
+bool Mp3Source::open(uint8_t* mp3, uint32_t len) {
+    close();
+    m_mem = mp3;
+    m_memLen = len;
+    return begin();
+}
+
+bool Mp3Source::begin() {
+    m_channels = 0;
+    m_sampleRate = 0;
+    m_decoder = MP3Decoder_AllocateBuffers();
+    m_in = (uint8_t*)(psramFound() ? ps_malloc(IN_SIZE) : malloc(IN_SIZE));
+    m_pcm = (int16_t*)(psramFound() ? ps_malloc(1152 * 2 * sizeof(int16_t)) : malloc(1152 * 2 * sizeof(int16_t)));
+    if(!m_decoder || !m_in || !m_pcm) {log_e("not enough memory for the mp3 source"); close(); return false;}
+    fill();
+    if(m_inLen >= 10 && !memcmp(m_in, "ID3", 3)) { // skip the ID3v2 tag, the size is syncsafe
+        uint32_t tagSize = 10 + ((m_in[6] & 0x7F) << 21 | (m_in[7] & 0x7F) << 14 | (m_in[8] & 0x7F) << 7 | (m_in[9] & 0x7F));
+        while(tagSize && m_inLen) {
+            uint32_t n = min(tagSize, (uint32_t)m_inLen);
+            consume(n);
+            tagSize -= n;
+            fill();
+        }
+    }
+    if(!decodeFrame()) {log_e("no mp3 frame found"); close(); return false;}
+    return true;
+}
+
+void Mp3Source::close() {
+    if(m_file) m_file.close();
+    if(m_mem) {free(m_mem); m_mem = NULL;}
+    if(m_in) {free(m_in); m_in = NULL;}
+    if(m_pcm) {free(m_pcm); m_pcm = NULL;}
+    MP3Decoder_FreeBuffers(m_decoder);
+    m_decoder = NULL;
+    m_memLen = m_memPos = 0;
+    m_inLen = m_pcmFrames = m_pcmPos = 0;
+}
+
+uint32_t Mp3Source::fill() {
+    uint32_t n = 0;
+    if(m_mem) {
+        n = min((uint32_t)(IN_SIZE - m_inLen), m_memLen - m_memPos);
+        memcpy(m_in + m_inLen, m_mem + m_memPos, n);
+        m_memPos += n;
     }
-    if(m_readPtr < m_writePtr) {
-        m_freeSpace = (m_endPtr - m_writePtr) + (m_readPtr - m_buffer);
+    else if(m_file) {
+        int32_t r = m_file.read(m_in + m_inLen, IN_SIZE - m_inLen);
+        if(r > 0) n = r;
     }
-    if(m_readPtr > m_writePtr) {
-        m_freeSpace = m_readPtr - m_writePtr;
+    m_inLen += n;
+    return n;
+}
+
+void Mp3Source::consume(uint32_t bytes) {
+    m_inLen -= bytes;
+    memmove(m_in, m_in + bytes, m_inLen);
+}
+
+bool Mp3Source::decodeFrame() {
+    // same error handling as Audio::sendBytes(): skip one byte and search the next syncword
+    while(true) {
+        fill();
+        if(!m_inLen) return false;
+        int32_t nextSync = MP3FindSyncWord(m_in, m_inLen);
+        if(nextSync < 0) { // keep the last bytes, the syncword can be split
+            if(m_inLen < IN_SIZE) return false; // nothing more to read
+            consume(m_inLen - 3);
+            continue;
+        }
+        consume(nextSync);
+        int32_t bytesLeft = m_inLen;
+        int32_t ret = MP3Decode(m_decoder, m_in, &bytesLeft, m_pcm, 0);
+        int32_t bytesDecoded = m_inLen - bytesLeft;
+        if(ret < 0 || bytesDecoded == 0) {consume(1); continue;}
+        consume(bytesDecoded);
+        uint8_t ch = MP3GetChannels(m_decoder);
+        if(ch != 1 && ch != 2) continue;
+        if(m_channels && ch != m_channels) {log_w("mp3 source: the number of channels changed"); return false;}
+        m_channels = ch;
+        m_sampleRate = MP3GetSampRate(m_decoder);
+        m_pcmFrames = MP3GetOutputSamps(m_decoder) / ch;
+        m_pcmPos = 0;
+        if(m_pcmFrames) return true;
     }
-    return m_freeSpace;
 }
 
-size_t AudioBuffer::writeSpace() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_writeSpace = m_endPtr - m_writePtr;
-        else m_writeSpace = 0;
+uint16_t Mp3Source::read(int16_t* buff, uint16_t frames) {
+    uint16_t n = 0;
+    while(n < frames && m_decoder) {
+        if(m_pcmPos == m_pcmFrames && !decodeFrame()) {close(); break;} // end of data, free the memory at once
+        uint16_t k = min((uint16_t)(frames - n), (uint16_t)(m_pcmFrames - m_pcmPos));
+        memcpy(buff + n * m_channels, m_pcm + m_pcmPos * m_channels, k * m_channels * sizeof(int16_t));
+        n += k;
+        m_pcmPos += k;
     }
-    if(m_readPtr < m_writePtr) {
-        m_writeSpace = m_endPtr - m_writePtr;
+    return n;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool AudioFileCache::begin(fs::FS& fs, const char* dir, uint32_t maxBytes) {
+    end();
+    if(!dir || strlen(dir) >= sizeof(m_dir) - 1) return false;
+    strcpy(m_dir, dir);
+    if(!fs.exists(m_dir) && !fs.mkdir(m_dir)) {log_e("can't create %s", m_dir); return false;}
+    m_fs = &fs;
+    m_maxBytes = maxBytes;
+
+    struct found_t { uint64_t key; uint32_t size; time_t t; };
+    std::vector<found_t>  found;
+    std::vector<uint64_t> leftovers; // .tmp files of interrupted downloads
+    File root = fs.open(m_dir);
+    File file = root.openNextFile();
+    while(file) {
+        const char* name = strrchr(file.name(), '/'); name = name ? name + 1 : file.name();
+        char* end = NULL;
+        uint64_t k = strtoull(name, &end, 16);
+        if(end == name + 16 && !strcmp(end, ".mp3")) found.push_back({k, (uint32_t)file.size(), file.getLastWrite()});
+        if(end == name + 16 && !strcmp(end, ".tmp")) leftovers.push_back(k);
+        file = root.openNextFile();
+    }
+    root.close();
+    for(auto k : leftovers) fs.remove(path(k, true));
+    std::sort(found.begin(), found.end(), [](const found_t& a, const found_t& b) { return a.t < b.t; }); // oldest first
+    for(auto& f : found) {
+        m_entries.push_back({f.key, f.size, ++m_useCounter});
+        m_bytes += f.size;
+    }
+    evict();
+    return true;
+}
+
+void AudioFileCache::end() {
+    m_fs = NULL;
+    m_entries.clear(); m_entries.shrink_to_fit();
+    m_bytes = 0;
+    m_useCounter = 0;
+}
+
+uint64_t AudioFileCache::key(const char* a, const char* b, const char* c) {
+    uint64_t h = 14695981039346656037ULL;
+    const char* str[3] = {a, b, c};
+    for(int i = 0; i < 3; i++) {
+        for(const char* p = str[i] ? str[i] : ""; ; p++) { // the terminating zero separates the strings
+            h = (h ^ (uint8_t)*p) * 1099511628211ULL;
+            if(!*p) break;
+        }
     }
-    if(m_readPtr > m_writePtr) {
-        m_writeSpace = m_readPtr - m_writePtr;
+    return h;
+}
+
+const char* AudioFileCache::path(uint64_t key, bool tmp) {
+    snprintf(m_path, sizeof(m_path), "%s/%08lx%08lx.%s", m_dir, (unsigned long)(key >> 32), (unsigned long)(key & 0xFFFFFFFF), tmp ? "tmp" : "mp3");
+    return m_path;
+}
+
+bool AudioFileCache::lookup(uint64_t key) {
+    if(!m_fs) return false;
+    for(auto& e : m_entries) {
+        if(e.key != key) continue;
+        if(!m_fs->exists(path(key))) break; // deleted from outside
+        e.lastUse = ++m_useCounter;
+        return true;
     }
-    return m_writeSpace;
+    return false;
 }
 
-size_t AudioBuffer::bufferFilled() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_dataLength = 0;
-        else m_dataLength = m_buffSize;
+File AudioFileCache::create(uint64_t key) {
+    if(!m_fs) return File();
+    return m_fs->open(path(key, true), FILE_WRITE);
+}
+
+void AudioFileCache::commit(uint64_t key, File& file) {
+    if(!m_fs || !file) return;
+    uint32_t size = file.size();
+    file.close();
+    if(!size) {m_fs->remove(path(key, true)); return;}
+    char tmpPath[sizeof(m_path)];
+    strcpy(tmpPath, path(key, true));
+    m_fs->remove(path(key));
+    if(!m_fs->rename(tmpPath, path(key))) {m_fs->remove(tmpPath); return;}
+    for(size_t i = 0; i < m_entries.size(); i++) {
+        if(m_entries[i].key == key) {m_bytes -= m_entries[i].size; m_entries.erase(m_entries.begin() + i); break;}
+    }
+    m_entries.push_back({key, size, ++m_useCounter});
+    m_bytes += size;
+    evict();
+}
+
+void AudioFileCache::discard(uint64_t key, File& file) {
+    if(!file) return;
+    file.close();
+    if(m_fs) m_fs->remove(path(key, true));
+}
+
+void AudioFileCache::evict() {
+    while(m_bytes > m_maxBytes && m_entries.size() > 1) { // the newest entry stays, even if it is too big on its own
+        size_t lru = 0;
+        for(size_t i = 1; i < m_entries.size(); i++) {
+            if(m_entries[i].lastUse < m_entries[lru].lastUse) lru = i;
+        }
+        m_fs->remove(path(m_entries[lru].key));
+        m_bytes -= m_entries[lru].size;
+        m_entries.erase(m_entries.begin() + lru);
     }
-    if(m_readPtr < m_writePtr) {
-        m_dataLength = m_writePtr - m_readPtr;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool HLSSegmentCache::begin(uint8_t maxSegments, uint32_t maxBytes) {
+    end();
+    if(!psramFound()) {log_e("HLS prefetch needs PSRAM"); return false;}
+    m_maxSegments = maxSegments;
+    m_maxBytes = maxBytes;
+    m_clientSecure.setInsecure();
+    return true;
+}
+
+void HLSSegmentCache::end() {
+    reset();
+    m_maxSegments = 0;
+}
+
+void HLSSegmentCache::reset() {
+    while(m_segs.size()) erase(m_segs.size() - 1);
+    m_segs.shrink_to_fit();
+    if(m_net) m_net->stop();
+    m_net = NULL;
+    uint8_t conn = m_connState;
+    if(conn == CONN_READY) m_connNet->stop();
+    if(conn != CONN_RUNNING) m_connState.compare_exchange_strong(conn, CONN_IDLE); // a running connect() is dropped later
+    m_host[0] = '\0';
+    m_bytes = 0;
+}
+
+bool HLSSegmentCache::request(const char* url) {
+    if(!isEnabled() || !url) return false;
+    if(find(url) >= 0) return true; // already known
+    if(m_segs.size() - (m_f_serving ? 1 : 0) >= m_maxSegments) return false;
+    m_segs.push_back({strdup(url), NULL, 0, 0, -1, SEG_LOADING});
+    return true;
+}
+
+int8_t HLSSegmentCache::state(const char* url) {
+    int idx = find(url);
+    return idx < 0 ? SEG_UNKNOWN : m_segs[idx].state;
+}
+
+void HLSSegmentCache::drop(const char* url) {
+    int idx = find(url);
+    if(idx >= 0 && !(m_f_serving && idx == 0)) erase(idx);
+}
+
+int HLSSegmentCache::find(const char* url) {
+    if(!url) return -1;
+    for(int i = 0; i < m_segs.size(); i++) {
+        if(!strcmp(m_segs[i].url, url)) return i;
     }
-    if(m_readPtr > m_writePtr) {
-        m_dataLength = (m_endPtr - m_readPtr) + (m_writePtr - m_buffer);
+    return -1;
+}
+
+void HLSSegmentCache::erase(int idx) {
+    if(idx == m_dlIdx) { // the rest of the response is still on the way, the connection can't be used again
+        if(m_net) m_net->stop();
+        m_dlIdx = -1;
+        m_dlState = DL_IDLE;
+    }
+    else if(idx < m_dlIdx) m_dlIdx--;
+    if(idx == 0 && m_f_serving) {m_f_serving = false; m_readPos = 0;}
+    free(m_segs[idx].url);
+    if(m_segs[idx].data) free(m_segs[idx].data);
+    m_bytes -= m_segs[idx].capacity;
+    m_segs.erase(m_segs.begin() + idx);
+}
+
+bool HLSSegmentCache::grow(seg_t& s, uint32_t need) {
+    if(need <= s.capacity) return true;
+    uint32_t cap = (s.length >= 0) ? need : max(need, s.capacity + 32768); // unknown length: grow in steps
+    if(m_bytes - s.capacity + cap > m_maxBytes) {log_w("HLS prefetch: segment does not fit into %lu bytes", (long unsigned)m_maxBytes); return false;}
+    uint8_t* p = (uint8_t*)ps_realloc(s.data, cap);
+    if(!p) return false;
+    m_bytes += cap - s.capacity;
+    s.data = p;
+    s.capacity = cap;
+    return true;
+}
+
+bool HLSSegmentCache::startDownload(seg_t& s, bool mayConnect) {
+    bool ssl = !strncmp(s.url, "https://", 8);
+    if(!ssl && strncmp(s.url, "http://", 7)) {s.state = SEG_FAILED; return false;}
+    const char* h = s.url + (ssl ? 8 : 7);
+    const char* path = strchr(h, '/');
+    size_t hostLen = path ? path - h : strlen(h);
+    char host[sizeof(m_host)];
+    if(hostLen >= sizeof(host)) {s.state = SEG_FAILED; return false;}
+    memcpy(host, h, hostLen);
+    host[hostLen] = '\0';
+    uint16_t port = ssl ? 443 : 80;
+    char* colon = strchr(host, ':');
+    if(colon) {*colon = '\0'; port = atoi(colon + 1);}
+
+    audioClient_t* net = ssl ? static_cast<audioClient_t*>(&m_clientSecure) : &m_client;
+    bool sameConn = (net == m_connNet && port == m_connPort && !strcmp(host, m_connHost));
+    if(m_connState == CONN_READY) { // connected by connectPending()
+        m_connState = CONN_IDLE;
+        if(sameConn) {m_net = net; strcpy(m_host, host); m_port = port;}
+        else m_connNet->stop(); // reset() in between, another host now
+    }
+    else if(m_connState == CONN_FAILED) {
+        m_connState = CONN_IDLE;
+        if(sameConn) {log_w("HLS prefetch: can't connect to %s", host); s.state = SEG_FAILED; return false;}
+    }
+    if(net != m_net || port != m_port || strcmp(host, m_host) || !net->connected()) { // no keep-alive connection to reuse
+        if(m_connState == CONN_RUNNING) return false; // connectPending() is busy
+        if(m_connState == CONN_WANTED) {
+            uint8_t wanted = CONN_WANTED;
+            if(!mayConnect || !m_connState.compare_exchange_strong(wanted, CONN_IDLE)) return false; // left to connectPending()
+        }
+        if(m_net) m_net->stop();
+        if(!mayConnect) { // the network task connects without holding the Audio mutex, see connectPending()
+            m_net = NULL;
+            m_connNet = net;
+            strcpy(m_connHost, host);
+            m_connPort = port;
+            m_connState = CONN_WANTED;
+            return false;
+        }
+        m_net = net;
+        if(!m_net->connect(host, port)) {
+            log_w("HLS prefetch: can't connect to %s", host);
+            m_net = NULL;
+            s.state = SEG_FAILED;
+            return false;
+        }
+        strcpy(m_host, host);
+        m_port = port;
     }
-    return m_dataLength;
+    m_net->printf("GET %s HTTP/1.1\r\nHost: %s\r\nAccept: */*\r\nUser-Agent: VLC/3.0.21 LibVLC/3.0.21\r\n"
+                  "Accept-Encoding: identity;q=1,*;q=0\r\nConnection: keep-alive\r\n\r\n", path ? path : "/", host);
+    s.length = -1;
+    s.size = 0;
+    m_status = 0;
+    m_linePos = 0;
+    m_f_chunked = false;
+    m_f_keepAlive = true;
+    m_dlState = DL_HEADER;
+    m_dlTime = millis();
+    return true;
 }
 
-size_t AudioBuffer::getMaxAvailableBytes() {
-    if(m_readPtr == m_writePtr) {
-    //   if(m_f_start)m_dataLength = 0;
-        if(m_f_isEmpty == true) m_dataLength = 0;
-        else m_dataLength = (m_endPtr - m_readPtr);
+bool HLSSegmentCache::readLine() {
+    while(m_net->available()) {
+        char c = m_net->read();
+        if(c == '\r') continue;
+        if(c == '\n') {m_line[m_linePos] = '\0'; m_linePos = 0; return true;}
+        if(m_linePos < sizeof(m_line) - 1) m_line[m_linePos++] = c; // longer header lines are not of interest
     }
-    if(m_readPtr < m_writePtr) {
-        m_dataLength = m_writePtr - m_readPtr;
+    return false;
+}
+
+void HLSSegmentCache::finish(bool ok) {
+    seg_t& s = m_segs[m_dlIdx];
+    s.state = ok ? SEG_COMPLETE : SEG_FAILED;
+    if(!ok) {
+        if(s.data) free(s.data);
+        m_bytes -= s.capacity;
+        s.data = NULL;
+        s.size = s.capacity = 0;
+    }
+    if(!ok || !m_f_keepAlive) m_net->stop();
+    m_dlIdx = -1;
+    m_dlState = DL_IDLE;
+}
+
+bool HLSSegmentCache::connectPending() {
+    // network task, without the Audio mutex. In CONN_RUNNING nothing else touches m_connNet, reset() leaves it alone
+    // and startDownload() waits for the result
+    uint8_t wanted = CONN_WANTED;
+    if(!m_connState.compare_exchange_strong(wanted, CONN_RUNNING)) return false;
+    bool ok = m_connNet->connect(m_connHost, m_connPort);
+    m_connState = ok ? CONN_READY : CONN_FAILED;
+    return ok;
+}
+
+void HLSSegmentCache::loop(bool mayConnect) {
+    if(!isEnabled()) return;
+    if(m_dlState == DL_IDLE) {
+        for(int i = 0; i < m_segs.size(); i++) {
+            if(m_segs[i].state != SEG_LOADING) continue;
+            if(startDownload(m_segs[i], mayConnect)) m_dlIdx = i;
+            break; // strictly in the order of request()
+        }
+        if(m_dlIdx < 0) return;
     }
-    if(m_readPtr > m_writePtr) {
-        m_dataLength = (m_endPtr - m_readPtr);
+
+    while(m_dlState != DL_IDLE) {
+        seg_t& s = m_segs[m_dlIdx];
+        int av = m_net->available();
+        if(av <= 0) {
+            if(!m_net->connected()) finish(m_dlState == DL_BODY && s.length < 0); // "Connection: close" without Content-Length
+            else if(millis() - m_dlTime > 4500) {log_w("HLS prefetch: timeout"); finish(false);}
+            return;
+        }
+        m_dlTime = millis();
+        int res = 0;
+        switch(m_dlState) {
+            case DL_HEADER:
+                if(!readLine()) break;
+                if(!m_status) { // "HTTP/1.1 200 OK"
+                    const char* sp = strchr(m_line, ' ');
+                    m_status = sp ? atoi(sp + 1) : -1;
+                    if(m_status != 200) {log_w("HLS prefetch: HTTP %i for %s", m_status, s.url); finish(false); return;}
+                    break;
+                }
+                if(m_line[0]) {
+                    for(char* p = m_line; *p && *p != ':'; p++) *p = tolower(*p);
+                    if(!strncmp(m_line, "content-length:", 15)) s.length = atoi(m_line + 15);
+                    if(!strncmp(m_line, "transfer-encoding:", 18) && strstr(m_line, "chunked")) m_f_chunked = true;
+                    if(!strncmp(m_line, "connection:", 11) && strstr(m_line, "close")) m_f_keepAlive = false;
+                    break;
+                }
+                // end of the header
+                if(m_f_chunked) s.length = -1;
+                if(s.length >= 0 && !grow(s, s.length)) {finish(false); return;}
+                if(s.length == 0) {finish(true); return;}
+                m_dlState = m_f_chunked ? DL_CHUNKSIZE : DL_BODY;
+                break;
+            case DL_BODY:
+            case DL_CHUNKDATA:
+                if(m_dlState == DL_CHUNKDATA) av = min((uint32_t)av, m_chunkLeft);
+                else if(s.length >= 0)        av = min((uint32_t)av, s.length - s.size);
+                if(!grow(s, s.size + av)) {finish(false); return;}
+                res = m_net->read(s.data + s.size, av);
+                if(res <= 0) return;
+                s.size += res;
+                if(m_dlState == DL_CHUNKDATA) {m_chunkLeft -= res; if(!m_chunkLeft) m_dlState = DL_CHUNKEND;}
+                else if(s.size == (uint32_t)s.length) {finish(true); return;}
+                break;
+            case DL_CHUNKSIZE:
+                if(!readLine()) break;
+                m_chunkLeft = strtoul(m_line, NULL, 16);
+                m_dlState = m_chunkLeft ? DL_CHUNKDATA : DL_TRAILER;
+                break;
+            case DL_CHUNKEND: // CRLF behind the chunk data
+                if(readLine()) m_dlState = DL_CHUNKSIZE;
+                break;
+            case DL_TRAILER:
+                if(readLine() && !m_line[0]) {finish(true); return;}
+                break;
+        }
     }
-    return m_dataLength;
 }
 
-void AudioBuffer::bytesWritten(size_t bw) {
-    if(!bw) return;
-    m_writePtr += bw;
-    if(m_writePtr == m_endPtr) { m_writePtr = m_buffer; }
-    if(m_writePtr > m_endPtr) log_e("m_writePtr %i, m_endPtr %i", m_writePtr, m_endPtr);
-    m_f_isEmpty = false;
+int32_t HLSSegmentCache::open(const char* url) {
+    if(m_f_serving) erase(0); // the previous segment is played
+    int idx = find(url);
+    if(idx < 0) return -1;
+    while(idx--) erase(0); // skipped
+    seg_t& s = m_segs[0];
+    bool usable = s.state == SEG_COMPLETE || (m_dlIdx == 0 && m_dlState == DL_BODY && s.length >= 0); // a running download can be read as it comes in
+    if(!usable) {erase(0); return -1;}
+    m_f_serving = true;
+    m_readPos = 0;
+    return s.state == SEG_COMPLETE ? s.size : s.length;
 }
 
-void AudioBuffer::bytesWasRead(size_t br) {
-    if(!br) return;
-    m_readPtr += br;
-    if(m_readPtr >= m_endPtr) {
-        size_t tmp = m_readPtr - m_endPtr;
-        m_readPtr = m_buffer + tmp;
+bool HLSSegmentCache::take(const char* url, uint8_t** data, uint32_t* size) {
+    int idx = find(url);
+    if(idx < 0 || m_segs[idx].state != SEG_COMPLETE || (m_f_serving && idx == 0)) return false;
+    *data = m_segs[idx].data;
+    *size = m_segs[idx].size;
+    m_bytes -= m_segs[idx].capacity;
+    m_segs[idx].data = NULL;
+    m_segs[idx].capacity = 0;
+    erase(idx);
+    return true;
+}
+
+int HLSSegmentCache::available() {
+    return m_f_serving ? m_segs[0].size - m_readPos : 0;
+}
+
+int HLSSegmentCache::read() {
+    if(available() <= 0) return -1;
+    return m_segs[0].data[m_readPos++];
+}
+
+int HLSSegmentCache::read(uint8_t* buf, size_t size) {
+    size_t n = min(size, (size_t)available());
+    if(n) memcpy(buf, m_segs[0].data + m_readPos, n);
+    m_readPos += n;
+    return n;
+}
+
+int HLSSegmentCache::peek() {
+    if(available() <= 0) return -1;
+    return m_segs[0].data[m_readPos];
+}
+
+uint8_t HLSSegmentCache::connected() {
+    return m_f_serving && (m_segs[0].state == SEG_LOADING || m_readPos < m_segs[0].size);
+}
+
+void HLSSegmentCache::stop() {
+    if(m_f_serving) erase(0);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SpectrumAnalyzer::begin(uint8_t bands, uint8_t decay, bool window) {
+    end();
+    if(bands > MAX_BANDS) bands = MAX_BANDS;
+    if(!bands) return false;
+    m_samples = (int32_t*)malloc(2 * FFT_SIZE * sizeof(int32_t)); // internal RAM, the FFT runs in the audio task
+    m_bins = (int32_t*)malloc(2 * (FFT_SIZE + 1) * sizeof(int32_t));
+    if(window) m_window = (int16_t*)malloc(2 * FFT_SIZE * sizeof(int16_t));
+    if(!m_samples || !m_bins || (window && !m_window)) {log_e("oom"); end(); return false;}
+
+    if(m_window) for(int i = 0; i < 2 * FFT_SIZE; i++) { m_window[i] = (int16_t)(16383.5f - 16383.5f * cosf(2 * PI * i / (2 * FFT_SIZE))); }
+
+    // logarithmic band edges from bin 1 (DC is left out) to bin FFT_SIZE (Nyquist), at least one bin per band
+    m_edges[0] = 1;
+    for(int b = 1; b <= bands; b++) {
+        int e = lroundf(powf(FFT_SIZE + 1, (float)b / bands));
+        e = max(e, m_edges[b - 1] + 1);
+        e = min(e, FFT_SIZE + 1 - (bands - b));
+        m_edges[b] = e;
+    }
+    memset(m_levels, 0, sizeof(m_levels));
+    m_decay = decay;
+    m_decimCnt = 0;
+    m_decimSum = 0;
+    m_nSamples = 0;
+    m_sampleRate = 0;
+    m_seq = 0;
+    m_bands = bands;
+    return true;
+}
+
+void SpectrumAnalyzer::end() {
+    m_bands = 0;
+    if(m_samples) {free(m_samples); m_samples = NULL;}
+    if(m_bins)    {free(m_bins);    m_bins = NULL;}
+    if(m_window)  {free(m_window);  m_window = NULL;}
+}
+
+void SpectrumAnalyzer::feed(const void* buff, uint16_t frames, bool wide, uint32_t sampleRate) {
+    if(!m_bands) return;
+    if(sampleRate != m_sampleRate) {
+        m_sampleRate = sampleRate;
+        m_decimation = max((sampleRate + 11025) / 22050, (uint32_t)1);
+        m_decimCnt = 0;
+        m_decimSum = 0;
+        m_nSamples = 0;
+    }
+    for(uint16_t i = 0; i < 2 * frames; i += 2) { // left + right
+        if(wide) m_decimSum += (((const int32_t*)buff)[i] >> 12) + (((const int32_t*)buff)[i + 1] >> 12); // 20 bits are enough
+        else     m_decimSum += (((const int16_t*)buff)[i] << 4)   + (((const int16_t*)buff)[i + 1] << 4);
+        if(++m_decimCnt < m_decimation) continue;
+        m_samples[m_nSamples++] = m_decimSum / (2 * m_decimation);
+        m_decimCnt = 0;
+        m_decimSum = 0;
+        if(m_nSamples == 2 * FFT_SIZE) {
+            compute();
+            m_nSamples = 0;
+        }
     }
-    if(m_readPtr == m_writePtr) m_f_isEmpty = true;
 }
 
-uint8_t* AudioBuffer::getWritePtr() { return m_writePtr; }
+void SpectrumAnalyzer::compute() {
+    const uint8_t bands = m_bands;
+    if(m_window) for(int i = 0; i < 2 * FFT_SIZE; i++) { m_samples[i] = ((int64_t)m_samples[i] * m_window[i]) >> 15; }
+    OPUSrealFFT(m_samples, m_bins, 2 * FFT_SIZE);
+
+    // a full scale sine (1 << 19) gives a bin of 2^19 * 480 / 2, the Hann window halves it
+    const float ref = (float)(1 << 19) * FFT_SIZE / (m_window ? 2 : 1);
+    const float refPow = ref * ref;
+    const uint32_t seq = m_seq.load(std::memory_order_relaxed);
+    const uint8_t* prev = m_levels[seq & 1];
+    uint8_t*       next = m_levels[(seq + 1) & 1]; // back buffer
+    for(uint8_t b = 0; b < bands; b++) {
+        float p = 0;
+        for(int k = m_edges[b]; k < m_edges[b + 1]; k++) {
+            float re = m_bins[2 * k], im = m_bins[2 * k + 1];
+            p += re * re + im * im;
+        }
+        int32_t level = (p > 0) ? 255 + lroundf(42.5f * log10f(p / refPow)) : 0; // 255 / 60dB * 10 * log10(p)
+        level = min(max(level, (int32_t)0), (int32_t)255);
+        if(m_decay && prev[b] > level + m_decay) level = prev[b] - m_decay;
+        next[b] = level;
+    }
+    m_seq.store(seq + 1, std::memory_order_release);
+}
 
-uint8_t* AudioBuffer::getReadPtr() {
-    int32_t len = m_endPtr - m_readPtr;
-    if(len < m_maxBlockSize) {                            // be sure the last frame is completed
-        memcpy(m_endPtr, m_buffer, m_maxBlockSize - (len)); // cpy from m_buffer to m_endPtr with len
+uint8_t SpectrumAnalyzer::read(uint8_t* levels) {
+    // the audio task writes only into the back buffer, which becomes the front buffer with the next m_seq,
+    // if m_seq has changed while copying, the copy may be torn and is repeated
+    uint32_t seq;
+    uint8_t  bands;
+    do {
+        seq = m_seq.load(std::memory_order_acquire);
+        bands = m_bands;
+        if(!seq || !bands) return 0;
+        memcpy(levels, m_levels[seq & 1], bands);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while(seq != m_seq.load(std::memory_order_relaxed));
+    return bands;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int AudioMixer::find(AudioSource* src) {
+    for(int i = 0; i < MAX_SOURCES; i++) {
+        if(src && m_slots[i].src == src) return i;
     }
-    return m_readPtr;
+    return -1;
 }
 
-void AudioBuffer::resetBuffer() {
-    m_writePtr = m_buffer;
-    m_readPtr = m_buffer;
-    m_endPtr = m_buffer + m_buffSize;
-    m_f_isEmpty = true;
+bool AudioMixer::add(AudioSource* src, uint8_t gain, bool voice) {
+    if(!src || find(src) >= 0) return false;
+    for(int i = 0; i < MAX_SOURCES; i++) {
+        slot_t& s = m_slots[i];
+        if(s.src) continue;
+        memset(&s, 0, sizeof(s));
+        s.src = src;
+        s.voice = voice;
+        s.target = (int32_t)((int64_t)min(gain, (uint8_t)100) * (1 << 30) / 100); // fades in from 0
+        m_active |= (1 << i);
+        return true;
+    }
+    log_w("mixer: no free slot");
+    return false;
+}
+
+void AudioMixer::remove(AudioSource* src, bool fade) {
+    int i = find(src);
+    if(i < 0) return;
+    if(!fade) {release(m_slots[i]); return;}
+    m_slots[i].target = 0;
+    m_slots[i].f_removing = true;
+}
+
+void AudioMixer::setGain(AudioSource* src, uint8_t gain) {
+    int i = find(src);
+    if(i < 0 || m_slots[i].f_removing) return;
+    m_slots[i].target = (int32_t)((int64_t)min(gain, (uint8_t)100) * (1 << 30) / 100);
 }
 
-uint32_t AudioBuffer::getWritePos() { return m_writePtr - m_buffer; }
+void AudioMixer::setDucking(uint8_t gain, uint16_t attackMs, uint16_t releaseMs) {
+    m_duckTarget = (int32_t)((int64_t)min(gain, (uint8_t)100) * (1 << 30) / 100);
+    m_attackMs = attackMs;
+    m_releaseMs = releaseMs;
+}
 
-uint32_t AudioBuffer::getReadPos() { return m_readPtr - m_buffer; }
+bool AudioMixer::nextFrame(slot_t& s, int16_t* frame) {
+    if(s.pos == s.n) {
+        s.n = s.src->read(s.buf, CHUNK);
+        s.pos = 0;
+        if(!s.n) return false;
+    }
+    if(s.src->channels() == 2) {
+        frame[0] = s.buf[2 * s.pos];
+        frame[1] = s.buf[2 * s.pos + 1];
+    }
+    else {
+        frame[0] = frame[1] = s.buf[s.pos];
+    }
+    s.pos++;
+    return true;
+}
+
+template <typename T> void AudioMixer::process(T* buff, uint16_t frames, uint32_t sampleRate) {
+    // T is int16_t or left justified int32_t, the sources are added with 16 bits in both cases
+    const bool    wide = sizeof(T) == sizeof(int32_t);
+    const int64_t maxVal = wide ? INT32_MAX : INT16_MAX, minVal = wide ? INT32_MIN : INT16_MIN;
+    if(!sampleRate) return;
+
+    bool     f_voice = false;
+    uint32_t inc[MAX_SOURCES];  // ratio of the sample rates, 1.0 = 65536
+    for(int i = 0; i < MAX_SOURCES; i++) {
+        slot_t& s = m_slots[i];
+        if(!s.src) continue;
+        if(s.voice && !s.f_removing) f_voice = true;
+        s.step = (int32_t)(((int64_t)1 << 30) * 1000 / ((int64_t)RAMP_MS * sampleRate)); // 0 ... 1 in RAMP_MS
+        inc[i] = (uint32_t)(((uint64_t)s.src->sampleRate() << 16) / sampleRate);
+        if(!s.f_primed) {s.f_primed = true; if(!nextFrame(s, s.b)) {release(s); continue;}}
+    }
+    const int32_t duckTarget = f_voice ? m_duckTarget : (1 << 30);
+    const int32_t duckStep = (int32_t)(((int64_t)1 << 30) * 1000 / ((int64_t)max(f_voice ? m_attackMs : m_releaseMs, (uint16_t)1) * sampleRate));
+
+    for(uint16_t f = 0; f < frames; f++) {
+        if(m_duckGain != duckTarget) {
+            if(m_duckGain < duckTarget) m_duckGain = min(m_duckGain + duckStep, duckTarget);
+            else                        m_duckGain = max(m_duckGain - duckStep, duckTarget);
+        }
+        int64_t acc[2];
+        for(int c = 0; c < 2; c++) acc[c] = ((int64_t)buff[2 * f + c] * (m_duckGain >> 15)) >> 15; // music bus
+
+        for(int i = 0; i < MAX_SOURCES; i++) {
+            slot_t& s = m_slots[i];
+            if(!s.src) continue;
+            if(s.gain != s.target) {
+                if(s.gain < s.target) s.gain = min(s.gain + s.step, s.target);
+                else                  s.gain = max(s.gain - s.step, s.target);
+            }
+            if(s.f_removing && s.gain == 0) {release(s); continue;}
+            const int32_t g = s.gain >> 15;     // Q15
+            const int32_t frac = s.frac >> 1;   // Q15, (b - a) * frac fits into 32 bits
+            for(int c = 0; c < 2; c++) {
+                int32_t smp = s.a[c] + (((s.b[c] - s.a[c]) * frac) >> 15);
+                acc[c] += wide ? ((int64_t)smp * g) << 1 : (smp * g) >> 15;
+            }
+            s.frac += inc[i];
+            while(s.frac >= 65536) {
+                s.frac -= 65536;
+                s.a[0] = s.b[0];
+                s.a[1] = s.b[1];
+                if(!nextFrame(s, s.b)) {release(s); break;}
+            }
+        }
+        for(int c = 0; c < 2; c++) buff[2 * f + c] = (T)min(max(acc[c], minVal), maxVal);
+    }
+    if(m_duckGain != (1 << 30)) m_active |= 0x80;
+    else m_active &= ~0x80;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Resampler::begin(uint32_t outRate, uint8_t quality) {
+    end();
+    if(!outRate) return false;
+    static const uint8_t  taps[4]   = {2, 8, 16, 32};
+    static const uint16_t phases[4] = {0, 32, 64, 64};
+    m_quality = min(quality, (uint8_t)3);
+    m_taps = taps[m_quality];
+    m_phases = phases[m_quality];
+    m_out = malloc(OUT_FRAMES * 2 * sizeof(int32_t)); // internal RAM, large enough for both sample widths
+    if(m_phases) m_table = (int16_t*)malloc((m_phases + 1) * m_taps * sizeof(int16_t));
+    if(!m_out || (m_phases && !m_table)) {log_e("oom"); end(); return false;}
+    m_outRate = outRate;
+    m_inRate = 0; // the table is calculated in setInputRate()
+    reset();
+    return true;
+}
+
+void Resampler::end() {
+    m_outRate = 0;
+    if(m_out)   {free(m_out);   m_out = NULL;}
+    if(m_table) {free(m_table); m_table = NULL;}
+    m_outFrames = m_outPos = 0;
+}
+
+void Resampler::reset() {
+    memset(m_hist, 0, sizeof(m_hist));
+    m_histPos = 0;
+    m_frac = 0;
+    m_need = 1;
+    m_outFrames = m_outPos = 0;
+}
+
+void Resampler::setInputRate(uint32_t inRate) {
+    if(!m_outRate || !inRate || inRate == m_inRate) return;
+    m_inRate = inRate;
+    uint64_t step = ((uint64_t)inRate << 32) / m_outRate;
+    m_stepInt = step >> 32;
+    m_stepFrac = (uint32_t)step;
+    if(m_table) calcTable();
+    reset();
+}
+
+void Resampler::calcTable() {
+    // windowed sinc (Kaiser), row p is the filter for the position p / m_phases between two input frames,
+    // every row is normalized to a DC gain of 1.0, the cutoff is below the Nyquist frequency of the lower rate
+    static const float beta[4] = {0, 5.0f, 6.5f, 8.0f}, rolloff[4] = {0, 0.90f, 0.93f, 0.95f};
+    auto bessel_I0 = [](float x) { // lambda, modified Bessel function of the first kind
+        float sum = 1, term = 1;
+        for(int k = 1; k < 25; k++) { term *= (x / (2 * k)) * (x / (2 * k)); sum += term; }
+        return sum;
+    };
+    const float fc = 0.5f * min(1.0f, (float)m_outRate / m_inRate) * rolloff[m_quality]; // cycles per input sample
+    const float i0Beta = bessel_I0(beta[m_quality]);
+    const float half = m_taps / 2;
+    float h[MAX_TAPS];
+    for(int p = 0; p <= m_phases; p++) {
+        float sum = 0;
+        for(int k = 0; k < m_taps; k++) {
+            float t = k + 1 - half - (float)p / m_phases;  // distance to the output position in input samples
+            float x = t / half;
+            float w = (fabsf(x) < 1) ? bessel_I0(beta[m_quality] * sqrtf(1 - x * x)) / i0Beta : 0;
+            float si = (t == 0) ? 1 : sinf(2 * PI * fc * t) / (2 * PI * fc * t);
+            h[k] = 2 * fc * si * w;
+            sum += h[k];
+        }
+        for(int k = 0; k < m_taps; k++) m_table[p * m_taps + k] = (int16_t)lroundf(h[k] / sum * 16384);
+    }
+}
+
+template <typename T> uint16_t Resampler::process(const T* in, uint16_t inFrames, uint16_t* used) {
+    // T is int16_t or left justified int32_t, the output has the same format
+    // int16_t: the sum of the products fits into 32 bits (sum of |coefficients| < 4)
+    typedef typename std::conditional<sizeof(T) == sizeof(int16_t), int32_t, int64_t>::type acc_t;
+    const acc_t maxVal = sizeof(T) == sizeof(int16_t) ? INT16_MAX : INT32_MAX, minVal = sizeof(T) == sizeof(int16_t) ? INT16_MIN : INT32_MIN;
+    T*       out = (T*)m_out;
+    uint16_t nIn = 0, nOut = 0;
+    const uint8_t taps = m_taps;
+
+    while(nOut < OUT_FRAMES) {
+        for(; m_need; m_need--) { // shift the next input frames into the history
+            if(nIn == inFrames) goto exit;
+            for(int c = 0; c < 2; c++) {
+                m_hist[c][m_histPos] = m_hist[c][m_histPos + taps] = in[2 * nIn + c];
+            }
+            if(++m_histPos == taps) m_histPos = 0;
+            nIn++;
+        }
+        for(int c = 0; c < 2; c++) {
+            const int32_t* x = &m_hist[c][m_histPos]; // oldest ... newest
+            acc_t y;
+            if(!m_table) { // linear
+                y = x[0] + (((acc_t)(x[1] - x[0]) * (acc_t)(m_frac >> 17)) >> 15);
+            }
+            else {
+                const uint64_t pp = (uint64_t)m_frac * m_phases;
+                const int16_t* c0 = m_table + (pp >> 32) * taps;
+                acc_t y0 = 0;
+                for(int k = 0; k < taps; k++) y0 += (acc_t)x[k] * c0[k];
+                const int16_t* c1 = c0 + taps; // interpolate between the rows p and p + 1
+                acc_t y1 = 0;
+                for(int k = 0; k < taps; k++) y1 += (acc_t)x[k] * c1[k];
+                y0 += (acc_t)(((int64_t)(y1 - y0) * (int64_t)((pp >> 17) & 0x7FFF)) >> 15);
+                y = y0 >> 14;
+            }
+            out[2 * nOut + c] = (T)min(max(y, minVal), maxVal);
+        }
+        nOut++;
+        uint64_t pos = (uint64_t)m_frac + m_stepFrac;
+        m_frac = (uint32_t)pos;
+        m_need = m_stepInt + (uint32_t)(pos >> 32);
+    }
+exit:
+    *used = nIn;
+    m_outFrames = nOut;
+    m_outPos = 0;
+    return nOut;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioMetrics::addMax(std::atomic<uint32_t>& max, uint32_t val) {
+    uint32_t m = max.load(std::memory_order_relaxed);
+    while(val > m && !max.compare_exchange_weak(m, val, std::memory_order_relaxed)) {}
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioMetrics::setCodec(uint8_t codec) {
+    if(m_codec.load(std::memory_order_relaxed) == codec) return;
+    for(int i = 0; i < HIST_BINS; i++) m_hist[i].store(0, std::memory_order_relaxed);
+    m_decodeFrames.store(0, std::memory_order_relaxed);
+    m_decodeSum.store(0, std::memory_order_relaxed);
+    m_decodeMax.store(0, std::memory_order_relaxed);
+    m_codec.store(codec, std::memory_order_relaxed);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioMetrics::addDecode(uint32_t cycles) {
+    int bin = 32 - __builtin_clz(cycles | 1) - HIST_SHIFT - 1; // 2^11...2^12 - 1 cycles: bin 0
+    bin = min(max(bin, 0), HIST_BINS - 1);
+    m_hist[bin].fetch_add(1, std::memory_order_relaxed);
+    m_decodeFrames.fetch_add(1, std::memory_order_relaxed);
+    m_decodeSum.fetch_add((cycles + 128) >> 8, std::memory_order_relaxed);
+    addMax(m_decodeMax, cycles);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioMetrics::addDsp(uint32_t cycles, bool newChunk) {
+    if(newChunk) m_dspChunks.fetch_add(1, std::memory_order_relaxed); // the resampler may continue a chunk in the next call
+    m_dspSum.fetch_add((cycles + 128) >> 8, std::memory_order_relaxed);
+    addMax(m_dspMax, cycles);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioMetrics::addStall(uint32_t cycles) {
+    m_stallSum.fetch_add((cycles + 128) >> 8, std::memory_order_relaxed);
+    addMax(m_stallMax, cycles);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioMetrics::read(audioMetrics_t* m, bool reset) {
+    // with reset, every counter is exchanged by 0, so that nothing added by the audio task in between is lost
+    uint32_t now = millis();
+    uint32_t periodMs = now - (reset ? m_t0.exchange(now, std::memory_order_relaxed) : m_t0.load(std::memory_order_relaxed));
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    memset(m, 0, sizeof(audioMetrics_t));
+    m->periodMs = periodMs;
+    m->codec = m_codec.load(std::memory_order_relaxed);
+    m->cpuMHz = mhz;
+    for(int i = 0; i < HIST_BINS; i++) m->decodeHist[i] = take(m_hist[i], reset);
+    m->decodeFrames = take(m_decodeFrames, reset);
+    uint64_t decodeSum = (uint64_t)take(m_decodeSum, reset) << 8;
+    m->decodeMaxCycles = take(m_decodeMax, reset);
+    m->dspChunks = take(m_dspChunks, reset);
+    uint64_t dspSum = (uint64_t)take(m_dspSum, reset) << 8;
+    m->dspMaxCycles = take(m_dspMax, reset);
+    m->i2sStallUs = ((uint64_t)take(m_stallSum, reset) << 8) / mhz;
+    m->i2sStallMaxUs = take(m_stallMax, reset) / mhz;
+    m->inBuffOverruns = take(m_overruns, reset);
+    uint32_t netBytes = take(m_netBytes, reset);
+    if(m->decodeFrames) m->decodeAvgCycles = decodeSum / m->decodeFrames;
+    if(m->dspChunks) m->dspAvgCycles = dspSum / m->dspChunks;
+    if(periodMs) {
+        m->netBytesPerSec = (uint64_t)netBytes * 1000 / periodMs;
+        m->cpuLoad = min((uint64_t)100, (decodeSum + dspSum) / 10 / ((uint64_t)periodMs * mhz));
+    }
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioMetrics::reset() {
+    audioMetrics_t m;
+    read(&m, true);
+}
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // clang-format off
 Audio::Audio(uint8_t i2sPort) {
 
-    mutex_playAudioData = xSemaphoreCreateMutex();
+    mutex_playAudioData = xSemaphoreCreateRecursiveMutex(); // is taken recursively by connecttohost() & co
     mutex_audioTask     = xSemaphoreCreateMutex();
 
     m_chbufSize = 512 + 64;
@@ -186,6 +1159,9 @@ Audio::Audio(uint8_t i2sPort) {
     m_i2s_chan_cfg.dma_frame_num = 256;                    // I2S frame number in one DMA buffer.
     m_i2s_chan_cfg.auto_clear    = true;                   // i2s will always send zero automatically if no data to send
     i2s_new_channel(&m_i2s_chan_cfg, &m_i2s_tx_handle, NULL);
+    i2s_event_callbacks_t i2s_cbs = {};
+    i2s_cbs.on_send_q_ovf = i2sSendQueueOverflow;             // counts the I2S underruns
+    i2s_channel_register_event_callback(m_i2s_tx_handle, &i2s_cbs, this);
 
     m_i2s_std_cfg.slot_cfg                = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO); // Set to enable bit shift in Philips mode
     m_i2s_std_cfg.gpio_cfg.bclk           = I2S_GPIO_UNUSED;           // BCLK, Assignment in setPinout()
@@ -201,6 +1177,8 @@ Audio::Audio(uint8_t i2sPort) {
     m_i2s_std_cfg.clk_cfg.mclk_multiple  = I2S_MCLK_MULTIPLE_512;      // mclk = sample_rate * 256
     i2s_channel_init_std_mode(m_i2s_tx_handle, &m_i2s_std_cfg);
     I2Sstart(m_i2s_num);
+    m_i2sSink.setHandle(m_i2s_tx_handle);
+    m_sink = &m_i2sSink;
     m_sampleRate = 44100;
 
     for(int i = 0; i < 3; i++) {
@@ -210,6 +1188,7 @@ Audio::Audio(uint8_t i2sPort) {
         m_filter[i].b1 = 0;
         m_filter[i].b2 = 0;
     }
+    IIR_loadCoefficients();
     computeLimit();  // first init, vol = 21, vol_steps = 21
     startAudioTask();
 }
@@ -217,7 +1196,10 @@ Audio::Audio(uint8_t i2sPort) {
 Audio::~Audio() {
     // I2Sstop(m_i2s_num);
     // InBuff.~AudioBuffer(); #215 the AudioBuffer is automatically destroyed by the destructor
+    stopNetworkTask(); // first, both tasks use the buffers and the I2S channel that are freed below
+    stopAudioTask();
     setDefaults();
+    setAudioSink(NULL);
 
     i2s_channel_disable(m_i2s_tx_handle);
     i2s_del_channel(m_i2s_tx_handle);
@@ -230,7 +1212,6 @@ Audio::~Audio() {
     x_ps_free(&m_lastM3U8host);
     x_ps_free(&m_speechtxt);
 
-    stopAudioTask();
     vSemaphoreDelete(mutex_playAudioData);
     vSemaphoreDelete(mutex_audioTask);
 }
@@ -261,16 +1242,20 @@ esp_err_t Audio::I2Sstop(uint8_t i2s_num) {
     return i2s_channel_disable(m_i2s_tx_handle);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::setDefaults() {
+void Audio::setDefaults(bool keepOutput) {
+    int16_t validSamples = m_validSamples; // keepOutput: the end of the previous file is played first (gapless)
     stopSong();
     initInBuff(); // initialize InputBuffer if not already done
     InBuff.resetBuffer();
-    MP3Decoder_FreeBuffers();
-    FLACDecoder_FreeBuffers();
-    AACDecoder_FreeBuffers();
-    OPUSDecoder_FreeBuffers();
-    VORBISDecoder_FreeBuffers();
-    memset(m_outBuff, 0, m_outbuffSize * sizeof(int16_t)); // Clear OutputBuffer
+    MP3Decoder_FreeBuffers(m_mp3Decoder); m_mp3Decoder = NULL;
+    FLACDecoder_FreeBuffers(m_flacDecoder); m_flacDecoder = NULL;
+    AACDecoder_FreeBuffers(m_aacDecoder); m_aacDecoder = NULL;
+    OPUSDecoder_FreeBuffers(m_opusDecoder); m_opusDecoder = NULL;
+    VORBISDecoder_FreeBuffers(m_vorbisDecoder); m_vorbisDecoder = NULL;
+    if(!keepOutput) memset(m_outBuff, 0, outBuffBytes()); // Clear OutputBuffer
+    if(!keepOutput) clearQueue();
+    m_f_countI2SUnderruns = false;
+    m_f_keepI2S = keepOutput;
     x_ps_free(&m_playlistBuff);
     vector_clear_and_shrink(m_playlistURL);
     vector_clear_and_shrink(m_playlistContent);
@@ -284,6 +1269,11 @@ void Audio::setDefaults() {
     ts_parsePacket(0, 0, 0);                     // reset ts routine
     x_ps_free(&m_lastM3U8host);
     x_ps_free(&m_speechtxt);
+    if(_client == &m_hlsCache) _client = m_hlsNetClient;
+    m_hlsCache.reset();
+    m_hlsPlaylistTime = 0;
+    m_hlsGapTime = 0;
+    m_m3u8_targetDuration = 0;
 
     AUDIO_INFO("buffers freed, free Heap: %lu bytes", (long unsigned int)ESP.getFreeHeap());
 
@@ -313,6 +1303,7 @@ void Audio::setDefaults() {
     m_f_ID3v1TagFound = false;
     m_f_lockInBuffer = false;
     m_f_acceptRanges = false;
+    m_f_oggFile = false;
 
     m_streamType = ST_NONE;
     m_codec = CODEC_NONE;
@@ -336,7 +1327,7 @@ void Audio::setDefaults() {
     m_fileSize = 0;
     m_ID3Size = 0;
     m_haveNewFilePos = 0;
-    m_validSamples = 0;
+    m_validSamples = keepOutput ? validSamples : 0;
     m_M4A_chConfig = 0;
     m_M4A_objectType = 0;
     m_M4A_sampleRate = 0;
@@ -372,7 +1363,7 @@ bool Audio::openai_speech(const String& api_key, const String& model, const Stri
         stopSong();
         return false;
     }
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
 
     setDefaults();
     m_f_ssl = true;
@@ -466,7 +1457,7 @@ bool Audio::connecttohost(const char* host, const char* user, const char* pwd) {
 //        |   |                                     |    |                              |             (query string)
 //    ssl?|   |<-----host without extension-------->|port|<----- --extension----------->|<-first parameter->|<-second parameter->.......
 
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
 
     // optional basic authorization
     if(user && pwd) authLen = strlen(user) + strlen(pwd);
@@ -585,6 +1576,10 @@ exit:
 bool Audio::httpPrint(const char* host) {
     // user and pwd for authentification only, can be empty
     if(!m_f_running) return false;
+    if(_client == &m_hlsCache) { // back from a prefetched segment to the network
+        m_hlsCache.stop();
+        _client = m_hlsNetClient;
+    }
     if(host == NULL) {
         AUDIO_INFO("Hostaddress is empty");
         stopSong();
@@ -826,7 +1821,7 @@ void Audio::UTF8toASCII(char* str) {
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::connecttoFS(fs::FS& fs, const char* path, int32_t fileStartPos) {
 
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
     bool res = false;
     int16_t dotPos;
     char* audioPath = NULL;
@@ -838,14 +1833,7 @@ bool Audio::connecttoFS(fs::FS& fs, const char* path, int32_t fileStartPos) {
     if(dotPos == -1) {AUDIO_INFO("No file extension found"); goto exit;}  // guard
     setDefaults(); // free buffers an set defaults
 
-    if(endsWith(path, ".mp3"))  codec = CODEC_MP3;
-    if(endsWith(path, ".m4a"))  codec = CODEC_M4A;
-    if(endsWith(path, ".aac"))  codec = CODEC_AAC;
-    if(endsWith(path, ".wav"))  codec = CODEC_WAV;
-    if(endsWith(path, ".flac")) codec = CODEC_FLAC;
-    if(endsWith(path, ".opus")) codec = CODEC_OPUS;
-    if(endsWith(path, ".ogg"))  codec = CODEC_OGG;
-    if(endsWith(path, ".oga"))  codec = CODEC_OGG;
+    codec = fileCodec(path);
     if(codec == CODEC_NONE) {AUDIO_INFO("The %s format is not supported", path + dotPos); goto exit;}   // guard
 
     audioPath = (char *)x_ps_calloc(strlen(path) + 2, sizeof(char));
@@ -870,19 +1858,244 @@ exit:
     return res;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint8_t Audio::fileCodec(const char* path) {
+    uint8_t codec = CODEC_NONE;
+    if(endsWith(path, ".mp3"))  codec = CODEC_MP3;
+    if(endsWith(path, ".m4a"))  codec = CODEC_M4A;
+    if(endsWith(path, ".aac"))  codec = CODEC_AAC;
+    if(endsWith(path, ".wav"))  codec = CODEC_WAV;
+    if(endsWith(path, ".flac")) codec = CODEC_FLAC;
+    if(endsWith(path, ".opus")) codec = CODEC_OPUS;
+    if(endsWith(path, ".ogg"))  codec = CODEC_OGG;
+    if(endsWith(path, ".oga"))  codec = CODEC_OGG;
+    return codec;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::queueNextFS(fs::FS& fs, const char* path) {
+    // The file is opened, its first bytes are read and its decoder is prepared while the current file is playing. At the
+    // end of the current file the decoder is swapped in, the last samples of the current file are still played and I2S
+    // keeps running. Web streams (connecttohost) can't be queued, the next station needs its own connection and its
+    // format is only known from the response header, so switching stations still means reconnecting and rebuffering.
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
+    bool res = false;
+    char* audioPath = NULL;
+    uint8_t codec = CODEC_NONE;
+    clearQueue();
+
+    if(!path) {printProcessLog(AUDIOLOG_PATH_IS_NULL); goto exit;}  // guard
+    codec = fileCodec(path);
+    if(codec == CODEC_NONE) {AUDIO_INFO("The format of %s is not supported", path); goto exit;}   // guard
+
+    audioPath = (char *)x_ps_calloc(strlen(path) + 2, sizeof(char));
+    if(!audioPath){printProcessLog(AUDIOLOG_OUT_OF_MEMORY); goto exit;};
+    if(path[0] != '/')audioPath[0] = '/';
+    strcat(audioPath, path);
+
+    if(!fs.exists(audioPath)) {printProcessLog(AUDIOLOG_FILE_NOT_FOUND, audioPath); goto exit;}
+    m_nextFile = fs.open(audioPath);
+    m_nextBuffLen = min((size_t)m_nextBuffSize, (size_t)m_nextFile.size());
+    if(!m_nextBuffLen) {printProcessLog(AUDIOLOG_FILE_READ_ERR, audioPath); clearQueue(); goto exit;}
+    m_nextBuff = (uint8_t*)x_ps_malloc(m_nextBuffLen);
+    if(!m_nextBuff) {printProcessLog(AUDIOLOG_OUT_OF_MEMORY); clearQueue(); goto exit;}
+    if(m_nextFile.read(m_nextBuff, m_nextBuffLen) != m_nextBuffLen) {printProcessLog(AUDIOLOG_FILE_READ_ERR, audioPath); clearQueue(); goto exit;}
+    m_nextCodec = codec;
+    prepareNextDecoder();
+    if(m_nextCodec == CODEC_NONE) {AUDIO_INFO("The format of %s is not supported", audioPath); clearQueue(); goto exit;}
+    AUDIO_INFO("Queued file: \"%s\"", audioPath);
+    res = true;
+
+exit:
+    x_ps_free(&audioPath);
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+    return res;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::clearQueue() {
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return;}
+    if(m_nextFile) m_nextFile.close();
+    if(m_nextBuff) {free(m_nextBuff); m_nextBuff = NULL;}
+    freeNextDecoder();
+    m_nextBuffLen = 0;
+    m_nextBuffPos = 0;
+    m_nextCodec = CODEC_NONE;
+    m_f_nextOggFile = false;
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::prepareNextDecoder() {
+    // Allocates the decoder of the queued file in advance. Ogg files (Opus, Vorbis, FLAC) begin with header pages:
+    // identification, comments and for Vorbis the codebooks. They are parsed here, so at the end of the current file the
+    // decoder continues with the first audio page. If the header pages don't fit into m_nextBuff (big cover art) the
+    // context stays unused and the header is parsed at the end of the current file as before. The headers of mp3, aac,
+    // m4a, wav and native flac are read by Audio itself (ID3, moov atom, STREAMINFO), only their decoder is allocated here.
+    if(m_nextCodec == CODEC_OGG) {
+        m_nextCodec = determineOggCodec(m_nextBuff, m_nextBuffLen);
+        m_f_nextOggFile = true;
+    }
+    switch(m_nextCodec) {
+        case CODEC_MP3:    m_nextDecoder = MP3Decoder_AllocateBuffers(); break;
+        case CODEC_AAC:
+        case CODEC_M4A:    m_nextDecoder = AACDecoder_AllocateBuffers(); break;
+        case CODEC_FLAC:   if(!psramFound()) return;
+                           m_nextDecoder = FLACDecoder_AllocateBuffers();
+                           if(m_nextDecoder) FLACSetOutputBits((FLACDecoder_t*)m_nextDecoder, m_outputBits);
+                           break;
+        case CODEC_OPUS:   m_nextDecoder = OPUSDecoder_AllocateBuffers(); break;
+        case CODEC_VORBIS: if(!psramFound()) return;
+                           m_nextDecoder = VORBISDecoder_AllocateBuffers();
+                           break;
+        default:           return;
+    }
+    if(!m_nextDecoder) return;
+    if(!m_f_nextOggFile && m_nextCodec != CODEC_OPUS && m_nextCodec != CODEC_VORBIS) return; // opus and vorbis come in ogg only
+
+    // the header pages have the granule position 0, the first page with another granule position holds audio
+    uint32_t  headerEnd = 0;
+    oggPage_t page;
+    while(true) {
+        if(OGGparsePage(m_nextBuff + headerEnd, m_nextBuffLen - headerEnd, &page, NULL) < 0) return;
+        if(page.granulePosition != 0) break;
+        headerEnd += page.headerSize + page.bodySize;
+        if(headerEnd >= m_nextBuffLen) return;
+    }
+
+    // same calls as sendBytes() with the syncword at pos 0, the header pages deliver no samples
+    int16_t* outBuff = (int16_t*)x_ps_malloc(outBuffBytes());
+    if(!outBuff) return;
+    if(m_nextCodec == CODEC_OPUS) OPUSFindSyncWord((OPUSDecoder_t*)m_nextDecoder, m_nextBuff, m_nextBuffLen);
+    uint32_t pos = 0;
+    for(int i = 0; i < 4096 && pos < headerEnd; i++) { // the decoders can ask to be called again without reading a byte
+        int32_t bytesLeft = m_nextBuffLen - pos;
+        int32_t ret = 0;
+        if(m_nextCodec == CODEC_FLAC)   ret = FLACDecode((FLACDecoder_t*)m_nextDecoder, m_nextBuff + pos, &bytesLeft, outBuff);
+        if(m_nextCodec == CODEC_OPUS)   ret = OPUSDecode((OPUSDecoder_t*)m_nextDecoder, m_nextBuff + pos, &bytesLeft, outBuff);
+        if(m_nextCodec == CODEC_VORBIS) ret = VORBISDecode((VORBISDecoder_t*)m_nextDecoder, m_nextBuff + pos, &bytesLeft, outBuff);
+        uint32_t bytesDecoded = m_nextBuffLen - pos - bytesLeft;
+        if(ret < 0 || (ret == 0 && bytesDecoded == 0)) break;
+        pos += bytesDecoded;
+    }
+    free(outBuff);
+    if(pos == headerEnd) {m_nextBuffPos = pos; return;}
+    log_w("the header pages of the queued file are parsed at the end of the current file");
+    uint8_t codec = m_nextCodec; // the context has seen a part of the header, it can't be used for the whole file
+    freeNextDecoder();
+    m_nextCodec = codec;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::freeNextDecoder() {
+    switch(m_nextCodec) {
+        case CODEC_MP3:    MP3Decoder_FreeBuffers((MP3Decoder_t*)m_nextDecoder); break;
+        case CODEC_AAC:
+        case CODEC_M4A:    AACDecoder_FreeBuffers((AACDecoder_t*)m_nextDecoder); break;
+        case CODEC_FLAC:   FLACDecoder_FreeBuffers((FLACDecoder_t*)m_nextDecoder); break;
+        case CODEC_OPUS:   OPUSDecoder_FreeBuffers((OPUSDecoder_t*)m_nextDecoder); break;
+        case CODEC_VORBIS: VORBISDecoder_FreeBuffers((VORBISDecoder_t*)m_nextDecoder); break;
+    }
+    m_nextDecoder = NULL;
+    m_nextBuffPos = 0;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::playQueuedFile() {
+    // Called at the end of the current file. m_outBuff and the DMA buffers still hold its last samples, they are played
+    // before the first samples of the queued file. The decoder prepared in queueNextFS() takes over, the rest of the
+    // header is read at once from the bytes read in queueNextFS().
+    File     file = m_nextFile;
+    uint8_t  codec = m_nextCodec;
+    uint8_t* buff = m_nextBuff;
+    uint16_t len = m_nextBuffLen;
+    uint16_t pos = m_nextBuffPos;
+    void*    decoder = m_nextDecoder;
+    bool     f_oggFile = m_f_nextOggFile;
+    m_nextFile = File();
+    m_nextBuff = NULL;
+    m_nextBuffLen = 0;
+    m_nextBuffPos = 0;
+    m_nextDecoder = NULL;
+    m_nextCodec = CODEC_NONE;
+    m_f_nextOggFile = false;
+
+    xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ); // not in the middle of playChunk()
+    setDefaults(true);
+    audiofile = file;
+    m_dataMode = AUDIO_LOCALFILE;
+    m_fileSize = audiofile.size();
+    bool res = true;
+    switch(decoder ? codec : CODEC_NONE) {
+        case CODEC_MP3:    m_mp3Decoder    = (MP3Decoder_t*)decoder;    InBuff.changeMaxBlockSize(m_frameSizeMP3);    break;
+        case CODEC_AAC:
+        case CODEC_M4A:    m_aacDecoder    = (AACDecoder_t*)decoder;    InBuff.changeMaxBlockSize(m_frameSizeAAC);    break;
+        case CODEC_FLAC:   m_flacDecoder   = (FLACDecoder_t*)decoder;   InBuff.changeMaxBlockSize(m_frameSizeFLAC);
+                           FLACSetOutputBits(m_flacDecoder, m_outputBits); break;
+        case CODEC_OPUS:   m_opusDecoder   = (OPUSDecoder_t*)decoder;   InBuff.changeMaxBlockSize(m_frameSizeOPUS);   break;
+        case CODEC_VORBIS: m_vorbisDecoder = (VORBISDecoder_t*)decoder; InBuff.changeMaxBlockSize(m_frameSizeVORBIS); break;
+        default:           res = initializeDecoder(codec); break; // no context prepared
+    }
+    m_codec = codec;
+    m_f_oggFile = f_oggFile;
+    if(res) {
+        m_sumBytesDecoded = pos; // the header pages parsed in queueNextFS()
+        len = min((uint32_t)(len - pos), (uint32_t)InBuff.writeSpace());
+        memcpy(InBuff.getWritePtr(), buff + pos, len);
+        InBuff.bytesWritten(len);
+        audiofile.seek(pos + len);
+        m_f_running = true;
+    }
+    else audiofile.close();
+    free(buff);
+    xSemaphoreGive(mutex_audioTask);
+    if(!res) return false;
+
+    AUDIO_INFO("Reading file: \"%s\" (gapless)", audiofile.name());
+    for(int i = 0; i < 64 && m_f_running && !m_f_stream; i++) processLocalFile(); // header, the decoder can start at once
+    return m_f_running;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::connecttospeech(const char* speech, const char* lang) {
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
+
+    uint64_t cacheKey = AudioFileCache::key("translate_tts", lang, speech);
+    if(m_ttsCache.lookup(cacheKey)) { // already spoken once, play the local copy
+        AUDIO_INFO("speech from cache: \"%s\"", m_ttsCache.path(cacheKey));
+        bool res = connecttoFS(m_ttsCache.fs(), m_ttsCache.path(cacheKey));
+        if(res) {
+            m_f_tts = true; // audio_eof_speech() instead of audio_eof_mp3()
+            m_speechtxt = x_ps_strdup(speech);
+        }
+        xSemaphoreGiveRecursive(mutex_playAudioData);
+        return res;
+    }
 
     setDefaults();
+    x_ps_free(&m_speechtxt);
+    m_speechtxt = x_ps_strdup(speech);
+    _client = static_cast<WiFiClient*>(&client);
+    if(!sendTTSRequest(_client, speech, lang)) {
+        xSemaphoreGiveRecursive(mutex_playAudioData);
+        return false;
+    }
+
+    if(m_ttsCache.isEnabled()) { // record the download, see processWebFile()
+        m_ttsCacheFile = m_ttsCache.create(cacheKey);
+        m_ttsCacheKey = cacheKey;
+    }
+    m_streamType = ST_WEBFILE;
+    m_f_running = true;
+    m_f_ssl = false;
+    m_f_tts = true;
+    m_dataMode = HTTP_RESPONSE_HEADER;
+    x_ps_free(&m_lastHost); m_lastHost = x_ps_strdup("translate.google.com.vn");
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::sendTTSRequest(audioClient_t* cl, const char* speech, const char* lang) {
+    // connects to google translate and sends the GET request of the mp3, used by connecttospeech() and playSpeech()
     char host[] = "translate.google.com.vn";
     char path[] = "/translate_tts";
 
-    x_ps_free(&m_speechtxt);
-    m_speechtxt = x_ps_strdup(speech);
     char* urlStr = urlencode(speech, false); // percent encoding
     if(!urlStr) {
         log_e("out of memory");
-        xSemaphoreGiveRecursive(mutex_playAudioData);
         return false;
     }
 
@@ -904,22 +2117,12 @@ bool Audio::connecttospeech(const char* speech, const char* lang) {
 
     x_ps_free(&urlStr);
 
-    _client = static_cast<WiFiClient*>(&client);
     AUDIO_INFO("connect to \"%s\"", host);
-    if(!_client->connect(host, 80)) {
+    if(!cl->connect(host, 80)) {
         log_e("Connection failed");
-        xSemaphoreGiveRecursive(mutex_playAudioData);
         return false;
     }
-    _client->print(resp);
-
-    m_streamType = ST_WEBFILE;
-    m_f_running = true;
-    m_f_ssl = false;
-    m_f_tts = true;
-    m_dataMode = HTTP_RESPONSE_HEADER;
-    x_ps_free(&m_lastHost); m_lastHost = x_ps_strdup(host);
-    xSemaphoreGiveRecursive(mutex_playAudioData);
+    cl->print(resp);
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1375,7 +2578,7 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
         m_controlCounter = FLAC_OKAY;
         m_audioDataStart = headerSize;
         m_audioDataSize = m_contentlength - m_audioDataStart;
-        FLACSetRawBlockParams(m_flacNumChannels, m_flacSampleRate, m_flacBitsPerSample, m_flacTotalSamplesInStream, m_audioDataSize);
+        FLACSetRawBlockParams(m_flacDecoder, m_flacNumChannels, m_flacSampleRate, m_flacBitsPerSample, m_flacTotalSamplesInStream, m_audioDataSize);
         if(picLen) {
             size_t pos = audiofile.position();
             if(audio_id3image) audio_id3image(audiofile, picPos, picLen);
@@ -1412,8 +2615,8 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
         uint8_t bps = (nextval & 0x01) << 4;
         bps += (*(data + 16) >> 4) + 1;
         m_flacBitsPerSample = bps;
-        if((bps != 8) && (bps != 16)) {
-            log_e("bits per sample must be 8 or 16, is %i", bps);
+        if((bps < 8) || (bps > 24)) {
+            log_e("bits per sample must be 8 ... 24, is %i", bps);
             stopSong();
             return -1;
         }
@@ -2216,7 +3419,9 @@ uint32_t Audio::stopSong() {
             AUDIO_INFO("Closing audio file \"%s\"", audiofile.name());
             audiofile.close();
         }
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // Clear FilterBuffer
+        if(m_ttsCacheFile) m_ttsCache.discard(m_ttsCacheKey, m_ttsCacheFile); // incomplete speech download
+        clearSeekIndex(); // belongs to the file
+        memset(m_iirState, 0, sizeof(m_iirState)); // Clear FilterBuffer
         m_validSamples = 0;
         m_audioCurrentTime = 0;
         m_audioFileDuration = 0;
@@ -2233,8 +3438,9 @@ bool Audio::pauseResume() {
         m_f_running = !m_f_running;
         retVal = true;
         if(!m_f_running) {
-            memset(m_outBuff, 0, m_outbuffSize * sizeof(int16_t)); // Clear OutputBuffer
+            memset(m_outBuff, 0, outBuffBytes()); // Clear OutputBuffer
             m_validSamples = 0;
+            m_f_countI2SUnderruns = false; // the I2S channel idles while paused
         }
     }
     xSemaphoreGive(mutex_audioTask);
@@ -2244,57 +3450,53 @@ bool Audio::pauseResume() {
 void Audio::playChunk() {
 
     int16_t validSamples = 0;
-    static uint16_t count = 0;
+    static uint16_t count = 0; // bytes of m_outBuff that are already written
     size_t i2s_bytesConsumed = 0;
-    int16_t* sample[2] = {0};
-    int16_t* s2;
-    int sampleSize = 4; // 2 bytes per sample (int16_t) * 2 channels
+    int sampleSize = m_outputBits / 4; // 2 or 4 bytes per sample (int16_t or int32_t) * 2 channels
     esp_err_t err = ESP_OK;
-    int i= 0;
+    uint32_t t0 = AudioMetrics::cycles();
+    uint32_t dspCycles = 0; // metrics, the application's audio_process_i2s() is not counted
+    bool newChunk = (count == 0);
 
     if(count > 0) goto i2swrite;
 
-    if(getChannels() == 1){
-        for (int i = m_validSamples - 1; i >= 0; --i) {
-            int16_t sample = m_outBuff[i];
-            m_outBuff[2 * i] = sample;
-            m_outBuff[2 * i + 1] = sample;
+    if(m_outputBits == 32){
+        int32_t* buff32 = (int32_t*)m_outBuff;
+        const int ch = getChannels();
+        if(!m_f_outBuff32 || ch == 1){
+            // int16_t -> left justified int32_t and mono -> stereo in one pass, backwards, so that no sample
+            // is overwritten before it has been read
+            for (int i = m_validSamples * ch - 1; i >= 0; --i) {
+                int32_t sample = m_f_outBuff32 ? buff32[i] : (int32_t)m_outBuff[i] << 16;
+                if(ch == 1) { buff32[2 * i] = sample; buff32[2 * i + 1] = sample; }
+                else          buff32[i] = sample;
+            }
         }
-    //    m_validSamples *= 2;
+        validSamples = m_validSamples;
+        if(m_mixer.isActive()) m_mixer.process(buff32, validSamples, getSampleRate());
+        processBlock(buff32, validSamples);
     }
-
-    validSamples = m_validSamples;
-
-    while(validSamples) {
-        *sample = m_outBuff + i;
-        computeVUlevel(*sample);
-
-        //---------- Filterchain, can commented out if not used-------------
-        {
-            if(m_corr > 1) {
-                s2 = *sample;
-                s2[LEFTCHANNEL] /= m_corr;
-                s2[RIGHTCHANNEL] /= m_corr;
+    else{
+        if(getChannels() == 1){
+            for (int i = m_validSamples - 1; i >= 0; --i) {
+                int16_t sample = m_outBuff[i];
+                m_outBuff[2 * i] = sample;
+                m_outBuff[2 * i + 1] = sample;
             }
-            IIR_filterChain0(*sample);
-            IIR_filterChain1(*sample);
-            IIR_filterChain2(*sample);
-        }
-        //------------------------------------------------------------------
-        if(m_f_forceMono && m_channels == 2){
-            int32_t xy = ((*sample)[RIGHTCHANNEL] + (*sample)[LEFTCHANNEL]) / 2;
-            (*sample)[RIGHTCHANNEL] = (int16_t)xy;
-            (*sample)[LEFTCHANNEL]  = (int16_t)xy;
+        //    m_validSamples *= 2;
         }
-        Gain(*sample);
-        i += 2;
-        validSamples -= 1;
+        validSamples = m_validSamples;
+        if(m_mixer.isActive()) m_mixer.process(m_outBuff, validSamples, getSampleRate());
+        processBlock(m_outBuff, validSamples);
     }
+    dspCycles = AudioMetrics::cycles() - t0;
+
     if(audio_process_i2s) {
         // processing the audio samples from external before forwarding them to i2s
         bool continueI2S = false;
-        audio_process_i2s((int16_t*)m_outBuff, m_validSamples, 16, 2, &continueI2S);
+        audio_process_i2s((int16_t*)m_outBuff, m_validSamples, m_outputBits, 2, &continueI2S);
         if(!continueI2S) {
+            m_metrics.addDsp(dspCycles);
             m_validSamples = 0;
             count = 0;
             return;
@@ -2302,13 +3504,44 @@ void Audio::playChunk() {
     }
 
 i2swrite:
+    m_f_countI2SUnderruns = m_f_running && m_f_stream; // mixer only output (stopped or paused) is not counted
+
+    if(m_resampler.isConverting() || m_resampler.pending()) {
+        // m_outBuff holds m_validSamples frames at the stream rate from byte 'count' on, they are resampled in pieces
+        // to the fixed I2S rate, a piece is written completely before the next one is made
+        while(true) {
+            if(!m_resampler.pending()) {
+                if(!m_validSamples) break;
+                uint16_t used = 0;
+                t0 = AudioMetrics::cycles();
+                if(m_outputBits == 32) m_resampler.process((int32_t*)((uint8_t*)m_outBuff + count), m_validSamples, &used);
+                else                   m_resampler.process((int16_t*)((uint8_t*)m_outBuff + count), m_validSamples, &used);
+                dspCycles += AudioMetrics::cycles() - t0;
+                m_validSamples -= used;
+                count += used * sampleSize;
+                if(!m_resampler.pending()) break;
+            }
+            t0 = AudioMetrics::cycles();
+            err = m_sink->write(m_resampler.pendingData(m_outputBits == 32), m_resampler.pending() * sampleSize, &i2s_bytesConsumed);
+            m_metrics.addStall(AudioMetrics::cycles() - t0);
+            if( ! (err == ESP_OK || err == ESP_ERR_TIMEOUT)) goto exit;
+            m_resampler.consumed(i2s_bytesConsumed / sampleSize);
+            if(m_resampler.pending()) break; // DMA buffers are full
+        }
+        m_metrics.addDsp(dspCycles, newChunk);
+        if(m_validSamples == 0) { count = 0; }
+        return;
+    }
 
+    if(newChunk) m_metrics.addDsp(dspCycles);
     validSamples = m_validSamples;
 
-    err = i2s_channel_write(m_i2s_tx_handle, (int16_t*)m_outBuff + count, validSamples * sampleSize, &i2s_bytesConsumed, 10);
+    t0 = AudioMetrics::cycles();
+    err = m_sink->write((uint8_t*)m_outBuff + count, validSamples * sampleSize, &i2s_bytesConsumed);
+    m_metrics.addStall(AudioMetrics::cycles() - t0);
     if( ! (err == ESP_OK || err == ESP_ERR_TIMEOUT)) goto exit;
     m_validSamples -= i2s_bytesConsumed / sampleSize;
-    count += i2s_bytesConsumed / 2;
+    count += i2s_bytesConsumed;
     if(m_validSamples < 0) { m_validSamples = 0; }
     if(m_validSamples == 0) { count = 0; }
 
@@ -2335,6 +3568,8 @@ exit:
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::loop() {
+    if(m_f_networkTaskIsRunning && xTaskGetCurrentTaskHandle() != m_networkTaskHandle) return; // the network task does the work
+    reportMetrics();
     if(!m_f_running) return;
 
     if(m_playlistFormat != FORMAT_M3U8) { // normal process
@@ -2381,24 +3616,33 @@ void Audio::loop() {
             case AUDIO_PLAYLISTDATA:
                 host = parsePlaylist_M3U8();
                 if(!host) no_host_cnt++; else {no_host_cnt = 0; no_host_timer = millis();}
-                if(no_host_cnt == 2){no_host_timer = millis() + 2000;} // no new url? wait 2 seconds
+                if(no_host_cnt == 2){no_host_timer = millis() + (m_m3u8_targetDuration ? m_m3u8_targetDuration * 500 : 2000);} // no new url? wait half a target duration
                 if(host) { // host contains the next playlist URL
-                    httpPrint(host);
-                    m_dataMode = HTTP_RESPONSE_HEADER;
+                    if(!hlsOpenPrefetched(host)) {
+                        httpPrint(host);
+                        m_dataMode = HTTP_RESPONSE_HEADER;
+                    }
                 }
                 else { // host == NULL means connect to m3u8 URL
                     if(m_lastM3U8host) {httpPrint(m_lastM3U8host);}
                     else               {httpPrint(m_lastHost);}      // if url has no first redirection
                     m_dataMode = HTTP_RESPONSE_HEADER;               // we have a new playlist now
+                    m_hlsPlaylistTime = millis();
                 }
                 break;
             case AUDIO_DATA:
+                hlsPrefetch();
+                if(m_hlsGapTime && streamavail()) { // first bytes of the next segment
+                    if(m_f_Log) AUDIO_INFO("segment gap %lu ms", (long unsigned)(millis() - m_hlsGapTime));
+                    m_hlsGapTime = 0;
+                }
                 if(m_f_ts) { processWebStreamTS(); } // aac or aacp with ts packets
                 else { processWebStreamHLS(); }      // aac or aacp normal stream
 
                 if(m_f_continue) { // at this point m_f_continue is true, means processWebStream() needs more data
                     m_dataMode = AUDIO_PLAYLISTDATA;
                     m_f_continue = false;
+                    m_hlsGapTime = millis();
                 }
                 break;
         }
@@ -2636,7 +3880,7 @@ const char* Audio::parsePlaylist_ASX() { // Advanced Stream Redirector
     return host;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-const char* Audio::parsePlaylist_M3U8() {
+const char* Audio::parsePlaylist_M3U8(bool popURL) {
 
     // example: audio chunks
     // #EXTM3U
@@ -2688,6 +3932,7 @@ const char* Audio::parsePlaylist_M3U8() {
             if(startsWith(m_playlistContent[i], "##")) continue;
             if(startsWith(m_playlistContent[i], "#EXT-X-INDEPENDENT-SEGMENTS")) continue;
             if(startsWith(m_playlistContent[i], "#EXT-X-PROGRAM-DATE-TIME:")) continue;
+            if(startsWith(m_playlistContent[i], "#EXT-X-TARGETDURATION:")) {m_m3u8_targetDuration = atoi(m_playlistContent[i] + 22); continue;}
 
             if(!f_mediaSeq_found) {
                 xMedSeq = m3u8_findMediaSeqInURL();
@@ -2789,6 +4034,7 @@ const char* Audio::parsePlaylist_M3U8() {
         }
         vector_clear_and_shrink(m_playlistContent); // clear after reading everything, m_playlistContent.size is now 0
     }
+    if(!popURL) return NULL; // playlist from hlsPrefetch(), the segment URLs are queued now
 
     if(m_playlistURL.size() > 0) {
         x_ps_free(&m_playlistBuff);
@@ -2952,6 +4198,67 @@ const char* Audio::m3u8redirection(uint8_t* codec) {
     return m_playlistContent[choosenLine]; // it's a redirection, a new m3u8 playlist
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::hlsPrefetch() {
+    // runs while a segment plays: queue the next segments (the last one in m_playlistURL is played next) and,
+    // if all known segments are queued, reload the playlist half a target duration after the last request
+    // (RFC 8216 6.3.4). So at the end of a segment the next one is already in PSRAM, see hlsOpenPrefetched()
+    if(!m_hlsCache.isEnabled()) return;
+    for(int i = m_playlistURL.size() - 1; i >= 0; i--) {
+        if(!m_hlsCache.request(m_playlistURL[i])) break; // no room
+    }
+    const char* plsURL = m_lastM3U8host ? m_lastM3U8host : m_lastHost;
+    uint32_t    reload = m_m3u8_targetDuration ? m_m3u8_targetDuration * 500 : 2000;
+    if(m_playlistURL.size() == 0 && m_hlsCache.state(plsURL) == HLSSegmentCache::SEG_UNKNOWN && millis() - m_hlsPlaylistTime > reload) {
+        if(m_hlsCache.request(plsURL)) m_hlsPlaylistTime = millis();
+    }
+    // connect() blocks: the network task does it after loop() without the mutex, see networkTask(), otherwise only
+    // with enough data in the buffer
+    bool mayConnect = !m_f_networkTaskIsRunning && InBuff.bufferFilled() > InBuff.getBufsize() / 2;
+    m_hlsCache.loop(mayConnect);
+
+    int8_t state = m_hlsCache.state(plsURL);
+    if(state == HLSSegmentCache::SEG_FAILED) m_hlsCache.drop(plsURL); // again after the reload time
+    if(state == HLSSegmentCache::SEG_COMPLETE && m_playlistContent.size() == 0) {
+        uint8_t* data = NULL;
+        uint32_t size = 0;
+        if(!m_hlsCache.take(plsURL, &data, &size)) return;
+        char     pl[512]; // playlistLine, as in readPlayListData()
+        uint32_t start = 0;
+        for(uint32_t i = 0; i <= size; i++) {
+            if(i < size && data[i] != '\n') continue;
+            uint32_t end = i;
+            if(end > start && data[end - 1] == '\r') end--;
+            uint32_t len = min(end - start, (uint32_t)sizeof(pl) - 1);
+            if(len) {
+                memcpy(pl, data + start, len);
+                pl[len] = '\0';
+                m_playlistContent.push_back(x_ps_strdup(pl));
+            }
+            start = i + 1;
+        }
+        free(data);
+        parsePlaylist_M3U8(false);
+    }
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::hlsOpenPrefetched(const char* url) {
+    // instead of httpPrint() + parseHttpResponseHeader(): the segment comes from m_hlsCache, processWebStreamHLS()
+    // and processWebStreamTS() read it through _client
+    if(!m_hlsCache.isEnabled()) return false;
+    int32_t len = m_hlsCache.open(url);
+    if(len < 0) return false;
+    AUDIO_INFO("prefetched: \"%s\"", url);
+    if(_client != &m_hlsCache) m_hlsNetClient = _client;
+    _client = &m_hlsCache;
+    m_contentlength = len;
+    m_f_chunked = false;
+    m_streamType = ST_WEBSTREAM;
+    m_controlCounter = 0;
+    m_f_firstCall = true;
+    m_dataMode = AUDIO_DATA;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint64_t Audio::m3u8_findMediaSeqInURL() { // We have no clue what the media sequence is
 
     char*    pEnd;
@@ -3066,11 +4373,13 @@ void Audio::processLocalFile() {
         return;
     }
     availableBytes = InBuff.writeSpace();
+    if(m_f_keepI2S && !m_f_stream) availableBytes = min(availableBytes, maxFrameSize); // gapless start, header first
     int32_t bytesAddedToBuffer = audiofile.read(InBuff.getWritePtr(), availableBytes);
     if(bytesAddedToBuffer > 0) {InBuff.bytesWritten(bytesAddedToBuffer);}
     if(!m_f_stream) {
         if(m_codec == CODEC_OGG) { // log_i("determine correct codec here");
             uint8_t codec = determineOggCodec(InBuff.getReadPtr(), maxFrameSize);
+            m_f_oggFile = true;
             if     (codec == CODEC_FLAC)   {initializeDecoder(codec); m_codec = CODEC_FLAC;   return;}
             else if(codec == CODEC_OPUS)   {initializeDecoder(codec); m_codec = CODEC_OPUS;   return;}
             else if(codec == CODEC_VORBIS) {initializeDecoder(codec); m_codec = CODEC_VORBIS; return;}
@@ -3088,6 +4397,7 @@ void Audio::processLocalFile() {
             return;
         }
         else {
+            buildSeekIndex();
             m_f_stream = true;
             AUDIO_INFO("stream ready");
         }
@@ -3103,20 +4413,37 @@ void Audio::processLocalFile() {
         if(m_resumeFilePos >= (int32_t)m_audioDataStart + m_audioDataSize) {goto exit;}
         m_haveNewFilePos = m_resumeFilePos;
 
-        if(m_codec == CODEC_M4A) {m_resumeFilePos = m4a_correctResumeFilePos(m_resumeFilePos);   if(m_resumeFilePos == -1) goto exit;}
-        if(m_codec == CODEC_WAV) {while((m_resumeFilePos % 4) != 0){m_resumeFilePos++; if(m_resumeFilePos >= m_fileSize)   goto exit;}}  // must divisible by four
-        if(m_codec == CODEC_FLAC) {m_resumeFilePos = flac_correctResumeFilePos(m_resumeFilePos); if(m_resumeFilePos == -1) goto exit; FLACDecoderReset();}
-        if(m_codec == CODEC_MP3) { m_resumeFilePos = mp3_correctResumeFilePos(m_resumeFilePos);  if(m_resumeFilePos == -1) goto exit; MP3Decoder_ClearBuffer();}
-        if(m_codec == CODEC_VORBIS){m_resumeFilePos = ogg_correctResumeFilePos(m_resumeFilePos); if(m_resumeFilePos == -1) goto exit; VORBISDecoder_ClearBuffers();}
-        if(m_codec == CODEC_OPUS){m_resumeFilePos = ogg_correctResumeFilePos(m_resumeFilePos);   if(m_resumeFilePos == -1) goto exit; OPUSDecoder_ClearBuffers();}
+        float   skipTime = 0;
+        int32_t exactPos = (m_seekTime >= 0) ? seekByTime(m_seekTime, &skipTime) : -1; // -1: no time given or no index
+        if(exactPos >= 0) {
+            m_resumeFilePos = exactPos;
+            if(m_codec == CODEC_FLAC)   FLACDecoderReset(m_flacDecoder);
+            if(m_codec == CODEC_MP3)    MP3Decoder_ClearBuffer(m_mp3Decoder);
+            if(m_codec == CODEC_VORBIS) VORBISDecoder_ClearBuffers(m_vorbisDecoder);
+            if(m_codec == CODEC_OPUS)   OPUSDecoder_ClearBuffers(m_opusDecoder);
+        }
+        else {
+            if(m_codec == CODEC_M4A) {m_resumeFilePos = m4a_correctResumeFilePos(m_resumeFilePos);   if(m_resumeFilePos == -1) goto exit;}
+            if(m_codec == CODEC_WAV) {while((m_resumeFilePos % 4) != 0){m_resumeFilePos++; if(m_resumeFilePos >= m_fileSize)   goto exit;}}  // must divisible by four
+            if(m_codec == CODEC_FLAC) {m_resumeFilePos = flac_correctResumeFilePos(m_resumeFilePos); if(m_resumeFilePos == -1) goto exit; FLACDecoderReset(m_flacDecoder);}
+            if(m_codec == CODEC_MP3) { m_resumeFilePos = mp3_correctResumeFilePos(m_resumeFilePos);  if(m_resumeFilePos == -1) goto exit; MP3Decoder_ClearBuffer(m_mp3Decoder);}
+            if(m_codec == CODEC_VORBIS){m_resumeFilePos = ogg_correctResumeFilePos(m_resumeFilePos); if(m_resumeFilePos == -1) goto exit; VORBISDecoder_ClearBuffers(m_vorbisDecoder);}
+            if(m_codec == CODEC_OPUS){m_resumeFilePos = ogg_correctResumeFilePos(m_resumeFilePos);   if(m_resumeFilePos == -1) goto exit; OPUSDecoder_ClearBuffers(m_opusDecoder);}
+        }
 
         m_f_lockInBuffer = true;                          // lock the buffer, the InBuffer must not be re-entered in playAudioData()
             while(m_f_audioTaskIsDecoding) vTaskDelay(1); // We can't reset the InBuffer while the decoding is in progress
             audiofile.seek(m_resumeFilePos);
             InBuff.resetBuffer();
             m_sumBytesDecoded = m_haveNewFilePos = m_resumeFilePos;
+            m_seekNewTime = (exactPos >= 0) ? m_seekTime : -1;
+            m_seekSkipTime = skipTime;
+            if(exactPos >= 0) m_trimPos = m_seekTime * getSampleRate(); // the samples in front of m_seekTime are skipped
+            else {m_trimPos = m_trimDelay; m_trimEnd = 0;}              // position unknown, don't cut the end
+            if(m_codec == CODEC_MP3 && m_seekIndexLen) m_trimEnd = 0;   // VBR: the frame found via the TOC can be one off
+            m_seekTime = -1;
             m_resumeFilePos = -1;
-            if(m_codec == CODEC_MP3) MP3Decoder_ClearBuffer();
+            if(m_codec == CODEC_MP3) MP3Decoder_ClearBuffer(m_mp3Decoder);
         m_f_lockInBuffer = false;
     }
 
@@ -3126,22 +4453,30 @@ void Audio::processLocalFile() {
             m_sumBytesDecoded = m_haveNewFilePos = m_audioDataStart;
             audiofile.seek(m_audioDataStart);
             InBuff.resetBuffer();
+            m_trimPos = 0;
             AUDIO_INFO("file loop");
             m_f_eof = false;
             return;
         }
         if(m_f_ID3v1TagFound) readID3V1Tag();
+        if(m_nextFile && !m_f_tts) { // gapless
+            char* afn = strdup(audiofile.name());
+            playQueuedFile();
+            if(audio_eof_mp3) audio_eof_mp3(afn); // a file queued here follows the one that has just been started
+            AUDIO_INFO("End of file \"%s\"", afn);
+            x_ps_free(&afn);
+            return;
+        }
 exit:
         char* afn = NULL;
         if(audiofile) afn = strdup(audiofile.name()); // store temporary the name
         stopSong();
 
-        if(m_codec == CODEC_MP3) MP3Decoder_FreeBuffers();
-        if(m_codec == CODEC_AAC) AACDecoder_FreeBuffers();
-        if(m_codec == CODEC_M4A) AACDecoder_FreeBuffers();
-        if(m_codec == CODEC_FLAC) FLACDecoder_FreeBuffers();
-        if(m_codec == CODEC_OPUS) OPUSDecoder_FreeBuffers();
-        if(m_codec == CODEC_VORBIS) VORBISDecoder_FreeBuffers();
+        if(m_codec == CODEC_MP3) {MP3Decoder_FreeBuffers(m_mp3Decoder); m_mp3Decoder = NULL;}
+        if(m_codec == CODEC_AAC || m_codec == CODEC_M4A) {AACDecoder_FreeBuffers(m_aacDecoder); m_aacDecoder = NULL;}
+        if(m_codec == CODEC_FLAC) {FLACDecoder_FreeBuffers(m_flacDecoder); m_flacDecoder = NULL;}
+        if(m_codec == CODEC_OPUS) {OPUSDecoder_FreeBuffers(m_opusDecoder); m_opusDecoder = NULL;}
+        if(m_codec == CODEC_VORBIS) {VORBISDecoder_FreeBuffers(m_vorbisDecoder); m_vorbisDecoder = NULL;}
 
         m_audioCurrentTime = 0;
         m_audioFileDuration = 0;
@@ -3149,6 +4484,13 @@ exit:
         m_haveNewFilePos = 0;
         m_codec = CODEC_NONE;
 
+        if(afn && m_f_tts) { // speech from the cache
+            AUDIO_INFO("End of speech \"%s\"", m_speechtxt);
+            if(audio_eof_speech) audio_eof_speech(m_speechtxt);
+            x_ps_free(&m_speechtxt);
+            m_f_tts = false;
+            x_ps_free(&afn);
+        }
         if(afn) {
             if(audio_eof_mp3) audio_eof_mp3(afn);
             AUDIO_INFO("End of file \"%s\"", afn);
@@ -3197,9 +4539,14 @@ void Audio::processWebStream() {
 
     // buffer fill routine - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(availableBytes) {
+        if(!InBuff.freeSpace()) { // the server sends faster than we play, the TCP window closes
+            if(m_f_stream && !m_f_inBuffFull) {m_f_inBuffFull = true; m_metrics.addOverrun();}
+        }
+        else m_f_inBuffFull = false;
         availableBytes = min(availableBytes, (uint32_t)InBuff.writeSpace());
         int32_t bytesAddedToBuffer = _client->read(InBuff.getWritePtr(), availableBytes);
         if(bytesAddedToBuffer > 0) {
+            m_metrics.addNetBytes(bytesAddedToBuffer);
 
             if(m_f_metadata) m_metacount -= bytesAddedToBuffer;
             if(m_f_chunked) chunkSize -= bytesAddedToBuffer;
@@ -3263,6 +4610,8 @@ void Audio::processWebFile() {
     availableBytes = min(availableBytes, (uint32_t)InBuff.writeSpace());
     int32_t bytesAddedToBuffer = _client->read(InBuff.getWritePtr(), availableBytes);
     if(bytesAddedToBuffer > 0) {
+        m_metrics.addNetBytes(bytesAddedToBuffer);
+        if(m_ttsCacheFile) m_ttsCacheFile.write(InBuff.getWritePtr(), bytesAddedToBuffer);
         m_webFilePos += bytesAddedToBuffer;
         byteCounter += bytesAddedToBuffer;
         if(m_f_chunked) m_chunkcount -= bytesAddedToBuffer;
@@ -3300,13 +4649,13 @@ void Audio::processWebFile() {
 
         m_f_running = false;
         m_streamType = ST_NONE;
-        if(m_codec == CODEC_MP3) MP3Decoder_FreeBuffers();
-        if(m_codec == CODEC_AAC) AACDecoder_FreeBuffers();
-        if(m_codec == CODEC_M4A) AACDecoder_FreeBuffers();
-        if(m_codec == CODEC_FLAC) FLACDecoder_FreeBuffers();
-        if(m_codec == CODEC_OPUS) OPUSDecoder_FreeBuffers();
-        if(m_codec == CODEC_VORBIS) VORBISDecoder_FreeBuffers();
+        if(m_codec == CODEC_MP3) {MP3Decoder_FreeBuffers(m_mp3Decoder); m_mp3Decoder = NULL;}
+        if(m_codec == CODEC_AAC || m_codec == CODEC_M4A) {AACDecoder_FreeBuffers(m_aacDecoder); m_aacDecoder = NULL;}
+        if(m_codec == CODEC_FLAC) {FLACDecoder_FreeBuffers(m_flacDecoder); m_flacDecoder = NULL;}
+        if(m_codec == CODEC_OPUS) {OPUSDecoder_FreeBuffers(m_opusDecoder); m_opusDecoder = NULL;}
+        if(m_codec == CODEC_VORBIS) {VORBISDecoder_FreeBuffers(m_vorbisDecoder); m_vorbisDecoder = NULL;}
         m_codec = CODEC_NONE;
+        if(m_ttsCacheFile) m_ttsCache.commit(m_ttsCacheKey, m_ttsCacheFile); // complete, the next time from the cache
         if(m_f_tts) {
             AUDIO_INFO("End of speech \"%s\"", m_speechtxt);
             if(audio_eof_speech) audio_eof_speech(m_speechtxt);
@@ -3362,6 +4711,7 @@ void Audio::processWebStreamTS() {
 
         int res = _client->read(ts_packet + ts_packetPtr, minBytes);
         if(res > 0) {
+            m_metrics.addNetBytes(res);
             ts_packetPtr += res;
             byteCounter += res;
             if(ts_packetPtr < ts_packetsize) return; // not enough data yet, the process must be repeated if the packet size (188 bytes) is not reached
@@ -3477,7 +4827,9 @@ void Audio::processWebStreamHLS() {
 
         if(firstBytes) {
             if(ID3WritePtr < ID3BuffSize) {
-                ID3WritePtr += _client->readBytes(&ID3Buff[ID3WritePtr], ID3BuffSize - ID3WritePtr);
+                size_t n = _client->readBytes(&ID3Buff[ID3WritePtr], ID3BuffSize - ID3WritePtr);
+                ID3WritePtr += n;
+                m_metrics.addNetBytes(n);
                 return;
             }
             if(m_controlCounter < 100) {
@@ -3516,6 +4868,7 @@ void Audio::processWebStreamHLS() {
         }
         else { bytesWasWritten = _client->read(InBuff.getWritePtr(), InBuff.writeSpace()); }
         InBuff.bytesWritten(bytesWasWritten);
+        m_metrics.addNetBytes(bytesWasWritten);
 
         byteCounter += bytesWasWritten;
 
@@ -3580,7 +4933,11 @@ void Audio::playAudioData() {
         if(bytesToDecode < InBuff.getMaxBlockSize()) {lastFrame = true;}
         if(m_sumBytesDecoded >= m_audioDataSize && m_sumBytesDecoded != 0) { m_f_eof = true; goto exit; }
     }
-    if(!lastFrame) if(InBuff.bufferFilled() < InBuff.getMaxBlockSize()) goto exit;;
+    if(!lastFrame) if(InBuff.bufferFilled() < InBuff.getMaxBlockSize()) {
+        if(!m_f_inBuffStarved) {m_f_inBuffStarved = true; m_inBuffUnderruns++;} // the reader can't keep up
+        goto exit;
+    }
+    m_f_inBuffStarved = false;
 
     bytesDecoded = sendBytes(InBuff.getReadPtr(), InBuff.getMaxBlockSize());
     if(!m_f_running) return;
@@ -3871,8 +5228,9 @@ bool Audio::initializeDecoder(uint8_t codec) {
     uint32_t hWM = 0;
     switch(codec) {
         case CODEC_MP3:
-            if(!MP3Decoder_IsInit()){
-                if(!MP3Decoder_AllocateBuffers()) {
+            if(!m_mp3Decoder){
+                m_mp3Decoder = MP3Decoder_AllocateBuffers();
+                if(!m_mp3Decoder) {
                     AUDIO_INFO("The MP3Decoder could not be initialized");
                     goto exit;
                 }
@@ -3883,8 +5241,9 @@ bool Audio::initializeDecoder(uint8_t codec) {
             }
             break;
         case CODEC_AAC:
-            if(!AACDecoder_IsInit()) {
-                if(!AACDecoder_AllocateBuffers()) {
+            if(!m_aacDecoder) {
+                m_aacDecoder = AACDecoder_AllocateBuffers();
+                if(!m_aacDecoder) {
                     AUDIO_INFO("The AACDecoder could not be initialized");
                     goto exit;
                 }
@@ -3895,8 +5254,9 @@ bool Audio::initializeDecoder(uint8_t codec) {
             }
             break;
         case CODEC_M4A:
-            if(!AACDecoder_IsInit()) {
-                if(!AACDecoder_AllocateBuffers()) {
+            if(!m_aacDecoder) {
+                m_aacDecoder = AACDecoder_AllocateBuffers();
+                if(!m_aacDecoder) {
                     AUDIO_INFO("The AACDecoder could not be initialized");
                     goto exit;
                 }
@@ -3911,17 +5271,22 @@ bool Audio::initializeDecoder(uint8_t codec) {
                 AUDIO_INFO("FLAC works only with PSRAM!");
                 goto exit;
             }
-            if(!FLACDecoder_AllocateBuffers()) {
+            FLACDecoder_FreeBuffers(m_flacDecoder);
+            m_flacDecoder = FLACDecoder_AllocateBuffers();
+            if(!m_flacDecoder) {
                 AUDIO_INFO("The FLACDecoder could not be initialized");
                 goto exit;
             }
+            FLACSetOutputBits(m_flacDecoder, m_outputBits);
             gfH = ESP.getFreeHeap();
             hWM = uxTaskGetStackHighWaterMark(NULL);
             InBuff.changeMaxBlockSize(m_frameSizeFLAC);
             AUDIO_INFO("FLACDecoder has been initialized, free Heap: %lu bytes , free stack %lu DWORDs", (long unsigned int)gfH, (long unsigned int)hWM);
             break;
         case CODEC_OPUS:
-            if(!OPUSDecoder_AllocateBuffers()) {
+            OPUSDecoder_FreeBuffers(m_opusDecoder);
+            m_opusDecoder = OPUSDecoder_AllocateBuffers();
+            if(!m_opusDecoder) {
                 AUDIO_INFO("The OPUSDecoder could not be initialized");
                 goto exit;
             }
@@ -3935,7 +5300,9 @@ bool Audio::initializeDecoder(uint8_t codec) {
                 AUDIO_INFO("VORBIS works only with PSRAM!");
                 goto exit;
             }
-            if(!VORBISDecoder_AllocateBuffers()) {
+            VORBISDecoder_FreeBuffers(m_vorbisDecoder);
+            m_vorbisDecoder = VORBISDecoder_AllocateBuffers();
+            if(!m_vorbisDecoder) {
                 AUDIO_INFO("The VORBISDecoder could not be initialized");
                 goto exit;
             }
@@ -4216,12 +5583,12 @@ void Audio::showCodecParams() {
     else { AUDIO_INFO("BitRate: N/A"); }
 
     if(m_codec == CODEC_AAC) {
-        uint8_t answ = AACGetFormat();
+        uint8_t answ = AACGetFormat(m_aacDecoder);
         if(answ < 3) {
             const char hf[4][8] = {"unknown", "ADIF", "ADTS"};
             AUDIO_INFO("AAC HeaderFormat: %s", hf[answ])
         }
-        answ = AACGetSBR();
+        answ = AACGetSBR(m_aacDecoder);
         if(answ > 0 && answ < 4) {
             const char sbr[4][50] = {"without SBR", "upsampled SBR", "downsampled SBR", "no SBR used, but file is upsampled by a factor 2"};
             AUDIO_INFO("Spectral band replication: %s", sbr[answ]);
@@ -4252,16 +5619,16 @@ int Audio::findNextSync(uint8_t* data, size_t len) {
         if(!m_M4A_chConfig)m_M4A_chConfig = 2; // guard
         if(!m_M4A_sampleRate)m_M4A_sampleRate = 44100;
         if(!m_M4A_objectType)m_M4A_objectType = 2;
-        AACSetRawBlockParams(m_M4A_chConfig, m_M4A_sampleRate, m_M4A_objectType);
+        AACSetRawBlockParams(m_aacDecoder, m_M4A_chConfig, m_M4A_sampleRate, m_M4A_objectType);
         m_f_playing = true;
         nextSync = 0;
     }
     if(m_codec == CODEC_FLAC) {
-        nextSync = FLACFindSyncWord(data, len);
+        nextSync = FLACFindSyncWord(m_flacDecoder, data, len);
         if(nextSync == -1) return len; // OggS not found, search next block
     }
     if(m_codec == CODEC_OPUS) {
-        nextSync = OPUSFindSyncWord(data, len);
+        nextSync = OPUSFindSyncWord(m_opusDecoder, data, len);
         if(nextSync == -1) return len; // OggS not found, search next block
     }
     if(m_codec == CODEC_VORBIS) {
@@ -4291,50 +5658,51 @@ int Audio::findNextSync(uint8_t* data, size_t len) {
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::setDecoderItems() {
     if(m_codec == CODEC_MP3) {
-        setChannels(MP3GetChannels());
-        setSampleRate(MP3GetSampRate());
-        setBitsPerSample(MP3GetBitsPerSample());
-        setBitrate(MP3GetBitrate());
-        AUDIO_INFO("MPEG-%s, Layer %s",(MP3GetVersion()==0) ? "2.5" : (MP3GetVersion()==2) ? "2" : "1", (MP3GetLayer()==1) ? "III" : (MP3GetLayer()==2) ? "II" : "I");
+        setChannels(MP3GetChannels(m_mp3Decoder));
+        setSampleRate(MP3GetSampRate(m_mp3Decoder));
+        setBitsPerSample(MP3GetBitsPerSample(m_mp3Decoder));
+        setBitrate(MP3GetBitrate(m_mp3Decoder));
+        AUDIO_INFO("MPEG-%s, Layer %s",(MP3GetVersion(m_mp3Decoder)==0) ? "2.5" : (MP3GetVersion(m_mp3Decoder)==2) ? "2" : "1", (MP3GetLayer(m_mp3Decoder)==1) ? "III" : (MP3GetLayer(m_mp3Decoder)==2) ? "II" : "I");
     }
     if(m_codec == CODEC_AAC || m_codec == CODEC_M4A) {
-        setChannels(AACGetChannels());
-        setSampleRate(AACGetSampRate());
-        setBitsPerSample(AACGetBitsPerSample());
-        setBitrate(AACGetBitrate());
+        setChannels(AACGetChannels(m_aacDecoder));
+        setSampleRate(AACGetSampRate(m_aacDecoder));
+        setBitsPerSample(AACGetBitsPerSample(m_aacDecoder));
+        setBitrate(AACGetBitrate(m_aacDecoder));
     }
     if(m_codec == CODEC_FLAC) {
-        setChannels(FLACGetChannels());
-        setSampleRate(FLACGetSampRate());
-        setBitsPerSample(FLACGetBitsPerSample());
-        setBitrate(FLACGetBitRate());
-        if(FLACGetAudioDataStart() > 0){ // only flac-ogg, native flac sets audioDataStart in readFlacHeader()
-            m_audioDataStart = FLACGetAudioDataStart();
+        setChannels(FLACGetChannels(m_flacDecoder));
+        setSampleRate(FLACGetSampRate(m_flacDecoder));
+        setBitsPerSample(FLACGetBitsPerSample(m_flacDecoder));
+        setBitrate(FLACGetBitRate(m_flacDecoder));
+        if(FLACGetAudioDataStart(m_flacDecoder) > 0){ // only flac-ogg, native flac sets audioDataStart in readFlacHeader()
+            m_audioDataStart = FLACGetAudioDataStart(m_flacDecoder);
             if(getFileSize()) m_audioDataSize = getFileSize() - m_audioDataStart;
         }
     }
     if(m_codec == CODEC_OPUS) {
-        setChannels(OPUSGetChannels());
+        setChannels(OPUSGetChannels(m_opusDecoder));
         setSampleRate(OPUSGetSampRate());
         setBitsPerSample(OPUSGetBitsPerSample());
-        setBitrate(OPUSGetBitRate());
-        if(OPUSGetAudioDataStart() > 0){
-            m_audioDataStart = OPUSGetAudioDataStart();
+        setBitrate(OPUSGetBitRate(m_opusDecoder));
+        if(!m_haveNewFilePos) m_trimDelay = OPUSGetPreSkip(m_opusDecoder); // decoded from the first page on
+        if(OPUSGetAudioDataStart(m_opusDecoder) > 0){
+            m_audioDataStart = OPUSGetAudioDataStart(m_opusDecoder);
             if(getFileSize()) m_audioDataSize = getFileSize() - m_audioDataStart;
         }
     }
     if(m_codec == CODEC_VORBIS) {
-        setChannels(VORBISGetChannels());
-        setSampleRate(VORBISGetSampRate());
+        setChannels(VORBISGetChannels(m_vorbisDecoder));
+        setSampleRate(VORBISGetSampRate(m_vorbisDecoder));
         setBitsPerSample(VORBISGetBitsPerSample());
-        setBitrate(VORBISGetBitRate());
-        if(VORBISGetAudioDataStart() > 0){
-            m_audioDataStart = VORBISGetAudioDataStart();
+        setBitrate(VORBISGetBitRate(m_vorbisDecoder));
+        if(VORBISGetAudioDataStart(m_vorbisDecoder) > 0){
+            m_audioDataStart = VORBISGetAudioDataStart(m_vorbisDecoder);
             if(getFileSize()) m_audioDataSize = getFileSize() - m_audioDataStart;
         }
     }
-    if(getBitsPerSample() != 8 && getBitsPerSample() != 16) {
-        AUDIO_INFO("Bits per sample must be 8 or 16, found %i", getBitsPerSample());
+    if(getBitsPerSample() < 8 || getBitsPerSample() > 24) {
+        AUDIO_INFO("Bits per sample must be 8 ... 24, found %i", getBitsPerSample());
         stopSong();
     }
     if(getChannels() != 1 && getChannels() != 2) {
@@ -4365,19 +5733,23 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     if(m_codec == CODEC_NONE && m_playlistFormat == FORMAT_M3U8) return 0; // can happen when the m3u8 playlist is loaded
     if(!m_f_decode_ready) return 0; // find sync first
 
+    m_metrics.setCodec(m_codec);
+    uint32_t t0 = AudioMetrics::cycles();
     switch(m_codec) {
         case CODEC_WAV:  m_decodeError = 0; bytesLeft = 0; break;
-        case CODEC_MP3:  m_decodeError = MP3Decode(data, &bytesLeft, m_outBuff, 0); break;
-        case CODEC_AAC:  m_decodeError = AACDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_M4A:  m_decodeError = AACDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_FLAC: m_decodeError = FLACDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_OPUS: m_decodeError = OPUSDecode(data, &bytesLeft, m_outBuff); break;
-        case CODEC_VORBIS: m_decodeError = VORBISDecode(data, &bytesLeft, m_outBuff); break;
+        case CODEC_MP3:  m_decodeError = MP3Decode(m_mp3Decoder, data, &bytesLeft, m_outBuff, 0); break;
+        case CODEC_AAC:  m_decodeError = AACDecode(m_aacDecoder, data, &bytesLeft, m_outBuff); break;
+        case CODEC_M4A:  m_decodeError = AACDecode(m_aacDecoder, data, &bytesLeft, m_outBuff); break;
+        case CODEC_FLAC: m_decodeError = FLACDecode(m_flacDecoder, data, &bytesLeft, m_outBuff); break;
+        case CODEC_OPUS: m_decodeError = OPUSDecode(m_opusDecoder, data, &bytesLeft, m_outBuff); break;
+        case CODEC_VORBIS: m_decodeError = VORBISDecode(m_vorbisDecoder, data, &bytesLeft, m_outBuff); break;
         default: {
             log_e("no valid codec found codec = %d", m_codec);
             stopSong();
         }
     }
+    if(m_decodeError == 0) m_metrics.addDecode(AudioMetrics::cycles() - t0);
+    m_f_outBuff32 = (m_codec == CODEC_FLAC && m_outputBits == 32); // all other decoders deliver int16_t
 
     // m_decodeError - possible values are:
     //                   0: okay, no error
@@ -4430,26 +5802,26 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                                 m_validSamples = len;
                             }
                             break;
-        case CODEC_MP3:     m_validSamples = MP3GetOutputSamps() / getChannels();
+        case CODEC_MP3:     m_validSamples = MP3GetOutputSamps(m_mp3Decoder) / getChannels();
                             break;
-        case CODEC_AAC:     m_validSamples = AACGetOutputSamps() / getChannels();
+        case CODEC_AAC:     m_validSamples = AACGetOutputSamps(m_aacDecoder) / getChannels();
                             static uint8_t isPS = 0;
-                            if(!isPS && AACGetParametricStereo()){ // only change 0 -> 1
+                            if(!isPS && AACGetParametricStereo(m_aacDecoder)){ // only change 0 -> 1
                                 isPS = 1;
                                 AUDIO_INFO("Parametric Stereo");
                             }
-                            else isPS = AACGetParametricStereo();
+                            else isPS = AACGetParametricStereo(m_aacDecoder);
                             break;
-        case CODEC_M4A:     m_validSamples = AACGetOutputSamps() / getChannels();
+        case CODEC_M4A:     m_validSamples = AACGetOutputSamps(m_aacDecoder) / getChannels();
                             break;
         case CODEC_FLAC:    if(m_decodeError == FLAC_PARSE_OGG_DONE) return bytesDecoded; // nothing to play
-                            m_validSamples = FLACGetOutputSamps() / getChannels();
-                            st = FLACgetStreamTitle();
+                            m_validSamples = FLACGetOutputSamps(m_flacDecoder) / getChannels();
+                            st = FLACgetStreamTitle(m_flacDecoder);
                             if(st) {
                                 AUDIO_INFO(st);
                                 if(audio_showstreamtitle) audio_showstreamtitle(st);
                             }
-                            vec = FLACgetMetadataBlockPicture();
+                            vec = FLACgetMetadataBlockPicture(m_flacDecoder);
                             if(vec.size() > 0){ // get blockpic data
                                 // log_i("---------------------------------------------------------------------------");
                                 // log_i("ogg metadata blockpicture found:");
@@ -4459,13 +5831,13 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                             }
                             break;
         case CODEC_OPUS:    if(m_decodeError == OPUS_PARSE_OGG_DONE) return bytesDecoded; // nothing to play
-                            m_validSamples = OPUSGetOutputSamps();
-                            st = OPUSgetStreamTitle();
+                            m_validSamples = OPUSGetOutputSamps(m_opusDecoder);
+                            st = OPUSgetStreamTitle(m_opusDecoder);
                             if(st){
                                 AUDIO_INFO(st);
                                 if(audio_showstreamtitle) audio_showstreamtitle(st);
                             }
-                            vec = OPUSgetMetadataBlockPicture();
+                            vec = OPUSgetMetadataBlockPicture(m_opusDecoder);
                             if(vec.size() > 0){ // get blockpic data
                                 // log_i("---------------------------------------------------------------------------");
                                 // log_i("ogg metadata blockpicture found:");
@@ -4475,13 +5847,13 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                             }
                             break;
         case CODEC_VORBIS:  if(m_decodeError == VORBIS_PARSE_OGG_DONE) return bytesDecoded; // nothing to play
-                            m_validSamples = VORBISGetOutputSamps();
-                            st = VORBISgetStreamTitle();
+                            m_validSamples = VORBISGetOutputSamps(m_vorbisDecoder);
+                            st = VORBISgetStreamTitle(m_vorbisDecoder);
                             if(st) {
                                 AUDIO_INFO(st);
                                 if(audio_showstreamtitle) audio_showstreamtitle(st);
                             }
-                            vec = VORBISgetMetadataBlockPicture();
+                            vec = VORBISgetMetadataBlockPicture(m_vorbisDecoder);
                             if(vec.size() > 0){ // get blockpic data
                                 // log_i("---------------------------------------------------------------------------");
                                 // log_i("ogg metadata blockpicture found:");
@@ -4502,6 +5874,34 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     if(m_bitsPerSample == 16) bytesDecoderOut *= 2;
     computeAudioTime(bytesDecoded, bytesDecoderOut);
 
+    if(m_seekSkipTime > 0 && !m_validSamples && m_codec == CODEC_MP3) { // frame went into the bit reservoir only
+        m_seekSkipTime -= 1 / m_seekUnitsPerSec;
+    }
+    if(m_seekSkipTime > 0 && m_validSamples) { // the decoder restarted in front of the requested play position
+        uint32_t skip = m_seekSkipTime * getSampleRate();
+        if(skip >= (uint32_t)m_validSamples) {
+            m_seekSkipTime -= (float)m_validSamples / getSampleRate();
+            m_validSamples = 0;
+            return bytesDecoded;
+        }
+        uint8_t frameBytes = getChannels() * (m_f_outBuff32 ? 4 : 2);
+        memmove(m_outBuff, (uint8_t*)m_outBuff + skip * frameBytes, (m_validSamples - skip) * frameBytes);
+        m_validSamples -= skip;
+        m_seekSkipTime = 0;
+    }
+    if(m_trimDelay || m_trimEnd) { // encoder delay and padding, the file starts and ends with the sample that was encoded
+        uint32_t n = m_validSamples, skip = 0;
+        if(m_trimPos < m_trimDelay) skip = min((uint64_t)n, m_trimDelay - m_trimPos);
+        if(m_trimEnd && m_trimPos + n > m_trimEnd) n = (m_trimEnd > m_trimPos) ? m_trimEnd - m_trimPos : 0;
+        m_trimPos += m_validSamples;
+        if(skip >= n) {m_validSamples = 0; return bytesDecoded;}
+        if(skip) {
+            uint8_t frameBytes = getChannels() * (m_f_outBuff32 ? 4 : 2);
+            memmove(m_outBuff, (uint8_t*)m_outBuff + skip * frameBytes, (n - skip) * frameBytes);
+        }
+        m_validSamples = n - skip;
+    }
+
     m_curSample = 0;
     playChunk();
     return bytesDecoded;
@@ -4529,9 +5929,9 @@ void Audio::computeAudioTime(uint16_t bytesDecoderIn, uint16_t bytesDecoderOut)
         deltaBytesIn = 0;
         nominalBitRate = 0;
 
-        if(m_codec == CODEC_FLAC && FLACGetAudioFileDuration()){
-            m_audioFileDuration = FLACGetAudioFileDuration();
-            nominalBitRate = (m_audioDataSize / FLACGetAudioFileDuration()) * 8;
+        if(m_codec == CODEC_FLAC && FLACGetAudioFileDuration(m_flacDecoder)){
+            m_audioFileDuration = FLACGetAudioFileDuration(m_flacDecoder);
+            nominalBitRate = (m_audioDataSize / FLACGetAudioFileDuration(m_flacDecoder)) * 8;
             m_avr_bitrate = nominalBitRate;
         }
         if(m_codec == CODEC_WAV){
@@ -4540,6 +5940,11 @@ void Audio::computeAudioTime(uint16_t bytesDecoderIn, uint16_t bytesDecoderOut)
             m_audioFileDuration = m_audioDataSize  / (getSampleRate() * getChannels());
             if(getBitsPerSample() == 16) m_audioFileDuration /= 2;
         }
+        if(m_seekDuration > 0){ // exact value from the Xing/VBRI header, the FLAC streaminfo or the m4a mdhd atom
+            m_audioFileDuration = round(m_seekDuration);
+            nominalBitRate = m_audioDataSize * 8 / m_seekDuration;
+            m_avr_bitrate = nominalBitRate;
+        }
     }
 
     sumBytesIn   += bytesDecoderIn;
@@ -4572,6 +5977,11 @@ void Audio::computeAudioTime(uint16_t bytesDecoderIn, uint16_t bytesDecoderOut)
         uint32_t newTime = posWhithinAudioBlock / (m_avr_bitrate / 8);
         m_audioCurrentTime = newTime;
         sumBytesIn = posWhithinAudioBlock;
+        if(m_seekNewTime >= 0) { // sample accurate seek, the time is known
+            m_audioCurrentTime = m_seekNewTime;
+            sumBytesIn = (uint64_t)(m_seekNewTime * m_avr_bitrate / 8);
+            m_seekNewTime = -1;
+        }
         m_haveNewFilePos = 0;
     }
 }
@@ -4637,7 +6047,7 @@ void Audio::printDecodeError(int r) {
             case ERR_FLAC_PREORDER_TOO_BIG: e = "PREORDER TOO BIG"; break;
             case ERR_FLAC_RESERVED_RESIDUAL_CODING: e = "RESERVED RESIDUAL CODING"; break;
             case ERR_FLAC_WRONG_RICE_PARTITION_NR: e = "WRONG RICE PARTITION NR"; break;
-            case ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG: e = "BITS PER SAMPLE > 16"; break;
+            case ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG: e = "BITS PER SAMPLE > 24"; break;
             case ERR_FLAC_BITS_PER_SAMPLE_UNKNOWN: e = "BITS PER SAMPLE UNKNOWN"; break;
             case ERR_FLAC_DECODER_ASYNC: e = "DECODER ASYNCHRON"; break;
             case ERR_FLAC_BITREADER_UNDERFLOW: e = "BITREADER ERROR"; break;
@@ -4699,7 +6109,7 @@ bool Audio::setPinout(uint8_t BCLK, uint8_t LRC, uint8_t DOUT, int8_t MCLK) {
         x_ps_free(&m_ibuff);
         x_ps_free(&m_outBuff);
         x_ps_free(&m_lastHost);
-        m_outBuff  = (int16_t*)x_ps_malloc(m_outbuffSize * sizeof(int16_t));
+        m_outBuff  = (int16_t*)x_ps_malloc(outBuffBytes());
         m_chbuf    = (char*)   x_ps_malloc(m_chbufSize);
         m_ibuff    = (char*)   x_ps_malloc(m_ibuffSize);
         if(!m_chbuf || !m_outBuff || !m_ibuff) log_e("oom");
@@ -4770,9 +6180,14 @@ bool Audio::setAudioPlayPosition(uint16_t sec) {
     //if(m_codec == CODEC_VORBIS) return false; // not impl. yet
     // Jump to an absolute position in time within an audio file
     // e.g. setAudioPlayPosition(300) sets the pointer at pos 5 min
+    // The byte position is only an estimate, processLocalFile() replaces it with the exact one if the file has a seek index
     if(sec > getAudioFileDuration()) sec = getAudioFileDuration();
     uint32_t filepos = m_audioDataStart + (m_avr_bitrate * sec / 8);
-    if(m_dataMode == AUDIO_LOCALFILE) return setFilePos(filepos);
+    if(m_dataMode == AUDIO_LOCALFILE) {
+        if(!setFilePos(filepos)) return false;
+        m_seekTime = sec;
+        return true;
+    }
 //    if(m_streamType == ST_WEBFILE) return httpRange(m_lastHost, filepos);
     return false;
 }
@@ -4806,14 +6221,19 @@ bool Audio::setTimeOffset(int sec) { // fast forward or rewind the current posit
     if(pos >= (int32_t)endAB)  {pos = endAB;}
     setFilePos(pos);
 
+    float t = m_audioCurrentTime + sec; // for the sample accurate seek in processLocalFile()
+    if(t < 0) t = 0;
+    if(t > getAudioFileDuration()) t = getAudioFileDuration();
+    m_seekTime = t;
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::setFilePos(uint32_t pos) {
     if(m_dataMode == AUDIO_LOCALFILE && !audiofile) return false;
     if(m_codec == CODEC_AAC) return false;   // not impl. yet
-    memset(m_outBuff, 0, m_outbuffSize * sizeof(int16_t));
+    memset(m_outBuff, 0, outBuffBytes());
     m_validSamples = 0;
+    m_seekTime = -1;        // only a byte position, setAudioPlayPosition() and setTimeOffset() set the time afterwards
     m_haveNewFilePos = pos; // used in computeAudioCurrentTime()
     if(m_dataMode == AUDIO_LOCALFILE){
         m_resumeFilePos = pos;  // used in processLocalFile()
@@ -4835,7 +6255,7 @@ bool Audio::setSampleRate(uint32_t sampRate) {
 uint32_t Audio::getSampleRate() { return m_sampleRate; }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::setBitsPerSample(int bits) {
-    if((bits != 16) && (bits != 8)) return false;
+    if((bits < 8) || (bits > 24)) return false; // more than 16 only from FLAC, see setI2SOutputBits()
     m_bitsPerSample = bits;
     return true;
 }
@@ -4854,34 +6274,112 @@ uint8_t Audio::getChannels() {
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::reconfigI2S(){
 
-    I2Sstop(0);
+    uint32_t rate = getSampleRate();
+    if(getBitsPerSample() == 8 && getChannels() == 2) rate *= 2;
+    i2s_data_bit_width_t bw = (m_outputBits == 32) ? I2S_DATA_BIT_WIDTH_32BIT : I2S_DATA_BIT_WIDTH_16BIT;
 
-    if(getBitsPerSample() == 8 && getChannels() == 2) m_i2s_std_cfg.clk_cfg.sample_rate_hz = getSampleRate() * 2;
-    else m_i2s_std_cfg.clk_cfg.sample_rate_hz = getSampleRate();
+    if(m_resampler.isEnabled()) { // I2S keeps its rate, only the resampler is adapted to the stream
+        m_resampler.setInputRate(rate);
+        rate = m_resampler.outputRate();
+    }
+    bool keepClock = m_resampler.isEnabled() || m_f_keepI2S; // a queued file with the same rate follows without a gap
+    m_f_keepI2S = false;
+    if(!keepClock || m_i2s_std_cfg.clk_cfg.sample_rate_hz != rate || m_i2s_std_cfg.slot_cfg.data_bit_width != bw) {
+        I2Sstop(0);
 
-    if(!m_f_commFMT) m_i2s_std_cfg.slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO);
-    else             m_i2s_std_cfg.slot_cfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO);
+        m_i2s_std_cfg.clk_cfg.sample_rate_hz = rate;
+        if(!m_f_commFMT) m_i2s_std_cfg.slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(bw, I2S_SLOT_MODE_STEREO);
+        else             m_i2s_std_cfg.slot_cfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(bw, I2S_SLOT_MODE_STEREO);
 
-    m_i2s_std_cfg.slot_cfg.slot_mask = I2S_STD_SLOT_BOTH;
+        m_i2s_std_cfg.slot_cfg.slot_mask = I2S_STD_SLOT_BOTH;
 
-    i2s_channel_reconfig_std_clock(m_i2s_tx_handle, &m_i2s_std_cfg.clk_cfg);
-    i2s_channel_reconfig_std_slot(m_i2s_tx_handle, &m_i2s_std_cfg.slot_cfg);
+        i2s_channel_reconfig_std_clock(m_i2s_tx_handle, &m_i2s_std_cfg.clk_cfg);
+        i2s_channel_reconfig_std_slot(m_i2s_tx_handle, &m_i2s_std_cfg.slot_cfg);
 
-    I2Sstart(m_i2s_num);
+        I2Sstart(m_i2s_num);
+    }
 
-    memset(m_filterBuff, 0, sizeof(m_filterBuff)); // Clear FilterBuffer
+    memset(m_iirState, 0, sizeof(m_iirState)); // Clear FilterBuffer
     IIR_calculateCoefficients(m_gain0, m_gain1, m_gain2); // must be recalculated after each samplerate change
+    m_sink->begin(m_resampler.isEnabled() ? rate : getSampleRate(), m_outputBits, 2); // playChunk always delivers stereo, 16 or 32 bit
     return;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-bool Audio::setBitrate(int br) {
-    m_bitRate = br;
-    if(br) return true;
-    return false;
+bool Audio::setBitrate(int br) {
+    m_bitRate = br;
+    if(br) return true;
+    return false;
+}
+uint32_t Audio::getBitRate(bool avg) {
+    if(avg) return m_avr_bitrate;
+    return m_bitRate;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setAudioSink(AudioSink* sink) {
+    // e.g. WavFileSink to record the stream or NullSink to measure the decoding speed, NULL switches back to I2S
+    if(!sink) sink = &m_i2sSink;
+    if(sink == m_sink) return;
+    xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ); // not in the middle of playChunk()
+    m_sink->end();
+    m_sink = sink;
+    m_sink->begin(m_resampler.isEnabled() ? m_resampler.outputRate() : getSampleRate(), m_outputBits, 2);
+    xSemaphoreGive(mutex_audioTask);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::setI2SOutputBits(uint8_t bits) {
+    // 16: all samples are int16_t from the decoder to the sink (default)
+    // 32: playChunk works with left justified int32_t samples, 24 bit FLAC keeps its resolution and the DSP chain
+    //     (equalizer, balance, volume) has no rounding noise in the audible range, the I2S slots are 32 bit wide
+    if(bits != 16 && bits != 32) return false;
+    if(bits == m_outputBits) return true;
+    xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ); // not in the middle of playChunk()
+    m_outputBits = bits;
+    x_ps_free(&m_outBuff);
+    m_outBuff = (int16_t*)x_ps_malloc(outBuffBytes()); // PSRAM if there is any, as in setPinout()
+    if(!m_outBuff) log_e("oom");
+    else memset(m_outBuff, 0, outBuffBytes());
+    m_validSamples = 0;
+    m_resampler.reset(); // the history has the old sample width
+    if(m_flacDecoder) FLACSetOutputBits(m_flacDecoder, bits);
+    reconfigI2S();
+    xSemaphoreGive(mutex_audioTask);
+    return m_outBuff != NULL;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::setOutputSampleRate(uint32_t hz, uint8_t quality) {
+    // hz 0: I2S is reconfigured to the rate of each stream (default), otherwise I2S stays at hz and playChunk()
+    // resamples every stream to it, there is then no gap between streams with different rates
+    // quality 0: linear interpolation (~60dB SNR at 1kHz, aliasing), 1: 8 taps (~60dB), 2: 16 taps (~75dB, default),
+    // 3: 32 taps (~80dB), the CPU time grows with the number of taps
+    xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ); // not in the middle of playChunk()
+    bool res = true;
+    if(hz) res = m_resampler.begin(hz, quality);
+    else m_resampler.end();
+    reconfigI2S();
+    xSemaphoreGive(mutex_audioTask);
+    return res;
 }
-uint32_t Audio::getBitRate(bool avg) {
-    if(avg) return m_avr_bitrate;
-    return m_bitRate;
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::setTTSCache(fs::FS& fs, const char* dir, uint32_t maxBytes) {
+    // connecttospeech() stores every new sentence in dir (SD, FFat, LittleFS...) and plays it from there the next time
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
+    if(m_ttsCacheFile) m_ttsCache.discard(m_ttsCacheKey, m_ttsCacheFile);
+    bool res = true;
+    if(maxBytes) res = m_ttsCache.begin(fs, dir, maxBytes);
+    else m_ttsCache.end();
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+    return res;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::setHLSPrefetch(uint8_t segments, uint32_t maxBytes) {
+    // the next segments of a m3u8 stream are loaded on a second connection while the current one plays
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
+    if(_client == &m_hlsCache) _client = m_hlsNetClient;
+    bool res = true;
+    if(segments) res = m_hlsCache.begin(segments, maxBytes);
+    else m_hlsCache.end();
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+    return res;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::setI2SCommFMT_LSB(bool commFMT) {
@@ -4891,20 +6389,22 @@ void Audio::setI2SCommFMT_LSB(bool commFMT) {
 
     m_f_commFMT = commFMT;
 
+    i2s_data_bit_width_t bw = (m_outputBits == 32) ? I2S_DATA_BIT_WIDTH_32BIT : I2S_DATA_BIT_WIDTH_16BIT;
     i2s_channel_disable(m_i2s_tx_handle);
     if(commFMT) {
         AUDIO_INFO("commFMT = LSBJ (Least Significant Bit Justified)");
-        m_i2s_std_cfg.slot_cfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO);
+        m_i2s_std_cfg.slot_cfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(bw, I2S_SLOT_MODE_STEREO);
     }
     else {
         AUDIO_INFO("commFMT = Philips");
-        m_i2s_std_cfg.slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO);
+        m_i2s_std_cfg.slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(bw, I2S_SLOT_MODE_STEREO);
     }
     i2s_channel_reconfig_std_slot(m_i2s_tx_handle, &m_i2s_std_cfg.slot_cfg);
     i2s_channel_enable(m_i2s_tx_handle);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::computeVUlevel(int16_t sample[2]) {
+void Audio::computeVUlevel(const void* buff, uint16_t frames, bool wide) {
+    // wide: buff holds left justified int32_t samples, the upper 16 bits are enough for the VU meter
     static uint8_t sampleArray[2][4][8] = {0};
     static uint8_t cnt0 = 0, cnt1 = 0, cnt2 = 0, cnt3 = 0, cnt4 = 0;
     static bool    f_vu = false;
@@ -4923,47 +6423,59 @@ void Audio::computeVUlevel(int16_t sample[2]) {
         return maxValue;
     };
 
-    if(cnt0 == 64) {
-        cnt0 = 0;
-        cnt1++;
-    }
-    if(cnt1 == 8) {
-        cnt1 = 0;
-        cnt2++;
-    }
-    if(cnt2 == 8) {
-        cnt2 = 0;
-        cnt3++;
-    }
-    if(cnt3 == 8) {
-        cnt3 = 0;
-        cnt4++;
-        f_vu = true;
-    }
-    if(cnt4 == 8) { cnt4 = 0; }
+    for(uint16_t f = 0; f < frames; f++) {
+        int16_t sample[2];
+        if(wide) {
+            sample[LEFTCHANNEL]  = ((const int32_t*)buff)[2 * f + LEFTCHANNEL] >> 16;
+            sample[RIGHTCHANNEL] = ((const int32_t*)buff)[2 * f + RIGHTCHANNEL] >> 16;
+        }
+        else {
+            sample[LEFTCHANNEL]  = ((const int16_t*)buff)[2 * f + LEFTCHANNEL];
+            sample[RIGHTCHANNEL] = ((const int16_t*)buff)[2 * f + RIGHTCHANNEL];
+        }
 
-    if(!cnt0) { // store every 64th sample in the array[0]
-        sampleArray[LEFTCHANNEL][0][cnt1] = abs(sample[LEFTCHANNEL] >> 7);
-        sampleArray[RIGHTCHANNEL][0][cnt1] = abs(sample[RIGHTCHANNEL] >> 7);
-    }
-    if(!cnt1) { // store argest from 64 * 8 samples in the array[1]
-        sampleArray[LEFTCHANNEL][1][cnt2] = largest(sampleArray[LEFTCHANNEL][0]);
-        sampleArray[RIGHTCHANNEL][1][cnt2] = largest(sampleArray[RIGHTCHANNEL][0]);
-    }
-    if(!cnt2) { // store avg from 64 * 8 * 8 samples in the array[2]
-        sampleArray[LEFTCHANNEL][2][cnt3] = largest(sampleArray[LEFTCHANNEL][1]);
-        sampleArray[RIGHTCHANNEL][2][cnt3] = largest(sampleArray[RIGHTCHANNEL][1]);
-    }
-    if(!cnt3) { // store avg from 64 * 8 * 8 * 8 samples in the array[3]
-        sampleArray[LEFTCHANNEL][3][cnt4] = avg(sampleArray[LEFTCHANNEL][2]);
-        sampleArray[RIGHTCHANNEL][3][cnt4] = avg(sampleArray[RIGHTCHANNEL][2]);
-    }
-    if(f_vu) {
-        f_vu = false;
-        m_vuLeft = avg(sampleArray[LEFTCHANNEL][3]);
-        m_vuRight = avg(sampleArray[RIGHTCHANNEL][3]);
+        if(cnt0 == 64) {
+            cnt0 = 0;
+            cnt1++;
+        }
+        if(cnt1 == 8) {
+            cnt1 = 0;
+            cnt2++;
+        }
+        if(cnt2 == 8) {
+            cnt2 = 0;
+            cnt3++;
+        }
+        if(cnt3 == 8) {
+            cnt3 = 0;
+            cnt4++;
+            f_vu = true;
+        }
+        if(cnt4 == 8) { cnt4 = 0; }
+
+        if(!cnt0) { // store every 64th sample in the array[0]
+            sampleArray[LEFTCHANNEL][0][cnt1] = abs(sample[LEFTCHANNEL] >> 7);
+            sampleArray[RIGHTCHANNEL][0][cnt1] = abs(sample[RIGHTCHANNEL] >> 7);
+        }
+        if(!cnt1) { // store argest from 64 * 8 samples in the array[1]
+            sampleArray[LEFTCHANNEL][1][cnt2] = largest(sampleArray[LEFTCHANNEL][0]);
+            sampleArray[RIGHTCHANNEL][1][cnt2] = largest(sampleArray[RIGHTCHANNEL][0]);
+        }
+        if(!cnt2) { // store avg from 64 * 8 * 8 samples in the array[2]
+            sampleArray[LEFTCHANNEL][2][cnt3] = largest(sampleArray[LEFTCHANNEL][1]);
+            sampleArray[RIGHTCHANNEL][2][cnt3] = largest(sampleArray[RIGHTCHANNEL][1]);
+        }
+        if(!cnt3) { // store avg from 64 * 8 * 8 * 8 samples in the array[3]
+            sampleArray[LEFTCHANNEL][3][cnt4] = avg(sampleArray[LEFTCHANNEL][2]);
+            sampleArray[RIGHTCHANNEL][3][cnt4] = avg(sampleArray[RIGHTCHANNEL][2]);
+        }
+        if(f_vu) {
+            f_vu = false;
+            m_vuLeft = avg(sampleArray[LEFTCHANNEL][3]);
+            m_vuRight = avg(sampleArray[RIGHTCHANNEL][3]);
+        }
+        cnt1++;
     }
-    cnt1++;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint16_t Audio::getVUlevel() {
@@ -4972,6 +6484,184 @@ uint16_t Audio::getVUlevel() {
     return (m_vuLeft << 8) + m_vuRight;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::setSpectrum(uint8_t bands, uint8_t decay, bool window) {
+    // bands: number of levels for getSpectrum(), 0 switches the analyzer off and frees its buffers (~5KB)
+    // decay: fall of a level per spectrum (~46/s), 0: the levels follow the signal immediately
+    // window: Hann window (less leakage between the bands), false: rectangular
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;} // not in the middle of playChunk()
+    bool res = true;
+    if(bands) res = m_spectrum.begin(bands, decay, window);
+    else m_spectrum.end();
+    xSemaphoreGive(mutex_audioTask);
+    return res;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint8_t Audio::getSpectrum(uint8_t* levels) {
+    // can be called from any task, levels must hold the number of bands given in setSpectrum()
+    if(!m_f_running) return 0;
+    return m_spectrum.read(levels);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::mixerAdd(AudioSource* src, uint8_t gain, bool voice) {
+    // voice: the music bus is ducked while the source plays, see setDucking()
+    // the source plays over the running stream, it is converted to its sample rate
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;} // not in the middle of playChunk()
+    bool res = m_mixer.add(src, gain, voice);
+    xSemaphoreGive(mutex_audioTask);
+    return res;
+}
+
+void Audio::mixerRemove(AudioSource* src) {
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return;}
+    m_mixer.remove(src);
+    xSemaphoreGive(mutex_audioTask);
+}
+
+void Audio::mixerSetGain(AudioSource* src, uint8_t gain) {
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return;}
+    m_mixer.setGain(src, gain);
+    xSemaphoreGive(mutex_audioTask);
+}
+
+bool Audio::mixerIsPlaying(AudioSource* src) {
+    return m_mixer.isPlaying(src);
+}
+
+void Audio::setDucking(uint8_t gain, uint16_t attackMs, uint16_t releaseMs) {
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return;}
+    m_mixer.setDucking(gain, attackMs, releaseMs);
+    xSemaphoreGive(mutex_audioTask);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::playAnnouncement(fs::FS& fs, const char* path, uint8_t gain) {
+    // plays a WAV file over the running stream (or alone), the decoder and the buffers of the stream are not touched
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
+    m_mixer.remove(&m_announcement, false); // a running announcement is replaced
+    bool res = m_announcement.open(fs, path);
+    if(res) res = m_mixer.add(&m_announcement, gain, true);
+    xSemaphoreGive(mutex_audioTask);
+    if(res) AUDIO_INFO("announcement \"%s\"", path);
+    return res;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::playSpeech(const char* speech, const char* lang, uint8_t gain) {
+    // connecttospeech() as a voice source of the mixer: the running stream is ducked, but keeps its decoder and buffers.
+    // The mp3 is downloaded completely on a connection of its own (or taken from the tts cache) before it is played,
+    // this blocks the caller for the download, but not the audio task.
+    if(!speech || !lang) return false;
+    uint64_t cacheKey = AudioFileCache::key("translate_tts", lang, speech);
+    uint8_t* mp3 = NULL;
+    uint32_t len = 0;
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); return false;}
+    bool cached = m_ttsCache.isEnabled() && m_ttsCache.lookup(cacheKey);
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+
+    if(!cached) {
+        mp3 = downloadSpeech(speech, lang, &len);
+        if(!mp3) return false;
+    }
+    if(xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ) != pdTRUE) {log_e("audio is busy, try again"); free(mp3); return false;}
+    if(mp3 && m_ttsCache.isEnabled()) { // the next time from the cache
+        File file = m_ttsCache.create(cacheKey);
+        if(file && file.write(mp3, len) == len) m_ttsCache.commit(cacheKey, file);
+        else m_ttsCache.discard(cacheKey, file);
+    }
+    if(cached && !m_ttsCache.lookup(cacheKey)) cached = false; // evicted in the meantime
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) { // not in the middle of playChunk()
+        log_e("audio is busy, try again");
+        xSemaphoreGiveRecursive(mutex_playAudioData);
+        free(mp3);
+        return false;
+    }
+    m_mixer.remove(&m_speech, false); // a running speech is replaced
+    bool res = false;
+    if(mp3)         res = m_speech.open(mp3, len); // owns the buffer now
+    else if(cached) res = m_speech.open(m_ttsCache.fs(), m_ttsCache.path(cacheKey));
+    if(res) res = m_mixer.add(&m_speech, gain, true);
+    xSemaphoreGive(mutex_audioTask);
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+    if(res) AUDIO_INFO("speech \"%s\"%s", speech, cached ? " from cache" : "");
+    return res;
+}
+
+uint8_t* Audio::downloadSpeech(const char* speech, const char* lang, uint32_t* len) {
+    // GET of the tts mp3 into a malloc'd buffer, HTTP/1.1 with 'Connection: close', the body may be chunked
+    const uint32_t maxLen = 256 * 1024; // some sentences of speech are about 50KB
+    audioClient_t  cl;
+    if(!sendTTSRequest(&cl, speech, lang)) return NULL;
+
+    char     line[256];
+    uint16_t pos = 0;
+    int      status = 0;
+    int32_t  contentLength = -1;
+    bool     f_chunked = false;
+    bool     f_header = true;
+    uint8_t* buff = NULL;
+    uint32_t size = 0, capacity = 0;
+    uint32_t t0 = millis();
+    while(millis() - t0 < 10000) {
+        int av = cl.available();
+        if(!av) {
+            if(!cl.connected() || (contentLength >= 0 && !f_header && size >= (uint32_t)contentLength)) break;
+            vTaskDelay(5);
+            continue;
+        }
+        if(f_header) { // line by line
+            char c = cl.read();
+            if(c != '\n') {if(c != '\r' && pos < sizeof(line) - 1) line[pos++] = c; continue;}
+            line[pos] = '\0';
+            pos = 0;
+            if(!status) { // "HTTP/1.1 200 OK"
+                const char* sp = strchr(line, ' ');
+                status = sp ? atoi(sp + 1) : -1;
+                if(status != 200) {log_e("speech: HTTP %i", status); break;}
+                continue;
+            }
+            if(line[0]) {
+                for(char* p = line; *p && *p != ':'; p++) *p = tolower(*p);
+                if(!strncmp(line, "content-length:", 15)) contentLength = atoi(line + 15);
+                if(!strncmp(line, "transfer-encoding:", 18) && strstr(line, "chunked")) f_chunked = true;
+                continue;
+            }
+            f_header = false; // end of the header
+            if(f_chunked) contentLength = -1;
+            continue;
+        }
+        if(size + av > capacity) {
+            capacity = min(max(capacity + 16384, contentLength > 0 ? (uint32_t)contentLength + 1 : (uint32_t)0), maxLen + 1);
+            if(size + 1 >= capacity) {log_e("speech: more than %lu bytes", (long unsigned)maxLen); break;}
+            uint8_t* p = (uint8_t*)(psramFound() ? ps_realloc(buff, capacity) : realloc(buff, capacity));
+            if(!p) {log_e("out of memory"); break;}
+            buff = p;
+        }
+        int n = cl.read(buff + size, min((uint32_t)av, capacity - 1 - size));
+        if(n > 0) size += n;
+    }
+    cl.stop();
+    if(f_header || status != 200 || !size || (contentLength >= 0 && size < (uint32_t)contentLength)) {
+        if(!f_header) log_e("speech: download incomplete");
+        free(buff);
+        return NULL;
+    }
+    if(f_chunked) { // <size in hex>\r\n<data>\r\n ... 0\r\n\r\n, the data is moved to the front
+        buff[size] = '\0';
+        uint32_t r = 0, w = 0;
+        while(r < size) {
+            uint32_t n = strtoul((char*)buff + r, NULL, 16);
+            uint8_t* eol = (uint8_t*)memchr(buff + r, '\n', size - r);
+            if(!n || !eol) break;
+            r = eol - buff + 1;
+            n = min(n, size - r);
+            memmove(buff + w, buff + r, n);
+            w += n;
+            r += n + 2;
+        }
+        size = w;
+    }
+    *len = size;
+    return buff;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass) {
     // see https://www.earlevel.com/main/2013/10/13/biquad-calculator-v2/
     // values can be between -40 ... +6 (dB)
@@ -4991,11 +6681,7 @@ void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass
           Because when the EQ is adjusted, the IIR filter will be cleared and played,
           mixed in the audio data frame, and a click-like sound will be produced.
 
-          int16_t tmp[2]; tmp[0] = 0; tmp[1]= 0;
-
-          IIR_filterChain0(tmp, true ); // flush the filter
-          IIR_filterChain1(tmp, true ); // flush the filter
-          IIR_filterChain2(tmp, true ); // flush the filter
+          memset(m_iirState, 0, sizeof(m_iirState)); // flush the delay lines of IIR_filterBlock
         */
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -5048,13 +6734,44 @@ void Audio::computeLimit() {    // is calculated when the volume or balance chan
     m_limit_left = l * v;
     m_limit_right = r * v;
 
+    m_gainLeft  = (int32_t)(m_limit_left  * 32768 + 0.5); // Q15, 32768 is unity gain
+    m_gainRight = (int32_t)(m_limit_right * 32768 + 0.5);
+
     // log_i("m_limit_left %f,  m_limit_right %f ",m_limit_left, m_limit_right);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::Gain(int16_t* sample) {
+template <typename T> void Audio::processBlock(T* buff, uint16_t frames) {
+    // block processing, every stage runs over the whole buffer, disabled stages are skipped
+    // T is int16_t or left justified int32_t (setI2SOutputBits(32)), interleaved stereo in both cases
+    computeVUlevel(buff, frames, sizeof(T) == sizeof(int32_t));
+    m_spectrum.feed(buff, frames, sizeof(T) == sizeof(int32_t), getSampleRate());
+    IIR_filterBlock(buff, frames);
+    if(m_f_forceMono && m_channels == 2){
+        for(int i = 0; i < frames * 2; i += 2) {
+            T xy = ((int64_t)buff[i + RIGHTCHANNEL] + buff[i + LEFTCHANNEL]) / 2;
+            buff[i + RIGHTCHANNEL] = xy;
+            buff[i + LEFTCHANNEL]  = xy;
+        }
+    }
+    Gain(buff, frames);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+template <typename T> void Audio::Gain(T* buff, uint16_t frames) {
     /* important: these multiplications must all be signed ints, or the result will be invalid */
-    sample[LEFTCHANNEL]  *= m_limit_left ;
-    sample[RIGHTCHANNEL] *= m_limit_right;
+    const int32_t gl = m_gainLeft;
+    const int32_t gr = m_gainRight;
+    if(gl == 32768 && gr == 32768) return; // unity gain, nothing to do
+
+    for(uint16_t f = 0; f < frames; f++) {
+        if(sizeof(T) == sizeof(int16_t)) { // the product fits into 32 bits
+            buff[2 * f + LEFTCHANNEL]  = (buff[2 * f + LEFTCHANNEL]  * gl) >> 15;
+            buff[2 * f + RIGHTCHANNEL] = (buff[2 * f + RIGHTCHANNEL] * gr) >> 15;
+        }
+        else {
+            buff[2 * f + LEFTCHANNEL]  = ((int64_t)buff[2 * f + LEFTCHANNEL]  * gl) >> 15;
+            buff[2 * f + RIGHTCHANNEL] = ((int64_t)buff[2 * f + RIGHTCHANNEL] * gr) >> 15;
+        }
+    }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::inBufferFilled() {
@@ -5169,6 +6886,8 @@ void Audio::IIR_calculateCoefficients(int8_t G0, int8_t G1, int8_t G2) { // Infi
         m_filter[HIFGSHELF].b2 = (V - sqrtf(2 * V) * K + K * K) * norm;
     }
 
+    IIR_loadCoefficients();
+
     //    log_i("LS a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", m_filter[0].a0, m_filter[0].a1, m_filter[0].a2,
     //                                                  m_filter[0].b1, m_filter[0].b2);
     //    log_i("EQ a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", m_filter[1].a0, m_filter[1].a1, m_filter[1].a2,
@@ -5177,146 +6896,77 @@ void Audio::IIR_calculateCoefficients(int8_t G0, int8_t G1, int8_t G2) { // Infi
     //                                                  m_filter[2].b1, m_filter[2].b2);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-// clang-format off
-void Audio::IIR_filterChain0(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-    float          inSample[2];
-    float          outSample[2];
-    static int16_t iir_out[2];
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        iir_out[0] = 0;
-        iir_out[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    inSample[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    inSample[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    outSample[LEFTCHANNEL] =
-        m_filter[0].a0 * inSample[LEFTCHANNEL] + m_filter[0].a1 * m_filterBuff[0][z1][in][LEFTCHANNEL] +
-        m_filter[0].a2 * m_filterBuff[0][z2][in][LEFTCHANNEL] - m_filter[0].b1 * m_filterBuff[0][z1][out][LEFTCHANNEL] -
-        m_filter[0].b2 * m_filterBuff[0][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[0][z2][in][LEFTCHANNEL] = m_filterBuff[0][z1][in][LEFTCHANNEL];
-    m_filterBuff[0][z1][in][LEFTCHANNEL] = inSample[LEFTCHANNEL];
-    m_filterBuff[0][z2][out][LEFTCHANNEL] = m_filterBuff[0][z1][out][LEFTCHANNEL];
-    m_filterBuff[0][z1][out][LEFTCHANNEL] = outSample[LEFTCHANNEL];
-    iir_out[LEFTCHANNEL] = (int16_t)outSample[LEFTCHANNEL];
-
-    outSample[RIGHTCHANNEL] = m_filter[0].a0 * inSample[RIGHTCHANNEL] +
-                              m_filter[0].a1 * m_filterBuff[0][z1][in][RIGHTCHANNEL] +
-                              m_filter[0].a2 * m_filterBuff[0][z2][in][RIGHTCHANNEL] -
-                              m_filter[0].b1 * m_filterBuff[0][z1][out][RIGHTCHANNEL] -
-                              m_filter[0].b2 * m_filterBuff[0][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[0][z2][in][RIGHTCHANNEL] = m_filterBuff[0][z1][in][RIGHTCHANNEL];
-    m_filterBuff[0][z1][in][RIGHTCHANNEL] = inSample[RIGHTCHANNEL];
-    m_filterBuff[0][z2][out][RIGHTCHANNEL] = m_filterBuff[0][z1][out][RIGHTCHANNEL];
-    m_filterBuff[0][z1][out][RIGHTCHANNEL] = outSample[RIGHTCHANNEL];
-    iir_out[RIGHTCHANNEL] = (int16_t)outSample[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = iir_out[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = iir_out[RIGHTCHANNEL];
-    return;
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::IIR_filterChain1(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-    float          inSample[2];
-    float          outSample[2];
-    static int16_t iir_out[2];
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        iir_out[0] = 0;
-        iir_out[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    inSample[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    inSample[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    outSample[LEFTCHANNEL] =
-        m_filter[1].a0 * inSample[LEFTCHANNEL] + m_filter[1].a1 * m_filterBuff[1][z1][in][LEFTCHANNEL] +
-        m_filter[1].a2 * m_filterBuff[1][z2][in][LEFTCHANNEL] - m_filter[1].b1 * m_filterBuff[1][z1][out][LEFTCHANNEL] -
-        m_filter[1].b2 * m_filterBuff[1][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[1][z2][in][LEFTCHANNEL] = m_filterBuff[1][z1][in][LEFTCHANNEL];
-    m_filterBuff[1][z1][in][LEFTCHANNEL] = inSample[LEFTCHANNEL];
-    m_filterBuff[1][z2][out][LEFTCHANNEL] = m_filterBuff[1][z1][out][LEFTCHANNEL];
-    m_filterBuff[1][z1][out][LEFTCHANNEL] = outSample[LEFTCHANNEL];
-    iir_out[LEFTCHANNEL] = (int16_t)outSample[LEFTCHANNEL];
-
-    outSample[RIGHTCHANNEL] = m_filter[1].a0 * inSample[RIGHTCHANNEL] +
-                              m_filter[1].a1 * m_filterBuff[1][z1][in][RIGHTCHANNEL] +
-                              m_filter[1].a2 * m_filterBuff[1][z2][in][RIGHTCHANNEL] -
-                              m_filter[1].b1 * m_filterBuff[1][z1][out][RIGHTCHANNEL] -
-                              m_filter[1].b2 * m_filterBuff[1][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[1][z2][in][RIGHTCHANNEL] = m_filterBuff[1][z1][in][RIGHTCHANNEL];
-    m_filterBuff[1][z1][in][RIGHTCHANNEL] = inSample[RIGHTCHANNEL];
-    m_filterBuff[1][z2][out][RIGHTCHANNEL] = m_filterBuff[1][z1][out][RIGHTCHANNEL];
-    m_filterBuff[1][z1][out][RIGHTCHANNEL] = outSample[RIGHTCHANNEL];
-    iir_out[RIGHTCHANNEL] = (int16_t)outSample[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = iir_out[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = iir_out[RIGHTCHANNEL];
-    return;
+void Audio::IIR_loadCoefficients() {
+    // copies the three biquads into the layout used by IIR_filterBlock: {b0, b1, b2, a1, a2} per stage, the same order
+    // as ESP-DSP dsps_biquad_f32(). The level correction m_corr is folded into the first stage, so there is no extra
+    // division per sample. If all gains are 0dB the filters are transparent and the whole chain is skipped.
+
+    bool flat = (m_gain0 == 0 && m_gain1 == 0 && m_gain2 == 0);
+    if(flat && !m_f_iirFlat) memset(m_iirState, 0, sizeof(m_iirState));
+    m_f_iirFlat = flat;
+
+    for(int i = 0; i < 3; i++) {
+        float corr = (i == 0 && m_corr > 1) ? 1 / m_corr : 1;
+        float c[5] = {m_filter[i].a0 * corr, m_filter[i].a1 * corr, m_filter[i].a2 * corr, m_filter[i].b1, m_filter[i].b2};
+        for(int j = 0; j < 5; j++) {
+#ifdef AUDIO_DSP_FIXED_POINT
+            m_iirCoef[i][j] = (int32_t)lrintf(c[j] * (1 << 29)); // Q2.29
+#else
+            m_iirCoef[i][j] = c[j];
+#endif
+        }
+    }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::IIR_filterChain2(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-    float          inSample[2];
-    float          outSample[2];
-    static int16_t iir_out[2];
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        iir_out[0] = 0;
-        iir_out[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    inSample[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    inSample[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    outSample[LEFTCHANNEL] =
-        m_filter[2].a0 * inSample[LEFTCHANNEL] + m_filter[2].a1 * m_filterBuff[2][z1][in][LEFTCHANNEL] +
-        m_filter[2].a2 * m_filterBuff[2][z2][in][LEFTCHANNEL] - m_filter[2].b1 * m_filterBuff[2][z1][out][LEFTCHANNEL] -
-        m_filter[2].b2 * m_filterBuff[2][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[2][z2][in][LEFTCHANNEL] = m_filterBuff[2][z1][in][LEFTCHANNEL];
-    m_filterBuff[2][z1][in][LEFTCHANNEL] = inSample[LEFTCHANNEL];
-    m_filterBuff[2][z2][out][LEFTCHANNEL] = m_filterBuff[2][z1][out][LEFTCHANNEL];
-    m_filterBuff[2][z1][out][LEFTCHANNEL] = outSample[LEFTCHANNEL];
-    iir_out[LEFTCHANNEL] = (int16_t)outSample[LEFTCHANNEL];
-
-    outSample[RIGHTCHANNEL] = m_filter[2].a0 * inSample[RIGHTCHANNEL] +
-                              m_filter[2].a1 * m_filterBuff[2][z1][in][RIGHTCHANNEL] +
-                              m_filter[2].a2 * m_filterBuff[2][z2][in][RIGHTCHANNEL] -
-                              m_filter[2].b1 * m_filterBuff[2][z1][out][RIGHTCHANNEL] -
-                              m_filter[2].b2 * m_filterBuff[2][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[2][z2][in][RIGHTCHANNEL] = m_filterBuff[2][z1][in][RIGHTCHANNEL];
-    m_filterBuff[2][z1][in][RIGHTCHANNEL] = inSample[RIGHTCHANNEL];
-    m_filterBuff[2][z2][out][RIGHTCHANNEL] = m_filterBuff[2][z1][out][RIGHTCHANNEL];
-    m_filterBuff[2][z1][out][RIGHTCHANNEL] = outSample[RIGHTCHANNEL];
-    iir_out[RIGHTCHANNEL] = (int16_t)outSample[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = iir_out[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = iir_out[RIGHTCHANNEL];
-    return;
+// clang-format off
+template <typename T> void Audio::IIR_filterBlock(T* buff, uint16_t frames) { // Infinite Impulse Response (IIR) filters
+
+    // three cascaded biquads (low shelf, peak EQ, high shelf) in direct form I, one pass per channel over the whole
+    // block, the filter state lives in local variables (registers) and is written back at the end of the block.
+    // The intermediate values between the stages are not rounded to int16, only the output is saturated.
+    // int16_t samples get 8 fractional bits in the fixed point state, left justified int32_t samples give up
+    // their lowest 4 bits for headroom instead.
+
+    if(m_f_iirFlat) return;
+    const bool    wide = (sizeof(T) == sizeof(int32_t));
+    const int64_t hi   = wide ? INT32_MAX : INT16_MAX;
+    const int64_t lo   = wide ? INT32_MIN : INT16_MIN;
+
+    for(uint8_t ch = 0; ch < 2; ch++) {
+        iir_state_t z[3][4]; // x1, x2, y1, y2 per stage
+        memcpy(z, m_iirState[ch], sizeof(z));
+        T* p = buff + ch;
+
+#ifdef AUDIO_DSP_FIXED_POINT
+        const int32_t (*c)[5] = m_iirCoef;
+        for(uint16_t f = 0; f < frames; f++, p += 2) {
+            int32_t x = wide ? (int32_t)*p >> 4 : (int32_t)*p << 8; // Q.8, gives the state some fractional bits
+            for(int st = 0; st < 3; st++) {
+                int64_t acc = (int64_t)c[st][0] * x + (int64_t)c[st][1] * z[st][0] + (int64_t)c[st][2] * z[st][1]
+                            - (int64_t)c[st][3] * z[st][2] - (int64_t)c[st][4] * z[st][3];
+                int32_t y = (int32_t)(acc >> 29);
+                z[st][1] = z[st][0]; z[st][0] = x;
+                z[st][3] = z[st][2]; z[st][2] = y;
+                x = y;
+            }
+            int64_t o = wide ? (int64_t)x << 4 : x >> 8;
+            *p = (o > hi) ? hi : (o < lo) ? lo : o;
+        }
+#else
+        const float (*c)[5] = m_iirCoef;
+        for(uint16_t f = 0; f < frames; f++, p += 2) {
+            float x = *p;
+            for(int st = 0; st < 3; st++) {
+                float y = c[st][0] * x + c[st][1] * z[st][0] + c[st][2] * z[st][1] - c[st][3] * z[st][2] - c[st][4] * z[st][3];
+                z[st][1] = z[st][0]; z[st][0] = x;
+                z[st][3] = z[st][2]; z[st][2] = y;
+                x = y;
+            }
+            *p = (x >= (float)hi) ? hi : (x <= (float)lo) ? lo : (T)x; // (float)INT32_MAX is 2^31, no overflow
+        }
+#endif
+        memcpy(m_iirState[ch], z, sizeof(z));
+    }
 }
 // clang-format on
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -5977,25 +7627,16 @@ uint32_t Audio::m4a_correctResumeFilePos(uint32_t resumeFilePos) {
 
     if(!m_stsz_position) return m_audioDataStart; // guard
 
-    typedef union {
-        uint8_t  u8[4];
-        uint32_t u32;
-    } tu;
-    tu uu;
-
-    uint32_t i = 0, pos = m_audioDataStart;
-    audiofile.seek(m_stsz_position);
-
-    while(i < m_stsz_numEntries) {
-        i++;
-        uu.u8[3] = audiofile.read();
-        uu.u8[2] = audiofile.read();
-        uu.u8[1] = audiofile.read();
-        uu.u8[0] = audiofile.read();
-        pos += uu.u32;
-        if(pos >= resumeFilePos) break;
+    uint32_t first = 0, pos = m_audioDataStart;
+    int32_t  lo = 0, hi = (int32_t)m_seekIndexLen - 1;
+    while(lo <= hi) { // the last chunk in front of resumeFilePos, the walk through stsz starts there
+        int32_t mid = (lo + hi) / 2;
+        if(m_seekIndex[mid].pos <= resumeFilePos) {first = m_seekIndex[mid].unit; pos = m_seekIndex[mid].pos; lo = mid + 1;}
+        else hi = mid - 1;
     }
-    return pos;
+    uint32_t bytes = 0;
+    if(pos < resumeFilePos) m4a_walkStsz(first, m_stsz_numEntries - first, &bytes, resumeFilePos - pos);
+    return pos + bytes;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::ogg_correctResumeFilePos(uint32_t resumeFilePos) {
@@ -6058,29 +7699,29 @@ exit:
     return -1;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+static const int16_t mp3_bitrateTab[3][3][15] PROGMEM = { {
+    /* MPEG-1 */
+    { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 }, /* Layer 1 */
+    { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 }, /* Layer 2 */
+    { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 }, /* Layer 3 */
+    }, {
+    /* MPEG-2 */
+    { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 }, /* Layer 1 */
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 2 */
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 3 */
+    }, {
+    /* MPEG-2.5 */
+    { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 }, /* Layer 1 */
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 2 */
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 3 */
+}, };
+
 int32_t Audio::mp3_correctResumeFilePos(uint32_t resumeFilePos) {
 
     // The SncronWord sequence 0xFF 0xF? can be part of valid audio data. Therefore, it cannot be ensured that the next 0xFFF is really the beginning
     // of a new MP3 frame. Therefore, the following byte is parsed. If the bitrate and sample rate match the one currently being played,
     // the beginning of a new MP3 frame is likely.
 
-    const int16_t bitrateTab[3][3][15] PROGMEM = { {
-        /* MPEG-1 */
-        { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 }, /* Layer 1 */
-        { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 }, /* Layer 2 */
-        { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 }, /* Layer 3 */
-        }, {
-        /* MPEG-2 */
-        { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 }, /* Layer 1 */
-        { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 2 */
-        { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 3 */
-        }, {
-        /* MPEG-2.5 */
-        { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 }, /* Layer 1 */
-        { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 2 */
-        { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }, /* Layer 3 */
-    }, };
-
     auto find_sync_word = [&](size_t pos) -> int {
         int steps = 0;
         audiofile.seek(pos); // Set the file pointer to the given position
@@ -6119,25 +7760,640 @@ int32_t Audio::mp3_correctResumeFilePos(uint32_t resumeFilePos) {
         uint8_t  layer = 4 - ((syncL >> 1) & 0x03);
         if(srIdx == 3 || layer == 4 || brIdx == 15) {pos++; continue;}
         if(brIdx){
-            uint32_t bitrate = ((int32_t) bitrateTab[mpegVers][layer - 1][brIdx]) * 1000;
+            uint32_t bitrate = ((int32_t) mp3_bitrateTab[mpegVers][layer - 1][brIdx]) * 1000;
             uint32_t samplerate = samplerateTab[mpegVers][srIdx];
         //    log_e("%02X, %02X bitrate %i, samplerate %i", syncH, syncL, bitrate, samplerate);
-            if(MP3GetBitrate() == bitrate && getSampleRate() == samplerate) break;
+            if(MP3GetBitrate(m_mp3Decoder) == bitrate && getSampleRate() == samplerate) break;
         }
         pos++;
     }
     return pos;
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//    S E E K   I N D E X
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// setAudioPlayPosition() and setTimeOffset() know the play time, but a byte position estimated from the average bitrate
+// misses it by seconds in VBR files. When a local file is opened, buildSeekIndex() collects what the container offers
+// (FLAC SEEKTABLE, Xing/VBRI TOC, m4a chunk table) and seekByTime() turns a time into the position of a frame in
+// front of it plus the time that sendBytes() has to drop after decoding. Ogg files have a granule position in every
+// page header, they are bisected without an index.
+
+#define SEEK_INDEX_MAX 1024 // 8 KB
+
+static uint8_t flac_crc8(const uint8_t* data, uint8_t len) { // polynomial x^8 + x^2 + x^1 + x^0
+    uint8_t crc = 0;
+    while(len--) {
+        crc ^= *data++;
+        for(int i = 0; i < 8; i++) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+    }
+    return crc;
+}
+
+typedef struct {
+    uint8_t  version;  // MPEG1, MPEG2, MPEG25
+    uint8_t  layer;    // 1 ... 3
+    uint8_t  mono;
+    uint16_t samplesPerFrame;
+    uint32_t sampleRate;
+    uint32_t bitRate;
+    uint32_t frameLen; // in bytes, including the header
+} mp3FrameHeader_t;
+
+static bool mp3_frameHeader(const uint8_t* h, mp3FrameHeader_t* f) {
+    if(h[0] != 0xFF || (h[1] & 0xE0) != 0xE0) return false;
+    uint8_t verIdx = (h[1] >> 3) & 0x03;
+    uint8_t layerIdx = (h[1] >> 1) & 0x03;
+    uint8_t brIdx = (h[2] >> 4) & 0x0F;
+    uint8_t srIdx = (h[2] >> 2) & 0x03;
+    uint8_t padding = (h[2] >> 1) & 0x01;
+    if(verIdx == 1 || layerIdx == 0 || brIdx == 0 || brIdx == 15 || srIdx == 3) return false; // reserved or free format
+    f->version = (verIdx == 0 ? MPEG25 : ((verIdx & 0x01) ? MPEG1 : MPEG2));
+    f->layer = 4 - layerIdx;
+    f->mono = ((h[3] >> 6) & 0x03) == 3;
+    f->samplesPerFrame = samplesPerFrameTab[f->version][f->layer - 1];
+    f->sampleRate = samplerateTab[f->version][srIdx];
+    f->bitRate = (uint32_t)mp3_bitrateTab[f->version][f->layer - 1][brIdx] * 1000;
+    if(f->layer == 1) f->frameLen = (12 * f->bitRate / f->sampleRate + padding) * 4;
+    else              f->frameLen = f->samplesPerFrame / 8 * f->bitRate / f->sampleRate + padding;
+    return true;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::buildSeekIndex() {
+    if(m_dataMode != AUDIO_LOCALFILE || !audiofile) return;
+    clearSeekIndex();
+    uint32_t pos = audiofile.position();
+    if(m_codec == CODEC_MP3) mp3_buildSeekIndex();
+    if(m_codec == CODEC_M4A) m4a_buildSeekIndex();
+    if(m_codec == CODEC_FLAC && !m_f_oggFile) flac_buildSeekIndex();
+    if(m_codec == CODEC_OPUS) {int64_t g = ogg_lastGranule(); if(g > 0) m_trimEnd = g;} // OPUS: granule 0 is the first pre-skip sample
+    audiofile.seek(pos);
+    if(m_seekIndexLen) AUDIO_INFO("seek index: %u points", m_seekIndexLen);
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::clearSeekIndex() {
+    if(m_seekIndex) {free(m_seekIndex); m_seekIndex = NULL;}
+    m_seekIndexLen = 0;
+    m_seekUnitsPerSec = 0;
+    m_seekDuration = 0;
+    m_seekTime = -1;
+    m_seekSkipTime = 0;
+    m_seekNewTime = -1;
+    m_mp3FrameBytes = 0;
+    m_mp3FirstFrame = 0;
+    m_mp3StreamId = 0;
+    m_stsz_sampleSize = 0;
+    m_trimDelay = 0;
+    m_trimEnd = 0;
+    m_trimPos = 0;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t Audio::allocSeekIndex(uint32_t points) {
+    // returns the stride, every stride-th point is stored, 0: no memory
+    if(!points) return 0;
+    uint32_t stride = (points + SEEK_INDEX_MAX - 1) / SEEK_INDEX_MAX;
+    uint32_t n = (points + stride - 1) / stride;
+    m_seekIndex = (seekPoint_t*)x_ps_calloc(n, sizeof(seekPoint_t));
+    m_seekIndexLen = 0;
+    return m_seekIndex ? stride : 0;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::seekIndexFind(uint32_t unit) {
+    // index of the last point with m_seekIndex[i].unit <= unit, -1 if there is none
+    int32_t lo = 0, hi = (int32_t)m_seekIndexLen - 1, found = -1;
+    while(lo <= hi) {
+        int32_t mid = (lo + hi) / 2;
+        if(m_seekIndex[mid].unit <= unit) {found = mid; lo = mid + 1;}
+        else hi = mid - 1;
+    }
+    return found;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::seekByTime(float sec, float* skip) {
+    // returns the file position where the decoder has to start, -1 if the position can only be estimated
+    *skip = 0;
+    if(m_dataMode != AUDIO_LOCALFILE || !audiofile || sec < 0) return -1;
+    int32_t pos = -1;
+#if defined(AUDIO_LOG) && ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+    uint32_t t0 = millis(); // only for the log line below, unused if log_i() is compiled out
+#endif
+    if(m_f_oggFile || m_codec == CODEC_OPUS || m_codec == CODEC_VORBIS) pos = ogg_seekByTime(sec, skip); // OPUS and VORBIS come in ogg only
+    else if(m_codec == CODEC_FLAC) pos = flac_seekByTime(sec, skip);
+    else if(m_codec == CODEC_MP3)  pos = mp3_seekByTime(sec, skip);
+    else if(m_codec == CODEC_M4A)  pos = m4a_seekByTime(sec, skip);
+    else if(m_codec == CODEC_WAV) {
+        uint16_t blockAlign = getChannels() * getBitsPerSample() / 8;
+        uint32_t p = m_audioDataStart + (uint32_t)(sec * getSampleRate()) * blockAlign;
+        if(blockAlign && p < m_audioDataStart + m_audioDataSize) pos = p;
+    }
+    if(pos < (int32_t)m_audioDataStart || pos >= (int32_t)(m_audioDataStart + m_audioDataSize)) {*skip = 0; return -1;}
+#if defined(AUDIO_LOG) && ARDUHAL_LOG_LEVEL >= ARDUHAL_LOG_LEVEL_INFO
+    if(m_f_Log) log_i("seek to %.3fs: pos %i, skip %.3fs, %lums", sec, pos, *skip, (long unsigned int)(millis() - t0));
+#endif
+    return pos;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::flac_buildSeekIndex() {
+    // METADATA_BLOCK_SEEKTABLE: 18 bytes per point, sample number (8), offset to the first frame (8), samples (2)
+    if(!m_flacSampleRate) return;
+    m_seekUnitsPerSec = m_flacSampleRate;
+    if(m_flacTotalSamplesInStream) m_seekDuration = (float)m_flacTotalSamplesInStream / m_flacSampleRate;
+
+    uint8_t  hdr[18];
+    uint32_t pos = 4; // behind "fLaC"
+    while(pos + 4 <= m_audioDataStart) {
+        audiofile.seek(pos);
+        if(audiofile.read(hdr, 4) != 4) return;
+        uint32_t len = bigEndian(hdr + 1, 3);
+        if((hdr[0] & 0x7F) == 3) {
+            uint32_t points = len / 18;
+            uint32_t stride = allocSeekIndex(points);
+            if(!stride) return;
+            for(uint32_t i = 0; i < points; i++) {
+                if(audiofile.read(hdr, 18) != 18) break;
+                if(i % stride) continue;
+                uint64_t sample = ((uint64_t)bigEndian(hdr, 4) << 32) | bigEndian(hdr + 4, 4);
+                uint64_t offset = ((uint64_t)bigEndian(hdr + 8, 4) << 32) | bigEndian(hdr + 12, 4);
+                if(sample > 0xFFFFFFFF || offset >= m_audioDataSize) continue; // placeholder points are 0xFFFFFFFFFFFFFFFF
+                m_seekIndex[m_seekIndexLen].unit = sample;
+                m_seekIndex[m_seekIndexLen].pos = m_audioDataStart + offset;
+                m_seekIndexLen++;
+            }
+            return;
+        }
+        if(hdr[0] & 0x80) return; // last metadata block
+        pos += 4 + len;
+    }
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::flac_probeFrame(uint32_t pos, uint32_t limit, uint64_t* sample) {
+    // returns the position of the next frame header at or behind pos, the header CRC-8 must match
+    uint8_t buf[512];
+    const uint8_t maxHeaderLen = 16;
+    uint32_t end = m_audioDataStart + m_audioDataSize;
+    if(limit > end) limit = end;
+    while(pos + 6 < limit) {
+        audiofile.seek(pos);
+        int32_t n = audiofile.read(buf, sizeof(buf));
+        if(n < 6) return -1;
+        int32_t scan = (n == sizeof(buf)) ? n - maxHeaderLen : n - 1;
+        for(int32_t i = 0; i < scan && pos + i < limit; i++) {
+            const uint8_t* h = buf + i;
+            if(h[0] != 0xFF || (h[1] & 0xFE) != 0xF8) continue;
+            uint8_t bsCode = h[2] >> 4, srCode = h[2] & 0x0F;
+            if(bsCode == 0 || srCode == 15 || (h[3] >> 4) > 10 || ((h[3] >> 1) & 0x07) == 3 || (h[3] & 0x01)) continue;
+            uint8_t  k = 4;
+            uint64_t num = h[k];
+            uint8_t  extra;
+            if     (!(num & 0x80))        {extra = 0;}
+            else if((num & 0xE0) == 0xC0) {extra = 1; num &= 0x1F;}
+            else if((num & 0xF0) == 0xE0) {extra = 2; num &= 0x0F;}
+            else if((num & 0xF8) == 0xF0) {extra = 3; num &= 0x07;}
+            else if((num & 0xFC) == 0xF8) {extra = 4; num &= 0x03;}
+            else if((num & 0xFE) == 0xFC) {extra = 5; num &= 0x01;}
+            else if( num == 0xFE)         {extra = 6; num = 0;}
+            else continue;
+            k++;
+            bool valid = true;
+            while(extra--) {
+                if((h[k] & 0xC0) != 0x80) {valid = false; break;}
+                num = (num << 6) | (h[k] & 0x3F);
+                k++;
+            }
+            if(!valid) continue;
+            if(bsCode == 6) k += 1;
+            if(bsCode == 7) k += 2;
+            if(srCode == 12) k += 1;
+            if(srCode == 13 || srCode == 14) k += 2;
+            if(i + k >= n || flac_crc8(h, k) != h[k]) continue;
+            *sample = (h[1] & 0x01) ? num : num * m_flacMaxBlockSize; // variable blocksize: sample number, fixed: frame number
+            return pos + i;
+        }
+        if(n < (int32_t)sizeof(buf)) return -1;
+        pos += scan;
+    }
+    return -1;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::flac_seekByTime(float sec, float* skip) {
+    // the SEEKTABLE narrows the range, the rest is a bisection over the frame headers
+    if(!m_flacSampleRate || !m_flacMaxBlockSize) return -1;
+    uint64_t target = sec * m_flacSampleRate;
+    uint32_t lo = m_audioDataStart, hi = m_audioDataStart + m_audioDataSize;
+    uint32_t span = m_flacMaxFrameSize ? m_flacMaxFrameSize : 16384;
+    uint64_t s = 0, loSample = 0;
+    int32_t  i = seekIndexFind(target);
+    if(i >= 0) lo = m_seekIndex[i].pos;
+    if(i + 1 < m_seekIndexLen) hi = m_seekIndex[i + 1].pos + span;
+
+    int32_t p = flac_probeFrame(lo, hi, &loSample);
+    if(p < 0 || loSample > target) return -1;
+    lo = p;
+    while(hi - lo > 2 * span) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        p = flac_probeFrame(mid, hi, &s);
+        if(p < 0 || s > target) hi = mid;
+        else {lo = p; loSample = s;}
+    }
+    for(int n = 0; n < 64; n++) { // the last few frames one by one
+        p = flac_probeFrame(lo + 1, hi + span, &s);
+        if(p < 0 || s > target || s < loSample) break;
+        lo = p; loSample = s;
+    }
+    *skip = (float)(target - loSample) / m_flacSampleRate;
+    return lo;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::ogg_probePage(uint32_t pos, uint32_t limit, int64_t* granule, uint32_t* pageLen) {
+    // returns the position of the next page header at or behind pos
+    uint8_t buf[512];
+    uint32_t end = m_audioDataStart + m_audioDataSize;
+    if(limit > end) limit = end;
+    while(pos + 27 < limit) {
+        audiofile.seek(pos);
+        int32_t n = audiofile.read(buf, sizeof(buf));
+        if(n < 27) return -1;
+        int32_t i = 0, idx = 0;
+        while((idx = OGGfindSyncWord(buf + i, n - i)) >= 0 && pos + i + idx < limit) {
+            i += idx;
+            uint8_t   hdr[27 + 255];
+            oggPage_t page;
+            audiofile.seek(pos + i);
+            int32_t r = OGGparsePage(hdr, audiofile.read(hdr, sizeof(hdr)), &page, NULL);
+            if(r == ERR_OGG_TOO_SHORT) return -1;
+            if(r < 0) {i++; continue;} // "OggS" inside the audio data or corrupted page
+            *granule = page.granulePosition;
+            *pageLen = page.headerSize + page.bodySize;
+            return pos + i;
+        }
+        if(n < (int32_t)sizeof(buf)) return -1;
+        pos += n - 3;
+    }
+    return -1;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::ogg_seekByTime(float sec, float* skip) {
+    // The granule position of a page is the sample number at the end of its last packet (OPUS: always 48kHz),
+    // the decoder starts with the page behind the last page that ends in front of the requested time.
+    uint32_t rate = (m_codec == CODEC_OPUS) ? 48000 : getSampleRate();
+    if(!rate) return -1;
+    int64_t  target = sec * rate;
+    int64_t  g = 0;
+    uint32_t len = 0;
+    uint32_t lo = m_audioDataStart, hi = m_audioDataStart + m_audioDataSize;
+    int32_t  p;
+
+    while(hi - lo > 16384) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        p = ogg_probePage(mid, hi, &g, &len);
+        while(p >= 0 && g == -1) p = ogg_probePage(p + len, hi, &g, &len); // no packet ends on this page
+        if(p < 0 || g > target) hi = mid;
+        else lo = p;
+    }
+    int32_t startPos = -1;
+    int64_t startGranule = 0;
+    p = ogg_probePage(lo, hi, &g, &len);
+    while(p >= 0) {
+        if(g != -1) {
+            if(g > target) break;
+            if(g > 0) {startPos = p + len; startGranule = g;} // granule 0: header pages
+        }
+        p = ogg_probePage(p + len, m_audioDataStart + m_audioDataSize, &g, &len);
+    }
+    if(startPos < 0) return -1;
+    *skip = (float)(target - startGranule) / rate;
+    return startPos;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int64_t Audio::ogg_lastGranule() {
+    // granule position of the last page, the end of the file is searched backwards, -1: not found
+    uint32_t end = m_audioDataStart + m_audioDataSize, len = 0;
+    int64_t  g = -1, last = -1;
+    for(uint32_t back = 8192; back <= 65536 && last < 0; back *= 2) {
+        uint32_t pos = (end > m_audioDataStart + back) ? end - back : m_audioDataStart;
+        int32_t  p = ogg_probePage(pos, end, &g, &len);
+        while(p >= 0) {
+            if(g > 0) last = g;
+            p = ogg_probePage(p + len, end, &g, &len);
+        }
+        if(pos == m_audioDataStart) break;
+    }
+    return last;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::mp3_buildSeekIndex() {
+    // The first frame of a VBR file may be a Xing/Info frame with a TOC of 100 file positions in percent of the play time
+    // or a VBRI frame (Fraunhofer) with a table of frame groups. CBR files need no index, the frame length is constant.
+    uint8_t buf[200];
+    mp3FrameHeader_t f;
+    int32_t first = mp3_findFrame(m_audioDataStart, m_audioDataStart + 65536);
+    if(first < 0) return;
+    audiofile.seek(first);
+    if(audiofile.read(buf, sizeof(buf)) != sizeof(buf) || !mp3_frameHeader(buf, &f)) return;
+    m_mp3FirstFrame = first;
+    m_mp3StreamId = ((buf[1] & 0xFE) << 8) | (buf[2] & 0x0C);
+    m_seekUnitsPerSec = (float)f.sampleRate / f.samplesPerFrame;
+    uint32_t audioEnd = m_audioDataStart + m_audioDataSize;
+
+    uint8_t  xing = 4 + (f.layer == 3 ? sideBytesTab[f.version][f.mono ? 0 : 1] : 0);
+    uint32_t frames = 0, bytes = 0;
+    if(!memcmp(buf + xing, "Xing", 4) || !memcmp(buf + xing, "Info", 4)) {
+        uint32_t flags = bigEndian(buf + xing + 4, 4);
+        uint8_t  p = xing + 8;
+        uint8_t* toc = NULL;
+        if(flags & 0x01) {frames = bigEndian(buf + p, 4); p += 4;}
+        if(flags & 0x02) {bytes = bigEndian(buf + p, 4); p += 4;}
+        if(flags & 0x04) {toc = buf + p; p += 100;}
+        if(flags & 0x08) {p += 4;} // quality
+        if(!bytes || first + bytes > audioEnd) bytes = audioEnd - first;
+        if(frames) m_seekDuration = (float)frames * f.samplesPerFrame / f.sampleRate;
+        if(frames && f.layer == 3 && p + 24 <= sizeof(buf) && (!memcmp(buf + p, "LAME", 4) || !memcmp(buf + p, "Lav", 3))) {
+            // LAME tag (also written by ffmpeg): encoder delay and padding, 12 bit each
+            const uint16_t decoderDelay = 529; // synthesis filterbank
+            uint16_t encoderDelay = (buf[p + 21] << 4) | (buf[p + 22] >> 4);
+            uint16_t padding = ((buf[p + 22] & 0x0F) << 8) | buf[p + 23];
+            m_trimDelay = f.samplesPerFrame + encoderDelay + decoderDelay; // behind the Xing frame
+            m_trimEnd = (uint64_t)(frames + 1) * f.samplesPerFrame + decoderDelay - padding;
+            if(m_trimEnd <= m_trimDelay) m_trimDelay = m_trimEnd = 0;
+        }
+        else if(frames) m_trimDelay = f.samplesPerFrame; // the Xing frame is played as silence
+        if(frames && toc && allocSeekIndex(101) == 1) { // the decoder plays the Xing frame as silence, it is frame 0
+            for(int i = 0; i < 100; i++) {
+                m_seekIndex[i].unit = (uint64_t)frames * i / 100 + (i ? 1 : 0);
+                m_seekIndex[i].pos = first + (uint32_t)((uint64_t)toc[i] * bytes / 256);
+            }
+            m_seekIndex[100].unit = frames + 1; // end of the audio data
+            m_seekIndex[100].pos = first + bytes;
+            m_seekIndexLen = 101;
+        }
+        return;
+    }
+    if(!memcmp(buf + 36, "VBRI", 4)) {
+        bytes = bigEndian(buf + 46, 4);
+        frames = bigEndian(buf + 50, 4);
+        uint16_t entries = bigEndian(buf + 54, 2);
+        uint16_t scale = bigEndian(buf + 56, 2);
+        uint8_t  entrySize = bigEndian(buf + 58, 2);
+        uint16_t framesPerEntry = bigEndian(buf + 60, 2);
+        if(frames) m_seekDuration = (float)frames * f.samplesPerFrame / f.sampleRate;
+        if(!entries || entrySize < 1 || entrySize > 4) return;
+        uint32_t stride = allocSeekIndex(entries + 1);
+        if(!stride) return;
+        uint32_t pos = first, frame = 1; // VBRI frame included
+        audiofile.seek(first + 62);
+        for(uint32_t i = 0; i <= entries; i++) {
+            if(i % stride == 0 && pos < audioEnd) {
+                m_seekIndex[m_seekIndexLen].unit = i ? frame : 0;
+                m_seekIndex[m_seekIndexLen].pos = pos;
+                m_seekIndexLen++;
+            }
+            if(i == entries || audiofile.read(buf, entrySize) != entrySize) break;
+            pos += bigEndian(buf, entrySize) * scale;
+            frame += framesPerEntry;
+        }
+        return;
+    }
+    m_mp3FrameBytes = (float)f.samplesPerFrame / 8 * f.bitRate / f.sampleRate; // CBR
+    if(f.layer == 1) m_mp3FrameBytes = (float)12 * f.bitRate / f.sampleRate * 4;
+    m_seekDuration = (audioEnd - first) / m_mp3FrameBytes / m_seekUnitsPerSec;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::mp3_findFrame(uint32_t pos, uint32_t limit) {
+    // A frame is accepted if its header matches the first frame and the next frame header follows
+    uint8_t buf[512], next[4];
+    mp3FrameHeader_t f, g;
+    uint32_t end = m_audioDataStart + m_audioDataSize;
+    if(limit > end) limit = end;
+    auto sameStream = [&](const uint8_t* h) {
+        return !m_mp3StreamId || ((((h[1] & 0xFE) << 8) | (h[2] & 0x0C)) == m_mp3StreamId);
+    };
+    while(pos + 4 < limit) {
+        audiofile.seek(pos);
+        int32_t n = audiofile.read(buf, sizeof(buf));
+        if(n < 4) return -1;
+        for(int32_t i = 0; i + 4 <= n && pos + i < limit; i++) {
+            if(buf[i] != 0xFF || !mp3_frameHeader(buf + i, &f) || !sameStream(buf + i)) continue;
+            uint32_t nextPos = pos + i + f.frameLen;
+            if(nextPos + 4 > end) return pos + i; // last frame
+            audiofile.seek(nextPos);
+            if(audiofile.read(next, 4) == 4 && mp3_frameHeader(next, &g) && sameStream(next) && ((next[1] ^ buf[i + 1]) & 0xFE) == 0) return pos + i;
+        }
+        if(n < (int32_t)sizeof(buf)) return -1;
+        pos += n - 3;
+    }
+    return -1;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::mp3_seekByTime(float sec, float* skip) {
+    // The frame number is exact, its position is interpolated between two TOC points (VBR). The bit reservoir of the
+    // first frames behind the seek point is not available, they can be silent.
+    if(!m_mp3FirstFrame || m_seekUnitsPerSec <= 0) return -1;
+    const uint8_t reservoirFrames = 2; // decoded without output, they fill the bit reservoir for the frame at sec
+    float    frame = sec * m_seekUnitsPerSec;
+    uint32_t fr = frame;
+    fr = (fr > reservoirFrames) ? fr - reservoirFrames : 0;
+    float    pos, frameBytes = m_mp3FrameBytes;
+    if(m_seekIndexLen) {
+        int32_t i = seekIndexFind(fr);
+        if(i < 0) return -1;
+        pos = m_seekIndex[i].pos;
+        if(i + 1 < m_seekIndexLen && m_seekIndex[i + 1].unit > m_seekIndex[i].unit) {
+            frameBytes = (float)(m_seekIndex[i + 1].pos - m_seekIndex[i].pos) / (m_seekIndex[i + 1].unit - m_seekIndex[i].unit);
+            pos += (fr - m_seekIndex[i].unit) * frameBytes;
+        }
+    }
+    else if(m_mp3FrameBytes > 0) pos = m_mp3FirstFrame + fr * m_mp3FrameBytes;
+    else return -1;
+    pos -= frameBytes / 2; // the frame header nearest to the computed position
+    if(pos < m_mp3FirstFrame) pos = m_mp3FirstFrame;
+    int32_t p = mp3_findFrame(pos, pos + 8192);
+    if(p < 0) return -1;
+    *skip = (frame - fr) / m_seekUnitsPerSec;
+    return p;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::m4a_buildSeekIndex() {
+    // moov/trak/mdia/mdhd: timescale and duration, minf/stbl/stts: samples (aac frames) per time unit,
+    // stsc: samples per chunk, stco or co64: file position of each chunk. One point per chunk.
+    if(!m_stsz_position || !m_stsz_numEntries) return;
+    uint8_t  b[16];
+    uint32_t fileEnd = getFileSize();
+
+    auto findAtom = [&](uint32_t start, uint32_t end, const char* name, uint32_t* atomPos, uint32_t* atomSize) {
+        uint32_t pos = start;
+        while(pos + 8 <= end) {
+            audiofile.seek(pos);
+            if(audiofile.read(b, 8) != 8) return false;
+            uint32_t size = bigEndian(b, 4);
+            if(size == 1) { // 64 bit size
+                if(audiofile.read(b + 8, 8) != 8 || bigEndian(b + 8, 4)) return false;
+                size = bigEndian(b + 12, 4);
+            }
+            if(size < 8) return false;
+            if(!memcmp(b + 4, name, 4)) {*atomPos = pos; *atomSize = size; return true;}
+            pos += size;
+        }
+        return false;
+    };
+
+    uint32_t pos, size, moovPos, moovSize, trakPos, trakSize, mdiaPos, mdiaSize, minfPos, minfSize, stblPos, stblSize;
+    if(!findAtom(0, fileEnd, "moov", &moovPos, &moovSize)) return;
+    if(!findAtom(moovPos + 8, moovPos + moovSize, "trak", &trakPos, &trakSize)) return;
+    if(!findAtom(trakPos + 8, trakPos + trakSize, "mdia", &mdiaPos, &mdiaSize)) return;
+    if(!findAtom(mdiaPos + 8, mdiaPos + mdiaSize, "mdhd", &pos, &size)) return;
+    audiofile.seek(pos + 8);
+    audiofile.read(b, 16);
+    uint32_t timescale, duration;
+    if(b[0] == 1) {audiofile.seek(pos + 28); audiofile.read(b, 12); timescale = bigEndian(b, 4); duration = bigEndian(b + 8, 4);} // version 1
+    else          {timescale = bigEndian(b + 12, 4); audiofile.read(b, 4); duration = bigEndian(b, 4);}
+
+    // moov/mvhd: timescale of the edit list, trak/edts/elst: the first edit starts behind the AAC priming samples
+    // (media_time) and its length (segment_duration) leaves out the padding of the last frame
+    uint32_t movieTimescale = 0, edtsPos, edtsSize;
+    if(findAtom(moovPos + 8, moovPos + moovSize, "mvhd", &pos, &size)) {
+        audiofile.seek(pos + 8);
+        audiofile.read(b, 1);
+        audiofile.seek(pos + (b[0] == 1 ? 28 : 20)); // version 1: 64 bit times
+        audiofile.read(b, 4);
+        movieTimescale = bigEndian(b, 4);
+    }
+    if(movieTimescale && timescale && m_M4A_objectType != 5 && findAtom(trakPos + 8, trakPos + trakSize, "edts", &edtsPos, &edtsSize) &&
+       findAtom(edtsPos + 8, edtsPos + edtsSize, "elst", &pos, &size)) {
+        const uint16_t decoderDelay = 1024; // libfaad delivers no samples for the first frame
+        audiofile.seek(pos + 8);
+        audiofile.read(b, 8);
+        bool     v1 = (b[0] == 1);
+        uint32_t entries = bigEndian(b + 4, 4);
+        for(uint32_t i = 0; i < entries && i < 4; i++) {
+            audiofile.seek(pos + 16 + i * (v1 ? 20 : 12));
+            if(audiofile.read(b, v1 ? 16 : 8) != (v1 ? 16 : 8)) break;
+            uint64_t segmentDuration = v1 ? bigEndian(b, 8) : bigEndian(b, 4);
+            int64_t  mediaTime = v1 ? (int64_t)bigEndian(b + 8, 8) : (int32_t)bigEndian(b + 4, 4);
+            if(mediaTime < 0) continue; // empty edit
+            uint64_t length = segmentDuration * timescale / movieTimescale;
+            if(duration > mediaTime && length > duration - mediaTime) length = duration - mediaTime; // segment_duration is rounded
+            uint64_t lost = (mediaTime < decoderDelay) ? decoderDelay - mediaTime : 0;
+            m_trimDelay = (mediaTime > decoderDelay) ? mediaTime - decoderDelay : 0;
+            m_trimEnd = (length > lost) ? m_trimDelay + length - lost : 0;
+            break;
+        }
+    }
+    if(!findAtom(mdiaPos + 8, mdiaPos + mdiaSize, "minf", &minfPos, &minfSize)) return;
+    if(!findAtom(minfPos + 8, minfPos + minfSize, "stbl", &stblPos, &stblSize)) return;
+    if(!findAtom(stblPos + 8, stblPos + stblSize, "stts", &pos, &size)) return;
+    audiofile.seek(pos + 16);
+    audiofile.read(b, 8);
+    uint32_t delta = bigEndian(b + 4, 4); // aac: 1024 for every sample
+    if(!timescale || !delta) return;
+    m_seekUnitsPerSec = (float)timescale / delta;
+    if(duration) m_seekDuration = (float)duration / timescale;
+
+    audiofile.seek(m_stsz_position - 8);
+    audiofile.read(b, 4);
+    m_stsz_sampleSize = bigEndian(b, 4);
+
+    uint32_t stscPos, stscSize, stcoPos, stcoSize;
+    if(!findAtom(stblPos + 8, stblPos + stblSize, "stsc", &stscPos, &stscSize)) return;
+    bool co64 = false;
+    if(!findAtom(stblPos + 8, stblPos + stblSize, "stco", &stcoPos, &stcoSize)) {
+        if(!findAtom(stblPos + 8, stblPos + stblSize, "co64", &stcoPos, &stcoSize)) return;
+        co64 = true;
+    }
+    audiofile.seek(stscPos + 12);
+    audiofile.read(b, 4);
+    uint32_t stscEntries = bigEndian(b, 4);
+    audiofile.seek(stcoPos + 12);
+    audiofile.read(b, 4);
+    uint32_t chunks = bigEndian(b, 4);
+    if(!stscEntries || !chunks) return;
+    uint32_t stride = allocSeekIndex(chunks);
+    if(!stride) return;
+
+    auto stscEntry = [&](uint32_t idx, uint32_t* firstChunk, uint32_t* samplesPerChunk) {
+        if(idx >= stscEntries) {*firstChunk = 0xFFFFFFFF; return;}
+        audiofile.seek(stscPos + 16 + idx * 12);
+        audiofile.read(b, 8);
+        *firstChunk = bigEndian(b, 4);
+        *samplesPerChunk = bigEndian(b + 4, 4);
+    };
+    uint8_t  offs[8];
+    uint8_t  entrySize = co64 ? 8 : 4;
+    uint32_t stscIdx = 0, firstChunk, samplesPerChunk = 0, nextFirstChunk, nextSamplesPerChunk = 0;
+    uint32_t sample = 0;
+    stscEntry(0, &firstChunk, &samplesPerChunk);
+    stscEntry(1, &nextFirstChunk, &nextSamplesPerChunk);
+    for(uint32_t c = 0; c < chunks && sample < m_stsz_numEntries; c++) {
+        if(c + 1 >= nextFirstChunk) { // chunk numbers in stsc start with 1
+            stscIdx++;
+            samplesPerChunk = nextSamplesPerChunk;
+            stscEntry(stscIdx + 1, &nextFirstChunk, &nextSamplesPerChunk);
+        }
+        if(c % stride == 0) {
+            audiofile.seek(stcoPos + 16 + c * entrySize);
+            audiofile.read(offs, entrySize);
+            uint32_t offset = co64 ? (bigEndian(offs, 4) ? 0xFFFFFFFF : bigEndian(offs + 4, 4)) : bigEndian(offs, 4);
+            if(offset >= fileEnd) break;
+            m_seekIndex[m_seekIndexLen].unit = sample;
+            m_seekIndex[m_seekIndexLen].pos = offset;
+            m_seekIndexLen++;
+        }
+        sample += samplesPerChunk;
+    }
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t Audio::m4a_walkStsz(uint32_t first, uint32_t count, uint32_t* bytes, uint32_t maxBytes) {
+    // adds the sizes of the samples first ... first + count - 1 to bytes, stops when bytes reaches maxBytes
+    // returns the number of samples walked
+    if(first >= m_stsz_numEntries) return 0;
+    if(count > m_stsz_numEntries - first) count = m_stsz_numEntries - first;
+    if(m_stsz_sampleSize) {
+        uint32_t n = count;
+        if(maxBytes != UINT32_MAX && maxBytes > *bytes) {
+            uint32_t need = (maxBytes - *bytes + m_stsz_sampleSize - 1) / m_stsz_sampleSize;
+            if(need < n) n = need;
+        }
+        *bytes += n * m_stsz_sampleSize;
+        return n;
+    }
+    uint8_t  buf[256];
+    uint32_t n = 0;
+    audiofile.seek(m_stsz_position + first * 4);
+    while(n < count) {
+        uint32_t k = count - n;
+        if(k > sizeof(buf) / 4) k = sizeof(buf) / 4;
+        if(audiofile.read(buf, k * 4) != (int)(k * 4)) break;
+        for(uint32_t i = 0; i < k; i++) {
+            *bytes += bigEndian(buf + i * 4, 4);
+            n++;
+            if(*bytes >= maxBytes) return n;
+        }
+    }
+    return n;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::m4a_seekByTime(float sec, float* skip) {
+    if(!m_seekIndexLen || m_seekUnitsPerSec <= 0) return -1;
+    float    frame = sec * m_seekUnitsPerSec + 1; // the decoder returns no samples for the first frame of the file
+    uint32_t fr = frame;
+    if(fr >= m_stsz_numEntries) return -1;
+    int32_t i = seekIndexFind(fr);
+    if(i < 0) return -1;
+    uint32_t bytes = 0;
+    uint32_t n = fr - m_seekIndex[i].unit;
+    if(m4a_walkStsz(m_seekIndex[i].unit, n, &bytes, UINT32_MAX) != n) return -1;
+    *skip = (frame - fr) / m_seekUnitsPerSec;
+    return m_seekIndex[i].pos + bytes;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint8_t Audio::determineOggCodec(uint8_t* data, uint16_t len) {
     // if we have contentType == application/ogg; codec cn be OPUS, FLAC or VORBIS
     // let's have a look, what it is
-    int idx = specialIndexOf(data, "OggS", 6);
-    if(idx != 0) {
+    oggPage_t page;
+    int idx = OGGparsePage(data, len, &page, NULL);
+    if(idx < 0) {
         if(specialIndexOf(data, "fLaC", 6)) return CODEC_FLAC;
         return CODEC_NONE;
     }
-    data += 27;
+    data += page.headerSize; // first packet
     idx = specialIndexOf(data, "OpusHead", 40);
     if(idx >= 0) { return CODEC_OPUS; }
     idx = specialIndexOf(data, "fLaC", 40);
@@ -6208,7 +8464,7 @@ void Audio::audioTask() {
 }
 
 void Audio::performAudioTask() {
-    if(!m_f_running) return;
+    if(!m_f_running) {playMixerOnly(); return;}
     if(!m_f_stream) return;
     if(m_codec == CODEC_NONE) return; // wait for codec is  set
     if(m_codec == CODEC_OGG)  return; // wait for FLAC, VORBIS or OPUS
@@ -6217,6 +8473,138 @@ void Audio::performAudioTask() {
     playAudioData();
     xSemaphoreGive(mutex_audioTask);
 }
+void Audio::playMixerOnly() {
+    // no stream is playing (stopped or paused), the mixer sources are played over silence
+    if(!m_mixer.isActive() && !m_validSamples) return;
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) return; // next round
+    if(!m_validSamples) {
+        const uint16_t frames = 256; // ~6ms, keeps the latency of mixerAdd() low
+        memset(m_outBuff, 0, frames * 2 * (m_outputBits == 32 ? sizeof(int32_t) : sizeof(int16_t)));
+        m_validSamples = frames;
+    }
+    playChunk();
+    xSemaphoreGive(mutex_audioTask);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// optional task that calls loop() for the application. The stream data is then read even if the Arduino 'loop' is blocked for a
+// while, e.g. by the MQTT client. Between two calls the task sleeps in select() until the socket has new data.
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void Audio::setNetworkTaskCore(int8_t coreID){  // -1 stops the task, audio.loop() must then be called again by the application
+    if(coreID > 1) return;
+    stopNetworkTask();
+    m_networkTaskCoreId = coreID;
+    if(coreID >= 0) startNetworkTask();
+}
+
+void Audio::startNetworkTask() {
+    if(m_f_networkTaskIsRunning) {
+        log_i("network task is already running.");
+        return;
+    }
+    m_f_networkTaskIsRunning = true;
+    BaseType_t res = xTaskCreatePinnedToCore(
+        &Audio::networkTaskWrapper, /* Function to implement the task */
+        "NetworkTask",              /* Name of the task */
+        6144,                       /* Stack size, the audio_info() & co callbacks are also called from here */
+        this,                       /* Task input parameter */
+        2,                          /* Priority of the task */
+        &m_networkTaskHandle,       /* Task handle */
+        m_networkTaskCoreId         /* Core where the task should run */
+    );
+    if(res != pdPASS) {
+        log_e("network task could not be created");
+        m_f_networkTaskIsRunning = false;
+        m_networkTaskHandle = nullptr;
+    }
+}
+
+void Audio::stopNetworkTask() {
+    if(!m_f_networkTaskIsRunning) return;
+    m_f_networkTaskIsRunning = false; // the task ends itself, it must not be deleted while it is waiting in select()
+    if(xTaskGetCurrentTaskHandle() == m_networkTaskHandle) return;
+    while(m_networkTaskHandle != nullptr) vTaskDelay(1);
+}
+
+void Audio::networkTaskWrapper(void *param) {
+    Audio *runner = static_cast<Audio*>(param);
+    runner->networkTask();
+}
+
+void Audio::networkTask() {
+    while(m_f_networkTaskIsRunning) {
+        waitForNetworkData(20);
+        xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // connecttohost() & co. use the same mutex
+        loop();
+        xSemaphoreGiveRecursive(mutex_playAudioData);
+        m_hlsCache.connectPending(); // HLS prefetch, the blocking connect() must not hold the mutex
+    }
+    m_networkTaskHandle = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void Audio::waitForNetworkData(uint32_t timeout_ms) {
+    // returns as soon as loop() has something to do, instead of polling _client->available()
+    if(!m_f_running || m_dataMode != AUDIO_DATA) {vTaskDelay(1); return;} // local file, header, playlist
+    if(InBuff.writeSpace() == 0) {vTaskDelay(1); return;} // buffer full, wait for the decoder
+    if(_client->available()) return;                      // TLS can hold already decrypted data
+    if(_client == &m_hlsCache) {vTaskDelay(1); return;}   // prefetched segment, no socket to wait for
+    int fd = (_client == &clientsecure) ? clientsecure.fd() : client.fd();
+    if(fd < 0) {vTaskDelay(1); return;}
+    fd_set rfds;
+    FD_ZERO(&rfds);
+    FD_SET(fd, &rfds);
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = timeout_ms * 1000;
+    if(select(fd + 1, &rfds, NULL, NULL, &tv) > 0 && !_client->available()) vTaskDelay(1); // closed or error, no busy loop
+}
+
+uint32_t Audio::getInBuffUnderruns() { return m_inBuffUnderruns; }
+
+uint32_t Audio::getI2SUnderruns() { return m_i2sUnderruns; }
+
+void Audio::resetUnderrunCounters() {
+    m_inBuffUnderruns = 0;
+    m_i2sUnderruns = 0;
+}
+
+void Audio::getMetrics(audioMetrics_t* m) {
+    m_metrics.read(m, false);
+    m->inBuffUnderruns = m_inBuffUnderruns;
+    m->i2sUnderruns = m_i2sUnderruns;
+}
+
+void Audio::resetMetrics() {
+    m_metrics.reset();
+    resetUnderrunCounters();
+}
+
+void Audio::setMetricsInterval(uint16_t seconds) {
+    m_metricsInterval = seconds * 1000;
+    m_metricsTime = millis();
+    if(seconds) resetMetrics(); // the first report covers a full interval
+}
+
+void Audio::reportMetrics() {
+    // called by loop(), the counters are read and reset in one go, so each report covers one interval
+    if(!m_metricsInterval || millis() - m_metricsTime < m_metricsInterval) return;
+    m_metricsTime = millis();
+    audioMetrics_t m;
+    m_metrics.read(&m, true);
+    m.inBuffUnderruns = m_inBuffUnderruns.exchange(0);
+    m.i2sUnderruns = m_i2sUnderruns.exchange(0);
+    if(audio_metrics) audio_metrics(&m);
+}
+
+bool IRAM_ATTR Audio::i2sSendQueueOverflow(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx) {
+    // ISR context, the DMA had to send a buffer without new samples. The channel stays enabled while nothing is played,
+    // so only a running stream that has already written samples counts
+    Audio* a = static_cast<Audio*>(user_ctx);
+    if(a->m_f_countI2SUnderruns && a->m_f_running && a->m_f_stream) a->m_i2sUnderruns++;
+    return false; // no task was woken
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::getHighWatermark(){
     UBaseType_t highWaterMark = uxTaskGetStackHighWaterMark(m_audioTaskHandle);
     return highWaterMark; // dwords
@@ -12,6 +12,7 @@
 #pragma once
 #pragma GCC optimize ("Ofast")
 #include <vector>
+#include <algorithm>
 #include <Arduino.h>
 #include <libb64/cencode.h>
 #include <esp32-hal-log.h>
@@ -42,6 +43,31 @@
   #define I2S_GPIO_UNUSED -1 // = I2S_PIN_NO_CHANGE in IDF < 5
 #endif
 using namespace std;
+struct FLACDecoder_t; // see flac_decoder/flac_decoder.h
+struct AACDecoder_t;  // see aac_decoder/aac_decoder.h
+struct MP3Decoder_t;  // see mp3_decoder/mp3_decoder.h
+struct VORBISDecoder_t; // see vorbis_decoder/vorbis_decoder.h
+struct OPUSDecoder_t; // see opus_decoder/opus_decoder.h
+
+typedef struct _audioMetrics{       // Audio::getMetrics(), values since the last reset or report
+    uint32_t periodMs;              // duration of the period
+    uint8_t  codec;                 // the decode values belong to this codec, Audio::getCodec() numbering
+    uint8_t  cpuMHz;                // clock while the period ended, cycles / cpuMHz = microseconds
+    uint8_t  cpuLoad;               // decoding and DSP of the audio task in percent of the period (one core)
+    uint32_t decodeFrames;          // decoded frames (packets, blocks)
+    uint32_t decodeAvgCycles;       // per frame
+    uint32_t decodeMaxCycles;
+    uint32_t decodeHist[16];        // frames per decode time, bin i: 2^(i + 11)...2^(i + 12) - 1 cycles, the first and last bin: all below, all above
+    uint32_t dspChunks;             // playChunk() calls that processed new samples
+    uint32_t dspAvgCycles;          // per chunk: format conversion, mixer, DSP chain, spectrum, resampler
+    uint32_t dspMaxCycles;          // longest playChunk() call
+    uint32_t i2sStallUs;            // time the audio task waited for free DMA buffers (sum)
+    uint32_t i2sStallMaxUs;         // longest single wait
+    uint32_t inBuffUnderruns;       // less than one frame in the input buffer while playing
+    uint32_t inBuffOverruns;        // live stream: input buffer full while the server sends, the decoder can't keep up
+    uint32_t i2sUnderruns;          // the I2S DMA ran out of samples
+    uint32_t netBytesPerSec;        // audio data received from the network
+} audioMetrics_t;
 
 extern __attribute__((weak)) void audio_info(const char*);
 extern __attribute__((weak)) void audio_id3data(const char*); //ID3 metadata
@@ -59,8 +85,9 @@ extern __attribute__((weak)) void audio_icydescription(const char*);
 extern __attribute__((weak)) void audio_lasthost(const char*);
 extern __attribute__((weak)) void audio_eof_speech(const char*);
 extern __attribute__((weak)) void audio_eof_stream(const char*); // The webstream comes to an end
-extern __attribute__((weak)) void audio_process_i2s(int16_t* outBuff, uint16_t validSamples, uint8_t bitsPerSample, uint8_t channels, bool *continueI2S); // record audiodata or send via BT
+extern __attribute__((weak)) void audio_process_i2s(int16_t* outBuff, uint16_t validSamples, uint8_t bitsPerSample, uint8_t channels, bool *continueI2S); // record audiodata or send via BT, int32_t samples if bitsPerSample is 32
 extern __attribute__((weak)) void audio_log(uint8_t logLevel, const char* msg, const char* arg);
+extern __attribute__((weak)) void audio_metrics(const audioMetrics_t* m); // see setMetricsInterval()
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -68,7 +95,12 @@ class AudioBuffer {
 // AudioBuffer will be allocated in PSRAM, If PSRAM not available or has not enough space AudioBuffer will be
 // allocated in FlashRAM with reduced size
 //
-//  m_buffer            m_readPtr                 m_writePtr                 m_endPtr
+// Single producer (file or network reader: getWritePtr, writeSpace, bytesWritten) and single consumer (decoder:
+// getReadPtr, getMaxAvailableBytes, bytesWasRead), lock free, the two sides may run on different cores.
+// The producer only stores m_writeIdx, the consumer only stores m_readIdx. Both count from 0 to 2 * m_buffSize - 1,
+// so that a full buffer can be told apart from an empty one without a shared flag.
+//
+//  m_buffer            readPos                   writePos                   m_endPtr
 //   |                       |<------dataLength------->|<------ writeSpace ----->|
 //   ▼                       ▼                         ▼                         ▼
 //   ---------------------------------------------------------------------------------------------------------------
@@ -78,14 +110,14 @@ class AudioBuffer {
 //
 //
 //
-//   if the space between m_readPtr and buffend < m_resBuffSize copy data from the beginning to resBuff
-//   so that the mp3/aac/flac frame is always completed
+//   the guard region behind m_endPtr mirrors the first m_resBuffSize bytes of the ring, the producer updates it in
+//   bytesWritten(), so a mp3/aac/flac frame that wraps around can be read in one piece without copying in getReadPtr()
 //
-//  m_buffer                      m_writePtr                 m_readPtr        m_endPtr
+//  m_buffer                      writePos                   readPos          m_endPtr
 //   |                                 |<-------writeSpace------>|<--dataLength-->|
 //   ▼                                 ▼                         ▼                ▼
 //   ---------------------------------------------------------------------------------------------------------------
-//   |                        <--m_buffSize-->                                    |      <--m_resBuffSize -->     |
+//   |                        <--m_buffSize-->                                    | mirror of m_buffer[0...]      |
 //   ---------------------------------------------------------------------------------------------------------------
 //   |<---  ------dataLength--  ------>|<-------freeSpace------->|
 //
@@ -98,7 +130,7 @@ public:
     bool     isInitialized() { return m_f_init; };
     void     setBufsize(int ram, int psram);
     int32_t  getBufsize();
-    void     changeMaxBlockSize(uint16_t mbs);  // is default 1600 for mp3 and aac, set 16384 for FLAC
+    void     changeMaxBlockSize(uint16_t mbs);  // is default 1600 for mp3 and aac, set 16384 for FLAC, at most m_resBuffSize
     uint16_t getMaxBlockSize();                 // returns maxBlockSize
     size_t   freeSpace();                       // number of free bytes to overwrite
     size_t   writeSpace();                      // space fom writepointer to bufferend
@@ -110,30 +142,400 @@ public:
     uint8_t* getReadPtr();                      // returns the current readpointer
     uint32_t getWritePos();                     // write position relative to the beginning
     uint32_t getReadPos();                      // read position relative to the beginning
-    void     resetBuffer();                     // restore defaults
+    void     resetBuffer();                     // restore defaults, producer and consumer must be idle
     bool     havePSRAM() { return m_f_psram; };
 
 protected:
+    size_t   filled(size_t w, size_t r) { return (w >= r) ? w - r : w + 2 * m_buffSize - r; }
+    size_t   pos(size_t idx) { return (idx < m_buffSize) ? idx : idx - m_buffSize; }
+    size_t   advance(size_t idx, size_t n) { idx += n; return (idx >= 2 * m_buffSize) ? idx - 2 * m_buffSize : idx; }
+
     size_t            m_buffSizePSRAM    = UINT16_MAX * 10;   // most webstreams limit the advance to 100...300Kbytes
-    size_t            m_buffSizeRAM      = 1600 * 10;
+    size_t            m_buffSizeRAM      = 1600 * 14;  // ~14KB ring + the guard region
     size_t            m_buffSize         = 0;
-    size_t            m_freeSpace        = 0;
-    size_t            m_writeSpace       = 0;
-    size_t            m_dataLength       = 0;
-    size_t            m_resBuffSizeRAM   = 2048;     // reserved buffspace, >= one wav  frame
+    size_t            m_resBuffSizeRAM   = 4096 * 2; // reserved buffspace, >= one wav or vorbis block
     size_t            m_resBuffSizePSRAM = 4096 * 4; // reserved buffspace, >= one flac frame
+    size_t            m_resBuffSize      = 0;        // size of the guard region in use
     size_t            m_maxBlockSize     = 1600;
     uint8_t*          m_buffer           = NULL;
-    uint8_t*          m_writePtr         = NULL;
-    uint8_t*          m_readPtr          = NULL;
     uint8_t*          m_endPtr           = NULL;
+    std::atomic<size_t> m_writeIdx{0};           // written by the producer only
+    std::atomic<size_t> m_readIdx{0};            // written by the consumer only
     bool              m_f_init           = false;
-    bool              m_f_isEmpty        = true;
     bool              m_f_psram          = false;    // PSRAM is available (and used...)
 };
 //----------------------------------------------------------------------------------------------------------------------
 
-static const size_t AUDIO_STACK_SIZE = 3300;
+class AudioSink {
+// AudioSink receives the processed PCM data at the end of playChunk(), always interleaved L/R with 16 bits per sample,
+// or 32 bits per sample (left justified int32_t) after Audio::setI2SOutputBits(32). begin() tells which one.
+// The default sink is I2S. Others can be set with Audio::setAudioSink(), e.g. to record a stream or to measure the
+// decoder speed without waiting for the I2S DMA.
+public:
+    virtual ~AudioSink() {}
+    virtual esp_err_t begin(uint32_t sampleRate, uint8_t bitsPerSample, uint8_t channels) { return ESP_OK; } // after each format change
+    virtual esp_err_t write(const void* buff, size_t size, size_t* bytesWritten) = 0;                         // may accept less than size
+    virtual void      end() {}                                                                                 // sink is released
+};
+
+#if ESP_IDF_VERSION_MAJOR == 5
+class I2SSink : public AudioSink {
+public:
+    void      setHandle(i2s_chan_handle_t handle) { m_handle = handle; }
+    esp_err_t write(const void* buff, size_t size, size_t* bytesWritten) override;
+private:
+    i2s_chan_handle_t m_handle = NULL;
+};
+#endif
+
+class WavFileSink : public AudioSink {
+// writes a RIFF/WAVE file, the header is completed in end()
+public:
+    WavFileSink(File& file) : m_file(file) {}
+    esp_err_t begin(uint32_t sampleRate, uint8_t bitsPerSample, uint8_t channels) override;
+    esp_err_t write(const void* buff, size_t size, size_t* bytesWritten) override;
+    void      end() override;
+private:
+    void      writeHeader();
+    File&     m_file;
+    uint32_t  m_sampleRate = 44100;
+    uint32_t  m_dataSize = 0;
+    uint16_t  m_bitsPerSample = 16;
+};
+
+class NullSink : public AudioSink {
+// discards the data, decoding is then only limited by the input and the CPU
+public:
+    esp_err_t write(const void* buff, size_t size, size_t* bytesWritten) override { m_bytes += size; *bytesWritten = size; return ESP_OK; }
+    uint64_t  bytesWritten() { return m_bytes; }
+private:
+    uint64_t  m_bytes = 0;
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+class AudioSource {
+// AudioSource delivers PCM to the mixer (Audio::mixerAdd()), int16_t, mono or interleaved L/R, at its own sample rate.
+// read() is called from the audio task, the mixer converts to the sample rate and format of the running stream.
+public:
+    virtual ~AudioSource() {}
+    virtual uint32_t sampleRate() = 0;
+    virtual uint8_t  channels() = 0;                               // 1 or 2
+    virtual uint16_t read(int16_t* buff, uint16_t frames) = 0;     // returns the number of frames, 0: end of source
+};
+
+class WavFileSource : public AudioSource {
+// 16 bit PCM RIFF/WAVE file, e.g. a prerecorded announcement on SD or LittleFS
+public:
+    ~WavFileSource() { close(); }
+    bool     open(fs::FS& fs, const char* path);
+    void     close() { if(m_file) m_file.close(); m_dataLeft = 0; }
+    uint32_t sampleRate() override { return m_sampleRate; }
+    uint8_t  channels() override { return m_channels; }
+    uint16_t read(int16_t* buff, uint16_t frames) override;
+private:
+    File     m_file;
+    uint32_t m_sampleRate = 0;
+    uint32_t m_dataLeft = 0;                                       // bytes of the data chunk not read yet
+    uint8_t  m_channels = 0;
+};
+
+class MemorySource : public AudioSource {
+// PCM in flash or RAM, e.g. a gong before an announcement, the data is not copied
+public:
+    MemorySource(const int16_t* pcm, uint32_t frames, uint32_t sampleRate, uint8_t channels = 1, bool loop = false)
+        : m_pcm(pcm), m_frames(frames), m_sampleRate(sampleRate), m_channels(channels), m_f_loop(loop) {}
+    void     rewind() { m_pos = 0; }
+    uint32_t sampleRate() override { return m_sampleRate; }
+    uint8_t  channels() override { return m_channels; }
+    uint16_t read(int16_t* buff, uint16_t frames) override;
+private:
+    const int16_t* m_pcm;
+    uint32_t       m_frames;
+    uint32_t       m_pos = 0;
+    uint32_t       m_sampleRate;
+    uint8_t        m_channels;
+    bool           m_f_loop;
+};
+
+class Mp3Source : public AudioSource {
+// MP3 from a file or from memory, decoded with a decoder instance of its own, e.g. the speech of Audio::playSpeech().
+// open() decodes the first frame, so sampleRate() and channels() are valid before the source is added to the mixer.
+// The decoder and the buffers are freed as soon as the data ends.
+public:
+    enum : uint16_t { IN_SIZE = 2048 };                             // > the biggest mp3 frame (1441 bytes)
+    ~Mp3Source() { close(); }
+    bool     open(fs::FS& fs, const char* path);
+    bool     open(uint8_t* mp3, uint32_t len);                      // takes the malloc'd buffer, it is freed in close()
+    void     close();
+    uint32_t sampleRate() override { return m_sampleRate; }
+    uint8_t  channels() override { return m_channels; }
+    uint16_t read(int16_t* buff, uint16_t frames) override;
+private:
+    bool     begin();
+    bool     decodeFrame();                                         // next frame into m_pcm, false: end of data
+    uint32_t fill();                                                // tops up m_in from the file or the memory
+    void     consume(uint32_t bytes);
+    MP3Decoder_t* m_decoder = NULL;
+    File     m_file;
+    uint8_t* m_mem = NULL;
+    uint32_t m_memLen = 0;
+    uint32_t m_memPos = 0;
+    uint8_t* m_in = NULL;                                           // IN_SIZE bytes of mp3 data
+    uint16_t m_inLen = 0;
+    int16_t* m_pcm = NULL;                                          // one decoded frame, 1152 * 2 samples
+    uint16_t m_pcmFrames = 0;
+    uint16_t m_pcmPos = 0;
+    uint32_t m_sampleRate = 0;
+    uint8_t  m_channels = 0;
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+class AudioFileCache {
+// content addressed file cache, used by connecttospeech(): the key is a hash of the request, the file is
+// "<dir>/<key as 16 hex digits>.mp3". If the files together get bigger than maxBytes, the least recently used are deleted.
+// A download is written to "<key>.tmp" first and only renamed in commit(), so an aborted one never becomes a hit.
+public:
+    bool        begin(fs::FS& fs, const char* dir, uint32_t maxBytes); // scans dir, the order of use is taken from the file times
+    void        end();
+    bool        isEnabled() { return m_fs != NULL; }
+    static uint64_t key(const char* a, const char* b, const char* c);  // FNV-1a 64 over the three strings
+    const char* path(uint64_t key, bool tmp = false);                  // points to an internal buffer
+    fs::FS&     fs() { return *m_fs; }
+    bool        lookup(uint64_t key);                                  // true: cached, the entry is now the most recently used
+    File        create(uint64_t key);                                  // opens the .tmp file for writing
+    void        commit(uint64_t key, File& file);                      // .tmp -> .mp3, then evict() if necessary
+    void        discard(uint64_t key, File& file);                     // close and delete the .tmp file
+    uint32_t    sizeOnDisk() { return m_bytes; }
+private:
+    struct entry_t { uint64_t key; uint32_t size; uint32_t lastUse; };
+    void        evict();
+    fs::FS*     m_fs = NULL;
+    char        m_dir[32] = {0};
+    char        m_path[64] = {0};
+    uint32_t    m_maxBytes = 0;
+    uint32_t    m_bytes = 0;
+    uint32_t    m_useCounter = 0;
+    std::vector<entry_t> m_entries;
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+#ifndef ETHERNET_IF
+typedef WiFiClient          audioClient_t;
+typedef WiFiClientSecure    audioClientSecure_t;
+#else
+typedef NetworkClient       audioClient_t;
+typedef NetworkClientSecure audioClientSecure_t;
+#endif
+
+class HLSSegmentCache : public audioClient_t {
+// HLS prefetch: downloads the next media segments (and the next playlist) on a second keep-alive connection
+// while the current segment plays, the data is held in PSRAM. A segment is handed to processWebStreamHLS() or
+// processWebStreamTS() by pointing _client to this object, which then reads from memory like a network stream.
+// Only one download runs at a time, in the order of request(). loop() never blocks except for connect(), with
+// loop(false) a needed connect() is left to connectPending(), which the network task calls without the Audio mutex.
+public:
+    enum : int8_t { SEG_FAILED = -1, SEG_UNKNOWN = 0, SEG_LOADING = 1, SEG_COMPLETE = 2 };
+    ~HLSSegmentCache() { end(); }
+    bool     begin(uint8_t maxSegments, uint32_t maxBytes); // needs PSRAM
+    void     end();
+    void     reset();                                       // forget all segments, close the connection
+    bool     isEnabled() { return m_maxSegments != 0; }
+    bool     request(const char* url);                      // false: no room, try again later
+    int8_t   state(const char* url);
+    void     drop(const char* url);
+    void     loop(bool mayConnect);                         // one step of the download, mayConnect: connect() can block
+    bool     connectPending();                              // the connect() that loop(false) has left, true: connected
+    int32_t  open(const char* url);                         // serve it as client, returns its length or -1
+    bool     take(const char* url, uint8_t** data, uint32_t* size); // complete download, the caller frees data
+    // client interface of the segment that is served
+    int      available() override;
+    int      read() override;
+    int      read(uint8_t* buf, size_t size) override;
+    int      peek() override;
+    uint8_t  connected() override;
+    void     stop() override;
+private:
+    enum : uint8_t { DL_IDLE, DL_HEADER, DL_BODY, DL_CHUNKSIZE, DL_CHUNKDATA, DL_CHUNKEND, DL_TRAILER };
+    enum : uint8_t { CONN_IDLE, CONN_WANTED, CONN_RUNNING, CONN_READY, CONN_FAILED };
+    struct seg_t { char* url; uint8_t* data; uint32_t size; uint32_t capacity; int32_t length; int8_t state; };
+    int      find(const char* url);
+    void     erase(int idx);
+    bool     startDownload(seg_t& s, bool mayConnect);
+    bool     grow(seg_t& s, uint32_t need);
+    bool     readLine();                                    // true: m_line holds a complete line
+    void     finish(bool ok);
+    std::vector<seg_t>   m_segs;                            // m_segs[0] is the served one if m_f_serving
+    audioClient_t        m_client;
+    audioClientSecure_t  m_clientSecure;
+    audioClient_t*       m_net = NULL;
+    char                 m_host[128] = {0};
+    uint16_t             m_port = 0;
+    audioClient_t*       m_connNet = NULL;                  // connectPending(): client, host and port to connect
+    char                 m_connHost[128] = {0};
+    uint16_t             m_connPort = 0;
+    std::atomic<uint8_t> m_connState{CONN_IDLE};            // CONN_RUNNING: m_connNet belongs to connectPending()
+    char                 m_line[256] = {0};
+    uint16_t             m_linePos = 0;
+    int                  m_dlIdx = -1;                      // index in m_segs of the running download
+    uint8_t              m_dlState = DL_IDLE;
+    uint32_t             m_chunkLeft = 0;
+    uint32_t             m_dlTime = 0;                      // millis() of the last received byte
+    int16_t              m_status = 0;
+    bool                 m_f_chunked = false;
+    bool                 m_f_keepAlive = true;
+    bool                 m_f_serving = false;
+    uint32_t             m_readPos = 0;
+    uint8_t              m_maxSegments = 0;
+    uint32_t             m_maxBytes = 0;
+    uint32_t             m_bytes = 0;
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+class SpectrumAnalyzer {
+// FFT spectrum for LED and LCD visualizers, fed by processBlock() in the audio task. The frames are mixed to mono and
+// decimated to ~22kHz (44.1 and 48kHz: every 2 frames are averaged), 480 of these samples are transformed with the
+// CELT FFT (OPUSrealFFT), that is ~46 spectra per second. The bins are summed up in logarithmically spaced bands,
+// a level is 0...255 for -60...0dB full scale and falls by at most 'decay' per spectrum. The levels are double
+// buffered, read() can be called from any task without a lock.
+public:
+    enum : uint8_t { MAX_BANDS = 32, FFT_SIZE = 240 }; // FFT_SIZE: complex FFT, 2 * FFT_SIZE real samples
+    ~SpectrumAnalyzer() { end(); }
+    bool     begin(uint8_t bands, uint8_t decay, bool window); // bands 1...MAX_BANDS, window: Hann, else rectangular
+    void     end();
+    bool     isEnabled() { return m_bands != 0; }
+    void     feed(const void* buff, uint16_t frames, bool wide, uint32_t sampleRate); // interleaved stereo, as computeVUlevel()
+    uint8_t  read(uint8_t* levels);                            // returns the number of bands, 0: no spectrum (yet)
+private:
+    void     compute();
+    int32_t*             m_samples = NULL;                     // 2 * FFT_SIZE decimated mono samples
+    int32_t*             m_bins = NULL;                        // FFT_SIZE + 1 complex bins (re, im)
+    int16_t*             m_window = NULL;                      // Q15, NULL: rectangular
+    uint8_t              m_edges[MAX_BANDS + 1] = {0};         // first bin of each band, m_edges[m_bands]: end
+    uint8_t              m_levels[2][MAX_BANDS] = {{0}};       // front buffer is m_levels[m_seq & 1]
+    std::atomic<uint32_t> m_seq{0};                            // number of the published spectrum, 0: none
+    std::atomic<uint8_t> m_bands{0};
+    uint8_t              m_decay = 0;
+    uint8_t              m_decimation = 1;
+    uint8_t              m_decimCnt = 0;
+    int32_t              m_decimSum = 0;
+    uint16_t             m_nSamples = 0;
+    uint32_t             m_sampleRate = 0;
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+class AudioMixer {
+// mixes up to MAX_SOURCES AudioSources into the decoded stream (music bus) in playChunk(), before the equalizer and the
+// volume. The sources are resampled to the stream by linear interpolation. A gain change is ramped over RAMP_MS, a new
+// source fades in, remove() fades out. While a voice source plays, the music bus is ducked to the ducking gain.
+// add(), remove() and setGain() must not run during process(), Audio takes mutex_audioTask for them.
+public:
+    enum : uint8_t { MAX_SOURCES = 4, CHUNK = 64, RAMP_MS = 20 }; // CHUNK: frames read from a source at once
+    bool     add(AudioSource* src, uint8_t gain, bool voice);       // gain 0...100%, false: no free slot
+    void     remove(AudioSource* src, bool fade = true);
+    void     setGain(AudioSource* src, uint8_t gain);
+    void     setDucking(uint8_t gain, uint16_t attackMs, uint16_t releaseMs);
+    bool     isPlaying(AudioSource* src) { return find(src) >= 0; }
+    bool     isActive() { return m_active != 0; }                  // at least one source, or the music bus is ducked
+    template <typename T> void process(T* buff, uint16_t frames, uint32_t sampleRate); // interleaved stereo
+private:
+    struct slot_t {
+        AudioSource* src;
+        int32_t      gain, target, step;                            // Q30, step per frame
+        uint32_t     frac;                                          // Q16, position between the frames a and b
+        int16_t      a[2], b[2];
+        int16_t      buf[2 * CHUNK];
+        uint16_t     n, pos;                                        // frames in buf, next frame
+        bool         voice, f_removing, f_primed;
+    };
+    int      find(AudioSource* src);
+    bool     nextFrame(slot_t& s, int16_t* frame);
+    void     release(slot_t& s) { s.src = NULL; m_active &= ~(1 << (&s - m_slots)); }
+    slot_t   m_slots[MAX_SOURCES] = {};
+    uint8_t  m_active = 0;                                          // bit i: m_slots[i] is used, bit 7: music bus is ducked
+    int32_t  m_duckGain = 1 << 30;                                  // Q30
+    int32_t  m_duckTarget = (int32_t)(0.2 * (1 << 30));
+    uint16_t m_attackMs = 50;
+    uint16_t m_releaseMs = 500;
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+class Resampler {
+// converts every stream to one fixed output rate, so that I2S is not stopped and reconfigured at each new stream.
+// Polyphase FIR: the fraction of the input position selects a row of the coefficient table (as in SILK's
+// silk_resampler_private_IIR_FIR_INTERPOL), the results of the two neighbouring rows are interpolated. The table is
+// calculated for each input rate, the cutoff follows the lower of the two rates. Quality 0 interpolates linearly.
+// process() resamples m_outBuff in pieces of OUT_FRAMES, playChunk() writes a piece completely before the next one.
+public:
+    enum : uint8_t { MAX_TAPS = 32 };
+    enum : uint16_t { OUT_FRAMES = 256 };
+    ~Resampler() { end(); }
+    bool        begin(uint32_t outRate, uint8_t quality);      // quality 0...3, 2, 8, 16, 32 taps
+    void        end();
+    bool        isEnabled() { return m_outRate != 0; }
+    bool        isConverting() { return m_outRate && m_inRate != m_outRate; } // false: the stream has the output rate
+    uint32_t    outputRate() { return m_outRate; }
+    void        setInputRate(uint32_t inRate);                 // recalculates the table if the rate has changed
+    void        reset();                                       // clears the history and the pending output
+    template <typename T> uint16_t process(const T* in, uint16_t inFrames, uint16_t* used); // interleaved stereo
+    uint16_t    pending() { return m_outFrames - m_outPos; }    // resampled frames, not written yet
+    const void* pendingData(bool wide) { return (const uint8_t*)m_out + m_outPos * (wide ? 8 : 4); }
+    void        consumed(uint16_t frames) { m_outPos += frames; }
+private:
+    void        calcTable();
+    int16_t*    m_table = NULL;                                // (m_phases + 1) rows of m_taps coefficients, Q14
+    void*       m_out = NULL;                                  // OUT_FRAMES stereo frames, int16_t or int32_t
+    int32_t     m_hist[2][2 * MAX_TAPS] = {{0}};               // every sample is stored twice, the window is contiguous
+    uint32_t    m_outRate = 0;
+    uint32_t    m_inRate = 0;
+    uint32_t    m_stepInt = 1;                                 // input frames per output frame, integer part
+    uint32_t    m_stepFrac = 0;                                // fractional part, Q32
+    uint32_t    m_frac = 0;                                    // position between the last two input frames, Q32
+    uint32_t    m_need = 1;                                    // input frames to read before the next output frame
+    uint16_t    m_outFrames = 0;
+    uint16_t    m_outPos = 0;
+    uint16_t    m_phases = 0;
+    uint8_t     m_taps = 2;
+    uint8_t     m_histPos = 0;
+    uint8_t     m_quality = 0;
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+class AudioMetrics {
+// performance counters of the audio pipeline, cheap enough to stay enabled: the audio and network tasks add to fixed
+// size 32 bit atomics (relaxed, no lock), read() takes a snapshot from any task. Times are measured with the CPU cycle
+// counter, which is per core; the audio task is pinned, so start and stop are always read on the same core.
+// Cycle sums are kept in units of 256 cycles, at 240MHz a sum overflows after ~75 minutes without a reset.
+public:
+    enum : uint8_t { HIST_BINS = 16, HIST_SHIFT = 11 };    // bin of n cycles: log2(n) - HIST_SHIFT, clamped
+    static uint32_t cycles() { return ESP.getCycleCount(); }
+    void     setCodec(uint8_t codec);                      // a new codec resets the decode values
+    void     addDecode(uint32_t cycles);
+    void     addDsp(uint32_t cycles, bool newChunk = true);
+    void     addStall(uint32_t cycles);
+    void     addNetBytes(uint32_t bytes) { m_netBytes.fetch_add(bytes, std::memory_order_relaxed); }
+    void     addOverrun() { m_overruns.fetch_add(1, std::memory_order_relaxed); }
+    void     read(audioMetrics_t* m, bool reset);          // underrun counters are filled in by Audio
+    void     reset();
+private:
+    static void addMax(std::atomic<uint32_t>& max, uint32_t val);
+    static uint32_t take(std::atomic<uint32_t>& val, bool reset) { return reset ? val.exchange(0, std::memory_order_relaxed) : val.load(std::memory_order_relaxed); }
+    std::atomic<uint32_t> m_hist[HIST_BINS] = {};
+    std::atomic<uint32_t> m_decodeFrames{0};
+    std::atomic<uint32_t> m_decodeSum{0};                  // 256 cycles
+    std::atomic<uint32_t> m_decodeMax{0};
+    std::atomic<uint32_t> m_dspChunks{0};
+    std::atomic<uint32_t> m_dspSum{0};                     // 256 cycles
+    std::atomic<uint32_t> m_dspMax{0};
+    std::atomic<uint32_t> m_stallSum{0};                   // 256 cycles
+    std::atomic<uint32_t> m_stallMax{0};
+    std::atomic<uint32_t> m_netBytes{0};
+    std::atomic<uint32_t> m_overruns{0};
+    std::atomic<uint32_t> m_t0{0};                         // millis() at the start of the period
+    std::atomic<uint8_t>  m_codec{0};
+};
+//----------------------------------------------------------------------------------------------------------------------
+
+static const size_t AUDIO_STACK_SIZE = 3300; // the deepest path is OPUS (CELT) decoding, the mixer with an Mp3Source needs about half of it
 static StaticTask_t __attribute__((unused)) xAudioTaskBuffer;
 static StackType_t  __attribute__((unused)) xAudioStack[AUDIO_STACK_SIZE];
 
@@ -149,6 +551,9 @@ public:
     bool connecttohost(const char* host, const char* user = "", const char* pwd = "");
     bool connecttospeech(const char* speech, const char* lang);
     bool connecttoFS(fs::FS &fs, const char* path, int32_t m_fileStartPos = -1);
+    bool queueNextFS(fs::FS &fs, const char* path); // gapless, starts at the end of the current file (local files only)
+    void clearQueue();
+    bool isQueued() {return m_nextFile;}
     bool setFileLoop(bool input);//TEST loop
     void setConnectionTimeout(uint16_t timeout_ms, uint16_t timeout_ms_ssl);
     bool setAudioPlayPosition(uint16_t sec);
@@ -178,12 +583,28 @@ public:
     uint32_t getAudioCurrentTime();
     uint32_t getTotalPlayingTime();
     uint16_t getVUlevel();
+    bool     setSpectrum(uint8_t bands, uint8_t decay = 4, bool window = true); // bands 0: off, 1...32
+    uint8_t  getSpectrum(uint8_t* levels); // levels[bands] 0...255 (-60...0dB), returns the number of bands, 0: nothing to show
+    bool     mixerAdd(AudioSource* src, uint8_t gain = 100, bool voice = true); // the source must exist until mixerIsPlaying() is false
+    void     mixerRemove(AudioSource* src);                   // fades out
+    void     mixerSetGain(AudioSource* src, uint8_t gain);    // 0...100%, ramped
+    bool     mixerIsPlaying(AudioSource* src);
+    void     setDucking(uint8_t gain = 20, uint16_t attackMs = 50, uint16_t releaseMs = 500); // music while a voice source plays, 0...100%
+    bool     playAnnouncement(fs::FS& fs, const char* path, uint8_t gain = 100); // 16 bit PCM WAV over the running stream
+    bool     isAnnouncing() { return mixerIsPlaying(&m_announcement); }
+    bool     playSpeech(const char* speech, const char* lang, uint8_t gain = 100); // like connecttospeech(), over the running stream
+    bool     isSpeaking() { return mixerIsPlaying(&m_speech); }
+    bool     setOutputSampleRate(uint32_t hz, uint8_t quality = 2); // hz 0: I2S follows the stream (default), quality 0...3
 
     uint32_t inBufferFilled(); // returns the number of stored bytes in the inputbuffer
     uint32_t inBufferFree();   // returns the number of free bytes in the inputbuffer
     uint32_t inBufferSize();   // returns the size of the inputbuffer in bytes
     void setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass);
     void setI2SCommFMT_LSB(bool commFMT);
+    void setAudioSink(AudioSink* sink); // NULL restores I2S, the previous sink gets end()
+    bool setI2SOutputBits(uint8_t bits); // 16 (default) or 32, 32 keeps 24 bit FLAC and the DSP chain at full resolution
+    bool setTTSCache(fs::FS& fs, const char* dir = "/ttscache", uint32_t maxBytes = 512 * 1024); // maxBytes 0: off
+    bool setHLSPrefetch(uint8_t segments = 2, uint32_t maxBytes = 1024 * 1024); // segments 0: off, needs PSRAM, call before connecttohost()
     int getCodec() {return m_codec;}
     const char *getCodecname() {return codecname[m_codec];}
 
@@ -200,11 +621,15 @@ private:
 
   void            UTF8toASCII(char* str);
   bool            latinToUTF8(char* buff, size_t bufflen, bool UTF8check = true);
-  void            setDefaults(); // free buffers and set defaults
+  void            setDefaults(bool keepOutput = false); // free buffers and set defaults, keepOutput: m_outBuff is still played
   void            initInBuff();
   bool            httpPrint(const char* host);
   bool            httpRange(const char* host, uint32_t range);
   void            processLocalFile();
+  bool            playQueuedFile();
+  void            prepareNextDecoder();
+  void            freeNextDecoder();
+  uint8_t         fileCodec(const char* path);
   void            processWebStream();
   void            processWebFile();
   void            processWebStreamTS();
@@ -214,7 +639,9 @@ private:
   const char*     parsePlaylist_M3U();
   const char*     parsePlaylist_PLS();
   const char*     parsePlaylist_ASX();
-  const char*     parsePlaylist_M3U8();
+  const char*     parsePlaylist_M3U8(bool popURL = true); // popURL false: only collect the segment URLs
+  void            hlsPrefetch();
+  bool            hlsOpenPrefetched(const char* url);
   const char*     m3u8redirection(uint8_t* codec);
   uint64_t        m3u8_findMediaSeqInURL();
   bool            STfromEXTINF(char* str);
@@ -238,19 +665,26 @@ private:
   void            reconfigI2S();
   bool            setBitrate(int br);
   void            playChunk();
-  void            computeVUlevel(int16_t sample[2]);
+  void            playMixerOnly();
+  bool            sendTTSRequest(audioClient_t* cl, const char* speech, const char* lang);
+  uint8_t*        downloadSpeech(const char* speech, const char* lang, uint32_t* len);
+  void            computeVUlevel(const void* buff, uint16_t frames, bool wide);
   void            computeLimit();
-  void            Gain(int16_t* sample);
+  template <typename T> void processBlock(T* buff, uint16_t frames);
+  template <typename T> void Gain(T* buff, uint16_t frames);
   void            showstreamtitle(const char* ml);
   bool            parseContentType(char* ct);
   bool            parseHttpResponseHeader();
   bool            initializeDecoder(uint8_t codec);
   esp_err_t       I2Sstart(uint8_t i2s_num);
   esp_err_t       I2Sstop(uint8_t i2s_num);
-  void            IIR_filterChain0(int16_t iir_in[2], bool clear = false);
-  void            IIR_filterChain1(int16_t iir_in[2], bool clear = false);
-  void            IIR_filterChain2(int16_t iir_in[2], bool clear = false);
+#if ESP_IDF_VERSION_MAJOR == 5
+  static bool     i2sSendQueueOverflow(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx);
+#endif
+  template <typename T> void IIR_filterBlock(T* buff, uint16_t frames);
+  void            IIR_loadCoefficients();
   inline uint32_t streamavail() { return _client ? _client->available() : 0; }
+  inline size_t   outBuffBytes() { return m_outbuffSize * (m_outputBits == 32 ? sizeof(int32_t) : sizeof(int16_t)); }
   void            IIR_calculateCoefficients(int8_t G1, int8_t G2, int8_t G3);
   bool            ts_parsePacket(uint8_t* packet, uint8_t* packetStart, uint8_t* packetLength);
   uint32_t        find_m4a_atom(uint32_t fileSize, const char* atomType, uint32_t depth = 0);
@@ -266,6 +700,23 @@ private:
   void            audioTask();
   void            performAudioTask();
 
+  //+++ optional  T A S K  for loop(), reads the input buffer instead of the application +++
+public:
+  void            setNetworkTaskCore(int8_t coreID); // -1: no task, the application calls loop() (default), 0 or 1: core
+  uint32_t        getInBuffUnderruns();  // the decoder found less than one frame in the input buffer while playing
+  uint32_t        getI2SUnderruns();     // the I2S DMA ran out of samples
+  void            resetUnderrunCounters();
+  void            getMetrics(audioMetrics_t* m); // values since the last resetMetrics() or report
+  void            resetMetrics();                // also resets the underrun counters
+  void            setMetricsInterval(uint16_t seconds); // audio_metrics() from loop() every interval, then reset, 0: off
+private:
+  void            startNetworkTask();
+  void            stopNetworkTask();
+  static void     networkTaskWrapper(void *param);
+  void            networkTask();
+  void            reportMetrics();
+  void            waitForNetworkData(uint32_t timeout_ms);
+
   //+++ W E B S T R E A M  -  H E L P   F U N C T I O N S +++
   uint16_t readMetadata(uint16_t b, bool first = false);
   size_t   chunkedDataTransfer(uint8_t* bytes);
@@ -277,6 +728,23 @@ private:
   uint32_t ogg_correctResumeFilePos(uint32_t resumeFilePos);
   int32_t  flac_correctResumeFilePos(uint32_t resumeFilePos);
   int32_t  mp3_correctResumeFilePos(uint32_t resumeFilePos);
+  void     buildSeekIndex();
+  void     clearSeekIndex();
+  uint32_t allocSeekIndex(uint32_t points);
+  int32_t  seekIndexFind(uint32_t unit);
+  int32_t  seekByTime(float sec, float* skip);
+  void     flac_buildSeekIndex();
+  int32_t  flac_probeFrame(uint32_t pos, uint32_t limit, uint64_t* sample);
+  int32_t  flac_seekByTime(float sec, float* skip);
+  int32_t  ogg_probePage(uint32_t pos, uint32_t limit, int64_t* granule, uint32_t* pageLen);
+  int32_t  ogg_seekByTime(float sec, float* skip);
+  int64_t  ogg_lastGranule();
+  void     mp3_buildSeekIndex();
+  int32_t  mp3_findFrame(uint32_t pos, uint32_t limit);
+  int32_t  mp3_seekByTime(float sec, float* skip);
+  void     m4a_buildSeekIndex();
+  uint32_t m4a_walkStsz(uint32_t first, uint32_t count, uint32_t* bytes, uint32_t maxBytes);
+  int32_t  m4a_seekByTime(float sec, float* skip);
   uint8_t  determineOggCodec(uint8_t* data, uint16_t len);
 
   //++++ implement several function with respect to the index of string ++++
@@ -551,12 +1019,38 @@ private:
         float b2;
     } filter_t;
 
+#ifdef AUDIO_DSP_FIXED_POINT // -DAUDIO_DSP_FIXED_POINT, biquads in Q2.29 with 64 bit accumulators
+    typedef int32_t iir_coef_t;
+    typedef int32_t iir_state_t;
+#else
+    typedef float   iir_coef_t;
+    typedef float   iir_state_t;
+#endif
+
     typedef struct _pis_array{
         int number;
         int pids[4];
     } pid_array;
 
+    typedef struct _seekPoint{
+        uint32_t unit;    // FLAC: sample, MP3 and M4A: frame number
+        uint32_t pos;     // file position of the frame / chunk
+    } seekPoint_t;
+
     File                  audiofile;
+    File                  m_nextFile;          // queueNextFS(), opened while audiofile plays
+    AudioFileCache        m_ttsCache;
+    File                  m_ttsCacheFile;      // download of a connecttospeech() that is not cached yet
+    uint64_t              m_ttsCacheKey = 0;
+    HLSSegmentCache       m_hlsCache;
+    audioClient_t*        m_hlsNetClient = nullptr; // _client while a prefetched segment is served
+    uint32_t              m_hlsPlaylistTime = 0;    // millis() of the last playlist request
+    uint32_t              m_hlsGapTime = 0;         // millis() at the end of a segment, for the gap log
+    SpectrumAnalyzer      m_spectrum;
+    AudioMixer            m_mixer;
+    WavFileSource         m_announcement;      // source of playAnnouncement()
+    Mp3Source             m_speech;            // source of playSpeech()
+    Resampler             m_resampler;         // setOutputSampleRate()
 #ifndef ETHERNET_IF
     WiFiClient            client;
     WiFiClientSecure      clientsecure;
@@ -569,11 +1063,19 @@ private:
     SemaphoreHandle_t     mutex_playAudioData;
     SemaphoreHandle_t     mutex_audioTask;
     TaskHandle_t          m_audioTaskHandle = nullptr;
+    TaskHandle_t          m_networkTaskHandle = nullptr;
+    std::atomic<uint32_t> m_inBuffUnderruns{0};
+    std::atomic<uint32_t> m_i2sUnderruns{0};     // incremented in the I2S ISR
+    volatile bool         m_f_countI2SUnderruns = false; // stream samples were written, an empty DMA queue is a real dropout
+    AudioMetrics          m_metrics;
+    uint32_t              m_metricsInterval = 0;  // ms, 0: no audio_metrics() reports
+    uint32_t              m_metricsTime = 0;      // millis() of the last report
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
 #if ESP_IDF_VERSION_MAJOR == 5
     i2s_chan_handle_t     m_i2s_tx_handle = {};
+    I2SSink               m_i2sSink;           // default output
     i2s_chan_config_t     m_i2s_chan_cfg = {}; // stores I2S channel values
     i2s_std_config_t      m_i2s_std_cfg = {};  // stores I2S driver values
 #else
@@ -581,6 +1083,7 @@ private:
     i2s_pin_config_t      m_pin_config = {};
 #endif
 #pragma GCC diagnostic pop
+    AudioSink*            m_sink = NULL;       // receives the PCM data, m_i2sSink by default
 
     std::vector<char*>    m_playlistContent;  // m3u8 playlist buffer
     std::vector<char*>    m_playlistURL;      // m3u8 streamURLs buffer
@@ -593,6 +1096,7 @@ private:
     const size_t    m_frameSizeOPUS   = 1024;
     const size_t    m_frameSizeVORBIS = 4096 * 2;
     const size_t    m_outbuffSize     = 4096 * 2;
+    const uint16_t  m_nextBuffSize    = 16384;      // first bytes of the queued file, read in advance
 
     static const uint8_t m_tsPacketSize  = 188;
     static const uint8_t m_tsHeaderSize  = 4;
@@ -619,9 +1123,12 @@ private:
     uint8_t         m_vol_steps = 21;               // default
     double          m_limit_left = 0;               // limiter 0 ... 1, left channel
     double          m_limit_right = 0;              // limiter 0 ... 1, right channel
+    int32_t         m_gainLeft = 32768;             // m_limit_left in Q15
+    int32_t         m_gainRight = 32768;            // m_limit_right in Q15
     uint8_t         m_timeoutCounter = 0;           // timeout counter
     uint8_t         m_curve = 0;                    // volume characteristic
     uint8_t         m_bitsPerSample = 16;           // bitsPerSample
+    uint8_t         m_outputBits = 16;              // sample width in m_outBuff after playChunk() and at the sink: 16 or 32
     uint8_t         m_channels = 2;
     uint8_t         m_i2s_num = I2S_NUM_0;          // I2S_NUM_0 or I2S_NUM_1
     uint8_t         m_playlistFormat = 0;           // M3U, PLS, ASX
@@ -634,10 +1141,16 @@ private:
     uint8_t         m_vuLeft = 0;                   // average value of samples, left channel
     uint8_t         m_vuRight = 0;                  // average value of samples, right channel
     uint8_t         m_audioTaskCoreId = 0;
+    int8_t          m_networkTaskCoreId = -1;       // -1: no network task
     uint8_t         m_M4A_objectType = 0;           // set in read_M4A_Header
     uint8_t         m_M4A_chConfig = 0;             // set in read_M4A_Header
     uint16_t        m_M4A_sampleRate = 0;           // set in read_M4A_Header
     int16_t*        m_outBuff = NULL;               // Interleaved L/R
+    FLACDecoder_t*  m_flacDecoder = NULL;           // decoder context, owned by this instance
+    AACDecoder_t*   m_aacDecoder = NULL;            // decoder context, owned by this instance
+    MP3Decoder_t*   m_mp3Decoder = NULL;            // decoder context, owned by this instance
+    VORBISDecoder_t* m_vorbisDecoder = NULL;        // decoder context, owned by this instance
+    OPUSDecoder_t*  m_opusDecoder = NULL;           // decoder context, owned by this instance
     int16_t         m_validSamples = {0};           // #144
     int16_t         m_curSample{0};
     uint16_t        m_dataMode{0};                  // Statemaschine
@@ -659,9 +1172,29 @@ private:
     uint32_t        m_PlayingStartTime = 0;         // Stores the milliseconds after the start of the audio
     int32_t         m_resumeFilePos = -1;           // the return value from stopSong(), (-1) is idle
     int32_t         m_fileStartPos = -1;            // may be set in connecttoFS()
-    uint16_t        m_m3u8_targetDuration = 10;     //
+    uint16_t        m_m3u8_targetDuration = 0;      // #EXT-X-TARGETDURATION in seconds, 0: not known yet
     uint32_t        m_stsz_numEntries = 0;          // num of entries inside stsz atom (uint32_t)
     uint32_t        m_stsz_position = 0;            // pos of stsz atom within file
+    uint32_t        m_stsz_sampleSize = 0;          // all samples have this size, 0: sizes are in the table
+    seekPoint_t*    m_seekIndex = NULL;             // built in buildSeekIndex() for local files
+    uint16_t        m_seekIndexLen = 0;             // number of points in m_seekIndex
+    float           m_seekUnitsPerSec = 0;          // seekPoint_t.unit per second
+    float           m_seekDuration = 0;             // exact duration in seconds from the file header, 0: not known
+    float           m_seekTime = -1;                // requested play position in seconds, -1: byte position only
+    float           m_seekSkipTime = 0;             // audio to drop after the decoder restarted in front of m_seekTime
+    float           m_seekNewTime = -1;             // current time after a seek, used in computeAudioTime()
+    float           m_mp3FrameBytes = 0;            // average frame length of a CBR mp3 file
+    uint32_t        m_mp3FirstFrame = 0;            // pos of the first mp3 frame (Xing/VBRI frame if present)
+    uint16_t        m_mp3StreamId = 0;              // version, layer and samplerate bits of the first frame
+    uint32_t        m_trimDelay = 0;                // decoder samples in front of the audio (encoder/decoder delay, Opus pre-skip)
+    uint64_t        m_trimEnd = 0;                  // decoder samples up to the end of the audio (without padding), 0: not known
+    uint64_t        m_trimPos = 0;                  // decoder samples so far
+    uint8_t*        m_nextBuff = NULL;              // m_nextBuffLen bytes of m_nextFile from position 0
+    uint16_t        m_nextBuffLen = 0;
+    uint8_t         m_nextCodec = CODEC_NONE;       // codec of m_nextFile, from the file extension or the first ogg page
+    void*           m_nextDecoder = NULL;           // decoder context for m_nextCodec, allocated in queueNextFS()
+    uint16_t        m_nextBuffPos = 0;              // m_nextDecoder has already parsed m_nextBuff up to here (ogg header pages)
+    bool            m_f_nextOggFile = false;        // m_nextFile is an ogg file
     uint32_t        m_haveNewFilePos = 0;           // user changed the file position
     uint32_t        m_sumBytesDecoded = 0;          // used for streaming
     uint32_t        m_webFilePos = 0;               // same as audiofile.position() for SD files
@@ -681,6 +1214,7 @@ private:
     bool            m_f_tts = false;                // text to speech
     bool            m_f_loop = false;               // Set if audio file should loop
     bool            m_f_forceMono = false;          // if true stereo -> mono
+    bool            m_f_outBuff32 = false;          // the decoder wrote left justified int32_t samples into m_outBuff
     bool            m_f_rtsp = false;               // set if RTSP is used (m3u8 stream)
     bool            m_f_m3u8data = false;           // used in processM3U8entries
     bool            m_f_Log = false;                // set in platformio.ini  -DAUDIO_LOG and -DCORE_DEBUG_LEVEL=3 or 4
@@ -691,18 +1225,25 @@ private:
     bool            m_f_timeout = false;            //
     bool            m_f_commFMT = false;            // false: default (PHILIPS), true: Least Significant Bit Justified (japanese format)
     bool            m_f_audioTaskIsRunning = false;
+    bool            m_f_networkTaskIsRunning = false;
+    bool            m_f_inBuffStarved = false;      // counts every underrun only once
+    bool            m_f_inBuffFull = false;         // counts every overrun only once
     bool            m_f_stream = false;             // stream ready for output?
     bool            m_f_decode_ready = false;       // if true data for decode are ready
     bool            m_f_eof = false;                // end of file
     bool            m_f_lockInBuffer = false;       // lock inBuffer for manipulation
     bool            m_f_audioTaskIsDecoding = false;
     bool            m_f_acceptRanges = false;
+    bool            m_f_oggFile = false;            // local file is an ogg container (FLAC, OPUS or VORBIS)
+    bool            m_f_keepI2S = false;            // queued file started, reconfigI2S() keeps the channel running if possible
     uint8_t         m_f_channelEnabled = 3;         //
     uint32_t        m_audioFileDuration = 0;
     float           m_audioCurrentTime = 0;
     uint32_t        m_audioDataStart = 0;           // in bytes
     size_t          m_audioDataSize = 0;            //
-    float           m_filterBuff[3][2][2][2];       // IIR filters memory for Audio DSP
+    iir_coef_t      m_iirCoef[3][5];                // {b0, b1, b2, a1, a2} per biquad, set in IIR_loadCoefficients()
+    iir_state_t     m_iirState[2][3][4] = {};       // IIR filters memory for Audio DSP [channel][biquad][x1, x2, y1, y2]
+    bool            m_f_iirFlat = true;             // all EQ gains 0dB, filter chain is skipped
     float           m_corr = 1.0;					// correction factor for level adjustment
     size_t          m_i2s_bytesWritten = 0;         // set in i2s_write() but not used
     size_t          m_fileSize = 0;                 // size of the file
@@ -13,68 +13,59 @@
 #include <stdio.h>
 #include <time.h>
 #include "libfaad/neaacdec.h"
+#include <new>
 
 
-// Declaration of the required global variables
+// complete state of one decoder instance, libfaad keeps its own state behind hAac
+
+struct AACDecoder_t {
+    NeAACDecHandle           hAac = NULL;
+    NeAACDecFrameInfo        frameInfo = {};
+    NeAACDecConfigurationPtr conf = NULL;
+    bool                     f_firstCall = false;
+    bool                     f_setRaWBlockParams = false;
+    uint32_t                 aacSamplerate = 0;
+    uint8_t                  aacChannels = 0;
+    uint8_t                  aacProfile = 0;
+    uint16_t                 validSamples = 0;
+    float                    compressionRatio = 1;
+};
 
-NeAACDecHandle hAac;
-NeAACDecFrameInfo frameInfo;
-NeAACDecConfigurationPtr conf;
 const uint8_t  SYNCWORDH = 0xff; /* 12-bit syncword */
 const uint8_t  SYNCWORDL = 0xf0;
-bool f_decoderIsInit = false;
-bool f_firstCall = false;
-bool f_setRaWBlockParams = false;
-uint32_t aacSamplerate = 0;
-uint8_t aacChannels = 0;
-uint8_t aacProfile = 0;
-static uint16_t validSamples = 0;
-clock_t before;
-float compressionRatio = 1;
-mp4AudioSpecificConfig* mp4ASC;
 
 //----------------------------------------------------------------------------------------------------------------------
-bool AACDecoder_IsInit(){
-    return f_decoderIsInit;
-}
-//----------------------------------------------------------------------------------------------------------------------
-bool AACDecoder_AllocateBuffers(){
-    before = clock();
-    hAac = NeAACDecOpen();
-    conf = NeAACDecGetCurrentConfiguration(hAac);
-
-    if(hAac) f_decoderIsInit = true;
-    f_firstCall = false;
-    f_setRaWBlockParams = false;
-    return f_decoderIsInit;
+AACDecoder_t* AACDecoder_AllocateBuffers(){
+    AACDecoder_t* ad = new (std::nothrow) AACDecoder_t();
+    if(!ad) return NULL;
+    ad->hAac = NeAACDecOpen();
+    if(!ad->hAac) {delete ad; return NULL;}
+    ad->conf = NeAACDecGetCurrentConfiguration(ad->hAac);
+    return ad;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void AACDecoder_FreeBuffers(){
-    NeAACDecClose(hAac);
-    hAac = NULL;
-    f_decoderIsInit = false;
-    f_firstCall = false;
-    clock_t difference = clock() - before;
-    int msec = difference  / CLOCKS_PER_SEC; (void)msec;
-//    printf("ms %li\n", difference);
+void AACDecoder_FreeBuffers(AACDecoder_t* ad){
+    if(!ad) return;
+    NeAACDecClose(ad->hAac);
+    delete ad;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t AACGetFormat(){
-    return frameInfo.header_type;  // RAW        0 /* No header */
-                                   // ADIF       1 /* single ADIF header at the beginning of the file */
-                                   // ADTS       2 /* ADTS header at the beginning of each frame */
+uint8_t AACGetFormat(AACDecoder_t* ad){
+    return ad->frameInfo.header_type;  // RAW        0 /* No header */
+                                       // ADIF       1 /* single ADIF header at the beginning of the file */
+                                       // ADTS       2 /* ADTS header at the beginning of each frame */
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t AACGetSBR(){
-    return frameInfo.sbr;          // NO_SBR           0 /* no SBR used in this file */
-                                   // SBR_UPSAMPLED    1 /* upsampled SBR used */
-                                   // SBR_DOWNSAMPLED  2 /* downsampled SBR used */
-                                   // NO_SBR_UPSAMPLED 3 /* no SBR used, but file is upsampled by a factor 2 anyway */
+uint8_t AACGetSBR(AACDecoder_t* ad){
+    return ad->frameInfo.sbr;          // NO_SBR           0 /* no SBR used in this file */
+                                       // SBR_UPSAMPLED    1 /* upsampled SBR used */
+                                       // SBR_DOWNSAMPLED  2 /* downsampled SBR used */
+                                       // NO_SBR_UPSAMPLED 3 /* no SBR used, but file is upsampled by a factor 2 anyway */
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t AACGetParametricStereo(){  // not used (0) or used (1)
-//    log_w("frameInfo.ps %i", frameInfo.isPS);
-    return frameInfo.isPS;
+uint8_t AACGetParametricStereo(AACDecoder_t* ad){  // not used (0) or used (1)
+//    log_w("frameInfo.ps %i", ad->frameInfo.isPS);
+    return ad->frameInfo.isPS;
 }
 //----------------------------------------------------------------------------------------------------------------------
 int AACFindSyncWord(uint8_t *buf, int nBytes){
@@ -90,32 +81,33 @@ int AACFindSyncWord(uint8_t *buf, int nBytes){
     return -1;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACSetRawBlockParams(int nChans, int sampRateCore, int profile){
-    f_setRaWBlockParams = true;
-    aacChannels = nChans;  // 1: Mono, 2: Stereo
-    aacSamplerate = (uint32_t)sampRateCore; // 8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000
-    aacProfile = profile; //1: AAC Main, 2: AAC LC (Low Complexity), 3: AAC SSR (Scalable Sample Rate), 4: AAC LTP (Long Term Prediction)
+int AACSetRawBlockParams(AACDecoder_t* ad, int nChans, int sampRateCore, int profile){
+    ad->f_setRaWBlockParams = true;
+    ad->aacChannels = nChans;  // 1: Mono, 2: Stereo
+    ad->aacSamplerate = (uint32_t)sampRateCore; // 8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000
+    ad->aacProfile = profile; //1: AAC Main, 2: AAC LC (Low Complexity), 3: AAC SSR (Scalable Sample Rate), 4: AAC LTP (Long Term Prediction)
     return 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int16_t AACGetOutputSamps(){
-    return validSamples;
+int16_t AACGetOutputSamps(AACDecoder_t* ad){
+    return ad->validSamples;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetBitrate(){
-    uint32_t br = AACGetBitsPerSample() * AACGetChannels() *  AACGetSampRate();
-    return (br / compressionRatio);;
+int AACGetBitrate(AACDecoder_t* ad){
+    uint32_t br = AACGetBitsPerSample(ad) * AACGetChannels(ad) *  AACGetSampRate(ad);
+    return (br / ad->compressionRatio);;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetChannels(){
-    return aacChannels;
+int AACGetChannels(AACDecoder_t* ad){
+    return ad->aacChannels;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetSampRate(){
-    return aacSamplerate;
+int AACGetSampRate(AACDecoder_t* ad){
+    return ad->aacSamplerate;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetBitsPerSample(){
+int AACGetBitsPerSample(AACDecoder_t* ad){
+    (void)ad;
     return 16;
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -126,33 +118,33 @@ void createAudioSpecificConfig(uint8_t* config, uint8_t audioObjectType, uint8_t
 //----------------------------------------------------------------------------------------------------------------------
 extern uint8_t get_sr_index(const uint32_t samplerate);
 
-int AACDecode(uint8_t *inbuf, int32_t *bytesLeft, short *outbuf){
+int AACDecode(AACDecoder_t* ad, uint8_t *inbuf, int32_t *bytesLeft, short *outbuf){
     uint8_t* ob = (uint8_t*)outbuf;
-    if (f_firstCall == false){
-        if(f_setRaWBlockParams){ // set raw AAC values, e.g. for M4A config.
-            f_setRaWBlockParams = false;
-            conf->defSampleRate = aacSamplerate;
-            conf->outputFormat = FAAD_FMT_16BIT;
-            conf->useOldADTSFormat = 1;
-            conf->defObjectType = 2;
-            int8_t ret = NeAACDecSetConfiguration(hAac, conf); (void)ret;
+    if (ad->f_firstCall == false){
+        if(ad->f_setRaWBlockParams){ // set raw AAC values, e.g. for M4A config.
+            ad->f_setRaWBlockParams = false;
+            ad->conf->defSampleRate = ad->aacSamplerate;
+            ad->conf->outputFormat = FAAD_FMT_16BIT;
+            ad->conf->useOldADTSFormat = 1;
+            ad->conf->defObjectType = 2;
+            int8_t ret = NeAACDecSetConfiguration(ad->hAac, ad->conf); (void)ret;
 
             uint8_t specificInfo[2];
-            createAudioSpecificConfig(specificInfo, aacProfile, get_sr_index(aacSamplerate), aacChannels);
-            int8_t err = NeAACDecInit2(hAac, specificInfo, 2, &aacSamplerate, &aacChannels);(void)err;
+            createAudioSpecificConfig(specificInfo, ad->aacProfile, get_sr_index(ad->aacSamplerate), ad->aacChannels);
+            int8_t err = NeAACDecInit2(ad->hAac, specificInfo, 2, &ad->aacSamplerate, &ad->aacChannels);(void)err;
         }
         else{
-            NeAACDecSetConfiguration(hAac, conf);
-            int8_t err = NeAACDecInit(hAac, inbuf, *bytesLeft, &aacSamplerate, &aacChannels); (void)err;
+            NeAACDecSetConfiguration(ad->hAac, ad->conf);
+            int8_t err = NeAACDecInit(ad->hAac, inbuf, *bytesLeft, &ad->aacSamplerate, &ad->aacChannels); (void)err;
         }
-        f_firstCall = true;
+        ad->f_firstCall = true;
     }
 
-    NeAACDecDecode2(hAac, &frameInfo, inbuf, *bytesLeft, (void**)&ob, 2048 * 2 * sizeof(int16_t));
-    *bytesLeft -= frameInfo.bytesconsumed;
-    validSamples = frameInfo.samples;
-    int8_t err = 0 - frameInfo.error;
-    compressionRatio = (float)frameInfo.samples * 2 / frameInfo.bytesconsumed;
+    NeAACDecDecode2(ad->hAac, &ad->frameInfo, inbuf, *bytesLeft, (void**)&ob, 2048 * 2 * sizeof(int16_t));
+    *bytesLeft -= ad->frameInfo.bytesconsumed;
+    ad->validSamples = ad->frameInfo.samples;
+    int8_t err = 0 - ad->frameInfo.error;
+    ad->compressionRatio = (float)ad->frameInfo.samples * 2 / ad->frameInfo.bytesconsumed;
     return err;
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -17,18 +17,19 @@ struct AudioSpecificConfig {
     uint8_t channelConfiguration;
 };
 
-bool        AACDecoder_IsInit();
-bool        AACDecoder_AllocateBuffers();
-void        AACDecoder_FreeBuffers();
-uint8_t     AACGetFormat();
-uint8_t     AACGetParametricStereo();
-uint8_t     AACGetSBR();
-int         AACFindSyncWord(uint8_t *buf, int nBytes);
-int         AACSetRawBlockParams(int nChans, int sampRateCore, int profile);
-int16_t     AACGetOutputSamps();
-int         AACGetBitrate();
-int         AACGetChannels();
-int         AACGetSampRate();
-int         AACGetBitsPerSample();
-int         AACDecode(uint8_t *inbuf, int32_t *bytesLeft, short *outbuf);
-const char* AACGetErrorMessage(int8_t err);
+typedef struct AACDecoder_t AACDecoder_t; // complete state of one decoder instance, see AACDecoder_AllocateBuffers()
+
+AACDecoder_t* AACDecoder_AllocateBuffers();
+void          AACDecoder_FreeBuffers(AACDecoder_t* ad);
+uint8_t       AACGetFormat(AACDecoder_t* ad);
+uint8_t       AACGetParametricStereo(AACDecoder_t* ad);
+uint8_t       AACGetSBR(AACDecoder_t* ad);
+int           AACFindSyncWord(uint8_t *buf, int nBytes);
+int           AACSetRawBlockParams(AACDecoder_t* ad, int nChans, int sampRateCore, int profile);
+int16_t       AACGetOutputSamps(AACDecoder_t* ad);
+int           AACGetBitrate(AACDecoder_t* ad);
+int           AACGetChannels(AACDecoder_t* ad);
+int           AACGetSampRate(AACDecoder_t* ad);
+int           AACGetBitsPerSample(AACDecoder_t* ad);
+int           AACDecode(AACDecoder_t* ad, uint8_t *inbuf, int32_t *bytesLeft, short *outbuf);
+const char*   AACGetErrorMessage(int8_t err);
@@ -1420,7 +1420,7 @@ void faad_resetbits(bitfile* ld, int bits) {
     uint32_t tmp;
     int      words = bits >> 5;
     int      remainder = bits & 0x1F;
-    if(ld->buffer_size < words * 4) ld->bytes_left = 0;
+    if(ld->buffer_size < (uint32_t)words * 4) ld->bytes_left = 0;
     else ld->bytes_left = ld->buffer_size - words * 4;
     if(ld->bytes_left >= 4) {
         tmp = getdword(&ld->start[words]);
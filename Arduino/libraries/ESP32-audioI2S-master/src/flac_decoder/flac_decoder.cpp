@@ -10,46 +10,12 @@
  *
  */
 #include "flac_decoder.h"
+#include "../ogg_demuxer/ogg_demuxer.h"
 #include "vector"
+#include <new>
 using namespace std;
 
-FLACFrameHeader_t*   FLACFrameHeader;
-FLACMetadataBlock_t* FLACMetadataBlock;
-
-vector<uint32_t> s_flacSegmTableVec;
-vector<int32_t>  coefs;
-vector<uint32_t> s_flacBlockPicItem;
-uint64_t         s_flac_bitBuffer = 0;
-uint32_t         s_flacBitrate = 0;
-uint32_t         s_flacBlockPicLenUntilFrameEnd = 0;
-uint32_t         s_flacCurrentFilePos = 0;
-uint32_t         s_flacBlockPicPos = 0;
-uint32_t         s_flacBlockPicLen = 0;
-uint32_t         s_flacAudioDataStart = 0;
-int32_t          s_flacRemainBlockPicLen = 0;
 const uint16_t   s_flacOutBuffSize = 2048;
-uint16_t         s_numOfOutSamples = 0;
-uint16_t         s_flacValidSamples = 0;
-uint16_t         s_rIndex = 0;
-uint16_t         s_offset = 0;
-uint8_t          s_flacStatus = 0;
-uint8_t*         s_flacInptr;
-float            s_flacCompressionRatio = 0;
-uint8_t          s_flacBitBufferLen = 0;
-bool             s_f_flacParseOgg = false;
-bool             s_f_bitReaderError = false;
-uint8_t          s_flac_pageSegments = 0;
-char*            s_flacStreamTitle = NULL;
-char*            s_flacVendorString = NULL;
-bool             s_f_flacNewStreamtitle = false;
-bool             s_f_flacFirstCall = true;
-bool             s_f_oggWrapper = false;
-bool             s_f_lastMetaDataBlock = false;
-bool             s_f_flacNewMetadataBlockPicture = false;
-uint8_t          s_flacPageNr = 0;
-int32_t**        s_samplesBuffer = NULL;
-uint16_t         s_maxBlocksize = MAX_BLOCKSIZE;
-int32_t          s_nBytes = 0;
 
 //----------------------------------------------------------------------------------------------------------------------
 //          FLAC INI SECTION
@@ -59,104 +25,98 @@ int32_t          s_nBytes = 0;
 #define __malloc_heap_psram(size) \
     heap_caps_malloc_prefer(size, 2, MALLOC_CAP_DEFAULT|MALLOC_CAP_SPIRAM, MALLOC_CAP_DEFAULT|MALLOC_CAP_INTERNAL)
 
-bool FLACDecoder_AllocateBuffers(void){
+FLACDecoder_t* FLACDecoder_AllocateBuffers(void){
 
-    if(!FLACFrameHeader)    {FLACFrameHeader    = (FLACFrameHeader_t*)    __malloc_heap_psram(sizeof(FLACFrameHeader_t));}
-    if(!FLACMetadataBlock)  {FLACMetadataBlock  = (FLACMetadataBlock_t*)  __malloc_heap_psram(sizeof(FLACMetadataBlock_t));}
-    if(!s_flacStreamTitle)  {s_flacStreamTitle  = (char*)                 __malloc_heap_psram(256);}
-
-    if(!FLACFrameHeader || !FLACMetadataBlock || !s_flacStreamTitle){
+    // every decoder instance owns its complete state, so several streams can be decoded at the same time
+    void* mem = __malloc_heap_psram(sizeof(FLACDecoder_t));
+    if(!mem){
         log_e("not enough memory to allocate flacdecoder buffers");
-        return false;
+        return NULL;
     }
+    FLACDecoder_t* fd = new (mem) FLACDecoder_t();
 
-    if(psramFound()){
-        s_samplesBuffer = (int32_t**)ps_malloc(MAX_CHANNELS * sizeof(int32_t*));
-        for (int32_t i = 0; i < MAX_CHANNELS; i++){
-            s_samplesBuffer[i] = (int32_t*)ps_malloc(s_maxBlocksize * sizeof(int32_t));
-            if(!s_samplesBuffer[i]){
-                log_e("not enough memory to allocate flacdecoder buffers");
-                return false;
-            }
-        }
+    fd->samplesBuffer = (int32_t**)__malloc_heap_psram(MAX_CHANNELS * sizeof(int32_t*));
+    if(!fd->samplesBuffer){
+        log_e("not enough memory to allocate flacdecoder buffers");
+        FLACDecoder_FreeBuffers(fd);
+        return NULL;
     }
-    else  {
-        s_samplesBuffer = (int32_t**)malloc(MAX_CHANNELS * sizeof(int32_t*));
-        for (int32_t i = 0; i < MAX_CHANNELS; i++){
-            s_samplesBuffer[i] = (int32_t*)malloc(s_maxBlocksize * sizeof(int32_t));
-            if(!s_samplesBuffer[i]){
-                log_e("not enough memory to allocate flacdecoder buffers");
-                return false;
-            }
+    for (int32_t i = 0; i < MAX_CHANNELS; i++){
+        fd->samplesBuffer[i] = (int32_t*)__malloc_heap_psram(MAX_BLOCKSIZE * sizeof(int32_t));
+        if(!fd->samplesBuffer[i]){
+            log_e("not enough memory to allocate flacdecoder buffers");
+            FLACDecoder_FreeBuffers(fd);
+            return NULL;
         }
     }
 
-    FLACDecoder_ClearBuffer();
-    FLACDecoder_setDefaults();
-    s_flacPageNr = 0;
-    return true;
+    FLACDecoder_ClearBuffer(fd);
+    FLACDecoder_setDefaults(fd);
+    fd->pageNr = 0;
+    return fd;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoder_ClearBuffer(){
-    memset(FLACFrameHeader,   0, sizeof(FLACFrameHeader_t));
-    memset(FLACMetadataBlock, 0, sizeof(FLACMetadataBlock_t));
+void FLACDecoder_ClearBuffer(FLACDecoder_t* fd){
+    memset(&fd->frameHeader,   0, sizeof(FLACFrameHeader_t));
+    memset(&fd->metadataBlock, 0, sizeof(FLACMetadataBlock_t));
 
-    if(s_samplesBuffer) {
+    if(fd->samplesBuffer) {
         for (int32_t i = 0; i < MAX_CHANNELS; i++){
-            memset(s_samplesBuffer[i], 0, s_maxBlocksize * sizeof(int32_t));
+            memset(fd->samplesBuffer[i], 0, MAX_BLOCKSIZE * sizeof(int32_t));
         }
     }
 
-    s_flacSegmTableVec.clear(); s_flacSegmTableVec.shrink_to_fit();
-    s_flacStatus = DECODE_FRAME;
+    fd->segmTableSize = 0;
+    fd->segmTableRdPtr = -1;
+    fd->status = DECODE_FRAME;
+    memset(&fd->oggCrc, 0, sizeof(oggCrc_t));
     return;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoder_FreeBuffers(){
-    if(FLACFrameHeader)    {free(FLACFrameHeader);    FLACFrameHeader    = NULL;}
-    if(FLACMetadataBlock)  {free(FLACMetadataBlock);  FLACMetadataBlock  = NULL;}
-    if(s_flacStreamTitle)  {free(s_flacStreamTitle);  s_flacStreamTitle  = NULL;}
-    if(s_flacVendorString) {free(s_flacVendorString); s_flacVendorString = NULL;}
+void FLACDecoder_FreeBuffers(FLACDecoder_t* fd){
+    if(!fd) return;
+    if(fd->vendorString) {free(fd->vendorString); fd->vendorString = NULL;}
 
-    if(s_samplesBuffer){
+    if(fd->samplesBuffer){
         for (int32_t i = 0; i < MAX_CHANNELS; i++){
-            if(s_samplesBuffer[i]){free(s_samplesBuffer[i]);}
+            if(fd->samplesBuffer[i]){free(fd->samplesBuffer[i]);}
         }
-        free(s_samplesBuffer); s_samplesBuffer = NULL;
+        free(fd->samplesBuffer); fd->samplesBuffer = NULL;
     }
-    coefs.clear(); coefs.shrink_to_fit();
-    s_flacSegmTableVec.clear(); s_flacSegmTableVec.shrink_to_fit();
-    s_flacBlockPicItem.clear(); s_flacBlockPicItem.shrink_to_fit();
+    fd->~FLACDecoder_t(); // releases the vectors
+    free(fd);
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoder_setDefaults(){
-    coefs.clear(); coefs.shrink_to_fit();
-    s_flacSegmTableVec.clear(); s_flacSegmTableVec.shrink_to_fit();
-    s_flacBlockPicItem.clear(); s_flacBlockPicItem.shrink_to_fit();
-    s_flac_bitBuffer = 0;
-    s_flacBitrate = 0;
-    s_flacBlockPicLenUntilFrameEnd = 0;
-    s_flacCurrentFilePos = 0;
-    s_flacBlockPicPos = 0;
-    s_flacBlockPicLen = 0;
-    s_flacRemainBlockPicLen = 0;
-    s_flacAudioDataStart = 0;
-    s_numOfOutSamples = 0;
-    s_offset = 0;
-    s_flacValidSamples = 0;
-    s_rIndex = 0;
-    s_flacStatus = DECODE_FRAME;
-    s_flacCompressionRatio = 0;
-    s_flacBitBufferLen = 0;
-    s_flac_pageSegments = 0;
-    s_f_flacNewStreamtitle = false;
-    s_f_flacFirstCall = true;
-    s_f_oggWrapper = false;
-    s_f_lastMetaDataBlock = false;
-    s_f_flacNewMetadataBlockPicture = false;
-    s_f_flacParseOgg = false;
-    s_f_bitReaderError = false;
-    s_nBytes = 0;
+void FLACDecoder_setDefaults(FLACDecoder_t* fd){
+    fd->segmTableSize = 0;
+    fd->segmTableRdPtr = -1;
+    fd->f_continuedPage = false;
+    fd->f_lastPacketContinues = false;
+    fd->blockPicItem.clear(); fd->blockPicItem.shrink_to_fit();
+    fd->bitBuffer = 0;
+    fd->bitrate = 0;
+    fd->blockPicLenUntilFrameEnd = 0;
+    fd->currentFilePos = 0;
+    fd->blockPicPos = 0;
+    fd->blockPicLen = 0;
+    fd->remainBlockPicLen = 0;
+    fd->audioDataStart = 0;
+    fd->numOfOutSamples = 0;
+    fd->offset = 0;
+    fd->validSamples = 0;
+    fd->rIndex = 0;
+    fd->status = DECODE_FRAME;
+    fd->compressionRatio = 0;
+    fd->bitBufferLen = 0;
+    fd->pageSegments = 0;
+    fd->f_newStreamtitle = false;
+    fd->f_firstCall = true;
+    fd->f_oggWrapper = false;
+    fd->f_lastMetaDataBlock = false;
+    fd->f_newMetadataBlockPicture = false;
+    fd->f_parseOgg = false;
+    fd->f_bitReaderError = false;
+    fd->nBytes = 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
 //            B I T R E A D E R
@@ -167,70 +127,139 @@ const uint32_t mask[] = {0x00000000, 0x00000001, 0x00000003, 0x00000007, 0x00000
                          0x001fffff, 0x003fffff, 0x007fffff, 0x00ffffff, 0x01ffffff, 0x03ffffff, 0x07ffffff,
                          0x0fffffff, 0x1fffffff, 0x3fffffff, 0x7fffffff, 0xffffffff};
 
-uint32_t readUint(uint8_t nBits, int32_t *bytesLeft){
-    while (s_flacBitBufferLen < nBits){
-        uint8_t temp = *(s_flacInptr + s_rIndex);
-        s_rIndex++;
-        (*bytesLeft)--;
-        if(*bytesLeft < 0) { log_e("error in bitreader"); s_f_bitReaderError = true; break;}
-        s_flac_bitBuffer = (s_flac_bitBuffer << 8) | temp;
-        s_flacBitBufferLen += 8;
+// The valid bits are the lowest 'len' bits of the 64-bit cache, MSB first. The cache is topped up with whole bytes,
+// eight at once if the input has them, so the bounds check runs once per refill and not once per byte.
+// Bytes that are cached but not yet consumed are given back with releaseBits() before returning to the caller.
+inline __attribute__((always_inline)) void refillBits(FLACDecoder_t* fd, uint64_t& cache, uint8_t& len, int32_t* bytesLeft){
+    uint8_t n = (64 - len) >> 3;                   // whole bytes that fit into the cache
+    if(n == 0) return;
+    const uint8_t* p = fd->inptr + fd->rIndex;
+    if(*bytesLeft >= 8){
+        uint64_t w;
+        memcpy(&w, p, 8);
+        w = __builtin_bswap64(w);                  // big endian stream
+        cache = (n == 8) ? w : (cache << (n * 8)) | (w >> (64 - n * 8));
     }
-    s_flacBitBufferLen -= nBits;
-    uint32_t result = s_flac_bitBuffer >> s_flacBitBufferLen;
-    if (nBits < 32)
-        result &= mask[nBits];
-    return result;
+    else{
+        if(n > *bytesLeft) n = *bytesLeft;
+        for(uint8_t i = 0; i < n; i++) cache = (cache << 8) | p[i];
+    }
+    fd->rIndex += n;
+    *bytesLeft -= n;
+    len += n * 8;
+}
+
+void releaseBits(FLACDecoder_t* fd, int32_t* bytesLeft){
+    uint8_t n = fd->bitBufferLen >> 3;
+    fd->bitBufferLen -= n * 8;
+    fd->rIndex -= n;
+    *bytesLeft += n;
+}
+
+uint32_t readUint(FLACDecoder_t* fd, uint8_t nBits, int32_t *bytesLeft){
+    if(fd->bitBufferLen < nBits){
+        refillBits(fd, fd->bitBuffer, fd->bitBufferLen, bytesLeft);
+        if(fd->bitBufferLen < nBits){
+            log_e("error in bitreader");
+            fd->f_bitReaderError = true;
+            fd->bitBufferLen = 0;
+            return 0;
+        }
+    }
+    fd->bitBufferLen -= nBits;
+    return (uint32_t)(fd->bitBuffer >> fd->bitBufferLen) & mask[nBits];
 }
 
-int32_t readSignedInt(int32_t nBits, int32_t* bytesLeft){
-    int32_t temp = readUint(nBits, bytesLeft) << (32 - nBits);
+int32_t readSignedInt(FLACDecoder_t* fd, int32_t nBits, int32_t* bytesLeft){
+    int32_t temp = readUint(fd, nBits, bytesLeft) << (32 - nBits);
     temp = temp >> (32 - nBits); // The C++ compiler uses the sign bit to fill vacated bit positions
     return temp;
 }
 
-int64_t readRiceSignedInt(uint8_t param, int32_t* bytesLeft){
-    long val = 0;
-    while (readUint(1, bytesLeft) == 0)
-        val++;
-    val = (val << param) | readUint(param, bytesLeft);
-    return (val >> 1) ^ -(val & 1);
+int64_t readRiceSignedInt(FLACDecoder_t* fd, uint8_t param, int32_t* bytesLeft){
+    int32_t val = 0;
+    readRicePartition(fd, &val, 1, param, bytesLeft);
+    return val;
 }
 
-void alignToByte() {
-    s_flacBitBufferLen -= s_flacBitBufferLen % 8;
+int8_t readRicePartition(FLACDecoder_t* fd, int32_t* out, int32_t count, uint8_t param, int32_t* bytesLeft){
+    uint64_t cache = fd->bitBuffer;                // keep the cache in registers for the whole partition
+    uint8_t  len   = fd->bitBufferLen;
+    int8_t   ret   = ERR_FLAC_NONE;
+
+    for(int32_t i = 0; i < count; i++){
+        uint32_t q = 0;                            // unary coded quotient, count the leading zeros
+        while(true){
+            uint64_t v = len ? cache << (64 - len) : 0;
+            if(v){
+                uint8_t z = __builtin_clzll(v);
+                q += z;
+                len -= z + 1;                      // zeros and the stop bit
+                break;
+            }
+            q += len;
+            len = 0;
+            refillBits(fd, cache, len, bytesLeft);
+            if(!len) {ret = ERR_FLAC_BITREADER_UNDERFLOW; goto exit;}
+        }
+        if(len < param){
+            refillBits(fd, cache, len, bytesLeft);
+            if(len < param) {ret = ERR_FLAC_BITREADER_UNDERFLOW; goto exit;}
+        }
+        len -= param;
+        uint32_t u = (q << param) | ((uint32_t)(cache >> len) & mask[param]);
+        out[i] = (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+    }
+exit:
+    fd->bitBuffer = cache;
+    fd->bitBufferLen = len;
+    if(ret){
+        log_e("error in bitreader");
+        fd->f_bitReaderError = true;
+    }
+    return ret;
+}
+
+void alignToByte(FLACDecoder_t* fd) {
+    fd->bitBufferLen -= fd->bitBufferLen % 8;
 }
 //----------------------------------------------------------------------------------------------------------------------
 //              F L A C - D E C O D E R
 //----------------------------------------------------------------------------------------------------------------------
-void FLACSetRawBlockParams(uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength){
-    FLACMetadataBlock->numChannels = Chans;
-    FLACMetadataBlock->sampleRate = SampRate;
-    FLACMetadataBlock->bitsPerSample = BPS;
-    FLACMetadataBlock->totalSamples = tsis;  // total samples in stream
-    FLACMetadataBlock->audioDataLength = AuDaLength;
+void FLACSetRawBlockParams(FLACDecoder_t* fd, uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength){
+    fd->metadataBlock.numChannels = Chans;
+    fd->metadataBlock.sampleRate = SampRate;
+    fd->metadataBlock.bitsPerSample = BPS;
+    fd->metadataBlock.totalSamples = tsis;  // total samples in stream
+    fd->metadataBlock.audioDataLength = AuDaLength;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void FLACDecoderReset(FLACDecoder_t* fd){ // set var to default
+    FLACDecoder_setDefaults(fd);
+    FLACDecoder_ClearBuffer(fd);
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoderReset(){ // set var to default
-    FLACDecoder_setDefaults();
-    FLACDecoder_ClearBuffer();
+void FLACSetOutputBits(FLACDecoder_t* fd, uint8_t bits){ // 16 (default) or 32, survives FLACDecoderReset()
+    if(!fd) return;
+    if(bits != 16 && bits != 32) return;
+    fd->outputBits = bits;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t FLACFindSyncWord(unsigned char *buf, int32_t nBytes) {
+int32_t FLACFindSyncWord(FLACDecoder_t* fd, unsigned char *buf, int32_t nBytes) {
 
-    int32_t i = FLAC_specialIndexOf(buf, "OggS", nBytes);
-    if(i == 0) {s_f_bitReaderError = false; return 0;}  // flag has ogg wrapper
+    int32_t i = OGGfindSyncWord(buf, nBytes);
+    if(i == 0) {fd->f_bitReaderError = false; return 0;}  // flag has ogg wrapper
 
-    if(s_f_oggWrapper && i > 0){
-        s_f_bitReaderError = false;
+    if(fd->f_oggWrapper && i > 0){
+        fd->f_bitReaderError = false;
         return i;
     }
     else{
          /* find byte-aligned sync code - need 14 matching bits */
         for (i = 0; i < nBytes - 1; i++) {
             if ((buf[i + 0] & 0xFF) == 0xFF  && (buf[i + 1] & 0xFC) == 0xF8) { // <14> Sync code '11111111111110xx'
-                if(i) FLACDecoderReset();
-            //    s_f_bitReaderError = false;
+                if(i) FLACDecoderReset(fd);
+            //    fd->f_bitReaderError = false;
                 return i;
             }
         }
@@ -255,87 +284,56 @@ boolean FLACFindMagicWord(unsigned char* buf, int32_t nBytes){
     return false;
 }
 //----------------------------------------------------------------------------------------------------------------------
-char* FLACgetStreamTitle(){
-    if(s_f_flacNewStreamtitle){
-        s_f_flacNewStreamtitle = false;
-        return s_flacStreamTitle;
+char* FLACgetStreamTitle(FLACDecoder_t* fd){
+    if(fd->f_newStreamtitle){
+        fd->f_newStreamtitle = false;
+        return fd->streamTitle;
     }
     return NULL;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t FLACparseOGG(uint8_t *inbuf, int32_t *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
-
-    s_f_flacParseOgg = false;
-    int32_t idx = FLAC_specialIndexOf(inbuf, "OggS", 6);
-    if(idx != 0) return ERR_FLAC_DECODER_ASYNC;
-
-    uint8_t  version            = *(inbuf +  4); (void) version;
-    uint8_t  headerType         = *(inbuf +  5); (void) headerType;
-    uint64_t granulePosition    = (uint64_t)*(inbuf + 13) << 56;  // granule_position: an 8 Byte field containing -
-             granulePosition   += (uint64_t)*(inbuf + 12) << 48;  // position information. For an audio stream, it MAY
-             granulePosition   += (uint64_t)*(inbuf + 11) << 40;  // contain the total number of PCM samples encoded
-             granulePosition   += (uint64_t)*(inbuf + 10) << 32;  // after including all frames finished on this page.
-             granulePosition   += *(inbuf +  9) << 24;  // This is a hint for the decoder and gives it some timing
-             granulePosition   += *(inbuf +  8) << 16;  // and position information. A special value of -1 (in two's
-             granulePosition   += *(inbuf +  7) << 8;   // complement) indicates that no packets finish on this page.
-             granulePosition   += *(inbuf +  6); (void) granulePosition;
-    uint32_t bitstreamSerialNr  = *(inbuf + 17) << 24;  // bitstream_serial_number: a 4 Byte field containing the
-             bitstreamSerialNr += *(inbuf + 16) << 16;  // unique serial number by which the logical bitstream
-             bitstreamSerialNr += *(inbuf + 15) << 8;   // is identified.
-             bitstreamSerialNr += *(inbuf + 14); (void) bitstreamSerialNr;
-    uint32_t pageSequenceNr     = *(inbuf + 21) << 24;  // page_sequence_number: a 4 Byte field containing the sequence
-             pageSequenceNr    += *(inbuf + 20) << 16;  // number of the page so the decoder can identify page loss
-             pageSequenceNr    += *(inbuf + 19) << 8;   // This sequence number is increasing on each logical bitstream
-             pageSequenceNr    += *(inbuf + 18); (void) pageSequenceNr;
-    uint32_t CRCchecksum        = *(inbuf + 25) << 24;
-             CRCchecksum       += *(inbuf + 24) << 16;
-             CRCchecksum       += *(inbuf + 23) << 8;
-             CRCchecksum       += *(inbuf + 22); (void) CRCchecksum;
-    uint8_t  pageSegments       = *(inbuf + 26);        // giving the number of segment entries
-
-    // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
-    // 255: A second byte is needed.  The total length is first_byte + second byte
-    s_flacSegmTableVec.clear();
-    s_flacSegmTableVec.shrink_to_fit();
-    for(int32_t i = 0; i < pageSegments; i++){
-        int32_t n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            if(i == pageSegments) break;
-            n+= *(inbuf + 27 + i);
-        }
-        s_flacSegmTableVec.insert(s_flacSegmTableVec.begin(), n);
+int32_t FLACparseOGG(FLACDecoder_t* fd, uint8_t *inbuf, int32_t *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
+
+    fd->f_parseOgg = false;
+    oggPage_t page;
+    int32_t headerSize = OGGparsePage(inbuf, *bytesLeft, &page, fd->segmTable, &fd->oggCrc);
+    if(headerSize == ERR_OGG_CRC){ // the whole page is in the buffer, skip it
+        log_w("Ogg page %u: CRC error, page skipped", page.sequenceNr);
+        *bytesLeft -= page.headerSize + page.bodySize;
+        fd->currentFilePos += page.headerSize + page.bodySize;
+        fd->segmTableSize = 0;
+        fd->f_lastPacketContinues = false;
+        fd->f_parseOgg = true;
+        return ERR_FLAC_NONE;
     }
-    // for(int32_t i = 0; i< s_flacSegmTableVec.size(); i++){log_w("%i", s_flacSegmTableVec[i]);}
-
-    bool     continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
-    bool     firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
-    bool     lastPage      = headerType & 0x04; // set: this is the last page of a logical bitstream (eos)
-
-    (void)continuedPage; (void)lastPage;
+    if(headerSize < 0) return ERR_FLAC_DECODER_ASYNC;
 
-    // log_w("firstPage %i, continuedPage %i, lastPage %i", firstPage, continuedPage, lastPage);
+    fd->segmTableSize = page.packets;
+    fd->segmTableRdPtr = -1;
+    fd->f_continuedPage = OGGisContinuedPage(&page); // set: page contains data of a packet continued from the previous page
+    fd->f_lastPacketContinues = page.lastPacketContinues;
+    if(!fd->segmTableSize) fd->f_parseOgg = true;   // page without packets
 
-    if(firstPage) s_flacPageNr = 0;
+    // log_w("firstPage %i, continuedPage %i, lastPage %i", OGGisFirstPage(&page), OGGisContinuedPage(&page), OGGisLastPage(&page));
 
-    uint32_t headerSize = pageSegments + 27;
+    if(OGGisFirstPage(&page)) fd->pageNr = 0;
 
     *bytesLeft -= headerSize;
-    s_flacCurrentFilePos += headerSize;
+    fd->currentFilePos += headerSize;
     return ERR_FLAC_NONE; // no error
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-vector<uint32_t> FLACgetMetadataBlockPicture(){
-    if(s_f_flacNewMetadataBlockPicture){
-        s_f_flacNewMetadataBlockPicture = false;
-        return s_flacBlockPicItem;
+vector<uint32_t> FLACgetMetadataBlockPicture(FLACDecoder_t* fd){
+    if(fd->f_newMetadataBlockPicture){
+        fd->f_newMetadataBlockPicture = false;
+        return fd->blockPicItem;
     }
-    if(s_flacBlockPicItem.size() > 0){
-        s_flacBlockPicItem.clear();
-        s_flacBlockPicItem.shrink_to_fit();
+    if(fd->blockPicItem.size() > 0){
+        fd->blockPicItem.clear();
+        fd->blockPicItem.shrink_to_fit();
     }
-    return s_flacBlockPicItem;
+    return fd->blockPicItem;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
 int32_t parseFlacFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identification header   https://xiph.org/flac/ogg_mapping.html
@@ -353,7 +351,7 @@ int32_t parseFlacFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identifi
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
+int32_t parseMetaDataBlockHeader(FLACDecoder_t* fd, uint8_t *inbuf, int16_t nBytes){
     int8_t   ret = FLAC_PARSE_OGG_DONE;
     uint16_t pos = 0;
     int32_t  blockLength = 0;
@@ -378,7 +376,7 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
 
     while(true){
         mdBlockHeader         = *(inbuf + pos);
-        s_f_lastMetaDataBlock = mdBlockHeader & 0b10000000; //log_w("lastMdBlockFlag %i", s_f_lastMetaDataBlock);
+        fd->f_lastMetaDataBlock = mdBlockHeader & 0b10000000; //log_w("lastMdBlockFlag %i", fd->f_lastMetaDataBlock);
         blockType             = mdBlockHeader & 0b01111111; //log_w("blockType %i", blockType);
 
         blockLength        = *(inbuf + pos + 1) << 16;
@@ -432,10 +430,10 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 maxBlocksize += *(inbuf + pos + 3);
                 //log_i("minBlocksize %i", minBlocksize);
                 //log_i("maxBlocksize %i", maxBlocksize);
-                FLACMetadataBlock->minblocksize = minBlocksize;
-                FLACMetadataBlock->maxblocksize = maxBlocksize;
+                fd->metadataBlock.minblocksize = minBlocksize;
+                fd->metadataBlock.maxblocksize = maxBlocksize;
 
-                if(maxBlocksize > s_maxBlocksize){log_e("s_blocksize is too big"); return ERR_FLAC_BLOCKSIZE_TOO_BIG;}
+                if(maxBlocksize > MAX_BLOCKSIZE){log_e("s_blocksize is too big"); return ERR_FLAC_BLOCKSIZE_TOO_BIG;}
 
                 minFrameSize  = *(inbuf + pos + 4) << 16;
                 minFrameSize += *(inbuf + pos + 5) << 8;
@@ -445,22 +443,22 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 maxFrameSize += *(inbuf + pos + 9);
                 //log_i("minFrameSize %i", minFrameSize);
                 //log_i("maxFrameSize %i", maxFrameSize);
-                FLACMetadataBlock->minframesize = minFrameSize;
-                FLACMetadataBlock->maxframesize = maxFrameSize;
+                fd->metadataBlock.minframesize = minFrameSize;
+                fd->metadataBlock.maxframesize = maxFrameSize;
 
                 sampleRate   =  *(inbuf + pos + 10) << 12;
                 sampleRate  +=  *(inbuf + pos + 11) << 4;
                 sampleRate  += (*(inbuf + pos + 12) & 0xF0) >> 4;
                 //log_i("sampleRate %i", sampleRate);
-                FLACMetadataBlock->sampleRate = sampleRate;
+                fd->metadataBlock.sampleRate = sampleRate;
 
                 nrOfChannels = ((*(inbuf + pos + 12) & 0x0E) >> 1) + 1;
                 //log_i("nrOfChannels %i", nrOfChannels);
-                FLACMetadataBlock->numChannels = nrOfChannels;
+                fd->metadataBlock.numChannels = nrOfChannels;
 
                 bitsPerSample  =  (*(inbuf + pos + 12) & 0x01) << 5;
                 bitsPerSample += ((*(inbuf + pos + 13) & 0xF0) >> 4) + 1;
-                FLACMetadataBlock->bitsPerSample = bitsPerSample;
+                fd->metadataBlock.bitsPerSample = bitsPerSample;
                 //log_i("bitsPerSample %i", bitsPerSample);
 
                 totalSamplesInStream  = (uint64_t)(*(inbuf + pos + 17) & 0x0F) << 32;
@@ -469,7 +467,7 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 totalSamplesInStream += (*(inbuf + pos + 15)) << 8;
                 totalSamplesInStream += (*(inbuf + pos + 16));
                 //log_i("totalSamplesInStream %lli", totalSamplesInStream);
-                FLACMetadataBlock->totalSamples = totalSamplesInStream;
+                fd->metadataBlock.totalSamples = totalSamplesInStream;
 
                 //log_i("nBytes %i, blockLength %i", nBytes, blockLength);
                 pos += blockLength;
@@ -485,10 +483,10 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 if(vendorLength > 1024){
                     log_e("vendorLength > 1024 bytes");
                 }
-                if(s_flacVendorString) {free(s_flacVendorString); s_flacVendorString = NULL;}
-                s_flacVendorString = (char*) flac_x_ps_calloc(vendorLength + 1, sizeof(char));
-                memcpy(s_flacVendorString, inbuf + pos + 4, vendorLength);
-                //log_i("%s", s_flacVendorString);
+                if(fd->vendorString) {free(fd->vendorString); fd->vendorString = NULL;}
+                fd->vendorString = (char*) flac_x_ps_calloc(vendorLength + 1, sizeof(char));
+                memcpy(fd->vendorString, inbuf + pos + 4, vendorLength);
+                //log_i("%s", fd->vendorString);
 
                 pos += 4 + vendorLength;
                 userCommentListLength  = *(inbuf + pos + 3) << 24;
@@ -498,7 +496,7 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
 
                 pos += 4;
                 commemtStringLength = 0;
-                for(int32_t i = 0; i < userCommentListLength; i++){
+                for(uint32_t i = 0; i < userCommentListLength; i++){
                     commemtStringLength  = *(inbuf + pos + 3) << 24;
                     commemtStringLength += *(inbuf + pos + 2) << 16;
                     commemtStringLength += *(inbuf + pos + 1) <<  8;
@@ -534,44 +532,44 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                     }
                     if((FLAC_specialIndexOf(inbuf + pos + 4, "METADATA_BLOCK_PICTURE", 23) == 0) || (FLAC_specialIndexOf(inbuf + pos + 4, "metadata_block_picture", 23) == 0)){
                         //log_w("METADATA_BLOCK_PICTURE found, commemtStringLength %i", commemtStringLength);
-                        s_flacBlockPicLen = commemtStringLength - 23;
-                        s_flacBlockPicPos = s_flacCurrentFilePos + pos + 4 + 23;
-                        s_flacBlockPicLenUntilFrameEnd = nBytes - (pos + 23);
-                        if(s_flacBlockPicLen < s_flacBlockPicLenUntilFrameEnd) s_flacBlockPicLenUntilFrameEnd = s_flacBlockPicLen;
-                        s_flacRemainBlockPicLen = s_flacBlockPicLen - s_flacBlockPicLenUntilFrameEnd;
-                        //log_i("s_flacBlockPicPos %i, s_flacBlockPicLen %i", s_flacBlockPicPos, s_flacBlockPicLen);
-                        //log_i("s_flacBlockPicLenUntilFrameEnd %i, s_flacRemainBlockPicLen %i", s_flacBlockPicLenUntilFrameEnd, s_flacRemainBlockPicLen);
-                        if(s_flacRemainBlockPicLen <= 0) s_f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
-                        if(s_flacBlockPicLen){
-                            s_flacBlockPicItem.clear();
-                            s_flacBlockPicItem.shrink_to_fit();
-                            s_flacBlockPicItem.push_back(s_flacBlockPicPos);
-                            s_flacBlockPicItem.push_back(s_flacBlockPicLenUntilFrameEnd);
+                        fd->blockPicLen = commemtStringLength - 23;
+                        fd->blockPicPos = fd->currentFilePos + pos + 4 + 23;
+                        fd->blockPicLenUntilFrameEnd = nBytes - (pos + 23);
+                        if(fd->blockPicLen < fd->blockPicLenUntilFrameEnd) fd->blockPicLenUntilFrameEnd = fd->blockPicLen;
+                        fd->remainBlockPicLen = fd->blockPicLen - fd->blockPicLenUntilFrameEnd;
+                        //log_i("fd->blockPicPos %i, fd->blockPicLen %i", fd->blockPicPos, fd->blockPicLen);
+                        //log_i("fd->blockPicLenUntilFrameEnd %i, fd->remainBlockPicLen %i", fd->blockPicLenUntilFrameEnd, fd->remainBlockPicLen);
+                        if(fd->remainBlockPicLen <= 0) fd->f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
+                        if(fd->blockPicLen){
+                            fd->blockPicItem.clear();
+                            fd->blockPicItem.shrink_to_fit();
+                            fd->blockPicItem.push_back(fd->blockPicPos);
+                            fd->blockPicItem.push_back(fd->blockPicLenUntilFrameEnd);
                         }
                     }
                     pos += 4 + commemtStringLength;
                     //log_i("nBytes %i, pos %i, commemtStringLength %i", nBytes, pos, commemtStringLength);
                 }
-                memset(s_flacStreamTitle, 0, 256);
+                memset(fd->streamTitle, 0, 256);
                 if(vb[1] && vb[0]){ // artist and title
-                    strcpy(s_flacStreamTitle, vb[1]);
-                    strcat(s_flacStreamTitle, " - ");
-                    strcat(s_flacStreamTitle, vb[0]);
-                    s_f_flacNewStreamtitle = true;
+                    strcpy(fd->streamTitle, vb[1]);
+                    strcat(fd->streamTitle, " - ");
+                    strcat(fd->streamTitle, vb[0]);
+                    fd->f_newStreamtitle = true;
                 }
                 else if(vb[1]){
-                    strcpy(s_flacStreamTitle, vb[1]);
-                    s_f_flacNewStreamtitle = true;
+                    strcpy(fd->streamTitle, vb[1]);
+                    fd->f_newStreamtitle = true;
                 }
                 else if(vb[0]){
-                    strcpy(s_flacStreamTitle, vb[0]);
-                    s_f_flacNewStreamtitle = true;
+                    strcpy(fd->streamTitle, vb[0]);
+                    fd->f_newStreamtitle = true;
                 }
                 for(int32_t i = 0; i < 8; i++){
                     if(vb[i]){free(vb[i]); vb[i] = NULL;}
                 }
 
-                if(!s_flacBlockPicLen && s_flacSegmTableVec.size() == 1) s_f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
+                if(!fd->blockPicLen && fd->segmTableSize == 1) fd->f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
                 if(ret == FLAC_PARSE_OGG_DONE) return ret;
                 break;
 
@@ -587,227 +585,295 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
     return 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t FLACDecode(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){ //  MAIN LOOP
+int8_t FLACDecode(FLACDecoder_t* fd, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
+    // the CRC of an Ogg page that does not fit into the input window is carried across the calls, see ogg_demuxer.cpp
+    OGGcrcFeed(&fd->oggCrc, inbuf, *bytesLeft);
+    int8_t ret = flacDecode(fd, inbuf, bytesLeft, outbuf);
+    OGGcrcConsumed(&fd->oggCrc, *bytesLeft, ret);
+    return ret;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int8_t flacDecode(FLACDecoder_t* fd, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){ //  MAIN LOOP
 
     int32_t                ret = 0;
     uint32_t           segmLen = 0;
-    static uint32_t segmLenTmp = 0;
 
-    if(s_f_flacFirstCall){ // determine if ogg or flag
-        s_f_flacFirstCall = false;
-        s_nBytes = 0;
-        segmLenTmp = 0;
+    if(fd->f_firstCall){ // determine if ogg or flag
+        fd->f_firstCall = false;
+        fd->nBytes = 0;
+        fd->segmLenTmp = 0;
         if(FLAC_specialIndexOf(inbuf, "OggS", 5) == 0){
-            s_f_oggWrapper = true;
-            s_f_flacParseOgg = true;
+            fd->f_oggWrapper = true;
+            fd->f_parseOgg = true;
         }
     }
 
-    if(s_f_oggWrapper){
+    if(fd->f_oggWrapper){
 
-        if(segmLenTmp){ // can't skip more than 16K
-            if(segmLenTmp > 16384){
-                s_flacCurrentFilePos += 16384;
+        if(fd->segmLenTmp){ // can't skip more than 16K
+            if(fd->segmLenTmp > 16384){
+                fd->currentFilePos += 16384;
                 *bytesLeft -= 16384;
-                segmLenTmp -= 16384;
+                fd->segmLenTmp -= 16384;
             }
             else{
-                s_flacCurrentFilePos += segmLenTmp;
-                *bytesLeft -= segmLenTmp;
-                segmLenTmp  = 0;
+                fd->currentFilePos += fd->segmLenTmp;
+                *bytesLeft -= fd->segmLenTmp;
+                fd->segmLenTmp  = 0;
             }
             return FLAC_PARSE_OGG_DONE;
         }
 
-        if(s_nBytes > 0){
-            int16_t diff = s_nBytes;
-            if(s_flacAudioDataStart == 0){
-                s_flacAudioDataStart = s_flacCurrentFilePos;
+        if(fd->nBytes > 0){
+            int16_t diff = fd->nBytes;
+            if(fd->audioDataStart == 0){
+                fd->audioDataStart = fd->currentFilePos;
             }
-            ret = FLACDecodeNative(inbuf, &s_nBytes, outbuf);
-            diff -= s_nBytes;
-            s_flacCurrentFilePos += diff;
+            ret = FLACDecodeNative(fd, inbuf, &fd->nBytes, outbuf);
+            diff -= fd->nBytes;
+            fd->currentFilePos += diff;
             *bytesLeft -= diff;
             return ret;
         }
-        if(s_nBytes < 0){return ERR_FLAC_DECODER_ASYNC;}
+        if(fd->nBytes < 0){return ERR_FLAC_DECODER_ASYNC;}
+
+        int32_t rest = OGGcrcBadPageRest(&fd->oggCrc);
+        if(rest >= 0){ // the remaining packets of a corrupted page
+            *bytesLeft -= rest;
+            fd->currentFilePos += rest;
+            fd->segmTableSize = 0;
+            fd->segmTableRdPtr = -1;
+            fd->f_lastPacketContinues = false;
+            fd->f_parseOgg = true;
+            return FLAC_PARSE_OGG_DONE;
+        }
 
-        if(s_f_flacParseOgg == true){
-            s_f_flacParseOgg = false;
-            ret = FLACparseOGG(inbuf, bytesLeft);
+        if(fd->f_parseOgg == true){
+            fd->f_parseOgg = false;
+            ret = FLACparseOGG(fd, inbuf, bytesLeft);
             if(ret == ERR_FLAC_NONE) return FLAC_PARSE_OGG_DONE; // ok
             else return ret;  // error
         }
         //-------------------------------------------------------
-        if(!s_flacSegmTableVec.size()) log_e("size is 0");
-        segmLen = s_flacSegmTableVec.back();
-        s_flacSegmTableVec.pop_back();
-        if(!s_flacSegmTableVec.size()) s_f_flacParseOgg = true;
+        if(!fd->segmTableSize) {log_e("size is 0"); fd->f_parseOgg = true; return FLAC_PARSE_OGG_DONE;}
+        fd->segmTableRdPtr++;
+        fd->segmTableSize--;
+        segmLen = fd->segmTable[fd->segmTableRdPtr];
+        if(!fd->segmTableSize) fd->f_parseOgg = true;
         //-------------------------------------------------------
 
-        if(s_flacRemainBlockPicLen <= 0 && !s_f_flacNewMetadataBlockPicture) {
-            if(s_flacBlockPicItem.size() > 0) { // get blockpic data
+        if(fd->remainBlockPicLen <= 0 && !fd->f_newMetadataBlockPicture) {
+            if(fd->blockPicItem.size() > 0) { // get blockpic data
                 // log_i("---------------------------------------------------------------------------");
-                // log_i("metadata blockpic found at pos %i, size %i bytes", s_flacBlockPicPos, s_flacBlockPicLen);
-                // for(int32_t i = 0; i < s_flacBlockPicItem.size(); i += 2) { log_i("segment %02i, pos %07i, len %05i", i / 2, s_flacBlockPicItem[i], s_flacBlockPicItem[i + 1]); }
+                // log_i("metadata blockpic found at pos %i, size %i bytes", fd->blockPicPos, fd->blockPicLen);
+                // for(int32_t i = 0; i < fd->blockPicItem.size(); i += 2) { log_i("segment %02i, pos %07i, len %05i", i / 2, fd->blockPicItem[i], fd->blockPicItem[i + 1]); }
                 // log_i("---------------------------------------------------------------------------");
-                s_f_flacNewMetadataBlockPicture = true;
+                fd->f_newMetadataBlockPicture = true;
             }
         }
 
-        switch(s_flacPageNr) {
+        switch(fd->pageNr) {
             case 0:
                 ret = parseFlacFirstPacket(inbuf, segmLen);
-                if(ret == segmLen) {
-                    s_flacPageNr = 1;
+                if(ret == (int32_t)segmLen) {
+                    fd->pageNr = 1;
                     ret = FLAC_PARSE_OGG_DONE;
                     break;
                 }
                 if(ret < 0){  // fLaC signature not found
                     break;
                 }
-                if(ret < segmLen){
+                if(ret < (int32_t)segmLen){
                     segmLen -= ret;
                     *bytesLeft -= ret;
-                    s_flacCurrentFilePos += ret;
+                    fd->currentFilePos += ret;
                     inbuf += ret;
-                    s_flacPageNr = 1;
+                    fd->pageNr = 1;
                 } /* fallthrough */
             case 1:
-                if(s_flacRemainBlockPicLen > 0){
-                    s_flacRemainBlockPicLen -= segmLen;
-                    //log_i("s_flacCurrentFilePos %i, len %i, s_flacRemainBlockPicLen %i", s_flacCurrentFilePos, segmLen, s_flacRemainBlockPicLen);
-                    s_flacBlockPicItem.push_back(s_flacCurrentFilePos);
-                    s_flacBlockPicItem.push_back(segmLen);
-                    if(s_flacRemainBlockPicLen <= 0){s_flacPageNr = 2;}
+                if(fd->remainBlockPicLen > 0){
+                    fd->remainBlockPicLen -= segmLen;
+                    //log_i("fd->currentFilePos %i, len %i, fd->remainBlockPicLen %i", fd->currentFilePos, segmLen, fd->remainBlockPicLen);
+                    fd->blockPicItem.push_back(fd->currentFilePos);
+                    fd->blockPicItem.push_back(segmLen);
+                    if(fd->remainBlockPicLen <= 0){fd->pageNr = 2;}
                     ret = FLAC_PARSE_OGG_DONE;
                     break;
                 }
-                ret = parseMetaDataBlockHeader(inbuf, segmLen);
-                if(s_f_lastMetaDataBlock) s_flacPageNr = 2;
+                ret = parseMetaDataBlockHeader(fd, inbuf, segmLen);
+                if(fd->f_lastMetaDataBlock) fd->pageNr = 2;
                 break;
             case 2:
-                s_nBytes = segmLen;
+                if(fd->f_continuedPage && fd->segmTableRdPtr == 0){ // rest of a frame whose first part is missing
+                    fd->segmLenTmp = segmLen;
+                    return FLAC_PARSE_OGG_DONE;
+                }
+                if(fd->f_lastPacketContinues && !fd->segmTableSize){ // the frame continues on the next page
+                    oggPage_t page;
+                    if(OGGjoinContinuedPacket(inbuf, segmLen, *bytesLeft, &page, fd->segmTable, &fd->oggCrc)){
+                        *bytesLeft -= page.headerSize; // skip the gap, the joined frame follows
+                        fd->currentFilePos += page.headerSize;
+                        segmLen += fd->segmTable[0];
+                        fd->segmTableRdPtr = 0; // continue with the remaining packets of the next page
+                        fd->segmTableSize = page.packets - 1;
+                        fd->f_lastPacketContinues = page.lastPacketContinues;
+                        fd->f_parseOgg = !fd->segmTableSize;
+                    }
+                }
+                fd->nBytes = segmLen;
                 return FLAC_PARSE_OGG_DONE;
                 break;
         }
         if(segmLen > 16384){
-            segmLenTmp = segmLen;
+            fd->segmLenTmp = segmLen;
             return FLAC_PARSE_OGG_DONE;
         }
         *bytesLeft -= segmLen;
-        s_flacCurrentFilePos += segmLen;
+        fd->currentFilePos += segmLen;
         return ret;
     }
-    ret = FLACDecodeNative(inbuf, bytesLeft, outbuf);
+    ret = FLACDecodeNative(fd, inbuf, bytesLeft, outbuf);
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t FLACDecodeNative(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
+int8_t FLACDecodeNative(FLACDecoder_t* fd, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
+    int8_t ret = flacDecodeBlock(fd, inbuf, bytesLeft, outbuf);
+    releaseBits(fd, bytesLeft); // bytes the bitreader has cached but not consumed belong to the caller again
+    return ret;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int8_t flacDecodeBlock(FLACDecoder_t* fd, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
 
     int32_t bl = *bytesLeft;
-    static int32_t sbl = 0;
 
-    if(s_flacStatus != OUT_SAMPLES){
-        s_rIndex = 0;
-        s_flacInptr = inbuf;
+    if(fd->status != OUT_SAMPLES){
+        fd->rIndex = 0;
+        fd->inptr = inbuf;
     }
 
-    while(s_flacStatus == DECODE_FRAME){// Read a ton of header fields, and ignore most of them
-        int32_t ret = flacDecodeFrame (inbuf, bytesLeft);
+    while(fd->status == DECODE_FRAME){// Read a ton of header fields, and ignore most of them
+        int32_t ret = flacDecodeFrame(fd, inbuf, bytesLeft);
         if(ret != 0) return ret;
         if(*bytesLeft < MAX_BLOCKSIZE) return FLAC_DECODE_FRAMES_LOOP; // need more data
-        sbl += bl - *bytesLeft;
+        fd->sbl += bl - *bytesLeft;
     }
 
-    if(s_flacStatus == DECODE_SUBFRAMES){
+    if(fd->status == DECODE_SUBFRAMES){
         // Decode each channel's subframe, then skip footer
-        int32_t ret = decodeSubframes(bytesLeft);
+        int32_t ret = decodeSubframes(fd, bytesLeft);
         if(ret != 0) return ret;
-        s_flacStatus = OUT_SAMPLES;
-        sbl += bl - *bytesLeft;
+        fd->status = OUT_SAMPLES;
+        fd->sbl += bl - *bytesLeft;
     }
 
-    if(s_flacStatus == OUT_SAMPLES){  // Write the decoded samples
+    if(fd->status == OUT_SAMPLES){  // Write the decoded samples
         // blocksize can be much greater than outbuff, so we can't stuff all in once
         // therefore we need often more than one loop (split outputblock into pieces)
         uint16_t blockSize;
-        if(s_numOfOutSamples < s_flacOutBuffSize + s_offset) blockSize = s_numOfOutSamples - s_offset;
+        if(fd->numOfOutSamples < s_flacOutBuffSize + fd->offset) blockSize = fd->numOfOutSamples - fd->offset;
         else blockSize = s_flacOutBuffSize;
 
-        for (int32_t i = 0; i < blockSize; i++) {
-            for (int32_t j = 0; j < FLACMetadataBlock->numChannels; j++) {
-                int32_t val = s_samplesBuffer[j][i + s_offset];
-                if (FLACMetadataBlock->bitsPerSample == 8) val += 128;
-                outbuf[2*i+j] = val;
+        const uint8_t nch = fd->metadataBlock.numChannels;
+        const uint8_t bps = fd->metadataBlock.bitsPerSample;
+        if(fd->outputBits == 32){ // left justified, the full resolution of the stream is kept
+            int32_t* out32 = (int32_t*)outbuf;
+            for (int32_t i = 0; i < blockSize; i++) {
+                for (int32_t j = 0; j < nch; j++) {
+                    out32[nch * i + j] = (int32_t)((uint32_t)fd->samplesBuffer[j][i + fd->offset] << (32 - bps));
+                }
+            }
+        }
+        else if(bps > 16){ // requantize to 16 bit, TPDF dither instead of plain truncation
+            const uint8_t shift = bps - 16;
+            for (int32_t i = 0; i < blockSize; i++) {
+                for (int32_t j = 0; j < nch; j++) {
+                    int32_t val = fd->samplesBuffer[j][i + fd->offset];
+                    fd->ditherSeed = fd->ditherSeed * 1664525 + 1013904223;
+                    int32_t r1 = fd->ditherSeed >> (32 - shift);
+                    fd->ditherSeed = fd->ditherSeed * 1664525 + 1013904223;
+                    int32_t r2 = fd->ditherSeed >> (32 - shift);
+                    val = (val + r1 - r2 + (1 << (shift - 1))) >> shift;
+                    if(val >  32767) val =  32767;
+                    if(val < -32768) val = -32768;
+                    outbuf[nch * i + j] = val;
+                }
+            }
+        }
+        else{
+            for (int32_t i = 0; i < blockSize; i++) {
+                for (int32_t j = 0; j < nch; j++) {
+                    int32_t val = fd->samplesBuffer[j][i + fd->offset];
+                    if (bps == 8) val += 128;
+                    outbuf[nch * i + j] = val;
+                }
             }
         }
 
-        s_flacValidSamples = blockSize * FLACMetadataBlock->numChannels;
-        s_offset += blockSize;
-        if(sbl > 0){
-            s_flacCompressionRatio = (float)((s_flacValidSamples * 2) * FLACMetadataBlock->numChannels) / sbl; // valid samples are 16 bit
-            sbl = 0;
-            s_flacBitrate = FLACMetadataBlock->sampleRate * FLACMetadataBlock->bitsPerSample * FLACMetadataBlock->numChannels;
-            s_flacBitrate /= s_flacCompressionRatio;
-      //      log_e("s_flacBitrate %i, s_flacCompressionRatio %f, FLACMetadataBlock->sampleRate %i ", s_flacBitrate, s_flacCompressionRatio, FLACMetadataBlock->sampleRate);
+        fd->validSamples = blockSize * fd->metadataBlock.numChannels;
+        fd->offset += blockSize;
+        if(fd->sbl > 0){
+            fd->compressionRatio = (float)((fd->validSamples * 2) * fd->metadataBlock.numChannels) / fd->sbl; // valid samples are 16 bit
+            fd->sbl = 0;
+            fd->bitrate = fd->metadataBlock.sampleRate * fd->metadataBlock.bitsPerSample * fd->metadataBlock.numChannels;
+            fd->bitrate /= fd->compressionRatio;
+      //      log_e("fd->bitrate %i, fd->compressionRatio %f, fd->metadataBlock.sampleRate %i ", fd->bitrate, fd->compressionRatio, fd->metadataBlock.sampleRate);
         }
-        if(s_offset != s_numOfOutSamples) return GIVE_NEXT_LOOP;
-        if(s_offset > s_numOfOutSamples) { log_e("offset has a wrong value"); }
-        s_offset = 0;
+        if(fd->offset != fd->numOfOutSamples) return GIVE_NEXT_LOOP;
+        if(fd->offset > fd->numOfOutSamples) { log_e("offset has a wrong value"); }
+        fd->offset = 0;
     }
 
-    alignToByte();
-    readUint(16, bytesLeft);
+    alignToByte(fd);
+    readUint(fd, 16, bytesLeft);
 
-//    s_flacCompressionRatio = (float)m_bytesDecoded / (float)s_numOfOutSamples * FLACMetadataBlock->numChannels * (16/8);
-//    log_i("s_flacCompressionRatio % f", s_flacCompressionRatio);
-    s_flacStatus = DECODE_FRAME;
+//    fd->compressionRatio = (float)m_bytesDecoded / (float)fd->numOfOutSamples * fd->metadataBlock.numChannels * (16/8);
+//    log_i("fd->compressionRatio % f", fd->compressionRatio);
+    fd->status = DECODE_FRAME;
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t flacDecodeFrame(uint8_t *inbuf, int32_t *bytesLeft){
-    if(FLAC_specialIndexOf(inbuf, "OggS", *bytesLeft) == 0){ // async? => new sync is OggS => reset and decode (not page 0 or 1)
-        FLACDecoderReset();
-        s_flacPageNr = 2;
+int8_t flacDecodeFrame(FLACDecoder_t* fd, uint8_t *inbuf, int32_t *bytesLeft){
+    if(FLAC_specialIndexOf(inbuf, "OggS", 5) == 0){ // only position 0 is of interest, async? => new sync is OggS => reset and decode (not page 0 or 1)
+        FLACDecoderReset(fd);
+        fd->pageNr = 2;
         return OGG_SYNC_FOUND;
     }
-    readUint(14 + 1, bytesLeft); // synccode + reserved bit
-    FLACFrameHeader->blockingStrategy = readUint(1, bytesLeft);
-    FLACFrameHeader->blockSizeCode = readUint(4, bytesLeft);
-    FLACFrameHeader->sampleRateCode = readUint(4, bytesLeft);
-    FLACFrameHeader->chanAsgn = readUint(4, bytesLeft);
-    FLACFrameHeader->sampleSizeCode = readUint(3, bytesLeft);
-    if(!FLACMetadataBlock->numChannels){
-        if(FLACFrameHeader->chanAsgn == 0) FLACMetadataBlock->numChannels = 1;
-        if(FLACFrameHeader->chanAsgn == 1) FLACMetadataBlock->numChannels = 2;
-        if(FLACFrameHeader->chanAsgn > 7)  FLACMetadataBlock->numChannels = 2;
+    readUint(fd, 14 + 1, bytesLeft); // synccode + reserved bit
+    fd->frameHeader.blockingStrategy = readUint(fd, 1, bytesLeft);
+    fd->frameHeader.blockSizeCode = readUint(fd, 4, bytesLeft);
+    fd->frameHeader.sampleRateCode = readUint(fd, 4, bytesLeft);
+    fd->frameHeader.chanAsgn = readUint(fd, 4, bytesLeft);
+    fd->frameHeader.sampleSizeCode = readUint(fd, 3, bytesLeft);
+    if(!fd->metadataBlock.numChannels){
+        if(fd->frameHeader.chanAsgn == 0) fd->metadataBlock.numChannels = 1;
+        if(fd->frameHeader.chanAsgn == 1) fd->metadataBlock.numChannels = 2;
+        if(fd->frameHeader.chanAsgn > 7)  fd->metadataBlock.numChannels = 2;
     }
-    if(FLACMetadataBlock->numChannels < 1) return ERR_FLAC_UNKNOWN_CHANNEL_ASSIGNMENT;
-    if(!FLACMetadataBlock->bitsPerSample){
-        if(FLACFrameHeader->sampleSizeCode == 1) FLACMetadataBlock->bitsPerSample =  8;
-        if(FLACFrameHeader->sampleSizeCode == 2) FLACMetadataBlock->bitsPerSample = 12;
-        if(FLACFrameHeader->sampleSizeCode == 4) FLACMetadataBlock->bitsPerSample = 16;
-        if(FLACFrameHeader->sampleSizeCode == 5) FLACMetadataBlock->bitsPerSample = 20;
-        if(FLACFrameHeader->sampleSizeCode == 6) FLACMetadataBlock->bitsPerSample = 24;
+    if(fd->metadataBlock.numChannels < 1) return ERR_FLAC_UNKNOWN_CHANNEL_ASSIGNMENT;
+    if(!fd->metadataBlock.bitsPerSample){
+        if(fd->frameHeader.sampleSizeCode == 1) fd->metadataBlock.bitsPerSample =  8;
+        if(fd->frameHeader.sampleSizeCode == 2) fd->metadataBlock.bitsPerSample = 12;
+        if(fd->frameHeader.sampleSizeCode == 4) fd->metadataBlock.bitsPerSample = 16;
+        if(fd->frameHeader.sampleSizeCode == 5) fd->metadataBlock.bitsPerSample = 20;
+        if(fd->frameHeader.sampleSizeCode == 6) fd->metadataBlock.bitsPerSample = 24;
     }
-    if(FLACMetadataBlock->bitsPerSample > 16) return ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG;
-    if(FLACMetadataBlock->bitsPerSample < 8 ) return ERR_FLAC_BITS_PER_SAMPLE_UNKNOWN;
-    if(!FLACMetadataBlock->sampleRate){
-        if(FLACFrameHeader->sampleRateCode == 1)  FLACMetadataBlock->sampleRate =  88200;
-        if(FLACFrameHeader->sampleRateCode == 2)  FLACMetadataBlock->sampleRate = 176400;
-        if(FLACFrameHeader->sampleRateCode == 3)  FLACMetadataBlock->sampleRate = 192000;
-        if(FLACFrameHeader->sampleRateCode == 4)  FLACMetadataBlock->sampleRate =   8000;
-        if(FLACFrameHeader->sampleRateCode == 5)  FLACMetadataBlock->sampleRate =  16000;
-        if(FLACFrameHeader->sampleRateCode == 6)  FLACMetadataBlock->sampleRate =  22050;
-        if(FLACFrameHeader->sampleRateCode == 7)  FLACMetadataBlock->sampleRate =  24000;
-        if(FLACFrameHeader->sampleRateCode == 8)  FLACMetadataBlock->sampleRate =  32000;
-        if(FLACFrameHeader->sampleRateCode == 9)  FLACMetadataBlock->sampleRate =  44100;
-        if(FLACFrameHeader->sampleRateCode == 10) FLACMetadataBlock->sampleRate =  48000;
-        if(FLACFrameHeader->sampleRateCode == 11) FLACMetadataBlock->sampleRate =  96000;
+    if(fd->metadataBlock.bitsPerSample > 24) return ERR_FLAC_BITS_PER_SAMPLE_TOO_BIG;
+    if(fd->metadataBlock.bitsPerSample < 8 ) return ERR_FLAC_BITS_PER_SAMPLE_UNKNOWN;
+    if(!fd->metadataBlock.sampleRate){
+        if(fd->frameHeader.sampleRateCode == 1)  fd->metadataBlock.sampleRate =  88200;
+        if(fd->frameHeader.sampleRateCode == 2)  fd->metadataBlock.sampleRate = 176400;
+        if(fd->frameHeader.sampleRateCode == 3)  fd->metadataBlock.sampleRate = 192000;
+        if(fd->frameHeader.sampleRateCode == 4)  fd->metadataBlock.sampleRate =   8000;
+        if(fd->frameHeader.sampleRateCode == 5)  fd->metadataBlock.sampleRate =  16000;
+        if(fd->frameHeader.sampleRateCode == 6)  fd->metadataBlock.sampleRate =  22050;
+        if(fd->frameHeader.sampleRateCode == 7)  fd->metadataBlock.sampleRate =  24000;
+        if(fd->frameHeader.sampleRateCode == 8)  fd->metadataBlock.sampleRate =  32000;
+        if(fd->frameHeader.sampleRateCode == 9)  fd->metadataBlock.sampleRate =  44100;
+        if(fd->frameHeader.sampleRateCode == 10) fd->metadataBlock.sampleRate =  48000;
+        if(fd->frameHeader.sampleRateCode == 11) fd->metadataBlock.sampleRate =  96000;
     }
-    readUint(1, bytesLeft);
-    uint32_t temp = (readUint(8, bytesLeft) << 24);
+    readUint(fd, 1, bytesLeft);
+    uint32_t temp = (readUint(fd, 8, bytesLeft) << 24);
     temp = ~temp;
     uint32_t shift = 0x80000000; // Number of leading zeros
     int8_t count = 0;
@@ -816,119 +882,119 @@ int8_t flacDecodeFrame(uint8_t *inbuf, int32_t *bytesLeft){
         else break;
     }
     count--;
-    for (int32_t i = 0; i < count; i++) readUint(8, bytesLeft);
-    s_numOfOutSamples = 0;
-    if (FLACFrameHeader->blockSizeCode == 1)
-        s_numOfOutSamples = 192;
-    else if (2 <= FLACFrameHeader->blockSizeCode && FLACFrameHeader->blockSizeCode <= 5)
-        s_numOfOutSamples = 576 << (FLACFrameHeader->blockSizeCode - 2);
-    else if (FLACFrameHeader->blockSizeCode == 6)
-        s_numOfOutSamples = readUint(8, bytesLeft) + 1;
-    else if (FLACFrameHeader->blockSizeCode == 7)
-        s_numOfOutSamples = readUint(16, bytesLeft) + 1;
-    else if (8 <= FLACFrameHeader->blockSizeCode && FLACFrameHeader->blockSizeCode <= 15)
-        s_numOfOutSamples = 256 << (FLACFrameHeader->blockSizeCode - 8);
+    for (int32_t i = 0; i < count; i++) readUint(fd, 8, bytesLeft);
+    fd->numOfOutSamples = 0;
+    if (fd->frameHeader.blockSizeCode == 1)
+        fd->numOfOutSamples = 192;
+    else if (2 <= fd->frameHeader.blockSizeCode && fd->frameHeader.blockSizeCode <= 5)
+        fd->numOfOutSamples = 576 << (fd->frameHeader.blockSizeCode - 2);
+    else if (fd->frameHeader.blockSizeCode == 6)
+        fd->numOfOutSamples = readUint(fd, 8, bytesLeft) + 1;
+    else if (fd->frameHeader.blockSizeCode == 7)
+        fd->numOfOutSamples = readUint(fd, 16, bytesLeft) + 1;
+    else if (8 <= fd->frameHeader.blockSizeCode && fd->frameHeader.blockSizeCode <= 15)
+        fd->numOfOutSamples = 256 << (fd->frameHeader.blockSizeCode - 8);
     else{
         return ERR_FLAC_RESERVED_BLOCKSIZE_UNSUPPORTED;
     }
-    if(s_numOfOutSamples > MAX_OUTBUFFSIZE){
-        log_e("Error: blockSizeOut too big ,%i bytes", s_numOfOutSamples);
+    if(fd->numOfOutSamples > MAX_OUTBUFFSIZE){
+        log_e("Error: blockSizeOut too big ,%i bytes", fd->numOfOutSamples);
         return ERR_FLAC_BLOCKSIZE_TOO_BIG;
     }
-    if(FLACFrameHeader->sampleRateCode == 12)
-        readUint(8, bytesLeft);
-    else if (FLACFrameHeader->sampleRateCode == 13 || FLACFrameHeader->sampleRateCode == 14){
-        readUint(16, bytesLeft);
+    if(fd->frameHeader.sampleRateCode == 12)
+        readUint(fd, 8, bytesLeft);
+    else if (fd->frameHeader.sampleRateCode == 13 || fd->frameHeader.sampleRateCode == 14){
+        readUint(fd, 16, bytesLeft);
     }
-    readUint(8, bytesLeft);
-    s_flacStatus = DECODE_SUBFRAMES;
+    readUint(fd, 8, bytesLeft);
+    fd->status = DECODE_SUBFRAMES;
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint16_t FLACGetOutputSamps(){
-    int32_t vs = s_flacValidSamples;
-    s_flacValidSamples=0;
+uint16_t FLACGetOutputSamps(FLACDecoder_t* fd){
+    int32_t vs = fd->validSamples;
+    fd->validSamples=0;
     return vs;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint64_t FLACGetTotoalSamplesInStream(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->totalSamples;
+uint64_t FLACGetTotoalSamplesInStream(FLACDecoder_t* fd){
+    if(!fd) return 0;
+    return fd->metadataBlock.totalSamples;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t FLACGetBitsPerSample(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->bitsPerSample;
+uint8_t FLACGetBitsPerSample(FLACDecoder_t* fd){
+    if(!fd) return 0;
+    return fd->metadataBlock.bitsPerSample;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t FLACGetChannels(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->numChannels;
+uint8_t FLACGetChannels(FLACDecoder_t* fd){
+    if(!fd) return 0;
+    return fd->metadataBlock.numChannels;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetSampRate(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->sampleRate;
+uint32_t FLACGetSampRate(FLACDecoder_t* fd){
+    if(!fd) return 0;
+    return fd->metadataBlock.sampleRate;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetBitRate(){
-    return s_flacBitrate;
+uint32_t FLACGetBitRate(FLACDecoder_t* fd){
+    return fd->bitrate;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetAudioDataStart(){
-    return s_flacAudioDataStart;
+uint32_t FLACGetAudioDataStart(FLACDecoder_t* fd){
+    return fd->audioDataStart;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetAudioFileDuration() {
-    if(FLACGetSampRate()){ // DIV0
-        uint32_t afd = FLACGetTotoalSamplesInStream()/ FLACGetSampRate(); // AudioFileDuration
+uint32_t FLACGetAudioFileDuration(FLACDecoder_t* fd) {
+    if(FLACGetSampRate(fd)){ // DIV0
+        uint32_t afd = FLACGetTotoalSamplesInStream(fd)/ FLACGetSampRate(fd); // AudioFileDuration
         return afd;
     }
     return 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeSubframes(int32_t* bytesLeft){
-    if(FLACFrameHeader->chanAsgn <= 7) {
-        for (int32_t ch = 0; ch < FLACMetadataBlock->numChannels; ch++)
-            decodeSubframe(FLACMetadataBlock->bitsPerSample, ch, bytesLeft);
+int8_t decodeSubframes(FLACDecoder_t* fd, int32_t* bytesLeft){
+    if(fd->frameHeader.chanAsgn <= 7) {
+        for (int32_t ch = 0; ch < fd->metadataBlock.numChannels; ch++)
+            decodeSubframe(fd, fd->metadataBlock.bitsPerSample, ch, bytesLeft);
     }
-    else if (8 <= FLACFrameHeader->chanAsgn && FLACFrameHeader->chanAsgn <= 10) {
-        decodeSubframe(FLACMetadataBlock->bitsPerSample + (FLACFrameHeader->chanAsgn == 9 ? 1 : 0), 0, bytesLeft);
-        decodeSubframe(FLACMetadataBlock->bitsPerSample + (FLACFrameHeader->chanAsgn == 9 ? 0 : 1), 1, bytesLeft);
-        if(FLACFrameHeader->chanAsgn == 8) {
-            for (int32_t i = 0; i < s_numOfOutSamples; i++)
-                s_samplesBuffer[1][i] = (
-                        s_samplesBuffer[0][i] -
-                        s_samplesBuffer[1][i]);
+    else if (8 <= fd->frameHeader.chanAsgn && fd->frameHeader.chanAsgn <= 10) {
+        decodeSubframe(fd, fd->metadataBlock.bitsPerSample + (fd->frameHeader.chanAsgn == 9 ? 1 : 0), 0, bytesLeft);
+        decodeSubframe(fd, fd->metadataBlock.bitsPerSample + (fd->frameHeader.chanAsgn == 9 ? 0 : 1), 1, bytesLeft);
+        if(fd->frameHeader.chanAsgn == 8) {
+            for (int32_t i = 0; i < fd->numOfOutSamples; i++)
+                fd->samplesBuffer[1][i] = (
+                        fd->samplesBuffer[0][i] -
+                        fd->samplesBuffer[1][i]);
         }
-        else if (FLACFrameHeader->chanAsgn == 9) {
-            for (int32_t i = 0; i < s_numOfOutSamples; i++)
-                s_samplesBuffer[0][i] += s_samplesBuffer[1][i];
+        else if (fd->frameHeader.chanAsgn == 9) {
+            for (int32_t i = 0; i < fd->numOfOutSamples; i++)
+                fd->samplesBuffer[0][i] += fd->samplesBuffer[1][i];
         }
-        else if (FLACFrameHeader->chanAsgn == 10) {
-            for (int32_t i = 0; i < s_numOfOutSamples; i++) {
-                int32_t side =  s_samplesBuffer[1][i];
-                int32_t right = s_samplesBuffer[0][i] - (side >> 1);
-                s_samplesBuffer[1][i] = right;
-                s_samplesBuffer[0][i] = right + side;
+        else if (fd->frameHeader.chanAsgn == 10) {
+            for (int32_t i = 0; i < fd->numOfOutSamples; i++) {
+                int32_t side =  fd->samplesBuffer[1][i];
+                int32_t right = fd->samplesBuffer[0][i] - (side >> 1);
+                fd->samplesBuffer[1][i] = right;
+                fd->samplesBuffer[0][i] = right + side;
             }
         }
         else {
-            log_e("unknown channel assignment, %i", FLACFrameHeader->chanAsgn);
+            log_e("unknown channel assignment, %i", fd->frameHeader.chanAsgn);
             return ERR_FLAC_UNKNOWN_CHANNEL_ASSIGNMENT;
         }
     }
     else{
-        log_e("Reserved channel assignment, %i", FLACFrameHeader->chanAsgn);
+        log_e("Reserved channel assignment, %i", fd->frameHeader.chanAsgn);
         return ERR_FLAC_RESERVED_CHANNEL_ASSIGNMENT;
     }
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {
+int8_t decodeSubframe(FLACDecoder_t* fd, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {
     int8_t ret = 0;
-    readUint(1, bytesLeft);                // Zero bit padding, to prevent sync-fooling string of 1s
-    uint8_t type = readUint(6, bytesLeft); // Subframe type: 000000 : SUBFRAME_CONSTANT
+    readUint(fd, 1, bytesLeft);                // Zero bit padding, to prevent sync-fooling string of 1s
+    uint8_t type = readUint(fd, 6, bytesLeft); // Subframe type: 000000 : SUBFRAME_CONSTANT
                                            //                000001 : SUBFRAME_VERBATIM
                                            //                00001x : reserved
                                            //                0001xx : reserved
@@ -936,136 +1002,172 @@ int8_t decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {
                                            //                01xxxx : reserved
                                            //                1xxxxx : SUBFRAME_LPC, xxxxx=order-1
 
-    int32_t shift = readUint(1, bytesLeft);    // Wasted bits-per-sample' flag:
+    int32_t shift = readUint(fd, 1, bytesLeft);    // Wasted bits-per-sample' flag:
                                            // 0 : no wasted bits-per-sample in source subblock, k=0
                                            // 1 : k wasted bits-per-sample in source subblock, k-1 follows, unary coded; e.g. k=3 => 001 follows, k=7 => 0000001 follows.
     if (shift == 1) {
-        while (readUint(1, bytesLeft) == 0) { shift++;}
+        while (readUint(fd, 1, bytesLeft) == 0) { shift++;}
     }
     sampleDepth -= shift;
 
     if(type == 0){  // Constant coding
-        int32_t s= readSignedInt(sampleDepth, bytesLeft);                                    // SUBFRAME_CONSTANT
-        for(int32_t i = 0; i < s_numOfOutSamples; i++){
-            s_samplesBuffer[ch][i] = s;
+        int32_t s= readSignedInt(fd, sampleDepth, bytesLeft);                                    // SUBFRAME_CONSTANT
+        for(int32_t i = 0; i < fd->numOfOutSamples; i++){
+            fd->samplesBuffer[ch][i] = s;
         }
     }
     else if (type == 1) {  // Verbatim coding
-        for (int32_t i = 0; i < s_numOfOutSamples; i++)
-            s_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft);                  // SUBFRAME_VERBATIM
+        for (int32_t i = 0; i < fd->numOfOutSamples; i++)
+            fd->samplesBuffer[ch][i] = readSignedInt(fd, sampleDepth, bytesLeft);                  // SUBFRAME_VERBATIM
     }
     else if (8 <= type && type <= 12){
-        ret = decodeFixedPredictionSubframe(type - 8, sampleDepth, ch, bytesLeft);           // SUBFRAME_FIXED
+        ret = decodeFixedPredictionSubframe(fd, type - 8, sampleDepth, ch, bytesLeft);           // SUBFRAME_FIXED
         if(ret) return ret;
     }
     else if (32 <= type && type <= 63){
-        ret = decodeLinearPredictiveCodingSubframe(type - 31, sampleDepth, ch, bytesLeft);   // SUBFRAME_LPC
+        ret = decodeLinearPredictiveCodingSubframe(fd, type - 31, sampleDepth, ch, bytesLeft);   // SUBFRAME_LPC
         if(ret) return ret;
     }
     else{
         return ERR_FLAC_RESERVED_SUB_TYPE;
     }
     if(shift>0){
-        for (int32_t i = 0; i < s_numOfOutSamples; i++){
-            s_samplesBuffer[ch][i] <<= shift;
+        for (int32_t i = 0; i < fd->numOfOutSamples; i++){
+            fd->samplesBuffer[ch][i] <<= shift;
         }
     }
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int8_t decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {     // SUBFRAME_FIXED
+int8_t decodeFixedPredictionSubframe(FLACDecoder_t* fd, uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {     // SUBFRAME_FIXED
 
     uint8_t ret = 0;
     for(uint8_t i = 0; i < predOrder; i++)
-        s_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * predictor order).
-    ret = decodeResiduals(predOrder, ch, bytesLeft);
-    if(ret) return ret;
-    coefs.clear(); coefs.shrink_to_fit();
-    if(predOrder == 0) coefs.resize(0);
-    if(predOrder == 1) coefs.push_back(1);  // FIXED_PREDICTION_COEFFICIENTS
-    if(predOrder == 2){coefs.push_back(2); coefs.push_back(-1);}
-    if(predOrder == 3){coefs.push_back(3); coefs.push_back(-3); coefs.push_back(1);}
-    if(predOrder == 4){coefs.push_back(4); coefs.push_back(-6); coefs.push_back(4); coefs.push_back(-1);}
+        fd->samplesBuffer[ch][i] = readSignedInt(fd, sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * predictor order).
     if(predOrder > 4) return ERR_FLAC_PREORDER_TOO_BIG; // Error: preorder > 4"
-    restoreLinearPrediction(ch, 0);
+    ret = decodeResiduals(fd, predOrder, ch, bytesLeft);
+    if(ret) return ret;
+    restoreFixedPrediction(fd, ch, predOrder, sampleDepth);
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeLinearPredictiveCodingSubframe(int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft){
+int8_t decodeLinearPredictiveCodingSubframe(FLACDecoder_t* fd, int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft){
 
     int8_t ret = 0;
     for (int32_t i = 0; i < lpcOrder; i++){
-        s_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * lpc order).
+        fd->samplesBuffer[ch][i] = readSignedInt(fd, sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * lpc order).
     }
-    int32_t precision = readUint(4, bytesLeft) + 1;                         // (Quantized linear predictor coefficients' precision in bits)-1 (1111 = invalid).
-    int32_t shift = readSignedInt(5, bytesLeft);                            // Quantized linear predictor coefficient shift needed in bits (NOTE: this number is signed two's-complement).
-    coefs.clear(); coefs.shrink_to_fit();
+    int32_t precision = readUint(fd, 4, bytesLeft) + 1;                         // (Quantized linear predictor coefficients' precision in bits)-1 (1111 = invalid).
+    int32_t shift = readSignedInt(fd, 5, bytesLeft);                            // Quantized linear predictor coefficient shift needed in bits (NOTE: this number is signed two's-complement).
     for (uint8_t i = 0; i < lpcOrder; i++){
-        coefs.push_back(readSignedInt(precision, bytesLeft));           // Unencoded predictor coefficients (n = qlp coeff precision * lpc order) (NOTE: the coefficients are signed two's-complement).
+        fd->coefs[i] = readSignedInt(fd, precision, bytesLeft);                 // Unencoded predictor coefficients (n = qlp coeff precision * lpc order) (NOTE: the coefficients are signed two's-complement).
     }
-    ret = decodeResiduals(lpcOrder, ch, bytesLeft);
+    ret = decodeResiduals(fd, lpcOrder, ch, bytesLeft);
     if(ret) return ret;
-    restoreLinearPrediction(ch, shift);
+    // sample * coefficient summed over the order must fit into 32 bit, otherwise take the 64 bit accumulator
+    uint8_t orderBits = 0;
+    while((1 << orderBits) < lpcOrder) orderBits++;
+    restoreLinearPrediction(fd, ch, lpcOrder, shift, sampleDepth + precision + orderBits > 32);
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeResiduals(uint8_t warmup, uint8_t ch, int32_t* bytesLeft) {
+int8_t decodeResiduals(FLACDecoder_t* fd, uint8_t warmup, uint8_t ch, int32_t* bytesLeft) {
 
-    int32_t method = readUint(2, bytesLeft);                          // Residual coding method:
+    int32_t method = readUint(fd, 2, bytesLeft);                          // Residual coding method:
                                                                   // 00 : partitioned Rice coding with 4-bit Rice parameter; RESIDUAL_CODING_METHOD_PARTITIONED_RICE follows
                                                                   // 01 : partitioned Rice coding with 5-bit Rice parameter; RESIDUAL_CODING_METHOD_PARTITIONED_RICE2 follows
                                                                   // 10-11 : reserved
     if (method >= 2) {return ERR_FLAC_RESERVED_RESIDUAL_CODING;}
     uint8_t paramBits = method == 0 ? 4 : 5;                      // RESIDUAL_CODING_METHOD_PARTITIONED_RICE || RESIDUAL_CODING_METHOD_PARTITIONED_RICE2
     int32_t escapeParam = ( method == 0 ? 0xF : 0x1F);
-    int32_t partitionOrder = readUint(4, bytesLeft);                  // Partition order
+    int32_t partitionOrder = readUint(fd, 4, bytesLeft);                  // Partition order
     int32_t numPartitions = 1 << partitionOrder;                      // There will be 2^order partitions.
 
-    if (s_numOfOutSamples % numPartitions != 0){
+    if (fd->numOfOutSamples % numPartitions != 0){
         return ERR_FLAC_WRONG_RICE_PARTITION_NR;                  //Error: Block size not divisible by number of Rice partitions
     }
-    int32_t partitionSize = s_numOfOutSamples / numPartitions;
+    int32_t partitionSize = fd->numOfOutSamples / numPartitions;
 
     for (int32_t i = 0; i < numPartitions; i++) {
         int32_t start = i * partitionSize + (i == 0 ? warmup : 0);
         int32_t end = (i + 1) * partitionSize;
 
-        int32_t param = readUint(paramBits, bytesLeft);
+        int32_t param = readUint(fd, paramBits, bytesLeft);
         if (param < escapeParam) {
-            for (int32_t j = start; j < end; j++){
-                if(s_f_bitReaderError) break;
-                s_samplesBuffer[ch][j] = readRiceSignedInt(param, bytesLeft);
-            }
+            if(readRicePartition(fd, fd->samplesBuffer[ch] + start, end - start, param, bytesLeft)) break;
         }
         else {
-            int32_t numBits = readUint(5, bytesLeft);                 // Escape code, meaning the partition is in unencoded binary form using n bits per sample; n follows as a 5-bit number.
+            int32_t numBits = readUint(fd, 5, bytesLeft);                 // Escape code, meaning the partition is in unencoded binary form using n bits per sample; n follows as a 5-bit number.
             for (int32_t j = start; j < end; j++){
-                if(s_f_bitReaderError) break;
-                s_samplesBuffer[ch][j] = readSignedInt(numBits, bytesLeft);
+                if(fd->f_bitReaderError) break;
+                fd->samplesBuffer[ch][j] = readSignedInt(fd, numBits, bytesLeft);
             }
         }
     }
-    if(s_f_bitReaderError) return ERR_FLAC_BITREADER_UNDERFLOW;
+    if(fd->f_bitReaderError) return ERR_FLAC_BITREADER_UNDERFLOW;
     return ERR_FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void restoreLinearPrediction(uint8_t ch, uint8_t shift) {
-
-    for (int32_t i = coefs.size(); i < s_numOfOutSamples; i++) {
-        int32_t sum = 0;
-        for (int32_t j = 0; j < coefs.size(); j++){
-            sum += s_samplesBuffer[ch][i - 1 - j] * coefs[j];
+template <int ORDER, typename ACC>
+inline void lpcRestore(int32_t* s, const int32_t* coefs, int32_t n, uint8_t shift) {
+    // s[i] += sum(coefs[j] * s[i - 1 - j]) >> shift, ACC is int32_t or int64_t (high bit depth)
+    int32_t c[ORDER];
+    for(int j = 0; j < ORDER; j++) c[j] = coefs[j];
+    for(int32_t i = ORDER; i < n; i++) {
+        ACC sum = 0;
+        for(int j = 0; j < ORDER; j++) sum += (ACC)c[j] * s[i - 1 - j];
+        s[i] += (int32_t)(sum >> shift);
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+void restoreFixedPrediction(FLACDecoder_t* fd, uint8_t ch, uint8_t order, uint8_t sampleDepth) {
+    // FIXED_PREDICTION_COEFFICIENTS {1}, {2, -1}, {3, -3, 1}, {4, -6, 4, -1}
+    int32_t* s = fd->samplesBuffer[ch];
+    int32_t  n = fd->numOfOutSamples;
+    if(sampleDepth + order > 30) { // the sum of the coefficients is up to 16 (order 4), this could overflow 32 bit
+        static const int32_t fixedCoefs[5][4] = {{0}, {1}, {2, -1}, {3, -3, 1}, {4, -6, 4, -1}};
+        switch(order){
+            case 1: lpcRestore<1, int64_t>(s, fixedCoefs[1], n, 0); break;
+            case 2: lpcRestore<2, int64_t>(s, fixedCoefs[2], n, 0); break;
+            case 3: lpcRestore<3, int64_t>(s, fixedCoefs[3], n, 0); break;
+            case 4: lpcRestore<4, int64_t>(s, fixedCoefs[4], n, 0); break;
         }
-        s_samplesBuffer[ch][i] += (sum >> shift);
+        return;
     }
+    switch(order){
+        case 1: for(int32_t i = 1; i < n; i++) s[i] += s[i - 1]; break;
+        case 2: for(int32_t i = 2; i < n; i++) s[i] += 2 * s[i - 1] - s[i - 2]; break;
+        case 3: for(int32_t i = 3; i < n; i++) s[i] += 3 * (s[i - 1] - s[i - 2]) + s[i - 3]; break;
+        case 4: for(int32_t i = 4; i < n; i++) s[i] += 4 * (s[i - 1] + s[i - 3]) - 6 * s[i - 2] - s[i - 4]; break;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+#define LPC_CASES(ACC) \
+    LPC_CASE( 1, ACC) LPC_CASE( 2, ACC) LPC_CASE( 3, ACC) LPC_CASE( 4, ACC) LPC_CASE( 5, ACC) LPC_CASE( 6, ACC) \
+    LPC_CASE( 7, ACC) LPC_CASE( 8, ACC) LPC_CASE( 9, ACC) LPC_CASE(10, ACC) LPC_CASE(11, ACC) LPC_CASE(12, ACC) \
+    LPC_CASE(13, ACC) LPC_CASE(14, ACC) LPC_CASE(15, ACC) LPC_CASE(16, ACC) LPC_CASE(17, ACC) LPC_CASE(18, ACC) \
+    LPC_CASE(19, ACC) LPC_CASE(20, ACC) LPC_CASE(21, ACC) LPC_CASE(22, ACC) LPC_CASE(23, ACC) LPC_CASE(24, ACC) \
+    LPC_CASE(25, ACC) LPC_CASE(26, ACC) LPC_CASE(27, ACC) LPC_CASE(28, ACC) LPC_CASE(29, ACC) LPC_CASE(30, ACC) \
+    LPC_CASE(31, ACC) LPC_CASE(32, ACC)
+#define LPC_CASE(N, ACC) case N: lpcRestore<N, ACC>(s, fd->coefs, n, shift); break;
+
+void restoreLinearPrediction(FLACDecoder_t* fd, uint8_t ch, uint8_t order, uint8_t shift, bool wide) {
+    // the order is known at compile time in every kernel, so the inner loop is completely unrolled
+    int32_t* s = fd->samplesBuffer[ch];
+    int32_t  n = fd->numOfOutSamples;
+    if(wide) { switch(order) { LPC_CASES(int64_t) } }
+    else     { switch(order) { LPC_CASES(int32_t) } }
 }
+#undef LPC_CASE
+#undef LPC_CASES
 //----------------------------------------------------------------------------------------------------------------------
 int32_t FLAC_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact){
     int32_t result = 0;  // seek for str in buffer or in header up to baselen, not nullterninated
-    if (strlen(str) > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
-    for (int32_t i = 0; i < baselen - strlen(str); i++){
+    int32_t len = strlen(str);
+    if (len > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
+    for (int32_t i = 0; i < baselen - len; i++){
         result = i;
-        for (int32_t j = 0; j < strlen(str) + exact; j++){
+        for (int32_t j = 0; j < len + exact; j++){
             if (*(base + i + j) != *(str + j)){
                 result = -1;
                 break;
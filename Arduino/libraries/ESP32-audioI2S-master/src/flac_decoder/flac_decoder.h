@@ -18,6 +18,7 @@
 
 #include "Arduino.h"
 #include <vector>
+#include "../ogg_demuxer/ogg_demuxer.h"
 using namespace std;
 
 #define MAX_CHANNELS 2
@@ -148,40 +149,93 @@ typedef struct FLACFrameHeader_t {
 
 }FLACFrameHeader_t;
 
-int32_t          FLACFindSyncWord(unsigned char* buf, int32_t nBytes);
+typedef struct FLACDecoder_t {    // complete state of one decoder instance, see FLACDecoder_AllocateBuffers()
+    FLACFrameHeader_t   frameHeader;
+    FLACMetadataBlock_t metadataBlock;
+    vector<uint32_t>    blockPicItem;
+    uint64_t            bitBuffer = 0;
+    uint32_t            bitrate = 0;
+    uint32_t            blockPicLenUntilFrameEnd = 0;
+    uint32_t            currentFilePos = 0;
+    uint32_t            blockPicPos = 0;
+    uint32_t            blockPicLen = 0;
+    uint32_t            audioDataStart = 0;
+    uint32_t            segmLenTmp = 0;
+    int32_t             coefs[32] = {0};       // LPC coefficients of the current subframe
+    uint16_t            segmTable[256] = {0};  // packet lengths of the current Ogg page
+    oggCrc_t            oggCrc = {};           // CRC of the current Ogg page if it is bigger than the input window
+    int32_t             remainBlockPicLen = 0;
+    int32_t             nBytes = 0;
+    int32_t             sbl = 0;
+    uint32_t            ditherSeed = 1;        // LCG state for the TPDF dither, only used if bitsPerSample > outputBits
+    uint16_t            numOfOutSamples = 0;
+    uint16_t            validSamples = 0;
+    uint16_t            rIndex = 0;
+    uint16_t            offset = 0;
+    int16_t             segmTableRdPtr = -1;
+    uint8_t             status = 0;
+    uint8_t             bitBufferLen = 0;
+    uint8_t             pageSegments = 0;
+    uint8_t             segmTableSize = 0;
+    uint8_t             pageNr = 0;
+    uint8_t             outputBits = 16;       // 16: int16_t samples, 32: left justified int32_t samples in outbuf
+    uint8_t*            inptr = NULL;
+    float               compressionRatio = 0;
+    char                streamTitle[256] = {0};
+    char*               vendorString = NULL;
+    int32_t**           samplesBuffer = NULL;
+    bool                f_parseOgg = false;
+    bool                f_bitReaderError = false;
+    bool                f_newStreamtitle = false;
+    bool                f_firstCall = true;
+    bool                f_oggWrapper = false;
+    bool                f_continuedPage = false;
+    bool                f_lastPacketContinues = false;
+    bool                f_lastMetaDataBlock = false;
+    bool                f_newMetadataBlockPicture = false;
+}FLACDecoder_t;
+
+int32_t          FLACFindSyncWord(FLACDecoder_t* fd, unsigned char* buf, int32_t nBytes);
 boolean          FLACFindMagicWord(unsigned char* buf, int32_t nBytes);
-char*            FLACgetStreamTitle();
-int32_t          FLACparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
-vector<uint32_t> FLACgetMetadataBlockPicture();
+char*            FLACgetStreamTitle(FLACDecoder_t* fd);
+int32_t          FLACparseOGG(FLACDecoder_t* fd, uint8_t* inbuf, int32_t* bytesLeft);
+vector<uint32_t> FLACgetMetadataBlockPicture(FLACDecoder_t* fd);
 int32_t          parseFlacFirstPacket(uint8_t* inbuf, int16_t nBytes);
-int32_t          parseMetaDataBlockHeader(uint8_t* inbuf, int16_t nBytes);
-bool             FLACDecoder_AllocateBuffers(void);
-void             FLACDecoder_setDefaults();
-void             FLACDecoder_ClearBuffer();
-void             FLACDecoder_FreeBuffers();
-void             FLACSetRawBlockParams(uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength);
-void             FLACDecoderReset();
-int8_t           FLACDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-int8_t           FLACDecodeNative(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-int8_t           flacDecodeFrame(uint8_t* inbuf, int32_t* bytesLeft);
-uint16_t         FLACGetOutputSamps();
-uint64_t         FLACGetTotoalSamplesInStream();
-uint8_t          FLACGetBitsPerSample();
-uint8_t          FLACGetChannels();
-uint32_t         FLACGetSampRate();
-uint32_t         FLACGetBitRate();
-uint32_t         FLACGetAudioDataStart();
-uint32_t         FLACGetAudioFileDuration();
-uint32_t         readUint(uint8_t nBits, int32_t* bytesLeft);
-int32_t          readSignedInt(int32_t nBits, int32_t* bytesLeft);
-int64_t          readRiceSignedInt(uint8_t param, int32_t* bytesLeft);
-void             alignToByte();
-int8_t           decodeSubframes(int32_t* bytesLeft);
-int8_t           decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
-int8_t           decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
-int8_t           decodeLinearPredictiveCodingSubframe(int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
-int8_t           decodeResiduals(uint8_t warmup, uint8_t ch, int32_t* bytesLeft);
-void             restoreLinearPrediction(uint8_t ch, uint8_t shift);
+int32_t          parseMetaDataBlockHeader(FLACDecoder_t* fd, uint8_t* inbuf, int16_t nBytes);
+FLACDecoder_t*   FLACDecoder_AllocateBuffers(void);
+void             FLACDecoder_setDefaults(FLACDecoder_t* fd);
+void             FLACDecoder_ClearBuffer(FLACDecoder_t* fd);
+void             FLACDecoder_FreeBuffers(FLACDecoder_t* fd);
+void             FLACSetRawBlockParams(FLACDecoder_t* fd, uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength);
+void             FLACDecoderReset(FLACDecoder_t* fd);
+void             FLACSetOutputBits(FLACDecoder_t* fd, uint8_t bits);
+int8_t           FLACDecode(FLACDecoder_t* fd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+int8_t           flacDecode(FLACDecoder_t* fd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+int8_t           FLACDecodeNative(FLACDecoder_t* fd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+int8_t           flacDecodeBlock(FLACDecoder_t* fd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+int8_t           flacDecodeFrame(FLACDecoder_t* fd, uint8_t* inbuf, int32_t* bytesLeft);
+uint16_t         FLACGetOutputSamps(FLACDecoder_t* fd);
+uint64_t         FLACGetTotoalSamplesInStream(FLACDecoder_t* fd);
+uint8_t          FLACGetBitsPerSample(FLACDecoder_t* fd);
+uint8_t          FLACGetChannels(FLACDecoder_t* fd);
+uint32_t         FLACGetSampRate(FLACDecoder_t* fd);
+uint32_t         FLACGetBitRate(FLACDecoder_t* fd);
+uint32_t         FLACGetAudioDataStart(FLACDecoder_t* fd);
+uint32_t         FLACGetAudioFileDuration(FLACDecoder_t* fd);
+void             refillBits(FLACDecoder_t* fd, uint64_t& cache, uint8_t& len, int32_t* bytesLeft);
+void             releaseBits(FLACDecoder_t* fd, int32_t* bytesLeft);
+uint32_t         readUint(FLACDecoder_t* fd, uint8_t nBits, int32_t* bytesLeft);
+int32_t          readSignedInt(FLACDecoder_t* fd, int32_t nBits, int32_t* bytesLeft);
+int64_t          readRiceSignedInt(FLACDecoder_t* fd, uint8_t param, int32_t* bytesLeft);
+int8_t           readRicePartition(FLACDecoder_t* fd, int32_t* out, int32_t count, uint8_t param, int32_t* bytesLeft);
+void             alignToByte(FLACDecoder_t* fd);
+int8_t           decodeSubframes(FLACDecoder_t* fd, int32_t* bytesLeft);
+int8_t           decodeSubframe(FLACDecoder_t* fd, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
+int8_t           decodeFixedPredictionSubframe(FLACDecoder_t* fd, uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
+int8_t           decodeLinearPredictiveCodingSubframe(FLACDecoder_t* fd, int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
+int8_t           decodeResiduals(FLACDecoder_t* fd, uint8_t warmup, uint8_t ch, int32_t* bytesLeft);
+void             restoreFixedPrediction(FLACDecoder_t* fd, uint8_t ch, uint8_t order, uint8_t sampleDepth);
+void             restoreLinearPrediction(FLACDecoder_t* fd, uint8_t ch, uint8_t order, uint8_t shift, bool wide);
 int32_t          FLAC_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
 char*            flac_x_ps_malloc(uint16_t len);
 char*            flac_x_ps_calloc(uint16_t len, uint8_t size);
@@ -37,399 +37,773 @@ const uint8_t  m_NGRANS_MPEG2           =1;
 const uint32_t m_SQRTHALF               =0x5a82799a;  // sqrt(0.5) in Q31 format
 
 
-MP3FrameInfo_t *m_MP3FrameInfo;
-SFBandTable_t m_SFBandTable;
-StereoMode_t m_sMode;  /* mono/stereo mode */
-MPEGVersion_t m_MPEGVersion;  /* version ID */
-FrameHeader_t *m_FrameHeader;
-SideInfoSub_t m_SideInfoSub[m_MAX_NGRAN][m_MAX_NCHAN];
-SideInfo_t *m_SideInfo;
-CriticalBandInfo_t m_CriticalBandInfo[m_MAX_NCHAN];  /* filled in dequantizer, used in joint stereo reconstruction */
-DequantInfo_t *m_DequantInfo;
-HuffmanInfo_t *m_HuffmanInfo;
-IMDCTInfo_t *m_IMDCTInfo;
-ScaleFactorInfoSub_t m_ScaleFactorInfoSub[m_MAX_NGRAN][m_MAX_NCHAN];
-ScaleFactorJS_t *m_ScaleFactorJS;
-SubbandInfo_t *m_SubbandInfo;
-MP3DecInfo_t *m_MP3DecInfo;
-
-const uint16_t huffTable[4242] PROGMEM = {
-    /* huffTable01[9] */
-    0xf003, 0x3112, 0x3101, 0x2011, 0x2011, 0x1000, 0x1000, 0x1000, 0x1000,
-    /* huffTable02[65] */
-    0xf006, 0x6222, 0x6201, 0x5212, 0x5212, 0x5122, 0x5122, 0x5021, 0x5021, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    /* huffTable03[65] */
-    0xf006, 0x6222, 0x6201, 0x5212, 0x5212, 0x5122, 0x5122, 0x5021, 0x5021, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2101, 0x2101, 0x2101,
-    0x2101, 0x2101, 0x2101, 0x2101, 0x2101, 0x2101, 0x2101, 0x2101, 0x2101, 0x2101, 0x2101, 0x2101,
-    0x2101, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    /* huffTable05[257] */
-    0xf008, 0x8332, 0x8322, 0x7232, 0x7232, 0x6132, 0x6132, 0x6132, 0x6132, 0x7312, 0x7312, 0x7301,
-    0x7301, 0x7031, 0x7031, 0x7222, 0x7222, 0x6212, 0x6212, 0x6212, 0x6212, 0x6122, 0x6122, 0x6122,
-    0x6122, 0x6201, 0x6201, 0x6201, 0x6201, 0x6021, 0x6021, 0x6021, 0x6021, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    /* huffTable06[129] */
-    0xf007, 0x7332, 0x7301, 0x6322, 0x6322, 0x6232, 0x6232, 0x6031, 0x6031, 0x5312, 0x5312, 0x5312,
-    0x5312, 0x5132, 0x5132, 0x5132, 0x5132, 0x5222, 0x5222, 0x5222, 0x5222, 0x5201, 0x5201, 0x5201,
-    0x5201, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4122, 0x4122, 0x4122,
-    0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x4021, 0x4021, 0x4021, 0x4021, 0x4021, 0x4021, 0x4021,
-    0x4021, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000,
-    0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000,
-    /* huffTable07[110] */
-    0xf006, 0x0041, 0x0052, 0x005b, 0x0060, 0x0063, 0x0068, 0x006b, 0x6212, 0x5122, 0x5122, 0x6201,
-    0x6021, 0x4112, 0x4112, 0x4112, 0x4112, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0xf004, 0x4552, 0x4542, 0x4452, 0x4352, 0x3532, 0x3532,
-    0x3442, 0x3442, 0x3522, 0x3522, 0x3252, 0x3252, 0x2512, 0x2512, 0x2512, 0x2512, 0xf003, 0x2152,
-    0x2152, 0x3501, 0x3432, 0x2051, 0x2051, 0x3342, 0x3332, 0xf002, 0x2422, 0x2242, 0x1412, 0x1412,
-    0xf001, 0x1142, 0x1041, 0xf002, 0x2401, 0x2322, 0x2232, 0x2301, 0xf001, 0x1312, 0x1132, 0xf001,
-    0x1031, 0x1222,
-    /* huffTable08[280] */
-    0xf008, 0x0101, 0x010a, 0x010f, 0x8512, 0x8152, 0x0112, 0x0115, 0x8422, 0x8242, 0x8412, 0x7142,
-    0x7142, 0x8401, 0x8041, 0x8322, 0x8232, 0x8312, 0x8132, 0x8301, 0x8031, 0x6222, 0x6222, 0x6222,
-    0x6222, 0x6201, 0x6201, 0x6201, 0x6201, 0x6021, 0x6021, 0x6021, 0x6021, 0x4212, 0x4212, 0x4212,
-    0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212,
-    0x4212, 0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x4122,
-    0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112,
-    0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x2112, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0xf003, 0x3552, 0x3452, 0x2542, 0x2542, 0x1352, 0x1352,
-    0x1352, 0x1352, 0xf002, 0x2532, 0x2442, 0x1522, 0x1522, 0xf001, 0x1252, 0x1501, 0xf001, 0x1432,
-    0x1342, 0xf001, 0x1051, 0x1332,
-    /* huffTable09[93] */
-    0xf006, 0x0041, 0x004a, 0x004f, 0x0052, 0x0057, 0x005a, 0x6412, 0x6142, 0x6322, 0x6232, 0x5312,
-    0x5312, 0x5132, 0x5132, 0x6301, 0x6031, 0x5222, 0x5222, 0x5201, 0x5201, 0x4212, 0x4212, 0x4212,
-    0x4212, 0x4122, 0x4122, 0x4122, 0x4122, 0x4021, 0x4021, 0x4021, 0x4021, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3000, 0x3000, 0x3000,
-    0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0xf003, 0x3552, 0x3542, 0x2532, 0x2532, 0x2352, 0x2352,
-    0x3452, 0x3501, 0xf002, 0x2442, 0x2522, 0x2252, 0x2512, 0xf001, 0x1152, 0x1432, 0xf002, 0x1342,
-    0x1342, 0x2051, 0x2401, 0xf001, 0x1422, 0x1242, 0xf001, 0x1332, 0x1041,
-    /* huffTable10[320] */
-    0xf008, 0x0101, 0x010a, 0x010f, 0x0118, 0x011b, 0x0120, 0x0125, 0x8712, 0x8172, 0x012a, 0x012d,
-    0x0132, 0x8612, 0x8162, 0x8061, 0x0137, 0x013a, 0x013d, 0x8412, 0x8142, 0x8041, 0x8322, 0x8232,
-    0x8301, 0x7312, 0x7312, 0x7132, 0x7132, 0x7031, 0x7031, 0x7222, 0x7222, 0x6212, 0x6212, 0x6212,
-    0x6212, 0x6122, 0x6122, 0x6122, 0x6122, 0x6201, 0x6201, 0x6201, 0x6201, 0x6021, 0x6021, 0x6021,
-    0x6021, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112,
-    0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0xf003, 0x3772, 0x3762, 0x3672, 0x3752, 0x3572, 0x3662,
-    0x2742, 0x2742, 0xf002, 0x2472, 0x2652, 0x2562, 0x2732, 0xf003, 0x2372, 0x2372, 0x2642, 0x2642,
-    0x3552, 0x3452, 0x2362, 0x2362, 0xf001, 0x1722, 0x1272, 0xf002, 0x2462, 0x2701, 0x1071, 0x1071,
-    0xf002, 0x1262, 0x1262, 0x2542, 0x2532, 0xf002, 0x1601, 0x1601, 0x2352, 0x2442, 0xf001, 0x1632,
-    0x1622, 0xf002, 0x2522, 0x2252, 0x1512, 0x1512, 0xf002, 0x1152, 0x1152, 0x2432, 0x2342, 0xf001,
-    0x1501, 0x1051, 0xf001, 0x1422, 0x1242, 0xf001, 0x1332, 0x1401,
-    /* huffTable11[296] */
-    0xf008, 0x0101, 0x0106, 0x010f, 0x0114, 0x0117, 0x8722, 0x8272, 0x011c, 0x7172, 0x7172, 0x8712,
-    0x8071, 0x8632, 0x8362, 0x8061, 0x011f, 0x0122, 0x8512, 0x7262, 0x7262, 0x8622, 0x8601, 0x7612,
-    0x7612, 0x7162, 0x7162, 0x8152, 0x8432, 0x8051, 0x0125, 0x8422, 0x8242, 0x8412, 0x8142, 0x8401,
-    0x8041, 0x7322, 0x7322, 0x7232, 0x7232, 0x6312, 0x6312, 0x6312, 0x6312, 0x6132, 0x6132, 0x6132,
-    0x6132, 0x7301, 0x7301, 0x7031, 0x7031, 0x6222, 0x6222, 0x6222, 0x6222, 0x5122, 0x5122, 0x5122,
-    0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212,
-    0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x5201, 0x5201, 0x5201,
-    0x5201, 0x5201, 0x5201, 0x5201, 0x5201, 0x5021, 0x5021, 0x5021, 0x5021, 0x5021, 0x5021, 0x5021,
-    0x5021, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000,
-    0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0xf002, 0x2772, 0x2762, 0x2672, 0x2572, 0xf003, 0x2662,
-    0x2662, 0x2742, 0x2742, 0x2472, 0x2472, 0x3752, 0x3552, 0xf002, 0x2652, 0x2562, 0x1732, 0x1732,
-    0xf001, 0x1372, 0x1642, 0xf002, 0x2542, 0x2452, 0x2532, 0x2352, 0xf001, 0x1462, 0x1701, 0xf001,
-    0x1442, 0x1522, 0xf001, 0x1252, 0x1501, 0xf001, 0x1342, 0x1332,
-    /* huffTable12[185] */
-    0xf007, 0x0081, 0x008a, 0x008f, 0x0092, 0x0097, 0x009a, 0x009d, 0x00a2, 0x00a5, 0x00a8, 0x7622,
-    0x7262, 0x7162, 0x00ad, 0x00b0, 0x00b3, 0x7512, 0x7152, 0x7432, 0x7342, 0x00b6, 0x7422, 0x7242,
-    0x7412, 0x6332, 0x6332, 0x6142, 0x6142, 0x6322, 0x6322, 0x6232, 0x6232, 0x7041, 0x7301, 0x6031,
-    0x6031, 0x5312, 0x5312, 0x5312, 0x5312, 0x5132, 0x5132, 0x5132, 0x5132, 0x5222, 0x5222, 0x5222,
-    0x5222, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4212, 0x4122, 0x4122, 0x4122,
-    0x4122, 0x4122, 0x4122, 0x4122, 0x4122, 0x5201, 0x5201, 0x5201, 0x5201, 0x5021, 0x5021, 0x5021,
-    0x5021, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3101,
-    0x3101, 0x3101, 0x3101, 0x3101, 0x3101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0xf003, 0x3772, 0x3762,
-    0x2672, 0x2672, 0x2752, 0x2752, 0x2572, 0x2572, 0xf002, 0x2662, 0x2742, 0x2472, 0x2562, 0xf001,
-    0x1652, 0x1732, 0xf002, 0x2372, 0x2552, 0x1722, 0x1722, 0xf001, 0x1272, 0x1642, 0xf001, 0x1462,
-    0x1712, 0xf002, 0x1172, 0x1172, 0x2701, 0x2071, 0xf001, 0x1632, 0x1362, 0xf001, 0x1542, 0x1452,
-    0xf002, 0x1442, 0x1442, 0x2601, 0x2501, 0xf001, 0x1612, 0x1061, 0xf001, 0x1532, 0x1352, 0xf001,
-    0x1522, 0x1252, 0xf001, 0x1051, 0x1401,
-    /* huffTable13[497] */
-    0xf006, 0x0041, 0x0082, 0x00c3, 0x00e4, 0x0105, 0x0116, 0x011f, 0x0130, 0x0139, 0x013e, 0x0143,
-    0x0146, 0x6212, 0x6122, 0x6201, 0x6021, 0x4112, 0x4112, 0x4112, 0x4112, 0x4101, 0x4101, 0x4101,
-    0x4101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0xf006, 0x0108, 0x0111, 0x011a, 0x0123, 0x012c, 0x0131,
-    0x0136, 0x013f, 0x0144, 0x0147, 0x014c, 0x0151, 0x0156, 0x015b, 0x6f12, 0x61f2, 0x60f1, 0x0160,
-    0x0163, 0x0166, 0x62e2, 0x0169, 0x6e12, 0x61e2, 0x016c, 0x016f, 0x0172, 0x0175, 0x0178, 0x017b,
-    0x66c2, 0x6d32, 0x017e, 0x6d22, 0x62d2, 0x6d12, 0x67b2, 0x0181, 0x0184, 0x63c2, 0x0187, 0x6b42,
-    0x51d2, 0x51d2, 0x6d01, 0x60d1, 0x6a82, 0x68a2, 0x6c42, 0x64c2, 0x6b62, 0x66b2, 0x5c32, 0x5c32,
-    0x5c22, 0x5c22, 0x52c2, 0x52c2, 0x5b52, 0x5b52, 0x65b2, 0x6982, 0x5c12, 0x5c12, 0xf006, 0x51c2,
-    0x51c2, 0x6892, 0x6c01, 0x50c1, 0x50c1, 0x64b2, 0x6a62, 0x66a2, 0x6972, 0x5b32, 0x5b32, 0x53b2,
-    0x53b2, 0x6882, 0x6a52, 0x5b22, 0x5b22, 0x65a2, 0x6962, 0x54a2, 0x54a2, 0x6872, 0x6782, 0x5492,
-    0x5492, 0x6772, 0x6672, 0x42b2, 0x42b2, 0x42b2, 0x42b2, 0x4b12, 0x4b12, 0x4b12, 0x4b12, 0x41b2,
-    0x41b2, 0x41b2, 0x41b2, 0x5b01, 0x5b01, 0x50b1, 0x50b1, 0x5692, 0x5692, 0x5a42, 0x5a42, 0x5a32,
-    0x5a32, 0x53a2, 0x53a2, 0x5952, 0x5952, 0x5592, 0x5592, 0x4a22, 0x4a22, 0x4a22, 0x4a22, 0x42a2,
-    0x42a2, 0x42a2, 0x42a2, 0xf005, 0x4a12, 0x4a12, 0x41a2, 0x41a2, 0x5a01, 0x5862, 0x40a1, 0x40a1,
-    0x5682, 0x5942, 0x4392, 0x4392, 0x5932, 0x5852, 0x5582, 0x5762, 0x4922, 0x4922, 0x4292, 0x4292,
-    0x5752, 0x5572, 0x4832, 0x4832, 0x4382, 0x4382, 0x5662, 0x5742, 0x5472, 0x5652, 0x5562, 0x5372,
-    0xf005, 0x3912, 0x3912, 0x3912, 0x3912, 0x3192, 0x3192, 0x3192, 0x3192, 0x4901, 0x4901, 0x4091,
-    0x4091, 0x4842, 0x4842, 0x4482, 0x4482, 0x4272, 0x4272, 0x5642, 0x5462, 0x3822, 0x3822, 0x3822,
-    0x3822, 0x3282, 0x3282, 0x3282, 0x3282, 0x3812, 0x3812, 0x3812, 0x3812, 0xf004, 0x4732, 0x4722,
-    0x3712, 0x3712, 0x3172, 0x3172, 0x4552, 0x4701, 0x4071, 0x4632, 0x4362, 0x4542, 0x4452, 0x4622,
-    0x4262, 0x4532, 0xf003, 0x2182, 0x2182, 0x3801, 0x3081, 0x3612, 0x3162, 0x3601, 0x3061, 0xf004,
-    0x4352, 0x4442, 0x3522, 0x3522, 0x3252, 0x3252, 0x3501, 0x3501, 0x2512, 0x2512, 0x2512, 0x2512,
-    0x2152, 0x2152, 0x2152, 0x2152, 0xf003, 0x3432, 0x3342, 0x3051, 0x3422, 0x3242, 0x3332, 0x2412,
-    0x2412, 0xf002, 0x1142, 0x1142, 0x2401, 0x2041, 0xf002, 0x2322, 0x2232, 0x1312, 0x1312, 0xf001,
-    0x1132, 0x1301, 0xf001, 0x1031, 0x1222, 0xf003, 0x0082, 0x008b, 0x008e, 0x0091, 0x0094, 0x0097,
-    0x3ce2, 0x3dd2, 0xf003, 0x0093, 0x3eb2, 0x3be2, 0x3f92, 0x39f2, 0x3ae2, 0x3db2, 0x3bd2, 0xf003,
-    0x3f82, 0x38f2, 0x3cc2, 0x008d, 0x3e82, 0x0090, 0x27f2, 0x27f2, 0xf003, 0x2ad2, 0x2ad2, 0x3da2,
-    0x3cb2, 0x3bc2, 0x36f2, 0x2f62, 0x2f62, 0xf002, 0x28e2, 0x2f52, 0x2d92, 0x29d2, 0xf002, 0x25f2,
-    0x27e2, 0x2ca2, 0x2bb2, 0xf003, 0x2f42, 0x2f42, 0x24f2, 0x24f2, 0x3ac2, 0x36e2, 0x23f2, 0x23f2,
-    0xf002, 0x1f32, 0x1f32, 0x2d82, 0x28d2, 0xf001, 0x1f22, 0x12f2, 0xf002, 0x2e62, 0x2c92, 0x1f01,
-    0x1f01, 0xf002, 0x29c2, 0x2e52, 0x1ba2, 0x1ba2, 0xf002, 0x2d72, 0x27d2, 0x1e42, 0x1e42, 0xf002,
-    0x28c2, 0x26d2, 0x1e32, 0x1e32, 0xf002, 0x19b2, 0x19b2, 0x2b92, 0x2aa2, 0xf001, 0x1ab2, 0x15e2,
-    0xf001, 0x14e2, 0x1c82, 0xf001, 0x1d62, 0x13e2, 0xf001, 0x1e22, 0x1e01, 0xf001, 0x10e1, 0x1d52,
-    0xf001, 0x15d2, 0x1c72, 0xf001, 0x17c2, 0x1d42, 0xf001, 0x1b82, 0x18b2, 0xf001, 0x14d2, 0x1a92,
-    0xf001, 0x19a2, 0x1c62, 0xf001, 0x13d2, 0x1b72, 0xf001, 0x1c52, 0x15c2, 0xf001, 0x1992, 0x1a72,
-    0xf001, 0x17a2, 0x1792, 0xf003, 0x0023, 0x3df2, 0x2de2, 0x2de2, 0x1ff2, 0x1ff2, 0x1ff2, 0x1ff2,
-    0xf001, 0x1fe2, 0x1fd2, 0xf001, 0x1ee2, 0x1fc2, 0xf001, 0x1ed2, 0x1fb2, 0xf001, 0x1bf2, 0x1ec2,
-    0xf002, 0x1cd2, 0x1cd2, 0x2fa2, 0x29e2, 0xf001, 0x1af2, 0x1dc2, 0xf001, 0x1ea2, 0x1e92, 0xf001,
-    0x1f72, 0x1e72, 0xf001, 0x1ef2, 0x1cf2,
-    /* huffTable15[580] */
-    0xf008, 0x0101, 0x0122, 0x0143, 0x0154, 0x0165, 0x0176, 0x017f, 0x0188, 0x0199, 0x01a2, 0x01ab,
-    0x01b4, 0x01bd, 0x01c2, 0x01cb, 0x01d4, 0x01d9, 0x01de, 0x01e3, 0x01e8, 0x01ed, 0x01f2, 0x01f7,
-    0x01fc, 0x0201, 0x0204, 0x0207, 0x020a, 0x020f, 0x0212, 0x0215, 0x021a, 0x021d, 0x0220, 0x8192,
-    0x0223, 0x0226, 0x0229, 0x022c, 0x022f, 0x8822, 0x8282, 0x8812, 0x8182, 0x0232, 0x0235, 0x0238,
-    0x023b, 0x8722, 0x8272, 0x8462, 0x8712, 0x8552, 0x8172, 0x023e, 0x8632, 0x8362, 0x8542, 0x8452,
-    0x8622, 0x8262, 0x8612, 0x0241, 0x8532, 0x7162, 0x7162, 0x8352, 0x8442, 0x7522, 0x7522, 0x7252,
-    0x7252, 0x7512, 0x7512, 0x7152, 0x7152, 0x8501, 0x8051, 0x7432, 0x7432, 0x7342, 0x7342, 0x7422,
-    0x7422, 0x7242, 0x7242, 0x7332, 0x7332, 0x6142, 0x6142, 0x6142, 0x6142, 0x7412, 0x7412, 0x7401,
-    0x7401, 0x6322, 0x6322, 0x6322, 0x6322, 0x6232, 0x6232, 0x6232, 0x6232, 0x7041, 0x7041, 0x7301,
-    0x7301, 0x6312, 0x6312, 0x6312, 0x6312, 0x6132, 0x6132, 0x6132, 0x6132, 0x6031, 0x6031, 0x6031,
-    0x6031, 0x5222, 0x5222, 0x5222, 0x5222, 0x5222, 0x5222, 0x5222, 0x5222, 0x5212, 0x5212, 0x5212,
-    0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122,
-    0x5122, 0x5201, 0x5201, 0x5201, 0x5201, 0x5201, 0x5201, 0x5201, 0x5201, 0x5021, 0x5021, 0x5021,
-    0x5021, 0x5021, 0x5021, 0x5021, 0x5021, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112, 0x3112,
-    0x3112, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101,
-    0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011,
-    0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x3000, 0x3000, 0x3000,
-    0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000,
-    0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000,
-    0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0xf005, 0x5ff2, 0x5fe2, 0x5ef2, 0x5fd2, 0x4ee2, 0x4ee2,
-    0x5df2, 0x5fc2, 0x5cf2, 0x5ed2, 0x5de2, 0x5fb2, 0x4bf2, 0x4bf2, 0x5ec2, 0x5ce2, 0x4dd2, 0x4dd2,
-    0x4fa2, 0x4fa2, 0x4af2, 0x4af2, 0x4eb2, 0x4eb2, 0x4be2, 0x4be2, 0x4dc2, 0x4dc2, 0x4cd2, 0x4cd2,
-    0x4f92, 0x4f92, 0xf005, 0x49f2, 0x49f2, 0x4ae2, 0x4ae2, 0x4db2, 0x4db2, 0x4bd2, 0x4bd2, 0x4f82,
-    0x4f82, 0x48f2, 0x48f2, 0x4cc2, 0x4cc2, 0x4e92, 0x4e92, 0x49e2, 0x49e2, 0x4f72, 0x4f72, 0x47f2,
-    0x47f2, 0x4da2, 0x4da2, 0x4ad2, 0x4ad2, 0x4cb2, 0x4cb2, 0x4f62, 0x4f62, 0x5ea2, 0x5f01, 0xf004,
-    0x3bc2, 0x3bc2, 0x36f2, 0x36f2, 0x4e82, 0x48e2, 0x4f52, 0x4d92, 0x35f2, 0x35f2, 0x3e72, 0x3e72,
-    0x37e2, 0x37e2, 0x3ca2, 0x3ca2, 0xf004, 0x3ac2, 0x3ac2, 0x3bb2, 0x3bb2, 0x49d2, 0x4d82, 0x3f42,
-    0x3f42, 0x34f2, 0x34f2, 0x3f32, 0x3f32, 0x33f2, 0x33f2, 0x38d2, 0x38d2, 0xf004, 0x36e2, 0x36e2,
-    0x3f22, 0x3f22, 0x32f2, 0x32f2, 0x4e62, 0x40f1, 0x3f12, 0x3f12, 0x31f2, 0x31f2, 0x3c92, 0x3c92,
-    0x39c2, 0x39c2, 0xf003, 0x3e52, 0x3ba2, 0x3ab2, 0x35e2, 0x3d72, 0x37d2, 0x3e42, 0x34e2, 0xf003,
-    0x3c82, 0x38c2, 0x3e32, 0x3d62, 0x36d2, 0x33e2, 0x3b92, 0x39b2, 0xf004, 0x3e22, 0x3e22, 0x3aa2,
-    0x3aa2, 0x32e2, 0x32e2, 0x3e12, 0x3e12, 0x31e2, 0x31e2, 0x4e01, 0x40e1, 0x3d52, 0x3d52, 0x35d2,
-    0x35d2, 0xf003, 0x3c72, 0x37c2, 0x3d42, 0x3b82, 0x24d2, 0x24d2, 0x38b2, 0x3a92, 0xf003, 0x39a2,
-    0x3c62, 0x36c2, 0x3d32, 0x23d2, 0x23d2, 0x22d2, 0x22d2, 0xf003, 0x3d22, 0x3d01, 0x2d12, 0x2d12,
-    0x2b72, 0x2b72, 0x27b2, 0x27b2, 0xf003, 0x21d2, 0x21d2, 0x3c52, 0x30d1, 0x25c2, 0x25c2, 0x2a82,
-    0x2a82, 0xf002, 0x28a2, 0x2c42, 0x24c2, 0x2b62, 0xf003, 0x26b2, 0x26b2, 0x3992, 0x3c01, 0x2c32,
-    0x2c32, 0x23c2, 0x23c2, 0xf003, 0x2a72, 0x2a72, 0x27a2, 0x27a2, 0x26a2, 0x26a2, 0x30c1, 0x3b01,
-    0xf002, 0x12c2, 0x12c2, 0x2c22, 0x2b52, 0xf002, 0x25b2, 0x2c12, 0x2982, 0x2892, 0xf002, 0x21c2,
-    0x2b42, 0x24b2, 0x2a62, 0xf002, 0x2b32, 0x2972, 0x13b2, 0x13b2, 0xf002, 0x2792, 0x2882, 0x2b22,
-    0x2a52, 0xf002, 0x12b2, 0x12b2, 0x25a2, 0x2b12, 0xf002, 0x11b2, 0x11b2, 0x20b1, 0x2962, 0xf002,
-    0x2692, 0x2a42, 0x24a2, 0x2872, 0xf002, 0x2782, 0x2a32, 0x13a2, 0x13a2, 0xf001, 0x1952, 0x1592,
-    0xf001, 0x1a22, 0x12a2, 0xf001, 0x1a12, 0x11a2, 0xf002, 0x2a01, 0x20a1, 0x1862, 0x1862, 0xf001,
-    0x1682, 0x1942, 0xf001, 0x1492, 0x1932, 0xf002, 0x1392, 0x1392, 0x2772, 0x2901, 0xf001, 0x1852,
-    0x1582, 0xf001, 0x1922, 0x1762, 0xf001, 0x1672, 0x1292, 0xf001, 0x1912, 0x1091, 0xf001, 0x1842,
-    0x1482, 0xf001, 0x1752, 0x1572, 0xf001, 0x1832, 0x1382, 0xf001, 0x1662, 0x1742, 0xf001, 0x1472,
-    0x1801, 0xf001, 0x1081, 0x1652, 0xf001, 0x1562, 0x1732, 0xf001, 0x1372, 0x1642, 0xf001, 0x1701,
-    0x1071, 0xf001, 0x1601, 0x1061,
-    /* huffTable16[651] */
-    0xf008, 0x0101, 0x010a, 0x0113, 0x8ff2, 0x0118, 0x011d, 0x0120, 0x82f2, 0x0131, 0x8f12, 0x81f2,
-    0x0134, 0x0145, 0x0156, 0x0167, 0x0178, 0x0189, 0x019a, 0x01a3, 0x01ac, 0x01b5, 0x01be, 0x01c7,
-    0x01d0, 0x01d9, 0x01de, 0x01e3, 0x01e6, 0x01eb, 0x01f0, 0x8152, 0x01f3, 0x01f6, 0x01f9, 0x01fc,
-    0x8412, 0x8142, 0x01ff, 0x8322, 0x8232, 0x7312, 0x7312, 0x7132, 0x7132, 0x8301, 0x8031, 0x7222,
-    0x7222, 0x6212, 0x6212, 0x6212, 0x6212, 0x6122, 0x6122, 0x6122, 0x6122, 0x6201, 0x6201, 0x6201,
-    0x6201, 0x6021, 0x6021, 0x6021, 0x6021, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112,
-    0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4101, 0x4101, 0x4101,
-    0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101,
-    0x4101, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011,
-    0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x3011, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000,
-    0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0xf003, 0x3fe2, 0x3ef2, 0x3fd2, 0x3df2, 0x3fc2, 0x3cf2,
-    0x3fb2, 0x3bf2, 0xf003, 0x2fa2, 0x2fa2, 0x3af2, 0x3f92, 0x39f2, 0x38f2, 0x2f82, 0x2f82, 0xf002,
-    0x2f72, 0x27f2, 0x2f62, 0x26f2, 0xf002, 0x2f52, 0x25f2, 0x1f42, 0x1f42, 0xf001, 0x14f2, 0x13f2,
-    0xf004, 0x10f1, 0x10f1, 0x10f1, 0x10f1, 0x10f1, 0x10f1, 0x10f1, 0x10f1, 0x2f32, 0x2f32, 0x2f32,
-    0x2f32, 0x00e2, 0x00f3, 0x00fc, 0x0105, 0xf001, 0x1f22, 0x1f01, 0xf004, 0x00fa, 0x00ff, 0x0104,
-    0x0109, 0x010c, 0x0111, 0x0116, 0x0119, 0x011e, 0x0123, 0x0128, 0x43e2, 0x012d, 0x0130, 0x0133,
-    0x0136, 0xf004, 0x0128, 0x012b, 0x012e, 0x4d01, 0x0131, 0x0134, 0x0137, 0x4c32, 0x013a, 0x4c12,
-    0x40c1, 0x013d, 0x32e2, 0x32e2, 0x4e22, 0x4e12, 0xf004, 0x43d2, 0x4d22, 0x42d2, 0x41d2, 0x4b32,
-    0x012f, 0x3d12, 0x3d12, 0x44c2, 0x4b62, 0x43c2, 0x47a2, 0x3c22, 0x3c22, 0x42c2, 0x45b2, 0xf004,
-    0x41c2, 0x4c01, 0x4b42, 0x44b2, 0x4a62, 0x46a2, 0x33b2, 0x33b2, 0x4a52, 0x45a2, 0x3b22, 0x3b22,
-    0x32b2, 0x32b2, 0x3b12, 0x3b12, 0xf004, 0x31b2, 0x31b2, 0x4b01, 0x40b1, 0x4962, 0x4692, 0x4a42,
-    0x44a2, 0x4872, 0x4782, 0x33a2, 0x33a2, 0x4a32, 0x4952, 0x3a22, 0x3a22, 0xf004, 0x4592, 0x4862,
-    0x31a2, 0x31a2, 0x4682, 0x4772, 0x3492, 0x3492, 0x4942, 0x4752, 0x3762, 0x3762, 0x22a2, 0x22a2,
-    0x22a2, 0x22a2, 0xf003, 0x2a12, 0x2a12, 0x3a01, 0x30a1, 0x3932, 0x3392, 0x3852, 0x3582, 0xf003,
-    0x2922, 0x2922, 0x2292, 0x2292, 0x3672, 0x3901, 0x2912, 0x2912, 0xf003, 0x2192, 0x2192, 0x3091,
-    0x3842, 0x3482, 0x3572, 0x3832, 0x3382, 0xf003, 0x3662, 0x3822, 0x2282, 0x2282, 0x3742, 0x3472,
-    0x2812, 0x2812, 0xf003, 0x2182, 0x2182, 0x2081, 0x2081, 0x3801, 0x3652, 0x2732, 0x2732, 0xf003,
-    0x2372, 0x2372, 0x3562, 0x3642, 0x2722, 0x2722, 0x2272, 0x2272, 0xf003, 0x3462, 0x3552, 0x2701,
-    0x2701, 0x1712, 0x1712, 0x1712, 0x1712, 0xf002, 0x1172, 0x1172, 0x2071, 0x2632, 0xf002, 0x2362,
-    0x2542, 0x2452, 0x2622, 0xf001, 0x1262, 0x1612, 0xf002, 0x1162, 0x1162, 0x2601, 0x2061, 0xf002,
-    0x1352, 0x1352, 0x2532, 0x2442, 0xf001, 0x1522, 0x1252, 0xf001, 0x1512, 0x1501, 0xf001, 0x1432,
-    0x1342, 0xf001, 0x1051, 0x1422, 0xf001, 0x1242, 0x1332, 0xf001, 0x1401, 0x1041, 0xf004, 0x4ec2,
-    0x0086, 0x3ed2, 0x3ed2, 0x39e2, 0x39e2, 0x4ae2, 0x49d2, 0x2ee2, 0x2ee2, 0x2ee2, 0x2ee2, 0x3de2,
-    0x3de2, 0x3be2, 0x3be2, 0xf003, 0x2eb2, 0x2eb2, 0x2dc2, 0x2dc2, 0x3cd2, 0x3bd2, 0x2ea2, 0x2ea2,
-    0xf003, 0x2cc2, 0x2cc2, 0x3da2, 0x3ad2, 0x3e72, 0x3ca2, 0x2ac2, 0x2ac2, 0xf003, 0x39c2, 0x3d72,
-    0x2e52, 0x2e52, 0x1db2, 0x1db2, 0x1db2, 0x1db2, 0xf002, 0x1e92, 0x1e92, 0x2cb2, 0x2bc2, 0xf002,
-    0x2e82, 0x28e2, 0x2d92, 0x27e2, 0xf002, 0x2bb2, 0x2d82, 0x28d2, 0x2e62, 0xf001, 0x16e2, 0x1c92,
-    0xf002, 0x2ba2, 0x2ab2, 0x25e2, 0x27d2, 0xf002, 0x1e42, 0x1e42, 0x24e2, 0x2c82, 0xf001, 0x18c2,
-    0x1e32, 0xf002, 0x1d62, 0x1d62, 0x26d2, 0x2b92, 0xf002, 0x29b2, 0x2aa2, 0x11e2, 0x11e2, 0xf002,
-    0x14d2, 0x14d2, 0x28b2, 0x29a2, 0xf002, 0x1b72, 0x1b72, 0x27b2, 0x20d1, 0xf001, 0x1e01, 0x10e1,
-    0xf001, 0x1d52, 0x15d2, 0xf001, 0x1c72, 0x17c2, 0xf001, 0x1d42, 0x1b82, 0xf001, 0x1a92, 0x1c62,
-    0xf001, 0x16c2, 0x1d32, 0xf001, 0x1c52, 0x15c2, 0xf001, 0x1a82, 0x18a2, 0xf001, 0x1992, 0x1c42,
-    0xf001, 0x16b2, 0x1a72, 0xf001, 0x1b52, 0x1982, 0xf001, 0x1892, 0x1972, 0xf001, 0x1792, 0x1882,
-    0xf001, 0x1ce2, 0x1dd2,
-    /* huffTable24[705] */
-    0xf009, 0x8fe2, 0x8fe2, 0x8ef2, 0x8ef2, 0x8fd2, 0x8fd2, 0x8df2, 0x8df2, 0x8fc2, 0x8fc2, 0x8cf2,
-    0x8cf2, 0x8fb2, 0x8fb2, 0x8bf2, 0x8bf2, 0x7af2, 0x7af2, 0x7af2, 0x7af2, 0x8fa2, 0x8fa2, 0x8f92,
-    0x8f92, 0x79f2, 0x79f2, 0x79f2, 0x79f2, 0x78f2, 0x78f2, 0x78f2, 0x78f2, 0x8f82, 0x8f82, 0x8f72,
-    0x8f72, 0x77f2, 0x77f2, 0x77f2, 0x77f2, 0x7f62, 0x7f62, 0x7f62, 0x7f62, 0x76f2, 0x76f2, 0x76f2,
-    0x76f2, 0x7f52, 0x7f52, 0x7f52, 0x7f52, 0x75f2, 0x75f2, 0x75f2, 0x75f2, 0x7f42, 0x7f42, 0x7f42,
-    0x7f42, 0x74f2, 0x74f2, 0x74f2, 0x74f2, 0x7f32, 0x7f32, 0x7f32, 0x7f32, 0x73f2, 0x73f2, 0x73f2,
-    0x73f2, 0x7f22, 0x7f22, 0x7f22, 0x7f22, 0x72f2, 0x72f2, 0x72f2, 0x72f2, 0x71f2, 0x71f2, 0x71f2,
-    0x71f2, 0x8f12, 0x8f12, 0x80f1, 0x80f1, 0x9f01, 0x0201, 0x0206, 0x020b, 0x0210, 0x0215, 0x021a,
-    0x021f, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2,
-    0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2,
-    0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x4ff2, 0x0224, 0x0229, 0x0232,
-    0x0237, 0x023a, 0x023f, 0x0242, 0x0245, 0x024a, 0x024d, 0x0250, 0x0253, 0x0256, 0x0259, 0x025c,
-    0x025f, 0x0262, 0x0265, 0x0268, 0x026b, 0x026e, 0x0271, 0x0274, 0x0277, 0x027a, 0x027d, 0x0280,
-    0x0283, 0x0288, 0x028b, 0x028e, 0x0291, 0x0294, 0x0297, 0x029a, 0x029f, 0x94b2, 0x02a4, 0x02a7,
-    0x02aa, 0x93b2, 0x9882, 0x02af, 0x92b2, 0x02b2, 0x02b5, 0x9692, 0x94a2, 0x02b8, 0x9782, 0x9a32,
-    0x93a2, 0x9952, 0x9592, 0x9a22, 0x92a2, 0x91a2, 0x9862, 0x9682, 0x9772, 0x9942, 0x9492, 0x9932,
-    0x9392, 0x9852, 0x9582, 0x9922, 0x9762, 0x9672, 0x9292, 0x9912, 0x9192, 0x9842, 0x9482, 0x9752,
-    0x9572, 0x9832, 0x9382, 0x9662, 0x9822, 0x9282, 0x9812, 0x9742, 0x9472, 0x9182, 0x02bb, 0x9652,
-    0x9562, 0x9712, 0x02be, 0x8372, 0x8372, 0x9732, 0x9722, 0x8272, 0x8272, 0x8642, 0x8642, 0x8462,
-    0x8462, 0x8552, 0x8552, 0x8172, 0x8172, 0x8632, 0x8632, 0x8362, 0x8362, 0x8542, 0x8542, 0x8452,
-    0x8452, 0x8622, 0x8622, 0x8262, 0x8262, 0x8612, 0x8612, 0x8162, 0x8162, 0x9601, 0x9061, 0x8532,
-    0x8532, 0x8352, 0x8352, 0x8442, 0x8442, 0x8522, 0x8522, 0x8252, 0x8252, 0x8512, 0x8512, 0x9501,
-    0x9051, 0x7152, 0x7152, 0x7152, 0x7152, 0x8432, 0x8432, 0x8342, 0x8342, 0x7422, 0x7422, 0x7422,
-    0x7422, 0x7242, 0x7242, 0x7242, 0x7242, 0x7332, 0x7332, 0x7332, 0x7332, 0x7412, 0x7412, 0x7412,
-    0x7412, 0x7142, 0x7142, 0x7142, 0x7142, 0x8401, 0x8401, 0x8041, 0x8041, 0x7322, 0x7322, 0x7322,
-    0x7322, 0x7232, 0x7232, 0x7232, 0x7232, 0x6312, 0x6312, 0x6312, 0x6312, 0x6312, 0x6312, 0x6312,
-    0x6312, 0x6132, 0x6132, 0x6132, 0x6132, 0x6132, 0x6132, 0x6132, 0x6132, 0x7301, 0x7301, 0x7301,
-    0x7301, 0x7031, 0x7031, 0x7031, 0x7031, 0x6222, 0x6222, 0x6222, 0x6222, 0x6222, 0x6222, 0x6222,
-    0x6222, 0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5212,
-    0x5212, 0x5212, 0x5212, 0x5212, 0x5212, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122,
-    0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x5122, 0x6201, 0x6201, 0x6201,
-    0x6201, 0x6201, 0x6201, 0x6201, 0x6201, 0x6021, 0x6021, 0x6021, 0x6021, 0x6021, 0x6021, 0x6021,
-    0x6021, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112,
-    0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112,
-    0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4112, 0x4101, 0x4101, 0x4101,
-    0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101,
-    0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4101,
-    0x4101, 0x4101, 0x4101, 0x4101, 0x4101, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011,
-    0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011,
-    0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011, 0x4011,
-    0x4011, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000,
-    0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000,
-    0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0xf002, 0x2ee2, 0x2ed2,
-    0x2de2, 0x2ec2, 0xf002, 0x2ce2, 0x2dd2, 0x2eb2, 0x2be2, 0xf002, 0x2dc2, 0x2cd2, 0x2ea2, 0x2ae2,
-    0xf002, 0x2db2, 0x2bd2, 0x2cc2, 0x2e92, 0xf002, 0x29e2, 0x2da2, 0x2ad2, 0x2cb2, 0xf002, 0x2bc2,
-    0x2e82, 0x28e2, 0x2d92, 0xf002, 0x29d2, 0x2e72, 0x27e2, 0x2ca2, 0xf002, 0x2ac2, 0x2bb2, 0x2d82,
-    0x28d2, 0xf003, 0x3e01, 0x30e1, 0x2d01, 0x2d01, 0x16e2, 0x16e2, 0x16e2, 0x16e2, 0xf002, 0x2e62,
-    0x2c92, 0x19c2, 0x19c2, 0xf001, 0x1e52, 0x1ab2, 0xf002, 0x15e2, 0x15e2, 0x2ba2, 0x2d72, 0xf001,
-    0x17d2, 0x14e2, 0xf001, 0x1c82, 0x18c2, 0xf002, 0x2e42, 0x2e22, 0x1e32, 0x1e32, 0xf001, 0x1d62,
-    0x16d2, 0xf001, 0x13e2, 0x1b92, 0xf001, 0x19b2, 0x1aa2, 0xf001, 0x12e2, 0x1e12, 0xf001, 0x11e2,
-    0x1d52, 0xf001, 0x15d2, 0x1c72, 0xf001, 0x17c2, 0x1d42, 0xf001, 0x1b82, 0x18b2, 0xf001, 0x14d2,
-    0x1a92, 0xf001, 0x19a2, 0x1c62, 0xf001, 0x16c2, 0x1d32, 0xf001, 0x13d2, 0x1d22, 0xf001, 0x12d2,
-    0x1d12, 0xf001, 0x1b72, 0x17b2, 0xf001, 0x11d2, 0x1c52, 0xf001, 0x15c2, 0x1a82, 0xf001, 0x18a2,
-    0x1992, 0xf001, 0x1c42, 0x14c2, 0xf001, 0x1b62, 0x16b2, 0xf002, 0x20d1, 0x2c01, 0x1c32, 0x1c32,
-    0xf001, 0x13c2, 0x1a72, 0xf001, 0x17a2, 0x1c22, 0xf001, 0x12c2, 0x1b52, 0xf001, 0x15b2, 0x1c12,
-    0xf001, 0x1982, 0x1892, 0xf001, 0x11c2, 0x1b42, 0xf002, 0x20c1, 0x2b01, 0x1b32, 0x1b32, 0xf002,
-    0x20b1, 0x2a01, 0x1a12, 0x1a12, 0xf001, 0x1a62, 0x16a2, 0xf001, 0x1972, 0x1792, 0xf002, 0x20a1,
-    0x2901, 0x1091, 0x1091, 0xf001, 0x1b22, 0x1a52, 0xf001, 0x15a2, 0x1b12, 0xf001, 0x11b2, 0x1962,
-    0xf001, 0x1a42, 0x1872, 0xf001, 0x1801, 0x1081, 0xf001, 0x1701, 0x1071,
+
+/* two-level tables for the pairs in the big_values region, generated from the Helix tables
+ * entry 0: number of bits of the first lookup (rootBits), followed by 2^rootBits entries and the subtables
+ * leaf    0nnn nsxx xxxy yyyy  n: bits to consume, s = 1: the sign bits are included in n, x and y are
+ *                              sign (bit 4) and magnitude, s = 0: x and y are magnitudes, the linbits (x or y == 15)
+ *                              and the sign bits follow in the bitstream
+ * pointer 1bbb bfff ffff ffff  consume rootBits, then look up the next b bits in the subtable at entry f + 1
+ */
+const uint16_t huffTable[8815] PROGMEM = {
+    /* huffTable01[33] */
+    0x0005, 0x2c21, 0x2c31, 0x2e21, 0x2e31, 0x2401, 0x2401, 0x2411, 0x2411, 0x1c20, 0x1c20, 0x1c20,
+    0x1c20, 0x1e20, 0x1e20, 0x1e20, 0x1e20, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    /* huffTable02[257] */
+    0x0008, 0x4442, 0x4452, 0x4642, 0x4652, 0x3c02, 0x3c02, 0x3c12, 0x3c12, 0x3c22, 0x3c22, 0x3c32,
+    0x3c32, 0x3e22, 0x3e22, 0x3e32, 0x3e32, 0x3c41, 0x3c41, 0x3c51, 0x3c51, 0x3e41, 0x3e41, 0x3e51,
+    0x3e51, 0x3440, 0x3440, 0x3440, 0x3440, 0x3640, 0x3640, 0x3640, 0x3640, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    /* huffTable03[257] */
+    0x0008, 0x4442, 0x4452, 0x4642, 0x4652, 0x3c02, 0x3c02, 0x3c12, 0x3c12, 0x3c22, 0x3c22, 0x3c32,
+    0x3c32, 0x3e22, 0x3e22, 0x3e32, 0x3e32, 0x3c41, 0x3c41, 0x3c51, 0x3c51, 0x3e41, 0x3e41, 0x3e51,
+    0x3e51, 0x3440, 0x3440, 0x3440, 0x3440, 0x3640, 0x3640, 0x3640, 0x3640, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421,
+    0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2431, 0x2431, 0x2431,
+    0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431,
+    0x2431, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621,
+    0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631,
+    0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x1c01, 0x1c01, 0x1c01,
+    0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01,
+    0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01,
+    0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c01, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11,
+    0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11,
+    0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11, 0x1c11,
+    0x1c11, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    /* huffTable05[513] */
+    0x0009, 0x4063, 0x4063, 0x4043, 0x4043, 0x4c62, 0x4c72, 0x4e62, 0x4e72, 0x4461, 0x4461, 0x4471,
+    0x4471, 0x4661, 0x4661, 0x4671, 0x4671, 0x4c23, 0x4c33, 0x4e23, 0x4e33, 0x4403, 0x4403, 0x4413,
+    0x4413, 0x4460, 0x4460, 0x4660, 0x4660, 0x4c42, 0x4c52, 0x4e42, 0x4e52, 0x4422, 0x4422, 0x4432,
+    0x4432, 0x4622, 0x4622, 0x4632, 0x4632, 0x4441, 0x4441, 0x4451, 0x4451, 0x4641, 0x4641, 0x4651,
+    0x4651, 0x3c02, 0x3c02, 0x3c02, 0x3c02, 0x3c12, 0x3c12, 0x3c12, 0x3c12, 0x3c40, 0x3c40, 0x3c40,
+    0x3c40, 0x3e40, 0x3e40, 0x3e40, 0x3e40, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21,
+    0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    /* huffTable06[513] */
+    0x0009, 0x4c63, 0x4c73, 0x4e63, 0x4e73, 0x4403, 0x4403, 0x4413, 0x4413, 0x4443, 0x4443, 0x4453,
+    0x4453, 0x4643, 0x4643, 0x4653, 0x4653, 0x4462, 0x4462, 0x4472, 0x4472, 0x4662, 0x4662, 0x4672,
+    0x4672, 0x3c60, 0x3c60, 0x3c60, 0x3c60, 0x3e60, 0x3e60, 0x3e60, 0x3e60, 0x3c23, 0x3c23, 0x3c23,
+    0x3c23, 0x3c33, 0x3c33, 0x3c33, 0x3c33, 0x3e23, 0x3e23, 0x3e23, 0x3e23, 0x3e33, 0x3e33, 0x3e33,
+    0x3e33, 0x3c61, 0x3c61, 0x3c61, 0x3c61, 0x3c71, 0x3c71, 0x3c71, 0x3c71, 0x3e61, 0x3e61, 0x3e61,
+    0x3e61, 0x3e71, 0x3e71, 0x3e71, 0x3e71, 0x3c42, 0x3c42, 0x3c42, 0x3c42, 0x3c52, 0x3c52, 0x3c52,
+    0x3c52, 0x3e42, 0x3e42, 0x3e42, 0x3e42, 0x3e52, 0x3e52, 0x3e52, 0x3e52, 0x3402, 0x3402, 0x3402,
+    0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412,
+    0x3412, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3432, 0x3432, 0x3432,
+    0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622,
+    0x3622, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3441, 0x3441, 0x3441,
+    0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3451, 0x3451, 0x3451, 0x3451, 0x3451, 0x3451, 0x3451,
+    0x3451, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3651, 0x3651, 0x3651,
+    0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40,
+    0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2e40, 0x2e40, 0x2e40,
+    0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40,
+    0x2e40, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421,
+    0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421,
+    0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421,
+    0x2421, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431,
+    0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431,
+    0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2621, 0x2621, 0x2621,
+    0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621,
+    0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621,
+    0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631,
+    0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631,
+    0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631,
+    0x2631, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    /* huffTable07[517] */
+    0x0009, 0x8a00, 0x8a02, 0x4865, 0x4884, 0x4845, 0x48a2, 0x4025, 0x4025, 0x40a1, 0x40a1, 0x4805,
+    0x4864, 0x4ca0, 0x4ea0, 0x4883, 0x4863, 0x4044, 0x4044, 0x4082, 0x4082, 0x4c24, 0x4c34, 0x4e24,
+    0x4e34, 0x4c81, 0x4c91, 0x4e81, 0x4e91, 0x4480, 0x4480, 0x4680, 0x4680, 0x4c04, 0x4c14, 0x4043,
+    0x4043, 0x4062, 0x4062, 0x4c03, 0x4c13, 0x4c23, 0x4c33, 0x4e23, 0x4e33, 0x4c61, 0x4c71, 0x4e61,
+    0x4e71, 0x4460, 0x4460, 0x4660, 0x4660, 0x4c42, 0x4c52, 0x4e42, 0x4e52, 0x4422, 0x4422, 0x4432,
+    0x4432, 0x4622, 0x4622, 0x4632, 0x4632, 0x3c41, 0x3c41, 0x3c41, 0x3c41, 0x3c51, 0x3c51, 0x3c51,
+    0x3c51, 0x3e41, 0x3e41, 0x3e41, 0x3e41, 0x3e51, 0x3e51, 0x3e51, 0x3e51, 0x3c02, 0x3c02, 0x3c02,
+    0x3c02, 0x3c12, 0x3c12, 0x3c12, 0x3c12, 0x3c40, 0x3c40, 0x3c40, 0x3c40, 0x3e40, 0x3e40, 0x3e40,
+    0x3e40, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3431, 0x3431, 0x3431,
+    0x3431, 0x3431, 0x3431, 0x3431, 0x3431, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621,
+    0x3621, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x08a5, 0x0885, 0x08a4,
+    0x08a3,
+    /* huffTable08[519] */
+    0x0009, 0x9200, 0x48a3, 0x8a04, 0x4845, 0x48a2, 0x4805, 0x4025, 0x4025, 0x40a1, 0x40a1, 0x4864,
+    0x4883, 0x48a0, 0x4863, 0x4044, 0x4044, 0x4082, 0x4082, 0x4024, 0x4024, 0x4c81, 0x4c91, 0x4e81,
+    0x4e91, 0x4c04, 0x4c14, 0x4c80, 0x4e80, 0x4043, 0x4043, 0x4062, 0x4062, 0x4023, 0x4023, 0x4061,
+    0x4061, 0x4c03, 0x4c13, 0x4c60, 0x4e60, 0x4442, 0x4442, 0x4452, 0x4452, 0x4642, 0x4642, 0x4652,
+    0x4652, 0x3c02, 0x3c02, 0x3c02, 0x3c02, 0x3c12, 0x3c12, 0x3c12, 0x3c12, 0x3c40, 0x3c40, 0x3c40,
+    0x3c40, 0x3e40, 0x3e40, 0x3e40, 0x3e40, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422,
+    0x3422, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3622, 0x3622, 0x3622,
+    0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632,
+    0x3632, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3451, 0x3451, 0x3451,
+    0x3451, 0x3451, 0x3451, 0x3451, 0x3451, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641,
+    0x3641, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x2421, 0x2421, 0x2421,
+    0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421,
+    0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2421,
+    0x2421, 0x2421, 0x2421, 0x2421, 0x2421, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431,
+    0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431,
+    0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431, 0x2431,
+    0x2431, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621,
+    0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621,
+    0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2621, 0x2631, 0x2631, 0x2631,
+    0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631,
+    0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2631,
+    0x2631, 0x2631, 0x2631, 0x2631, 0x2631, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x10a5, 0x10a4, 0x0885,
+    0x0885, 0x0865, 0x0884,
+    /* huffTable09[513] */
+    0x0009, 0x48a5, 0x4885, 0x4065, 0x4065, 0x40a3, 0x40a3, 0x48a4, 0x4805, 0x4084, 0x4084, 0x4045,
+    0x4045, 0x40a2, 0x40a2, 0x4025, 0x4025, 0x4ca1, 0x4cb1, 0x4ea1, 0x4eb1, 0x4c64, 0x4c74, 0x4e64,
+    0x4e74, 0x4c83, 0x4c93, 0x4e83, 0x4e93, 0x4ca0, 0x4ea0, 0x4c04, 0x4c14, 0x4c44, 0x4c54, 0x4e44,
+    0x4e54, 0x4c82, 0x4c92, 0x4e82, 0x4e92, 0x4c63, 0x4c73, 0x4e63, 0x4e73, 0x4480, 0x4480, 0x4680,
+    0x4680, 0x4424, 0x4424, 0x4434, 0x4434, 0x4624, 0x4624, 0x4634, 0x4634, 0x4481, 0x4481, 0x4491,
+    0x4491, 0x4681, 0x4681, 0x4691, 0x4691, 0x4443, 0x4443, 0x4453, 0x4453, 0x4643, 0x4643, 0x4653,
+    0x4653, 0x4462, 0x4462, 0x4472, 0x4472, 0x4662, 0x4662, 0x4672, 0x4672, 0x3c23, 0x3c23, 0x3c23,
+    0x3c23, 0x3c33, 0x3c33, 0x3c33, 0x3c33, 0x3e23, 0x3e23, 0x3e23, 0x3e23, 0x3e33, 0x3e33, 0x3e33,
+    0x3e33, 0x3c61, 0x3c61, 0x3c61, 0x3c61, 0x3c71, 0x3c71, 0x3c71, 0x3c71, 0x3e61, 0x3e61, 0x3e61,
+    0x3e61, 0x3e71, 0x3e71, 0x3e71, 0x3e71, 0x3c03, 0x3c03, 0x3c03, 0x3c03, 0x3c13, 0x3c13, 0x3c13,
+    0x3c13, 0x3c60, 0x3c60, 0x3c60, 0x3c60, 0x3e60, 0x3e60, 0x3e60, 0x3e60, 0x3c42, 0x3c42, 0x3c42,
+    0x3c42, 0x3c52, 0x3c52, 0x3c52, 0x3c52, 0x3e42, 0x3e42, 0x3e42, 0x3e42, 0x3e52, 0x3e52, 0x3e52,
+    0x3e52, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3412, 0x3412, 0x3412,
+    0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422,
+    0x3422, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3622, 0x3622, 0x3622,
+    0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632,
+    0x3632, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3451, 0x3451, 0x3451,
+    0x3451, 0x3451, 0x3451, 0x3451, 0x3451, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641,
+    0x3641, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x2c40, 0x2c40, 0x2c40,
+    0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40, 0x2c40,
+    0x2c40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40,
+    0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2e40, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21,
+    0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    /* huffTable10[541] */
+    0x0009, 0x9200, 0x9204, 0x8a08, 0x8a0a, 0x8a0c, 0x920e, 0x4847, 0x48e2, 0x8a12, 0x48e0, 0x48c2,
+    0x8a14, 0x4806, 0x8a16, 0x4027, 0x4027, 0x40e1, 0x40e1, 0x4866, 0x4846, 0x8a18, 0x4825, 0x48a1,
+    0x8a1a, 0x4026, 0x4026, 0x40c1, 0x40c1, 0x4cc0, 0x4ec0, 0x4805, 0x48a0, 0x4844, 0x4882, 0x4863,
+    0x4804, 0x4024, 0x4024, 0x4081, 0x4081, 0x4c80, 0x4e80, 0x4043, 0x4043, 0x4062, 0x4062, 0x4c03,
+    0x4c13, 0x4c23, 0x4c33, 0x4e23, 0x4e33, 0x4c61, 0x4c71, 0x4e61, 0x4e71, 0x4460, 0x4460, 0x4660,
+    0x4660, 0x4c42, 0x4c52, 0x4e42, 0x4e52, 0x4422, 0x4422, 0x4432, 0x4432, 0x4622, 0x4622, 0x4632,
+    0x4632, 0x4441, 0x4441, 0x4451, 0x4451, 0x4641, 0x4641, 0x4651, 0x4651, 0x3c02, 0x3c02, 0x3c02,
+    0x3c02, 0x3c12, 0x3c12, 0x3c12, 0x3c12, 0x3c40, 0x3c40, 0x3c40, 0x3c40, 0x3e40, 0x3e40, 0x3e40,
+    0x3e40, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3431, 0x3431, 0x3431,
+    0x3431, 0x3431, 0x3431, 0x3431, 0x3431, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621,
+    0x3621, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x10e7, 0x10c7, 0x10e6,
+    0x10a7, 0x10e5, 0x10c6, 0x0887, 0x0887, 0x08e4, 0x08a6, 0x08c5, 0x0867, 0x08e3, 0x0886, 0x10a5,
+    0x10a4, 0x08c3, 0x08c3, 0x08c4, 0x0807, 0x0885, 0x0865, 0x08a3, 0x0884, 0x0845, 0x08a2, 0x0864,
+    0x0883,
+    /* huffTable11[529] */
+    0x0009, 0x8a00, 0x8a02, 0x8a04, 0x9206, 0x8a0a, 0x4867, 0x48e3, 0x4886, 0x8a0c, 0x8a0e, 0x4047,
+    0x4047, 0x40e2, 0x40e2, 0x48c4, 0x4807, 0x4ce1, 0x4cf1, 0x4ee1, 0x4ef1, 0x4027, 0x4027, 0x4ce0,
+    0x4ee0, 0x4066, 0x4066, 0x40c3, 0x40c3, 0x4cc0, 0x4ec0, 0x4884, 0x4845, 0x48a2, 0x4805, 0x4025,
+    0x4025, 0x4cc2, 0x4cd2, 0x4ec2, 0x4ed2, 0x4046, 0x4046, 0x4c06, 0x4c16, 0x4c26, 0x4c36, 0x4e26,
+    0x4e36, 0x4cc1, 0x4cd1, 0x4ec1, 0x4ed1, 0x40a1, 0x40a1, 0x4064, 0x4064, 0x4ca0, 0x4ea0, 0x4883,
+    0x4863, 0x4044, 0x4044, 0x4082, 0x4082, 0x4024, 0x4024, 0x4081, 0x4081, 0x4c04, 0x4c14, 0x4c80,
+    0x4e80, 0x4c43, 0x4c53, 0x4e43, 0x4e53, 0x4c62, 0x4c72, 0x4e62, 0x4e72, 0x4423, 0x4423, 0x4433,
+    0x4433, 0x4623, 0x4623, 0x4633, 0x4633, 0x4461, 0x4461, 0x4471, 0x4471, 0x4661, 0x4661, 0x4671,
+    0x4671, 0x4403, 0x4403, 0x4413, 0x4413, 0x4460, 0x4460, 0x4660, 0x4660, 0x4442, 0x4442, 0x4452,
+    0x4452, 0x4642, 0x4642, 0x4652, 0x4652, 0x3c41, 0x3c41, 0x3c41, 0x3c41, 0x3c51, 0x3c51, 0x3c51,
+    0x3c51, 0x3e41, 0x3e41, 0x3e41, 0x3e41, 0x3e51, 0x3e51, 0x3e51, 0x3e51, 0x3422, 0x3422, 0x3422,
+    0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3432,
+    0x3432, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3632, 0x3632, 0x3632,
+    0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402,
+    0x3402, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3440, 0x3440, 0x3440,
+    0x3440, 0x3440, 0x3440, 0x3440, 0x3440, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640,
+    0x3640, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2e21, 0x2e21, 0x2e21,
+    0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21,
+    0x2e21, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400,
+    0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x1400, 0x08e7, 0x08c7, 0x08e6,
+    0x08e5, 0x08c6, 0x0887, 0x08e4, 0x08e4, 0x10a7, 0x10a5, 0x08a6, 0x08c5, 0x0885, 0x08a4, 0x0865,
+    0x08a3,
+    /* huffTable12[515] */
+    0x0009, 0x8a00, 0x48e6, 0x48a7, 0x48e5, 0x48c6, 0x4887, 0x48e4, 0x48c5, 0x40a6, 0x40a6, 0x4067,
+    0x4067, 0x48e3, 0x48a5, 0x4047, 0x4047, 0x40e2, 0x40e2, 0x4086, 0x4086, 0x40c4, 0x40c4, 0x4027,
+    0x4027, 0x40e1, 0x40e1, 0x4807, 0x48e0, 0x4066, 0x4066, 0x40c3, 0x40c3, 0x4085, 0x4085, 0x40a4,
+    0x40a4, 0x4084, 0x4084, 0x4806, 0x4805, 0x4c46, 0x4c56, 0x4e46, 0x4e56, 0x4cc2, 0x4cd2, 0x4ec2,
+    0x4ed2, 0x4cc1, 0x4cd1, 0x4ec1, 0x4ed1, 0x4026, 0x4026, 0x4cc0, 0x4ec0, 0x4065, 0x4065, 0x40a3,
+    0x40a3, 0x4045, 0x4045, 0x40a2, 0x40a2, 0x4c25, 0x4c35, 0x4e25, 0x4e35, 0x4ca1, 0x4cb1, 0x4ea1,
+    0x4eb1, 0x4c64, 0x4c74, 0x4e64, 0x4e74, 0x4c83, 0x4c93, 0x4e83, 0x4e93, 0x4ca0, 0x4ea0, 0x4c04,
+    0x4c14, 0x4c44, 0x4c54, 0x4e44, 0x4e54, 0x4c82, 0x4c92, 0x4e82, 0x4e92, 0x4c24, 0x4c34, 0x4e24,
+    0x4e34, 0x4463, 0x4463, 0x4473, 0x4473, 0x4663, 0x4663, 0x4673, 0x4673, 0x4481, 0x4481, 0x4491,
+    0x4491, 0x4681, 0x4681, 0x4691, 0x4691, 0x4443, 0x4443, 0x4453, 0x4453, 0x4643, 0x4643, 0x4653,
+    0x4653, 0x4462, 0x4462, 0x4472, 0x4472, 0x4662, 0x4662, 0x4672, 0x4672, 0x4480, 0x4480, 0x4680,
+    0x4680, 0x4403, 0x4403, 0x4413, 0x4413, 0x3c60, 0x3c60, 0x3c60, 0x3c60, 0x3e60, 0x3e60, 0x3e60,
+    0x3e60, 0x3c23, 0x3c23, 0x3c23, 0x3c23, 0x3c33, 0x3c33, 0x3c33, 0x3c33, 0x3e23, 0x3e23, 0x3e23,
+    0x3e23, 0x3e33, 0x3e33, 0x3e33, 0x3e33, 0x3c61, 0x3c61, 0x3c61, 0x3c61, 0x3c71, 0x3c71, 0x3c71,
+    0x3c71, 0x3e61, 0x3e61, 0x3e61, 0x3e61, 0x3e71, 0x3e71, 0x3e71, 0x3e71, 0x3c42, 0x3c42, 0x3c42,
+    0x3c42, 0x3c52, 0x3c52, 0x3c52, 0x3c52, 0x3e42, 0x3e42, 0x3e42, 0x3e42, 0x3e52, 0x3e52, 0x3e52,
+    0x3e52, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3422, 0x3432, 0x3432, 0x3432,
+    0x3432, 0x3432, 0x3432, 0x3432, 0x3432, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622, 0x3622,
+    0x3622, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3632, 0x3441, 0x3441, 0x3441,
+    0x3441, 0x3441, 0x3441, 0x3441, 0x3441, 0x3451, 0x3451, 0x3451, 0x3451, 0x3451, 0x3451, 0x3451,
+    0x3451, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3641, 0x3651, 0x3651, 0x3651,
+    0x3651, 0x3651, 0x3651, 0x3651, 0x3651, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402,
+    0x3402, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3440, 0x3440, 0x3440,
+    0x3440, 0x3440, 0x3440, 0x3440, 0x3440, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640,
+    0x3640, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400,
+    0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400,
+    0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21,
+    0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401,
+    0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2401, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2411,
+    0x2411, 0x2411, 0x2411, 0x2411, 0x2411, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x08e7, 0x08c7,
+    /* huffTable13[1743] */
+    0x0009, 0xd200, 0xae00, 0xa620, 0xa630, 0xa640, 0xa650, 0x9e60, 0x9e68, 0x9e70, 0x9e78, 0x9e80,
+    0x9e88, 0x8e90, 0x9692, 0x9696, 0x8e9a, 0x8e9c, 0x969e, 0x96a2, 0x96a6, 0x8eaa, 0x96ac, 0x96b0,
+    0x96b4, 0x4829, 0x4921, 0x8eb8, 0x8eba, 0x96bc, 0x4848, 0x4902, 0x4828, 0x8ec0, 0x4827, 0x48e1,
+    0x8ec2, 0x8ec4, 0x8ec6, 0x8ec8, 0x8eca, 0x4101, 0x4101, 0x4808, 0x4900, 0x4826, 0x48c1, 0x4806,
+    0x48c0, 0x8ecc, 0x4845, 0x48a2, 0x4805, 0x4025, 0x4025, 0x40a1, 0x40a1, 0x4864, 0x4883, 0x48a0,
+    0x4844, 0x4882, 0x4863, 0x4024, 0x4024, 0x4c81, 0x4c91, 0x4e81, 0x4e91, 0x4c04, 0x4c14, 0x4c80,
+    0x4e80, 0x4043, 0x4043, 0x4062, 0x4062, 0x4c23, 0x4c33, 0x4e23, 0x4e33, 0x4c61, 0x4c71, 0x4e61,
+    0x4e71, 0x4403, 0x4403, 0x4413, 0x4413, 0x4460, 0x4460, 0x4660, 0x4660, 0x4c42, 0x4c52, 0x4e42,
+    0x4e52, 0x4422, 0x4422, 0x4432, 0x4432, 0x4622, 0x4622, 0x4632, 0x4632, 0x4441, 0x4441, 0x4451,
+    0x4451, 0x4641, 0x4641, 0x4651, 0x4651, 0x3c02, 0x3c02, 0x3c02, 0x3c02, 0x3c12, 0x3c12, 0x3c12,
+    0x3c12, 0x3c40, 0x3c40, 0x3c40, 0x3c40, 0x3e40, 0x3e40, 0x3e40, 0x3e40, 0x3421, 0x3421, 0x3421,
+    0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3431, 0x3431, 0x3431, 0x3431, 0x3431, 0x3431, 0x3431,
+    0x3431, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3631, 0x3631, 0x3631,
+    0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01,
+    0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c11, 0x2c11, 0x2c11,
+    0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11,
+    0x2c11, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x51ee, 0x51ec, 0x49ed,
+    0x49ed, 0x55cd, 0x55dd, 0x57cd, 0x57dd, 0x4def, 0x4def, 0x4dff, 0x4dff, 0x4fef, 0x4fef, 0x4fff,
+    0x4fff, 0x4dcf, 0x4dcf, 0x4ddf, 0x4ddf, 0x4fcf, 0x4fcf, 0x4fdf, 0x4fdf, 0x4daf, 0x4daf, 0x4dbf,
+    0x4dbf, 0x4faf, 0x4faf, 0x4fbf, 0x4fbf, 0x4dce, 0x4dce, 0x4dde, 0x4dde, 0x4fce, 0x4fce, 0x4fde,
+    0x4fde, 0x4d8f, 0x4d8f, 0x4d9f, 0x4d9f, 0x4f8f, 0x4f8f, 0x4f9f, 0x4f9f, 0x4dae, 0x4dae, 0x4dbe,
+    0x4dbe, 0x4fae, 0x4fae, 0x4fbe, 0x4fbe, 0x4d6f, 0x4d6f, 0x4d7f, 0x4d7f, 0x4f6f, 0x4f6f, 0x4f7f,
+    0x4f7f, 0x4deb, 0x4deb, 0x4dfb, 0x4dfb, 0x4feb, 0x4feb, 0x4ffb, 0x4ffb, 0x4d8e, 0x4d8e, 0x4d9e,
+    0x4d9e, 0x4f8e, 0x4f8e, 0x4f9e, 0x4f9e, 0x4dac, 0x4dac, 0x4dbc, 0x4dbc, 0x4fac, 0x4fac, 0x4fbc,
+    0x4fbc, 0x554f, 0x555f, 0x574f, 0x575f, 0x55c9, 0x55d9, 0x57c9, 0x57d9, 0x45cc, 0x45cc, 0x45cc,
+    0x45cc, 0x45dc, 0x45dc, 0x45dc, 0x45dc, 0x47cc, 0x47cc, 0x47cc, 0x47cc, 0x47dc, 0x47dc, 0x47dc,
+    0x47dc, 0x45ad, 0x45ad, 0x45ad, 0x45ad, 0x45bd, 0x45bd, 0x45bd, 0x45bd, 0x47ad, 0x47ad, 0x47ad,
+    0x47ad, 0x47bd, 0x47bd, 0x47bd, 0x47bd, 0x4dea, 0x4dea, 0x4dfa, 0x4dfa, 0x4fea, 0x4fea, 0x4ffa,
+    0x4ffa, 0x4d8d, 0x4d8d, 0x4d9d, 0x4d9d, 0x4f8d, 0x4f8d, 0x4f9d, 0x4f9d, 0x456e, 0x456e, 0x456e,
+    0x456e, 0x457e, 0x457e, 0x457e, 0x457e, 0x476e, 0x476e, 0x476e, 0x476e, 0x477e, 0x477e, 0x477e,
+    0x477e, 0x45cb, 0x45cb, 0x45cb, 0x45cb, 0x45db, 0x45db, 0x45db, 0x45db, 0x47cb, 0x47cb, 0x47cb,
+    0x47cb, 0x47db, 0x47db, 0x47db, 0x47db, 0x452f, 0x452f, 0x452f, 0x452f, 0x453f, 0x453f, 0x453f,
+    0x453f, 0x472f, 0x472f, 0x472f, 0x472f, 0x473f, 0x473f, 0x473f, 0x473f, 0x45e9, 0x45e9, 0x45e9,
+    0x45e9, 0x45f9, 0x45f9, 0x45f9, 0x45f9, 0x47e9, 0x47e9, 0x47e9, 0x47e9, 0x47f9, 0x47f9, 0x47f9,
+    0x47f9, 0x45ca, 0x45ca, 0x45ca, 0x45ca, 0x45da, 0x45da, 0x45da, 0x45da, 0x47ca, 0x47ca, 0x47ca,
+    0x47ca, 0x47da, 0x47da, 0x47da, 0x47da, 0x456d, 0x456d, 0x456d, 0x456d, 0x457d, 0x457d, 0x457d,
+    0x457d, 0x476d, 0x476d, 0x476d, 0x476d, 0x477d, 0x477d, 0x477d, 0x477d, 0x45ab, 0x45ab, 0x45ab,
+    0x45ab, 0x45bb, 0x45bb, 0x45bb, 0x45bb, 0x47ab, 0x47ab, 0x47ab, 0x47ab, 0x47bb, 0x47bb, 0x47bb,
+    0x47bb, 0x450f, 0x450f, 0x450f, 0x450f, 0x451f, 0x451f, 0x451f, 0x451f, 0x470f, 0x470f, 0x470f,
+    0x470f, 0x471f, 0x471f, 0x471f, 0x471f, 0x45e8, 0x45e8, 0x45e8, 0x45e8, 0x45f8, 0x45f8, 0x45f8,
+    0x45f8, 0x47e8, 0x47e8, 0x47e8, 0x47e8, 0x47f8, 0x47f8, 0x47f8, 0x47f8, 0x458c, 0x458c, 0x458c,
+    0x458c, 0x459c, 0x459c, 0x459c, 0x459c, 0x478c, 0x478c, 0x478c, 0x478c, 0x479c, 0x479c, 0x479c,
+    0x479c, 0x4d4e, 0x4d4e, 0x4d5e, 0x4d5e, 0x4f4e, 0x4f4e, 0x4f5e, 0x4f5e, 0x4d2e, 0x4d2e, 0x4d3e,
+    0x4d3e, 0x4f2e, 0x4f2e, 0x4f3e, 0x4f3e, 0x450e, 0x450e, 0x450e, 0x450e, 0x451e, 0x451e, 0x451e,
+    0x451e, 0x470e, 0x470e, 0x470e, 0x470e, 0x471e, 0x471e, 0x471e, 0x471e, 0x4cef, 0x4cef, 0x4cff,
+    0x4cff, 0x4eef, 0x4eef, 0x4eff, 0x4eff, 0x4cee, 0x4cee, 0x4cfe, 0x4cfe, 0x4eee, 0x4eee, 0x4efe,
+    0x4efe, 0x3de7, 0x3de7, 0x3de7, 0x3de7, 0x3de7, 0x3de7, 0x3de7, 0x3de7, 0x3df7, 0x3df7, 0x3df7,
+    0x3df7, 0x3df7, 0x3df7, 0x3df7, 0x3df7, 0x3fe7, 0x3fe7, 0x3fe7, 0x3fe7, 0x3fe7, 0x3fe7, 0x3fe7,
+    0x3fe7, 0x3ff7, 0x3ff7, 0x3ff7, 0x3ff7, 0x3ff7, 0x3ff7, 0x3ff7, 0x3ff7, 0x3daa, 0x3daa, 0x3daa,
+    0x3daa, 0x3daa, 0x3daa, 0x3daa, 0x3daa, 0x3dba, 0x3dba, 0x3dba, 0x3dba, 0x3dba, 0x3dba, 0x3dba,
+    0x3dba, 0x3faa, 0x3faa, 0x3faa, 0x3faa, 0x3faa, 0x3faa, 0x3faa, 0x3faa, 0x3fba, 0x3fba, 0x3fba,
+    0x3fba, 0x3fba, 0x3fba, 0x3fba, 0x3fba, 0x454d, 0x454d, 0x454d, 0x454d, 0x455d, 0x455d, 0x455d,
+    0x455d, 0x474d, 0x474d, 0x474d, 0x474d, 0x475d, 0x475d, 0x475d, 0x475d, 0x456c, 0x456c, 0x456c,
+    0x456c, 0x457c, 0x457c, 0x457c, 0x457c, 0x476c, 0x476c, 0x476c, 0x476c, 0x477c, 0x477c, 0x477c,
+    0x477c, 0x458b, 0x458b, 0x458b, 0x458b, 0x459b, 0x459b, 0x459b, 0x459b, 0x478b, 0x478b, 0x478b,
+    0x478b, 0x479b, 0x479b, 0x479b, 0x479b, 0x45e6, 0x45e6, 0x45e6, 0x45e6, 0x45f6, 0x45f6, 0x45f6,
+    0x45f6, 0x47e6, 0x47e6, 0x47e6, 0x47e6, 0x47f6, 0x47f6, 0x47f6, 0x47f6, 0x3ccf, 0x3ccf, 0x3ccf,
+    0x3ccf, 0x3ccf, 0x3ccf, 0x3ccf, 0x3ccf, 0x3cdf, 0x3cdf, 0x3cdf, 0x3cdf, 0x3cdf, 0x3cdf, 0x3cdf,
+    0x3cdf, 0x3ecf, 0x3ecf, 0x3ecf, 0x3ecf, 0x3ecf, 0x3ecf, 0x3ecf, 0x3ecf, 0x3edf, 0x3edf, 0x3edf,
+    0x3edf, 0x3edf, 0x3edf, 0x3edf, 0x3edf, 0x3dc8, 0x3dc8, 0x3dc8, 0x3dc8, 0x3dc8, 0x3dc8, 0x3dc8,
+    0x3dc8, 0x3dd8, 0x3dd8, 0x3dd8, 0x3dd8, 0x3dd8, 0x3dd8, 0x3dd8, 0x3dd8, 0x3fc8, 0x3fc8, 0x3fc8,
+    0x3fc8, 0x3fc8, 0x3fc8, 0x3fc8, 0x3fc8, 0x3fd8, 0x3fd8, 0x3fd8, 0x3fd8, 0x3fd8, 0x3fd8, 0x3fd8,
+    0x3fd8, 0x3caf, 0x3caf, 0x3caf, 0x3caf, 0x3caf, 0x3caf, 0x3caf, 0x3caf, 0x3cbf, 0x3cbf, 0x3cbf,
+    0x3cbf, 0x3cbf, 0x3cbf, 0x3cbf, 0x3cbf, 0x3eaf, 0x3eaf, 0x3eaf, 0x3eaf, 0x3eaf, 0x3eaf, 0x3eaf,
+    0x3eaf, 0x3ebf, 0x3ebf, 0x3ebf, 0x3ebf, 0x3ebf, 0x3ebf, 0x3ebf, 0x3ebf, 0x3d2d, 0x3d2d, 0x3d2d,
+    0x3d2d, 0x3d2d, 0x3d2d, 0x3d2d, 0x3d2d, 0x3d3d, 0x3d3d, 0x3d3d, 0x3d3d, 0x3d3d, 0x3d3d, 0x3d3d,
+    0x3d3d, 0x3f2d, 0x3f2d, 0x3f2d, 0x3f2d, 0x3f2d, 0x3f2d, 0x3f2d, 0x3f2d, 0x3f3d, 0x3f3d, 0x3f3d,
+    0x3f3d, 0x3f3d, 0x3f3d, 0x3f3d, 0x3f3d, 0x3da9, 0x3da9, 0x3da9, 0x3da9, 0x3da9, 0x3da9, 0x3da9,
+    0x3da9, 0x3db9, 0x3db9, 0x3db9, 0x3db9, 0x3db9, 0x3db9, 0x3db9, 0x3db9, 0x3fa9, 0x3fa9, 0x3fa9,
+    0x3fa9, 0x3fa9, 0x3fa9, 0x3fa9, 0x3fa9, 0x3fb9, 0x3fb9, 0x3fb9, 0x3fb9, 0x3fb9, 0x3fb9, 0x3fb9,
+    0x3fb9, 0x3de5, 0x3de5, 0x3de5, 0x3de5, 0x3de5, 0x3de5, 0x3de5, 0x3de5, 0x3df5, 0x3df5, 0x3df5,
+    0x3df5, 0x3df5, 0x3df5, 0x3df5, 0x3df5, 0x3fe5, 0x3fe5, 0x3fe5, 0x3fe5, 0x3fe5, 0x3fe5, 0x3fe5,
+    0x3fe5, 0x3ff5, 0x3ff5, 0x3ff5, 0x3ff5, 0x3ff5, 0x3ff5, 0x3ff5, 0x3ff5, 0x3dc7, 0x3dc7, 0x3dc7,
+    0x3dc7, 0x3dc7, 0x3dc7, 0x3dc7, 0x3dc7, 0x3dd7, 0x3dd7, 0x3dd7, 0x3dd7, 0x3dd7, 0x3dd7, 0x3dd7,
+    0x3dd7, 0x3fc7, 0x3fc7, 0x3fc7, 0x3fc7, 0x3fc7, 0x3fc7, 0x3fc7, 0x3fc7, 0x3fd7, 0x3fd7, 0x3fd7,
+    0x3fd7, 0x3fd7, 0x3fd7, 0x3fd7, 0x3fd7, 0x3d4c, 0x3d4c, 0x3d4c, 0x3d4c, 0x3d4c, 0x3d4c, 0x3d4c,
+    0x3d4c, 0x3d5c, 0x3d5c, 0x3d5c, 0x3d5c, 0x3d5c, 0x3d5c, 0x3d5c, 0x3d5c, 0x3f4c, 0x3f4c, 0x3f4c,
+    0x3f4c, 0x3f4c, 0x3f4c, 0x3f4c, 0x3f4c, 0x3f5c, 0x3f5c, 0x3f5c, 0x3f5c, 0x3f5c, 0x3f5c, 0x3f5c,
+    0x3f5c, 0x3d6b, 0x3d6b, 0x3d6b, 0x3d6b, 0x3d6b, 0x3d6b, 0x3d6b, 0x3d6b, 0x3d7b, 0x3d7b, 0x3d7b,
+    0x3d7b, 0x3d7b, 0x3d7b, 0x3d7b, 0x3d7b, 0x3f6b, 0x3f6b, 0x3f6b, 0x3f6b, 0x3f6b, 0x3f6b, 0x3f6b,
+    0x3f6b, 0x3f7b, 0x3f7b, 0x3f7b, 0x3f7b, 0x3f7b, 0x3f7b, 0x3f7b, 0x3f7b, 0x3c8f, 0x3c8f, 0x3c8f,
+    0x3c8f, 0x3c8f, 0x3c8f, 0x3c8f, 0x3c8f, 0x3c9f, 0x3c9f, 0x3c9f, 0x3c9f, 0x3c9f, 0x3c9f, 0x3c9f,
+    0x3c9f, 0x3e8f, 0x3e8f, 0x3e8f, 0x3e8f, 0x3e8f, 0x3e8f, 0x3e8f, 0x3e8f, 0x3e9f, 0x3e9f, 0x3e9f,
+    0x3e9f, 0x3e9f, 0x3e9f, 0x3e9f, 0x3e9f, 0x3de4, 0x3de4, 0x3de4, 0x3de4, 0x3de4, 0x3de4, 0x3de4,
+    0x3de4, 0x3df4, 0x3df4, 0x3df4, 0x3df4, 0x3df4, 0x3df4, 0x3df4, 0x3df4, 0x3fe4, 0x3fe4, 0x3fe4,
+    0x3fe4, 0x3fe4, 0x3fe4, 0x3fe4, 0x3fe4, 0x3ff4, 0x3ff4, 0x3ff4, 0x3ff4, 0x3ff4, 0x3ff4, 0x3ff4,
+    0x3ff4, 0x458a, 0x458a, 0x458a, 0x458a, 0x459a, 0x459a, 0x459a, 0x459a, 0x478a, 0x478a, 0x478a,
+    0x478a, 0x479a, 0x479a, 0x479a, 0x479a, 0x45c6, 0x45c6, 0x45c6, 0x45c6, 0x45d6, 0x45d6, 0x45d6,
+    0x45d6, 0x47c6, 0x47c6, 0x47c6, 0x47c6, 0x47d6, 0x47d6, 0x47d6, 0x47d6, 0x3de3, 0x3de3, 0x3de3,
+    0x3de3, 0x3de3, 0x3de3, 0x3de3, 0x3de3, 0x3df3, 0x3df3, 0x3df3, 0x3df3, 0x3df3, 0x3df3, 0x3df3,
+    0x3df3, 0x3fe3, 0x3fe3, 0x3fe3, 0x3fe3, 0x3fe3, 0x3fe3, 0x3fe3, 0x3fe3, 0x3ff3, 0x3ff3, 0x3ff3,
+    0x3ff3, 0x3ff3, 0x3ff3, 0x3ff3, 0x3ff3, 0x346f, 0x346f, 0x346f, 0x346f, 0x346f, 0x346f, 0x346f,
+    0x346f, 0x346f, 0x346f, 0x346f, 0x346f, 0x346f, 0x346f, 0x346f, 0x346f, 0x347f, 0x347f, 0x347f,
+    0x347f, 0x347f, 0x347f, 0x347f, 0x347f, 0x347f, 0x347f, 0x347f, 0x347f, 0x347f, 0x347f, 0x347f,
+    0x347f, 0x366f, 0x366f, 0x366f, 0x366f, 0x366f, 0x366f, 0x366f, 0x366f, 0x366f, 0x366f, 0x366f,
+    0x366f, 0x366f, 0x366f, 0x366f, 0x366f, 0x367f, 0x367f, 0x367f, 0x367f, 0x367f, 0x367f, 0x367f,
+    0x367f, 0x367f, 0x367f, 0x367f, 0x367f, 0x367f, 0x367f, 0x367f, 0x367f, 0x3d0d, 0x3d0d, 0x3d0d,
+    0x3d0d, 0x3d0d, 0x3d0d, 0x3d0d, 0x3d0d, 0x3d1d, 0x3d1d, 0x3d1d, 0x3d1d, 0x3d1d, 0x3d1d, 0x3d1d,
+    0x3d1d, 0x3f0d, 0x3f0d, 0x3f0d, 0x3f0d, 0x3f0d, 0x3f0d, 0x3f0d, 0x3f0d, 0x3f1d, 0x3f1d, 0x3f1d,
+    0x3f1d, 0x3f1d, 0x3f1d, 0x3f1d, 0x3f1d, 0x3da8, 0x3da8, 0x3da8, 0x3da8, 0x3da8, 0x3da8, 0x3da8,
+    0x3da8, 0x3db8, 0x3db8, 0x3db8, 0x3db8, 0x3db8, 0x3db8, 0x3db8, 0x3db8, 0x3fa8, 0x3fa8, 0x3fa8,
+    0x3fa8, 0x3fa8, 0x3fa8, 0x3fa8, 0x3fa8, 0x3fb8, 0x3fb8, 0x3fb8, 0x3fb8, 0x3fb8, 0x3fb8, 0x3fb8,
+    0x3fb8, 0x204f, 0x204f, 0x21e2, 0x21e2, 0x28ce, 0x292c, 0x2c0f, 0x2c1f, 0x2989, 0x28ae, 0x214b,
+    0x214b, 0x28ed, 0x29a7, 0x208e, 0x208e, 0x2988, 0x29a6, 0x206e, 0x206e, 0x2169, 0x2169, 0x292b,
+    0x294a, 0x2c2f, 0x2c3f, 0x2e2f, 0x2e3f, 0x2de1, 0x2df1, 0x2fe1, 0x2ff1, 0x25e0, 0x27e0, 0x216a,
+    0x21c5, 0x21c4, 0x210c, 0x20cd, 0x21c3, 0x19c2, 0x19c2, 0x204e, 0x200e, 0x182e, 0x182e, 0x19c1,
+    0x19c1, 0x21c0, 0x20ad, 0x21a5, 0x20ec, 0x2187, 0x208d, 0x210b, 0x2168, 0x21a4, 0x212a, 0x2149,
+    0x20cc, 0x1986, 0x1986, 0x186d, 0x186d, 0x21a3, 0x20eb, 0x184d, 0x184d, 0x19a2, 0x19a2, 0x182d,
+    0x182d, 0x1967, 0x1967, 0x20ac, 0x2185, 0x2129, 0x20ea, 0x1983, 0x1983, 0x2147, 0x2127, 0x188b,
+    0x188b, 0x25a1, 0x25b1, 0x27a1, 0x27b1, 0x240d, 0x241d, 0x25a0, 0x27a0, 0x190a, 0x190a, 0x1948,
+    0x1948, 0x188c, 0x1984, 0x18cb, 0x1966, 0x106c, 0x106c, 0x104c, 0x104c, 0x1182, 0x1182, 0x10ab,
+    0x10ab, 0x1965, 0x1909, 0x102c, 0x102c, 0x1181, 0x1181, 0x1928, 0x180c, 0x1d80, 0x1f80, 0x1964,
+    0x18ca, 0x1946, 0x18e9, 0x106b, 0x106b, 0x1163, 0x1163, 0x1908, 0x18aa, 0x104b, 0x104b, 0x1945,
+    0x18c9, 0x1144, 0x1144, 0x18e8, 0x1907, 0x1124, 0x1124, 0x18e7, 0x18e6, 0x1d62, 0x1d72, 0x1f62,
+    0x1f72, 0x082b, 0x0961, 0x100b, 0x1160, 0x1126, 0x108a, 0x106a, 0x1143, 0x10a9, 0x1125, 0x084a,
+    0x0942, 0x082a, 0x0941, 0x100a, 0x10c8, 0x1540, 0x1740, 0x1106, 0x1089, 0x0923, 0x0923, 0x1069,
+    0x10a8, 0x1105, 0x10c7, 0x0849, 0x0922, 0x10a7, 0x10e5, 0x0868, 0x0868, 0x0903, 0x0903, 0x10c6,
+    0x1087, 0x10e4, 0x10a6, 0x10c5, 0x10e3, 0x0809, 0x0920, 0x0888, 0x0904, 0x08e2, 0x08e2, 0x1086,
+    0x10c4, 0x0867, 0x0847, 0x08a5, 0x0807, 0x08e0, 0x0866, 0x08c3, 0x0885, 0x08a4, 0x0846, 0x08c2,
+    0x0865, 0x08a3, 0x0884,
+    /* huffTable15[697] */
+    0x0009, 0xa200, 0x9a10, 0x9a18, 0xa220, 0x9a30, 0x9238, 0x9a3c, 0x9244, 0x9a48, 0x9250, 0x9254,
+    0x9258, 0x925c, 0x9260, 0x9264, 0x9a68, 0x9270, 0x9274, 0x9278, 0x8a7c, 0x927e, 0x8a82, 0x9284,
+    0x8a88, 0x8a8a, 0x8a8c, 0x928e, 0x8a92, 0x8a94, 0x9296, 0x4982, 0x8a9a, 0x8a9c, 0x8a9e, 0x8aa0,
+    0x8aa2, 0x8aa4, 0x4963, 0x8aa6, 0x8aa8, 0x4962, 0x8aaa, 0x4961, 0x8aac, 0x8aae, 0x8ab0, 0x8ab2,
+    0x4943, 0x48a9, 0x4925, 0x484a, 0x4942, 0x482a, 0x4941, 0x8ab4, 0x48c8, 0x4906, 0x4889, 0x4924,
+    0x4869, 0x4923, 0x8ab6, 0x48a8, 0x4905, 0x4849, 0x48c7, 0x48e6, 0x4922, 0x4121, 0x4121, 0x4829,
+    0x4920, 0x4888, 0x4904, 0x48a7, 0x48e5, 0x4868, 0x4903, 0x48c6, 0x4887, 0x4048, 0x4048, 0x4102,
+    0x4102, 0x4028, 0x4028, 0x4101, 0x4101, 0x48e4, 0x4808, 0x4900, 0x48a6, 0x48c5, 0x4867, 0x48e3,
+    0x4886, 0x4047, 0x4047, 0x40e2, 0x40e2, 0x40c4, 0x40c4, 0x4027, 0x4027, 0x40a5, 0x40a5, 0x40e1,
+    0x40e1, 0x4807, 0x48e0, 0x4066, 0x4066, 0x40c3, 0x40c3, 0x4085, 0x4085, 0x40a4, 0x40a4, 0x4046,
+    0x4046, 0x40c2, 0x40c2, 0x4026, 0x4026, 0x4806, 0x48c0, 0x4065, 0x4065, 0x4cc1, 0x4cd1, 0x4ec1,
+    0x4ed1, 0x40a3, 0x40a3, 0x4084, 0x4084, 0x4c45, 0x4c55, 0x4e45, 0x4e55, 0x4ca2, 0x4cb2, 0x4ea2,
+    0x4eb2, 0x4c25, 0x4c35, 0x4e25, 0x4e35, 0x4ca1, 0x4cb1, 0x4ea1, 0x4eb1, 0x4c05, 0x4c15, 0x4ca0,
+    0x4ea0, 0x4c64, 0x4c74, 0x4e64, 0x4e74, 0x4c83, 0x4c93, 0x4e83, 0x4e93, 0x4c44, 0x4c54, 0x4e44,
+    0x4e54, 0x4c82, 0x4c92, 0x4e82, 0x4e92, 0x4c63, 0x4c73, 0x4e63, 0x4e73, 0x4481, 0x4481, 0x4491,
+    0x4491, 0x4681, 0x4681, 0x4691, 0x4691, 0x4c24, 0x4c34, 0x4e24, 0x4e34, 0x4404, 0x4404, 0x4414,
+    0x4414, 0x4443, 0x4443, 0x4453, 0x4453, 0x4643, 0x4643, 0x4653, 0x4653, 0x4462, 0x4462, 0x4472,
+    0x4472, 0x4662, 0x4662, 0x4672, 0x4672, 0x4480, 0x4480, 0x4680, 0x4680, 0x4403, 0x4403, 0x4413,
+    0x4413, 0x4423, 0x4423, 0x4433, 0x4433, 0x4623, 0x4623, 0x4633, 0x4633, 0x4461, 0x4461, 0x4471,
+    0x4471, 0x4661, 0x4661, 0x4671, 0x4671, 0x3c60, 0x3c60, 0x3c60, 0x3c60, 0x3e60, 0x3e60, 0x3e60,
+    0x3e60, 0x3c42, 0x3c42, 0x3c42, 0x3c42, 0x3c52, 0x3c52, 0x3c52, 0x3c52, 0x3e42, 0x3e42, 0x3e42,
+    0x3e42, 0x3e52, 0x3e52, 0x3e52, 0x3e52, 0x3c22, 0x3c22, 0x3c22, 0x3c22, 0x3c32, 0x3c32, 0x3c32,
+    0x3c32, 0x3e22, 0x3e22, 0x3e22, 0x3e22, 0x3e32, 0x3e32, 0x3e32, 0x3e32, 0x3c41, 0x3c41, 0x3c41,
+    0x3c41, 0x3c51, 0x3c51, 0x3c51, 0x3c51, 0x3e41, 0x3e41, 0x3e41, 0x3e41, 0x3e51, 0x3e51, 0x3e51,
+    0x3e51, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3402, 0x3412, 0x3412, 0x3412,
+    0x3412, 0x3412, 0x3412, 0x3412, 0x3412, 0x3440, 0x3440, 0x3440, 0x3440, 0x3440, 0x3440, 0x3440,
+    0x3440, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x3640, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21, 0x2c21,
+    0x2c21, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31,
+    0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2c31, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21,
+    0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e21, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31, 0x2e31,
+    0x2e31, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01,
+    0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11,
+    0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c20, 0x2c20, 0x2c20,
+    0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20,
+    0x2c20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20,
+    0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00,
+    0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x1c00, 0x21ef, 0x21cf, 0x21ee,
+    0x21af, 0x19ce, 0x19ce, 0x21ed, 0x218f, 0x21ec, 0x21ae, 0x21cd, 0x216f, 0x19eb, 0x19eb, 0x218e,
+    0x21cc, 0x19ad, 0x194f, 0x19ea, 0x196e, 0x19cb, 0x198d, 0x19ac, 0x192f, 0x19e9, 0x19ca, 0x196d,
+    0x19ab, 0x190f, 0x19e8, 0x198c, 0x192e, 0x19c9, 0x19c9, 0x18ef, 0x18ef, 0x19e7, 0x19e7, 0x194d,
+    0x194d, 0x19aa, 0x19aa, 0x196c, 0x196c, 0x18cf, 0x18cf, 0x214e, 0x200f, 0x118b, 0x118b, 0x11e6,
+    0x11e6, 0x190e, 0x19c8, 0x18af, 0x192d, 0x11e5, 0x10ee, 0x11c7, 0x114c, 0x118a, 0x118a, 0x116b,
+    0x116b, 0x19a9, 0x190d, 0x108f, 0x108f, 0x11e4, 0x106f, 0x11e3, 0x11a8, 0x11c6, 0x11c6, 0x104f,
+    0x104f, 0x11e2, 0x11e2, 0x18ce, 0x19e0, 0x102f, 0x11e1, 0x112c, 0x1189, 0x10ae, 0x114b, 0x116a,
+    0x11c5, 0x10ed, 0x11a7, 0x108e, 0x11c4, 0x110c, 0x1188, 0x106e, 0x10cd, 0x11a6, 0x11c3, 0x112b,
+    0x1169, 0x104e, 0x114a, 0x11c2, 0x102e, 0x11c1, 0x11c1, 0x180e, 0x19c0, 0x10ad, 0x10ad, 0x11a5,
+    0x11a5, 0x10ec, 0x1187, 0x108d, 0x110b, 0x09a4, 0x09a4, 0x1168, 0x112a, 0x1149, 0x10cc, 0x1186,
+    0x106d, 0x09a3, 0x09a2, 0x104d, 0x100d, 0x082d, 0x082d, 0x08eb, 0x0967, 0x09a1, 0x09a1, 0x10ac,
+    0x11a0, 0x0985, 0x090a, 0x0948, 0x088c, 0x0984, 0x08cb, 0x0966, 0x0966, 0x1129, 0x100c, 0x086c,
+    0x0983, 0x08ea, 0x0947, 0x0946, 0x0946, 0x1180, 0x100b, 0x084c, 0x08ab, 0x0965, 0x082c, 0x0909,
+    0x0928, 0x0981, 0x088b, 0x0964, 0x08ca, 0x086b, 0x08e9, 0x0927, 0x0908, 0x084b, 0x08aa, 0x0945,
+    0x082b, 0x0960, 0x08c9, 0x0926, 0x088a, 0x0944, 0x08e8, 0x0907, 0x086a, 0x080a, 0x0940, 0x08e7,
+    0x0809,
+    /* huffTable16[1015] */
+    0x0009, 0x9200, 0x9204, 0x9208, 0x920c, 0x8a10, 0x8a12, 0x41ef, 0x41ef, 0x8a14, 0x488f, 0x49e4,
+    0x49e3, 0x49e0, 0xc216, 0x41e2, 0x41e2, 0x484f, 0x480f, 0x402f, 0x402f, 0x41e1, 0x41e1, 0xab16,
+    0xab36, 0xa356, 0xa366, 0xa376, 0x9b86, 0x9b8e, 0x9b96, 0x9b9e, 0x9ba6, 0x9bae, 0x9bb6, 0x93be,
+    0x93c2, 0x8bc6, 0x93c8, 0x93cc, 0x93d0, 0x93d4, 0x93d8, 0x8bdc, 0x93de, 0x93e2, 0x8be6, 0x93e8,
+    0x4827, 0x48e1, 0x8bec, 0x8bee, 0x8bf0, 0x48c2, 0x4826, 0x48c1, 0x8bf2, 0x48a3, 0x8bf4, 0x4845,
+    0x48a2, 0x40a1, 0x40a1, 0x4825, 0x4805, 0x4864, 0x4883, 0x48a0, 0x4844, 0x4882, 0x4863, 0x4024,
+    0x4024, 0x4081, 0x4081, 0x4804, 0x4880, 0x4043, 0x4043, 0x4062, 0x4062, 0x4c23, 0x4c33, 0x4e23,
+    0x4e33, 0x4c61, 0x4c71, 0x4e61, 0x4e71, 0x4c03, 0x4c13, 0x4c60, 0x4e60, 0x4c42, 0x4c52, 0x4e42,
+    0x4e52, 0x4422, 0x4422, 0x4432, 0x4432, 0x4622, 0x4622, 0x4632, 0x4632, 0x4441, 0x4441, 0x4451,
+    0x4451, 0x4641, 0x4641, 0x4651, 0x4651, 0x3c02, 0x3c02, 0x3c02, 0x3c02, 0x3c12, 0x3c12, 0x3c12,
+    0x3c12, 0x3c40, 0x3c40, 0x3c40, 0x3c40, 0x3e40, 0x3e40, 0x3e40, 0x3e40, 0x3421, 0x3421, 0x3421,
+    0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3431, 0x3431, 0x3431, 0x3431, 0x3431, 0x3431, 0x3431,
+    0x3431, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3631, 0x3631, 0x3631,
+    0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01,
+    0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c11, 0x2c11, 0x2c11,
+    0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11,
+    0x2c11, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420,
+    0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2420, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x2620,
+    0x2620, 0x2620, 0x2620, 0x2620, 0x2620, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00,
+    0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x0c00, 0x11cf, 0x11ee, 0x11af,
+    0x11ed, 0x118f, 0x11ec, 0x116f, 0x11eb, 0x094f, 0x094f, 0x11ea, 0x112f, 0x11e9, 0x11e8, 0x090f,
+    0x090f, 0x08ef, 0x09e7, 0x08cf, 0x09e6, 0x08af, 0x09e5, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f, 0x086f,
+    0x086f, 0x086f, 0x086f, 0x398e, 0x398e, 0x41cc, 0x41ad, 0x45ae, 0x45be, 0x47ae, 0x47be, 0x45c9,
+    0x45d9, 0x47c9, 0x47d9, 0x39ca, 0x39ca, 0x39a9, 0x39a9, 0x3dce, 0x3dce, 0x3dde, 0x3dde, 0x3fce,
+    0x3fce, 0x3fde, 0x3fde, 0x45cd, 0x45dd, 0x47cd, 0x47dd, 0x45cb, 0x45db, 0x47cb, 0x47db, 0x3d6e,
+    0x3d6e, 0x3d7e, 0x3d7e, 0x3f6e, 0x3f6e, 0x3f7e, 0x3f7e, 0x3d8d, 0x3d8d, 0x3d9d, 0x3d9d, 0x3f8d,
+    0x3f8d, 0x3f9d, 0x3f9d, 0x45ac, 0x45bc, 0x47ac, 0x47bc, 0x45ab, 0x45bb, 0x47ab, 0x47bb, 0x3d4e,
+    0x3d4e, 0x3d5e, 0x3d5e, 0x3f4e, 0x3f4e, 0x3f5e, 0x3f5e, 0x3d8c, 0x3d8c, 0x3d9c, 0x3d9c, 0x3f8c,
+    0x3f8c, 0x3f9c, 0x3f9c, 0x454d, 0x455d, 0x474d, 0x475d, 0x45aa, 0x45ba, 0x47aa, 0x47ba, 0x44ee,
+    0x44fe, 0x46ee, 0x46fe, 0x454c, 0x455c, 0x474c, 0x475c, 0x3d8a, 0x3d8a, 0x3d9a, 0x3d9a, 0x3f8a,
+    0x3f8a, 0x3f9a, 0x3f9a, 0x4589, 0x4599, 0x4789, 0x4799, 0x44ed, 0x44fd, 0x46ed, 0x46fd, 0x3cae,
+    0x3cae, 0x3cbe, 0x3cbe, 0x3eae, 0x3eae, 0x3ebe, 0x3ebe, 0x356d, 0x356d, 0x356d, 0x356d, 0x357d,
+    0x357d, 0x357d, 0x357d, 0x376d, 0x376d, 0x376d, 0x376d, 0x377d, 0x377d, 0x377d, 0x377d, 0x212e,
+    0x212e, 0x296c, 0x298b, 0x290e, 0x29c8, 0x292d, 0x29c7, 0x296b, 0x290d, 0x29a8, 0x28ce, 0x21c6,
+    0x21c6, 0x212c, 0x212c, 0x294b, 0x296a, 0x29c5, 0x29a7, 0x208e, 0x208e, 0x29c4, 0x290c, 0x2188,
+    0x2188, 0x206e, 0x206e, 0x20cd, 0x20cd, 0x29a6, 0x292b, 0x2969, 0x294a, 0x21c1, 0x21c1, 0x21a4,
+    0x21a4, 0x2968, 0x2949, 0x20eb, 0x20eb, 0x2967, 0x29a0, 0x2dc3, 0x2dd3, 0x2fc3, 0x2fd3, 0x2c0e,
+    0x2c1e, 0x2dc0, 0x2fc0, 0x20ad, 0x20ad, 0x21a5, 0x21a5, 0x20ec, 0x20ec, 0x2187, 0x2187, 0x208d,
+    0x208d, 0x210b, 0x210b, 0x212a, 0x20cc, 0x2186, 0x206d, 0x20ac, 0x2185, 0x240d, 0x241d, 0x210a,
+    0x2148, 0x2129, 0x208c, 0x2166, 0x20ea, 0x186c, 0x186c, 0x20ab, 0x2109, 0x182c, 0x182c, 0x2580,
+    0x2780, 0x2128, 0x20e9, 0x25c2, 0x25d2, 0x27c2, 0x27d2, 0x184e, 0x184e, 0x182e, 0x182e, 0x19a3,
+    0x19a3, 0x184d, 0x184d, 0x19a2, 0x19a2, 0x19a1, 0x19a1, 0x186b, 0x186b, 0x2127, 0x2108, 0x242d,
+    0x243d, 0x262d, 0x263d, 0x1984, 0x18cb, 0x1983, 0x1947, 0x104c, 0x104c, 0x1982, 0x1965, 0x1981,
+    0x180c, 0x188b, 0x1964, 0x18ca, 0x1946, 0x1163, 0x1163, 0x18aa, 0x1945, 0x104b, 0x104b, 0x1162,
+    0x1162, 0x102b, 0x102b, 0x1161, 0x1161, 0x180b, 0x1960, 0x18c9, 0x1926, 0x188a, 0x1944, 0x18e8,
+    0x1907, 0x1143, 0x1143, 0x186a, 0x18a9, 0x104a, 0x104a, 0x1925, 0x18c8, 0x1141, 0x1141, 0x1906,
+    0x18e7, 0x1124, 0x1124, 0x1889, 0x18a7, 0x10c7, 0x10c7, 0x1d42, 0x1d52, 0x1f42, 0x1f52, 0x082a,
+    0x082a, 0x100a, 0x1140, 0x1069, 0x1123, 0x10a8, 0x1105, 0x0849, 0x0922, 0x10e6, 0x1009, 0x0829,
+    0x0829, 0x0921, 0x0921, 0x1120, 0x1088, 0x1104, 0x10e5, 0x1068, 0x1103, 0x10c6, 0x1048, 0x0902,
+    0x0902, 0x1087, 0x10e4, 0x0828, 0x0828, 0x0901, 0x0900, 0x1008, 0x10a6, 0x0867, 0x0867, 0x08e3,
+    0x08e3, 0x10c5, 0x1086, 0x0847, 0x08e2, 0x10c4, 0x10a5, 0x1407, 0x1417, 0x08e0, 0x0866, 0x08c3,
+    0x0885, 0x08a4, 0x0846, 0x0806, 0x08c0, 0x0865, 0x0884,
+    /* huffTable24[653] */
+    0x0009, 0x41cf, 0x41cf, 0x41ee, 0x41ee, 0x41af, 0x41af, 0x41ed, 0x41ed, 0x418f, 0x418f, 0x41ec,
+    0x41ec, 0x416f, 0x416f, 0x41eb, 0x41eb, 0x39ea, 0x39ea, 0x39ea, 0x39ea, 0x414f, 0x414f, 0x412f,
+    0x412f, 0x39e9, 0x39e9, 0x39e9, 0x39e9, 0x39e8, 0x39e8, 0x39e8, 0x39e8, 0x410f, 0x410f, 0x40ef,
+    0x40ef, 0x39e7, 0x39e7, 0x39e7, 0x39e7, 0x38cf, 0x38cf, 0x38cf, 0x38cf, 0x39e6, 0x39e6, 0x39e6,
+    0x39e6, 0x38af, 0x38af, 0x38af, 0x38af, 0x39e5, 0x39e5, 0x39e5, 0x39e5, 0x388f, 0x388f, 0x388f,
+    0x388f, 0x39e4, 0x39e4, 0x39e4, 0x39e4, 0x386f, 0x386f, 0x386f, 0x386f, 0x39e3, 0x39e3, 0x39e3,
+    0x39e3, 0x384f, 0x384f, 0x384f, 0x384f, 0x39e2, 0x39e2, 0x39e2, 0x39e2, 0x39e1, 0x39e1, 0x39e1,
+    0x39e1, 0x402f, 0x402f, 0x41e0, 0x41e0, 0x480f, 0x9200, 0x9204, 0x9208, 0x920c, 0x9210, 0x9214,
+    0x9218, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef,
+    0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef,
+    0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x21ef, 0x921c, 0x9a20, 0x9228,
+    0x8a2c, 0x922e, 0x8a32, 0x8a34, 0x9236, 0x8a3a, 0x8a3c, 0x8a3e, 0x8a40, 0x8a42, 0x8a44, 0x8a46,
+    0x8a48, 0x8a4a, 0x8a4c, 0x8a4e, 0x8a50, 0x8a52, 0x8a54, 0x8a56, 0x8a58, 0x8a5a, 0x8a5c, 0x8a5e,
+    0x9260, 0x8a64, 0x8a66, 0x8a68, 0x8a6a, 0x8a6c, 0x8a6e, 0x9270, 0x9274, 0x4964, 0x8a78, 0x8a7a,
+    0x927c, 0x4963, 0x4908, 0x8a80, 0x4962, 0x8a82, 0x8a84, 0x4926, 0x4944, 0x8a86, 0x4907, 0x486a,
+    0x4943, 0x48a9, 0x4925, 0x484a, 0x4942, 0x4941, 0x48c8, 0x4906, 0x48e7, 0x4889, 0x4924, 0x4869,
+    0x4923, 0x48a8, 0x4905, 0x4849, 0x48c7, 0x48e6, 0x4922, 0x4829, 0x4921, 0x4888, 0x4904, 0x48a7,
+    0x48e5, 0x4868, 0x4903, 0x48c6, 0x4848, 0x4902, 0x4828, 0x4887, 0x48e4, 0x4901, 0x8a88, 0x48a6,
+    0x48c5, 0x4827, 0x8a8a, 0x40e3, 0x40e3, 0x4867, 0x4847, 0x40e2, 0x40e2, 0x4086, 0x4086, 0x40c4,
+    0x40c4, 0x40a5, 0x40a5, 0x40e1, 0x40e1, 0x4066, 0x4066, 0x40c3, 0x40c3, 0x4085, 0x4085, 0x40a4,
+    0x40a4, 0x4046, 0x4046, 0x40c2, 0x40c2, 0x4026, 0x4026, 0x40c1, 0x40c1, 0x4806, 0x48c0, 0x4065,
+    0x4065, 0x40a3, 0x40a3, 0x4084, 0x4084, 0x4045, 0x4045, 0x40a2, 0x40a2, 0x4025, 0x4025, 0x4805,
+    0x48a0, 0x4ca1, 0x4cb1, 0x4ea1, 0x4eb1, 0x4064, 0x4064, 0x4083, 0x4083, 0x4c44, 0x4c54, 0x4e44,
+    0x4e54, 0x4c82, 0x4c92, 0x4e82, 0x4e92, 0x4c63, 0x4c73, 0x4e63, 0x4e73, 0x4c24, 0x4c34, 0x4e24,
+    0x4e34, 0x4c81, 0x4c91, 0x4e81, 0x4e91, 0x4c04, 0x4c14, 0x4c80, 0x4e80, 0x4c43, 0x4c53, 0x4e43,
+    0x4e53, 0x4c62, 0x4c72, 0x4e62, 0x4e72, 0x4423, 0x4423, 0x4433, 0x4433, 0x4623, 0x4623, 0x4633,
+    0x4633, 0x4461, 0x4461, 0x4471, 0x4471, 0x4661, 0x4661, 0x4671, 0x4671, 0x4403, 0x4403, 0x4413,
+    0x4413, 0x4460, 0x4460, 0x4660, 0x4660, 0x4442, 0x4442, 0x4452, 0x4452, 0x4642, 0x4642, 0x4652,
+    0x4652, 0x3c22, 0x3c22, 0x3c22, 0x3c22, 0x3c32, 0x3c32, 0x3c32, 0x3c32, 0x3e22, 0x3e22, 0x3e22,
+    0x3e22, 0x3e32, 0x3e32, 0x3e32, 0x3e32, 0x3c41, 0x3c41, 0x3c41, 0x3c41, 0x3c51, 0x3c51, 0x3c51,
+    0x3c51, 0x3e41, 0x3e41, 0x3e41, 0x3e41, 0x3e51, 0x3e51, 0x3e51, 0x3e51, 0x3c02, 0x3c02, 0x3c02,
+    0x3c02, 0x3c12, 0x3c12, 0x3c12, 0x3c12, 0x3c40, 0x3c40, 0x3c40, 0x3c40, 0x3e40, 0x3e40, 0x3e40,
+    0x3e40, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3421, 0x3431, 0x3431, 0x3431,
+    0x3431, 0x3431, 0x3431, 0x3431, 0x3431, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621, 0x3621,
+    0x3621, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x3631, 0x2c01, 0x2c01, 0x2c01,
+    0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01, 0x2c01,
+    0x2c01, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11,
+    0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c11, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20,
+    0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2c20, 0x2e20, 0x2e20, 0x2e20,
+    0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20, 0x2e20,
+    0x2e20, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400,
+    0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400,
+    0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x2400, 0x11ce, 0x11ae, 0x11cd,
+    0x118e, 0x11cc, 0x11ad, 0x116e, 0x11cb, 0x118d, 0x11ac, 0x114e, 0x11ca, 0x116d, 0x11ab, 0x118c,
+    0x112e, 0x11c9, 0x114d, 0x11aa, 0x116c, 0x118b, 0x110e, 0x11c8, 0x112d, 0x11a9, 0x10ee, 0x11c7,
+    0x114c, 0x118a, 0x116b, 0x110d, 0x11a8, 0x180e, 0x19c0, 0x1c0d, 0x1c1d, 0x1dc6, 0x1dd6, 0x1fc6,
+    0x1fd6, 0x10ce, 0x112c, 0x0989, 0x0989, 0x08ae, 0x096a, 0x09c5, 0x09c5, 0x114b, 0x10ed, 0x09a7,
+    0x09c4, 0x090c, 0x0988, 0x108e, 0x104e, 0x086e, 0x086e, 0x08cd, 0x09a6, 0x09c3, 0x092b, 0x0969,
+    0x094a, 0x09c2, 0x082e, 0x09c1, 0x08ad, 0x09a5, 0x08ec, 0x0987, 0x088d, 0x090b, 0x0968, 0x09a4,
+    0x092a, 0x0949, 0x08cc, 0x0986, 0x086d, 0x09a3, 0x084d, 0x09a2, 0x082d, 0x08eb, 0x0967, 0x09a1,
+    0x08ac, 0x0985, 0x090a, 0x0948, 0x0929, 0x088c, 0x0984, 0x08cb, 0x0966, 0x11a0, 0x100c, 0x086c,
+    0x086c, 0x0983, 0x08ea, 0x0947, 0x084c, 0x0982, 0x08ab, 0x0965, 0x082c, 0x0909, 0x0928, 0x0981,
+    0x088b, 0x1180, 0x100b, 0x086b, 0x086b, 0x1160, 0x100a, 0x082a, 0x082a, 0x08ca, 0x0946, 0x08e9,
+    0x0927, 0x1140, 0x1009, 0x1520, 0x1720, 0x084b, 0x08aa, 0x0945, 0x082b, 0x0961, 0x08c9, 0x088a,
+    0x08e8, 0x0808, 0x0900, 0x0807, 0x08e0,
 };
 /* pow(2,-i/4) * pow(j,4/3) for i=0..3 j=0..15, Q25 format */
 const int32_t pow43_14[4][16] PROGMEM = { /* Q28 */
@@ -529,19 +903,95 @@ const uint32_t fastWin36[18] PROGMEM = {
         0x4a868feb, 0xef7a6275, 0x47311c28, 0xf6a09e67, 0x42aace8b, 0xfd16d8dd
 };
 
-/* tables for quadruples
- * format 0xAB
- *  A = length of codeword
- *  B = codeword
+/* tables for quadruples, indexed by the codeword and the next 4 bits, so the sign bits are always included
+ * format 0x0NSV
+ *  N = bits to consume (codeword + signs)
+ *  S = sign bits of v w x y
+ *  V = magnitudes of v w x y
  */
-const uint8_t quadTable[64+16] PROGMEM = {
-    /* table A */
-    0x6b, 0x6f, 0x6d, 0x6e, 0x67, 0x65, 0x59, 0x59, 0x56, 0x56, 0x53, 0x53, 0x5a, 0x5a, 0x5c, 0x5c,
-    0x42, 0x42, 0x42, 0x42, 0x41, 0x41, 0x41, 0x41, 0x44, 0x44, 0x44, 0x44, 0x48, 0x48, 0x48, 0x48,
-    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
-    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
-    /* table B */
-    0x4f, 0x4e, 0x4d, 0x4c, 0x4b, 0x4a, 0x49, 0x48, 0x47, 0x46, 0x45, 0x44, 0x43, 0x42, 0x41, 0x40,
+const uint16_t quadTable[1024+256] PROGMEM = {
+    /* table A[1024] */
+    0x90b, 0x90b, 0x91b, 0x91b, 0x92b, 0x92b, 0x93b, 0x93b, 0x98b, 0x98b, 0x99b, 0x99b, 0x9ab, 0x9ab, 0x9bb, 0x9bb,
+    0xa0f, 0xa1f, 0xa2f, 0xa3f, 0xa4f, 0xa5f, 0xa6f, 0xa7f, 0xa8f, 0xa9f, 0xaaf, 0xabf, 0xacf, 0xadf, 0xaef, 0xaff,
+    0x90d, 0x90d, 0x91d, 0x91d, 0x94d, 0x94d, 0x95d, 0x95d, 0x98d, 0x98d, 0x99d, 0x99d, 0x9cd, 0x9cd, 0x9dd, 0x9dd,
+    0x90e, 0x90e, 0x92e, 0x92e, 0x94e, 0x94e, 0x96e, 0x96e, 0x98e, 0x98e, 0x9ae, 0x9ae, 0x9ce, 0x9ce, 0x9ee, 0x9ee,
+    0x907, 0x907, 0x917, 0x917, 0x927, 0x927, 0x937, 0x937, 0x947, 0x947, 0x957, 0x957, 0x967, 0x967, 0x977, 0x977,
+    0x805, 0x805, 0x805, 0x805, 0x815, 0x815, 0x815, 0x815, 0x845, 0x845, 0x845, 0x845, 0x855, 0x855, 0x855, 0x855,
+    0x709, 0x709, 0x709, 0x709, 0x709, 0x709, 0x709, 0x709, 0x719, 0x719, 0x719, 0x719, 0x719, 0x719, 0x719, 0x719,
+    0x789, 0x789, 0x789, 0x789, 0x789, 0x789, 0x789, 0x789, 0x799, 0x799, 0x799, 0x799, 0x799, 0x799, 0x799, 0x799,
+    0x706, 0x706, 0x706, 0x706, 0x706, 0x706, 0x706, 0x706, 0x726, 0x726, 0x726, 0x726, 0x726, 0x726, 0x726, 0x726,
+    0x746, 0x746, 0x746, 0x746, 0x746, 0x746, 0x746, 0x746, 0x766, 0x766, 0x766, 0x766, 0x766, 0x766, 0x766, 0x766,
+    0x703, 0x703, 0x703, 0x703, 0x703, 0x703, 0x703, 0x703, 0x713, 0x713, 0x713, 0x713, 0x713, 0x713, 0x713, 0x713,
+    0x723, 0x723, 0x723, 0x723, 0x723, 0x723, 0x723, 0x723, 0x733, 0x733, 0x733, 0x733, 0x733, 0x733, 0x733, 0x733,
+    0x70a, 0x70a, 0x70a, 0x70a, 0x70a, 0x70a, 0x70a, 0x70a, 0x72a, 0x72a, 0x72a, 0x72a, 0x72a, 0x72a, 0x72a, 0x72a,
+    0x78a, 0x78a, 0x78a, 0x78a, 0x78a, 0x78a, 0x78a, 0x78a, 0x7aa, 0x7aa, 0x7aa, 0x7aa, 0x7aa, 0x7aa, 0x7aa, 0x7aa,
+    0x70c, 0x70c, 0x70c, 0x70c, 0x70c, 0x70c, 0x70c, 0x70c, 0x74c, 0x74c, 0x74c, 0x74c, 0x74c, 0x74c, 0x74c, 0x74c,
+    0x78c, 0x78c, 0x78c, 0x78c, 0x78c, 0x78c, 0x78c, 0x78c, 0x7cc, 0x7cc, 0x7cc, 0x7cc, 0x7cc, 0x7cc, 0x7cc, 0x7cc,
+    0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502,
+    0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502,
+    0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522,
+    0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522,
+    0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501,
+    0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501,
+    0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511,
+    0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511,
+    0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504,
+    0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504,
+    0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544,
+    0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544,
+    0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508,
+    0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508,
+    0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588,
+    0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x100,
+    /* table B[256] */
+    0x80f, 0x81f, 0x82f, 0x83f, 0x84f, 0x85f, 0x86f, 0x87f, 0x88f, 0x89f, 0x8af, 0x8bf, 0x8cf, 0x8df, 0x8ef, 0x8ff,
+    0x70e, 0x70e, 0x72e, 0x72e, 0x74e, 0x74e, 0x76e, 0x76e, 0x78e, 0x78e, 0x7ae, 0x7ae, 0x7ce, 0x7ce, 0x7ee, 0x7ee,
+    0x70d, 0x70d, 0x71d, 0x71d, 0x74d, 0x74d, 0x75d, 0x75d, 0x78d, 0x78d, 0x79d, 0x79d, 0x7cd, 0x7cd, 0x7dd, 0x7dd,
+    0x60c, 0x60c, 0x60c, 0x60c, 0x64c, 0x64c, 0x64c, 0x64c, 0x68c, 0x68c, 0x68c, 0x68c, 0x6cc, 0x6cc, 0x6cc, 0x6cc,
+    0x70b, 0x70b, 0x71b, 0x71b, 0x72b, 0x72b, 0x73b, 0x73b, 0x78b, 0x78b, 0x79b, 0x79b, 0x7ab, 0x7ab, 0x7bb, 0x7bb,
+    0x60a, 0x60a, 0x60a, 0x60a, 0x62a, 0x62a, 0x62a, 0x62a, 0x68a, 0x68a, 0x68a, 0x68a, 0x6aa, 0x6aa, 0x6aa, 0x6aa,
+    0x609, 0x609, 0x609, 0x609, 0x619, 0x619, 0x619, 0x619, 0x689, 0x689, 0x689, 0x689, 0x699, 0x699, 0x699, 0x699,
+    0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x508, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588, 0x588,
+    0x707, 0x707, 0x717, 0x717, 0x727, 0x727, 0x737, 0x737, 0x747, 0x747, 0x757, 0x757, 0x767, 0x767, 0x777, 0x777,
+    0x606, 0x606, 0x606, 0x606, 0x626, 0x626, 0x626, 0x626, 0x646, 0x646, 0x646, 0x646, 0x666, 0x666, 0x666, 0x666,
+    0x605, 0x605, 0x605, 0x605, 0x615, 0x615, 0x615, 0x615, 0x645, 0x645, 0x645, 0x645, 0x655, 0x655, 0x655, 0x655,
+    0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x504, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544, 0x544,
+    0x603, 0x603, 0x603, 0x603, 0x613, 0x613, 0x613, 0x613, 0x623, 0x623, 0x623, 0x623, 0x633, 0x633, 0x633, 0x633,
+    0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x502, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522, 0x522,
+    0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x501, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511, 0x511,
+    0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400, 0x400,
 };
 
 /* indexing = [version][layer][bitrate index]
@@ -748,92 +1198,92 @@ int32_t CalcBitsUsed(BitStreamInfo_t *bsi, uint8_t *startBuf, int32_t startOffse
     return bitsUsed;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t CheckPadBit(){
-    return (m_FrameHeader->paddingBit ? 1 : 0);
+int32_t CheckPadBit(MP3Decoder_t* md){
+    return (md->frameHeader->paddingBit ? 1 : 0);
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t UnpackFrameHeader(uint8_t *buf){
+int32_t UnpackFrameHeader(MP3Decoder_t* md, uint8_t *buf){
    int32_t verIdx;
     /* validate pointers and sync word */
     if ((buf[0] & m_SYNCWORDH) != m_SYNCWORDH || (buf[1] & m_SYNCWORDL) != m_SYNCWORDL){return -1;}
     /* read header fields - use bitmasks instead of GetBits() for speed, since format never varies */
     verIdx = (buf[1] >> 3) & 0x03;
-    m_MPEGVersion = (MPEGVersion_t) (verIdx == 0 ? MPEG25 : ((verIdx & 0x01) ? MPEG1 : MPEG2));
-    m_FrameHeader->layer = 4 - ((buf[1] >> 1) & 0x03); /* easy mapping of index to layer number, 4 = error */
-    m_FrameHeader->crc = 1 - ((buf[1] >> 0) & 0x01);
-    m_FrameHeader->brIdx = (buf[2] >> 4) & 0x0f;
-    m_FrameHeader->srIdx = (buf[2] >> 2) & 0x03;
-    m_FrameHeader->paddingBit = (buf[2] >> 1) & 0x01;
-    m_FrameHeader->privateBit = (buf[2] >> 0) & 0x01;
-    m_sMode = (StereoMode_t) ((buf[3] >> 6) & 0x03); /* maps to correct enum (see definition) */
-    m_FrameHeader->modeExt = (buf[3] >> 4) & 0x03;
-    m_FrameHeader->copyFlag = (buf[3] >> 3) & 0x01;
-    m_FrameHeader->origFlag = (buf[3] >> 2) & 0x01;
-    m_FrameHeader->emphasis = (buf[3] >> 0) & 0x03;
+    md->mpegVersion = (MPEGVersion_t) (verIdx == 0 ? MPEG25 : ((verIdx & 0x01) ? MPEG1 : MPEG2));
+    md->frameHeader->layer = 4 - ((buf[1] >> 1) & 0x03); /* easy mapping of index to layer number, 4 = error */
+    md->frameHeader->crc = 1 - ((buf[1] >> 0) & 0x01);
+    md->frameHeader->brIdx = (buf[2] >> 4) & 0x0f;
+    md->frameHeader->srIdx = (buf[2] >> 2) & 0x03;
+    md->frameHeader->paddingBit = (buf[2] >> 1) & 0x01;
+    md->frameHeader->privateBit = (buf[2] >> 0) & 0x01;
+    md->sMode = (StereoMode_t) ((buf[3] >> 6) & 0x03); /* maps to correct enum (see definition) */
+    md->frameHeader->modeExt = (buf[3] >> 4) & 0x03;
+    md->frameHeader->copyFlag = (buf[3] >> 3) & 0x01;
+    md->frameHeader->origFlag = (buf[3] >> 2) & 0x01;
+    md->frameHeader->emphasis = (buf[3] >> 0) & 0x03;
     /* check parameters to avoid indexing tables with bad values */
-    if (m_FrameHeader->srIdx == 3 || m_FrameHeader->layer == 4 || m_FrameHeader->brIdx == 15) {return -1;}
+    if (md->frameHeader->srIdx == 3 || md->frameHeader->layer == 4 || md->frameHeader->brIdx == 15) {return -1;}
     /* for readability (we reference sfBandTable many times in decoder) */
-    m_SFBandTable = sfBandTable[m_MPEGVersion][m_FrameHeader->srIdx];
-    if (m_sMode != Joint) /* just to be safe (dequant, stproc check fh->modeExt) */
-        m_FrameHeader->modeExt = 0;
+    md->sfBandTable = sfBandTable[md->mpegVersion][md->frameHeader->srIdx];
+    if (md->sMode != Joint) /* just to be safe (dequant, stproc check fh->modeExt) */
+        md->frameHeader->modeExt = 0;
     /* init user-accessible data */
-    m_MP3DecInfo->nChans = (m_sMode == Mono ? 1 : 2);
-    m_MP3DecInfo->samprate = samplerateTab[m_MPEGVersion][m_FrameHeader->srIdx];
-    m_MP3DecInfo->nGrans = (m_MPEGVersion == MPEG1 ? m_NGRANS_MPEG1 : m_NGRANS_MPEG2);
-    m_MP3DecInfo->nGranSamps = ((int32_t) samplesPerFrameTab[m_MPEGVersion][m_FrameHeader->layer - 1])/m_MP3DecInfo->nGrans;
-    m_MP3DecInfo->layer = m_FrameHeader->layer;
+    md->mp3DecInfo->nChans = (md->sMode == Mono ? 1 : 2);
+    md->mp3DecInfo->samprate = samplerateTab[md->mpegVersion][md->frameHeader->srIdx];
+    md->mp3DecInfo->nGrans = (md->mpegVersion == MPEG1 ? m_NGRANS_MPEG1 : m_NGRANS_MPEG2);
+    md->mp3DecInfo->nGranSamps = ((int32_t) samplesPerFrameTab[md->mpegVersion][md->frameHeader->layer - 1])/md->mp3DecInfo->nGrans;
+    md->mp3DecInfo->layer = md->frameHeader->layer;
 
     /* get bitrate and nSlots from table, unless brIdx == 0 (free mode) in which case caller must figure it out himself
      * question - do we want to overwrite mp3DecInfo->bitrate with 0 each time if it's free mode, and
      *  copy the pre-calculated actual free bitrate into it in mp3dec.c (according to the spec,
      *  this shouldn't be necessary, since it should be either all frames free or none free)
      */
-    if (m_FrameHeader->brIdx) {
-        m_MP3DecInfo->bitrate=((int32_t) bitrateTab[m_MPEGVersion][m_FrameHeader->layer - 1][m_FrameHeader->brIdx]) * 1000;
+    if (md->frameHeader->brIdx) {
+        md->mp3DecInfo->bitrate=((int32_t) bitrateTab[md->mpegVersion][md->frameHeader->layer - 1][md->frameHeader->brIdx]) * 1000;
         /* nSlots = total frame bytes (from table) - sideInfo bytes - header - CRC (if present) + pad (if present) */
-        m_MP3DecInfo->nSlots= (int32_t) slotTab[m_MPEGVersion][m_FrameHeader->srIdx][m_FrameHeader->brIdx]
-                - (int32_t) sideBytesTab[m_MPEGVersion][(m_sMode == Mono ? 0 : 1)] - 4
-                - (m_FrameHeader->crc ? 2 : 0) + (m_FrameHeader->paddingBit ? 1 : 0);
+        md->mp3DecInfo->nSlots= (int32_t) slotTab[md->mpegVersion][md->frameHeader->srIdx][md->frameHeader->brIdx]
+                - (int32_t) sideBytesTab[md->mpegVersion][(md->sMode == Mono ? 0 : 1)] - 4
+                - (md->frameHeader->crc ? 2 : 0) + (md->frameHeader->paddingBit ? 1 : 0);
     }
     /* load crc word, if enabled, and return length of frame header (in bytes) */
-    if (m_FrameHeader->crc) {
-        m_FrameHeader->CRCWord = ((int32_t) buf[4] << 8 | (int32_t) buf[5] << 0);
+    if (md->frameHeader->crc) {
+        md->frameHeader->CRCWord = ((int32_t) buf[4] << 8 | (int32_t) buf[5] << 0);
         return 6;
     } else {
-        m_FrameHeader->CRCWord = 0;
+        md->frameHeader->CRCWord = 0;
         return 4;
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t UnpackSideInfo( uint8_t *buf) {
+int32_t UnpackSideInfo(MP3Decoder_t* md, uint8_t *buf) {
    int32_t gr, ch, bd, nBytes;
     BitStreamInfo_t bitStreamInfo, *bsi;
 
     SideInfoSub_t *sis;
     /* validate pointers and sync word */
     bsi = &bitStreamInfo;
-    if (m_MPEGVersion == MPEG1) {
+    if (md->mpegVersion == MPEG1) {
         /* MPEG 1 */
-        nBytes=(m_sMode == Mono ? m_SIBYTES_MPEG1_MONO : m_SIBYTES_MPEG1_STEREO);
+        nBytes=(md->sMode == Mono ? m_SIBYTES_MPEG1_MONO : m_SIBYTES_MPEG1_STEREO);
         SetBitstreamPointer(bsi, nBytes, buf);
-        m_SideInfo->mainDataBegin = GetBits(bsi, 9);
-        m_SideInfo->privateBits= GetBits(bsi, (m_sMode == Mono ? 5 : 3));
-        for (ch = 0; ch < m_MP3DecInfo->nChans; ch++)
-            for (bd = 0; bd < m_MAX_SCFBD; bd++) m_SideInfo->scfsi[ch][bd] = GetBits(bsi, 1);
+        md->sideInfo->mainDataBegin = GetBits(bsi, 9);
+        md->sideInfo->privateBits= GetBits(bsi, (md->sMode == Mono ? 5 : 3));
+        for (ch = 0; ch < md->mp3DecInfo->nChans; ch++)
+            for (bd = 0; bd < m_MAX_SCFBD; bd++) md->sideInfo->scfsi[ch][bd] = GetBits(bsi, 1);
     } else {
         /* MPEG 2, MPEG 2.5 */
-        nBytes=(m_sMode == Mono ? m_SIBYTES_MPEG2_MONO : m_SIBYTES_MPEG2_STEREO);
+        nBytes=(md->sMode == Mono ? m_SIBYTES_MPEG2_MONO : m_SIBYTES_MPEG2_STEREO);
         SetBitstreamPointer(bsi, nBytes, buf);
-        m_SideInfo->mainDataBegin = GetBits(bsi, 8);
-        m_SideInfo->privateBits = GetBits(bsi, (m_sMode == Mono ? 1 : 2));
+        md->sideInfo->mainDataBegin = GetBits(bsi, 8);
+        md->sideInfo->privateBits = GetBits(bsi, (md->sMode == Mono ? 1 : 2));
     }
-    for (gr = 0; gr < m_MP3DecInfo->nGrans; gr++) {
-        for (ch = 0; ch < m_MP3DecInfo->nChans; ch++) {
-            sis = &m_SideInfoSub[gr][ch]; /* side info subblock for this granule, channel */
+    for (gr = 0; gr < md->mp3DecInfo->nGrans; gr++) {
+        for (ch = 0; ch < md->mp3DecInfo->nChans; ch++) {
+            sis = &md->sideInfoSub[gr][ch]; /* side info subblock for this granule, channel */
             sis->part23Length = GetBits(bsi, 12);
             sis->nBigvals = GetBits(bsi, 9);
             sis->globalGain = GetBits(bsi, 8);
-            sis->sfCompress = GetBits(bsi, (m_MPEGVersion == MPEG1 ? 4 : 9));
+            sis->sfCompress = GetBits(bsi, (md->mpegVersion == MPEG1 ? 4 : 9));
             sis->winSwitchFlag = GetBits(bsi, 1);
             if (sis->winSwitchFlag) {
                 /* this is a start, stop, short, or mixed block */
@@ -868,12 +1318,12 @@ int32_t UnpackSideInfo( uint8_t *buf) {
                 sis->region0Count = GetBits(bsi, 4);
                 sis->region1Count = GetBits(bsi, 3);
             }
-            sis->preFlag = (m_MPEGVersion == MPEG1 ? GetBits(bsi, 1) : 0);
+            sis->preFlag = (md->mpegVersion == MPEG1 ? GetBits(bsi, 1) : 0);
             sis->sfactScale = GetBits(bsi, 1);
             sis->count1TableSelect = GetBits(bsi, 1);
         }
     }
-    m_MP3DecInfo->mainDataBegin = m_SideInfo->mainDataBegin; /* needed by main decode loop */
+    md->mp3DecInfo->mainDataBegin = md->sideInfo->mainDataBegin; /* needed by main decode loop */
     assert(nBytes == CalcBitsUsed(bsi, buf, 0) >> 3);
     return nBytes;
 }
@@ -1135,7 +1585,7 @@ void UnpackSFMPEG2(BitStreamInfo_t *bsi, SideInfoSub_t *sis,
  *
  * Return:      length (in bytes) of scale factor data, -1 if null input pointers
  **********************************************************************************************************************/
-int32_t UnpackScaleFactors( uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail, int32_t gr, int32_t ch){
+int32_t UnpackScaleFactors(MP3Decoder_t* md, uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail, int32_t gr, int32_t ch){
    int32_t bitsUsed;
     uint8_t *startBuf;
     BitStreamInfo_t bitStreamInfo, *bsi;
@@ -1147,14 +1597,14 @@ int32_t UnpackScaleFactors( uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail,
     if (*bitOffset)
         GetBits(bsi, *bitOffset);
 
-    if (m_MPEGVersion == MPEG1)
-        UnpackSFMPEG1(bsi, &m_SideInfoSub[gr][ch], &m_ScaleFactorInfoSub[gr][ch],
-                      m_SideInfo->scfsi[ch], gr, &m_ScaleFactorInfoSub[0][ch]);
+    if (md->mpegVersion == MPEG1)
+        UnpackSFMPEG1(bsi, &md->sideInfoSub[gr][ch], &md->scaleFactorInfoSub[gr][ch],
+                      md->sideInfo->scfsi[ch], gr, &md->scaleFactorInfoSub[0][ch]);
     else
-        UnpackSFMPEG2(bsi, &m_SideInfoSub[gr][ch], &m_ScaleFactorInfoSub[gr][ch],
-                      gr, ch, m_FrameHeader->modeExt, m_ScaleFactorJS);
+        UnpackSFMPEG2(bsi, &md->sideInfoSub[gr][ch], &md->scaleFactorInfoSub[gr][ch],
+                      gr, ch, md->frameHeader->modeExt, md->scaleFactorJS);
 
-    m_MP3DecInfo->part23Length[gr][ch] = m_SideInfoSub[gr][ch].part23Length;
+    md->mp3DecInfo->part23Length[gr][ch] = md->sideInfoSub[gr][ch].part23Length;
 
     bitsUsed = CalcBitsUsed(bsi, buf, *bitOffset);
     buf += (bitsUsed + *bitOffset) >> 3;
@@ -1295,34 +1745,34 @@ int32_t MP3FindFreeSync(uint8_t *buf, uint8_t firstFH[4], int32_t nBytes){
  *
  * Notes:       call this right after calling MP3Decode
  **********************************************************************************************************************/
-void MP3GetLastFrameInfo() {
-    if (m_MP3DecInfo->layer != 3){
-        m_MP3FrameInfo->bitrate=0;
-        m_MP3FrameInfo->nChans=0;
-        m_MP3FrameInfo->samprate=0;
-        m_MP3FrameInfo->bitsPerSample=0;
-        m_MP3FrameInfo->outputSamps=0;
-        m_MP3FrameInfo->layer=0;
-        m_MP3FrameInfo->version=0;
+void MP3GetLastFrameInfo(MP3Decoder_t* md) {
+    if (md->mp3DecInfo->layer != 3){
+        md->mp3FrameInfo->bitrate=0;
+        md->mp3FrameInfo->nChans=0;
+        md->mp3FrameInfo->samprate=0;
+        md->mp3FrameInfo->bitsPerSample=0;
+        md->mp3FrameInfo->outputSamps=0;
+        md->mp3FrameInfo->layer=0;
+        md->mp3FrameInfo->version=0;
     }
     else{
-        m_MP3FrameInfo->bitrate=m_MP3DecInfo->bitrate;
-        m_MP3FrameInfo->nChans=m_MP3DecInfo->nChans;
-        m_MP3FrameInfo->samprate=m_MP3DecInfo->samprate;
-        m_MP3FrameInfo->bitsPerSample=16;
-        m_MP3FrameInfo->outputSamps=m_MP3DecInfo->nChans
-                * (int32_t) samplesPerFrameTab[m_MPEGVersion][m_MP3DecInfo->layer-1];
-        m_MP3FrameInfo->layer=m_MP3DecInfo->layer;
-        m_MP3FrameInfo->version=m_MPEGVersion;
+        md->mp3FrameInfo->bitrate=md->mp3DecInfo->bitrate;
+        md->mp3FrameInfo->nChans=md->mp3DecInfo->nChans;
+        md->mp3FrameInfo->samprate=md->mp3DecInfo->samprate;
+        md->mp3FrameInfo->bitsPerSample=16;
+        md->mp3FrameInfo->outputSamps=md->mp3DecInfo->nChans
+                * (int32_t) samplesPerFrameTab[md->mpegVersion][md->mp3DecInfo->layer-1];
+        md->mp3FrameInfo->layer=md->mp3DecInfo->layer;
+        md->mp3FrameInfo->version=md->mpegVersion;
     }
 }
-int32_t MP3GetSampRate(){return m_MP3FrameInfo->samprate;}
-int32_t MP3GetChannels(){return m_MP3FrameInfo->nChans;}
-int32_t MP3GetBitsPerSample(){return m_MP3FrameInfo->bitsPerSample;}
-int32_t MP3GetBitrate(){return m_MP3FrameInfo->bitrate;}
-int32_t MP3GetOutputSamps(){return m_MP3FrameInfo->outputSamps;}
-int32_t MP3GetLayer(){return m_MP3FrameInfo->layer;}     // 0: Reserviert, 1: Layer III, 2: Layer II, 3: Layer I
-int32_t MP3GetVersion(){return m_MP3FrameInfo->version;} // 0: MPEG-2.5, 1: Reserviert, 2: MPEG-2 (ISO/IEC 13818-3), 3: MPEG-1 (ISO/IEC 11172-3)
+int32_t MP3GetSampRate(MP3Decoder_t* md){return md->mp3FrameInfo->samprate;}
+int32_t MP3GetChannels(MP3Decoder_t* md){return md->mp3FrameInfo->nChans;}
+int32_t MP3GetBitsPerSample(MP3Decoder_t* md){return md->mp3FrameInfo->bitsPerSample;}
+int32_t MP3GetBitrate(MP3Decoder_t* md){return md->mp3FrameInfo->bitrate;}
+int32_t MP3GetOutputSamps(MP3Decoder_t* md){return md->mp3FrameInfo->outputSamps;}
+int32_t MP3GetLayer(MP3Decoder_t* md){return md->mp3FrameInfo->layer;}     // 0: Reserviert, 1: Layer III, 2: Layer II, 3: Layer I
+int32_t MP3GetVersion(MP3Decoder_t* md){return md->mp3FrameInfo->version;} // 0: MPEG-2.5, 1: Reserviert, 2: MPEG-2 (ISO/IEC 13818-3), 3: MPEG-1 (ISO/IEC 11172-3)
 /***********************************************************************************************************************
  * Function:    MP3GetNextFrameInfo
  *
@@ -1335,12 +1785,12 @@ int32_t MP3GetVersion(){return m_MP3FrameInfo->version;} // 0: MPEG-2.5, 1: Rese
  *
  * Return:      error code, defined in mp3dec.h (0 means no error, < 0 means error)
  **********************************************************************************************************************/
-int32_t MP3GetNextFrameInfo(uint8_t *buf) {
+int32_t MP3GetNextFrameInfo(MP3Decoder_t* md, uint8_t *buf) {
 
-    if (UnpackFrameHeader( buf) == -1 || m_MP3DecInfo->layer != 3)
+    if (UnpackFrameHeader(md, buf) == -1 || md->mp3DecInfo->layer != 3)
         return ERR_MP3_INVALID_FRAMEHEADER;
 
-    MP3GetLastFrameInfo();
+    MP3GetLastFrameInfo(md);
 
     return ERR_MP3_NONE;
 }
@@ -1356,9 +1806,9 @@ int32_t MP3GetNextFrameInfo(uint8_t *buf) {
  *
  * Return:      none
  **********************************************************************************************************************/
-void MP3ClearBadFrame(int16_t *outbuf) {
+void MP3ClearBadFrame(MP3Decoder_t* md, int16_t *outbuf) {
    int32_t i;
-    for (i = 0; i < m_MP3DecInfo->nGrans * m_MP3DecInfo->nGranSamps * m_MP3DecInfo->nChans; i++)
+    for (i = 0; i < md->mp3DecInfo->nGrans * md->mp3DecInfo->nGranSamps * md->mp3DecInfo->nChans; i++)
         outbuf[i] = 0;
 }
 /***********************************************************************************************************************
@@ -1380,43 +1830,42 @@ void MP3ClearBadFrame(int16_t *outbuf) {
  * Notes:       switching useSize on and off between frames in the same stream
  *                is not supported (bit reservoir is not maintained if useSize on)
  **********************************************************************************************************************/
-int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t useSize){
+int32_t MP3Decode(MP3Decoder_t* md, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t useSize){
    int32_t offset, bitOffset, mainBits, gr, ch, fhBytes, siBytes, freeFrameBytes;
    int32_t prevBitOffset, sfBlockBits, huffBlockBits;
     uint8_t *mainPtr;
-    static uint8_t underflowCounter = 0; // http://macslons-irish-pub-radio.stream.laut.fm/macslons-irish-pub-radio
 
     /* unpack frame header */
-    fhBytes = UnpackFrameHeader(inbuf);
+    fhBytes = UnpackFrameHeader(md, inbuf);
     if (fhBytes < 0){
         return ERR_MP3_INVALID_FRAMEHEADER; /* don't clear outbuf since we don't know size (failed to parse header) */
     }
     inbuf += fhBytes;
     /* unpack side info */
-    siBytes = UnpackSideInfo( inbuf);
+    siBytes = UnpackSideInfo(md, inbuf);
     if (siBytes < 0) {
-        MP3ClearBadFrame(outbuf);
+        MP3ClearBadFrame(md, outbuf);
         return ERR_MP3_INVALID_SIDEINFO;
     }
     inbuf += siBytes;
     *bytesLeft -= (fhBytes + siBytes);
 
     /* if free mode, need to calculate bitrate and nSlots manually, based on frame size */
-    if (m_MP3DecInfo->bitrate == 0 || m_MP3DecInfo->freeBitrateFlag) {
-        if(!m_MP3DecInfo->freeBitrateFlag){
+    if (md->mp3DecInfo->bitrate == 0 || md->mp3DecInfo->freeBitrateFlag) {
+        if(!md->mp3DecInfo->freeBitrateFlag){
             /* first time through, need to scan for next sync word and figure out frame size */
-            m_MP3DecInfo->freeBitrateFlag=1;
-            m_MP3DecInfo->freeBitrateSlots=MP3FindFreeSync(inbuf, inbuf - fhBytes - siBytes, *bytesLeft);
-            if(m_MP3DecInfo->freeBitrateSlots < 0){
-                MP3ClearBadFrame(outbuf);
-                m_MP3DecInfo->freeBitrateFlag = 0;
+            md->mp3DecInfo->freeBitrateFlag=1;
+            md->mp3DecInfo->freeBitrateSlots=MP3FindFreeSync(inbuf, inbuf - fhBytes - siBytes, *bytesLeft);
+            if(md->mp3DecInfo->freeBitrateSlots < 0){
+                MP3ClearBadFrame(md, outbuf);
+                md->mp3DecInfo->freeBitrateFlag = 0;
                 return ERR_MP3_FREE_BITRATE_SYNC;
             }
-            freeFrameBytes=m_MP3DecInfo->freeBitrateSlots + fhBytes + siBytes;
-            m_MP3DecInfo->bitrate=(freeFrameBytes * m_MP3DecInfo->samprate * 8)
-                    / (m_MP3DecInfo->nGrans * m_MP3DecInfo->nGranSamps);
+            freeFrameBytes=md->mp3DecInfo->freeBitrateSlots + fhBytes + siBytes;
+            md->mp3DecInfo->bitrate=(freeFrameBytes * md->mp3DecInfo->samprate * 8)
+                    / (md->mp3DecInfo->nGrans * md->mp3DecInfo->nGranSamps);
         }
-        m_MP3DecInfo->nSlots = m_MP3DecInfo->freeBitrateSlots + CheckPadBit(); /* add pad byte, if required */
+        md->mp3DecInfo->nSlots = md->mp3DecInfo->freeBitrateSlots + CheckPadBit(md); /* add pad byte, if required */
     }
 
     /* useSize != 0 means we're getting reformatted (RTP) packets (see RFC 3119)
@@ -1426,103 +1875,103 @@ int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t
      *      frame is (in bytesLeft)
      */
     if (useSize) {
-        m_MP3DecInfo->nSlots = *bytesLeft;
-        if (m_MP3DecInfo->mainDataBegin != 0 || m_MP3DecInfo->nSlots <= 0) {
+        md->mp3DecInfo->nSlots = *bytesLeft;
+        if (md->mp3DecInfo->mainDataBegin != 0 || md->mp3DecInfo->nSlots <= 0) {
             /* error - non self-contained frame, or missing frame (size <= 0), could do loss concealment here */
-            MP3ClearBadFrame(outbuf);
+            MP3ClearBadFrame(md, outbuf);
             return ERR_MP3_INVALID_FRAMEHEADER;
         }
 
         /* can operate in-place on reformatted frames */
-        m_MP3DecInfo->mainDataBytes = m_MP3DecInfo->nSlots;
+        md->mp3DecInfo->mainDataBytes = md->mp3DecInfo->nSlots;
         mainPtr = inbuf;
-        inbuf += m_MP3DecInfo->nSlots;
-        *bytesLeft -= (m_MP3DecInfo->nSlots);
+        inbuf += md->mp3DecInfo->nSlots;
+        *bytesLeft -= (md->mp3DecInfo->nSlots);
     } else {
         /* out of data - assume last or truncated frame */
-        if (m_MP3DecInfo->nSlots > *bytesLeft) {
-            MP3ClearBadFrame(outbuf);
+        if (md->mp3DecInfo->nSlots > *bytesLeft) {
+            MP3ClearBadFrame(md, outbuf);
             return ERR_MP3_INDATA_UNDERFLOW;
         }
         /* fill main data buffer with enough new data for this frame */
-        if (m_MP3DecInfo->mainDataBytes >= m_MP3DecInfo->mainDataBegin) {
+        if (md->mp3DecInfo->mainDataBytes >= md->mp3DecInfo->mainDataBegin) {
             /* adequate "old" main data available (i.e. bit reservoir) */
-            underflowCounter = 0;
-            memmove(m_MP3DecInfo->mainBuf,
-                    m_MP3DecInfo->mainBuf + m_MP3DecInfo->mainDataBytes - m_MP3DecInfo->mainDataBegin,
-                    m_MP3DecInfo->mainDataBegin);
-            memcpy (m_MP3DecInfo->mainBuf + m_MP3DecInfo->mainDataBegin, inbuf,
-                    m_MP3DecInfo->nSlots);
-
-            m_MP3DecInfo->mainDataBytes = m_MP3DecInfo->mainDataBegin + m_MP3DecInfo->nSlots;
-            inbuf += m_MP3DecInfo->nSlots;
-            *bytesLeft -= (m_MP3DecInfo->nSlots);
-            mainPtr = m_MP3DecInfo->mainBuf;
+            md->underflowCounter = 0;
+            memmove(md->mp3DecInfo->mainBuf,
+                    md->mp3DecInfo->mainBuf + md->mp3DecInfo->mainDataBytes - md->mp3DecInfo->mainDataBegin,
+                    md->mp3DecInfo->mainDataBegin);
+            memcpy (md->mp3DecInfo->mainBuf + md->mp3DecInfo->mainDataBegin, inbuf,
+                    md->mp3DecInfo->nSlots);
+
+            md->mp3DecInfo->mainDataBytes = md->mp3DecInfo->mainDataBegin + md->mp3DecInfo->nSlots;
+            inbuf += md->mp3DecInfo->nSlots;
+            *bytesLeft -= (md->mp3DecInfo->nSlots);
+            mainPtr = md->mp3DecInfo->mainBuf;
         } else {
             /* not enough data in bit reservoir from previous frames (perhaps starting in middle of file) */
-            underflowCounter ++;
-            memcpy(m_MP3DecInfo->mainBuf + m_MP3DecInfo->mainDataBytes, inbuf, m_MP3DecInfo->nSlots);
-            m_MP3DecInfo->mainDataBytes += m_MP3DecInfo->nSlots;
-            inbuf += m_MP3DecInfo->nSlots;
-            *bytesLeft -= (m_MP3DecInfo->nSlots);
-            if(underflowCounter < 4){
+            md->underflowCounter ++;
+            memcpy(md->mp3DecInfo->mainBuf + md->mp3DecInfo->mainDataBytes, inbuf, md->mp3DecInfo->nSlots);
+            md->mp3DecInfo->mainDataBytes += md->mp3DecInfo->nSlots;
+            inbuf += md->mp3DecInfo->nSlots;
+            *bytesLeft -= (md->mp3DecInfo->nSlots);
+            if(md->underflowCounter < 4){
                 return ERR_MP3_NONE;
             }
-            MP3ClearBadFrame( outbuf);
+            MP3ClearBadFrame(md, outbuf);
             return ERR_MP3_MAINDATA_UNDERFLOW;
         }
     }
     bitOffset = 0;
-    mainBits = m_MP3DecInfo->mainDataBytes * 8;
+    mainBits = md->mp3DecInfo->mainDataBytes * 8;
 
     /* decode one complete frame */
-    for (gr = 0; gr < m_MP3DecInfo->nGrans; gr++) {
-        for (ch = 0; ch < m_MP3DecInfo->nChans; ch++) {
+    for (gr = 0; gr < md->mp3DecInfo->nGrans; gr++) {
+        for (ch = 0; ch < md->mp3DecInfo->nChans; ch++) {
             /* unpack scale factors and compute size of scale factor block */
             prevBitOffset = bitOffset;
-            offset = UnpackScaleFactors( mainPtr, &bitOffset,
+            offset = UnpackScaleFactors(md, mainPtr, &bitOffset,
                     mainBits, gr, ch);
             sfBlockBits = 8 * offset - prevBitOffset + bitOffset;
-            huffBlockBits = m_MP3DecInfo->part23Length[gr][ch] - sfBlockBits;
+            huffBlockBits = md->mp3DecInfo->part23Length[gr][ch] - sfBlockBits;
             mainPtr += offset;
             mainBits -= sfBlockBits;
 
             if (offset < 0 || mainBits < huffBlockBits) {
-                MP3ClearBadFrame(outbuf);
+                MP3ClearBadFrame(md, outbuf);
                 return ERR_MP3_INVALID_SCALEFACT;
             }
             /* decode Huffman code words */
             prevBitOffset = bitOffset;
-            offset = DecodeHuffman( mainPtr, &bitOffset, huffBlockBits, gr, ch);
+            offset = DecodeHuffman(md, mainPtr, &bitOffset, huffBlockBits, gr, ch);
             if (offset < 0) {
-                MP3ClearBadFrame( outbuf);
+                MP3ClearBadFrame(md, outbuf);
                 return ERR_MP3_INVALID_HUFFCODES;
             }
             mainPtr += offset;
             mainBits -= (8 * offset - prevBitOffset + bitOffset);
         }
         /* dequantize coefficients, decode stereo, reorder int16_t blocks */
-        if (MP3Dequantize( gr) < 0) {
-            MP3ClearBadFrame(outbuf);
+        if (MP3Dequantize(md, gr) < 0) {
+            MP3ClearBadFrame(md, outbuf);
             return ERR_MP3_INVALID_DEQUANTIZE;
         }
 
         /* alias reduction, inverse MDCT, overlap-add, frequency inversion */
-        for (ch = 0; ch < m_MP3DecInfo->nChans; ch++) {
-            if (IMDCT( gr, ch) < 0) {
-                MP3ClearBadFrame(outbuf);
+        for (ch = 0; ch < md->mp3DecInfo->nChans; ch++) {
+            if (IMDCT(md, gr, ch) < 0) {
+                MP3ClearBadFrame(md, outbuf);
                 return ERR_MP3_INVALID_IMDCT;
             }
         }
         /* subband transform - if stereo, interleaves pcm LRLRLR */
-        if (Subband(
-                outbuf + gr * m_MP3DecInfo->nGranSamps * m_MP3DecInfo->nChans)
+        if (Subband(md,
+                outbuf + gr * md->mp3DecInfo->nGranSamps * md->mp3DecInfo->nChans)
                 < 0) {
-            MP3ClearBadFrame(outbuf);
+            MP3ClearBadFrame(md, outbuf);
             return ERR_MP3_INVALID_SUBBAND;
         }
     }
-    MP3GetLastFrameInfo();
+    MP3GetLastFrameInfo(md);
     return ERR_MP3_NONE;
 }
 
@@ -1531,29 +1980,29 @@ int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t
  *
  * Description: clear all the memory needed for the MP3 decoder
  *
- * Inputs:      none
+ * Inputs:      decoder context
  *
  * Outputs:     none
  *
  * Return:      none
  *
  **********************************************************************************************************************/
-void MP3Decoder_ClearBuffer(void) {
+void MP3Decoder_ClearBuffer(MP3Decoder_t* md) {
 
     /* important to do this - DSP primitives assume a bunch of state variables are 0 on first use */
-    memset( m_MP3DecInfo,         0, sizeof(MP3DecInfo_t));                                    //Clear MP3DecInfo
-    memset(&m_ScaleFactorInfoSub, 0, sizeof(ScaleFactorInfoSub_t)*(m_MAX_NGRAN *m_MAX_NCHAN)); //Clear ScaleFactorInfo
-    memset( m_SideInfo,           0, sizeof(SideInfo_t));                                      //Clear SideInfo
-    memset( m_FrameHeader,        0, sizeof(FrameHeader_t));                                   //Clear FrameHeader
-    memset( m_HuffmanInfo,        0, sizeof(HuffmanInfo_t));                                   //Clear HuffmanInfo
-    memset( m_DequantInfo,        0, sizeof(DequantInfo_t));                                   //Clear DequantInfo
-    memset( m_IMDCTInfo,          0, sizeof(IMDCTInfo_t));                                     //Clear IMDCTInfo
-    memset( m_SubbandInfo,        0, sizeof(SubbandInfo_t));                                   //Clear SubbandInfo
-    memset(&m_CriticalBandInfo,   0, sizeof(CriticalBandInfo_t)*m_MAX_NCHAN);                  //Clear CriticalBandInfo
-    memset( m_ScaleFactorJS,      0, sizeof(ScaleFactorJS_t));                                 //Clear ScaleFactorJS
-    memset(&m_SideInfoSub,        0, sizeof(SideInfoSub_t)*(m_MAX_NGRAN *m_MAX_NCHAN));        //Clear SideInfoSub
-    memset(&m_SFBandTable,        0, sizeof(SFBandTable_t));                                   //Clear SFBandTable
-    memset( m_MP3FrameInfo,       0, sizeof(MP3FrameInfo_t));                                  //Clear MP3FrameInfo
+    memset( md->mp3DecInfo,         0, sizeof(MP3DecInfo_t));                                    //Clear MP3DecInfo
+    memset(&md->scaleFactorInfoSub, 0, sizeof(ScaleFactorInfoSub_t)*(m_MAX_NGRAN *m_MAX_NCHAN)); //Clear ScaleFactorInfo
+    memset( md->sideInfo,           0, sizeof(SideInfo_t));                                      //Clear SideInfo
+    memset( md->frameHeader,        0, sizeof(FrameHeader_t));                                   //Clear FrameHeader
+    memset( md->huffmanInfo,        0, sizeof(HuffmanInfo_t));                                   //Clear HuffmanInfo
+    memset( md->dequantInfo,        0, sizeof(DequantInfo_t));                                   //Clear DequantInfo
+    memset( md->imdctInfo,          0, sizeof(IMDCTInfo_t));                                     //Clear IMDCTInfo
+    memset( md->subbandInfo,        0, sizeof(SubbandInfo_t));                                   //Clear SubbandInfo
+    memset(&md->criticalBandInfo,   0, sizeof(CriticalBandInfo_t)*m_MAX_NCHAN);                  //Clear CriticalBandInfo
+    memset( md->scaleFactorJS,      0, sizeof(ScaleFactorJS_t));                                 //Clear ScaleFactorJS
+    memset(&md->sideInfoSub,        0, sizeof(SideInfoSub_t)*(m_MAX_NGRAN *m_MAX_NCHAN));        //Clear SideInfoSub
+    memset(&md->sfBandTable,        0, sizeof(SFBandTable_t));                                   //Clear SFBandTable
+    memset( md->mp3FrameInfo,       0, sizeof(MP3FrameInfo_t));                                  //Clear MP3FrameInfo
 
     return;
 
@@ -1567,8 +2016,8 @@ void MP3Decoder_ClearBuffer(void) {
  *
  * Outputs:     none
  *
- * Return:      pointer to MP3DecInfo structure (initialized with pointers to all
- *                the internal buffers needed for decoding)
+ * Return:      pointer to a new decoder context (initialized with pointers to all
+ *                the internal buffers needed for decoding), NULL if out of memory
  *
  * Notes:       if one or more mallocs fail, function frees any buffers already
  *                allocated before returning
@@ -1585,71 +2034,61 @@ void MP3Decoder_ClearBuffer(void) {
         heap_caps_malloc_prefer(size, 2, MALLOC_CAP_DEFAULT|MALLOC_CAP_INTERNAL, MALLOC_CAP_DEFAULT|MALLOC_CAP_SPIRAM)
 #endif
 
-bool MP3Decoder_AllocateBuffers(void) {
-    if(!m_MP3DecInfo)       {m_MP3DecInfo    = (MP3DecInfo_t*)    __malloc_heap_psram(sizeof(MP3DecInfo_t)   );}
-    if(!m_FrameHeader)      {m_FrameHeader   = (FrameHeader_t*)   __malloc_heap_psram(sizeof(FrameHeader_t)  );}
-    if(!m_SideInfo)         {m_SideInfo      = (SideInfo_t*)      __malloc_heap_psram(sizeof(SideInfo_t)     );}
-    if(!m_ScaleFactorJS)    {m_ScaleFactorJS = (ScaleFactorJS_t*) __malloc_heap_psram(sizeof(ScaleFactorJS_t));}
-    if(!m_HuffmanInfo)      {m_HuffmanInfo   = (HuffmanInfo_t*)   __malloc_heap_psram(sizeof(HuffmanInfo_t)  );}
-    if(!m_DequantInfo)      {m_DequantInfo   = (DequantInfo_t*)   __malloc_heap_psram(sizeof(DequantInfo_t)  );}
-    if(!m_IMDCTInfo)        {m_IMDCTInfo     = (IMDCTInfo_t*)     __malloc_heap_psram(sizeof(IMDCTInfo_t)    );}
-    if(!m_SubbandInfo)      {m_SubbandInfo   = (SubbandInfo_t*)   __malloc_heap_psram(sizeof(SubbandInfo_t)  );}
-    if(!m_MP3FrameInfo)     {m_MP3FrameInfo  = (MP3FrameInfo_t*)  __malloc_heap_psram(sizeof(MP3FrameInfo_t) );}
-
-    if(!m_MP3DecInfo || !m_FrameHeader || !m_SideInfo || !m_ScaleFactorJS || !m_HuffmanInfo ||
-       !m_DequantInfo || !m_IMDCTInfo || !m_SubbandInfo || !m_MP3FrameInfo) {
-        MP3Decoder_FreeBuffers();
+MP3Decoder_t* MP3Decoder_AllocateBuffers(void) {
+    // every decoder instance owns its complete state, so several streams can be decoded at the same time
+    MP3Decoder_t* md = (MP3Decoder_t*)__malloc_heap_psram(sizeof(MP3Decoder_t));
+    if(!md) {
         log_e("not enough memory to allocate mp3decoder buffers");
-        return false;
+        return NULL;
     }
-    MP3Decoder_ClearBuffer();
-    return true;
-}
-/***********************************************************************************************************************
- * Function:    MP3Decoder_IsInit
- *
- * Description: returns MP3 decoder initialization status
- *
- * Inputs:      none
- *
- * Outputs:     none
- *
- * Return:      true if buffers allocated, otherwise false
-
- **********************************************************************************************************************/
-bool MP3Decoder_IsInit(void) {
-    if(!m_MP3DecInfo || !m_FrameHeader || !m_SideInfo || !m_ScaleFactorJS || !m_HuffmanInfo ||
-       !m_DequantInfo || !m_IMDCTInfo || !m_SubbandInfo || !m_MP3FrameInfo) {
-        return false;
+    memset(md, 0, sizeof(MP3Decoder_t));
+    md->mp3DecInfo    = (MP3DecInfo_t*)    __malloc_heap_psram(sizeof(MP3DecInfo_t)   );
+    md->frameHeader   = (FrameHeader_t*)   __malloc_heap_psram(sizeof(FrameHeader_t)  );
+    md->sideInfo      = (SideInfo_t*)      __malloc_heap_psram(sizeof(SideInfo_t)     );
+    md->scaleFactorJS = (ScaleFactorJS_t*) __malloc_heap_psram(sizeof(ScaleFactorJS_t));
+    md->huffmanInfo   = (HuffmanInfo_t*)   __malloc_heap_psram(sizeof(HuffmanInfo_t)  );
+    md->dequantInfo   = (DequantInfo_t*)   __malloc_heap_psram(sizeof(DequantInfo_t)  );
+    md->imdctInfo     = (IMDCTInfo_t*)     __malloc_heap_psram(sizeof(IMDCTInfo_t)    );
+    md->subbandInfo   = (SubbandInfo_t*)   __malloc_heap_psram(sizeof(SubbandInfo_t)  );
+    md->mp3FrameInfo  = (MP3FrameInfo_t*)  __malloc_heap_psram(sizeof(MP3FrameInfo_t) );
+
+    if(!md->mp3DecInfo || !md->frameHeader || !md->sideInfo || !md->scaleFactorJS || !md->huffmanInfo ||
+       !md->dequantInfo || !md->imdctInfo || !md->subbandInfo || !md->mp3FrameInfo) {
+        MP3Decoder_FreeBuffers(md);
+        log_e("not enough memory to allocate mp3decoder buffers");
+        return NULL;
     }
-    return true;
+    MP3Decoder_ClearBuffer(md);
+    return md;
 }
 /***********************************************************************************************************************
  * Function:    MP3Decoder_FreeBuffers
  *
  * Description: frees all the memory used by the MP3 decoder
  *
- * Inputs:      pointer to initialized MP3DecInfo structure
+ * Inputs:      decoder context from MP3Decoder_AllocateBuffers() or NULL
  *
  * Outputs:     none
  *
  * Return:      none
  *
- * Notes:       safe to call even if some buffers were not allocated
+ * Notes:       safe to call even if some buffers were not allocated, md is invalid afterwards
  **********************************************************************************************************************/
-void MP3Decoder_FreeBuffers()
+void MP3Decoder_FreeBuffers(MP3Decoder_t* md)
 {
+    if(!md) return;
 //    uint32_t i = ESP.getFreeHeap();
 
-    if(m_MP3DecInfo)        {free(m_MP3DecInfo);      m_MP3DecInfo=NULL;}
-    if(m_FrameHeader)       {free(m_FrameHeader);     m_FrameHeader=NULL;}
-    if(m_SideInfo)          {free(m_SideInfo);        m_SideInfo=NULL;}
-    if(m_ScaleFactorJS )    {free(m_ScaleFactorJS);   m_ScaleFactorJS=NULL;}
-    if(m_HuffmanInfo)       {free(m_HuffmanInfo);     m_HuffmanInfo=NULL;}
-    if(m_DequantInfo)       {free(m_DequantInfo);     m_DequantInfo=NULL;}
-    if(m_IMDCTInfo)         {free(m_IMDCTInfo);       m_IMDCTInfo=NULL;}
-    if(m_SubbandInfo)       {free(m_SubbandInfo);     m_SubbandInfo=NULL;}
-    if(m_MP3FrameInfo)      {free(m_MP3FrameInfo);    m_MP3FrameInfo=NULL;}
+    if(md->mp3DecInfo)        {free(md->mp3DecInfo);      md->mp3DecInfo=NULL;}
+    if(md->frameHeader)       {free(md->frameHeader);     md->frameHeader=NULL;}
+    if(md->sideInfo)          {free(md->sideInfo);        md->sideInfo=NULL;}
+    if(md->scaleFactorJS )    {free(md->scaleFactorJS);   md->scaleFactorJS=NULL;}
+    if(md->huffmanInfo)       {free(md->huffmanInfo);     md->huffmanInfo=NULL;}
+    if(md->dequantInfo)       {free(md->dequantInfo);     md->dequantInfo=NULL;}
+    if(md->imdctInfo)         {free(md->imdctInfo);       md->imdctInfo=NULL;}
+    if(md->subbandInfo)       {free(md->subbandInfo);     md->subbandInfo=NULL;}
+    if(md->mp3FrameInfo)      {free(md->mp3FrameInfo);    md->mp3FrameInfo=NULL;}
+    free(md);
 
 //    log_i("MP3Decoder: %lu bytes memory was freed", ESP.getFreeHeap() - i);
 }
@@ -1658,6 +2097,47 @@ void MP3Decoder_FreeBuffers()
  * H U F F M A N N
  **********************************************************************************************************************/
 
+/* the cache holds 57...64 bits after a refill, enough for the longest pair (19 bits code, 2 * (13 linbits + sign)) */
+static inline void HuffBitsInit(HuffBits_t *hb, uint8_t *buf, int32_t bitOffset, int32_t bitsLeft) {
+    hb->cache = 0;
+    hb->cachedBits = (8 - bitOffset) & 0x07;
+    hb->buf = buf;
+    if (hb->cachedBits)
+        hb->cache = (uint64_t) (*hb->buf++) << (64 - hb->cachedBits);
+    hb->bitsLeft = bitsLeft - hb->cachedBits;
+    if (hb->bitsLeft < 0) { /* the block ends in the first byte */
+        hb->cachedBits += hb->bitsLeft;
+        hb->bitsLeft = 0;
+        hb->cache = hb->cachedBits > 0 ? hb->cache & (~0ULL << (64 - hb->cachedBits)) : 0;
+    }
+}
+
+static inline void HuffBitsRefill(HuffBits_t *hb) {
+    while (hb->cachedBits <= 56 && hb->bitsLeft > 0) {
+        uint32_t b = *hb->buf++;
+        if (hb->bitsLeft < 8) { /* last byte, the bits behind the block must read as 0 */
+            b &= 0xff << (8 - hb->bitsLeft);
+            hb->cache |= (uint64_t) b << (56 - hb->cachedBits);
+            hb->cachedBits += hb->bitsLeft;
+            hb->bitsLeft = 0;
+            break;
+        }
+        hb->cache |= (uint64_t) b << (56 - hb->cachedBits);
+        hb->cachedBits += 8;
+        hb->bitsLeft -= 8;
+    }
+}
+
+static inline uint32_t HuffBitsPeek(HuffBits_t *hb, int32_t n) { return (uint32_t) (hb->cache >> (64 - n)); }
+static inline void HuffBitsSkip(HuffBits_t *hb, int32_t n) { hb->cache <<= n; hb->cachedBits -= n; }
+
+/* returns the sign bit at bit 31, for the sign-magnitude format of huffDecBuf */
+static inline int32_t HuffBitsSign(HuffBits_t *hb) {
+    int32_t s = (int32_t) (hb->cache >> 32) & 0x80000000;
+    HuffBitsSkip(hb, 1);
+    return s;
+}
+
 /***********************************************************************************************************************
  * Function:    DecodeHuffmanPairs
  *
@@ -1675,16 +2155,15 @@ void MP3Decoder_FreeBuffers()
  * Return:      number of bits used, or -1 if out of bits
  *
  * Notes:       assumes that nVals is an even number
- *              si_huff.bit tests every Huffman codeword in every table (though not
- *                necessarily all linBits outputs for x,y > 15)
+ *              the first lookup of rootBits (9 at most) resolves most codewords including their sign bits,
+ *                longer codewords take one more lookup in a subtable, linbits are read from the 64 bit cache
  **********************************************************************************************************************/
-// no improvement with section=data
 int32_t DecodeHuffmanPairs(int32_t *xy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset){
-   int32_t i, x, y;
-   int32_t cachedBits, padBits, len, startBits, linBits, maxBits, minBits;
+   int32_t x, y, startBits, linBits, rootBits;
     HuffTabType_t tabType;
-    uint16_t cw, *tBase, *tCurr;
-    uint32_t cache;
+    const uint16_t *tBase;
+    uint16_t cw;
+    HuffBits_t hb;
 
     if (nVals <= 0)
         return 0;
@@ -1693,208 +2172,66 @@ int32_t DecodeHuffmanPairs(int32_t *xy, int32_t nVals, int32_t tabIdx, int32_t b
         return -1;
     startBits = bitsLeft;
 
-    tBase = (uint16_t *) (huffTable + huffTabOffset[tabIdx]);
+    tBase = huffTable + huffTabOffset[tabIdx];
     linBits = huffTabLookup[tabIdx].linBits;
     tabType = (HuffTabType_t)huffTabLookup[tabIdx].tabType;
 
-//    assert(!(nVals & 0x01));
-//    assert(tabIdx < m_HUFF_PAIRTABS);
-//    assert(tabIdx >= 0);
-//    assert(tabType != invalidTab);
-
     if((nVals & 0x01)){log_d("assert(!(nVals & 0x01))"); return -1;}
     if(!(tabIdx < m_HUFF_PAIRTABS)){log_d("assert(tabIdx < m_HUFF_PAIRTABS)"); return -1;}
     if(!(tabIdx >= 0)){log_d("(tabIdx >= 0)"); return -1;}
     if(!(tabType != invalidTab)){log_d("(tabType != invalidTab)"); return -1;}
 
-
-    /* initially fill cache with any partial byte */
-    cache = 0;
-    cachedBits = (8 - bitOffset) & 0x07;
-    if (cachedBits)
-        cache = (uint32_t) (*buf++) << (32 - cachedBits);
-    bitsLeft -= cachedBits;
-
     if (tabType == noBits) {
         /* table 0, no data, x = y = 0 */
-        for (i = 0; i < nVals; i += 2) {
-            xy[i + 0] = 0;
-            xy[i + 1] = 0;
-        }
+        memset(xy, 0, nVals * sizeof(int32_t));
         return 0;
-    } else if (tabType == oneShot) {
-        /* single lookup, no escapes */
-
-        maxBits = (int32_t)( (((uint16_t)(pgm_read_word(&tBase[0])) >>  0) & 0x000f));
-        tBase++;
-        padBits = 0;
-        while (nVals > 0) {
-            /* refill cache - assumes cachedBits <= 16 */
-            if (bitsLeft >= 16) {
-                /* load 2 new bytes into left-justified cache */
-                cache |= (uint32_t) (*buf++) << (24 - cachedBits);
-                cache |= (uint32_t) (*buf++) << (16 - cachedBits);
-                cachedBits += 16;
-                bitsLeft -= 16;
-            } else {
-                /* last time through, pad cache with zeros and drain cache */
-                if (cachedBits + bitsLeft <= 0)
-                    return -1;
-                if (bitsLeft > 0)
-                    cache |= (uint32_t) (*buf++) << (24 - cachedBits);
-                if (bitsLeft > 8)
-                    cache |= (uint32_t) (*buf++) << (16 - cachedBits);
-                cachedBits += bitsLeft;
-                bitsLeft = 0;
-
-                cache &= (int32_t) 0x80000000 >> (cachedBits - 1);
-                padBits = 11;
-                cachedBits += padBits; /* okay if this is > 32 (0's automatically shifted in from right) */
-            }
-
-            /* largest maxBits = 9, plus 2 for sign bits, so make sure cache has at least 11 bits */
-            while (nVals > 0 && cachedBits >= 11) {
-                cw = pgm_read_word(&tBase[cache >> (32 - maxBits)]);
-
-                len=(int32_t)( (((uint16_t)(cw)) >> 12) & 0x000f);
-                cachedBits -= len;
-                cache <<= len;
-
-                x=(int32_t)( (((uint16_t)(cw)) >>  4) & 0x000f);
-                if (x) {
-                    (x) |= ((cache) & 0x80000000);
-                    cache <<= 1;
-                    cachedBits--;
-                }
-
-
+    }
 
-                y=(int32_t)( (((uint16_t)(cw)) >>  8) & 0x000f);
-                if (y) {
-                    (y) |= ((cache) & 0x80000000);
-                    cache <<= 1;
-                    cachedBits--;
-                }
+    rootBits = pgm_read_word(&tBase[0]);
+    tBase++;
+    HuffBitsInit(&hb, buf, bitOffset, bitsLeft);
 
-                /* ran out of bits - should never have consumed padBits */
-                if (cachedBits < padBits)
-                    return -1;
+    while (nVals > 0) {
+        if (hb.cachedBits < 48)
+            HuffBitsRefill(&hb);
 
-                *xy++ = x;
-                *xy++ = y;
-                nVals -= 2;
-            }
+        cw = pgm_read_word(&tBase[HuffBitsPeek(&hb, rootBits)]);
+        if (cw & 0x8000) { /* long codeword, second lookup */
+            HuffBitsSkip(&hb, rootBits);
+            cw = pgm_read_word(&tBase[(cw & 0x07ff) + HuffBitsPeek(&hb, (cw >> 11) & 0x0f)]);
         }
-        bitsLeft += (cachedBits - padBits);
-        return (startBits - bitsLeft);
-    } else if (tabType == loopLinbits || tabType == loopNoLinbits) {
-        tCurr = tBase;
-        padBits = 0;
-        while (nVals > 0) {
-            /* refill cache - assumes cachedBits <= 16 */
-            if (bitsLeft >= 16) {
-                /* load 2 new bytes into left-justified cache */
-                cache |= (uint32_t) (*buf++) << (24 - cachedBits);
-                cache |= (uint32_t) (*buf++) << (16 - cachedBits);
-                cachedBits += 16;
-                bitsLeft -= 16;
-            } else {
-                /* last time through, pad cache with zeros and drain cache */
-                if (cachedBits + bitsLeft <= 0)
-                    return -1;
-                if (bitsLeft > 0)
-                    cache |= (uint32_t) (*buf++) << (24 - cachedBits);
-                if (bitsLeft > 8)
-                    cache |= (uint32_t) (*buf++) << (16 - cachedBits);
-                cachedBits += bitsLeft;
-                bitsLeft = 0;
-
-                cache &= (int32_t) 0x80000000 >> (cachedBits - 1);
-                padBits = 11;
-                cachedBits += padBits; /* okay if this is > 32 (0's automatically shifted in from right) */
+        HuffBitsSkip(&hb, (cw >> 11) & 0x0f);
+
+        x = (cw >> 5) & 0x1f;
+        y = cw & 0x1f;
+        if (cw & 0x0400) {
+            /* the signs were part of the lookup, sign-magnitude */
+            x = (x & 0x0f) | ((x & 0x10) << 27);
+            y = (y & 0x0f) | ((y & 0x10) << 27);
+        } else {
+            if (x == 15 && linBits) {
+                x += HuffBitsPeek(&hb, linBits);
+                HuffBitsSkip(&hb, linBits);
             }
-
-            /* largest maxBits = 9, plus 2 for sign bits, so make sure cache has at least 11 bits */
-            while (nVals > 0 && cachedBits >= 11) {
-                maxBits = (int32_t)( (((uint16_t)(pgm_read_word(&tCurr[0]))) >>  0) & 0x000f);
-                cw = pgm_read_word(&tCurr[(cache >> (32 - maxBits)) + 1]);
-                len=(int32_t)( (((uint16_t)(cw)) >> 12) & 0x000f);
-                if (!len) {
-                    cachedBits -= maxBits;
-                    cache <<= maxBits;
-                    tCurr += cw;
-                    continue;
-                }
-                cachedBits -= len;
-                cache <<= len;
-
-                x=(int32_t)( (((uint16_t)(cw)) >>  4) & 0x000f);
-                y=(int32_t)( (((uint16_t)(cw)) >>  8) & 0x000f);
-
-                if (x == 15 && tabType == loopLinbits) {
-                    minBits = linBits + 1 + (y ? 1 : 0);
-                    if (cachedBits + bitsLeft < minBits)
-                        return -1;
-                    while (cachedBits < minBits) {
-                        cache |= (uint32_t) (*buf++) << (24 - cachedBits);
-                        cachedBits += 8;
-                        bitsLeft -= 8;
-                    }
-                    if (bitsLeft < 0) {
-                        cachedBits += bitsLeft;
-                        bitsLeft = 0;
-                        cache &= (int32_t) 0x80000000 >> (cachedBits - 1);
-                    }
-                    x += (int32_t) (cache >> (32 - linBits));
-                    cachedBits -= linBits;
-                    cache <<= linBits;
-                }
-                if (x) {
-                    (x) |= ((cache) & 0x80000000);
-                    cache <<= 1;
-                    cachedBits--;
-                }
-
-                if (y == 15 && tabType == loopLinbits) {
-                    minBits = linBits + 1;
-                    if (cachedBits + bitsLeft < minBits)
-                        return -1;
-                    while (cachedBits < minBits) {
-                        cache |= (uint32_t) (*buf++) << (24 - cachedBits);
-                        cachedBits += 8;
-                        bitsLeft -= 8;
-                    }
-                    if (bitsLeft < 0) {
-                        cachedBits += bitsLeft;
-                        bitsLeft = 0;
-                        cache &= (int32_t) 0x80000000 >> (cachedBits - 1);
-                    }
-                    y += (int32_t) (cache >> (32 - linBits));
-                    cachedBits -= linBits;
-                    cache <<= linBits;
-                }
-                if (y) {
-                    (y) |= ((cache) & 0x80000000);
-                    cache <<= 1;
-                    cachedBits--;
-                }
-
-                /* ran out of bits - should never have consumed padBits */
-                if (cachedBits < padBits)
-                    return -1;
-
-                *xy++ = x;
-                *xy++ = y;
-                nVals -= 2;
-                tCurr = tBase;
+            if (x)
+                x |= HuffBitsSign(&hb);
+            if (y == 15 && linBits) {
+                y += HuffBitsPeek(&hb, linBits);
+                HuffBitsSkip(&hb, linBits);
             }
+            if (y)
+                y |= HuffBitsSign(&hb);
         }
-        bitsLeft += (cachedBits - padBits);
-        return (startBits - bitsLeft);
-    }
 
-    /* error in bitstream - trying to access unused Huffman table */
-    return -1;
+        /* ran out of bits - the last codeword was read from the zeros behind the block */
+        if (hb.cachedBits < 0)
+            return -1;
+
+        *xy++ = x;
+        *xy++ = y;
+        nVals -= 2;
+    }
+    return startBits - (hb.bitsLeft + hb.cachedBits);
 }
 
 /***********************************************************************************************************************
@@ -1914,92 +2251,37 @@ int32_t DecodeHuffmanPairs(int32_t *xy, int32_t nVals, int32_t tabIdx, int32_t b
  * Return:      index of the first "zero_part" value (index of the first sample
  *                of the quad word after which all samples are 0)
  *
- * Notes:        si_huff.bit tests every vwxy output in both quad tables
+ * Notes:       one lookup of maxBits + 4 bits resolves the codeword and its sign bits
  **********************************************************************************************************************/
-// no improvement with section=data
 int32_t DecodeHuffmanQuads(int32_t *vwxy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset){
-   int32_t i, v, w, x, y;
-   int32_t len, maxBits, cachedBits, padBits;
-    uint32_t cache;
-    uint8_t cw, *tBase;
+   int32_t i, maxBits;
+    const uint16_t *tBase;
+    uint16_t cw;
+    HuffBits_t hb;
 
     if(bitsLeft<=0) return 0;
 
-    tBase = (uint8_t *) quadTable + quadTabOffset[tabIdx];
-    maxBits = quadTabMaxBits[tabIdx];
-
-    /* initially fill cache with any partial byte */
-    cache = 0;
-    cachedBits=(8-bitOffset) & 0x07;
-    if(cachedBits)cache=(uint32_t)(*buf++) << (32 - cachedBits);
-    bitsLeft -= cachedBits;
+    tBase = quadTable + quadTabOffset[tabIdx];
+    maxBits = quadTabMaxBits[tabIdx] + 4;
+    HuffBitsInit(&hb, buf, bitOffset, bitsLeft);
 
-    i = padBits = 0;
+    i = 0;
     while (i < (nVals - 3)) {
-        /* refill cache - assumes cachedBits <= 16 */
-        if (bitsLeft >= 16) {
-            /* load 2 new bytes into left-justified cache */
-            cache |= (uint32_t) (*buf++) << (24 - cachedBits);
-            cache |= (uint32_t) (*buf++) << (16 - cachedBits);
-            cachedBits += 16;
-            bitsLeft -= 16;
-        } else {
-            /* last time through, pad cache with zeros and drain cache */
-            if(cachedBits+bitsLeft <= 0) return i;
-            if(bitsLeft>0) cache |= (uint32_t)(*buf++)<<(24-cachedBits);
-            if (bitsLeft > 8) cache |= (uint32_t)(*buf++)<<(16 - cachedBits);
-            cachedBits += bitsLeft;
-            bitsLeft = 0;
-
-            cache &= (int32_t) 0x80000000 >> (cachedBits - 1);
-            padBits = 10;
-            cachedBits += padBits; /* okay if this is > 32 (0's automatically shifted in from right) */
-        }
-
-        /* largest maxBits = 6, plus 4 for sign bits, so make sure cache has at least 10 bits */
-        while(i < (nVals - 3) && cachedBits >= 10){
-            cw = pgm_read_byte(&tBase[cache >> (32 - maxBits)]);
-            len=(int32_t)( (((uint8_t)(cw)) >> 4) & 0x0f);
-            cachedBits -= len;
-            cache <<= len;
-
-            v=(int32_t)( (((uint8_t)(cw)) >> 3) & 0x01);
-            if (v) {
-                (v) |= ((cache) & 0x80000000);
-                cache <<= 1;
-                cachedBits--;
-            }
-            w=(int32_t)( (((uint8_t)(cw)) >> 2) & 0x01);
-            if (w) {
-                (w) |= ((cache) & 0x80000000);
-                cache <<= 1;
-                cachedBits--;
-            }
+        if (hb.cachedBits < 10)
+            HuffBitsRefill(&hb);
 
-            x=(int32_t)( (((uint8_t)(cw)) >> 1) & 0x01);
-            if (x) {
-                (x) |= ((cache) & 0x80000000);
-                cache <<= 1;
-                cachedBits--;
-            }
+        cw = pgm_read_word(&tBase[HuffBitsPeek(&hb, maxBits)]);
+        HuffBitsSkip(&hb, cw >> 8);
 
-            y=(int32_t)( (((uint8_t)(cw)) >> 0) & 0x01);
-            if (y) {
-                (y) |= ((cache) & 0x80000000);
-                cache <<= 1;
-                cachedBits--;
-            }
+        /* ran out of bits - okay (means we're done) */
+        if (hb.cachedBits < 0)
+            return i;
 
-            /* ran out of bits - okay (means we're done) */
-            if (cachedBits < padBits)
-                return i;
-
-            *vwxy++ = v;
-            *vwxy++ = w;
-            *vwxy++ = x;
-            *vwxy++ = y;
-            i += 4;
-        }
+        *vwxy++ = ((cw >> 3) & 0x01) | ((cw & 0x80) << 24);
+        *vwxy++ = ((cw >> 2) & 0x01) | ((cw & 0x40) << 25);
+        *vwxy++ = ((cw >> 1) & 0x01) | ((cw & 0x20) << 26);
+        *vwxy++ = ((cw >> 0) & 0x01) | ((cw & 0x10) << 27);
+        i += 4;
     }
 
     /* decoded max number of quad values */
@@ -2029,15 +2311,15 @@ int32_t DecodeHuffmanQuads(int32_t *vwxy, int32_t nVals, int32_t tabIdx, int32_t
  *                out of bits prematurely (invalid bitstream)
  **********************************************************************************************************************/
 // .data about 1ms faster per frame
-int32_t DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, int32_t gr, int32_t ch){
+int32_t DecodeHuffman(MP3Decoder_t* md, uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, int32_t gr, int32_t ch){
 
    int32_t r1Start, r2Start, rEnd[4]; /* region boundaries */
    int32_t i, w, bitsUsed, bitsLeft;
     uint8_t *startBuf = buf;
 
     SideInfoSub_t *sis;
-    sis = &m_SideInfoSub[gr][ch];
-    //hi = (HuffmanInfo_t*) (m_MP3DecInfo->HuffmanInfoPS);
+    sis = &md->sideInfoSub[gr][ch];
+    //hi = (HuffmanInfo_t*) (md->mp3DecInfo->HuffmanInfoPS);
 
     if (huffBlockBits < 0)
         return -1;
@@ -2045,20 +2327,20 @@ int32_t DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, i
     /* figure out region boundaries (the first 2*bigVals coefficients divided into 3 regions) */
     if (sis->winSwitchFlag && sis->blockType == 2) {
         if (sis->mixedBlock == 0) {
-            r1Start = m_SFBandTable.s[(sis->region0Count + 1) / 3] * 3;
+            r1Start = md->sfBandTable.s[(sis->region0Count + 1) / 3] * 3;
         } else {
-            if (m_MPEGVersion == MPEG1) {
-                r1Start = m_SFBandTable.l[sis->region0Count + 1];
+            if (md->mpegVersion == MPEG1) {
+                r1Start = md->sfBandTable.l[sis->region0Count + 1];
             } else {
                 /* see MPEG2 spec for explanation */
-                w = m_SFBandTable.s[4] - m_SFBandTable.s[3];
-                r1Start = m_SFBandTable.l[6] + 2 * w;
+                w = md->sfBandTable.s[4] - md->sfBandTable.s[3];
+                r1Start = md->sfBandTable.l[6] + 2 * w;
             }
         }
         r2Start = m_MAX_NSAMP; /* short blocks don't have region 2 */
     } else {
-        r1Start = m_SFBandTable.l[sis->region0Count + 1];
-        r2Start = m_SFBandTable.l[sis->region0Count + 1 + sis->region1Count + 1];
+        r1Start = md->sfBandTable.l[sis->region0Count + 1];
+        r2Start = md->sfBandTable.l[sis->region0Count + 1 + sis->region1Count + 1];
     }
 
     /* offset rEnd index by 1 so first region = rEnd[1] - rEnd[0], etc. */
@@ -2068,12 +2350,12 @@ int32_t DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, i
     rEnd[0] = 0;
 
     /* rounds up to first all-zero pair (we don't check last pair for (x,y) == (non-zero, zero)) */
-    m_HuffmanInfo->nonZeroBound[ch] = rEnd[3];
+    md->huffmanInfo->nonZeroBound[ch] = rEnd[3];
 
     /* decode Huffman pairs (rEnd[i] are always even numbers) */
     bitsLeft = huffBlockBits;
     for (i = 0; i < 3; i++) {
-        bitsUsed = DecodeHuffmanPairs(m_HuffmanInfo->huffDecBuf[ch] + rEnd[i],
+        bitsUsed = DecodeHuffmanPairs(md->huffmanInfo->huffDecBuf[ch] + rEnd[i],
                 rEnd[i + 1] - rEnd[i], sis->tableSelect[i], bitsLeft, buf,
                 *bitOffset);
         if (bitsUsed < 0 || bitsUsed > bitsLeft) /* error - overran end of bitstream */
@@ -2086,13 +2368,13 @@ int32_t DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, i
     }
 
     /* decode Huffman quads (if any) */
-    m_HuffmanInfo->nonZeroBound[ch] += DecodeHuffmanQuads(m_HuffmanInfo->huffDecBuf[ch] + rEnd[3],
+    md->huffmanInfo->nonZeroBound[ch] += DecodeHuffmanQuads(md->huffmanInfo->huffDecBuf[ch] + rEnd[3],
             m_MAX_NSAMP - rEnd[3], sis->count1TableSelect, bitsLeft, buf,
             *bitOffset);
 
-    assert(m_HuffmanInfo->nonZeroBound[ch] <= m_MAX_NSAMP);
-    for (i = m_HuffmanInfo->nonZeroBound[ch]; i < m_MAX_NSAMP; i++)
-        m_HuffmanInfo->huffDecBuf[ch][i] = 0;
+    assert(md->huffmanInfo->nonZeroBound[ch] <= m_MAX_NSAMP);
+    for (i = md->huffmanInfo->nonZeroBound[ch]; i < m_MAX_NSAMP; i++)
+        md->huffmanInfo->huffDecBuf[ch][i] = 0;
 
     /* If bits used for 576 samples < huffBlockBits, then the extras are considered
      *  to be stuffing bits (throw away, but need to return correct bitstream position)
@@ -2130,16 +2412,16 @@ int32_t DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, i
  *              Equivalently, we can think of the dequantized coefficients as
  *                Q(DQ_FRACBITS_OUT - 15) with no implicit bias.
  **********************************************************************************************************************/
-int32_t MP3Dequantize(int32_t gr){
+int32_t MP3Dequantize(MP3Decoder_t* md, int32_t gr){
    int32_t i, ch, nSamps, mOut[2];
     CriticalBandInfo_t *cbi;
-    cbi = &m_CriticalBandInfo[0];
+    cbi = &md->criticalBandInfo[0];
     mOut[0] = mOut[1] = 0;
 
     /* dequantize all the samples in each channel */
-    for (ch = 0; ch < m_MP3DecInfo->nChans; ch++) {
-        m_HuffmanInfo->gb[ch] = DequantChannel(m_HuffmanInfo->huffDecBuf[ch], m_DequantInfo->workBuf,
-                &m_HuffmanInfo->nonZeroBound[ch], &m_SideInfoSub[gr][ch], &m_ScaleFactorInfoSub[gr][ch], &cbi[ch]);
+    for (ch = 0; ch < md->mp3DecInfo->nChans; ch++) {
+        md->huffmanInfo->gb[ch] = DequantChannel(md, md->huffmanInfo->huffDecBuf[ch], md->dequantInfo->workBuf,
+                &md->huffmanInfo->nonZeroBound[ch], &md->sideInfoSub[gr][ch], &md->scaleFactorInfoSub[gr][ch], &cbi[ch]);
     }
 
     /* joint stereo processing assumes one guard bit in input samples
@@ -2147,53 +2429,53 @@ int32_t MP3Dequantize(int32_t gr){
      *   just make a pass over the data and clip to [-2^30+1, 2^30-1]
      * in practice this may never happen
      */
-    if (m_FrameHeader->modeExt && (m_HuffmanInfo->gb[0] < 1 || m_HuffmanInfo->gb[1] < 1)) {
-        for (i = 0; i < m_HuffmanInfo->nonZeroBound[0]; i++) {
-            if (m_HuffmanInfo->huffDecBuf[0][i] < -0x3fffffff)  m_HuffmanInfo->huffDecBuf[0][i] = -0x3fffffff;
-            if (m_HuffmanInfo->huffDecBuf[0][i] >  0x3fffffff)  m_HuffmanInfo->huffDecBuf[0][i] =  0x3fffffff;
+    if (md->frameHeader->modeExt && (md->huffmanInfo->gb[0] < 1 || md->huffmanInfo->gb[1] < 1)) {
+        for (i = 0; i < md->huffmanInfo->nonZeroBound[0]; i++) {
+            if (md->huffmanInfo->huffDecBuf[0][i] < -0x3fffffff)  md->huffmanInfo->huffDecBuf[0][i] = -0x3fffffff;
+            if (md->huffmanInfo->huffDecBuf[0][i] >  0x3fffffff)  md->huffmanInfo->huffDecBuf[0][i] =  0x3fffffff;
         }
-        for (i = 0; i < m_HuffmanInfo->nonZeroBound[1]; i++) {
-            if (m_HuffmanInfo->huffDecBuf[1][i] < -0x3fffffff)  m_HuffmanInfo->huffDecBuf[1][i] = -0x3fffffff;
-            if (m_HuffmanInfo->huffDecBuf[1][i] >  0x3fffffff)  m_HuffmanInfo->huffDecBuf[1][i] =  0x3fffffff;
+        for (i = 0; i < md->huffmanInfo->nonZeroBound[1]; i++) {
+            if (md->huffmanInfo->huffDecBuf[1][i] < -0x3fffffff)  md->huffmanInfo->huffDecBuf[1][i] = -0x3fffffff;
+            if (md->huffmanInfo->huffDecBuf[1][i] >  0x3fffffff)  md->huffmanInfo->huffDecBuf[1][i] =  0x3fffffff;
         }
     }
 
     /* do mid-side stereo processing, if enabled */
-    if (m_FrameHeader->modeExt >> 1) {
-        if (m_FrameHeader->modeExt & 0x01) {
+    if (md->frameHeader->modeExt >> 1) {
+        if (md->frameHeader->modeExt & 0x01) {
             /* intensity stereo enabled - run mid-side up to start of right zero region */
             if (cbi[1].cbType == 0)
-                nSamps = m_SFBandTable.l[cbi[1].cbEndL + 1];
+                nSamps = md->sfBandTable.l[cbi[1].cbEndL + 1];
             else
-                nSamps = 3 * m_SFBandTable.s[cbi[1].cbEndSMax + 1];
+                nSamps = 3 * md->sfBandTable.s[cbi[1].cbEndSMax + 1];
         } else {
             /* intensity stereo disabled - run mid-side on whole spectrum */
-            nSamps = (m_HuffmanInfo->nonZeroBound[0] > m_HuffmanInfo->nonZeroBound[1] ?
-                                                       m_HuffmanInfo->nonZeroBound[0] : m_HuffmanInfo->nonZeroBound[1]);
+            nSamps = (md->huffmanInfo->nonZeroBound[0] > md->huffmanInfo->nonZeroBound[1] ?
+                                                       md->huffmanInfo->nonZeroBound[0] : md->huffmanInfo->nonZeroBound[1]);
         }
-        MidSideProc(m_HuffmanInfo->huffDecBuf, nSamps, mOut);
+        MidSideProc(md->huffmanInfo->huffDecBuf, nSamps, mOut);
     }
 
     /* do intensity stereo processing, if enabled */
-    if (m_FrameHeader->modeExt & 0x01) {
-        nSamps = m_HuffmanInfo->nonZeroBound[0];
-        if (m_MPEGVersion == MPEG1) {
-            IntensityProcMPEG1(m_HuffmanInfo->huffDecBuf, nSamps, &m_ScaleFactorInfoSub[gr][1], &m_CriticalBandInfo[0],
-                    m_FrameHeader->modeExt >> 1, m_SideInfoSub[gr][1].mixedBlock, mOut);
+    if (md->frameHeader->modeExt & 0x01) {
+        nSamps = md->huffmanInfo->nonZeroBound[0];
+        if (md->mpegVersion == MPEG1) {
+            IntensityProcMPEG1(md, md->huffmanInfo->huffDecBuf, nSamps, &md->scaleFactorInfoSub[gr][1], &md->criticalBandInfo[0],
+                    md->frameHeader->modeExt >> 1, md->sideInfoSub[gr][1].mixedBlock, mOut);
         } else {
-            IntensityProcMPEG2(m_HuffmanInfo->huffDecBuf, nSamps, &m_ScaleFactorInfoSub[gr][1], &m_CriticalBandInfo[0],
-                    m_ScaleFactorJS, m_FrameHeader->modeExt >> 1, m_SideInfoSub[gr][1].mixedBlock, mOut);
+            IntensityProcMPEG2(md, md->huffmanInfo->huffDecBuf, nSamps, &md->scaleFactorInfoSub[gr][1], &md->criticalBandInfo[0],
+                    md->scaleFactorJS, md->frameHeader->modeExt >> 1, md->sideInfoSub[gr][1].mixedBlock, mOut);
         }
     }
 
     /* adjust guard bit count and nonZeroBound if we did any stereo processing */
-    if (m_FrameHeader->modeExt) {
-        m_HuffmanInfo->gb[0] = CLZ(mOut[0]) - 1;
-        m_HuffmanInfo->gb[1] = CLZ(mOut[1]) - 1;
-        nSamps = (m_HuffmanInfo->nonZeroBound[0] > m_HuffmanInfo->nonZeroBound[1] ?
-                                                       m_HuffmanInfo->nonZeroBound[0] : m_HuffmanInfo->nonZeroBound[1]);
-        m_HuffmanInfo->nonZeroBound[0] = nSamps;
-        m_HuffmanInfo->nonZeroBound[1] = nSamps;
+    if (md->frameHeader->modeExt) {
+        md->huffmanInfo->gb[0] = CLZ(mOut[0]) - 1;
+        md->huffmanInfo->gb[1] = CLZ(mOut[1]) - 1;
+        nSamps = (md->huffmanInfo->nonZeroBound[0] > md->huffmanInfo->nonZeroBound[1] ?
+                                                       md->huffmanInfo->nonZeroBound[0] : md->huffmanInfo->nonZeroBound[1]);
+        md->huffmanInfo->nonZeroBound[0] = nSamps;
+        md->huffmanInfo->nonZeroBound[1] = nSamps;
     }
 
     /* output format Q(DQ_FRACBITS_OUT) */
@@ -2265,7 +2547,7 @@ int32_t DequantBlock(int32_t *inbuf, int32_t *outbuf, int32_t num, int32_t scale
                 if (x < 0x40000000)
                     x <<= 1, shift += 1;
 
-                coef = (x < m_SQRTHALF) ? poly43lo : poly43hi;
+                coef = ((uint32_t)x < m_SQRTHALF) ? poly43lo : poly43hi;
 
                 /* polynomial */
                 y = coef[0];
@@ -2321,7 +2603,7 @@ int32_t DequantBlock(int32_t *inbuf, int32_t *outbuf, int32_t num, int32_t scale
  *
  * Notes:       dequantized samples in Q(DQ_FRACBITS_OUT) format
  **********************************************************************************************************************/
-int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBound,  SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis,
+int32_t DequantChannel(MP3Decoder_t* md, int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBound,  SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis,
                                                                                               CriticalBandInfo_t *cbi)
 {
    int32_t i, j, w, cb;
@@ -2336,7 +2618,7 @@ int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBou
     if (sis->blockType == 2) {
         // cbStartL = 0;
         if (sis->mixedBlock) {
-            cbEndL = (m_MPEGVersion == MPEG1 ? 8 : 6);
+            cbEndL = (md->mpegVersion == MPEG1 ? 8 : 6);
             cbStartS = 3;
         } else {
             cbEndL = 0;
@@ -2365,7 +2647,7 @@ int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBou
      *   dividing every sample by sqrt(2) = multiplying by 2^-.5)
      */
     globalGain = sis->globalGain;
-    if (m_FrameHeader->modeExt >> 1)
+    if (md->frameHeader->modeExt >> 1)
          globalGain -= 2;
     globalGain += m_IMDCT_SCALE;      /* scale everything by sqrt(2), for fast IMDCT36 */
 
@@ -2373,7 +2655,7 @@ int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBou
     for (cb = 0; cb < cbEndL; cb++) {
 
         nonZero = 0;
-        nSamps = m_SFBandTable.l[cb + 1] - m_SFBandTable.l[cb];
+        nSamps = md->sfBandTable.l[cb + 1] - md->sfBandTable.l[cb];
         gainI = 210 - globalGain + sfactMultiplier * (sfis->l[cb] + (sis->preFlag ? (int32_t)preTab[cb] : 0));
 
         nonZero |= DequantBlock(sampleBuf + i, sampleBuf + i, nSamps, gainI);
@@ -2402,7 +2684,7 @@ int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBou
     cbMax[2] = cbMax[1] = cbMax[0] = cbStartS;
     for (cb = cbStartS; cb < cbEndS; cb++) {
 
-        nSamps = m_SFBandTable.s[cb + 1] - m_SFBandTable.s[cb];
+        nSamps = md->sfBandTable.s[cb + 1] - md->sfBandTable.s[cb];
         for (w = 0; w < 3; w++) {
             nonZero =  0;
             gainI = 210 - globalGain + 8*sis->subBlockGain[w] + sfactMultiplier*(sfis->s[cb][w]);
@@ -2514,7 +2796,7 @@ void MidSideProc(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, int32_t mO
  * Notes:       assume at least 1 GB in input
  *
  **********************************************************************************************************************/
-void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  ScaleFactorInfoSub_t *sfis,
+void IntensityProcMPEG1(MP3Decoder_t* md, int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  ScaleFactorInfoSub_t *sfis,
                                                     CriticalBandInfo_t *cbi, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2])
 {
    int32_t i = 0, j = 0, n = 0, cb = 0, w = 0;
@@ -2533,13 +2815,13 @@ void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  Sc
         cbStartL = cbi[1].cbEndL + 1;
         cbEndL = cbi[0].cbEndL + 1;
         cbStartS = cbEndS = 0;
-        i = m_SFBandTable.l[cbStartL];
+        i = md->sfBandTable.l[cbStartL];
     } else if (cbi[1].cbType == 1 || cbi[1].cbType == 2) {
         /* short or mixed block */
         cbStartS = cbi[1].cbEndSMax + 1;
         cbEndS = cbi[0].cbEndSMax + 1;
         cbStartL = cbEndL = 0;
-        i = 3 * m_SFBandTable.s[cbStartS];
+        i = 3 * md->sfBandTable.s[cbStartS];
     }
     sampsLeft = nSamps - i; /* process to length of left */
     isfTab = (int32_t *) ISFMpeg1[midSideFlag];
@@ -2556,7 +2838,7 @@ void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  Sc
             fr = isfTab[6] - isfTab[isf];
         }
 
-        n = m_SFBandTable.l[cb + 1] - m_SFBandTable.l[cb];
+        n = md->sfBandTable.l[cb + 1] - md->sfBandTable.l[cb];
         for (j = 0; j < n && sampsLeft > 0; j++, i++) {
             xr = MULSHIFT32(fr, x[0][i]) << 2;
             x[1][i] = xr;
@@ -2579,7 +2861,7 @@ void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  Sc
                 frs[w] = isfTab[6] - isfTab[isf];
             }
         }
-        n = m_SFBandTable.s[cb + 1] - m_SFBandTable.s[cb];
+        n = md->sfBandTable.s[cb + 1] - md->sfBandTable.s[cb];
         for (j = 0; j < n && sampsLeft >= 3; j++, i += 3) {
             xr = MULSHIFT32(frs[0], x[0][i + 0]) << 2;
             x[1][i + 0] = xr;
@@ -2628,7 +2910,7 @@ void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  Sc
  * Notes:       assume at least 1 GB in input
  *
  **********************************************************************************************************************/
-void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
+void IntensityProcMPEG2(MP3Decoder_t* md, int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
          ScaleFactorInfoSub_t *sfis, CriticalBandInfo_t *cbi,
         ScaleFactorJS_t *sfjs, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2]) {
    int32_t i, j, k, n, r, cb, w;
@@ -2655,7 +2937,7 @@ void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
         il[21] = il[22] = 1;
         cbStartL = cbi[1].cbEndL + 1; /* start at end of right */
         cbEndL = cbi[0].cbEndL + 1; /* process to end of left */
-        i = m_SFBandTable.l[cbStartL];
+        i = md->sfBandTable.l[cbStartL];
         sampsLeft = nSamps - i;
 
         for (cb = cbStartL; cb < cbEndL; cb++) {
@@ -2668,7 +2950,7 @@ void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
                 fl = isfTab[(sfIdx & 0x01 ? isf : 0)];
                 fr = isfTab[(sfIdx & 0x01 ? 0 : isf)];
             }
-           int32_t r=m_SFBandTable.l[cb + 1] - m_SFBandTable.l[cb];
+           int32_t r=md->sfBandTable.l[cb + 1] - md->sfBandTable.l[cb];
             n=(r < sampsLeft ? r : sampsLeft);
             //n = MIN(fh->sfBand->l[cb + 1] - fh->sfBand->l[cb], sampsLeft);
             for (j = 0; j < n; j++, i++) {
@@ -2691,7 +2973,7 @@ void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
         for (w = 0; w < 3; w++) {
             cbStartS = cbi[1].cbEndS[w] + 1; /* start at end of right */
             cbEndS = cbi[0].cbEndS[w] + 1; /* process to end of left */
-            i = 3 * m_SFBandTable.s[cbStartS] + w;
+            i = 3 * md->sfBandTable.s[cbStartS] + w;
 
             /* skip through sample array by 3, so early-exit logic would be more tricky */
             for (cb = cbStartS; cb < cbEndS; cb++) {
@@ -2704,7 +2986,7 @@ void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
                     fl = isfTab[(sfIdx & 0x01 ? isf : 0)];
                     fr = isfTab[(sfIdx & 0x01 ? 0 : isf)];
                 }
-                n = m_SFBandTable.s[cb + 1] - m_SFBandTable.s[cb];
+                n = md->sfBandTable.s[cb + 1] - md->sfBandTable.s[cb];
 
                 for (j = 0; j < n; j++, i += 3) {
                     xr = MULSHIFT32(fr, x[0][i]) << 2;
@@ -3430,24 +3712,24 @@ int32_t HybridTransform(int32_t *xCurr, int32_t *xPrev, int32_t y[m_BLOCK_SIZE][
  **********************************************************************************************************************/
 // a bit faster in RAM
 /*__attribute__ ((section (".data")))*/
-int32_t IMDCT(int32_t gr, int32_t ch) {
+int32_t IMDCT(MP3Decoder_t* md, int32_t gr, int32_t ch) {
    int32_t nBfly, blockCutoff;
     BlockCount_t bc;
 
-    /* m_SideInfo is an array of up to 4 structs, stored as gr0ch0, gr0ch1, gr1ch0, gr1ch1 */
+    /* md->sideInfo is an array of up to 4 structs, stored as gr0ch0, gr0ch1, gr1ch0, gr1ch1 */
     /* anti-aliasing done on whole long blocks only
      * for mixed blocks, nBfly always 1, except 3 for 8 kHz MPEG 2.5 (see sfBandTab)
      *   nLongBlocks = number of blocks with (possibly) non-zero power
      *   nBfly = number of butterflies to do (nLongBlocks - 1, unless no long blocks)
      */
-    blockCutoff = m_SFBandTable.l[(m_MPEGVersion == MPEG1 ? 8 : 6)] / 18; /* same as 3* num short sfb's in spec */
-    if (m_SideInfoSub[gr][ch].blockType != 2) {
+    blockCutoff = md->sfBandTable.l[(md->mpegVersion == MPEG1 ? 8 : 6)] / 18; /* same as 3* num short sfb's in spec */
+    if (md->sideInfoSub[gr][ch].blockType != 2) {
         /* all long transforms */
-       int32_t x=(m_HuffmanInfo->nonZeroBound[ch] + 7) / 18 + 1;
+       int32_t x=(md->huffmanInfo->nonZeroBound[ch] + 7) / 18 + 1;
         bc.nBlocksLong=(x<32 ? x : 32);
         //bc.nBlocksLong = min((hi->nonZeroBound[ch] + 7) / 18 + 1, 32);
         nBfly = bc.nBlocksLong - 1;
-    } else if (m_SideInfoSub[gr][ch].blockType == 2 && m_SideInfoSub[gr][ch].mixedBlock) {
+    } else if (md->sideInfoSub[gr][ch].blockType == 2 && md->sideInfoSub[gr][ch].mixedBlock) {
         /* mixed block - long transforms until cutoff, then short transforms */
         bc.nBlocksLong = blockCutoff;
         nBfly = bc.nBlocksLong - 1;
@@ -3457,29 +3739,29 @@ int32_t IMDCT(int32_t gr, int32_t ch) {
         nBfly = 0;
     }
 
-    AntiAlias(m_HuffmanInfo->huffDecBuf[ch], nBfly);
-   int32_t x=m_HuffmanInfo->nonZeroBound[ch];
+    AntiAlias(md->huffmanInfo->huffDecBuf[ch], nBfly);
+   int32_t x=md->huffmanInfo->nonZeroBound[ch];
    int32_t y=nBfly * 18 + 8;
-    m_HuffmanInfo->nonZeroBound[ch]=(x>y ? x: y);
+    md->huffmanInfo->nonZeroBound[ch]=(x>y ? x: y);
 
-    assert(m_HuffmanInfo->nonZeroBound[ch] <= m_MAX_NSAMP);
+    assert(md->huffmanInfo->nonZeroBound[ch] <= m_MAX_NSAMP);
 
     /* for readability, use a struct instead of passing a million parameters to HybridTransform() */
-    bc.nBlocksTotal = (m_HuffmanInfo->nonZeroBound[ch] + 17) / 18;
-    bc.nBlocksPrev = m_IMDCTInfo->numPrevIMDCT[ch];
-    bc.prevType = m_IMDCTInfo->prevType[ch];
-    bc.prevWinSwitch = m_IMDCTInfo->prevWinSwitch[ch];
+    bc.nBlocksTotal = (md->huffmanInfo->nonZeroBound[ch] + 17) / 18;
+    bc.nBlocksPrev = md->imdctInfo->numPrevIMDCT[ch];
+    bc.prevType = md->imdctInfo->prevType[ch];
+    bc.prevWinSwitch = md->imdctInfo->prevWinSwitch[ch];
     /* where WINDOW switches (not nec. transform) */
-    bc.currWinSwitch = (m_SideInfoSub[gr][ch].mixedBlock ? blockCutoff : 0);
-    bc.gbIn = m_HuffmanInfo->gb[ch];
+    bc.currWinSwitch = (md->sideInfoSub[gr][ch].mixedBlock ? blockCutoff : 0);
+    bc.gbIn = md->huffmanInfo->gb[ch];
 
-    m_IMDCTInfo->numPrevIMDCT[ch] = HybridTransform(m_HuffmanInfo->huffDecBuf[ch], m_IMDCTInfo->overBuf[ch],
-            m_IMDCTInfo->outBuf[ch], &m_SideInfoSub[gr][ch], &bc);
-    m_IMDCTInfo->prevType[ch] = m_SideInfoSub[gr][ch].blockType;
-    m_IMDCTInfo->prevWinSwitch[ch] = bc.currWinSwitch; /* 0 means not a mixed block (either all short or all long) */
-    m_IMDCTInfo->gb[ch] = bc.gbOut;
+    md->imdctInfo->numPrevIMDCT[ch] = HybridTransform(md->huffmanInfo->huffDecBuf[ch], md->imdctInfo->overBuf[ch],
+            md->imdctInfo->outBuf[ch], &md->sideInfoSub[gr][ch], &bc);
+    md->imdctInfo->prevType[ch] = md->sideInfoSub[gr][ch].blockType;
+    md->imdctInfo->prevWinSwitch[ch] = bc.currWinSwitch; /* 0 means not a mixed block (either all short or all long) */
+    md->imdctInfo->gb[ch] = bc.gbOut;
 
-    assert(m_IMDCTInfo->numPrevIMDCT[ch] <= m_NBANDS);
+    assert(md->imdctInfo->numPrevIMDCT[ch] <= m_NBANDS);
 
     /* output has gained 2int32_t bits */
     return 0;
@@ -3501,28 +3783,28 @@ int32_t IMDCT(int32_t gr, int32_t ch) {
  *
  * Return:      0 on success,  -1 if null input pointers
  **********************************************************************************************************************/
-int32_t Subband(int16_t *pcmBuf) {
+int32_t Subband(MP3Decoder_t* md, int16_t *pcmBuf) {
    int32_t b;
-    if (m_MP3DecInfo->nChans == 2) {
+    if (md->mp3DecInfo->nChans == 2) {
         /* stereo */
         for (b = 0; b < m_BLOCK_SIZE; b++) {
-            FDCT32(m_IMDCTInfo->outBuf[0][b], m_SubbandInfo->vbuf + 0 * 32, m_SubbandInfo->vindex,
-                    (b & 0x01), m_IMDCTInfo->gb[0]);
-            FDCT32(m_IMDCTInfo->outBuf[1][b], m_SubbandInfo->vbuf + 1 * 32, m_SubbandInfo->vindex,
-                    (b & 0x01), m_IMDCTInfo->gb[1]);
+            FDCT32(md->imdctInfo->outBuf[0][b], md->subbandInfo->vbuf + 0 * 32, md->subbandInfo->vindex,
+                    (b & 0x01), md->imdctInfo->gb[0]);
+            FDCT32(md->imdctInfo->outBuf[1][b], md->subbandInfo->vbuf + 1 * 32, md->subbandInfo->vindex,
+                    (b & 0x01), md->imdctInfo->gb[1]);
             PolyphaseStereo(pcmBuf,
-                    m_SubbandInfo->vbuf + m_SubbandInfo->vindex + m_VBUF_LENGTH * (b & 0x01),
+                    md->subbandInfo->vbuf + md->subbandInfo->vindex + m_VBUF_LENGTH * (b & 0x01),
                     polyCoef);
-            m_SubbandInfo->vindex = (m_SubbandInfo->vindex - (b & 0x01)) & 7;
+            md->subbandInfo->vindex = (md->subbandInfo->vindex - (b & 0x01)) & 7;
             pcmBuf += (2 * m_NBANDS);
         }
     } else {
         /* mono */
         for (b = 0; b < m_BLOCK_SIZE; b++) {
-            FDCT32(m_IMDCTInfo->outBuf[0][b], m_SubbandInfo->vbuf + 0 * 32, m_SubbandInfo->vindex,
-                    (b & 0x01), m_IMDCTInfo->gb[0]);
-            PolyphaseMono(pcmBuf, m_SubbandInfo->vbuf + m_SubbandInfo->vindex + m_VBUF_LENGTH * (b & 0x01), polyCoef);
-            m_SubbandInfo->vindex = (m_SubbandInfo->vindex - (b & 0x01)) & 7;
+            FDCT32(md->imdctInfo->outBuf[0][b], md->subbandInfo->vbuf + 0 * 32, md->subbandInfo->vindex,
+                    (b & 0x01), md->imdctInfo->gb[0]);
+            PolyphaseMono(pcmBuf, md->subbandInfo->vbuf + md->subbandInfo->vindex + m_VBUF_LENGTH * (b & 0x01), polyCoef);
+            md->subbandInfo->vindex = (md->subbandInfo->vindex - (b & 0x01)) & 7;
             pcmBuf += m_NBANDS;
         }
     }
@@ -3567,8 +3849,6 @@ int32_t Subband(int16_t *pcmBuf) {
 	buf[16+i] = b2 + b3;    buf[31-i] = MULSHIFT32(*cptr++, b3 - b2) << (s2); \
 }
 
-static const uint8_t FDCT32s1s2[16] = {5,3,3,2,2,1,1,1, 1,1,1,1,1,2,2,4};
-
 void FDCT32(int32_t *buf, int32_t *dest, int32_t offset, int32_t oddBlock, int32_t gb) {
     int32_t i, s, tmp, es;
     const int32_t *cptr = (const int32_t*)m_dcttab;
@@ -3587,10 +3867,15 @@ void FDCT32(int32_t *buf, int32_t *dest, int32_t offset, int32_t oddBlock, int32
 			buf[i] >>= es;
 	}
 
-	/* first pass */
-    for (unsigned i=0; i < 8; i++) {
-        D32FP(i, FDCT32s1s2[0 + i], FDCT32s1s2[8 + i]);
-    }
+	/* first pass, constant shifts */
+	D32FP(0, 5, 1);
+	D32FP(1, 3, 1);
+	D32FP(2, 3, 1);
+	D32FP(3, 2, 1);
+	D32FP(4, 2, 1);
+	D32FP(5, 1, 2);
+	D32FP(6, 1, 2);
+	D32FP(7, 1, 4);
 
 	/* second pass */
 	for (i = 4; i > 0; i--) {
@@ -3724,6 +4009,11 @@ short ClipToShort(int32_t x, int32_t fracBits){
     return x;
 #endif
 }
+/* polyphase output: the 64 bit sum (rndVal already added) is scaled to Q0 and saturated in one step */
+inline
+short ClipSumToShort(uint64_t sum){
+    return ClipToShort((int32_t)SAR64(sum, (32 - m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+}
 /***********************************************************************************************************************
  * Function:    PolyphaseMono
  *
@@ -3755,9 +4045,9 @@ void PolyphaseMono(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
     sum1L = rndVal;
     for(int32_t j=0; j<8; j++){
         c1=*coef; coef++; c2=*coef; coef++; vLo=*(vb1+(j)); vHi=*(vb1+(23-(j))); // 0...7
-        sum1L=MADD64(sum1L, vLo, c1); sum1L=MADD64(sum1L, vHi, -c2);
+        sum1L=MADD64(sum1L, vLo, c1); sum1L=MSUB64(sum1L, vHi, c2);
     }
-    *(pcm + 0) = ClipToShort((int32_t)SAR64(sum1L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+    *(pcm + 0) = ClipSumToShort(sum1L);
 
     /* special case, output sample 16 */
     coef = coefBase + 256;
@@ -3766,7 +4056,7 @@ void PolyphaseMono(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
     for(int32_t j=0; j<8; j++){
         c1=*coef; coef++; vLo=*(vb1+(j)); sum1L = MADD64(sum1L, vLo,  c1); // 0...7
     }
-    *(pcm + 16) = ClipToShort((int32_t)SAR64(sum1L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+    *(pcm + 16) = ClipSumToShort(sum1L);
 
     /* main convolution loop: sum1L = samples 1, 2, 3, ... 15   sum2L = samples 31, 30, ... 17 */
     coef = coefBase + 16;
@@ -3779,11 +4069,11 @@ void PolyphaseMono(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
         for(int32_t j=0; j<8; j++){
             c1=*coef; coef++; c2=*coef; coef++; vLo=*(vb1+(j)); vHi = *(vb1+(23-(j)));
             sum1L=MADD64(sum1L, vLo,  c1); sum2L = MADD64(sum2L, vLo,  c2);
-            sum1L=MADD64(sum1L, vHi, -c2); sum2L = MADD64(sum2L, vHi,  c1);
+            sum1L=MSUB64(sum1L, vHi, c2); sum2L = MADD64(sum2L, vHi,  c1);
         }
         vb1 += 64;
-        *(pcm)       = ClipToShort((int32_t)SAR64(sum1L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
-        *(pcm + 2*i) = ClipToShort((int32_t)SAR64(sum2L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+        *(pcm)       = ClipSumToShort(sum1L);
+        *(pcm + 2*i) = ClipSumToShort(sum2L);
         pcm++;
     }
 }
@@ -3821,12 +4111,12 @@ void PolyphaseStereo(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
 
     for(int32_t j=0; j<8; j++){
         c1=*coef; coef++; c2=*coef; coef++; vLo=*(vb1+(j)); vHi = *(vb1+(23-(j)));
-        sum1L=MADD64(sum1L, vLo,  c1); sum1L=MADD64(sum1L, vHi, -c2);
+        sum1L=MADD64(sum1L, vLo,  c1); sum1L=MSUB64(sum1L, vHi, c2);
         vLo=*(vb1+32+(j)); vHi=*(vb1+32+(23-(j)));
-        sum1R=MADD64(sum1R, vLo,  c1); sum1R=MADD64(sum1R, vHi, -c2); \
+        sum1R=MADD64(sum1R, vLo,  c1); sum1R=MSUB64(sum1R, vHi, c2); \
     }
-    *(pcm + 0) = ClipToShort((int32_t)SAR64(sum1L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
-    *(pcm + 1) = ClipToShort((int32_t)SAR64(sum1R, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+    *(pcm + 0) = ClipSumToShort(sum1L);
+    *(pcm + 1) = ClipSumToShort(sum1R);
 
     /* special case, output sample 16 */
     coef = coefBase + 256;
@@ -3837,8 +4127,8 @@ void PolyphaseStereo(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
         c1=*coef; coef++; vLo = *(vb1+(j)); sum1L = MADD64(sum1L, vLo,  c1);
         vLo = *(vb1+32+(j)); sum1R = MADD64(sum1R, vLo,  c1);
     }
-    *(pcm + 2*16 + 0) = ClipToShort((int32_t)SAR64(sum1L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
-    *(pcm + 2*16 + 1) = ClipToShort((int32_t)SAR64(sum1R, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+    *(pcm + 2*16 + 0) = ClipSumToShort(sum1L);
+    *(pcm + 2*16 + 1) = ClipSumToShort(sum1R);
 
     /* main convolution loop: sum1L = samples 1, 2, 3, ... 15   sum2L = samples 31, 30, ... 17 */
     coef = coefBase + 16;
@@ -3853,16 +4143,16 @@ void PolyphaseStereo(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
         for(int32_t j=0; j<8; j++){
             c1=*coef; coef++; c2=*coef; coef++; vLo=*(vb1+(j)); vHi = *(vb1+(23-(j)));
             sum1L=MADD64(sum1L, vLo,  c1); sum2L=MADD64(sum2L, vLo,  c2);
-            sum1L=MADD64(sum1L, vHi, -c2); sum2L=MADD64(sum2L, vHi,  c1);
+            sum1L=MSUB64(sum1L, vHi, c2); sum2L=MADD64(sum2L, vHi,  c1);
             vLo=*(vb1+32+(j));  vHi=*(vb1+32+(23-(j)));
             sum1R=MADD64(sum1R, vLo,  c1); sum2R=MADD64(sum2R, vLo,  c2);
-            sum1R=MADD64(sum1R, vHi, -c2); sum2R=MADD64(sum2R, vHi,  c1);
+            sum1R=MSUB64(sum1R, vHi, c2); sum2R=MADD64(sum2R, vHi,  c1);
         }
         vb1 += 64;
-        *(pcm + 0)         = ClipToShort((int32_t)SAR64(sum1L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
-        *(pcm + 1)         = ClipToShort((int32_t)SAR64(sum1R, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
-        *(pcm + 2*2*i + 0) = ClipToShort((int32_t)SAR64(sum2L, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
-        *(pcm + 2*2*i + 1) = ClipToShort((int32_t)SAR64(sum2R, (32-m_CSHIFT)), m_DQ_FRACBITS_OUT - 2 - 2 - 15);
+        *(pcm + 0)         = ClipSumToShort(sum1L);
+        *(pcm + 1)         = ClipSumToShort(sum1R);
+        *(pcm + 2*2*i + 0) = ClipSumToShort(sum2L);
+        *(pcm + 2*2*i + 1) = ClipSumToShort(sum2R);
         pcm += 2;
     }
 }
@@ -55,6 +55,13 @@ typedef struct BitStreamInfo {
     int32_t nBytes;
 } BitStreamInfo_t;
 
+typedef struct HuffBits {   /* bit cache of the Huffman decoder, refilled bytewise */
+    uint64_t cache;         /* left-justified, zeros behind the last valid bit */
+    int32_t cachedBits;     /* valid bits in cache, < 0: more bits consumed than the block has */
+    int32_t bitsLeft;       /* bits of the block not yet in cache */
+    uint8_t *buf;
+} HuffBits_t;
+
 typedef enum {          /* map these to the corresponding 2-bit values in the frame header */
     Stereo = 0x00,      /* two independent channels, but L and R frames might have different # of bits */
     Joint = 0x01,       /* coupled channels - layer III: mix of M-S and intensity, Layers I/II: intensity and direct coding only */
@@ -197,6 +204,25 @@ typedef struct MP3DecInfo {
     int32_t part23Length[m_MAX_NGRAN][m_MAX_NCHAN];
 } MP3DecInfo_t;
 
+typedef struct MP3Decoder_t {   /* complete state of one decoder instance, see MP3Decoder_AllocateBuffers() */
+    MP3DecInfo_t *mp3DecInfo;
+    MP3FrameInfo_t *mp3FrameInfo;
+    FrameHeader_t *frameHeader;
+    SideInfo_t *sideInfo;
+    DequantInfo_t *dequantInfo;
+    HuffmanInfo_t *huffmanInfo;
+    IMDCTInfo_t *imdctInfo;
+    ScaleFactorJS_t *scaleFactorJS;
+    SubbandInfo_t *subbandInfo;
+    SFBandTable_t sfBandTable;
+    StereoMode_t sMode;         /* mono/stereo mode */
+    MPEGVersion_t mpegVersion;  /* version ID */
+    SideInfoSub_t sideInfoSub[m_MAX_NGRAN][m_MAX_NCHAN];
+    CriticalBandInfo_t criticalBandInfo[m_MAX_NCHAN];  /* filled in dequantizer, used in joint stereo reconstruction */
+    ScaleFactorInfoSub_t scaleFactorInfoSub[m_MAX_NGRAN][m_MAX_NCHAN];
+    uint8_t underflowCounter;   /* http://macslons-irish-pub-radio.stream.laut.fm/macslons-irish-pub-radio */
+} MP3Decoder_t;
+
 
 
 
@@ -279,21 +305,21 @@ const int32_t pow2frac[8] PROGMEM = {
     0x50a28be6, 0x7fffffff, 0x6597fa94, 0x50a28be6
 };
 
-const uint16_t m_HUFF_OFFSET_01=  0;
-const uint16_t m_HUFF_OFFSET_02=  9 + m_HUFF_OFFSET_01;
-const uint16_t m_HUFF_OFFSET_03= 65 + m_HUFF_OFFSET_02;
-const uint16_t m_HUFF_OFFSET_05= 65 + m_HUFF_OFFSET_03;
-const uint16_t m_HUFF_OFFSET_06=257 + m_HUFF_OFFSET_05;
-const uint16_t m_HUFF_OFFSET_07=129 + m_HUFF_OFFSET_06;
-const uint16_t m_HUFF_OFFSET_08=110 + m_HUFF_OFFSET_07;
-const uint16_t m_HUFF_OFFSET_09=280 + m_HUFF_OFFSET_08;
-const uint16_t m_HUFF_OFFSET_10= 93 + m_HUFF_OFFSET_09;
-const uint16_t m_HUFF_OFFSET_11=320 + m_HUFF_OFFSET_10;
-const uint16_t m_HUFF_OFFSET_12=296 + m_HUFF_OFFSET_11;
-const uint16_t m_HUFF_OFFSET_13=185 + m_HUFF_OFFSET_12;
-const uint16_t m_HUFF_OFFSET_15=497 + m_HUFF_OFFSET_13;
-const uint16_t m_HUFF_OFFSET_16=580 + m_HUFF_OFFSET_15;
-const uint16_t m_HUFF_OFFSET_24=651 + m_HUFF_OFFSET_16;
+const uint16_t m_HUFF_OFFSET_01=   0;
+const uint16_t m_HUFF_OFFSET_02=  33 + m_HUFF_OFFSET_01;
+const uint16_t m_HUFF_OFFSET_03= 257 + m_HUFF_OFFSET_02;
+const uint16_t m_HUFF_OFFSET_05= 257 + m_HUFF_OFFSET_03;
+const uint16_t m_HUFF_OFFSET_06= 513 + m_HUFF_OFFSET_05;
+const uint16_t m_HUFF_OFFSET_07= 513 + m_HUFF_OFFSET_06;
+const uint16_t m_HUFF_OFFSET_08= 517 + m_HUFF_OFFSET_07;
+const uint16_t m_HUFF_OFFSET_09= 519 + m_HUFF_OFFSET_08;
+const uint16_t m_HUFF_OFFSET_10= 513 + m_HUFF_OFFSET_09;
+const uint16_t m_HUFF_OFFSET_11= 541 + m_HUFF_OFFSET_10;
+const uint16_t m_HUFF_OFFSET_12= 529 + m_HUFF_OFFSET_11;
+const uint16_t m_HUFF_OFFSET_13= 515 + m_HUFF_OFFSET_12;
+const uint16_t m_HUFF_OFFSET_15=1743 + m_HUFF_OFFSET_13;
+const uint16_t m_HUFF_OFFSET_16= 697 + m_HUFF_OFFSET_15;
+const uint16_t m_HUFF_OFFSET_24=1015 + m_HUFF_OFFSET_16;
 
 const int32_t huffTabOffset[m_HUFF_PAIRTABS] PROGMEM = {
     0,                   m_HUFF_OFFSET_01,    m_HUFF_OFFSET_02,    m_HUFF_OFFSET_03,
@@ -341,8 +367,8 @@ const HuffTabLookup_t huffTabLookup[m_HUFF_PAIRTABS] PROGMEM = {
 };
 
 
-const int32_t quadTabOffset[2] PROGMEM = {0, 64};
-const int32_t quadTabMaxBits[2] PROGMEM = {6, 4};
+const int32_t quadTabOffset[2] PROGMEM = {0, 1024};
+const int32_t quadTabMaxBits[2] PROGMEM = {6, 4};   /* the tables are indexed with maxBits + 4 bits */
 
 /* indexing = [version][samplerate index]
  * sample rate of frame (Hz)
@@ -455,47 +481,46 @@ const uint32_t csa[8][2] PROGMEM = {
  */
 
 // prototypes
-bool MP3Decoder_AllocateBuffers(void);
-bool MP3Decoder_IsInit();
-void MP3Decoder_FreeBuffers();
-int32_t  MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t useSize);
-void     MP3GetLastFrameInfo();
-int32_t  MP3GetNextFrameInfo(uint8_t *buf);
+MP3Decoder_t* MP3Decoder_AllocateBuffers(void);
+void MP3Decoder_FreeBuffers(MP3Decoder_t* md);
+int32_t  MP3Decode(MP3Decoder_t* md, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t useSize);
+void     MP3GetLastFrameInfo(MP3Decoder_t* md);
+int32_t  MP3GetNextFrameInfo(MP3Decoder_t* md, uint8_t *buf);
 int32_t  MP3FindSyncWord(uint8_t *buf, int32_t nBytes);
-int32_t  MP3GetSampRate();
-int32_t  MP3GetChannels();
-int32_t  MP3GetBitsPerSample();
-int32_t  MP3GetBitrate();
-int32_t  MP3GetOutputSamps();
-int32_t  MP3GetLayer();
-int32_t  MP3GetVersion();
+int32_t  MP3GetSampRate(MP3Decoder_t* md);
+int32_t  MP3GetChannels(MP3Decoder_t* md);
+int32_t  MP3GetBitsPerSample(MP3Decoder_t* md);
+int32_t  MP3GetBitrate(MP3Decoder_t* md);
+int32_t  MP3GetOutputSamps(MP3Decoder_t* md);
+int32_t  MP3GetLayer(MP3Decoder_t* md);
+int32_t  MP3GetVersion(MP3Decoder_t* md);
 
 //internally used
-void MP3Decoder_ClearBuffer(void);
+void MP3Decoder_ClearBuffer(MP3Decoder_t* md);
 void PolyphaseMono(int16_t *pcm, int32_t *vbuf, const uint32_t* coefBase);
 void PolyphaseStereo(int16_t *pcm, int32_t *vbuf, const uint32_t* coefBase);
 void SetBitstreamPointer(BitStreamInfo_t *bsi, int32_t nBytes, uint8_t *buf);
 uint32_t GetBits(BitStreamInfo_t *bsi, int32_t nBits);
 int32_t CalcBitsUsed(BitStreamInfo_t *bsi, uint8_t *startBuf, int32_t startOffset);
-int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBound, SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis, CriticalBandInfo_t *cbi);
+int32_t DequantChannel(MP3Decoder_t* md, int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBound, SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis, CriticalBandInfo_t *cbi);
 void MidSideProc(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, int32_t mOut[2]);
-void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, ScaleFactorInfoSub_t *sfis,	CriticalBandInfo_t *cbi, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2]);
-void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, ScaleFactorInfoSub_t *sfis, CriticalBandInfo_t *cbi, ScaleFactorJS_t *sfjs, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2]);
+void IntensityProcMPEG1(MP3Decoder_t* md, int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, ScaleFactorInfoSub_t *sfis,	CriticalBandInfo_t *cbi, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2]);
+void IntensityProcMPEG2(MP3Decoder_t* md, int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, ScaleFactorInfoSub_t *sfis, CriticalBandInfo_t *cbi, ScaleFactorJS_t *sfjs, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2]);
 void FDCT32(int32_t *x, int32_t *d, int32_t offset, int32_t oddBlock, int32_t gb);// __attribute__ ((section (".data")));
-int32_t CheckPadBit();
-int32_t UnpackFrameHeader(uint8_t *buf);
-int32_t UnpackSideInfo(uint8_t *buf);
-int32_t DecodeHuffman( uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, int32_t gr, int32_t ch);
-int32_t MP3Dequantize( int32_t gr);
-int32_t IMDCT( int32_t gr, int32_t ch);
-int32_t UnpackScaleFactors( uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail, int32_t gr, int32_t ch);
-int32_t Subband(int16_t *pcmBuf);
+int32_t CheckPadBit(MP3Decoder_t* md);
+int32_t UnpackFrameHeader(MP3Decoder_t* md, uint8_t *buf);
+int32_t UnpackSideInfo(MP3Decoder_t* md, uint8_t *buf);
+int32_t DecodeHuffman(MP3Decoder_t* md, uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, int32_t gr, int32_t ch);
+int32_t MP3Dequantize(MP3Decoder_t* md, int32_t gr);
+int32_t IMDCT(MP3Decoder_t* md, int32_t gr, int32_t ch);
+int32_t UnpackScaleFactors(MP3Decoder_t* md, uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail, int32_t gr, int32_t ch);
+int32_t Subband(MP3Decoder_t* md, int16_t *pcmBuf);
 int16_t ClipToShort(int32_t x, int32_t fracBits);
 void RefillBitstreamCache(BitStreamInfo_t *bsi);
 void UnpackSFMPEG1(BitStreamInfo_t *bsi, SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis, int32_t *scfsi, int32_t gr, ScaleFactorInfoSub_t *sfisGr0);
 void UnpackSFMPEG2(BitStreamInfo_t *bsi, SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis, int32_t gr, int32_t ch, int32_t modeExt, ScaleFactorJS_t *sfjs);
 int32_t MP3FindFreeSync(uint8_t *buf, uint8_t firstFH[4], int32_t nBytes);
-void MP3ClearBadFrame( int16_t *outbuf);
+void MP3ClearBadFrame(MP3Decoder_t* md, int16_t *outbuf);
 int32_t DecodeHuffmanPairs(int32_t *xy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset);
 int32_t DecodeHuffmanQuads(int32_t *vwxy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset);
 int32_t DequantBlock(int32_t *inbuf, int32_t *outbuf, int32_t num, int32_t scale);
@@ -510,6 +535,7 @@ int32_t HybridTransform(int32_t *xCurr, int32_t *xPrev, int32_t y[m_BLOCK_SIZE][
 inline uint64_t SAR64(uint64_t x, int32_t n) {return x >> n;}
 inline int32_t MULSHIFT32(int32_t x, int32_t y) { int32_t z; z = (uint64_t) x * (uint64_t) y >> 32; return z;}
 inline uint64_t MADD64(uint64_t sum64, int32_t x, int32_t y) {sum64 += (uint64_t) x * (uint64_t) y; return sum64;}/* returns 64-bit value in [edx:eax] */
+inline uint64_t MSUB64(uint64_t sum64, int32_t x, int32_t y) {sum64 -= (uint64_t) x * (uint64_t) y; return sum64;}
 inline uint64_t xSAR64(uint64_t x, int32_t n){return x >> n;}
 inline int32_t FASTABS(int32_t x){ return __builtin_abs(x);} //xtensa has a fast abs instruction //fb
 #define CLZ(x) __builtin_clz(x) //fb
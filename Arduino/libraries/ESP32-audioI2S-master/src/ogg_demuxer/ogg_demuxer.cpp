@@ -0,0 +1,190 @@
+/*
+ * ogg_demuxer.cpp
+ * splits Ogg pages into packets for the FLAC, OPUS and VORBIS decoders
+ * reference https://www.xiph.org/ogg/doc/rfc3533.txt
+ *
+ *  Created on: 19.10.2026
+ */
+//----------------------------------------------------------------------------------------------------------------------
+//                                     O G G   D E M U X E R
+//----------------------------------------------------------------------------------------------------------------------
+// The demuxer never copies packet data. OGGparsePage() fills the packet length table of the caller, the packets follow
+// the page header directly in the input buffer. A packet that continues on the next page is joined in place by
+// OGGjoinContinuedPacket(): the first part is moved behind the header of the next page, so that both parts are
+// contiguous and the remaining packets of the next page stay where they are.
+// The CRC of a page that is completely in the buffer is checked by OGGparsePage(). The decoders see the stream through a
+// window of a few KB (OPUS 1 KB), most pages are bigger. For these the CRC is carried in an oggCrc_t across the decode
+// calls: OGGcrcFeed() at the start of each call adds the bytes of the open page that have come into the window,
+// OGGcrcConsumed() at the end moves the window by the bytes the decoder has consumed. The result is known when the last
+// byte of the page has arrived, the packets in front of it are decoded already. OGGcrcBadPageRest() tells the decoder
+// how much of the bad page is left to skip.
+
+#include "ogg_demuxer.h"
+#include "Arduino.h"
+
+// CRC-32, polynomial 0x04C11DB7, initial value 0, no reflection, no final xor (rfc3533 chapter 6)
+const uint32_t oggCrcTable[256] PROGMEM = {
+    0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
+    0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
+    0x4C11DB70, 0x48D0C6C7, 0x4593E01E, 0x4152FDA9, 0x5F15ADAC, 0x5BD4B01B, 0x569796C2, 0x52568B75,
+    0x6A1936C8, 0x6ED82B7F, 0x639B0DA6, 0x675A1011, 0x791D4014, 0x7DDC5DA3, 0x709F7B7A, 0x745E66CD,
+    0x9823B6E0, 0x9CE2AB57, 0x91A18D8E, 0x95609039, 0x8B27C03C, 0x8FE6DD8B, 0x82A5FB52, 0x8664E6E5,
+    0xBE2B5B58, 0xBAEA46EF, 0xB7A96036, 0xB3687D81, 0xAD2F2D84, 0xA9EE3033, 0xA4AD16EA, 0xA06C0B5D,
+    0xD4326D90, 0xD0F37027, 0xDDB056FE, 0xD9714B49, 0xC7361B4C, 0xC3F706FB, 0xCEB42022, 0xCA753D95,
+    0xF23A8028, 0xF6FB9D9F, 0xFBB8BB46, 0xFF79A6F1, 0xE13EF6F4, 0xE5FFEB43, 0xE8BCCD9A, 0xEC7DD02D,
+    0x34867077, 0x30476DC0, 0x3D044B19, 0x39C556AE, 0x278206AB, 0x23431B1C, 0x2E003DC5, 0x2AC12072,
+    0x128E9DCF, 0x164F8078, 0x1B0CA6A1, 0x1FCDBB16, 0x018AEB13, 0x054BF6A4, 0x0808D07D, 0x0CC9CDCA,
+    0x7897AB07, 0x7C56B6B0, 0x71159069, 0x75D48DDE, 0x6B93DDDB, 0x6F52C06C, 0x6211E6B5, 0x66D0FB02,
+    0x5E9F46BF, 0x5A5E5B08, 0x571D7DD1, 0x53DC6066, 0x4D9B3063, 0x495A2DD4, 0x44190B0D, 0x40D816BA,
+    0xACA5C697, 0xA864DB20, 0xA527FDF9, 0xA1E6E04E, 0xBFA1B04B, 0xBB60ADFC, 0xB6238B25, 0xB2E29692,
+    0x8AAD2B2F, 0x8E6C3698, 0x832F1041, 0x87EE0DF6, 0x99A95DF3, 0x9D684044, 0x902B669D, 0x94EA7B2A,
+    0xE0B41DE7, 0xE4750050, 0xE9362689, 0xEDF73B3E, 0xF3B06B3B, 0xF771768C, 0xFA325055, 0xFEF34DE2,
+    0xC6BCF05F, 0xC27DEDE8, 0xCF3ECB31, 0xCBFFD686, 0xD5B88683, 0xD1799B34, 0xDC3ABDED, 0xD8FBA05A,
+    0x690CE0EE, 0x6DCDFD59, 0x608EDB80, 0x644FC637, 0x7A089632, 0x7EC98B85, 0x738AAD5C, 0x774BB0EB,
+    0x4F040D56, 0x4BC510E1, 0x46863638, 0x42472B8F, 0x5C007B8A, 0x58C1663D, 0x558240E4, 0x51435D53,
+    0x251D3B9E, 0x21DC2629, 0x2C9F00F0, 0x285E1D47, 0x36194D42, 0x32D850F5, 0x3F9B762C, 0x3B5A6B9B,
+    0x0315D626, 0x07D4CB91, 0x0A97ED48, 0x0E56F0FF, 0x1011A0FA, 0x14D0BD4D, 0x19939B94, 0x1D528623,
+    0xF12F560E, 0xF5EE4BB9, 0xF8AD6D60, 0xFC6C70D7, 0xE22B20D2, 0xE6EA3D65, 0xEBA91BBC, 0xEF68060B,
+    0xD727BBB6, 0xD3E6A601, 0xDEA580D8, 0xDA649D6F, 0xC423CD6A, 0xC0E2D0DD, 0xCDA1F604, 0xC960EBB3,
+    0xBD3E8D7E, 0xB9FF90C9, 0xB4BCB610, 0xB07DABA7, 0xAE3AFBA2, 0xAAFBE615, 0xA7B8C0CC, 0xA379DD7B,
+    0x9B3660C6, 0x9FF77D71, 0x92B45BA8, 0x9675461F, 0x8832161A, 0x8CF30BAD, 0x81B02D74, 0x857130C3,
+    0x5D8A9099, 0x594B8D2E, 0x5408ABF7, 0x50C9B640, 0x4E8EE645, 0x4A4FFBF2, 0x470CDD2B, 0x43CDC09C,
+    0x7B827D21, 0x7F436096, 0x7200464F, 0x76C15BF8, 0x68860BFD, 0x6C47164A, 0x61043093, 0x65C52D24,
+    0x119B4BE9, 0x155A565E, 0x18197087, 0x1CD86D30, 0x029F3D35, 0x065E2082, 0x0B1D065B, 0x0FDC1BEC,
+    0x3793A651, 0x3352BBE6, 0x3E119D3F, 0x3AD08088, 0x2497D08D, 0x2056CD3A, 0x2D15EBE3, 0x29D4F654,
+    0xC5A92679, 0xC1683BCE, 0xCC2B1D17, 0xC8EA00A0, 0xD6AD50A5, 0xD26C4D12, 0xDF2F6BCB, 0xDBEE767C,
+    0xE3A1CBC1, 0xE760D676, 0xEA23F0AF, 0xEEE2ED18, 0xF0A5BD1D, 0xF464A0AA, 0xF9278673, 0xFDE69BC4,
+    0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662, 0x933EB0BB, 0x97FFAD0C,
+    0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668, 0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4,
+};
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t OGGcrc32(const uint8_t* data, uint32_t len, uint32_t crc){
+    while(len--) crc = (crc << 8) ^ oggCrcTable[((crc >> 24) ^ *data++) & 0xFF];
+    return crc;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t OGGfindSyncWord(const uint8_t* buf, int32_t nBytes){
+    // returns the position of the next capture pattern "OggS" or -1
+    const uint8_t* p   = buf;
+    const uint8_t* end = buf + nBytes - 3;
+    while(p < end){
+        p = (const uint8_t*)memchr(p, 'O', end - p);
+        if(!p) break;
+        if(p[1] == 'g' && p[2] == 'g' && p[3] == 'S') return p - buf;
+        p++;
+    }
+    return -1;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t OGGparsePage(const uint8_t* buf, int32_t nBytes, oggPage_t* page, uint16_t* packetLen, oggCrc_t* crc){
+    // parses the page header at buf, packetLen (255 entries or NULL) receives the length of each packet
+    // returns the header size or an error, the CRC is checked if the whole page is in the buffer
+    // otherwise the page is opened in crc (if not NULL), buf must be inside the window given to OGGcrcFeed()
+    if(nBytes < 27) return ERR_OGG_TOO_SHORT;
+    if(memcmp(buf, "OggS", 4) != 0) return ERR_OGG_SYNC_NOT_FOUND;
+    if(buf[4] != 0 || buf[5] > 7) return ERR_OGG_VERSION;
+
+    uint8_t pageSegments = buf[26];
+    if(nBytes < 27 + pageSegments) return ERR_OGG_TOO_SHORT;
+
+    page->headerType      = buf[5];
+    page->granulePosition = 0;
+    for(int32_t i = 13; i >= 6; i--) page->granulePosition = (page->granulePosition << 8) | buf[i];
+    page->serialNr        = buf[14] | (buf[15] << 8) | (buf[16] << 16) | ((uint32_t)buf[17] << 24);
+    page->sequenceNr      = buf[18] | (buf[19] << 8) | (buf[20] << 16) | ((uint32_t)buf[21] << 24);
+    page->headerSize      = 27 + pageSegments;
+    page->bodySize        = 0;
+    page->packets         = 0;
+    page->crcChecked      = false;
+
+    // lacing values: 255 means the packet continues in the next segment, 0...254 ends the packet
+    uint32_t n = 0;
+    for(int32_t i = 0; i < pageSegments; i++){
+        n += buf[27 + i];
+        if(buf[27 + i] < 255){
+            if(packetLen) packetLen[page->packets] = n;
+            page->packets++;
+            page->bodySize += n;
+            n = 0;
+        }
+    }
+    page->lastPacketContinues = (pageSegments && buf[26 + pageSegments] == 255);
+    if(page->lastPacketContinues){
+        if(packetLen) packetLen[page->packets] = n;
+        page->packets++;
+        page->bodySize += n;
+    }
+
+    uint32_t pageSize = page->headerSize + page->bodySize;
+    uint32_t CRCchecksum = buf[22] | (buf[23] << 8) | (buf[24] << 16) | ((uint32_t)buf[25] << 24);
+    if(pageSize <= (uint32_t)nBytes || crc){
+        const uint8_t zero[4] = {0, 0, 0, 0}; // the checksum field itself is calculated as 0
+        uint32_t sum = OGGcrc32(buf, 22);
+        sum = OGGcrc32(zero, 4, sum);
+        sum = OGGcrc32(buf + 26, _min(pageSize, (uint32_t)nBytes) - 26, sum);
+        if(pageSize <= (uint32_t)nBytes){
+            if(sum != CRCchecksum) return ERR_OGG_CRC;
+            page->crcChecked = true;
+        }
+        else{ // the rest follows in the next decode calls
+            crc->crc        = sum;
+            crc->checksum   = CRCchecksum;
+            crc->sequenceNr = page->sequenceNr;
+            crc->remain     = pageSize - nBytes;
+            crc->ahead      = crc->window; // up to the end of the window
+            crc->failed     = false;
+        }
+    }
+    return page->headerSize;
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint8_t* OGGjoinContinuedPacket(uint8_t* buf, uint32_t partLen, int32_t nBytes, oggPage_t* nextPage, uint16_t* packetLen,
+                                oggCrc_t* crc){
+    // buf holds the first part of a packet (partLen bytes), the header of the next page follows directly
+    //  |part 1|oggPH|part 2|packet|packet|...      before
+    //  |unused|part 1 + part 2|packet|packet|...   after, returns the begin of part 1
+    // nextPage and packetLen describe the next page, its first packet is the joined one (partLen + packetLen[0])
+    // returns NULL if the next page is not completely in the buffer or the packet spans more than two pages
+    // crc: as in OGGparsePage(), the header of the next page is overwritten here
+    if((int32_t)partLen >= nBytes) return NULL;
+    if(OGGparsePage(buf + partLen, nBytes - partLen, nextPage, packetLen, crc) < 0) return NULL;
+    if(!OGGisContinuedPage(nextPage) || !nextPage->packets) return NULL;
+    if(nextPage->packets == 1 && nextPage->lastPacketContinues) return NULL;
+    if(partLen + nextPage->headerSize + packetLen[0] > (uint32_t)nBytes) return NULL;
+    memmove(buf + nextPage->headerSize, buf, partLen);
+    return buf + nextPage->headerSize;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void OGGcrcFeed(oggCrc_t* crc, const uint8_t* buf, int32_t nBytes){
+    // start of a decode call, buf is the first byte the decoder has not consumed yet
+    crc->window = nBytes;
+    if(!crc->remain || crc->ahead >= nBytes) return;
+    uint32_t n = _min(crc->remain, (uint32_t)(nBytes - crc->ahead));
+    crc->crc = OGGcrc32(buf + crc->ahead, n, crc->crc);
+    crc->ahead  += n;
+    crc->remain -= n;
+    if(!crc->remain && crc->crc != crc->checksum) crc->failed = true;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void OGGcrcConsumed(oggCrc_t* crc, int32_t bytesLeft, int32_t ret){
+    // end of a decode call, ret is its return value
+    int32_t consumed = crc->window - bytesLeft;
+    if(ret < 0 || (ret == 0 && !consumed)){ // the caller skips bytes and searches the next sync word
+        memset(crc, 0, sizeof(oggCrc_t));
+        return;
+    }
+    crc->ahead -= consumed;
+    if(crc->ahead < 0){ // consumed beyond the taken bytes (skipped metadata), the open page can't be checked anymore
+        crc->remain = 0;
+        crc->ahead = 0;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t OGGcrcBadPageRest(oggCrc_t* crc){
+    // call before the next packet is taken from the segment table
+    // returns -1 or, if the CRC of the current page was wrong, the bytes up to its end that are not consumed yet
+    if(!crc->failed) return -1;
+    crc->failed = false;
+    log_w("Ogg page %u: CRC error, rest of the page skipped", crc->sequenceNr);
+    return crc->ahead;
+}
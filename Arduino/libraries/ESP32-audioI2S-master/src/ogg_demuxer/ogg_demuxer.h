@@ -0,0 +1,47 @@
+// Ogg page/packet demuxer, shared by the FLAC, OPUS and VORBIS decoders
+// reference https://www.xiph.org/ogg/doc/rfc3533.txt
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+enum : int8_t  {ERR_OGG_NONE = 0,
+                ERR_OGG_SYNC_NOT_FOUND = -1,  // no "OggS" at the given position
+                ERR_OGG_VERSION = -2,         // stream_structure_version is not 0 or unknown header_type bits
+                ERR_OGG_CRC = -3,             // page checksum mismatch, the page is corrupted
+                ERR_OGG_TOO_SHORT = -4};      // the header (27 bytes + segment table) is not completely in the buffer
+
+typedef struct _oggPage{
+    uint8_t  headerType;          // 0x01 continued packet, 0x02 first page (bos), 0x04 last page (eos)
+    int64_t  granulePosition;     // -1: no packet finishes on this page
+    uint32_t serialNr;            // bitstream_serial_number
+    uint32_t sequenceNr;          // page_sequence_number
+    uint32_t bodySize;            // sum of all lacing values
+    uint16_t headerSize;          // 27 + page_segments
+    uint8_t  packets;             // number of packets (or packet parts) on this page
+    bool     lastPacketContinues; // the last packet is finished on the next page
+    bool     crcChecked;          // the whole page was in the buffer and its CRC is valid
+} oggPage_t;
+
+typedef struct _oggCrc{           // CRC of a page that is bigger than the input window of one decode call
+    uint32_t crc;                 // over the bytes taken so far, the checksum field counts as 0
+    uint32_t checksum;            // CRC_checksum from the page header
+    uint32_t sequenceNr;
+    uint32_t remain;              // bytes of the page not taken yet, 0: no page open
+    int32_t  ahead;               // bytes taken but not consumed by the decoder yet
+    int32_t  window;              // bytesLeft at the start of the decode call
+    bool     failed;              // the page is complete and its CRC is wrong
+} oggCrc_t;
+
+inline bool OGGisContinuedPage(const oggPage_t* page) {return page->headerType & 0x01;}
+inline bool OGGisFirstPage(const oggPage_t* page)     {return page->headerType & 0x02;}
+inline bool OGGisLastPage(const oggPage_t* page)      {return page->headerType & 0x04;}
+
+uint32_t OGGcrc32(const uint8_t* data, uint32_t len, uint32_t crc = 0);
+int32_t  OGGfindSyncWord(const uint8_t* buf, int32_t nBytes);
+int32_t  OGGparsePage(const uint8_t* buf, int32_t nBytes, oggPage_t* page, uint16_t* packetLen, oggCrc_t* crc = NULL);
+uint8_t* OGGjoinContinuedPacket(uint8_t* buf, uint32_t partLen, int32_t nBytes, oggPage_t* nextPage, uint16_t* packetLen,
+                                oggCrc_t* crc = NULL);
+void     OGGcrcFeed(oggCrc_t* crc, const uint8_t* buf, int32_t nBytes);
+void     OGGcrcConsumed(oggCrc_t* crc, int32_t bytesLeft, int32_t ret);
+int32_t  OGGcrcBadPageRest(oggCrc_t* crc);
@@ -34,20 +34,6 @@
 #include "celt.h"
 #include "opus_decoder.h"
 
-CELTDecoder  *s_celtDec;
-band_ctx_t    s_band_ctx;
-ec_ctx_t      s_ec;
-int32_t*      s_freqBuff;           // mem in celt_synthesis
-int32_t*      s_iyBuff;             // mem in alg_unquant
-int16_t*      s_normBuff;           // mem in quant_all_bands
-int16_t*      s_XBuff;              // mem in celt_decode_with_ec
-int32_t*      s_bits1Buff;          // mem in clt_compute_allocation
-int32_t*      s_bits2Buff;          // mem in clt_compute_allocation
-int32_t*      s_threshBuff;         // mem in clt_compute_allocation
-int32_t*      s_trim_offsetBuff;    // mem in clt_compute_allocation
-uint8_t*      s_collapse_masksBuff; // mem n celt_decode_with_ec
-int16_t*      s_tmpBuff;            // mem in deinterleave_hadamard and interleave_hadamard
-
 const uint32_t CELT_GET_AND_CLEAR_ERROR_REQUEST = 10007;
 const uint32_t CELT_SET_CHANNELS_REQUEST        = 10008;
 const uint32_t CELT_SET_START_BAND_REQUEST      = 10010;
@@ -664,6 +650,27 @@ void exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16_t s
     int16_t *Xptr;
     Xptr = X;
     ms = s * (-1);
+    if (stride == 1) {
+        /* Each step reads the value the previous one has just written, keep it in a register instead of going through
+           memory. Same arithmetic as the generic loop below. */
+        int16_t x1, x2;
+        x1 = X[0];
+        for (i = 0; i < len - 1; i++) {
+            x2 = X[i + 1];
+            X[i] = (int16_t)(PSHR(MAC16_16(MULT16_16(c, x1), ms, x2), 15));
+            x1 = (int16_t)(PSHR(MAC16_16(MULT16_16(c, x2), s, x1), 15));
+        }
+        X[len - 1] = x1;
+        if (len < 3) return;
+        x2 = X[len - 2];
+        for (i = len - 3; i >= 0; i--) {
+            x1 = X[i];
+            X[i + 1] = (int16_t)(PSHR(MAC16_16(MULT16_16(c, x2), s, x1), 15));
+            x2 = (int16_t)(PSHR(MAC16_16(MULT16_16(c, x1), ms, x2), 15));
+        }
+        X[0] = x2;
+        return;
+    }
     for (i = 0; i < len - stride; i++) {
         int16_t x1, x2;
         x1 = Xptr[0];
@@ -764,14 +771,14 @@ uint32_t extract_collapse_mask(int32_t *iy, int32_t N, int32_t B) {
 
 /** Decode pulse vector and combine the result with the pitch vector to produce
     the final normalised signal in the current band. */
-uint32_t alg_unquant(int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain) {
+uint32_t alg_unquant(CELTDecoder_t* cd, int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain) {
     int32_t Ryy;
     uint32_t collapse_mask;
     if(K <= 0) log_e("alg_unquant() needs at least one pulse");
     if(N <= 1) log_e("alg_unquant() needs at least two dimensions");
 
-    int32_t* iy = s_iyBuff; assert(N <= 176);
-    Ryy = decode_pulses(iy, N, K);
+    int32_t* iy = cd->iyBuff; assert(N <= 176);
+    Ryy = decode_pulses(cd, iy, N, K);
     normalise_residual(iy, X, N, Ryy, gain);
     exp_rotation(X, N, -1, B, K, spread);
     collapse_mask = extract_collapse_mask(iy, N, B);
@@ -808,7 +815,28 @@ void comb_filter_const(int32_t *y, int32_t *x, int32_t T, int32_t N, int16_t g10
     x3 = x[-T - 1];
     x2 = x[-T];
     x1 = x[-T + 1];
-    for (i = 0; i < N; i++) {
+    /* Unrolled by four, the taps are renamed instead of shifted after every sample. T >= 15, so all reads are from
+       positions that the (in-place) filter has already written, the same as in the plain loop. */
+    for (i = 0; i < N - 3; i += 4) {
+        int32_t t;
+        x0 = x[i - T + 2];
+        t = x[i] + MULT16_32_Q15(g10, x2) + MULT16_32_Q15(g11, ADD32(x1, x3)) + MULT16_32_Q15(g12, ADD32(x0, x4));
+        y[i] = SATURATE(t, (300000000));
+        x4 = x[i - T + 3];
+        t = x[i + 1] + MULT16_32_Q15(g10, x1) + MULT16_32_Q15(g11, ADD32(x0, x2)) + MULT16_32_Q15(g12, ADD32(x4, x3));
+        y[i + 1] = SATURATE(t, (300000000));
+        x3 = x[i - T + 4];
+        t = x[i + 2] + MULT16_32_Q15(g10, x0) + MULT16_32_Q15(g11, ADD32(x4, x1)) + MULT16_32_Q15(g12, ADD32(x3, x2));
+        y[i + 2] = SATURATE(t, (300000000));
+        x2 = x[i - T + 5];
+        t = x[i + 3] + MULT16_32_Q15(g10, x4) + MULT16_32_Q15(g11, ADD32(x3, x0)) + MULT16_32_Q15(g12, ADD32(x2, x1));
+        y[i + 3] = SATURATE(t, (300000000));
+        x1 = x2;
+        x2 = x3;
+        x3 = x4;
+        x4 = x0;
+    }
+    for (; i < N; i++) {
         x0 = x[i - T + 2];
         y[i]  = x[i];
         y[i] += MULT16_32_Q15(g10, x2);
@@ -1002,11 +1030,11 @@ void denormalise_bands(const int16_t * X, int32_t * freq,
 //----------------------------------------------------------------------------------------------------------------------
 
 /* This prevents energy collapse for transients with multiple short MDCTs */
-void anti_collapse(int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size,
+void anti_collapse(CELTDecoder_t* cd, int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size,
                    const int16_t *logE, const int16_t *prev1logE, const int16_t *prev2logE, const int32_t *pulses,
                    uint32_t seed){
     int32_t c, i, j, k;
-    const uint8_t  end = s_celtDec->end;  // 21
+    const uint8_t  end = cd->celtDec->end;  // 21
     for (i = 0; i < end; i++) {
         int32_t N0;
         int16_t thresh, sqrt_1;
@@ -1171,13 +1199,13 @@ static const int32_t ordery_table[] = {
 };
 //----------------------------------------------------------------------------------------------------------------------
 
-void deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
+void deinterleave_hadamard(CELTDecoder_t* cd, int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
     int32_t i, j;
     int32_t N;
     N = N0 * stride;
 
     assert(N <= 176);
-    int16_t* tmp = s_tmpBuff;
+    int16_t* tmp = cd->tmpBuff;
 
     assert(stride > 0);
     if (hadamard) {
@@ -1196,13 +1224,13 @@ void deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadam
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void interleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
+void interleave_hadamard(CELTDecoder_t* cd, int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
     int32_t i, j;
     int32_t N;
     N = N0 * stride;
 
     assert(N <= 176);
-    int16_t* tmp = s_tmpBuff;
+    int16_t* tmp = cd->tmpBuff;
 
     if (hadamard) {
         const int32_t *ordery = ordery_table + stride - 2;
@@ -1260,7 +1288,7 @@ int32_t compute_qn(int32_t N, int32_t b, int32_t offset, int32_t pulse_cap, int3
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B,
+void compute_theta(CELTDecoder_t* cd, struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B,
                           int32_t __B0, int32_t LM, int32_t stereo, int32_t *fill) {
     int32_t qn;
     int32_t itheta = 0;
@@ -1273,8 +1301,8 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
     int32_t inv = 0;
     int32_t i;
     int32_t intensity;
-    i = s_band_ctx.i;
-    intensity = s_band_ctx.intensity;
+    i = cd->band_ctx.i;
+    intensity = cd->band_ctx.intensity;
 
     /* Decide on the resolution to give to the split parameter theta */
     pulse_cap = logN400[i] + LM * (1 << BITRES);
@@ -1282,7 +1310,7 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
     qn = compute_qn(N, *b, offset, pulse_cap, stereo);
     if (stereo && i >= intensity)
         qn = 1;
-    tell = ec_tell_frac();
+    tell = ec_tell_frac(cd->ec);
     if (qn != 1) {
         /* Entropy coding of the angle. We use a uniform pdf for the time split, a step for stereo,
            and a triangular one for the rest. */
@@ -1294,18 +1322,18 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
             /* Use a probability of p0 up to itheta=8192 and then use 1 after */
 
             int32_t fs;
-            fs = ec_decode(ft);
+            fs = ec_decode(cd->ec, ft);
             if (fs < (x0 + 1) * p0)
                 x = fs / p0;
             else
                 x = x0 + 1 + (fs - (x0 + 1) * p0);
-            ec_dec_update(x <= x0 ? p0 * x : (x - 1 - x0) + (x0 + 1) * p0, x <= x0 ? p0 * (x + 1) : (x - x0) + (x0 + 1) * p0, ft);
+            ec_dec_update(cd->ec, x <= x0 ? p0 * x : (x - 1 - x0) + (x0 + 1) * p0, x <= x0 ? p0 * (x + 1) : (x - x0) + (x0 + 1) * p0, ft);
             itheta = x;
 
         }
         else if (__B0 > 1 || stereo) {
             /* Uniform pdf */
-            itheta = ec_dec_uint(qn + 1);
+            itheta = ec_dec_uint(cd->ec, qn + 1);
         }
         else {
             int32_t fs = 1, ft;
@@ -1313,7 +1341,7 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
             /* Triangular pdf */
             int32_t fl = 0;
             int32_t fm;
-            fm = ec_decode(ft);
+            fm = ec_decode(cd->ec, ft);
             if (fm < ((qn >> 1) * ((qn >> 1) + 1) >> 1))
             {
                 itheta = (isqrt32(8 * (uint32_t)fm + 1) - 1) >> 1;
@@ -1326,7 +1354,7 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
                 fs = qn + 1 - itheta;
                 fl = ft - ((qn + 1 - itheta) * (qn + 2 - itheta) >> 1);
             }
-            ec_dec_update(fl, fl + fs, ft);
+            ec_dec_update(cd->ec, fl, fl + fs, ft);
 
         }
         assert(itheta >= 0);
@@ -1337,17 +1365,17 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
                  Let's do that at higher complexity */
     }
     else if (stereo) {
-        if (*b > 2 << BITRES && s_band_ctx.remaining_bits > 2 << BITRES) {
-            inv = ec_dec_bit_logp(2);
+        if (*b > 2 << BITRES && cd->band_ctx.remaining_bits > 2 << BITRES) {
+            inv = ec_dec_bit_logp(cd->ec, 2);
         }
         else
             inv = 0;
         /* inv flag override to avoid problems with downmixing. */
-        if (s_band_ctx.disable_inv)
+        if (cd->band_ctx.disable_inv)
             inv = 0;
         itheta = 0;
     }
-    qalloc = ec_tell_frac() - tell;
+    qalloc = ec_tell_frac(cd->ec) - tell;
     *b -= qalloc;
 
     if (itheta == 0) {
@@ -1379,7 +1407,7 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-uint32_t quant_band_n1(int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out) {
+uint32_t quant_band_n1(CELTDecoder_t* cd, int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out) {
 
     int32_t c;
     int32_t stereo;
@@ -1388,11 +1416,11 @@ uint32_t quant_band_n1(int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out)
     stereo = Y != NULL;
     c = 0;
     do {
-        if (s_band_ctx.remaining_bits >= 1 << BITRES) {
-            s_band_ctx.remaining_bits -= 1 << BITRES;
+        if (cd->band_ctx.remaining_bits >= 1 << BITRES) {
+            cd->band_ctx.remaining_bits -= 1 << BITRES;
             b -= 1 << BITRES;
         }
-        if (s_band_ctx.resynth)
+        if (cd->band_ctx.resynth)
             x[0] = 16384;  // NORM_SCALING
         x = Y;
     } while (++c < 1 + stereo);
@@ -1405,7 +1433,7 @@ uint32_t quant_band_n1(int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out)
 /* This function is responsible for encoding and decoding a mono partition. It can split the band in two and transmit
    the energy difference with the two half-bands. It can be called recursively so bands can end up being
    split in 8 parts. */
-uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
+uint32_t quant_partition(CELTDecoder_t* cd, int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
                                 int16_t gain, int32_t fill){
     const uint8_t *cache;
     int32_t q;
@@ -1417,8 +1445,8 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
     int16_t *Y = NULL;
     int32_t i;
     int32_t spread;
-    i = s_band_ctx.i;
-    spread = s_band_ctx.spread;
+    i = cd->band_ctx.i;
+    spread = cd->band_ctx.spread;
 
     /* If we need 1.5 more bit than we can produce, split the band in two. */
     cache = cache_bits50 + cache_index50[(LM + 1) * m_CELTMode.nbEBands + i];
@@ -1437,7 +1465,7 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
             fill = (fill & 1) | (fill << 1);
         B = (B + 1) >> 1;
 
-        compute_theta(&sctx, X, Y, N, &b, B, _B0, LM, 0, &fill);
+        compute_theta(cd, &sctx, X, Y, N, &b, B, _B0, LM, 0, &fill);
         imid = sctx.imid;
         iside = sctx.iside;
         delta = sctx.delta;
@@ -1458,30 +1486,30 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
         }
         mbits = _max(0, _min(b, (b - delta) / 2));
         sbits = b - mbits;
-        s_band_ctx.remaining_bits -= qalloc;
+        cd->band_ctx.remaining_bits -= qalloc;
 
         if (lowband)
             next_lowband2 = lowband + N; /* >32-bit split case */
 
-        rebalance = s_band_ctx.remaining_bits;
+        rebalance = cd->band_ctx.remaining_bits;
         if (mbits >= sbits)  {
-            cm = quant_partition(X, N, mbits, B, lowband, LM,
+            cm = quant_partition(cd, X, N, mbits, B, lowband, LM,
                                  MULT16_16_P15(gain, mid), fill);
-            rebalance = mbits - (rebalance - s_band_ctx.remaining_bits);
+            rebalance = mbits - (rebalance - cd->band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 0)
                 sbits += rebalance - (3 << BITRES);
-            cm |= quant_partition(Y, N, sbits, B, next_lowband2, LM,
+            cm |= quant_partition(cd, Y, N, sbits, B, next_lowband2, LM,
                                   MULT16_16_P15(gain, side), fill >> B)
                   << (_B0 >> 1);
         }
         else {
-            cm = quant_partition(Y, N, sbits, B, next_lowband2, LM,
+            cm = quant_partition(cd, Y, N, sbits, B, next_lowband2, LM,
                                  MULT16_16_P15(gain, side), fill >> B)
                  << (_B0 >> 1);
-            rebalance = sbits - (rebalance - s_band_ctx.remaining_bits);
+            rebalance = sbits - (rebalance - cd->band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 16384)
                 mbits += rebalance - (3 << BITRES);
-            cm |= quant_partition(X, N, mbits, B, lowband, LM,
+            cm |= quant_partition(cd, X, N, mbits, B, lowband, LM,
                                   MULT16_16_P15(gain, mid), fill);
         }
     }
@@ -1489,27 +1517,27 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
         /* This is the basic no-split case */
         q = bits2pulses(i, LM, b);
         curr_bits = pulses2bits(i, LM, q);
-        s_band_ctx.remaining_bits -= curr_bits;
+        cd->band_ctx.remaining_bits -= curr_bits;
 
         /* Ensures we can never bust the budget */
-        while (s_band_ctx.remaining_bits < 0 && q > 0) {
-            s_band_ctx.remaining_bits += curr_bits;
+        while (cd->band_ctx.remaining_bits < 0 && q > 0) {
+            cd->band_ctx.remaining_bits += curr_bits;
             q--;
             curr_bits = pulses2bits(i, LM, q);
-            s_band_ctx.remaining_bits -= curr_bits;
+            cd->band_ctx.remaining_bits -= curr_bits;
         }
 
         if (q != 0) {
             int32_t K = get_pulses(q);
 
             /* Finally do the actual quantization */
-            cm = alg_unquant(X, N, K, spread, B, gain);
+            cm = alg_unquant(cd, X, N, K, spread, B, gain);
 
         }
         else {
             /* If there's no pulse, fill the band anyway */
             int32_t j;
-            if (s_band_ctx.resynth)
+            if (cd->band_ctx.resynth)
             {
                 uint32_t cm_mask;
                 /* B can be as large as 16, so this shift might overflow an int32_t on a
@@ -1523,8 +1551,8 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
                     if (lowband == NULL) {
                         /* Noise */
                         for (j = 0; j < N; j++) {
-                            s_band_ctx.seed = celt_lcg_rand(s_band_ctx.seed);
-                            X[j] = (int16_t)((int32_t)s_band_ctx.seed >> 20);
+                            cd->band_ctx.seed = celt_lcg_rand(cd->band_ctx.seed);
+                            X[j] = (int16_t)((int32_t)cd->band_ctx.seed >> 20);
                         }
                         cm = cm_mask;
                     }
@@ -1532,10 +1560,10 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
                         /* Folded spectrum */
                         for (j = 0; j < N; j++) {
                             int16_t tmp;
-                            s_band_ctx.seed = celt_lcg_rand(s_band_ctx.seed);
+                            cd->band_ctx.seed = celt_lcg_rand(cd->band_ctx.seed);
                             /* About 48 dB below the "normal" folding level */
                             tmp = QCONST16(1.0f / 256, 10);
-                            tmp = (s_band_ctx.seed) & 0x8000 ? tmp : -tmp;
+                            tmp = (cd->band_ctx.seed) & 0x8000 ? tmp : -tmp;
                             X[j] = lowband[j] + tmp;
                         }
                         cm = fill;
@@ -1551,7 +1579,7 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
 //----------------------------------------------------------------------------------------------------------------------
 
 /* This function is responsible for encoding and decoding a band for the mono case. */
-uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
+uint32_t quant_band(CELTDecoder_t* cd, int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
                            int16_t *lowband_out, int16_t gain, int16_t *lowband_scratch, int32_t fill) {
     int32_t N0 = N;
     int32_t N_B = N;
@@ -1563,7 +1591,7 @@ uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowban
     uint32_t cm = 0;
     int32_t k;
     int32_t tf_change;
-    tf_change = s_band_ctx.tf_change;
+    tf_change = cd->band_ctx.tf_change;
 
     longBlocks = _B0 == 1;
 
@@ -1572,7 +1600,7 @@ uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowban
 
     /* Special case for one sample */
     if (N == 1) {
-        return quant_band_n1(X, NULL, b, lowband_out);
+        return quant_band_n1(cd, X, NULL, b, lowband_out);
     }
 
     if (tf_change > 0)
@@ -1610,15 +1638,15 @@ uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowban
     /* Reorganize the samples in time order instead of frequency order */
     if (_B0 > 1) {
         if (lowband)
-            deinterleave_hadamard(lowband, N_B >> recombine, _B0 << recombine, longBlocks);
+            deinterleave_hadamard(cd, lowband, N_B >> recombine, _B0 << recombine, longBlocks);
     }
 
-    cm = quant_partition(X, N, b, B, lowband, LM, gain, fill);
+    cm = quant_partition(cd, X, N, b, B, lowband, LM, gain, fill);
 
-    if (s_band_ctx.resynth) {
+    if (cd->band_ctx.resynth) {
         /* Undo the sample reorganization going from time order to frequency order */
         if (_B0 > 1)
-            interleave_hadamard(X, N_B >> recombine, _B0 << recombine, longBlocks);
+            interleave_hadamard(cd, X, N_B >> recombine, _B0 << recombine, longBlocks);
 
         /* Undo time-freq changes that we did earlier */
         N_B = N__B0;
@@ -1654,7 +1682,7 @@ uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowban
 //----------------------------------------------------------------------------------------------------------------------
 
 /* This function is responsible for encoding and decoding a band for the stereo case. */
-uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband,
+uint32_t quant_band_stereo(CELTDecoder_t* cd, int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband,
                                   int32_t LM, int16_t *lowband_out, int16_t *lowband_scratch, int32_t fill) {
     int32_t imid = 0, iside = 0;
     int32_t inv = 0;
@@ -1668,12 +1696,12 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
 
     /* Special case for one sample */
     if (N == 1){
-        return quant_band_n1(X, Y, b, lowband_out);
+        return quant_band_n1(cd, X, Y, b, lowband_out);
     }
 
     orig_fill = fill;
 
-    compute_theta(&sctx, X, Y, N, &b, B, B, LM, 1, &fill);
+    compute_theta(cd, &sctx, X, Y, N, &b, B, B, LM, 1, &fill);
     inv = sctx.inv;
     imid = sctx.imid;
     iside = sctx.iside;
@@ -1698,23 +1726,23 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
             sbits = 1 << BITRES;
         mbits -= sbits;
         c = itheta > 8192;
-        s_band_ctx.remaining_bits -= qalloc + sbits;
+        cd->band_ctx.remaining_bits -= qalloc + sbits;
 
         x2 = c ? Y : X;
         y2 = c ? X : Y;
         if (sbits) {
-            sign = ec_dec_bits(1);
+            sign = ec_dec_bits(cd->ec, 1);
         }
         sign = 1 - 2 * sign;
         /* We use orig_fill here because we want to fold the side, but if
            itheta==16384, we'll have cleared the low bits of fill. */
-        cm = quant_band(x2, N, mbits, B, lowband, LM, lowband_out, 32767,
+        cm = quant_band(cd, x2, N, mbits, B, lowband, LM, lowband_out, 32767,
                         lowband_scratch, orig_fill);
         /* We don't split N=2 bands, so cm is either 1 or 0 (for a fold-collapse),
            and there's no need to worry about mixing with the other channel. */
         y2[0] = -sign * x2[1];
         y2[1] = sign * x2[0];
-        if (s_band_ctx.resynth) {
+        if (cd->band_ctx.resynth) {
             int16_t tmp;
             X[0] = MULT16_16_Q15(mid, X[0]);
             X[1] = MULT16_16_Q15(mid, X[1]);
@@ -1734,36 +1762,36 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
 
         mbits = _max(0, _min(b, (b - delta) / 2));
         sbits = b - mbits;
-        s_band_ctx.remaining_bits -= qalloc;
+        cd->band_ctx.remaining_bits -= qalloc;
 
-        rebalance = s_band_ctx.remaining_bits;
+        rebalance = cd->band_ctx.remaining_bits;
         if (mbits >= sbits) {
             /* In stereo mode, we do not apply a scaling to the mid because we need the normalized
                mid for folding later. */
-            cm = quant_band(X, N, mbits, B, lowband, LM, lowband_out, 32767,
+            cm = quant_band(cd, X, N, mbits, B, lowband, LM, lowband_out, 32767,
                             lowband_scratch, fill);
-            rebalance = mbits - (rebalance - s_band_ctx.remaining_bits);
+            rebalance = mbits - (rebalance - cd->band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 0)
                 sbits += rebalance - (3 << BITRES);
 
             /* For a stereo split, the high bits of fill are always zero, so no
                folding will be done to the side. */
-            cm |= quant_band(Y, N, sbits, B, NULL, LM, NULL, side, NULL, fill >> B);
+            cm |= quant_band(cd, Y, N, sbits, B, NULL, LM, NULL, side, NULL, fill >> B);
         }
         else {
             /* For a stereo split, the high bits of fill are always zero, so no
                folding will be done to the side. */
-            cm = quant_band(Y, N, sbits, B, NULL, LM, NULL, side, NULL, fill >> B);
-            rebalance = sbits - (rebalance - s_band_ctx.remaining_bits);
+            cm = quant_band(cd, Y, N, sbits, B, NULL, LM, NULL, side, NULL, fill >> B);
+            rebalance = sbits - (rebalance - cd->band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 16384)
                 mbits += rebalance - (3 << BITRES);
             /* In stereo mode, we do not apply a scaling to the mid because we need the normalized
                mid for folding later. */
-            cm |= quant_band(X, N, mbits, B, lowband, LM, lowband_out, 32767,
+            cm |= quant_band(cd, X, N, mbits, B, lowband, LM, lowband_out, 32767,
                              lowband_scratch, fill);
         }
     }
-    if (s_band_ctx.resynth) {
+    if (cd->band_ctx.resynth) {
         if (N != 2)
             stereo_merge(X, Y, mid, N);
         if (inv)
@@ -1790,7 +1818,7 @@ void special_hybrid_folding(int16_t *norm, int16_t *norm2, int32_t M, int32_t du
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t *pulses,
+void quant_all_bands(CELTDecoder_t* cd, int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t *pulses,
                      int32_t shortBlocks, int32_t spread,
                      int32_t dual_stereo, int32_t intensity, int32_t *tf_res, int32_t total_bits, int32_t balance,
                      int32_t LM, int32_t codedBands){
@@ -1807,8 +1835,8 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
     int32_t C = Y_ != NULL ? 2 : 1;
     int32_t norm_offset;
     int32_t resynth = 1;
-    const uint8_t end = s_celtDec->end;  // 21
-    uint8_t disable_inv = s_celtDec->disable_inv; // 1- mono, 0- stereo
+    const uint8_t end = cd->celtDec->end;  // 21
+    uint8_t disable_inv = cd->celtDec->disable_inv; // 1- mono, 0- stereo
 
     M = 1 << LM;
     B = shortBlocks ? M : 1;
@@ -1817,7 +1845,7 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
        output in that band. */
 
 //    assert(C * (M * eBands[m_CELTMode.nbEBands - 1] - norm_offset) >= 1248);
-    norm = s_normBuff;
+    norm = cd->normBuff;
 
     norm2 = norm + M * eBands[m_CELTMode.nbEBands - 1] - norm_offset;
 
@@ -1828,15 +1856,15 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
     lowband_scratch = X_ + M * eBands[m_CELTMode.nbEBands - 1];
 
     lowband_offset = 0;
-    s_band_ctx.encode = 0;
-    s_band_ctx.intensity = intensity;
-    s_band_ctx.seed = 0;
-    s_band_ctx.spread = spread;
-    s_band_ctx.disable_inv = disable_inv; // 0 - stereo, 1 - mono
-    s_band_ctx.resynth = resynth;
-    s_band_ctx.theta_round = 0;
+    cd->band_ctx.encode = 0;
+    cd->band_ctx.intensity = intensity;
+    cd->band_ctx.seed = 0;
+    cd->band_ctx.spread = spread;
+    cd->band_ctx.disable_inv = disable_inv; // 0 - stereo, 1 - mono
+    cd->band_ctx.resynth = resynth;
+    cd->band_ctx.theta_round = 0;
     /* Avoid injecting noise in the first band on transients. */
-    s_band_ctx.avoid_split_noise = B > 1;
+    cd->band_ctx.avoid_split_noise = B > 1;
     for (i = 0; i < end; i++){
         int32_t tell;
         int32_t b;
@@ -1849,7 +1877,7 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
         uint32_t y_cm;
         int32_t last;
 
-        s_band_ctx.i = i;
+        cd->band_ctx.i = i;
         last = (i == end - 1);
 
         X = X_ + M * eBands[i];
@@ -1859,13 +1887,13 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
             Y = NULL;
         N = M * eBands[i + 1] - M * eBands[i];
         assert(N > 0);
-        tell = ec_tell_frac();
+        tell = ec_tell_frac(cd->ec);
 
         /* Compute how many bits we want to allocate to this band */
         if (i != 0)
             balance -= tell;
         remaining_bits = total_bits - tell - 1;
-        s_band_ctx.remaining_bits = remaining_bits;
+        cd->band_ctx.remaining_bits = remaining_bits;
         if (i <= codedBands - 1){
             curr_balance = celt_sudiv(balance, _min(3, codedBands - i));
             b = _max(0, _min(16383, _min(remaining_bits + 1, pulses[i] + curr_balance)));
@@ -1880,7 +1908,7 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
             special_hybrid_folding(norm, norm2, M, dual_stereo);
 
         tf_change = tf_res[i];
-        s_band_ctx.tf_change = tf_change;
+        cd->band_ctx.tf_change = tf_change;
         if (i >= m_CELTMode.effEBands) {
             X = norm;
             if (Y_ != NULL)
@@ -1928,23 +1956,23 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
                     norm[j] = HALF32(norm[j] + norm2[j]);
         }
         if (dual_stereo) {
-            x_cm = quant_band(X, N, b / 2, B,
+            x_cm = quant_band(cd, X, N, b / 2, B,
                               effective_lowband != -1 ? norm + effective_lowband : NULL, LM,
                               last ? NULL : norm + M * eBands[i] - norm_offset, 32767, lowband_scratch, x_cm);
-            y_cm = quant_band(Y, N, b / 2, B,
+            y_cm = quant_band(cd, Y, N, b / 2, B,
                               effective_lowband != -1 ? norm2 + effective_lowband : NULL, LM,
                               last ? NULL : norm2 + M * eBands[i] - norm_offset, 32767, lowband_scratch, y_cm);
         }
         else {
             if (Y != NULL) {
-                s_band_ctx.theta_round = 0;
-                x_cm = quant_band_stereo(X, Y, N, b, B,
+                cd->band_ctx.theta_round = 0;
+                x_cm = quant_band_stereo(cd, X, Y, N, b, B,
                                     effective_lowband != -1 ? norm + effective_lowband : NULL, LM,
                                     last ? NULL : norm + M * eBands[i] - norm_offset, lowband_scratch, x_cm | y_cm);
 
             }
             else {
-                x_cm = quant_band(X, N, b, B,
+                x_cm = quant_band(cd, X, N, b, B,
                                   effective_lowband != -1 ? norm + effective_lowband : NULL, LM,
                                   last ? NULL : norm + M * eBands[i] - norm_offset, 32767, lowband_scratch, x_cm | y_cm);
             }
@@ -1958,7 +1986,7 @@ void quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t
         update_lowband = b > (N << BITRES);
         /* We only need to avoid noise on a split for the first band. After that, we
            have folding. */
-        s_band_ctx.avoid_split_noise = 0;
+        cd->band_ctx.avoid_split_noise = 0;
     }
 
 }
@@ -1972,41 +2000,41 @@ int32_t celt_decoder_get_size(int32_t channels){
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t celt_decoder_init(int32_t channels){
+int32_t celt_decoder_init(CELTDecoder_t* cd, int32_t channels){
     // allocate buffers first
     if (channels < 0 || channels > 2){
         return ERR_OPUS_CHANNELS_OUT_OF_RANGE;
     }
-    if (s_celtDec == NULL){
+    if (cd->celtDec == NULL){
         return ERR_OPUS_CELT_ALLOC_FAIL;
     }
 
     int32_t n = celt_decoder_get_size(channels);
-    memset(s_celtDec, 0, n * sizeof(char));
-
-    s_celtDec->channels = channels;
-    if(channels == 1) s_celtDec->disable_inv = 1; else s_celtDec->disable_inv = 0; // 1 mono ,  0 stereo
-    s_celtDec->end = s_celtDec->mode->effEBands; // 21
-    s_celtDec->error = 0;
-    s_celtDec->mode = &m_CELTMode;
-    s_celtDec->overlap = m_CELTMode.overlap;
-
-    s_celtDec->postfilter_gain = 0;
-    s_celtDec->postfilter_gain_old = 0;
-
-    s_celtDec->postfilter_period = 0;
-    s_celtDec->postfilter_tapset = 0;
-    s_celtDec->postfilter_tapset_old = 0;
-    s_celtDec->preemph_memD[0] = 0;
-    s_celtDec->preemph_memD[1] = 0;
-    s_celtDec->rng = 0;
-    s_celtDec->signalling = 1;
-    s_celtDec->start = 0;
-    s_celtDec->stream_channels = channels;
-    s_celtDec->_decode_mem[0] = 0;
-    s_celtDec->end = s_celtDec->mode->effEBands; // 21
-
-    int32_t ret = celt_decoder_ctl(OPUS_RESET_STATE);
+    memset(cd->celtDec, 0, n * sizeof(char));
+
+    cd->celtDec->channels = channels;
+    if(channels == 1) cd->celtDec->disable_inv = 1; else cd->celtDec->disable_inv = 0; // 1 mono ,  0 stereo
+    cd->celtDec->end = cd->celtDec->mode->effEBands; // 21
+    cd->celtDec->error = 0;
+    cd->celtDec->mode = &m_CELTMode;
+    cd->celtDec->overlap = m_CELTMode.overlap;
+
+    cd->celtDec->postfilter_gain = 0;
+    cd->celtDec->postfilter_gain_old = 0;
+
+    cd->celtDec->postfilter_period = 0;
+    cd->celtDec->postfilter_tapset = 0;
+    cd->celtDec->postfilter_tapset_old = 0;
+    cd->celtDec->preemph_memD[0] = 0;
+    cd->celtDec->preemph_memD[1] = 0;
+    cd->celtDec->rng = 0;
+    cd->celtDec->signalling = 1;
+    cd->celtDec->start = 0;
+    cd->celtDec->stream_channels = channels;
+    cd->celtDec->_decode_mem[0] = 0;
+    cd->celtDec->end = cd->celtDec->mode->effEBands; // 21
+
+    int32_t ret = celt_decoder_ctl(cd, OPUS_RESET_STATE);
     if(ret < 0) return ret;
     return ERR_OPUS_NONE;
 }
@@ -2019,45 +2047,56 @@ int32_t celt_decoder_init(int32_t channels){
     #define __heap_caps_malloc(size) heap_caps_malloc(size, MALLOC_CAP_DEFAULT)
 #endif
 
-bool CELTDecoder_AllocateBuffers(void) {
+CELTDecoder_t* CELTDecoder_AllocateBuffers(ec_ctx_t* ec) {
+    CELTDecoder_t* cd = (CELTDecoder_t*)__heap_caps_malloc(sizeof(CELTDecoder_t));
+    if(!cd) {
+        log_e("not enough memory to allocate celtdecoder buffers");
+        return NULL;
+    }
+    memset(cd, 0, sizeof(CELTDecoder_t));
+    cd->ec = ec; // in hybrid frames CELT continues reading where SILK stopped
+
     size_t omd = celt_decoder_get_size(2);
-    if(!s_celtDec)              {s_celtDec = (CELTDecoder*)       __heap_caps_malloc(omd);}
-    if(!s_freqBuff)             {s_freqBuff = (int32_t*)          __heap_caps_malloc(960  * sizeof(int32_t));}
-    if(!s_iyBuff)               {s_iyBuff = (int32_t*)            __heap_caps_malloc(176  * sizeof(int32_t));}
-    if(!s_normBuff)             {s_normBuff = (int16_t*)          __heap_caps_malloc(1248 * sizeof(int16_t));}
-    if(!s_XBuff)                {s_XBuff = (int16_t*)             __heap_caps_malloc(1920 * sizeof(int16_t));}
-    if(!s_bits1Buff)            {s_bits1Buff = (int32_t*)         __heap_caps_malloc(21   * sizeof(int32_t));}
-    if(!s_bits2Buff)            {s_bits2Buff = (int32_t*)         __heap_caps_malloc(21   * sizeof(int32_t));}
-    if(!s_threshBuff)           {s_threshBuff = (int32_t*)        __heap_caps_malloc(21   * sizeof(int32_t));}
-    if(!s_trim_offsetBuff)      {s_trim_offsetBuff = (int32_t*)   __heap_caps_malloc(21   * sizeof(int32_t));}
-    if(!s_collapse_masksBuff)   {s_collapse_masksBuff = (uint8_t*)__heap_caps_malloc(42   * sizeof(uint8_t));}
-    if(!s_tmpBuff)              {s_tmpBuff = (int16_t*)           __heap_caps_malloc(176  * sizeof(int16_t));}
-
-    if(!s_celtDec) {
-        CELTDecoder_FreeBuffers();
+    cd->celtDec = (CELTDecoder*)       __heap_caps_malloc(omd);
+    cd->freqBuff = (int32_t*)          __heap_caps_malloc(960  * sizeof(int32_t));
+    cd->iyBuff = (int32_t*)            __heap_caps_malloc(176  * sizeof(int32_t));
+    cd->normBuff = (int16_t*)          __heap_caps_malloc(1248 * sizeof(int16_t));
+    cd->XBuff = (int16_t*)             __heap_caps_malloc(1920 * sizeof(int16_t));
+    cd->bits1Buff = (int32_t*)         __heap_caps_malloc(21   * sizeof(int32_t));
+    cd->bits2Buff = (int32_t*)         __heap_caps_malloc(21   * sizeof(int32_t));
+    cd->threshBuff = (int32_t*)        __heap_caps_malloc(21   * sizeof(int32_t));
+    cd->trim_offsetBuff = (int32_t*)   __heap_caps_malloc(21   * sizeof(int32_t));
+    cd->collapse_masksBuff = (uint8_t*)__heap_caps_malloc(42   * sizeof(uint8_t));
+    cd->tmpBuff = (int16_t*)           __heap_caps_malloc(176  * sizeof(int16_t));
+
+    if(!cd->celtDec || !cd->freqBuff || !cd->iyBuff || !cd->normBuff || !cd->XBuff || !cd->bits1Buff || !cd->bits2Buff ||
+       !cd->threshBuff || !cd->trim_offsetBuff || !cd->collapse_masksBuff || !cd->tmpBuff) {
+        CELTDecoder_FreeBuffers(cd);
         log_e("not enough memory to allocate celtdecoder buffers");
-        return false;
+        return NULL;
     }
-    return true;
+    return cd;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void CELTDecoder_FreeBuffers(){
-    if(s_celtDec)            { free(s_celtDec);            s_celtDec =            NULL; }
-    if(s_freqBuff)           { free(s_freqBuff),           s_freqBuff =           NULL; }
-    if(s_iyBuff)             { free(s_iyBuff),             s_iyBuff =             NULL; }
-    if(s_normBuff)           { free(s_normBuff),           s_normBuff =           NULL; }
-    if(s_XBuff)              { free(s_XBuff),              s_XBuff =              NULL; }
-    if(s_bits1Buff)          { free(s_bits1Buff),          s_bits1Buff =          NULL; }
-    if(s_bits2Buff)          { free(s_bits2Buff),          s_bits2Buff =          NULL; }
-    if(s_threshBuff)         { free(s_threshBuff),         s_threshBuff =         NULL; }
-    if(s_trim_offsetBuff)    { free(s_trim_offsetBuff),    s_trim_offsetBuff =    NULL; }
-    if(s_collapse_masksBuff) { free(s_collapse_masksBuff), s_collapse_masksBuff = NULL; }
-    if(s_tmpBuff)            { free(s_tmpBuff),            s_tmpBuff =            NULL; }
+void CELTDecoder_FreeBuffers(CELTDecoder_t* cd){
+    if(!cd) return;
+    if(cd->celtDec)            { free(cd->celtDec);            cd->celtDec =            NULL; }
+    if(cd->freqBuff)           { free(cd->freqBuff),           cd->freqBuff =           NULL; }
+    if(cd->iyBuff)             { free(cd->iyBuff),             cd->iyBuff =             NULL; }
+    if(cd->normBuff)           { free(cd->normBuff),           cd->normBuff =           NULL; }
+    if(cd->XBuff)              { free(cd->XBuff),              cd->XBuff =              NULL; }
+    if(cd->bits1Buff)          { free(cd->bits1Buff),          cd->bits1Buff =          NULL; }
+    if(cd->bits2Buff)          { free(cd->bits2Buff),          cd->bits2Buff =          NULL; }
+    if(cd->threshBuff)         { free(cd->threshBuff),         cd->threshBuff =         NULL; }
+    if(cd->trim_offsetBuff)    { free(cd->trim_offsetBuff),    cd->trim_offsetBuff =    NULL; }
+    if(cd->collapse_masksBuff) { free(cd->collapse_masksBuff), cd->collapse_masksBuff = NULL; }
+    if(cd->tmpBuff)            { free(cd->tmpBuff),            cd->tmpBuff =            NULL; }
+    free(cd);
 }
 //----------------------------------------------------------------------------------------------------------------------
-void CELTDecoder_ClearBuffer(void){
+void CELTDecoder_ClearBuffer(CELTDecoder_t* cd){
     size_t omd = celt_decoder_get_size(2);
-    memset(s_celtDec, 0, omd * sizeof(char));
+    memset(cd->celtDec, 0, omd * sizeof(char));
 }
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -2086,14 +2125,14 @@ void deemphasis_stereo_simple(int32_t *in[], int16_t *pcm, int32_t N, const int1
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void deemphasis(int32_t *in[], int16_t *pcm, int32_t N) {
+void deemphasis(CELTDecoder_t* cd, int32_t *in[], int16_t *pcm, int32_t N) {
     int32_t        c;
     int32_t        Nd;
     int32_t        apply_downsampling = 0;
     int16_t        coef0;
-    const int32_t  CC = s_celtDec->channels;
+    const int32_t  CC = cd->celtDec->channels;
     const int16_t *coef = m_CELTMode.preemph;
-    int32_t       *mem = s_celtDec->preemph_memD;
+    int32_t       *mem = cd->celtDec->preemph_memD;
 
     /* Short version for common case. */
     if(CC == 2) {
@@ -2130,7 +2169,7 @@ void deemphasis(int32_t *in[], int16_t *pcm, int32_t N) {
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t C,
+void celt_synthesis(CELTDecoder_t* cd, int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t C,
                     int32_t isTransient, int32_t LM, int32_t silence) {
     int32_t c, i;
     int32_t M;
@@ -2140,13 +2179,13 @@ void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t C
     int32_t shift;
     int32_t nbEBands;
     int32_t overlap;
-    const int32_t  CC = s_celtDec->channels;
-    const uint8_t effEnd = s_celtDec->end;  // 21
+    const int32_t  CC = cd->celtDec->channels;
+    const uint8_t effEnd = cd->celtDec->end;  // 21
 
     overlap = m_CELTMode.overlap;
     nbEBands = m_CELTMode.nbEBands;
     N = m_CELTMode.shortMdctSize << LM;
-    int32_t* freq = s_freqBuff; assert(N <= 960); /**< Interleaved signal MDCTs */
+    int32_t* freq = cd->freqBuff; assert(N <= 960); /**< Interleaved signal MDCTs */
     M = 1 << LM;
 
     if(isTransient) {
@@ -2196,25 +2235,25 @@ void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t C
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void tf_decode(int32_t isTransient, int32_t *tf_res, int32_t LM){
+void tf_decode(CELTDecoder_t* cd, int32_t isTransient, int32_t *tf_res, int32_t LM){
     int32_t i, curr, tf_select;
     int32_t tf_select_rsv;
     int32_t tf_changed;
     int32_t logp;
     uint32_t budget;
     uint32_t tell;
-    const uint8_t end = s_celtDec->end;
+    const uint8_t end = cd->celtDec->end;
 
-    budget = s_ec.storage * 8;
-    tell = ec_tell();
+    budget = cd->ec->storage * 8;
+    tell = ec_tell(cd->ec);
     logp = isTransient ? 2 : 4;
     tf_select_rsv = LM > 0 && tell + logp + 1 <= budget;
     budget -= tf_select_rsv;
     tf_changed = curr = 0;
     for (i = 0; i < end; i++) {
         if (tell + logp <= budget) {
-            curr ^= ec_dec_bit_logp(logp);
-            tell = ec_tell();
+            curr ^= ec_dec_bit_logp(cd->ec, logp);
+            tell = ec_tell(cd->ec);
             tf_changed |= curr;
         }
         tf_res[i] = curr;
@@ -2224,7 +2263,7 @@ void tf_decode(int32_t isTransient, int32_t *tf_res, int32_t LM){
     if (tf_select_rsv &&
         tf_select_table[LM][4 * isTransient + 0 + tf_changed] !=
             tf_select_table[LM][4 * isTransient + 2 + tf_changed]) {
-        tf_select = ec_dec_bit_logp(1);
+        tf_select = ec_dec_bit_logp(cd->ec, 1);
     }
     for (i = 0; i < end; i++) {
         tf_res[i] = tf_select_table[LM][4 * isTransient + 2 * tf_select + tf_res[i]];
@@ -2232,7 +2271,7 @@ void tf_decode(int32_t isTransient, int32_t *tf_res, int32_t LM){
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
+int32_t celt_decode_with_ec(CELTDecoder_t* cd, int16_t *outbuf, int32_t frame_size) {
 
     int32_t  c, i, N;
     int32_t  spread_decision;
@@ -2245,9 +2284,9 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
     int32_t        shortBlocks;
     int32_t        isTransient;
     int32_t        intra_ener;
-    const uint8_t  CC = s_celtDec->channels;
+    const uint8_t  CC = cd->celtDec->channels;
     int32_t        LM, M;
-    const uint8_t  end = s_celtDec->end;  // 21
+    const uint8_t  end = cd->celtDec->end;  // 21
     int32_t        codedBands;
     int32_t        alloc_trim;
     int32_t        postfilter_pitch;
@@ -2262,12 +2301,12 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
     int32_t        anti_collapse_rsv;
     int32_t        anti_collapse_on = 0;
     int32_t        silence;
-    const uint8_t  C = s_celtDec->stream_channels; // =channels=2
+    const uint8_t  C = cd->celtDec->stream_channels; // =channels=2
     const uint8_t  nbEBands = m_CELTMode.nbEBands; // =21
     const uint8_t  overlap = m_CELTMode.overlap; // =120
     const int16_t *eBands = eband5ms;
 
-    lpc = (int16_t *)(s_celtDec->_decode_mem + (DECODE_BUFFER_SIZE + overlap) * CC);
+    lpc = (int16_t *)(cd->celtDec->_decode_mem + (DECODE_BUFFER_SIZE + overlap) * CC);
     oldBandE = lpc + CC * 24;
     oldLogE = oldBandE + 2 * nbEBands;
     oldLogE2 = oldLogE + 2 * nbEBands;
@@ -2281,54 +2320,54 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
 
     M = 1 << LM; // LM=3 -> M = 8
 
-    if(s_ec.storage > 1275 || outbuf == NULL) {log_e("OPUS_BAD_ARG"); return ERR_OPUS_CELT_BAD_ARG;}
+    if(cd->ec->storage > 1275 || outbuf == NULL) {log_e("OPUS_BAD_ARG"); return ERR_OPUS_CELT_BAD_ARG;}
 
     N = M * m_CELTMode.shortMdctSize; // const m_CELTMode.shortMdctSize == 120, M == 8 -> N = 960
 
     c = 0;
     do {
-        decode_mem[c] = s_celtDec->_decode_mem + c * (DECODE_BUFFER_SIZE + overlap);
+        decode_mem[c] = cd->celtDec->_decode_mem + c * (DECODE_BUFFER_SIZE + overlap);
         out_syn[c] = decode_mem[c] + DECODE_BUFFER_SIZE - N;
     } while(++c < CC);
 
-    if(s_ec.storage <= 1) {log_e("OPUS_BAD_ARG"); return ERR_OPUS_CELT_BAD_ARG;}
+    if(cd->ec->storage <= 1) {log_e("OPUS_BAD_ARG"); return ERR_OPUS_CELT_BAD_ARG;}
 
     if(C == 1) {
         for(i = 0; i < nbEBands; i++) oldBandE[i] = _max(oldBandE[i], oldBandE[nbEBands + i]);
     }
 
-    total_bits = s_ec.storage * 8;
-    tell = ec_tell();
+    total_bits = cd->ec->storage * 8;
+    tell = ec_tell(cd->ec);
 
     if(tell >= total_bits) silence = 1;
     else if(tell == 1)
-        silence = ec_dec_bit_logp(15);
+        silence = ec_dec_bit_logp(cd->ec, 15);
     else
         silence = 0;
     if(silence) {
         /* Pretend we've read all the remaining bits */
-        tell = s_ec.storage * 8;
-        s_ec.nbits_total += tell - ec_tell();
+        tell = cd->ec->storage * 8;
+        cd->ec->nbits_total += tell - ec_tell(cd->ec);
     }
 
     postfilter_gain = 0;
     postfilter_pitch = 0;
     postfilter_tapset = 0;
     if(tell + 16 <= total_bits) {
-        if(ec_dec_bit_logp(1)) {
+        if(ec_dec_bit_logp(cd->ec, 1)) {
             int32_t qg, octave;
-            octave = ec_dec_uint(6);
-            postfilter_pitch = (16 << octave) + ec_dec_bits(4 + octave) - 1;
-            qg = ec_dec_bits(3);
-            if(ec_tell() + 2 <= total_bits) postfilter_tapset = ec_dec_icdf(tapset_icdf, 2);
+            octave = ec_dec_uint(cd->ec, 6);
+            postfilter_pitch = (16 << octave) + ec_dec_bits(cd->ec, 4 + octave) - 1;
+            qg = ec_dec_bits(cd->ec, 3);
+            if(ec_tell(cd->ec) + 2 <= total_bits) postfilter_tapset = ec_dec_icdf(cd->ec, tapset_icdf, 2);
             postfilter_gain = QCONST16(.09375f, 15) * (qg + 1);
         }
-        tell = ec_tell();
+        tell = ec_tell(cd->ec);
     }
 
     if(LM > 0 && tell + 3 <= total_bits) {
-        isTransient = ec_dec_bit_logp(3);
-        tell = ec_tell();
+        isTransient = ec_dec_bit_logp(cd->ec, 3);
+        tell = ec_tell(cd->ec);
     } else
         isTransient = 0;
 
@@ -2337,16 +2376,16 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
         shortBlocks = 0;
 
     /* Decode the global flags (first symbols in the stream) */
-    intra_ener = tell + 3 <= total_bits ? ec_dec_bit_logp(3) : 0;
+    intra_ener = tell + 3 <= total_bits ? ec_dec_bit_logp(cd->ec, 3) : 0;
     /* Get band energies */
-    unquant_coarse_energy(oldBandE, intra_ener, C, LM);
+    unquant_coarse_energy(cd, oldBandE, intra_ener, C, LM);
 
     int32_t tf_res[nbEBands];
-    tf_decode(isTransient, tf_res, LM);
+    tf_decode(cd, isTransient, tf_res, LM);
 
-    tell = ec_tell();
+    tell = ec_tell(cd->ec);
     spread_decision = 2;  // SPREAD_NORMAL
-    if(tell + 4 <= total_bits) spread_decision = ec_dec_icdf(spread_icdf, 5);
+    if(tell + 4 <= total_bits) spread_decision = ec_dec_icdf(cd->ec, spread_icdf, 5);
 
     int32_t cap[nbEBands];
     init_caps(cap, LM, C);
@@ -2354,7 +2393,7 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
     int32_t offsets[nbEBands];
     dynalloc_logp = 6;
     total_bits <<= BITRES;
-    tell = ec_tell_frac();
+    tell = ec_tell_frac(cd->ec);
     for(i = 0; i < end; i++) {
         int32_t width, quanta;
         int32_t dynalloc_loop_logp;
@@ -2367,8 +2406,8 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
         boost = 0;
         while(tell + (dynalloc_loop_logp << BITRES) < total_bits && boost < cap[i]) {
             int32_t flag;
-            flag = ec_dec_bit_logp(dynalloc_loop_logp);
-            tell = ec_tell_frac();
+            flag = ec_dec_bit_logp(cd->ec, dynalloc_loop_logp);
+            tell = ec_tell_frac(cd->ec);
             if(!flag) break;
             boost += quanta;
             total_bits -= quanta;
@@ -2380,69 +2419,69 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
     }
 
     int32_t fine_quant[nbEBands];
-    alloc_trim = tell + (6 << BITRES) <= total_bits ? ec_dec_icdf(trim_icdf, 7) : 5;
+    alloc_trim = tell + (6 << BITRES) <= total_bits ? ec_dec_icdf(cd->ec, trim_icdf, 7) : 5;
 
-    bits = (((int32_t)s_ec.storage * 8) << BITRES) - ec_tell_frac() - 1;
+    bits = (((int32_t)cd->ec->storage * 8) << BITRES) - ec_tell_frac(cd->ec) - 1;
     anti_collapse_rsv = isTransient && LM >= 2 && bits >= ((LM + 2) << BITRES) ? (1 << BITRES) : 0;
     bits -= anti_collapse_rsv;
 
     int32_t pulses[nbEBands];
     int32_t fine_priority[nbEBands];
 
-    codedBands = clt_compute_allocation(offsets, cap, alloc_trim, &intensity, &dual_stereo, bits, &balance,
+    codedBands = clt_compute_allocation(cd, offsets, cap, alloc_trim, &intensity, &dual_stereo, bits, &balance,
                                         pulses, fine_quant, fine_priority, C, LM);
 
-    unquant_fine_energy(oldBandE, fine_quant, C);
+    unquant_fine_energy(cd, oldBandE, fine_quant, C);
 
     c = 0;
     do { OPUS_MOVE(decode_mem[c], decode_mem[c] + N, DECODE_BUFFER_SIZE - N + overlap / 2); } while(++c < CC);
 
     /* Decode fixed codebook */
     assert(C * nbEBands <= 42);
-    uint8_t* collapse_masks = s_collapse_masksBuff;
+    uint8_t* collapse_masks = cd->collapse_masksBuff;
 
     assert(C * N <= 1920);
-    int16_t* X = s_XBuff;
+    int16_t* X = cd->XBuff;
 
-    quant_all_bands(X, C == 2 ? X + N : NULL, collapse_masks, pulses, shortBlocks, spread_decision,
-                    dual_stereo, intensity, tf_res, s_ec.storage * (8 << BITRES) - anti_collapse_rsv, balance, LM, codedBands);
+    quant_all_bands(cd, X, C == 2 ? X + N : NULL, collapse_masks, pulses, shortBlocks, spread_decision,
+                    dual_stereo, intensity, tf_res, cd->ec->storage * (8 << BITRES) - anti_collapse_rsv, balance, LM, codedBands);
 
-    if(anti_collapse_rsv > 0) { anti_collapse_on = ec_dec_bits(1); }
+    if(anti_collapse_rsv > 0) { anti_collapse_on = ec_dec_bits(cd->ec, 1); }
 
-    unquant_energy_finalise(oldBandE, fine_quant, fine_priority, s_ec.storage * 8 - ec_tell(), C);
+    unquant_energy_finalise(cd, oldBandE, fine_quant, fine_priority, cd->ec->storage * 8 - ec_tell(cd->ec), C);
 
-    if(anti_collapse_on) anti_collapse(X, collapse_masks, LM, C, N, oldBandE, oldLogE, oldLogE2, pulses, s_celtDec->rng);
+    if(anti_collapse_on) anti_collapse(cd, X, collapse_masks, LM, C, N, oldBandE, oldLogE, oldLogE2, pulses, cd->celtDec->rng);
 
     if(silence) {
         for(i = 0; i < C * nbEBands; i++) oldBandE[i] = -QCONST16(28.f, 10);
     }
 
-    celt_synthesis(X, out_syn, oldBandE, C, isTransient, LM, silence);
+    celt_synthesis(cd, X, out_syn, oldBandE, C, isTransient, LM, silence);
 
     c = 0;
     const uint8_t COMBFILTER_MINPERIOD = 15;
     do {
-        s_celtDec->postfilter_period = _max(s_celtDec->postfilter_period, COMBFILTER_MINPERIOD);
-        s_celtDec->postfilter_period_old = _max(s_celtDec->postfilter_period_old, COMBFILTER_MINPERIOD);
-        comb_filter(out_syn[c], out_syn[c], s_celtDec->postfilter_period_old, s_celtDec->postfilter_period,
-                    m_CELTMode.shortMdctSize, s_celtDec->postfilter_gain_old, s_celtDec->postfilter_gain,
-                    s_celtDec->postfilter_tapset_old, s_celtDec->postfilter_tapset);
+        cd->celtDec->postfilter_period = _max(cd->celtDec->postfilter_period, COMBFILTER_MINPERIOD);
+        cd->celtDec->postfilter_period_old = _max(cd->celtDec->postfilter_period_old, COMBFILTER_MINPERIOD);
+        comb_filter(out_syn[c], out_syn[c], cd->celtDec->postfilter_period_old, cd->celtDec->postfilter_period,
+                    m_CELTMode.shortMdctSize, cd->celtDec->postfilter_gain_old, cd->celtDec->postfilter_gain,
+                    cd->celtDec->postfilter_tapset_old, cd->celtDec->postfilter_tapset);
         if(LM != 0)
             comb_filter(out_syn[c] + m_CELTMode.shortMdctSize, out_syn[c] + m_CELTMode.shortMdctSize,
-                        s_celtDec->postfilter_period, postfilter_pitch, N - m_CELTMode.shortMdctSize, s_celtDec->postfilter_gain,
-                        postfilter_gain, s_celtDec->postfilter_tapset, postfilter_tapset);
+                        cd->celtDec->postfilter_period, postfilter_pitch, N - m_CELTMode.shortMdctSize, cd->celtDec->postfilter_gain,
+                        postfilter_gain, cd->celtDec->postfilter_tapset, postfilter_tapset);
 
     } while(++c < CC);
-    s_celtDec->postfilter_period_old = s_celtDec->postfilter_period;
-    s_celtDec->postfilter_gain_old = s_celtDec->postfilter_gain;
-    s_celtDec->postfilter_tapset_old = s_celtDec->postfilter_tapset;
-    s_celtDec->postfilter_period = postfilter_pitch;
-    s_celtDec->postfilter_gain = postfilter_gain;
-    s_celtDec->postfilter_tapset = postfilter_tapset;
+    cd->celtDec->postfilter_period_old = cd->celtDec->postfilter_period;
+    cd->celtDec->postfilter_gain_old = cd->celtDec->postfilter_gain;
+    cd->celtDec->postfilter_tapset_old = cd->celtDec->postfilter_tapset;
+    cd->celtDec->postfilter_period = postfilter_pitch;
+    cd->celtDec->postfilter_gain = postfilter_gain;
+    cd->celtDec->postfilter_tapset = postfilter_tapset;
     if(LM != 0) {
-        s_celtDec->postfilter_period_old = s_celtDec->postfilter_period;
-        s_celtDec->postfilter_gain_old = s_celtDec->postfilter_gain;
-        s_celtDec->postfilter_tapset_old = s_celtDec->postfilter_tapset;
+        cd->celtDec->postfilter_period_old = cd->celtDec->postfilter_period;
+        cd->celtDec->postfilter_gain_old = cd->celtDec->postfilter_gain;
+        cd->celtDec->postfilter_tapset_old = cd->celtDec->postfilter_tapset;
     }
 
     if(C == 1) memcpy(&oldBandE[nbEBands], oldBandE, nbEBands * sizeof(*oldBandE));
@@ -2469,66 +2508,66 @@ int32_t celt_decode_with_ec(int16_t *outbuf, int32_t frame_size) {
             oldLogE[c * nbEBands + i] = oldLogE2[c * nbEBands + i] = -QCONST16(28.f, 10);
         }
     } while(++c < 2);
-    s_celtDec->rng = 0; //dec->rng;
+    cd->celtDec->rng = 0; //dec->rng;
 
-    deemphasis(out_syn, outbuf, N);
+    deemphasis(cd, out_syn, outbuf, N);
 
-    if(ec_tell() > 8 * s_ec.storage) return ERR_CELT_OPUS_INTERNAL_ERROR;
-    if(s_ec.error) s_celtDec->error = 1;
+    if(ec_tell(cd->ec) > 8 * (int32_t)cd->ec->storage) return ERR_CELT_OPUS_INTERNAL_ERROR;
+    if(cd->ec->error) cd->celtDec->error = 1;
 
     return frame_size;
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t celt_decoder_ctl(int32_t request, ...) {
+int32_t celt_decoder_ctl(CELTDecoder_t* cd, int32_t request, ...) {
     va_list ap;
 
     va_start(ap, request);
     switch (request) {
         case CELT_SET_START_BAND_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
-            if (value < 1 || value > s_celtDec->mode->nbEBands) {va_end(ap); return ERR_OPUS_CELT_START_BAND;}
-            s_celtDec->start = value;
+            if (value < 1 || value > cd->celtDec->mode->nbEBands) {va_end(ap); return ERR_OPUS_CELT_START_BAND;}
+            cd->celtDec->start = value;
         } break;
         case CELT_SET_END_BAND_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
-            if (value < 1 || value > s_celtDec->mode->nbEBands) {va_end(ap); return ERR_OPUS_CELT_END_BAND;}
-            s_celtDec->end = value;
+            if (value < 1 || value > cd->celtDec->mode->nbEBands) {va_end(ap); return ERR_OPUS_CELT_END_BAND;}
+            cd->celtDec->end = value;
         } break;
         case CELT_SET_CHANNELS_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
             if (value < 1 || value > 2) {va_end(ap); return ERR_OPUS_CELT_SET_CHANNELS;}
-            s_celtDec->stream_channels = value;
+            cd->celtDec->stream_channels = value;
         } break;
         case CELT_GET_AND_CLEAR_ERROR_REQUEST: {
             int32_t *value = va_arg(ap, int32_t *);
             if (value == NULL)  {va_end(ap); return ERR_OPUS_CELT_CLEAR_REQUEST;}
-            *value = s_celtDec->error;
-            s_celtDec->error = 0;
+            *value = cd->celtDec->error;
+            cd->celtDec->error = 0;
         } break;
         case OPUS_RESET_STATE: {
             int32_t i;
             int16_t *lpc, *oldBandE, *oldLogE, *oldLogE2;
-            lpc = (int16_t *)(s_celtDec->_decode_mem + (DECODE_BUFFER_SIZE + s_celtDec->overlap) * s_celtDec->channels);
-            oldBandE = lpc + s_celtDec->channels * 24;
-            oldLogE = oldBandE + 2 * s_celtDec->mode->nbEBands;
-            oldLogE2 = oldLogE + 2 * s_celtDec->mode->nbEBands;
+            lpc = (int16_t *)(cd->celtDec->_decode_mem + (DECODE_BUFFER_SIZE + cd->celtDec->overlap) * cd->celtDec->channels);
+            oldBandE = lpc + cd->celtDec->channels * 24;
+            oldLogE = oldBandE + 2 * cd->celtDec->mode->nbEBands;
+            oldLogE2 = oldLogE + 2 * cd->celtDec->mode->nbEBands;
 
-            int32_t n = celt_decoder_get_size(s_celtDec->channels);
-            char* dest   = (char*)&s_celtDec->rng;
-            char* offset = (char*)s_celtDec;
-            memset(dest, 0,  n - (dest - offset) * sizeof(s_celtDec));
+            int32_t n = celt_decoder_get_size(cd->celtDec->channels);
+            char* dest   = (char*)&cd->celtDec->rng;
+            char* offset = (char*)cd->celtDec;
+            memset(dest, 0,  n - (dest - offset) * sizeof(cd->celtDec));
 
-            for (i = 0; i < 2 * s_celtDec->mode->nbEBands; i++) oldLogE[i] = oldLogE2[i] = -QCONST16(28.f, 10);
+            for (i = 0; i < 2 * cd->celtDec->mode->nbEBands; i++) oldLogE[i] = oldLogE2[i] = -QCONST16(28.f, 10);
         } break;
         case CELT_GET_MODE_REQUEST: {
             const CELTMode **value = va_arg(ap, const CELTMode **);
             if (value == 0){va_end(ap); return ERR_OPUS_CELT_GET_MODE_REQUEST;}
-            *value = s_celtDec->mode;
+            *value = cd->celtDec->mode;
         } break;
         case CELT_SET_SIGNALLING_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
-            s_celtDec->signalling = value;
+            cd->celtDec->signalling = value;
         } break;
         default:
             va_end(ap);
@@ -2618,22 +2657,22 @@ int32_t cwrsi(int32_t _n, int32_t _k, uint32_t _i, int32_t *_y) {
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t decode_pulses(int32_t *_y, int32_t _n, int32_t _k) {
-    return cwrsi(_n, _k, ec_dec_uint(CELT_PVQ_V(_n, _k)), _y);
+int32_t decode_pulses(CELTDecoder_t* cd, int32_t *_y, int32_t _n, int32_t _k) {
+    return cwrsi(_n, _k, ec_dec_uint(cd->ec, CELT_PVQ_V(_n, _k)), _y);
 }
 //----------------------------------------------------------------------------------------------------------------------
 
 /* This is a faster version of ec_tell_frac() that takes advantage of the low (1/8 bit) resolution to use just a linear
    function followed by a lookup to determine the exact transition thresholds. */
-uint32_t ec_tell_frac() {
+uint32_t ec_tell_frac(ec_ctx_t* ec) {
     static const uint32_t correction[8] = {35733, 38967, 42495, 46340, 50535, 55109, 60097, 65535};
     uint32_t nbits;
     uint32_t r;
     int32_t l;
     uint32_t b;
-    nbits = s_ec.nbits_total << BITRES;
-    l = EC_ILOG(s_ec.rng);
-    r = s_ec.rng >> (l - 16);
+    nbits = ec->nbits_total << BITRES;
+    l = EC_ILOG(ec->rng);
+    r = ec->rng >> (l - 16);
     b = (r >> 12) - 8;
     b += r > correction[b];
     l = (l << 3) + b;
@@ -2641,122 +2680,122 @@ uint32_t ec_tell_frac() {
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t ec_read_byte() { return s_ec.offs < s_ec.storage ? s_ec.buf[s_ec.offs++] : 0; }
+int32_t ec_read_byte(ec_ctx_t* ec) { return ec->offs < ec->storage ? ec->buf[ec->offs++] : 0; }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t ec_read_byte_from_end() {
-    return s_ec.end_offs < s_ec.storage ? s_ec.buf[s_ec.storage - ++(s_ec.end_offs)] : 0;
+int32_t ec_read_byte_from_end(ec_ctx_t* ec) {
+    return ec->end_offs < ec->storage ? ec->buf[ec->storage - ++(ec->end_offs)] : 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
 
 /*Normalizes the contents of val and rng so that rng lies entirely in the high-order symbol.*/
-void ec_dec_normalize() {
+void ec_dec_normalize(ec_ctx_t* ec) {
     /*If the range is too small, rescale it and input some bits.*/
-    while (s_ec.rng <= EC_CODE_BOT) {
+    while (ec->rng <= EC_CODE_BOT) {
         int32_t sym;
-        s_ec.nbits_total += EC_SYM_BITS;
-        s_ec.rng <<= EC_SYM_BITS;
+        ec->nbits_total += EC_SYM_BITS;
+        ec->rng <<= EC_SYM_BITS;
         /*Use up the remaining bits from our last symbol.*/
-        sym = s_ec.rem;
+        sym = ec->rem;
         /*Read the next value from the input.*/
-        s_ec.rem = ec_read_byte();
+        ec->rem = ec_read_byte(ec);
         /*Take the rest of the bits we need from this new symbol.*/
-        sym = (sym << EC_SYM_BITS | s_ec.rem) >> (EC_SYM_BITS - EC_CODE_EXTRA);
+        sym = (sym << EC_SYM_BITS | ec->rem) >> (EC_SYM_BITS - EC_CODE_EXTRA);
         /*And subtract them from val, capped to be less than EC_CODE_TOP.*/
-        s_ec.val = ((s_ec.val << EC_SYM_BITS) + (EC_SYM_MAX & ~sym)) & (EC_CODE_TOP - 1);
+        ec->val = ((ec->val << EC_SYM_BITS) + (EC_SYM_MAX & ~sym)) & (EC_CODE_TOP - 1);
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void ec_dec_init(uint8_t *_buf, uint32_t _storage) {
-    s_ec.buf = _buf;
-    s_ec.storage = _storage;
-    s_ec.end_offs = 0;
-    s_ec.end_window = 0;
-    s_ec.nend_bits = 0;
-    s_ec.nbits_total = EC_CODE_BITS + 1 - ((EC_CODE_BITS - EC_CODE_EXTRA) / EC_SYM_BITS) * EC_SYM_BITS;
-    s_ec.offs = 0;
-    s_ec.rng = 1U << EC_CODE_EXTRA;
-    s_ec.rem = ec_read_byte();
-    s_ec.val = s_ec.rng - 1 - (s_ec.rem >> (EC_SYM_BITS - EC_CODE_EXTRA));
-    s_ec.error = 0;
+void ec_dec_init(ec_ctx_t* ec, uint8_t *_buf, uint32_t _storage) {
+    ec->buf = _buf;
+    ec->storage = _storage;
+    ec->end_offs = 0;
+    ec->end_window = 0;
+    ec->nend_bits = 0;
+    ec->nbits_total = EC_CODE_BITS + 1 - ((EC_CODE_BITS - EC_CODE_EXTRA) / EC_SYM_BITS) * EC_SYM_BITS;
+    ec->offs = 0;
+    ec->rng = 1U << EC_CODE_EXTRA;
+    ec->rem = ec_read_byte(ec);
+    ec->val = ec->rng - 1 - (ec->rem >> (EC_SYM_BITS - EC_CODE_EXTRA));
+    ec->error = 0;
     /*Normalize the interval.*/
-    ec_dec_normalize();
+    ec_dec_normalize(ec);
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-uint32_t ec_decode(uint32_t _ft) {
+uint32_t ec_decode(ec_ctx_t* ec, uint32_t _ft) {
     uint32_t s;
     assert(_ft > 0);
-    s_ec.ext = s_ec.rng / _ft;
-    s = (uint32_t)(s_ec.val / s_ec.ext);
+    ec->ext = ec->rng / _ft;
+    s = (uint32_t)(ec->val / ec->ext);
     return _ft - EC_MINI(s + 1, _ft);
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-uint32_t ec_decode_bin(uint32_t _bits) {
+uint32_t ec_decode_bin(ec_ctx_t* ec, uint32_t _bits) {
     uint32_t s;
-    s_ec.ext = s_ec.rng >> _bits;
-    s = (uint32_t)(s_ec.val / s_ec.ext);
+    ec->ext = ec->rng >> _bits;
+    s = (uint32_t)(ec->val / ec->ext);
     return (1U << _bits) - EC_MINI(s + 1U, 1U << _bits);
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void ec_dec_update(uint32_t _fl, uint32_t _fh, uint32_t _ft) {
+void ec_dec_update(ec_ctx_t* ec, uint32_t _fl, uint32_t _fh, uint32_t _ft) {
     uint32_t s;
-    s = s_ec.ext *  (_ft - _fh);
-    s_ec.val -= s;
+    s = ec->ext *  (_ft - _fh);
+    ec->val -= s;
 
     if(_fl > 0){
-        s_ec.rng = s_ec.ext * (_fh - _fl);
+        ec->rng = ec->ext * (_fh - _fl);
     }
     else{
-        s_ec.rng = s_ec.rng - s;
+        ec->rng = ec->rng - s;
     }
-    ec_dec_normalize();
+    ec_dec_normalize(ec);
 }
 //----------------------------------------------------------------------------------------------------------------------
 
 /*The probability of having a "one" is 1/(1<<_logp).*/
-int32_t ec_dec_bit_logp(uint32_t _logp) {
+int32_t ec_dec_bit_logp(ec_ctx_t* ec, uint32_t _logp) {
     uint32_t r;
     uint32_t d;
     uint32_t s;
     int32_t ret;
-    r = s_ec.rng;
-    d = s_ec.val;
+    r = ec->rng;
+    d = ec->val;
     s = r >> _logp;
     ret = d < s;
-    if (!ret) s_ec.val = d - s;
-    s_ec.rng = ret ? s : r - s;
-    ec_dec_normalize();
+    if (!ret) ec->val = d - s;
+    ec->rng = ret ? s : r - s;
+    ec_dec_normalize(ec);
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t ec_dec_icdf(const uint8_t *_icdf, uint32_t _ftb) {
+int32_t ec_dec_icdf(ec_ctx_t* ec, const uint8_t *_icdf, uint32_t _ftb) {
     uint32_t r;
     uint32_t d;
     uint32_t s;
     uint32_t t;
     int32_t ret;
-    s = s_ec.rng;
-    d = s_ec.val;
+    s = ec->rng;
+    d = ec->val;
     r = s >> _ftb;
     ret = -1;
     do {
         t = s;
         s = r * _icdf[++ret];
     } while (d < s);
-    s_ec.val = d - s;
-    s_ec.rng = t - s;
-    ec_dec_normalize();
+    ec->val = d - s;
+    ec->rng = t - s;
+    ec_dec_normalize(ec);
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-uint32_t ec_dec_uint(uint32_t _ft) {
+uint32_t ec_dec_uint(ec_ctx_t* ec, uint32_t _ft) {
     uint32_t ft;
     uint32_t s;
     int32_t ftb;
@@ -2768,39 +2807,39 @@ uint32_t ec_dec_uint(uint32_t _ft) {
         uint32_t t;
         ftb -= EC_UINT_BITS;
         ft = (uint32_t)(_ft >> ftb) + 1;
-        s = ec_decode(ft);
-        ec_dec_update(s, s + 1, ft);
-        t = (uint32_t)s << ftb | ec_dec_bits(ftb);
+        s = ec_decode(ec, ft);
+        ec_dec_update(ec, s, s + 1, ft);
+        t = (uint32_t)s << ftb | ec_dec_bits(ec, ftb);
         if (t <= _ft) return t;
-        s_ec.error = 1;
+        ec->error = 1;
         return _ft;
     } else {
         _ft++;
-        s = ec_decode((uint32_t)_ft);
-        ec_dec_update(s, s + 1, (uint32_t)_ft);
+        s = ec_decode(ec, (uint32_t)_ft);
+        ec_dec_update(ec, s, s + 1, (uint32_t)_ft);
         return s;
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-uint32_t ec_dec_bits(uint32_t _bits) {
+uint32_t ec_dec_bits(ec_ctx_t* ec, uint32_t _bits) {
     uint32_t window;
     int32_t available;
     uint32_t ret;
-    window = s_ec.end_window;
-    available = s_ec.nend_bits;
+    window = ec->end_window;
+    available = ec->nend_bits;
     if ((uint32_t)available < _bits) {
         do {
-            window |= (uint32_t)ec_read_byte_from_end() << available;
+            window |= (uint32_t)ec_read_byte_from_end(ec) << available;
             available += EC_SYM_BITS;
-        } while (available <= EC_WINDOW_SIZE - EC_SYM_BITS);
+        } while (available <= (int32_t)(EC_WINDOW_SIZE - EC_SYM_BITS));
     }
     ret = (uint32_t)window & (((uint32_t)1 << _bits) - 1U);
     window >>= _bits;
     available -= _bits;
-    s_ec.end_window = window;
-    s_ec.nend_bits = available;
-    s_ec.nbits_total += _bits;
+    ec->end_window = window;
+    ec->nend_bits = available;
+    ec->nbits_total += _bits;
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -2948,7 +2987,7 @@ void kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st
     kiss_fft_cpx *Fout0, *Fout1, *Fout2, *Fout3, *Fout4;
     int32_t i, u;
     kiss_fft_cpx scratch[13];
-    const kiss_twiddle_cpx *tw;
+    const kiss_twiddle_cpx *tw, *tw1, *tw2, *tw3, *tw4;
     kiss_twiddle_cpx ya, yb;
     kiss_fft_cpx *Fout_beg = Fout;
 
@@ -2965,15 +3004,20 @@ void kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st
         Fout2 = Fout0 + 2 * m;
         Fout3 = Fout0 + 3 * m;
         Fout4 = Fout0 + 4 * m;
+        tw1 = tw2 = tw3 = tw4 = tw;
 
         /* For non-custom modes, m is guaranteed to be a multiple of 4. */
         for (u = 0; u < m; ++u) {
             scratch[0] = *Fout0;
 
-            C_MUL(scratch[1], *Fout1, tw[u * fstride]);
-            C_MUL(scratch[2], *Fout2, tw[2 * u * fstride]);
-            C_MUL(scratch[3], *Fout3, tw[3 * u * fstride]);
-            C_MUL(scratch[4], *Fout4, tw[4 * u * fstride]);
+            C_MUL(scratch[1], *Fout1, *tw1);
+            C_MUL(scratch[2], *Fout2, *tw2);
+            C_MUL(scratch[3], *Fout3, *tw3);
+            C_MUL(scratch[4], *Fout4, *tw4);
+            tw1 += fstride;
+            tw2 += fstride * 2;
+            tw3 += fstride * 3;
+            tw4 += fstride * 4;
 
             C_ADD(scratch[7], scratch[1], scratch[4]);
             C_SUB(scratch[10], scratch[1], scratch[4]);
@@ -3055,6 +3099,39 @@ void opus_fft_impl(const kiss_fft_state *st, kiss_fft_cpx *fout) {
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
+void opus_fft_real(const int32_t *in, kiss_fft_cpx *out, int32_t shift) {
+    /* real FFT of 480 >> shift samples with the complex FFT of half the size (kfft[shift + 1]), the even samples
+       are the real, the odd ones the imaginary part. out gets the bins 0 ... n/2 (n/2 + 1 values), not scaled. */
+    const kiss_fft_state *st = m_mdct_lookup.kfft[shift + 1];
+    const int32_t n2 = st->nfft;
+    int32_t k;
+
+    for (k = 0; k < n2; k++) {
+        out[st->bitrev[k]].r = in[2 * k];
+        out[st->bitrev[k]].i = in[2 * k + 1];
+    }
+    opus_fft_impl(st, out);
+
+    /* X[k] = E[k] + W^k * O[k], X[n/2 - k] = conj(E[k] - W^k * O[k]), W = exp(-2*pi*i/n) = twiddles[1 << shift] */
+    kiss_fft_cpx z0 = out[0];
+    out[0].r = z0.r + z0.i;
+    out[0].i = 0;
+    out[n2].r = z0.r - z0.i;
+    out[n2].i = 0;
+    for (k = 1; k <= n2 / 2; k++) {
+        kiss_fft_cpx a = out[k], b = out[n2 - k], e, o, t;
+        e.r = SHR32(a.r + b.r, 1);
+        e.i = SHR32(a.i - b.i, 1);
+        o.r = SHR32(a.i + b.i, 1);
+        o.i = SHR32(b.r - a.r, 1);
+        C_MUL(t, o, st->twiddles[k << shift]);
+        out[k].r = e.r + t.r;
+        out[k].i = e.i + t.i;
+        out[n2 - k].r = e.r - t.r;
+        out[n2 - k].i = t.i - e.i;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
 
 /* When called, decay is positive and at most 11456. */
 uint32_t ec_laplace_get_freq1(uint32_t fs0, int32_t decay) {
@@ -3064,11 +3141,11 @@ uint32_t ec_laplace_get_freq1(uint32_t fs0, int32_t decay) {
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t ec_laplace_decode(uint32_t fs, int32_t decay) {
+int32_t ec_laplace_decode(ec_ctx_t* ec, uint32_t fs, int32_t decay) {
     int32_t val = 0;
     uint32_t fl;
     uint32_t fm;
-    fm = ec_decode_bin(15);
+    fm = ec_decode_bin(ec, 15);
     fl = 0;
     if (fm >= fs) {
         val++;
@@ -3098,7 +3175,7 @@ int32_t ec_laplace_decode(uint32_t fs, int32_t decay) {
     assert(fs > 0);
     assert(fl <= fm);
     assert(fm < _min(fl + fs, 32768));
-    ec_dec_update(fl, _min(fl + fs, 32768), 32768);
+    ec_dec_update(ec, fl, _min(fl + fs, 32768), 32768);
     return val;
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -3326,7 +3403,7 @@ void clt_mdct_backward(int32_t *in, int32_t * out, int32_t overlap, int32_t shif
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t interp_bits2pulses(int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2,
+int32_t interp_bits2pulses(CELTDecoder_t* cd, int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2,
                            const int32_t *thresh, const int32_t *cap, int32_t total, int32_t *_balance,
                            int32_t skip_rsv, int32_t *intensity, int32_t intensity_rsv, int32_t *dual_stereo,
                            int32_t dual_stereo_rsv, int32_t *bits, int32_t *ebits, int32_t *fine_priority, int32_t C,
@@ -3413,7 +3490,7 @@ int32_t interp_bits2pulses(int32_t end, int32_t skip_start, const int32_t *bits1
           Otherwise it is force-skipped.
           This ensures that we have enough bits to code the skip flag.*/
         if(band_bits >= max(thresh[j], alloc_floor + (1 << BITRES))) {
-            if(ec_dec_bit_logp(1)) { break; }
+            if(ec_dec_bit_logp(cd->ec, 1)) { break; }
             /*We used a bit to skip this band.*/
             psum += 1 << BITRES;
             band_bits -= 1 << BITRES;
@@ -3435,7 +3512,7 @@ int32_t interp_bits2pulses(int32_t end, int32_t skip_start, const int32_t *bits1
     assert(codedBands > 0);
     /* Code the intensity and dual stereo parameters. */
     if(intensity_rsv > 0) {
-        *intensity = ec_dec_uint(codedBands + 1);
+        *intensity = ec_dec_uint(cd->ec, codedBands + 1);
     } else
         *intensity = 0;
     if(*intensity <= 0) {
@@ -3443,7 +3520,7 @@ int32_t interp_bits2pulses(int32_t end, int32_t skip_start, const int32_t *bits1
         dual_stereo_rsv = 0;
     }
     if(dual_stereo_rsv > 0) {
-        *dual_stereo = ec_dec_bit_logp(1);
+        *dual_stereo = ec_dec_bit_logp(cd->ec, 1);
     } else
         *dual_stereo = 0;
 
@@ -3554,7 +3631,7 @@ int32_t interp_bits2pulses(int32_t end, int32_t skip_start, const int32_t *bits1
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t clt_compute_allocation(const int32_t *offsets, const int32_t *cap, int32_t alloc_trim,
+int32_t clt_compute_allocation(CELTDecoder_t* cd, const int32_t *offsets, const int32_t *cap, int32_t alloc_trim,
                            int32_t *intensity, int32_t *dual_stereo, int32_t total, int32_t *balance, int32_t *pulses, int32_t *ebits,
                            int32_t *fine_priority, int32_t C, int32_t LM) {
     int32_t lo, hi, len, j;
@@ -3563,7 +3640,7 @@ int32_t clt_compute_allocation(const int32_t *offsets, const int32_t *cap, int32
     int32_t skip_rsv;
     int32_t intensity_rsv;
     int32_t dual_stereo_rsv;
-    const uint8_t end = s_celtDec->end;  // 21
+    const uint8_t end = cd->celtDec->end;  // 21
 
     total = _max(total, 0);
     len = m_CELTMode.nbEBands; // =21
@@ -3584,10 +3661,10 @@ int32_t clt_compute_allocation(const int32_t *offsets, const int32_t *cap, int32
     }
 
     assert(len <= 21);
-    int32_t* bits1       = s_bits1Buff;
-    int32_t* bits2       = s_bits2Buff;
-    int32_t* thresh      = s_threshBuff;
-    int32_t* trim_offset = s_trim_offsetBuff;
+    int32_t* bits1       = cd->bits1Buff;
+    int32_t* bits2       = cd->bits2Buff;
+    int32_t* thresh      = cd->threshBuff;
+    int32_t* trim_offset = cd->trim_offsetBuff;
 
     for (j = 0; j < end; j++) {
         /* Below this threshold, we're sure not to allocate any PVQ bits */
@@ -3641,7 +3718,7 @@ int32_t clt_compute_allocation(const int32_t *offsets, const int32_t *cap, int32
         bits1[j] = bits1j;
         bits2[j] = bits2j;
     }
-    codedBands = interp_bits2pulses(end, skip_start, bits1, bits2, thresh, cap, total, balance, skip_rsv,
+    codedBands = interp_bits2pulses(cd, end, skip_start, bits1, bits2, thresh, cap, total, balance, skip_rsv,
                                     intensity, intensity_rsv, dual_stereo, dual_stereo_rsv, pulses, ebits,
                                     fine_priority, C, LM);
 
@@ -3649,7 +3726,7 @@ int32_t clt_compute_allocation(const int32_t *offsets, const int32_t *cap, int32
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void unquant_coarse_energy(int16_t *oldEBands, int32_t intra, int32_t C, int32_t LM) {
+void unquant_coarse_energy(CELTDecoder_t* cd, int16_t *oldEBands, int32_t intra, int32_t C, int32_t LM) {
     const uint8_t *prob_model = e_prob_model[LM][intra];
     int32_t i, c;
     int32_t prev[2] = {0, 0};
@@ -3657,7 +3734,7 @@ void unquant_coarse_energy(int16_t *oldEBands, int32_t intra, int32_t C, int32_t
     int16_t beta;
     int32_t budget;
     int32_t tell;
-    const uint8_t end = s_celtDec->end;  // 21
+    const uint8_t end = cd->celtDec->end;  // 21
 
     if (intra) {
         coef = 0;
@@ -3667,7 +3744,7 @@ void unquant_coarse_energy(int16_t *oldEBands, int32_t intra, int32_t C, int32_t
         coef = pred_coef[LM];
     }
 
-    budget = s_ec.storage * 8;
+    budget = cd->ec->storage * 8;
 
     /* Decode at a fixed coarse resolution */
     for (i = 0; i < end; i++) {
@@ -3680,16 +3757,16 @@ void unquant_coarse_energy(int16_t *oldEBands, int32_t intra, int32_t C, int32_t
                test on C at function entry, but that isn't enough
                to make the static analyzer happy. */
             assert(c < 2);
-            tell = ec_tell();
+            tell = ec_tell(cd->ec);
             if (budget - tell >= 15) {
                 int32_t pi;
                 pi = 2 * _min(i, 20);
-                qi = ec_laplace_decode(prob_model[pi] << 7, prob_model[pi + 1] << 6);
+                qi = ec_laplace_decode(cd->ec, prob_model[pi] << 7, prob_model[pi + 1] << 6);
             } else if (budget - tell >= 2) {
-                qi = ec_dec_icdf(small_energy_icdf, 2);
+                qi = ec_dec_icdf(cd->ec, small_energy_icdf, 2);
                 qi = (qi >> 1) ^ -(qi & 1);
             } else if (budget - tell >= 1) {
-                qi = -ec_dec_bit_logp(1);
+                qi = -ec_dec_bit_logp(cd->ec, 1);
             } else
                 qi = -1;
             q = (int32_t)SHL32(EXTEND32(qi), 10);
@@ -3704,9 +3781,9 @@ void unquant_coarse_energy(int16_t *oldEBands, int32_t intra, int32_t C, int32_t
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void unquant_fine_energy(int16_t *oldEBands, int32_t *fine_quant, int32_t C) {
+void unquant_fine_energy(CELTDecoder_t* cd, int16_t *oldEBands, int32_t *fine_quant, int32_t C) {
     int32_t i, c;
-    const uint8_t end = s_celtDec->end;  // 21
+    const uint8_t end = cd->celtDec->end;  // 21
     /* Decode finer resolution */
     for (i = 0; i < end; i++) {
         if (fine_quant[i] <= 0) continue;
@@ -3714,7 +3791,7 @@ void unquant_fine_energy(int16_t *oldEBands, int32_t *fine_quant, int32_t C) {
         do {
             int32_t q2;
             int16_t offset;
-            q2 = ec_dec_bits(fine_quant[i]);
+            q2 = ec_dec_bits(cd->ec, fine_quant[i]);
             offset = SUB16(SHR32(SHL32(EXTEND32(q2), 10) + QCONST16(.5f, 10), fine_quant[i]),
                            QCONST16(.5f, 10));
             oldEBands[i + c * m_CELTMode.nbEBands] += offset;
@@ -3723,10 +3800,10 @@ void unquant_fine_energy(int16_t *oldEBands, int32_t *fine_quant, int32_t C) {
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-void unquant_energy_finalise(int16_t *oldEBands, int32_t *fine_quant,
+void unquant_energy_finalise(CELTDecoder_t* cd, int16_t *oldEBands, int32_t *fine_quant,
                              int32_t *fine_priority, int32_t bits_left, int32_t C) {
     int32_t i, prio, c;
-    const uint8_t  end = s_celtDec->end;  // 21
+    const uint8_t  end = cd->celtDec->end;  // 21
 
     /* Use up the remaining bits */
     for (prio = 0; prio < 2; prio++) {
@@ -3736,7 +3813,7 @@ void unquant_energy_finalise(int16_t *oldEBands, int32_t *fine_quant,
             do {
                 int32_t q2;
                 int16_t offset;
-                q2 = ec_dec_bits(1);
+                q2 = ec_dec_bits(cd->ec, 1);
                 offset = SHR16(SHL16(q2, 10) - QCONST16(.5f, 10), fine_quant[i] + 1);
                 oldEBands[i + c * m_CELTMode.nbEBands] += offset;
                 bits_left--;
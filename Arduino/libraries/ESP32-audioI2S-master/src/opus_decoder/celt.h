@@ -82,7 +82,6 @@ typedef struct _ec_ctx {
     int32_t  error; /*Nonzero if an error occurred.*/
 } ec_ctx_t;
 
-extern ec_ctx_t s_ec;
 extern const uint8_t cache_bits50[392];
 extern const int16_t cache_index50[105];
 
@@ -100,6 +99,22 @@ typedef struct _band_ctx{
     int32_t avoid_split_noise;
 } band_ctx_t;
 
+typedef struct CELTDecoder_t {  // complete state of one CELT decoder instance, see CELTDecoder_AllocateBuffers()
+    CELTDecoder *celtDec;
+    band_ctx_t   band_ctx;
+    ec_ctx_t    *ec;                 // range decoder, owned by the OPUS decoder and shared with SILK
+    int32_t*     freqBuff;           // mem in celt_synthesis
+    int32_t*     iyBuff;             // mem in alg_unquant
+    int16_t*     normBuff;           // mem in quant_all_bands
+    int16_t*     XBuff;              // mem in celt_decode_with_ec
+    int32_t*     bits1Buff;          // mem in clt_compute_allocation
+    int32_t*     bits2Buff;          // mem in clt_compute_allocation
+    int32_t*     threshBuff;         // mem in clt_compute_allocation
+    int32_t*     trim_offsetBuff;    // mem in clt_compute_allocation
+    uint8_t*     collapse_masksBuff; // mem n celt_decode_with_ec
+    int16_t*     tmpBuff;            // mem in deinterleave_hadamard and interleave_hadamard
+} CELTDecoder_t;
+
 struct split_ctx{
     int32_t inv;
     int32_t imid;
@@ -357,8 +372,8 @@ inline int16_t sig2word16(int32_t x){
    return (int16_t)(x);
 }
 
-inline int32_t ec_tell(){
-  return s_ec.nbits_total-EC_ILOG(s_ec.rng);
+inline int32_t ec_tell(ec_ctx_t* ec){
+  return ec->nbits_total-EC_ILOG(ec->rng);
 }
 
 /* Atan approximation using a 4th order polynomial. Input is in Q15 format and normalized by pi/4. Output is in
@@ -448,22 +463,33 @@ inline int32_t celt_exp2(int16_t x) {
 
 inline void dual_inner_prod(const int16_t *x, const int16_t *y01, const int16_t *y02, int32_t N, int32_t *xy1,
                                    int32_t *xy2) {
+    /* two partial sums per product, the even and odd terms are independent MAC chains */
     int32_t i;
-    int32_t xy01 = 0;
-    int32_t xy02 = 0;
-    for(i = 0; i < N; i++) {
+    int32_t xy01 = 0, xy01b = 0;
+    int32_t xy02 = 0, xy02b = 0;
+    for(i = 0; i < N - 1; i += 2) {
+        xy01  = MAC16_16(xy01,  x[i],     y01[i]);
+        xy01b = MAC16_16(xy01b, x[i + 1], y01[i + 1]);
+        xy02  = MAC16_16(xy02,  x[i],     y02[i]);
+        xy02b = MAC16_16(xy02b, x[i + 1], y02[i + 1]);
+    }
+    if(i < N) {
         xy01 = MAC16_16(xy01, x[i], y01[i]);
         xy02 = MAC16_16(xy02, x[i], y02[i]);
     }
-    *xy1 = xy01;
-    *xy2 = xy02;
+    *xy1 = xy01 + xy01b;
+    *xy2 = xy02 + xy02b;
 }
 
 inline uint32_t celt_inner_prod(const int16_t *x, const int16_t *y, int32_t N) {
     int32_t i;
-    uint32_t xy = 0;
-    for (i = 0; i < N; i++) xy = (int32_t)x[i] * (int32_t)y[i] + xy;
-    return xy;
+    uint32_t xy = 0, xyb = 0;
+    for (i = 0; i < N - 1; i += 2) {
+        xy  = (int32_t)x[i]     * (int32_t)y[i]     + xy;
+        xyb = (int32_t)x[i + 1] * (int32_t)y[i + 1] + xyb;
+    }
+    if (i < N) xy = (int32_t)x[i] * (int32_t)y[i] + xy;
+    return xy + xyb;
 }
 
 inline int32_t get_pulses(int32_t i){
@@ -530,58 +556,59 @@ int16_t  bitexact_cos(int16_t x);
 int32_t  bitexact_log2tan(int32_t isin, int32_t icos);
 void     denormalise_bands(const int16_t *X, int32_t *freq, const int16_t *bandLogE, int32_t end, int32_t M,
                            int32_t silence);
-void     anti_collapse(int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size, const int16_t *logE,
+void     anti_collapse(CELTDecoder_t* cd, int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size, const int16_t *logE,
                        const int16_t *prev1logE, const int16_t *prev2logE, const int32_t *pulses, uint32_t seed);
 void     compute_channel_weights(int32_t Ex, int32_t Ey, int16_t w[2]);
 void     stereo_split(int16_t *X, int16_t *Y, int32_t N);
 void     stereo_merge(int16_t *X, int16_t *Y, int16_t mid, int32_t N);
-void     deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
-void     interleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
+void     deinterleave_hadamard(CELTDecoder_t* cd, int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
+void     interleave_hadamard(CELTDecoder_t* cd, int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
 void     haar1(int16_t *X, int32_t N0, int32_t stride);
 int32_t  compute_qn(int32_t N, int32_t b, int32_t offset, int32_t pulse_cap, int32_t stereo);
-void     compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B, int32_t __B0,
+void     compute_theta(CELTDecoder_t* cd, struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B, int32_t __B0,
                        int32_t LM, int32_t stereo, int32_t *fill);
-uint32_t quant_band_n1(int16_t *X, int16_t *Y, int32_t b, int16_t *lowband_out);
-uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM, int16_t gain,
+uint32_t quant_band_n1(CELTDecoder_t* cd, int16_t *X, int16_t *Y, int32_t b, int16_t *lowband_out);
+uint32_t quant_partition(CELTDecoder_t* cd, int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM, int16_t gain,
                          int32_t fill);
-uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM, int16_t *lowband_out,
+uint32_t quant_band(CELTDecoder_t* cd, int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM, int16_t *lowband_out,
                     int16_t gain, int16_t *lowband_scratch, int32_t fill);
-uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
+uint32_t quant_band_stereo(CELTDecoder_t* cd, int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
                            int16_t *lowband_out, int16_t *lowband_scratch, int32_t fill);
 void     special_hybrid_folding(int16_t *norm, int16_t *norm2, int32_t M, int32_t dual_stereo);
-void     quant_all_bands(int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t *pulses, int32_t shortBlocks,
+void     quant_all_bands(CELTDecoder_t* cd, int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, int32_t *pulses, int32_t shortBlocks,
                          int32_t spread, int32_t dual_stereo, int32_t intensity, int32_t *tf_res, int32_t total_bits,
                          int32_t balance, int32_t LM, int32_t codedBands);
 int32_t  celt_decoder_get_size(int32_t channels);
-int32_t  celt_decoder_init(int32_t channels);
+int32_t  celt_decoder_init(CELTDecoder_t* cd, int32_t channels);
 void     deemphasis_stereo_simple(int32_t *in[], int16_t *pcm, int32_t N, const int16_t coef0, int32_t *mem);
-void     deemphasis(int32_t *in[], int16_t *pcm, int32_t N);
-void     celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t C, int32_t isTransient, int32_t LM,
+void     deemphasis(CELTDecoder_t* cd, int32_t *in[], int16_t *pcm, int32_t N);
+void     celt_synthesis(CELTDecoder_t* cd, int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t C, int32_t isTransient, int32_t LM,
                         int32_t silence);
-void     tf_decode(int32_t isTransient, int32_t *tf_res, int32_t LM);
-int32_t  celt_decode_with_ec(int16_t *outbuf, int32_t frame_size);
-int32_t  celt_decoder_ctl(int32_t request, ...);
+void     tf_decode(CELTDecoder_t* cd, int32_t isTransient, int32_t *tf_res, int32_t LM);
+int32_t  celt_decode_with_ec(CELTDecoder_t* cd, int16_t *outbuf, int32_t frame_size);
+int32_t  celt_decoder_ctl(CELTDecoder_t* cd, int32_t request, ...);
 int32_t  cwrsi(int32_t _n, int32_t _k, uint32_t _i, int32_t *_y);
-int32_t  decode_pulses(int32_t *_y, int32_t _n, int32_t _k);
-uint32_t ec_tell_frac();
-int32_t  ec_read_byte();
-int32_t  ec_read_byte_from_end();
-void     ec_dec_normalize();
-void     ec_dec_init(uint8_t *_buf, uint32_t _storage);
-uint32_t ec_decode(uint32_t _ft);
-uint32_t ec_decode_bin(uint32_t _bits);
-void     ec_dec_update(uint32_t _fl, uint32_t _fh, uint32_t _ft);
-int32_t  ec_dec_bit_logp(uint32_t _logp);
-int32_t  ec_dec_icdf(const uint8_t *_icdf, uint32_t _ftb);
-uint32_t ec_dec_uint(uint32_t _ft);
-uint32_t ec_dec_bits(uint32_t _bits);
+int32_t  decode_pulses(CELTDecoder_t* cd, int32_t *_y, int32_t _n, int32_t _k);
+uint32_t ec_tell_frac(ec_ctx_t* ec);
+int32_t  ec_read_byte(ec_ctx_t* ec);
+int32_t  ec_read_byte_from_end(ec_ctx_t* ec);
+void     ec_dec_normalize(ec_ctx_t* ec);
+void     ec_dec_init(ec_ctx_t* ec, uint8_t *_buf, uint32_t _storage);
+uint32_t ec_decode(ec_ctx_t* ec, uint32_t _ft);
+uint32_t ec_decode_bin(ec_ctx_t* ec, uint32_t _bits);
+void     ec_dec_update(ec_ctx_t* ec, uint32_t _fl, uint32_t _fh, uint32_t _ft);
+int32_t  ec_dec_bit_logp(ec_ctx_t* ec, uint32_t _logp);
+int32_t  ec_dec_icdf(ec_ctx_t* ec, const uint8_t *_icdf, uint32_t _ftb);
+uint32_t ec_dec_uint(ec_ctx_t* ec, uint32_t _ft);
+uint32_t ec_dec_bits(ec_ctx_t* ec, uint32_t _bits);
 void     kf_bfly2(kiss_fft_cpx *Fout, int32_t m, int32_t N);
 void     kf_bfly4(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
 void     kf_bfly3(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
 void     kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
 void     opus_fft_impl(const kiss_fft_state *st, kiss_fft_cpx *fout);
+void     opus_fft_real(const int32_t *in, kiss_fft_cpx *out, int32_t shift);
 uint32_t ec_laplace_get_freq1(uint32_t fs0, int32_t decay);
-int32_t  ec_laplace_decode(uint32_t fs, int32_t decay);
+int32_t  ec_laplace_decode(ec_ctx_t* ec, uint32_t fs, int32_t decay);
 uint32_t isqrt32(uint32_t _val);
 int16_t  celt_rsqrt_norm(int32_t x);
 int32_t  celt_sqrt(int32_t x);
@@ -592,23 +619,23 @@ void     exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16
 void     exp_rotation(int16_t *X, int32_t len, int32_t dir, int32_t stride, int32_t K, int32_t spread);
 void     normalise_residual(int32_t *iy, int16_t *X, int32_t N, int32_t Ryy, int16_t gain);
 uint32_t extract_collapse_mask(int32_t *iy, int32_t N, int32_t B);
-uint32_t alg_unquant(int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain);
+uint32_t alg_unquant(CELTDecoder_t* cd, int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain);
 void     renormalise_vector(int16_t *X, int32_t N, int16_t gain);
-int32_t  interp_bits2pulses(int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2,
+int32_t  interp_bits2pulses(CELTDecoder_t* cd, int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2,
                             const int32_t *thresh, const int32_t *cap, int32_t total, int32_t *_balance,
                             int32_t skip_rsv, int32_t *intensity, int32_t intensity_rsv, int32_t *dual_stereo,
                             int32_t dual_stereo_rsv, int32_t *bits, int32_t *ebits, int32_t *fine_priority, int32_t C,
                             int32_t LM);
-int32_t  clt_compute_allocation(const int32_t *offsets, const int32_t *cap, int32_t alloc_trim, int32_t *intensity,
+int32_t  clt_compute_allocation(CELTDecoder_t* cd, const int32_t *offsets, const int32_t *cap, int32_t alloc_trim, int32_t *intensity,
                                 int32_t *dual_stereo, int32_t total, int32_t *balance, int32_t *pulses, int32_t *ebits,
                                 int32_t *fine_priority, int32_t C, int32_t LM);
-void     unquant_coarse_energy(int16_t *oldEBands, int32_t intra, int32_t C, int32_t LM);
-void     unquant_fine_energy(int16_t *oldEBands, int32_t *fine_quant, int32_t C);
-void     unquant_energy_finalise(int16_t *oldEBands, int32_t *fine_quant, int32_t *fine_priority, int32_t bits_left,
+void     unquant_coarse_energy(CELTDecoder_t* cd, int16_t *oldEBands, int32_t intra, int32_t C, int32_t LM);
+void     unquant_fine_energy(CELTDecoder_t* cd, int16_t *oldEBands, int32_t *fine_quant, int32_t C);
+void     unquant_energy_finalise(CELTDecoder_t* cd, int16_t *oldEBands, int32_t *fine_quant, int32_t *fine_priority, int32_t bits_left,
                                  int32_t C);
 uint32_t celt_pvq_u_row(uint32_t row, uint32_t data);
 
-bool     CELTDecoder_AllocateBuffers(void);
-void     CELTDecoder_FreeBuffers();
-void     CELTDecoder_ClearBuffer(void);
+CELTDecoder_t* CELTDecoder_AllocateBuffers(ec_ctx_t* ec);
+void     CELTDecoder_FreeBuffers(CELTDecoder_t* cd);
+void     CELTDecoder_ClearBuffer(CELTDecoder_t* cd);
 
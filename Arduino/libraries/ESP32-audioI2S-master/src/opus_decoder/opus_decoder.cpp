@@ -11,8 +11,10 @@
 #include "opus_decoder.h"
 #include "celt.h"
 #include "silk.h"
+#include "../ogg_demuxer/ogg_demuxer.h"
 #include "Arduino.h"
 #include <vector>
+#include <new>
 
 #define __malloc_heap_psram(size) \
     heap_caps_malloc_prefer(size, 2, MALLOC_CAP_DEFAULT | MALLOC_CAP_SPIRAM, MALLOC_CAP_DEFAULT | MALLOC_CAP_INTERNAL)
@@ -29,63 +31,92 @@ enum {OPUS_BANDWIDTH_NARROWBAND = 1101,    OPUS_BANDWIDTH_MEDIUMBAND = 1102, OPU
       OPUS_BANDWIDTH_SUPERWIDEBAND = 1104, OPUS_BANDWIDTH_FULLBAND = 1105};
 enum {MODE_NONE = 0, MODE_SILK_ONLY = 1000, MODE_HYBRID = 1001,  MODE_CELT_ONLY = 1002};
 
-bool      s_f_opusParseOgg = false;
-bool      s_f_newSteamTitle = false;  // streamTitle
-bool      s_f_opusNewMetadataBlockPicture = false; // new metadata block picture
-bool      s_f_opusStereoFlag = false;
-bool      s_f_continuedPage = false;
-bool      s_f_firstPage = false;
-bool      s_f_lastPage = false;
-bool      s_f_nextChunk = false;
-
-uint8_t   s_opusChannels = 0;
-uint16_t  s_mode = 0;
-uint8_t   s_opusCountCode =  0;
-uint8_t   s_opusPageNr = 0;
-uint8_t   s_frameCount = 0;
-uint16_t  s_opusOggHeaderSize = 0;
-uint16_t  s_bandWidth = 0;
-uint16_t  s_internalSampleRate = 0;
-uint16_t  s_endband =0;
-uint32_t  s_opusSamplerate = 0;
-uint32_t  s_opusSegmentLength = 0;
-uint32_t  s_opusCurrentFilePos = 0;
-uint32_t  s_opusAudioDataStart = 0;
-int32_t   s_opusBlockPicLen = 0;
-int32_t   s_blockPicLenUntilFrameEnd = 0;
-int32_t   s_opusRemainBlockPicLen = 0;
-int32_t   s_opusCommentBlockSize = 0;
-uint32_t  s_opusBlockPicPos = 0;
-uint32_t  s_opusBlockLen = 0;
-char     *s_opusChbuf = NULL;
-int32_t   s_opusValidSamples = 0;
-
-uint16_t *s_opusSegmentTable;
-uint8_t   s_opusSegmentTableSize = 0;
-int16_t   s_opusSegmentTableRdPtr = -1;
-int8_t    s_opusError = 0;
-int8_t    s_prev_mode = 0;
-float     s_opusCompressionRatio = 0;
-
-std::vector <uint32_t>s_opusBlockPicItem;
-
-bool OPUSDecoder_AllocateBuffers(){
-    s_opusChbuf = (char*)__malloc_heap_psram(512);
-    if(!CELTDecoder_AllocateBuffers()) {log_e("CELT not init"); return false;}
-    s_opusSegmentTable = (uint16_t*)__malloc_heap_psram(256 * sizeof(uint16_t));
-    if(!s_opusSegmentTable) {log_e("CELT not init"); return false;}
-    CELTDecoder_ClearBuffer();
-    OPUSDecoder_ClearBuffers();
+// complete state of one decoder instance: ogg parser, CELT, SILK and the range decoder they share
+struct OPUSDecoder_t {
+    bool      f_opusParseOgg = false;
+    bool      f_newSteamTitle = false;  // streamTitle
+    bool      f_opusNewMetadataBlockPicture = false; // new metadata block picture
+    bool      f_opusStereoFlag = false;
+    bool      f_continuedPage = false;
+    bool      f_firstPage = false;
+    bool      f_lastPage = false;
+    bool      f_nextChunk = false;
+    bool      f_opusLastPacketContinues = false;
+
+    uint8_t   opusChannels = 0;
+    uint16_t  mode = 0;
+    uint8_t   opusCountCode =  0;
+    uint8_t   opusPageNr = 0;
+    uint8_t   frameCount = 0;
+    uint16_t  opusOggHeaderSize = 0;
+    uint16_t  bandWidth = 0;
+    uint16_t  internalSampleRate = 0;
+    uint16_t  opusPreSkip = 0;
+    uint16_t  endband =0;
+    uint32_t  opusSamplerate = 0;
+    uint32_t  opusSegmentLength = 0;
+    uint32_t  opusCurrentFilePos = 0;
+    uint32_t  opusAudioDataStart = 0;
+    int32_t   opusBlockPicLen = 0;
+    int32_t   blockPicLenUntilFrameEnd = 0;
+    int32_t   opusRemainBlockPicLen = 0;
+    int32_t   opusCommentBlockSize = 0;
+    uint32_t  opusBlockPicPos = 0;
+    uint32_t  opusBlockLen = 0;
+    char     *opusChbuf = NULL;
+    int32_t   opusValidSamples = 0;
+
+    uint16_t *opusSegmentTable = NULL;
+    uint8_t   opusSegmentTableSize = 0;
+    int16_t   opusSegmentTableRdPtr = -1;
+    int8_t    opusError = 0;
+    int8_t    prev_mode = 0;
+    float     opusCompressionRatio = 0;
+    oggCrc_t  oggCrc = {};              // CRC of the current Ogg page if it is bigger than the input window
+
+    std::vector <uint32_t>opusBlockPicItem;
+
+    // state that survives between the calls for the frames of one packet
+    int8_t    configNr = 0;
+    uint16_t  samplesPerFrame = 0;
+    uint16_t  code1FrameSize = 0;
+    uint16_t  code2FirstFrameLength = 0;
+    uint16_t  code2SecondFrameLength = 0;
+    bool      code3FirstCall = true;
+    bool      code3Vbr = false;
+    bool      code3Padding = false;
+    int16_t   code3FrameSize = 0;
+    uint8_t   code3FrameCount = 0;
+    int32_t   code3SamplesPerFrame = 0;
+    int32_t   code3PaddingLength = 0;
+
+    ec_ctx_t       ec = {}; // range decoder, SILK and CELT read from the same bitstream in hybrid frames
+    CELTDecoder_t* celt = NULL;
+    SILKDecoder_t* silk = NULL;
+};
+
+OPUSDecoder_t* OPUSDecoder_AllocateBuffers(){
+    // every decoder instance owns its complete state, so several streams can be decoded at the same time
+    void* mem = __malloc_heap_psram(sizeof(OPUSDecoder_t));
+    if(!mem) {log_e("not enough memory to allocate opusdecoder buffers"); return NULL;}
+    OPUSDecoder_t* od = new (mem) OPUSDecoder_t();
+    od->opusChbuf = (char*)__malloc_heap_psram(512);
+    od->opusSegmentTable = (uint16_t*)__malloc_heap_psram(256 * sizeof(uint16_t));
+    od->celt = CELTDecoder_AllocateBuffers(&od->ec);
+    od->silk = SILKDecoder_AllocateBuffers(&od->ec);
+    if(!od->opusChbuf || !od->opusSegmentTable || !od->celt || !od->silk) {log_e("CELT not init"); OPUSDecoder_FreeBuffers(od); return NULL;}
+    CELTDecoder_ClearBuffer(od->celt);
+    OPUSDecoder_ClearBuffers(od);
     // allocate CELT buffers after OPUS head (nr of channels is needed)
-    s_opusError = celt_decoder_init(2); if(s_opusError < 0) {log_e("CELT not init"); return false;}
-    s_opusError = celt_decoder_ctl(CELT_SET_SIGNALLING_REQUEST,  0); if(s_opusError < 0) {log_e("CELT not init"); return false;}
-    s_opusError = celt_decoder_ctl(CELT_SET_END_BAND_REQUEST,   21); if(s_opusError < 0) {log_e("CELT not init"); return false;}
-    OPUSsetDefaults();
+    od->opusError = celt_decoder_init(od->celt, 2); if(od->opusError < 0) {log_e("CELT not init"); OPUSDecoder_FreeBuffers(od); return NULL;}
+    od->opusError = celt_decoder_ctl(od->celt, CELT_SET_SIGNALLING_REQUEST,  0); if(od->opusError < 0) {log_e("CELT not init"); OPUSDecoder_FreeBuffers(od); return NULL;}
+    od->opusError = celt_decoder_ctl(od->celt, CELT_SET_END_BAND_REQUEST,   21); if(od->opusError < 0) {log_e("CELT not init"); OPUSDecoder_FreeBuffers(od); return NULL;}
+    OPUSsetDefaults(od);
 
     int32_t ret = 0, silkDecSizeBytes = 0;
     (void) ret;
     (void) silkDecSizeBytes;
-    silk_InitDecoder();
+    silk_InitDecoder(od->silk);
     //ret = silk_Get_Decoder_Size(&silkDecSizeBytes);
     // if (ret){
     //     log_e("internal error");
@@ -93,281 +124,315 @@ bool OPUSDecoder_AllocateBuffers(){
     // else{
     //     log_i("silkDecSizeBytes %i", silkDecSizeBytes);
     // }
-    return true;
+    return od;
 }
-void OPUSDecoder_FreeBuffers(){
-    if(s_opusChbuf)        {free(s_opusChbuf);        s_opusChbuf = NULL;}
-    if(s_opusSegmentTable) {free(s_opusSegmentTable); s_opusSegmentTable = NULL;}
-    s_frameCount = 0;
-    s_opusSegmentLength = 0;
-    s_opusValidSamples = 0;
-    s_opusSegmentTableSize = 0;
-    s_opusOggHeaderSize = 0;
-    s_opusSegmentTableRdPtr = -1;
-    s_opusCountCode = 0;
-    CELTDecoder_FreeBuffers();
+void OPUSDecoder_FreeBuffers(OPUSDecoder_t* od){
+    if(!od) return;
+    if(od->opusChbuf)        {free(od->opusChbuf);        od->opusChbuf = NULL;}
+    if(od->opusSegmentTable) {free(od->opusSegmentTable); od->opusSegmentTable = NULL;}
+    CELTDecoder_FreeBuffers(od->celt);
+    SILKDecoder_FreeBuffers(od->silk);
+    od->~OPUSDecoder_t(); // releases the vector
+    free(od);
 }
-void OPUSDecoder_ClearBuffers(){
-    if(s_opusChbuf)        memset(s_opusChbuf, 0, 512);
-    if(s_opusSegmentTable) memset(s_opusSegmentTable, 0, 256 * sizeof(int16_t));
-    s_frameCount = 0;
-    s_opusSegmentLength = 0;
-    s_opusValidSamples = 0;
-    s_opusSegmentTableSize = 0;
-    s_opusOggHeaderSize = 0;
-    s_opusSegmentTableRdPtr = -1;
-    s_opusCountCode = 0;
+void OPUSDecoder_ClearBuffers(OPUSDecoder_t* od){
+    if(od->opusChbuf)        memset(od->opusChbuf, 0, 512);
+    if(od->opusSegmentTable) memset(od->opusSegmentTable, 0, 256 * sizeof(int16_t));
+    od->frameCount = 0;
+    od->opusSegmentLength = 0;
+    od->opusValidSamples = 0;
+    od->opusSegmentTableSize = 0;
+    od->opusOggHeaderSize = 0;
+    od->opusSegmentTableRdPtr = -1;
+    od->opusCountCode = 0;
+    od->f_opusLastPacketContinues = false;
+    memset(&od->oggCrc, 0, sizeof(oggCrc_t));
 }
-void OPUSsetDefaults(){
-    s_f_opusParseOgg = false;
-    s_f_newSteamTitle = false;  // streamTitle
-    s_f_opusNewMetadataBlockPicture = false;
-    s_f_opusStereoFlag = false;
-    s_opusChannels = 0;
-    s_frameCount = 0;
-    s_mode = 0;
-    s_opusSamplerate = 0;
-    s_internalSampleRate = 0;
-    s_bandWidth = 0;
-    s_opusSegmentLength = 0;
-    s_opusValidSamples = 0;
-    s_opusSegmentTableSize = 0;
-    s_opusOggHeaderSize = 0;
-    s_opusSegmentTableRdPtr = -1;
-    s_opusCountCode = 0;
-    s_opusBlockPicPos = 0;
-    s_opusCurrentFilePos = 0;
-    s_opusAudioDataStart = 0;
-    s_opusBlockPicLen = 0;
-    s_opusCommentBlockSize = 0;
-    s_opusRemainBlockPicLen = 0;
-    s_blockPicLenUntilFrameEnd = 0;
-    s_opusBlockLen = 0;
-    s_opusPageNr = 0;
-    s_opusError = 0;
-    s_endband = 0;
-    s_prev_mode = 0;
-    s_opusBlockPicItem.clear(); s_opusBlockPicItem.shrink_to_fit();
+void OPUSsetDefaults(OPUSDecoder_t* od){
+    od->f_opusParseOgg = false;
+    od->f_newSteamTitle = false;  // streamTitle
+    od->f_opusNewMetadataBlockPicture = false;
+    od->f_opusStereoFlag = false;
+    od->opusChannels = 0;
+    od->frameCount = 0;
+    od->mode = 0;
+    od->opusSamplerate = 0;
+    od->opusPreSkip = 0;
+    od->internalSampleRate = 0;
+    od->bandWidth = 0;
+    od->opusSegmentLength = 0;
+    od->opusValidSamples = 0;
+    od->opusSegmentTableSize = 0;
+    od->opusOggHeaderSize = 0;
+    od->opusSegmentTableRdPtr = -1;
+    od->opusCountCode = 0;
+    od->f_opusLastPacketContinues = false;
+    memset(&od->oggCrc, 0, sizeof(oggCrc_t));
+    od->opusBlockPicPos = 0;
+    od->opusCurrentFilePos = 0;
+    od->opusAudioDataStart = 0;
+    od->opusBlockPicLen = 0;
+    od->opusCommentBlockSize = 0;
+    od->opusRemainBlockPicLen = 0;
+    od->blockPicLenUntilFrameEnd = 0;
+    od->opusBlockLen = 0;
+    od->opusPageNr = 0;
+    od->opusError = 0;
+    od->endband = 0;
+    od->prev_mode = 0;
+    od->opusBlockPicItem.clear(); od->opusBlockPicItem.shrink_to_fit();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t OPUSDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
+int32_t OPUSDecode(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
+    // the CRC of an Ogg page that does not fit into the input window is carried across the calls, see ogg_demuxer.cpp
+    OGGcrcFeed(&od->oggCrc, inbuf, *bytesLeft);
+    int32_t ret = opusDecode(od, inbuf, bytesLeft, outbuf);
+    OGGcrcConsumed(&od->oggCrc, *bytesLeft, ret);
+    return ret;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t opusDecode(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
 
     int32_t ret = ERR_OPUS_NONE;
     int32_t segmLen = 0;
 
-    if(s_opusCommentBlockSize) {
-        if(s_opusCommentBlockSize > 8192) {
-            s_opusRemainBlockPicLen -= 8192;
+    if(od->opusCommentBlockSize) {
+        if(od->opusCommentBlockSize > 8192) {
+            od->opusRemainBlockPicLen -= 8192;
             *bytesLeft -= 8192;
-            s_opusCurrentFilePos += 8192;
-            s_opusCommentBlockSize -= 8192;
+            od->opusCurrentFilePos += 8192;
+            od->opusCommentBlockSize -= 8192;
         }
         else {
-            s_opusRemainBlockPicLen -= s_opusCommentBlockSize;
-            *bytesLeft -= s_opusCommentBlockSize;
-            s_opusCurrentFilePos += s_opusCommentBlockSize;
-            s_opusCommentBlockSize = 0;
+            od->opusRemainBlockPicLen -= od->opusCommentBlockSize;
+            *bytesLeft -= od->opusCommentBlockSize;
+            od->opusCurrentFilePos += od->opusCommentBlockSize;
+            od->opusCommentBlockSize = 0;
         }
-        if(s_opusRemainBlockPicLen <= 0) {
-            if(s_opusBlockPicItem.size() > 0) { // get blockpic data
+        if(od->opusRemainBlockPicLen <= 0) {
+            if(od->opusBlockPicItem.size() > 0) { // get blockpic data
                 // log_i("---------------------------------------------------------------------------");
                 // log_i("metadata blockpic found at pos %i, size %i bytes", s_vorbisBlockPicPos, s_vorbisBlockPicLen);
                 // for(int32_t i = 0; i < s_vorbisBlockPicItem.size(); i += 2) { log_i("segment %02i, pos %07i, len %05i", i / 2, s_vorbisBlockPicItem[i], s_vorbisBlockPicItem[i + 1]); }
                 // log_i("---------------------------------------------------------------------------");
-                s_f_opusNewMetadataBlockPicture = true;
+                od->f_opusNewMetadataBlockPicture = true;
             }
         }
         return OPUS_PARSE_OGG_DONE;
     }
 
-    if(s_frameCount > 0) return opusDecodePage3(inbuf, bytesLeft, segmLen, outbuf); // decode audio, next part
+    if(od->frameCount > 0) return opusDecodePage3(od, inbuf, bytesLeft, segmLen, outbuf); // decode audio, next part
+
+    int32_t rest = OGGcrcBadPageRest(&od->oggCrc);
+    if(rest >= 0){ // the remaining packets of a corrupted page
+        *bytesLeft             -= rest;
+        od->opusCurrentFilePos += rest;
+        od->opusSegmentTableSize = 0;
+        od->opusSegmentTableRdPtr = -1;
+        od->f_opusLastPacketContinues = false;
+        return OPUS_PARSE_OGG_DONE;
+    }
 
-    if(!s_opusSegmentTableSize) {
-        s_f_opusParseOgg = false;
-        s_opusCountCode = 0;
-        ret = OPUSparseOGG(inbuf, bytesLeft);
+    if(!od->opusSegmentTableSize) {
+        od->f_opusParseOgg = false;
+        od->opusCountCode = 0;
+        ret = OPUSparseOGG(od, inbuf, bytesLeft);
         if(ret != ERR_OPUS_NONE) return ret; // error
-        inbuf += s_opusOggHeaderSize;
+        inbuf += od->opusOggHeaderSize;
     }
 
-    if(s_opusSegmentTableSize > 0) {
-        s_opusSegmentTableRdPtr++;
-        s_opusSegmentTableSize--;
-        segmLen = s_opusSegmentTable[s_opusSegmentTableRdPtr];
+    if(od->opusSegmentTableSize > 0) {
+        od->opusSegmentTableRdPtr++;
+        od->opusSegmentTableSize--;
+        segmLen = od->opusSegmentTable[od->opusSegmentTableRdPtr];
+        if(od->opusPageNr == 3){
+            if(od->f_continuedPage && od->opusSegmentTableRdPtr == 0){ // rest of a packet whose first part was dropped
+                *bytesLeft           -= segmLen;
+                od->opusCurrentFilePos += segmLen;
+                ret = OPUS_PARSE_OGG_DONE;
+            }
+            else if(od->f_opusLastPacketContinues && !od->opusSegmentTableSize){
+                ret = opusJoinContinuedPacket(od, &inbuf, bytesLeft, &segmLen);
+            }
+            if(ret != ERR_OPUS_NONE){
+                if(od->opusSegmentTableSize == 0) od->opusSegmentTableRdPtr = -1;
+                return ret;
+            }
+        }
     }
 
-    if(s_opusPageNr == 0) { // OpusHead
-        ret = opusDecodePage0(inbuf, bytesLeft, segmLen);
+    if(od->opusPageNr == 0) { // OpusHead
+        ret = opusDecodePage0(od, inbuf, bytesLeft, segmLen);
     }
-    else if(s_opusPageNr == 1) { // OpusComment
-        ret = parseOpusComment(inbuf, segmLen);
+    else if(od->opusPageNr == 1) { // OpusComment
+        ret = parseOpusComment(od, inbuf, segmLen);
         if(ret == 0) log_e("OpusCommemtPage not found");
-        s_opusRemainBlockPicLen = s_opusBlockPicLen;
-        *bytesLeft -= (segmLen - s_blockPicLenUntilFrameEnd);
-        s_opusCommentBlockSize = s_blockPicLenUntilFrameEnd;
-        s_opusPageNr++;
+        od->opusRemainBlockPicLen = od->opusBlockPicLen;
+        *bytesLeft -= (segmLen - od->blockPicLenUntilFrameEnd);
+        od->opusCommentBlockSize = od->blockPicLenUntilFrameEnd;
+        od->opusPageNr++;
         ret = OPUS_PARSE_OGG_DONE;
     }
-    else if(s_opusPageNr == 2) { // OpusComment Subsequent Pages
-        s_opusCommentBlockSize = segmLen;
-        if(s_opusRemainBlockPicLen <= segmLen) s_opusPageNr++;
+    else if(od->opusPageNr == 2) { // OpusComment Subsequent Pages
+        od->opusCommentBlockSize = segmLen;
+        if(od->opusRemainBlockPicLen <= segmLen) od->opusPageNr++;
         ;
         ret = OPUS_PARSE_OGG_DONE;
     }
-    else if(s_opusPageNr == 3) {
-        ret = opusDecodePage3(inbuf, bytesLeft, segmLen, outbuf); // decode audio
+    else if(od->opusPageNr == 3) {
+        ret = opusDecodePage3(od, inbuf, bytesLeft, segmLen, outbuf); // decode audio
     }
     else { ; }
 
-    if(s_opusSegmentTableSize == 0) {
-        s_opusSegmentTableRdPtr = -1; // back to the parking position
+    if(od->opusSegmentTableSize == 0) {
+        od->opusSegmentTableRdPtr = -1; // back to the parking position
     }
     return ret;
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t opusDecodePage0(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
+int32_t opusDecodePage0(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
     int32_t ret = 0;
-    ret = parseOpusHead(inbuf, segmentLength);
+    ret = parseOpusHead(od, inbuf, segmentLength);
     *bytesLeft           -= segmentLength;
-    s_opusCurrentFilePos += segmentLength;
-    if(ret == 1){ s_opusPageNr++;}
+    od->opusCurrentFilePos += segmentLength;
+    if(ret == 1){ od->opusPageNr++;}
     if(ret == 0){ log_e("OpusHead not found"); }
     if(ret < 0) return ret;
     return OPUS_PARSE_OGG_DONE;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t opusDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t *outbuf){
+int32_t opusDecodePage3(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t *outbuf){
 
-    if(s_opusAudioDataStart == 0){
-        s_opusAudioDataStart = s_opusCurrentFilePos;
+    if(od->opusAudioDataStart == 0){
+        od->opusAudioDataStart = od->opusCurrentFilePos;
     }
 
 
-    s_endband = 21;
-    static int8_t configNr = 0;
-    static uint16_t samplesPerFrame = 0;
+    od->endband = 21;
+    int8_t&   configNr = od->configNr;
+    uint16_t& samplesPerFrame = od->samplesPerFrame;
 
     int32_t ret = 0;
 
-    if(s_frameCount > 0) goto FramePacking; // more than one frame in the packet
+    if(od->frameCount > 0) goto FramePacking; // more than one frame in the packet
 
-    configNr = parseOpusTOC(inbuf[0]);
+    configNr = parseOpusTOC(od, inbuf[0]);
     if(configNr < 0) {log_e("something went wrong");  return configNr;} // SILK or Hybrid mode
 
     switch(configNr){
-        case  0 ... 3:  s_endband  = 0; // OPUS_BANDWIDTH_SILK_NARROWBAND
-                        s_mode = MODE_SILK_ONLY;
-                        s_bandWidth = OPUS_BANDWIDTH_NARROWBAND;
-                        s_internalSampleRate = 8000;
+        case  0 ... 3:  od->endband  = 0; // OPUS_BANDWIDTH_SILK_NARROWBAND
+                        od->mode = MODE_SILK_ONLY;
+                        od->bandWidth = OPUS_BANDWIDTH_NARROWBAND;
+                        od->internalSampleRate = 8000;
                         break;
-        case  4 ... 7:  s_endband  = 0; // OPUS_BANDWIDTH_SILK_MEDIUMBAND
-                        s_mode = MODE_SILK_ONLY;
-                        s_bandWidth = OPUS_BANDWIDTH_MEDIUMBAND;
-                        s_internalSampleRate = 12000;
+        case  4 ... 7:  od->endband  = 0; // OPUS_BANDWIDTH_SILK_MEDIUMBAND
+                        od->mode = MODE_SILK_ONLY;
+                        od->bandWidth = OPUS_BANDWIDTH_MEDIUMBAND;
+                        od->internalSampleRate = 12000;
                         break;
-        case  8 ... 11: s_endband  = 0; // OPUS_BANDWIDTH_SILK_WIDEBAND
-                        s_mode = MODE_SILK_ONLY;
-                        s_bandWidth = OPUS_BANDWIDTH_WIDEBAND;
-                        s_internalSampleRate = 16000;
+        case  8 ... 11: od->endband  = 0; // OPUS_BANDWIDTH_SILK_WIDEBAND
+                        od->mode = MODE_SILK_ONLY;
+                        od->bandWidth = OPUS_BANDWIDTH_WIDEBAND;
+                        od->internalSampleRate = 16000;
                         break;
-        case 12 ... 13: s_endband  = 0; // OPUS_BANDWIDTH_HYBRID_SUPERWIDEBAND
-                        s_mode = MODE_HYBRID;
-                        s_bandWidth = OPUS_BANDWIDTH_SUPERWIDEBAND;
+        case 12 ... 13: od->endband  = 0; // OPUS_BANDWIDTH_HYBRID_SUPERWIDEBAND
+                        od->mode = MODE_HYBRID;
+                        od->bandWidth = OPUS_BANDWIDTH_SUPERWIDEBAND;
                         break;
-        case 14 ... 15: s_endband  = 0; // OPUS_BANDWIDTH_HYBRID_FULLBAND
-                        s_mode = MODE_HYBRID;
-                        s_bandWidth = OPUS_BANDWIDTH_FULLBAND;
+        case 14 ... 15: od->endband  = 0; // OPUS_BANDWIDTH_HYBRID_FULLBAND
+                        od->mode = MODE_HYBRID;
+                        od->bandWidth = OPUS_BANDWIDTH_FULLBAND;
                         break;
-        case 16 ... 19: s_endband = 13; // OPUS_BANDWIDTH_CELT_NARROWBAND
-                        s_mode = MODE_CELT_ONLY;
-                        s_bandWidth = OPUS_BANDWIDTH_NARROWBAND;
+        case 16 ... 19: od->endband = 13; // OPUS_BANDWIDTH_CELT_NARROWBAND
+                        od->mode = MODE_CELT_ONLY;
+                        od->bandWidth = OPUS_BANDWIDTH_NARROWBAND;
                         break;
-        case 20 ... 23: s_endband = 17; // OPUS_BANDWIDTH_CELT_WIDEBAND
-                        s_mode = MODE_CELT_ONLY;
-                        s_bandWidth = OPUS_BANDWIDTH_WIDEBAND;
+        case 20 ... 23: od->endband = 17; // OPUS_BANDWIDTH_CELT_WIDEBAND
+                        od->mode = MODE_CELT_ONLY;
+                        od->bandWidth = OPUS_BANDWIDTH_WIDEBAND;
                         break;
-        case 24 ... 27: s_endband = 19; // OPUS_BANDWIDTH_CELT_SUPERWIDEBAND
-                        s_mode = MODE_CELT_ONLY;
-                        s_bandWidth = OPUS_BANDWIDTH_SUPERWIDEBAND;
+        case 24 ... 27: od->endband = 19; // OPUS_BANDWIDTH_CELT_SUPERWIDEBAND
+                        od->mode = MODE_CELT_ONLY;
+                        od->bandWidth = OPUS_BANDWIDTH_SUPERWIDEBAND;
                         break;
-        case 28 ... 31: s_endband = 21; // OPUS_BANDWIDTH_CELT_FULLBAND
-                        s_mode = MODE_CELT_ONLY;
-                        s_bandWidth = OPUS_BANDWIDTH_FULLBAND;
+        case 28 ... 31: od->endband = 21; // OPUS_BANDWIDTH_CELT_FULLBAND
+                        od->mode = MODE_CELT_ONLY;
+                        od->bandWidth = OPUS_BANDWIDTH_FULLBAND;
                         break;
         default:        log_e("unknown bandwidth, configNr is: %d", configNr);
-                        s_endband = 21; // assume OPUS_BANDWIDTH_FULLBAND
+                        od->endband = 21; // assume OPUS_BANDWIDTH_FULLBAND
                         break;
     }
 
-//    celt_decoder_ctl(CELT_SET_START_BAND_REQUEST, s_endband);
-    if (s_mode == MODE_CELT_ONLY){
-        celt_decoder_ctl(CELT_SET_END_BAND_REQUEST, s_endband);
+//    celt_decoder_ctl(CELT_SET_START_BAND_REQUEST, od->endband);
+    if (od->mode == MODE_CELT_ONLY){
+        celt_decoder_ctl(od->celt, CELT_SET_END_BAND_REQUEST, od->endband);
     }
-    else if(s_mode == MODE_SILK_ONLY){
+    else if(od->mode == MODE_SILK_ONLY){
         // silk_InitDecoder();
     }
 
-    samplesPerFrame = opus_packet_get_samples_per_frame(inbuf, /*s_opusSamplerate*/ 48000);
+    samplesPerFrame = opus_packet_get_samples_per_frame(inbuf, /*od->opusSamplerate*/ 48000);
 
 FramePacking:            // https://www.tech-invite.com/y65/tinv-ietf-rfc-6716-2.html   3.2. Frame Packing
-//log_i("s_opusCountCode %i, configNr %i", s_opusCountCode, configNr);
+//log_i("od->opusCountCode %i, configNr %i", od->opusCountCode, configNr);
 
-    switch(s_opusCountCode){
+    switch(od->opusCountCode){
         case 0:  // Code 0: One Frame in the Packet
-            ret = opus_FramePacking_Code0(inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame);
+            ret = opus_FramePacking_Code0(od, inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame);
             break;
         case 1:  // Code 1: Two Frames in the Packet, Each with Equal Compressed Size
-            ret = opus_FramePacking_Code1(inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame, &s_frameCount);
+            ret = opus_FramePacking_Code1(od, inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame, &od->frameCount);
             break;
         case 2:  // Code 2: Two Frames in the Packet, with Different Compressed Sizes
-            ret = opus_FramePacking_Code2(inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame, &s_frameCount);
+            ret = opus_FramePacking_Code2(od, inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame, &od->frameCount);
             break;
         case 3: // Code 3: A Signaled Number of Frames in the Packet
-            ret = opus_FramePacking_Code3(inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame, &s_frameCount);
+            ret = opus_FramePacking_Code3(od, inbuf, bytesLeft, outbuf, segmentLength, samplesPerFrame, &od->frameCount);
             break;
         default:
-            log_e("unknown countCode %i", s_opusCountCode);
+            log_e("unknown countCode %i", od->opusCountCode);
             break;
     }
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t opus_decode_frame(uint8_t *inbuf, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame) {
+int32_t opus_decode_frame(OPUSDecoder_t* od, uint8_t *inbuf, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame) {
 
     int32_t   ret = 0;
 
-    if (s_mode == MODE_CELT_ONLY){
-        celt_decoder_ctl(CELT_SET_END_BAND_REQUEST, s_endband);
-        ec_dec_init((uint8_t *)inbuf, packetLen);
-        ret = celt_decode_with_ec((int16_t*)outbuf, samplesPerFrame);
+    if (od->mode == MODE_CELT_ONLY){
+        celt_decoder_ctl(od->celt, CELT_SET_END_BAND_REQUEST, od->endband);
+        ec_dec_init(&od->ec, (uint8_t *)inbuf, packetLen);
+        ret = celt_decode_with_ec(od->celt, (int16_t*)outbuf, samplesPerFrame);
     }
 
-    if(s_mode == MODE_SILK_ONLY) {
+    if(od->mode == MODE_SILK_ONLY) {
         int decodedSamples = 0;
         int32_t silk_frame_size;
         uint16_t payloadSize_ms = max(10, 1000 * samplesPerFrame / 48000);
-        if(s_bandWidth == OPUS_BANDWIDTH_NARROWBAND) { s_internalSampleRate = 8000; }
-        else if(s_bandWidth == OPUS_BANDWIDTH_MEDIUMBAND) { s_internalSampleRate = 12000; }
-        else if(s_bandWidth == OPUS_BANDWIDTH_WIDEBAND) { s_internalSampleRate = 16000; }
-        else { s_internalSampleRate = 16000; }
-        ec_dec_init((uint8_t *)inbuf, packetLen);
+        if(od->bandWidth == OPUS_BANDWIDTH_NARROWBAND) { od->internalSampleRate = 8000; }
+        else if(od->bandWidth == OPUS_BANDWIDTH_MEDIUMBAND) { od->internalSampleRate = 12000; }
+        else if(od->bandWidth == OPUS_BANDWIDTH_WIDEBAND) { od->internalSampleRate = 16000; }
+        else { od->internalSampleRate = 16000; }
+        ec_dec_init(&od->ec, (uint8_t *)inbuf, packetLen);
         uint8_t APIchannels = 2;
-        silk_setRawParams(s_opusChannels, APIchannels, payloadSize_ms, s_internalSampleRate, 48000);
+        silk_setRawParams(od->silk, od->opusChannels, APIchannels, payloadSize_ms, od->internalSampleRate, 48000);
         do{
             /* Call SILK decoder */
             int lost_flag = 0;
             int first_frame = decodedSamples == 0;
-            int silk_ret = silk_Decode(lost_flag, first_frame, (int16_t*)outbuf + decodedSamples, &silk_frame_size);
+            int silk_ret = silk_Decode(od->silk, lost_flag, first_frame, (int16_t*)outbuf + decodedSamples, &silk_frame_size);
             if(silk_ret)log_w("silk_ret %i", silk_ret);
             decodedSamples += silk_frame_size;
         } while(decodedSamples < samplesPerFrame);
         ret = decodedSamples;
     }
 
-    if(s_mode == MODE_HYBRID){
+    if(od->mode == MODE_HYBRID){
         log_w("Hybrid mode not yet supported");
         return samplesPerFrame;
         int decodedSamples = 0;
@@ -379,34 +444,34 @@ int32_t opus_decode_frame(uint8_t *inbuf, int16_t *outbuf, int32_t packetLen, ui
         F5 = F10 >> 1;
         F2_5 = F5 >> 1;
         if(packetLen < F2_5) { return ERR_OPUS_BUFFER_TOO_SMALL; }
-        ec_dec_init((uint8_t *)inbuf, packetLen);
-        s_internalSampleRate = 16000;
+        ec_dec_init(&od->ec, (uint8_t *)inbuf, packetLen);
+        od->internalSampleRate = 16000;
         uint8_t APIchannels = 2;
         uint16_t payloadSize_ms = max(10, 1000 * samplesPerFrame / 48000);
         int lost_flag = 0;
         int first_frame = decodedSamples == 0;
-        silk_setRawParams(s_opusChannels, APIchannels, payloadSize_ms, s_internalSampleRate, 48000);
-        silk_Decode(lost_flag, first_frame, (int16_t*)outbuf + decodedSamples, &silk_frame_size);
-        if(s_bandWidth) {
-            s_endband = 21;
-            switch(s_bandWidth) {
-                case OPUS_BANDWIDTH_NARROWBAND: s_endband = 13; break;
+        silk_setRawParams(od->silk, od->opusChannels, APIchannels, payloadSize_ms, od->internalSampleRate, 48000);
+        silk_Decode(od->silk, lost_flag, first_frame, (int16_t*)outbuf + decodedSamples, &silk_frame_size);
+        if(od->bandWidth) {
+            od->endband = 21;
+            switch(od->bandWidth) {
+                case OPUS_BANDWIDTH_NARROWBAND: od->endband = 13; break;
                 case OPUS_BANDWIDTH_MEDIUMBAND:
-                case OPUS_BANDWIDTH_WIDEBAND: s_endband = 17; break;
-                case OPUS_BANDWIDTH_SUPERWIDEBAND: s_endband = 19; break;
-                case OPUS_BANDWIDTH_FULLBAND: s_endband = 21; break;
+                case OPUS_BANDWIDTH_WIDEBAND: od->endband = 17; break;
+                case OPUS_BANDWIDTH_SUPERWIDEBAND: od->endband = 19; break;
+                case OPUS_BANDWIDTH_FULLBAND: od->endband = 21; break;
                 default: break;
             }
         }
         start_band = 17;
-        celt_decoder_ctl(CELT_SET_START_BAND_REQUEST, start_band);
-    //    celt_decoder_ctl(CELT_SET_END_BAND_REQUEST, s_endband);
-        ret = celt_decode_with_ec((int16_t*)outbuf, samplesPerFrame);
+        celt_decoder_ctl(od->celt, CELT_SET_START_BAND_REQUEST, start_band);
+    //    celt_decoder_ctl(CELT_SET_END_BAND_REQUEST, od->endband);
+        ret = celt_decode_with_ec(od->celt, (int16_t*)outbuf, samplesPerFrame);
     }
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int8_t opus_FramePacking_Code0(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame){
+int8_t opus_FramePacking_Code0(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame){
 
 /*  Code 0: One Frame in the Packet
 
@@ -425,20 +490,20 @@ int8_t opus_FramePacking_Code0(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outb
 */
     int32_t ret = 0;
     *bytesLeft -= packetLen;
-    s_opusCurrentFilePos += packetLen;
+    od->opusCurrentFilePos += packetLen;
     packetLen--;
     inbuf++;
-    ret = opus_decode_frame(inbuf, outbuf, packetLen, samplesPerFrame);
+    ret = opus_decode_frame(od, inbuf, outbuf, packetLen, samplesPerFrame);
 // log_w("code 0, ret %i", ret);
     if(ret < 0){
         return ret; // decode err
     }
-    s_opusValidSamples = ret;
+    od->opusValidSamples = ret;
     return ERR_OPUS_NONE;
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int8_t opus_FramePacking_Code1(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount){
+int8_t opus_FramePacking_Code1(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount){
 
 /*  Code 1: Two Frames in the Packet, Each with Equal Compressed Size
 
@@ -460,33 +525,33 @@ int8_t opus_FramePacking_Code1(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outb
      +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 */
     int32_t ret = 0;
-    static uint16_t c1fs = 0;
+    uint16_t& c1fs = od->code1FrameSize;
     if(*frameCount == 0){
         packetLen--;
         inbuf++;
         *bytesLeft -= 1;
-        s_opusCurrentFilePos += 1;
+        od->opusCurrentFilePos += 1;
         c1fs = packetLen / 2;
         // log_w("OPUS countCode 1 len %i, c1fs %i", len, c1fs);
         *frameCount = 2;
     }
     if(*frameCount > 0){
-        ret = opus_decode_frame(inbuf, outbuf, c1fs, samplesPerFrame);
+        ret = opus_decode_frame(od, inbuf, outbuf, c1fs, samplesPerFrame);
         // log_w("code 1, ret %i", ret);
         if(ret < 0){
             *frameCount = 0;
             return ret;  // decode err
         }
-        s_opusValidSamples = ret;
+        od->opusValidSamples = ret;
         *bytesLeft -= c1fs;
-        s_opusCurrentFilePos += c1fs;
+        od->opusCurrentFilePos += c1fs;
     }
     *frameCount -= 1;
     return ERR_OPUS_NONE;
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int8_t opus_FramePacking_Code2(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount){
+int8_t opus_FramePacking_Code2(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount){
 
 /*  Code 2: Two Frames in the Packet, with Different Compressed Sizes
 
@@ -515,8 +580,8 @@ int8_t opus_FramePacking_Code2(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outb
      +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 */
     int32_t ret = 0;
-    static uint16_t firstFrameLength = 0;
-    static uint16_t secondFrameLength = 0;
+    uint16_t& firstFrameLength = od->code2FirstFrameLength;
+    uint16_t& secondFrameLength = od->code2SecondFrameLength;
 
     if(*frameCount == 0){
         uint8_t b1 = inbuf[1];
@@ -525,47 +590,47 @@ int8_t opus_FramePacking_Code2(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outb
             firstFrameLength = b1;
             packetLen -= 2;
             *bytesLeft -= 2;
-            s_opusCurrentFilePos += 2;
+            od->opusCurrentFilePos += 2;
             inbuf += 2;
         }
         else{
             firstFrameLength = b1 + (b2 * 4);
             packetLen -= 3;
             *bytesLeft -= 3;
-            s_opusCurrentFilePos += 3;
+            od->opusCurrentFilePos += 3;
             inbuf += 3;
         }
         secondFrameLength = packetLen - firstFrameLength;
         *frameCount = 2;
     }
     if(*frameCount == 2){
-        ret = opus_decode_frame(inbuf, outbuf, firstFrameLength, samplesPerFrame);
+        ret = opus_decode_frame(od, inbuf, outbuf, firstFrameLength, samplesPerFrame);
         // log_w("code 2, ret %i", ret);
         if(ret < 0){
             *frameCount = 0;
             return ret;  // decode err
         }
-        s_opusValidSamples = ret;
+        od->opusValidSamples = ret;
         *bytesLeft -= firstFrameLength;
-        s_opusCurrentFilePos += firstFrameLength;
+        od->opusCurrentFilePos += firstFrameLength;
     }
     if(*frameCount == 1){
-        ret = opus_decode_frame(inbuf, outbuf, secondFrameLength, samplesPerFrame);
+        ret = opus_decode_frame(od, inbuf, outbuf, secondFrameLength, samplesPerFrame);
         // log_w("code 2, ret %i", ret);
         if(ret < 0){
             *frameCount = 0;
             return ret;  // decode err
         }
-        s_opusValidSamples = ret;
+        od->opusValidSamples = ret;
         *bytesLeft -= secondFrameLength;
-        s_opusCurrentFilePos += secondFrameLength;
+        od->opusCurrentFilePos += secondFrameLength;
     }
     *frameCount -= 1;
     return ERR_OPUS_NONE;
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int8_t opus_FramePacking_Code3(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount){
+int8_t opus_FramePacking_Code3(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount){
 
 /*  Code 3: A Signaled Number of Frames in the Packet
 
@@ -664,13 +729,13 @@ int8_t opus_FramePacking_Code3(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outb
      +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
 */
-    static bool    firstCall = true;
-    static bool    v = false; // VBR indicator
-    static bool    p = false; // padding exists
-    static int16_t fs = 0;    // frame size
-    static uint8_t M = 0;     // nr of frames
-    static int32_t spf = 0;   // static samples per frame
-    static int32_t paddingLength = 0;
+    bool&          firstCall = od->code3FirstCall;
+    bool&          v = od->code3Vbr;       // VBR indicator
+    bool&          p = od->code3Padding;   // padding exists
+    int16_t&       fs = od->code3FrameSize; // frame size
+    uint8_t&       M = od->code3FrameCount; // nr of frames
+    int32_t&       spf = od->code3SamplesPerFrame; // samples per frame
+    int32_t&       paddingLength = od->code3PaddingLength;
     uint32_t       idx = 0;   // includes TOC byte
     int32_t        ret = 0;
     int32_t        remainingBytes = 0;
@@ -678,7 +743,7 @@ int8_t opus_FramePacking_Code3(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outb
 
     if (firstCall) {
         firstCall = false;
-        s_opusCurrentFilePos += packetLen;
+        od->opusCurrentFilePos += packetLen;
         paddingLength = 0;
         idx = 1; // skip TOC byte
         spf = samplesPerFrame;
@@ -723,16 +788,16 @@ int8_t opus_FramePacking_Code3(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outb
         *bytesLeft -= idx;
     }
     if(*frameCount > 0){
-        if(v){ret = opus_decode_frame(inbuf + idx, outbuf, vfs[M - (*frameCount)], spf); *bytesLeft -= vfs[M - (*frameCount)]; /* log_e("code 3, vfs[M - (*frameCount)], spf) %i",  vfs[M - (*frameCount)], spf); */ }
-        else{ ret = opus_decode_frame(inbuf + idx, outbuf, fs, spf); *bytesLeft -= fs; /* log_e("code 3, fs, spf) %i", fs, spf); */ }
+        if(v){ret = opus_decode_frame(od, inbuf + idx, outbuf, vfs[M - (*frameCount)], spf); *bytesLeft -= vfs[M - (*frameCount)]; /* log_e("code 3, vfs[M - (*frameCount)], spf) %i",  vfs[M - (*frameCount)], spf); */ }
+        else{ ret = opus_decode_frame(od, inbuf + idx, outbuf, fs, spf); *bytesLeft -= fs; /* log_e("code 3, fs, spf) %i", fs, spf); */ }
         // log_w("code 3, ret %i", ret);
         *frameCount -= 1;
-        s_opusValidSamples = ret;
+        od->opusValidSamples = ret;
         if(*frameCount > 0) return OPUS_CONTINUE;
     }
     *bytesLeft -= paddingLength;
     *frameCount = 0;
-    s_opusValidSamples = samplesPerFrame;
+    od->opusValidSamples = samplesPerFrame;
     firstCall = true;
     return ERR_OPUS_NONE;
 }
@@ -759,8 +824,8 @@ int32_t opus_packet_get_samples_per_frame(const uint8_t *data, int32_t Fs) {
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-uint8_t OPUSGetChannels(){
-    return s_opusChannels;
+uint8_t OPUSGetChannels(OPUSDecoder_t* od){
+    return od->opusChannels;
 }
 uint32_t OPUSGetSampRate(){
     return 48000;
@@ -768,39 +833,55 @@ uint32_t OPUSGetSampRate(){
 uint8_t OPUSGetBitsPerSample(){
     return 16;
 }
-uint32_t OPUSGetBitRate(){
-    if(s_opusCompressionRatio != 0){
-        return (16 * 2 * 48000) / s_opusCompressionRatio;  //bitsPerSample * channel* SampleRate/CompressionRatio
+uint32_t OPUSGetBitRate(OPUSDecoder_t* od){
+    if(od->opusCompressionRatio != 0){
+        return (16 * 2 * 48000) / od->opusCompressionRatio;  //bitsPerSample * channel* SampleRate/CompressionRatio
     }
     else return 0;
 }
-uint16_t OPUSGetOutputSamps(){
-    return s_opusValidSamples; // 1024
+uint16_t OPUSGetOutputSamps(OPUSDecoder_t* od){
+    return od->opusValidSamples; // 1024
+}
+uint32_t OPUSGetAudioDataStart(OPUSDecoder_t* od){
+    return od->opusAudioDataStart;
 }
-uint32_t OPUSGetAudioDataStart(){
-    return s_opusAudioDataStart;
+uint16_t OPUSGetPreSkip(OPUSDecoder_t* od){
+    return od->opusPreSkip; // samples (48kHz) at the beginning that are not part of the audio
 }
-char* OPUSgetStreamTitle(){
-    if(s_f_newSteamTitle){
-        s_f_newSteamTitle = false;
-        return s_opusChbuf;
+char* OPUSgetStreamTitle(OPUSDecoder_t* od){
+    if(od->f_newSteamTitle){
+        od->f_newSteamTitle = false;
+        return od->opusChbuf;
     }
     return NULL;
 }
-vector<uint32_t> OPUSgetMetadataBlockPicture(){
-    if(s_f_opusNewMetadataBlockPicture){
-        s_f_opusNewMetadataBlockPicture = false;
-        return s_opusBlockPicItem;
+vector<uint32_t> OPUSgetMetadataBlockPicture(OPUSDecoder_t* od){
+    if(od->f_opusNewMetadataBlockPicture){
+        od->f_opusNewMetadataBlockPicture = false;
+        return od->opusBlockPicItem;
     }
-    if(s_opusBlockPicItem.size() > 0){
-        s_opusBlockPicItem.clear();
-        s_opusBlockPicItem.shrink_to_fit();
+    if(od->opusBlockPicItem.size() > 0){
+        od->opusBlockPicItem.clear();
+        od->opusBlockPicItem.shrink_to_fit();
     }
-    return s_opusBlockPicItem;
+    return od->opusBlockPicItem;
+}
+int32_t OPUSrealFFT(const int32_t* in, int32_t* out, uint16_t n){
+    // the CELT FFT as real FFT for other users (spectrum analyzer in Audio), works without an opus stream
+    // n = 480, 240 or 120 samples, out: n / 2 + 1 bins as interleaved re, im, unscaled (gain up to n / 2)
+    int32_t shift;
+    switch(n){
+        case 480: shift = 0; break;
+        case 240: shift = 1; break;
+        case 120: shift = 2; break;
+        default: return -1;
+    }
+    opus_fft_real(in, (kiss_fft_cpx*)out, shift);
+    return n / 2 + 1;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-int8_t parseOpusTOC(uint8_t TOC_Byte){  // https://www.rfc-editor.org/rfc/rfc6716  page 16 ff
+int8_t parseOpusTOC(OPUSDecoder_t* od, uint8_t TOC_Byte){  // https://www.rfc-editor.org/rfc/rfc6716  page 16 ff
 
     uint8_t configNr = 0;
     uint8_t s = 0;              // stereo flag
@@ -832,8 +913,8 @@ int8_t parseOpusTOC(uint8_t TOC_Byte){  // https://www.rfc-editor.org/rfc/rfc671
         c = 2: 2 frames in the packet, with different compressed sizes
         c = 3: an arbitrary number of frames in the packet
     */
-    s_opusCountCode = c;
-    s_f_opusStereoFlag = s;
+    od->opusCountCode = c;
+    od->f_opusStereoFlag = s;
 
     // if(configNr < 12) return ERR_OPUS_SILK_MODE_UNSUPPORTED;
     // if(configNr < 16) return ERR_OPUS_HYBRID_MODE_UNSUPPORTED;
@@ -844,7 +925,7 @@ int8_t parseOpusTOC(uint8_t TOC_Byte){  // https://www.rfc-editor.org/rfc/rfc671
     return configNr;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseOpusComment(uint8_t *inbuf, int32_t nBytes){      // reference https://exiftool.org/TagNames/Vorbis.html#Comments
+int32_t parseOpusComment(OPUSDecoder_t* od, uint8_t *inbuf, int32_t nBytes){      // reference https://exiftool.org/TagNames/Vorbis.html#Comments
                                                        // reference https://www.rfc-editor.org/rfc/rfc7845#section-5
     int32_t idx = OPUS_specialIndexOf(inbuf, "OpusTags", 10);
     if(idx != 0) return 0; // is not OpusTags
@@ -866,7 +947,7 @@ int32_t parseOpusComment(uint8_t *inbuf, int32_t nBytes){      // reference http
              commentListLength += *(inbuf + 0 + pos);
     pos += 4;
     nBytes -= 4;
-    for(int32_t i = 0; i < commentListLength; i++){
+    for(uint32_t i = 0; i < commentListLength; i++){
         uint32_t commentStringLen   = *(inbuf + 3 + pos) << 24;
                  commentStringLen  += *(inbuf + 2 + pos) << 16;
                  commentStringLen  += *(inbuf + 1 + pos) << 8;
@@ -884,33 +965,33 @@ int32_t parseOpusComment(uint8_t *inbuf, int32_t nBytes){      // reference http
         idx = OPUS_specialIndexOf(inbuf + pos, "metadata_block_picture=", 25);
         if(idx == -1) idx = OPUS_specialIndexOf(inbuf + pos, "METADATA_BLOCK_PICTURE=", 25);
         if(idx == 0){
-            s_opusBlockPicLen = commentStringLen - 23;
-            s_opusCurrentFilePos += pos + 23;
-            s_opusBlockPicPos += s_opusCurrentFilePos;
-            s_blockPicLenUntilFrameEnd = nBytes - 23;
-        //  log_i("metadata block picture found at pos %i, length %i", s_opusBlockPicPos, s_opusBlockPicLen);
-            uint32_t pLen = _min(s_blockPicLenUntilFrameEnd, s_opusBlockPicLen);
+            od->opusBlockPicLen = commentStringLen - 23;
+            od->opusCurrentFilePos += pos + 23;
+            od->opusBlockPicPos += od->opusCurrentFilePos;
+            od->blockPicLenUntilFrameEnd = nBytes - 23;
+        //  log_i("metadata block picture found at pos %i, length %i", od->opusBlockPicPos, od->opusBlockPicLen);
+            uint32_t pLen = _min(od->blockPicLenUntilFrameEnd, od->opusBlockPicLen);
             if(pLen){
-                s_opusBlockPicItem.push_back(s_opusBlockPicPos);
-                s_opusBlockPicItem.push_back(pLen);
+                od->opusBlockPicItem.push_back(od->opusBlockPicPos);
+                od->opusBlockPicItem.push_back(pLen);
             }
         }
         pos += commentStringLen;
         nBytes -= commentStringLen;
     }
     if(artist && title){
-        strcpy(s_opusChbuf, artist);
-        strcat(s_opusChbuf, " - ");
-        strcat(s_opusChbuf, title);
-        s_f_newSteamTitle = true;
+        strcpy(od->opusChbuf, artist);
+        strcat(od->opusChbuf, " - ");
+        strcat(od->opusChbuf, title);
+        od->f_newSteamTitle = true;
     }
     else if(artist){
-        strcpy(s_opusChbuf, artist);
-        s_f_newSteamTitle = true;
+        strcpy(od->opusChbuf, artist);
+        od->f_newSteamTitle = true;
     }
     else if(title){
-        strcpy(s_opusChbuf, title);
-        s_f_newSteamTitle = true;
+        strcpy(od->opusChbuf, title);
+        od->f_newSteamTitle = true;
     }
     if(artist){free(artist); artist = NULL;}
     if(title) {free(title);  title = NULL;}
@@ -918,7 +999,7 @@ int32_t parseOpusComment(uint8_t *inbuf, int32_t nBytes){      // reference http
     return 1;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseOpusHead(uint8_t *inbuf, int32_t nBytes){  // reference https://wiki.xiph.org/OggOpus
+int32_t parseOpusHead(OPUSDecoder_t* od, uint8_t *inbuf, int32_t nBytes){  // reference https://wiki.xiph.org/OggOpus
 
 
     int32_t idx = OPUS_specialIndexOf(inbuf, "OpusHead", 10);
@@ -938,113 +1019,110 @@ int32_t parseOpusHead(uint8_t *inbuf, int32_t nBytes){  // reference https://wik
     uint8_t  channelMap         = *(inbuf + 18);
 
     if(channelCount == 0 || channelCount >2) return ERR_OPUS_CHANNELS_OUT_OF_RANGE;
-    s_opusChannels = channelCount;
+    od->opusChannels = channelCount;
 //    log_e("sampleRate %i", sampleRate);
 //    if(sampleRate != 48000 && sampleRate != 44100) return ERR_OPUS_INVALID_SAMPLERATE;
-    s_opusSamplerate = sampleRate;
+    od->opusSamplerate = sampleRate;
+    od->opusPreSkip = preSkip;
     if(channelMap > 1) return ERR_OPUS_EXTRA_CHANNELS_UNSUPPORTED;
 
     (void)outputGain;
 
-    CELTDecoder_ClearBuffer();
-    s_opusError = celt_decoder_init(s_opusChannels); if(s_opusError < 0) {log_e("CELT not init"); return false;}
-    s_opusError = celt_decoder_ctl(CELT_SET_SIGNALLING_REQUEST,  0); if(s_opusError < 0) {log_e("CELT not init"); return false;}
-    s_opusError = celt_decoder_ctl(CELT_SET_END_BAND_REQUEST,   21); if(s_opusError < 0) {log_e("CELT not init"); return false;}
+    CELTDecoder_ClearBuffer(od->celt);
+    od->opusError = celt_decoder_init(od->celt, od->opusChannels); if(od->opusError < 0) {log_e("CELT not init"); return false;}
+    od->opusError = celt_decoder_ctl(od->celt, CELT_SET_SIGNALLING_REQUEST,  0); if(od->opusError < 0) {log_e("CELT not init"); return false;}
+    od->opusError = celt_decoder_ctl(od->celt, CELT_SET_END_BAND_REQUEST,   21); if(od->opusError < 0) {log_e("CELT not init"); return false;}
 
     return 1;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-int32_t OPUSparseOGG(uint8_t *inbuf, int32_t *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
-
-    int32_t idx = OPUS_specialIndexOf(inbuf, "OggS", 6);
-    if(idx != 0) return ERR_OPUS_DECODER_ASYNC;
-
-    int16_t segmentTableWrPtr = -1;
-
-    uint8_t  version            = *(inbuf +  4); (void) version;
-    uint8_t  headerType         = *(inbuf +  5); (void) headerType;
-    uint64_t granulePosition    = (uint64_t)*(inbuf + 13) << 56;  // granule_position: an 8 Byte field containing -
-             granulePosition   += (uint64_t)*(inbuf + 12) << 48;  // position information. For an audio stream, it MAY
-             granulePosition   += (uint64_t)*(inbuf + 11) << 40;  // contain the total number of PCM samples encoded
-             granulePosition   += (uint64_t)*(inbuf + 10) << 32;  // after including all frames finished on this page.
-             granulePosition   += *(inbuf +  9) << 24;  // This is a hint for the decoder and gives it some timing
-             granulePosition   += *(inbuf +  8) << 16;  // and position information. A special value of -1 (in two's
-             granulePosition   += *(inbuf +  7) << 8;   // complement) indicates that no packets finish on this page.
-             granulePosition   += *(inbuf +  6); (void) granulePosition;
-    uint32_t bitstreamSerialNr  = *(inbuf + 17) << 24;  // bitstream_serial_number: a 4 Byte field containing the
-             bitstreamSerialNr += *(inbuf + 16) << 16;  // unique serial number by which the logical bitstream
-             bitstreamSerialNr += *(inbuf + 15) << 8;   // is identified.
-             bitstreamSerialNr += *(inbuf + 14); (void) bitstreamSerialNr;
-    uint32_t pageSequenceNr     = *(inbuf + 21) << 24;  // page_sequence_number: a 4 Byte field containing the sequence
-             pageSequenceNr    += *(inbuf + 20) << 16;  // number of the page so the decoder can identify page loss
-             pageSequenceNr    += *(inbuf + 19) << 8;   // This sequence number is increasing on each logical bitstream
-             pageSequenceNr    += *(inbuf + 18); (void) pageSequenceNr;
-    uint32_t CRCchecksum        = *(inbuf + 25) << 24;
-             CRCchecksum       += *(inbuf + 24) << 16;
-             CRCchecksum       += *(inbuf + 23) << 8;
-             CRCchecksum       += *(inbuf + 22); (void) CRCchecksum;
-    uint8_t  pageSegments       = *(inbuf + 26);        // giving the number of segment entries
-
-    // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
-    // 255: A second byte is needed.  The total length is first_byte + second byte
-    s_opusSegmentLength = 0;
-    segmentTableWrPtr = -1;
-
-    for(int32_t i = 0; i < pageSegments; i++){
-        int32_t n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            if(i == pageSegments) break;
-            n+= *(inbuf + 27 + i);
-        }
-        segmentTableWrPtr++;
-        s_opusSegmentTable[segmentTableWrPtr] = n;
-        s_opusSegmentLength += n;
+int32_t OPUSparseOGG(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
+
+    oggPage_t page;
+    int32_t headerSize = OGGparsePage(inbuf, *bytesLeft, &page, od->opusSegmentTable, &od->oggCrc);
+    if(headerSize == ERR_OGG_CRC){ // the whole page is in the buffer, skip it
+        log_w("Ogg page %u: CRC error, page skipped", page.sequenceNr);
+        *bytesLeft           -= page.headerSize + page.bodySize;
+        od->opusCurrentFilePos += page.headerSize + page.bodySize;
+        od->opusSegmentTableSize = 0;
+        od->f_opusLastPacketContinues = false;
+        return OPUS_PARSE_OGG_DONE;
     }
-    s_opusSegmentTableSize = segmentTableWrPtr + 1;
-    s_opusCompressionRatio = (float)(960 * 2 * pageSegments)/s_opusSegmentLength;  // const 960 validBytes out
+    if(headerSize < 0) return ERR_OPUS_DECODER_ASYNC;
+
+    od->opusSegmentLength    = page.bodySize;
+    od->opusSegmentTableSize = page.packets;
+    od->opusCompressionRatio = (float)(960 * 2 * (page.headerSize - 27))/od->opusSegmentLength;  // const 960 validBytes out
+
+    od->f_continuedPage = OGGisContinuedPage(&page); // set: page contains data of a packet continued from the previous page
+    od->f_firstPage     = OGGisFirstPage(&page);     // set: this is the first page of a logical bitstream (bos)
+    od->f_lastPage      = OGGisLastPage(&page);      // set: this is the last page of a logical bitstream (eos)
+    od->f_opusLastPacketContinues = page.lastPacketContinues;
 
-    s_f_continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
-    s_f_firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
-    s_f_lastPage      = headerType & 0x04; // set: this is the last page of a logical bitstream (eos)
+//  log_i("firstPage %i, continuedPage %i, lastPage %i",od->f_firstPage, od->f_continuedPage, od->f_lastPage);
 
-//  log_i("firstPage %i, continuedPage %i, lastPage %i",s_f_firstPage, s_f_continuedPage, s_f_lastPage);
+    if(od->f_firstPage) od->opusPageNr = 0; // chained stream, a new OpusHead follows
 
-    uint16_t headerSize   = pageSegments + 27;
     *bytesLeft           -= headerSize;
-    s_opusCurrentFilePos += headerSize;
-    s_opusOggHeaderSize   = headerSize;
-
-    int32_t pLen = _min((int32_t)s_opusSegmentLength, s_opusRemainBlockPicLen);
-//  log_i("s_opusSegmentLength %i, s_opusRemainBlockPicLen %i", s_opusSegmentLength, s_opusRemainBlockPicLen);
-    if(s_opusBlockPicLen && pLen > 0){
-        s_opusBlockPicItem.push_back(s_opusCurrentFilePos);
-        s_opusBlockPicItem.push_back(pLen);
+    od->opusCurrentFilePos += headerSize;
+    od->opusOggHeaderSize   = headerSize;
+
+    int32_t pLen = _min((int32_t)od->opusSegmentLength, od->opusRemainBlockPicLen);
+//  log_i("od->opusSegmentLength %i, od->opusRemainBlockPicLen %i", od->opusSegmentLength, od->opusRemainBlockPicLen);
+    if(od->opusBlockPicLen && pLen > 0){
+        od->opusBlockPicItem.push_back(od->opusCurrentFilePos);
+        od->opusBlockPicItem.push_back(pLen);
+    }
+    return ERR_OPUS_NONE;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t opusJoinContinuedPacket(OPUSDecoder_t* od, uint8_t** inbuf, int32_t* bytesLeft, int32_t* segmLen){
+    // the last packet of the page continues on the next one, join both parts in place if the next page is in the buffer
+    oggPage_t page;
+    uint8_t* packet = OGGjoinContinuedPacket(*inbuf, *segmLen, *bytesLeft, &page, od->opusSegmentTable, &od->oggCrc);
+    if(!packet){ // not joinable, drop the first part, the rest is dropped with the next page
+        *bytesLeft           -= *segmLen;
+        od->opusCurrentFilePos += *segmLen;
+        od->f_opusLastPacketContinues = false;
+        return OPUS_PARSE_OGG_DONE;
     }
+    *bytesLeft           -= page.headerSize; // the gap in front of the joined packet
+    od->opusCurrentFilePos += page.headerSize;
+    *segmLen             += od->opusSegmentTable[0];
+    *inbuf                = packet;
+
+    od->opusSegmentTableRdPtr = 0; // continue with the remaining packets of the next page
+    od->opusSegmentTableSize  = page.packets - 1;
+    od->opusSegmentLength     = page.bodySize;
+    od->f_continuedPage       = false;
+    od->f_firstPage           = OGGisFirstPage(&page);
+    od->f_lastPage            = OGGisLastPage(&page);
+    od->f_opusLastPacketContinues = page.lastPacketContinues;
     return ERR_OPUS_NONE;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-int32_t OPUSFindSyncWord(unsigned char *buf, int32_t nBytes){
+int32_t OPUSFindSyncWord(OPUSDecoder_t* od, unsigned char *buf, int32_t nBytes){
     // assume we have a ogg wrapper
-    int32_t idx = OPUS_specialIndexOf(buf, "OggS", nBytes);
+    int32_t idx = OGGfindSyncWord(buf, nBytes);
     if(idx >= 0){ // Magic Word found
     //    log_i("OggS found at %i", idx);
-        s_f_opusParseOgg = true;
+        od->f_opusParseOgg = true;
         return idx;
     }
     log_i("find sync");
-    s_f_opusParseOgg = false;
+    od->f_opusParseOgg = false;
     return ERR_OPUS_OGG_SYNC_NOT_FOUND;
 }
 //----------------------------------------------------------------------------------------------------------------------
 int32_t OPUS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact){
     int32_t result = -1;  // seek for str in buffer or in header up to baselen, not nullterninated
-    if (strlen(str) > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
-    for (int32_t i = 0; i < baselen - strlen(str); i++){
+    int32_t len = strlen(str);
+    if (len > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
+    for (int32_t i = 0; i < baselen - len; i++){
         result = i;
-        for (int32_t j = 0; j < strlen(str) + exact; j++){
+        for (int32_t j = 0; j < len + exact; j++){
             if (*(base + i + j) != *(str + j)){
                 result = -1;
                 break;
@@ -34,30 +34,36 @@ enum : int8_t  {OPUS_CONTINUE = 110,
                 ERR_OPUS_CELT_START_BAND = -27,
                 ERR_CELT_OPUS_INTERNAL_ERROR = -28};
 
-bool             OPUSDecoder_AllocateBuffers();
-void             OPUSDecoder_FreeBuffers();
-void             OPUSDecoder_ClearBuffers();
-void             OPUSsetDefaults();
-int32_t          OPUSDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-int32_t          opusDecodePage0(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t          opusDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t *outbuf);
-int8_t           opus_FramePacking_Code0(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame);
-int8_t           opus_FramePacking_Code1(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
-int8_t           opus_FramePacking_Code2(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
-int8_t           opus_FramePacking_Code3(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
-uint8_t          OPUSGetChannels();
+typedef struct OPUSDecoder_t OPUSDecoder_t; // complete state of one decoder instance, see OPUSDecoder_AllocateBuffers()
+
+OPUSDecoder_t*   OPUSDecoder_AllocateBuffers();
+void             OPUSDecoder_FreeBuffers(OPUSDecoder_t* od);
+void             OPUSDecoder_ClearBuffers(OPUSDecoder_t* od);
+void             OPUSsetDefaults(OPUSDecoder_t* od);
+int32_t          OPUSDecode(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+int32_t          opusDecode(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+int32_t          opusDecodePage0(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+int32_t          opusDecodePage3(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t *outbuf);
+int8_t           opus_FramePacking_Code0(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame);
+int8_t           opus_FramePacking_Code1(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
+int8_t           opus_FramePacking_Code2(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
+int8_t           opus_FramePacking_Code3(OPUSDecoder_t* od, uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
+uint8_t          OPUSGetChannels(OPUSDecoder_t* od);
 uint32_t         OPUSGetSampRate();
 uint8_t          OPUSGetBitsPerSample();
-uint32_t         OPUSGetBitRate();
-uint16_t         OPUSGetOutputSamps();
-uint32_t         OPUSGetAudioDataStart();
-char*            OPUSgetStreamTitle();
-vector<uint32_t> OPUSgetMetadataBlockPicture();
-int32_t          OPUSFindSyncWord(unsigned char* buf, int32_t nBytes);
-int32_t          OPUSparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
-int32_t          parseOpusHead(uint8_t* inbuf, int32_t nBytes);
-int32_t          parseOpusComment(uint8_t* inbuf, int32_t nBytes);
-int8_t           parseOpusTOC(uint8_t TOC_Byte);
+uint32_t         OPUSGetBitRate(OPUSDecoder_t* od);
+uint16_t         OPUSGetOutputSamps(OPUSDecoder_t* od);
+uint32_t         OPUSGetAudioDataStart(OPUSDecoder_t* od);
+uint16_t         OPUSGetPreSkip(OPUSDecoder_t* od);
+char*            OPUSgetStreamTitle(OPUSDecoder_t* od);
+vector<uint32_t> OPUSgetMetadataBlockPicture(OPUSDecoder_t* od);
+int32_t          OPUSrealFFT(const int32_t* in, int32_t* out, uint16_t n);
+int32_t          OPUSFindSyncWord(OPUSDecoder_t* od, unsigned char* buf, int32_t nBytes);
+int32_t          OPUSparseOGG(OPUSDecoder_t* od, uint8_t* inbuf, int32_t* bytesLeft);
+int32_t          opusJoinContinuedPacket(OPUSDecoder_t* od, uint8_t** inbuf, int32_t* bytesLeft, int32_t* segmLen);
+int32_t          parseOpusHead(OPUSDecoder_t* od, uint8_t* inbuf, int32_t nBytes);
+int32_t          parseOpusComment(OPUSDecoder_t* od, uint8_t* inbuf, int32_t nBytes);
+int8_t           parseOpusTOC(OPUSDecoder_t* od, uint8_t TOC_Byte);
 int32_t          opus_packet_get_samples_per_frame(const uint8_t* data, int32_t Fs);
 
 // some helper functions
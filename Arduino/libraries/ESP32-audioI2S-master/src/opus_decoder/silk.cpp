@@ -21,17 +21,6 @@ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
     heap_caps_calloc_prefer(ch, size, 2, MALLOC_CAP_DEFAULT | MALLOC_CAP_SPIRAM, MALLOC_CAP_DEFAULT | MALLOC_CAP_INTERNAL)
 
 
-silk_decoder_state s_channel_state[2];
-silk_decoder       s_decState;
-extern ec_ctx_t    s_ec;
-
-uint8_t  s_channelsInternal = 0;
-uint8_t  s_payloadSize_ms = 0;
-uint8_t  s_API_channels = 0;
-uint32_t s_silk_internalSampleRate = 0;
-uint32_t s_API_sampleRate = 0;
-uint32_t s_prevPitchLag = 0;
-
 /* Coefficients for 2-band filter bank based on first-order allpass filters */
 int16_t A_fb1_20 = 5394 << 1;
 int16_t A_fb1_21 = -24290; /* (int16_t)(20623 << 1) */
@@ -772,17 +761,17 @@ void silk_bwexpander(int16_t*      ar,       /* I/O  AR filter to be expanded (w
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode mid/side predictors */
-void silk_stereo_decode_pred(int32_t pred_Q13[]) {
+void silk_stereo_decode_pred(SILKDecoder_t* sd, int32_t pred_Q13[]) {
     int32_t n, ix[2][3];
     int32_t low_Q13, step_Q13;
 
     /* Entropy decoding */
-    n = ec_dec_icdf(silk_stereo_pred_joint_iCDF, 8);
+    n = ec_dec_icdf(sd->ec, silk_stereo_pred_joint_iCDF, 8);
     ix[0][2] = silk_DIV32_16(n, 5);
     ix[1][2] = n - 5 * ix[0][2];
     for (n = 0; n < 2; n++) {
-        ix[n][0] = ec_dec_icdf(silk_uniform3_iCDF, 8);
-        ix[n][1] = ec_dec_icdf(silk_uniform5_iCDF, 8);
+        ix[n][0] = ec_dec_icdf(sd->ec, silk_uniform3_iCDF, 8);
+        ix[n][1] = ec_dec_icdf(sd->ec, silk_uniform5_iCDF, 8);
     }
 
     /* Dequantize */
@@ -798,10 +787,10 @@ void silk_stereo_decode_pred(int32_t pred_Q13[]) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode mid-only flag */
-void silk_stereo_decode_mid_only(int32_t* decode_only_mid /* O    Flag that only mid channel has been coded   */
+void silk_stereo_decode_mid_only(SILKDecoder_t* sd, int32_t* decode_only_mid /* O    Flag that only mid channel has been coded   */
 ) {
     /* Decode flag that only mid channel is coded */
-    *decode_only_mid = ec_dec_icdf(silk_stereo_only_code_mid_iCDF, 8);
+    *decode_only_mid = ec_dec_icdf(sd->ec, silk_stereo_only_code_mid_iCDF, 8);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* helper function for NLSF2A(intermediate polynomial, Q[dd+1], vector of interleaved 2*cos(LSFs), QA_[d], polynomial order (= 1/2 * filter order)  ) */
@@ -891,7 +880,7 @@ void silk_NLSF2A(int16_t* a_Q12, const int16_t* NLSF, const int32_t d) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode side-information parameters from payload (State, Compressor data structure, Frame number, Flag indicating LBRR data is being decoded, The type of conditional coding to use) */
-void silk_decode_indices(silk_decoder_state* psDec, int32_t FrameIndex, int32_t decode_LBRR, int32_t condCoding) {
+void silk_decode_indices(SILKDecoder_t* sd, silk_decoder_state* psDec, int32_t FrameIndex, int32_t decode_LBRR, int32_t condCoding) {
     int32_t i, k, Ix;
     int32_t decode_absolute_lagIndex, delta_lagIndex;
     int16_t ec_ix[MAX_LPC_ORDER];
@@ -901,9 +890,9 @@ void silk_decode_indices(silk_decoder_state* psDec, int32_t FrameIndex, int32_t
     /* Decode signal type and quantizer offset */
     /*******************************************/
     if (decode_LBRR || psDec->VAD_flags[FrameIndex]) {
-        Ix = ec_dec_icdf(silk_type_offset_VAD_iCDF, 8) + 2;
+        Ix = ec_dec_icdf(sd->ec, silk_type_offset_VAD_iCDF, 8) + 2;
     } else {
-        Ix = ec_dec_icdf(silk_type_offset_no_VAD_iCDF, 8);
+        Ix = ec_dec_icdf(sd->ec, silk_type_offset_no_VAD_iCDF, 8);
     }
     psDec->indices.signalType = (int8_t)silk_RSHIFT(Ix, 1);
     psDec->indices.quantOffsetType = (int8_t)(Ix & 1);
@@ -914,35 +903,35 @@ void silk_decode_indices(silk_decoder_state* psDec, int32_t FrameIndex, int32_t
     /* First subframe */
     if (condCoding == CODE_CONDITIONALLY) {
         /* Conditional coding */
-        psDec->indices.GainsIndices[0] = (int8_t)ec_dec_icdf(silk_delta_gain_iCDF, 8);
+        psDec->indices.GainsIndices[0] = (int8_t)ec_dec_icdf(sd->ec, silk_delta_gain_iCDF, 8);
     } else {
         /* Independent coding, in two stages: MSB bits followed by 3 LSBs */
-        psDec->indices.GainsIndices[0] = (int8_t)silk_LSHIFT(ec_dec_icdf(silk_gain_iCDF[psDec->indices.signalType], 8), 3);
-        psDec->indices.GainsIndices[0] += (int8_t)ec_dec_icdf(silk_uniform8_iCDF, 8);
+        psDec->indices.GainsIndices[0] = (int8_t)silk_LSHIFT(ec_dec_icdf(sd->ec, silk_gain_iCDF[psDec->indices.signalType], 8), 3);
+        psDec->indices.GainsIndices[0] += (int8_t)ec_dec_icdf(sd->ec, silk_uniform8_iCDF, 8);
     }
 
     /* Remaining subframes */
-    for (i = 1; i < psDec->nb_subfr; i++) { psDec->indices.GainsIndices[i] = (int8_t)ec_dec_icdf(silk_delta_gain_iCDF, 8); }
+    for (i = 1; i < psDec->nb_subfr; i++) { psDec->indices.GainsIndices[i] = (int8_t)ec_dec_icdf(sd->ec, silk_delta_gain_iCDF, 8); }
 
     /**********************/
     /* Decode LSF Indices */
     /**********************/
-    psDec->indices.NLSFIndices[0] = (int8_t)ec_dec_icdf(&psDec->psNLSF_CB->CB1_iCDF[(psDec->indices.signalType >> 1) * psDec->psNLSF_CB->nVectors], 8);
+    psDec->indices.NLSFIndices[0] = (int8_t)ec_dec_icdf(sd->ec, &psDec->psNLSF_CB->CB1_iCDF[(psDec->indices.signalType >> 1) * psDec->psNLSF_CB->nVectors], 8);
     silk_NLSF_unpack(ec_ix, pred_Q8, psDec->psNLSF_CB, psDec->indices.NLSFIndices[0]);
     assert(psDec->psNLSF_CB->order == psDec->LPC_order);
     for (i = 0; i < psDec->psNLSF_CB->order; i++) {
-        Ix = ec_dec_icdf(&psDec->psNLSF_CB->ec_iCDF[ec_ix[i]], 8);
+        Ix = ec_dec_icdf(sd->ec, &psDec->psNLSF_CB->ec_iCDF[ec_ix[i]], 8);
         if (Ix == 0) {
-            Ix -= ec_dec_icdf(silk_NLSF_EXT_iCDF, 8);
+            Ix -= ec_dec_icdf(sd->ec, silk_NLSF_EXT_iCDF, 8);
         } else if (Ix == 2 * NLSF_QUANT_MAX_AMPLITUDE) {
-            Ix += ec_dec_icdf(silk_NLSF_EXT_iCDF, 8);
+            Ix += ec_dec_icdf(sd->ec, silk_NLSF_EXT_iCDF, 8);
         }
         psDec->indices.NLSFIndices[i + 1] = (int8_t)(Ix - NLSF_QUANT_MAX_AMPLITUDE);
     }
 
     /* Decode LSF interpolation factor */
     if (psDec->nb_subfr == MAX_NB_SUBFR) {
-        psDec->indices.NLSFInterpCoef_Q2 = (int8_t)ec_dec_icdf(silk_NLSF_interpolation_factor_iCDF, 8);
+        psDec->indices.NLSFInterpCoef_Q2 = (int8_t)ec_dec_icdf(sd->ec, silk_NLSF_interpolation_factor_iCDF, 8);
     } else {
         psDec->indices.NLSFInterpCoef_Q2 = 4;
     }
@@ -955,7 +944,7 @@ void silk_decode_indices(silk_decoder_state* psDec, int32_t FrameIndex, int32_t
         decode_absolute_lagIndex = 1;
         if (condCoding == CODE_CONDITIONALLY && psDec->ec_prevSignalType == TYPE_VOICED) {
             /* Decode Delta index */
-            delta_lagIndex = (int16_t)ec_dec_icdf(silk_pitch_delta_iCDF, 8);
+            delta_lagIndex = (int16_t)ec_dec_icdf(sd->ec, silk_pitch_delta_iCDF, 8);
             if (delta_lagIndex > 0) {
                 delta_lagIndex = delta_lagIndex - 9;
                 psDec->indices.lagIndex = (int16_t)(psDec->ec_prevLagIndex + delta_lagIndex);
@@ -964,27 +953,27 @@ void silk_decode_indices(silk_decoder_state* psDec, int32_t FrameIndex, int32_t
         }
         if (decode_absolute_lagIndex) {
             /* Absolute decoding */
-            psDec->indices.lagIndex = (int16_t)ec_dec_icdf(silk_pitch_lag_iCDF, 8) * silk_RSHIFT(psDec->fs_kHz, 1);
-            psDec->indices.lagIndex += (int16_t)ec_dec_icdf(psDec->pitch_lag_low_bits_iCDF, 8);
+            psDec->indices.lagIndex = (int16_t)ec_dec_icdf(sd->ec, silk_pitch_lag_iCDF, 8) * silk_RSHIFT(psDec->fs_kHz, 1);
+            psDec->indices.lagIndex += (int16_t)ec_dec_icdf(sd->ec, psDec->pitch_lag_low_bits_iCDF, 8);
         }
         psDec->ec_prevLagIndex = psDec->indices.lagIndex;
 
         /* Get countour index */
-        psDec->indices.contourIndex = (int8_t)ec_dec_icdf(psDec->pitch_contour_iCDF, 8);
+        psDec->indices.contourIndex = (int8_t)ec_dec_icdf(sd->ec, psDec->pitch_contour_iCDF, 8);
 
         /********************/
         /* Decode LTP gains */
         /********************/
         /* Decode PERIndex value */
-        psDec->indices.PERIndex = (int8_t)ec_dec_icdf(silk_LTP_per_index_iCDF, 8);
+        psDec->indices.PERIndex = (int8_t)ec_dec_icdf(sd->ec, silk_LTP_per_index_iCDF, 8);
 
-        for (k = 0; k < psDec->nb_subfr; k++) { psDec->indices.LTPIndex[k] = (int8_t)ec_dec_icdf(silk_LTP_gain_iCDF_ptrs[psDec->indices.PERIndex], 8); }
+        for (k = 0; k < psDec->nb_subfr; k++) { psDec->indices.LTPIndex[k] = (int8_t)ec_dec_icdf(sd->ec, silk_LTP_gain_iCDF_ptrs[psDec->indices.PERIndex], 8); }
 
         /**********************/
         /* Decode LTP scaling */
         /**********************/
         if (condCoding == CODE_INDEPENDENTLY) {
-            psDec->indices.LTP_scaleIndex = (int8_t)ec_dec_icdf(silk_LTPscale_iCDF, 8);
+            psDec->indices.LTP_scaleIndex = (int8_t)ec_dec_icdf(sd->ec, silk_LTPscale_iCDF, 8);
         } else {
             psDec->indices.LTP_scaleIndex = 0;
         }
@@ -994,7 +983,7 @@ void silk_decode_indices(silk_decoder_state* psDec, int32_t FrameIndex, int32_t
     /***************/
     /* Decode seed */
     /***************/
-    psDec->indices.Seed = (int8_t)ec_dec_icdf(silk_uniform4_iCDF, 8);
+    psDec->indices.Seed = (int8_t)ec_dec_icdf(sd->ec, silk_uniform4_iCDF, 8);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -1069,7 +1058,7 @@ void silk_decode_parameters(silk_decoder_state*   psDec,     /* I/O  State
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode quantization indices of excitation (Compressor data structure, Excitation signal, Sigtype, quantOffsetType, Frame length)*/
-void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_t quantOffsetType, const int32_t frame_length) {
+void silk_decode_pulses(SILKDecoder_t* sd, int16_t pulses[], const int32_t signalType, const int32_t quantOffsetType, const int32_t frame_length) {
     int32_t        i, j, k, iter, abs_q, nLS, RateLevelIndex;
     int32_t        sum_pulses[MAX_NB_SHELL_BLOCKS], nLshifts[MAX_NB_SHELL_BLOCKS];
     int16_t*       pulses_ptr;
@@ -1078,7 +1067,7 @@ void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_
     /*********************/
     /* Decode rate level */
     /*********************/
-    RateLevelIndex = ec_dec_icdf(silk_rate_levels_iCDF[signalType >> 1], 8);
+    RateLevelIndex = ec_dec_icdf(sd->ec, silk_rate_levels_iCDF[signalType >> 1], 8);
 
     /* Calculate number of shell blocks */
     assert(1 << LOG2_SHELL_CODEC_FRAME_LENGTH == SHELL_CODEC_FRAME_LENGTH);
@@ -1094,13 +1083,13 @@ void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_
     cdf_ptr = silk_pulses_per_block_iCDF[RateLevelIndex];
     for (i = 0; i < iter; i++) {
         nLshifts[i] = 0;
-        sum_pulses[i] = ec_dec_icdf(cdf_ptr, 8);
+        sum_pulses[i] = ec_dec_icdf(sd->ec, cdf_ptr, 8);
 
         /* LSB indication */
         while (sum_pulses[i] == SILK_MAX_PULSES + 1) {
             nLshifts[i]++;
             /* When we've already got 10 LSBs, we shift the table to not allow (SILK_MAX_PULSES + 1) */
-            sum_pulses[i] = ec_dec_icdf(silk_pulses_per_block_iCDF[N_RATE_LEVELS - 1] + (nLshifts[i] == 10), 8);
+            sum_pulses[i] = ec_dec_icdf(sd->ec, silk_pulses_per_block_iCDF[N_RATE_LEVELS - 1] + (nLshifts[i] == 10), 8);
         }
     }
 
@@ -1109,7 +1098,7 @@ void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_
     /***************************************************/
     for (i = 0; i < iter; i++) {
         if (sum_pulses[i] > 0) {
-            silk_shell_decoder(&pulses[silk_SMULBB(i, SHELL_CODEC_FRAME_LENGTH)], sum_pulses[i]);
+            silk_shell_decoder(sd, &pulses[silk_SMULBB(i, SHELL_CODEC_FRAME_LENGTH)], sum_pulses[i]);
         } else {
             memset(&pulses[silk_SMULBB(i, SHELL_CODEC_FRAME_LENGTH)], 0, SHELL_CODEC_FRAME_LENGTH * sizeof(pulses[0]));
         }
@@ -1126,7 +1115,7 @@ void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_
                 abs_q = pulses_ptr[k];
                 for (j = 0; j < nLS; j++) {
                     abs_q = silk_LSHIFT(abs_q, 1);
-                    abs_q += ec_dec_icdf(silk_lsb_iCDF, 8);
+                    abs_q += ec_dec_icdf(sd->ec, silk_lsb_iCDF, 8);
                 }
                 pulses_ptr[k] = abs_q;
             }
@@ -1138,7 +1127,7 @@ void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_
     /****************************************/
     /* Decode and add signs to pulse signal */
     /****************************************/
-    silk_decode_signs(pulses, frame_length, signalType, quantOffsetType, sum_pulses);
+    silk_decode_signs(sd, pulses, frame_length, signalType, quantOffsetType, sum_pulses);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Set decoder sampling rate (Decoder state pointer , Sampling frequency (kHz) , API Sampling frequency (Hz))*/
@@ -1319,13 +1308,13 @@ void silk_quant_LTP_gains(int16_t       B_Q14[MAX_NB_SUBFR * LTP_ORDER],
     *pred_gain_dB_Q7 = (int32_t)silk_SMULBB(-3, silk_lin2log(res_nrg_Q15) - (15 << 7));
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-static inline void decode_split(int16_t*       p_child1,   /* O    pulse amplitude of first child subframe     */
+static inline void decode_split(SILKDecoder_t* sd, int16_t*       p_child1,   /* O    pulse amplitude of first child subframe     */
                                 int16_t*       p_child2,   /* O    pulse amplitude of second child subframe    */
                                 const int32_t  p,          /* I    pulse amplitude of current subframe         */
                                 const uint8_t* shell_table /* I    table of shell cdfs                         */
 ) {
     if (p > 0) {
-        p_child1[0] = ec_dec_icdf(&shell_table[silk_shell_code_table_offsets[p]], 8);
+        p_child1[0] = ec_dec_icdf(sd->ec, &shell_table[silk_shell_code_table_offsets[p]], 8);
         p_child2[0] = p - p_child1[0];
     } else {
         p_child1[0] = 0;
@@ -1334,28 +1323,28 @@ static inline void decode_split(int16_t*       p_child1,   /* O    pulse amplitu
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Shell decoder, operates on one shell code frame of 16 pulses */
-void silk_shell_decoder(int16_t*      pulses0, /* O    data: nonnegative pulse amplitudes          */
+void silk_shell_decoder(SILKDecoder_t* sd, int16_t*      pulses0, /* O    data: nonnegative pulse amplitudes          */
                         const int32_t pulses4  /* I    number of pulses per pulse-subframe         */
 ) {
     int16_t pulses3[2], pulses2[4], pulses1[8];
 
     /* this function operates on one shell code frame of 16 pulses */
     assert(SHELL_CODEC_FRAME_LENGTH == 16);
-    decode_split(&pulses3[0], &pulses3[1], pulses4, silk_shell_code_table3);
-    decode_split(&pulses2[0], &pulses2[1], pulses3[0], silk_shell_code_table2);
-    decode_split(&pulses1[0], &pulses1[1], pulses2[0], silk_shell_code_table1);
-    decode_split(&pulses0[0], &pulses0[1], pulses1[0], silk_shell_code_table0);
-    decode_split(&pulses0[2], &pulses0[3], pulses1[1], silk_shell_code_table0);
-    decode_split(&pulses1[2], &pulses1[3], pulses2[1], silk_shell_code_table1);
-    decode_split(&pulses0[4], &pulses0[5], pulses1[2], silk_shell_code_table0);
-    decode_split(&pulses0[6], &pulses0[7], pulses1[3], silk_shell_code_table0);
-    decode_split(&pulses2[2], &pulses2[3], pulses3[1], silk_shell_code_table2);
-    decode_split(&pulses1[4], &pulses1[5], pulses2[2], silk_shell_code_table1);
-    decode_split(&pulses0[8], &pulses0[9], pulses1[4], silk_shell_code_table0);
-    decode_split(&pulses0[10], &pulses0[11], pulses1[5], silk_shell_code_table0);
-    decode_split(&pulses1[6], &pulses1[7], pulses2[3], silk_shell_code_table1);
-    decode_split(&pulses0[12], &pulses0[13], pulses1[6], silk_shell_code_table0);
-    decode_split(&pulses0[14], &pulses0[15], pulses1[7], silk_shell_code_table0);
+    decode_split(sd, &pulses3[0], &pulses3[1], pulses4, silk_shell_code_table3);
+    decode_split(sd, &pulses2[0], &pulses2[1], pulses3[0], silk_shell_code_table2);
+    decode_split(sd, &pulses1[0], &pulses1[1], pulses2[0], silk_shell_code_table1);
+    decode_split(sd, &pulses0[0], &pulses0[1], pulses1[0], silk_shell_code_table0);
+    decode_split(sd, &pulses0[2], &pulses0[3], pulses1[1], silk_shell_code_table0);
+    decode_split(sd, &pulses1[2], &pulses1[3], pulses2[1], silk_shell_code_table1);
+    decode_split(sd, &pulses0[4], &pulses0[5], pulses1[2], silk_shell_code_table0);
+    decode_split(sd, &pulses0[6], &pulses0[7], pulses1[3], silk_shell_code_table0);
+    decode_split(sd, &pulses2[2], &pulses2[3], pulses3[1], silk_shell_code_table2);
+    decode_split(sd, &pulses1[4], &pulses1[5], pulses2[2], silk_shell_code_table1);
+    decode_split(sd, &pulses0[8], &pulses0[9], pulses1[4], silk_shell_code_table0);
+    decode_split(sd, &pulses0[10], &pulses0[11], pulses1[5], silk_shell_code_table0);
+    decode_split(sd, &pulses1[6], &pulses1[7], pulses2[3], silk_shell_code_table1);
+    decode_split(sd, &pulses0[12], &pulses0[13], pulses1[6], silk_shell_code_table0);
+    decode_split(sd, &pulses0[14], &pulses0[15], pulses1[7], silk_shell_code_table0);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Quantize mid/side predictors */
@@ -1609,7 +1598,7 @@ void silk_CNG(silk_decoder_state*   psDec,     /* I/O  Decoder state
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Decodes signs of excitation */
-void silk_decode_signs(int16_t       pulses[],                       /* I/O  pulse signal                                */
+void silk_decode_signs(SILKDecoder_t* sd, int16_t       pulses[],                       /* I/O  pulse signal                                */
                        int32_t       length,                         /* I    length of input                             */
                        const int32_t signalType,                     /* I    Signal type                                 */
                        const int32_t quantOffsetType,                /* I    Quantization offset type                    */
@@ -1633,7 +1622,7 @@ void silk_decode_signs(int16_t       pulses[],                       /* I/O  pul
                 if (q_ptr[j] > 0) {
                     /* attach sign */
                     /* implementation with shift, subtraction, multiplication */
-                    q_ptr[j] *= silk_dec_map(ec_dec_icdf(icdf, 8));
+                    q_ptr[j] *= silk_dec_map(ec_dec_icdf(sd->ec, icdf, 8));
                 }
             }
         }
@@ -1641,20 +1630,20 @@ void silk_decode_signs(int16_t       pulses[],                       /* I/O  pul
     }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void silk_setRawParams(uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate) {
-    s_channelsInternal = channels;
-    s_API_channels = API_channels;
-    s_payloadSize_ms = payloadSize_ms;
-    s_silk_internalSampleRate = internalSampleRate;
-    s_API_sampleRate = API_samleRate;
+void silk_setRawParams(SILKDecoder_t* sd, uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate) {
+    sd->channelsInternal = channels;
+    sd->API_channels = API_channels;
+    sd->payloadSize_ms = payloadSize_ms;
+    sd->silk_internalSampleRate = internalSampleRate;
+    sd->API_sampleRate = API_samleRate;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-uint32_t silk_getPrevPitchLag() {
-    return s_prevPitchLag;
+uint32_t silk_getPrevPitchLag(SILKDecoder_t* sd) {
+    return sd->prevPitchLag;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode a frame */
-int32_t silk_Decode(int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode fec                */
+int32_t silk_Decode(SILKDecoder_t* sd, int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode fec                */
                     int32_t  newPacketFlag, /* I    Indicates first decoder call for this packet    */
                     int16_t* samplesOut,    /* O    Decoded output speech vector                    */
                     int32_t* nSamplesOut    /* O    Number of samples decoded                       */
@@ -1668,107 +1657,107 @@ int32_t silk_Decode(int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode
     int16_t* samplesOut2_tmp = NULL;
     int32_t       MS_pred_Q13[2] = {0};
     int16_t*      resample_out_ptr;
-    silk_decoder* psDec = (silk_decoder*)&s_decState;
+    silk_decoder* psDec = (silk_decoder*)&sd->decState;
     int32_t       has_side;
     int32_t       stereo_to_mono;
     int           delay_stack_alloc;
 
-    assert(s_channelsInternal == 1 || s_channelsInternal == 2);
+    assert(sd->channelsInternal == 1 || sd->channelsInternal == 2);
 
     /**********************************/
     /* Test if first frame in payload */
     /**********************************/
     if (newPacketFlag) {
-        for (n = 0; n < s_channelsInternal; n++) { s_channel_state[n].nFramesDecoded = 0; /* Used to count frames in packet */ }
+        for (n = 0; n < sd->channelsInternal; n++) { sd->channel_state[n].nFramesDecoded = 0; /* Used to count frames in packet */ }
     }
 
     /* If Mono -> Stereo transition in bitstream: init state of second channel */
-    if (s_channelsInternal > psDec->nChannelsInternal) { ret += silk_init_decoder(&s_channel_state[1]); }
+    if (sd->channelsInternal > psDec->nChannelsInternal) { ret += silk_init_decoder(&sd->channel_state[1]); }
 
-    stereo_to_mono = s_channelsInternal == 1 && psDec->nChannelsInternal == 2 && (s_silk_internalSampleRate == 1000 * s_channel_state[0].fs_kHz);
+    stereo_to_mono = sd->channelsInternal == 1 && psDec->nChannelsInternal == 2 && (sd->silk_internalSampleRate == (uint32_t)(1000 * sd->channel_state[0].fs_kHz));
 
-    if (s_channel_state[0].nFramesDecoded == 0) {
-        for (n = 0; n < s_channelsInternal; n++) {
+    if (sd->channel_state[0].nFramesDecoded == 0) {
+        for (n = 0; n < sd->channelsInternal; n++) {
             int32_t fs_kHz_dec;
-            if (s_payloadSize_ms == 0) {
+            if (sd->payloadSize_ms == 0) {
                 /* Assuming packet loss, use 10 ms */
-                s_channel_state[n].nFramesPerPacket = 1;
-                s_channel_state[n].nb_subfr = 2;
-            } else if (s_payloadSize_ms == 10) {
-                s_channel_state[n].nFramesPerPacket = 1;
-                s_channel_state[n].nb_subfr = 2;
-            } else if (s_payloadSize_ms == 20) {
-                s_channel_state[n].nFramesPerPacket = 1;
-                s_channel_state[n].nb_subfr = 4;
-            } else if (s_payloadSize_ms == 40) {
-                s_channel_state[n].nFramesPerPacket = 2;
-                s_channel_state[n].nb_subfr = 4;
-            } else if (s_payloadSize_ms == 60) {
-                s_channel_state[n].nFramesPerPacket = 3;
-                s_channel_state[n].nb_subfr = 4;
+                sd->channel_state[n].nFramesPerPacket = 1;
+                sd->channel_state[n].nb_subfr = 2;
+            } else if (sd->payloadSize_ms == 10) {
+                sd->channel_state[n].nFramesPerPacket = 1;
+                sd->channel_state[n].nb_subfr = 2;
+            } else if (sd->payloadSize_ms == 20) {
+                sd->channel_state[n].nFramesPerPacket = 1;
+                sd->channel_state[n].nb_subfr = 4;
+            } else if (sd->payloadSize_ms == 40) {
+                sd->channel_state[n].nFramesPerPacket = 2;
+                sd->channel_state[n].nb_subfr = 4;
+            } else if (sd->payloadSize_ms == 60) {
+                sd->channel_state[n].nFramesPerPacket = 3;
+                sd->channel_state[n].nb_subfr = 4;
             } else {
                 return SILK_DEC_INVALID_FRAME_SIZE;
             }
-            fs_kHz_dec = (s_silk_internalSampleRate >> 10) + 1;
+            fs_kHz_dec = (sd->silk_internalSampleRate >> 10) + 1;
             if (fs_kHz_dec != 8 && fs_kHz_dec != 12 && fs_kHz_dec != 16) { return SILK_DEC_INVALID_SAMPLING_FREQUENCY; }
-            ret += silk_decoder_set_fs(&s_channel_state[n], fs_kHz_dec, s_API_sampleRate);
+            ret += silk_decoder_set_fs(&sd->channel_state[n], fs_kHz_dec, sd->API_sampleRate);
         }
     }
 
-    if (s_API_channels == 2 && s_channelsInternal == 2 && (psDec->nChannelsAPI == 1 || psDec->nChannelsInternal == 1)) {
+    if (sd->API_channels == 2 && sd->channelsInternal == 2 && (psDec->nChannelsAPI == 1 || psDec->nChannelsInternal == 1)) {
         memset(psDec->sStereo.pred_prev_Q13, 0, sizeof(psDec->sStereo.pred_prev_Q13));
         memset(psDec->sStereo.sSide, 0, sizeof(psDec->sStereo.sSide));
-        memcpy(&s_channel_state[1].resampler_state, &s_channel_state[0].resampler_state, sizeof(silk_resampler_state_struct));
+        memcpy(&sd->channel_state[1].resampler_state, &sd->channel_state[0].resampler_state, sizeof(silk_resampler_state_struct));
     }
-    psDec->nChannelsAPI = s_API_channels;
-    psDec->nChannelsInternal = s_channelsInternal;
+    psDec->nChannelsAPI = sd->API_channels;
+    psDec->nChannelsInternal = sd->channelsInternal;
 
-    if (s_API_sampleRate > (int32_t)MAX_API_FS_KHZ * 1000 || s_API_sampleRate < 8000) {
+    if (sd->API_sampleRate > (int32_t)MAX_API_FS_KHZ * 1000 || sd->API_sampleRate < 8000) {
         ret = SILK_DEC_INVALID_SAMPLING_FREQUENCY;
 
         return (ret);
     }
 
-    if (lostFlag != FLAG_PACKET_LOST && s_channel_state[0].nFramesDecoded == 0) {
+    if (lostFlag != FLAG_PACKET_LOST && sd->channel_state[0].nFramesDecoded == 0) {
         /* First decoder call for this payload */
         /* Decode VAD flags and LBRR flag */
-        for (n = 0; n < s_channelsInternal; n++) {
-            for (i = 0; i < s_channel_state[n].nFramesPerPacket; i++) { s_channel_state[n].VAD_flags[i] = ec_dec_bit_logp(1); }
-            s_channel_state[n].LBRR_flag = ec_dec_bit_logp(1);
+        for (n = 0; n < sd->channelsInternal; n++) {
+            for (i = 0; i < sd->channel_state[n].nFramesPerPacket; i++) { sd->channel_state[n].VAD_flags[i] = ec_dec_bit_logp(sd->ec, 1); }
+            sd->channel_state[n].LBRR_flag = ec_dec_bit_logp(sd->ec, 1);
         }
         /* Decode LBRR flags */
-        for (n = 0; n < s_channelsInternal; n++) {
-            memset(s_channel_state[n].LBRR_flags, 0, sizeof(s_channel_state[n].LBRR_flags));
-            if (s_channel_state[n].LBRR_flag) {
-                if (s_channel_state[n].nFramesPerPacket == 1) {
-                    s_channel_state[n].LBRR_flags[0] = 1;
+        for (n = 0; n < sd->channelsInternal; n++) {
+            memset(sd->channel_state[n].LBRR_flags, 0, sizeof(sd->channel_state[n].LBRR_flags));
+            if (sd->channel_state[n].LBRR_flag) {
+                if (sd->channel_state[n].nFramesPerPacket == 1) {
+                    sd->channel_state[n].LBRR_flags[0] = 1;
                 } else {
-                    LBRR_symbol = ec_dec_icdf(silk_LBRR_flags_iCDF_ptr[s_channel_state[n].nFramesPerPacket - 2], 8) + 1;
-                    for (i = 0; i < s_channel_state[n].nFramesPerPacket; i++) { s_channel_state[n].LBRR_flags[i] = silk_RSHIFT(LBRR_symbol, i) & 1; }
+                    LBRR_symbol = ec_dec_icdf(sd->ec, silk_LBRR_flags_iCDF_ptr[sd->channel_state[n].nFramesPerPacket - 2], 8) + 1;
+                    for (i = 0; i < sd->channel_state[n].nFramesPerPacket; i++) { sd->channel_state[n].LBRR_flags[i] = silk_RSHIFT(LBRR_symbol, i) & 1; }
                 }
             }
         }
 
         if (lostFlag == FLAG_DECODE_NORMAL) {
             /* Regular decoding: skip all LBRR data */
-            for (i = 0; i < s_channel_state[0].nFramesPerPacket; i++) {
-                for (n = 0; n < s_channelsInternal; n++) {
-                    if (s_channel_state[n].LBRR_flags[i]) {
+            for (i = 0; i < sd->channel_state[0].nFramesPerPacket; i++) {
+                for (n = 0; n < sd->channelsInternal; n++) {
+                    if (sd->channel_state[n].LBRR_flags[i]) {
                         int16_t pulses[MAX_FRAME_LENGTH];
                         int32_t condCoding;
 
-                        if (s_channelsInternal == 2 && n == 0) {
-                            silk_stereo_decode_pred(MS_pred_Q13);
-                            if (s_channel_state[1].LBRR_flags[i] == 0) { silk_stereo_decode_mid_only(&decode_only_middle); }
+                        if (sd->channelsInternal == 2 && n == 0) {
+                            silk_stereo_decode_pred(sd, MS_pred_Q13);
+                            if (sd->channel_state[1].LBRR_flags[i] == 0) { silk_stereo_decode_mid_only(sd, &decode_only_middle); }
                         }
                         /* Use conditional coding if previous frame available */
-                        if (i > 0 && s_channel_state[n].LBRR_flags[i - 1]) {
+                        if (i > 0 && sd->channel_state[n].LBRR_flags[i - 1]) {
                             condCoding = CODE_CONDITIONALLY;
                         } else {
                             condCoding = CODE_INDEPENDENTLY;
                         }
-                        silk_decode_indices(&s_channel_state[n], i, 1, condCoding);
-                        silk_decode_pulses(pulses, s_channel_state[n].indices.signalType, s_channel_state[n].indices.quantOffsetType, s_channel_state[n].frame_length);
+                        silk_decode_indices(sd, &sd->channel_state[n], i, 1, condCoding);
+                        silk_decode_pulses(sd, pulses, sd->channel_state[n].indices.signalType, sd->channel_state[n].indices.quantOffsetType, sd->channel_state[n].frame_length);
                     }
                 }
             }
@@ -1776,13 +1765,13 @@ int32_t silk_Decode(int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode
     }
 
     /* Get MS predictor index */
-    if (s_channelsInternal == 2) {
-        if (lostFlag == FLAG_DECODE_NORMAL || (lostFlag == FLAG_DECODE_LBRR && s_channel_state[0].LBRR_flags[s_channel_state[0].nFramesDecoded] == 1)) {
-            silk_stereo_decode_pred(MS_pred_Q13);
+    if (sd->channelsInternal == 2) {
+        if (lostFlag == FLAG_DECODE_NORMAL || (lostFlag == FLAG_DECODE_LBRR && sd->channel_state[0].LBRR_flags[sd->channel_state[0].nFramesDecoded] == 1)) {
+            silk_stereo_decode_pred(sd, MS_pred_Q13);
             /* For LBRR data, decode mid-only flag only if side-channel's LBRR flag is false */
-            if ((lostFlag == FLAG_DECODE_NORMAL && s_channel_state[1].VAD_flags[s_channel_state[0].nFramesDecoded] == 0) ||
-                (lostFlag == FLAG_DECODE_LBRR && s_channel_state[1].LBRR_flags[s_channel_state[0].nFramesDecoded] == 0)) {
-                silk_stereo_decode_mid_only(&decode_only_middle);
+            if ((lostFlag == FLAG_DECODE_NORMAL && sd->channel_state[1].VAD_flags[sd->channel_state[0].nFramesDecoded] == 0) ||
+                (lostFlag == FLAG_DECODE_LBRR && sd->channel_state[1].LBRR_flags[sd->channel_state[0].nFramesDecoded] == 0)) {
+                silk_stereo_decode_mid_only(sd, &decode_only_middle);
             } else {
                 decode_only_middle = 0;
             }
@@ -1792,47 +1781,47 @@ int32_t silk_Decode(int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode
     }
 
     /* Reset side channel decoder prediction memory for first frame with side coding */
-    if (s_channelsInternal == 2 && decode_only_middle == 0 && psDec->prev_decode_only_middle == 1) {
-        memset(s_channel_state[1].outBuf, 0, sizeof(s_channel_state[1].outBuf));
-        memset(s_channel_state[1].sLPC_Q14_buf, 0, sizeof(s_channel_state[1].sLPC_Q14_buf));
-        s_channel_state[1].lagPrev = 100;
-        s_channel_state[1].LastGainIndex = 10;
-        s_channel_state[1].prevSignalType = TYPE_NO_VOICE_ACTIVITY;
-        s_channel_state[1].first_frame_after_reset = 1;
+    if (sd->channelsInternal == 2 && decode_only_middle == 0 && psDec->prev_decode_only_middle == 1) {
+        memset(sd->channel_state[1].outBuf, 0, sizeof(sd->channel_state[1].outBuf));
+        memset(sd->channel_state[1].sLPC_Q14_buf, 0, sizeof(sd->channel_state[1].sLPC_Q14_buf));
+        sd->channel_state[1].lagPrev = 100;
+        sd->channel_state[1].LastGainIndex = 10;
+        sd->channel_state[1].prevSignalType = TYPE_NO_VOICE_ACTIVITY;
+        sd->channel_state[1].first_frame_after_reset = 1;
     }
 
     /* Check if the temp buffer fits into the output PCM buffer. If it fits, we can delay allocating the temp buffer until after the SILK peak stack
        usage. We need to use a < and not a <= because of the two extra samples. */
-    delay_stack_alloc = s_silk_internalSampleRate * s_channelsInternal < s_API_sampleRate * s_API_channels;
-//    ALLOC(samplesOut1_tmp_storage1, delay_stack_alloc ? ALLOC_NONE : s_channelsInternal * (s_channel_state[0].frame_length + 2), int16_t);
-    int size = delay_stack_alloc ? ALLOC_NONE : s_channelsInternal * (s_channel_state[0].frame_length + 2);
+    delay_stack_alloc = sd->silk_internalSampleRate * sd->channelsInternal < sd->API_sampleRate * sd->API_channels;
+//    ALLOC(samplesOut1_tmp_storage1, delay_stack_alloc ? ALLOC_NONE : sd->channelsInternal * (sd->channel_state[0].frame_length + 2), int16_t);
+    int size = delay_stack_alloc ? ALLOC_NONE : sd->channelsInternal * (sd->channel_state[0].frame_length + 2);
     samplesOut1_tmp_storage1 = (int16_t*) __malloc_heap_psram(size * sizeof(int16_t));
 
     if (delay_stack_alloc) {
         samplesOut1_tmp[0] = samplesOut;
-        samplesOut1_tmp[1] = samplesOut + s_channel_state[0].frame_length + 2;
+        samplesOut1_tmp[1] = samplesOut + sd->channel_state[0].frame_length + 2;
     } else {
         samplesOut1_tmp[0] = samplesOut1_tmp_storage1;
-        samplesOut1_tmp[1] = samplesOut1_tmp_storage1 + s_channel_state[0].frame_length + 2;
+        samplesOut1_tmp[1] = samplesOut1_tmp_storage1 + sd->channel_state[0].frame_length + 2;
     }
 
     if (lostFlag == FLAG_DECODE_NORMAL) {
         has_side = !decode_only_middle;
     } else {
-        has_side = !psDec->prev_decode_only_middle || (s_channelsInternal == 2 && lostFlag == FLAG_DECODE_LBRR && s_channel_state[1].LBRR_flags[s_channel_state[1].nFramesDecoded] == 1);
+        has_side = !psDec->prev_decode_only_middle || (sd->channelsInternal == 2 && lostFlag == FLAG_DECODE_LBRR && sd->channel_state[1].LBRR_flags[sd->channel_state[1].nFramesDecoded] == 1);
     }
     /* Call decoder for one frame */
-    for (n = 0; n < s_channelsInternal; n++) {
+    for (n = 0; n < sd->channelsInternal; n++) {
         if (n == 0 || has_side) {
             int32_t FrameIndex;
             int32_t condCoding;
 
-            FrameIndex = s_channel_state[0].nFramesDecoded - n;
+            FrameIndex = sd->channel_state[0].nFramesDecoded - n;
             /* Use independent coding if no previous frame available */
             if (FrameIndex <= 0) {
                 condCoding = CODE_INDEPENDENTLY;
             } else if (lostFlag == FLAG_DECODE_LBRR) {
-                condCoding = s_channel_state[n].LBRR_flags[FrameIndex - 1] ? CODE_CONDITIONALLY : CODE_INDEPENDENTLY;
+                condCoding = sd->channel_state[n].LBRR_flags[FrameIndex - 1] ? CODE_CONDITIONALLY : CODE_INDEPENDENTLY;
             } else if (n > 0 && psDec->prev_decode_only_middle) {
                 /* If we skipped a side frame in this packet, we don't
                    need LTP scaling; the LTP state is well-defined. */
@@ -1840,16 +1829,16 @@ int32_t silk_Decode(int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode
             } else {
                 condCoding = CODE_CONDITIONALLY;
             }
-            ret += silk_decode_frame(&s_channel_state[n], &samplesOut1_tmp[n][2], &nSamplesOutDec, lostFlag, condCoding);
+            ret += silk_decode_frame(sd, &sd->channel_state[n], &samplesOut1_tmp[n][2], &nSamplesOutDec, lostFlag, condCoding);
         } else {
             memset(&samplesOut1_tmp[n][2], 0, nSamplesOutDec * sizeof(int16_t));
         }
-        s_channel_state[n].nFramesDecoded++;
+        sd->channel_state[n].nFramesDecoded++;
     }
 
-    if (s_API_channels == 2 && s_channelsInternal == 2) {
+    if (sd->API_channels == 2 && sd->channelsInternal == 2) {
         /* Convert Mid/Side to Left/Right */
-        silk_stereo_MS_to_LR(&psDec->sStereo, samplesOut1_tmp[0], samplesOut1_tmp[1], MS_pred_Q13, s_channel_state[0].fs_kHz, nSamplesOutDec);
+        silk_stereo_MS_to_LR(&psDec->sStereo, samplesOut1_tmp[0], samplesOut1_tmp[1], MS_pred_Q13, sd->channel_state[0].fs_kHz, nSamplesOutDec);
     } else {
         /* Buffering */
         memcpy(samplesOut1_tmp[0], psDec->sStereo.sMid, 2 * sizeof(int16_t));
@@ -1857,45 +1846,45 @@ int32_t silk_Decode(int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode
     }
 
     /* Number of output samples */
-    *nSamplesOut = silk_DIV32(nSamplesOutDec * s_API_sampleRate, silk_SMULBB(s_channel_state[0].fs_kHz, 1000));
+    *nSamplesOut = silk_DIV32(nSamplesOutDec * sd->API_sampleRate, silk_SMULBB(sd->channel_state[0].fs_kHz, 1000));
 
     /* Set up pointers to temp buffers */
-    // ALLOC(samplesOut2_tmp, s_API_channels == 2 ? *nSamplesOut : ALLOC_NONE, int16_t);
-    size = s_API_channels == 2 ? *nSamplesOut : ALLOC_NONE;
+    // ALLOC(samplesOut2_tmp, sd->API_channels == 2 ? *nSamplesOut : ALLOC_NONE, int16_t);
+    size = sd->API_channels == 2 ? *nSamplesOut : ALLOC_NONE;
     samplesOut2_tmp = (int16_t*) __malloc_heap_psram(size * sizeof(int16_t));
 
-    if (s_API_channels == 2) {
+    if (sd->API_channels == 2) {
         resample_out_ptr = samplesOut2_tmp;
     } else {
         resample_out_ptr = samplesOut;
     }
 
-    // ALLOC(samplesOut1_tmp_storage2, delay_stack_alloc ? s_channelsInternal * (s_channel_state[0].frame_length + 2) : ALLOC_NONE, int16_t);
-    size = delay_stack_alloc ? s_channelsInternal * (s_channel_state[0].frame_length + 2) : ALLOC_NONE;
+    // ALLOC(samplesOut1_tmp_storage2, delay_stack_alloc ? sd->channelsInternal * (sd->channel_state[0].frame_length + 2) : ALLOC_NONE, int16_t);
+    size = delay_stack_alloc ? sd->channelsInternal * (sd->channel_state[0].frame_length + 2) : ALLOC_NONE;
     samplesOut1_tmp_storage2 = (int16_t*) __malloc_heap_psram(size * sizeof(int16_t));
 
     if (delay_stack_alloc) {
         memcpy(samplesOut1_tmp_storage2, samplesOut, size * sizeof(int16_t));
         samplesOut1_tmp[0] = samplesOut1_tmp_storage2;
-        samplesOut1_tmp[1] = samplesOut1_tmp_storage2 + s_channel_state[0].frame_length + 2;
+        samplesOut1_tmp[1] = samplesOut1_tmp_storage2 + sd->channel_state[0].frame_length + 2;
     }
-    for (n = 0; n < silk_min(s_API_channels, s_channelsInternal); n++) {
+    for (n = 0; n < silk_min(sd->API_channels, sd->channelsInternal); n++) {
 
         /* Resample decoded signal to API_sampleRate */
-        ret += silk_resampler(&s_channel_state[n].resampler_state, resample_out_ptr, &samplesOut1_tmp[n][1], nSamplesOutDec);
+        ret += silk_resampler(&sd->channel_state[n].resampler_state, resample_out_ptr, &samplesOut1_tmp[n][1], nSamplesOutDec);
 
         /* Interleave if stereo output and stereo stream */
-        if (s_API_channels == 2) {
+        if (sd->API_channels == 2) {
             for (i = 0; i < *nSamplesOut; i++) { samplesOut[n + 2 * i] = resample_out_ptr[i]; }
         }
     }
 
     /* Create two channel output from mono stream */
-    if (s_API_channels == 2 && s_channelsInternal == 1) {
+    if (sd->API_channels == 2 && sd->channelsInternal == 1) {
         if (stereo_to_mono) {
             /* Resample right channel for newly collapsed stereo just in case
                we weren't doing collapsing when switching to mono */
-            ret += silk_resampler(&s_channel_state[1].resampler_state, resample_out_ptr, &samplesOut1_tmp[0][1], nSamplesOutDec);
+            ret += silk_resampler(&sd->channel_state[1].resampler_state, resample_out_ptr, &samplesOut1_tmp[0][1], nSamplesOutDec);
 
             for (i = 0; i < *nSamplesOut; i++) { samplesOut[1 + 2 * i] = resample_out_ptr[i]; }
         } else {
@@ -1904,17 +1893,17 @@ int32_t silk_Decode(int32_t  lostFlag,      /* I    0: no loss, 1 loss, 2 decode
     }
 
     /* Export pitch lag, measured at 48 kHz sampling rate */
-    if (s_channel_state[0].prevSignalType == TYPE_VOICED) {
+    if (sd->channel_state[0].prevSignalType == TYPE_VOICED) {
         int mult_tab[3] = {6, 4, 3};
-        s_prevPitchLag = s_channel_state[0].lagPrev * mult_tab[(s_channel_state[0].fs_kHz - 8) >> 2];
+        sd->prevPitchLag = sd->channel_state[0].lagPrev * mult_tab[(sd->channel_state[0].fs_kHz - 8) >> 2];
     } else {
-        s_prevPitchLag = 0;
+        sd->prevPitchLag = 0;
     }
 
     if (lostFlag == FLAG_PACKET_LOST) {
         /* On packet loss, remove the gain clamping to prevent having the energy "bounce back"
            if we lose packets when the energy is going down */
-        for (i = 0; i < psDec->nChannelsInternal; i++) s_channel_state[i].LastGainIndex = 10;
+        for (i = 0; i < psDec->nChannelsInternal; i++) sd->channel_state[i].LastGainIndex = 10;
     } else {
         psDec->prev_decode_only_middle = decode_only_middle;
     }
@@ -1936,14 +1925,29 @@ int32_t silk_Get_Decoder_Size(int32_t* decSizeBytes) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+SILKDecoder_t* SILKDecoder_AllocateBuffers(ec_ctx_t* ec) {
+    SILKDecoder_t* sd = (SILKDecoder_t*)__calloc_heap_psram(1, sizeof(SILKDecoder_t));
+    if (!sd) {
+        log_e("not enough memory to allocate silkdecoder buffers");
+        return NULL;
+    }
+    sd->ec = ec; // in hybrid frames CELT continues reading where SILK stopped
+    return sd;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void SILKDecoder_FreeBuffers(SILKDecoder_t* sd) {
+    if (sd) free(sd);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 /* Reset decoder state */
-int32_t silk_InitDecoder() {
+int32_t silk_InitDecoder(SILKDecoder_t* sd) {
 
     int32_t n, ret = SILK_NO_ERROR;
-    for (n = 0; n < DECODER_NUM_CHANNELS; n++) { ret = silk_init_decoder(&s_channel_state[n]); }
-    memset(&s_decState.sStereo, 0, sizeof(s_decState.sStereo));
+    for (n = 0; n < DECODER_NUM_CHANNELS; n++) { ret = silk_init_decoder(&sd->channel_state[n]); }
+    memset(&sd->decState.sStereo, 0, sizeof(sd->decState.sStereo));
     /* Not strictly needed, but it's cleaner that way */
-    s_decState.prev_decode_only_middle = 0;
+    sd->decState.prev_decode_only_middle = 0;
 
     return ret;
 }
@@ -2138,7 +2142,7 @@ void silk_decode_core(silk_decoder_state*   psDec,                   /* I/O  Dec
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode frame */
-int32_t silk_decode_frame(silk_decoder_state* psDec,     /* I/O  Pointer to Silk decoder state               */
+int32_t silk_decode_frame(SILKDecoder_t* sd, silk_decoder_state* psDec,     /* I/O  Pointer to Silk decoder state               */
                           int16_t             pOut[],    /* O    Pointer to output speech frame              */
                           int32_t*            pN,        /* O    Pointer to size of output frame             */
                           int32_t             lostFlag,  /* I    0: no loss, 1 loss, 2 decode fec            */
@@ -2159,12 +2163,12 @@ int32_t silk_decode_frame(silk_decoder_state* psDec,     /* I/O  Pointer to Silk
         /*********************************************/
         /* Decode quantization indices of side info  */
         /*********************************************/
-        silk_decode_indices(psDec, psDec->nFramesDecoded, lostFlag, condCoding);
+        silk_decode_indices(sd, psDec, psDec->nFramesDecoded, lostFlag, condCoding);
 
         /*********************************************/
         /* Decode quantization indices of excitation */
         /*********************************************/
-        silk_decode_pulses(pulses, psDec->indices.signalType, psDec->indices.quantOffsetType, psDec->frame_length);
+        silk_decode_pulses(sd, pulses, psDec->indices.signalType, psDec->indices.quantOffsetType, psDec->frame_length);
 
         /********************************************/
         /* Decode parameters and pulse signal       */
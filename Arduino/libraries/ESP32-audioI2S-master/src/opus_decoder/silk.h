@@ -727,6 +727,19 @@ typedef struct {
     int32_t          prev_decode_only_middle;
 } silk_decoder;
 
+/* Complete state of one SILK decoder instance, see SILKDecoder_AllocateBuffers() */
+typedef struct SILKDecoder_t {
+    silk_decoder_state channel_state[2];
+    silk_decoder       decState;
+    ec_ctx_t*          ec; /* range decoder, owned by the OPUS decoder and shared with CELT */
+    uint8_t            channelsInternal;
+    uint8_t            payloadSize_ms;
+    uint8_t            API_channels;
+    uint32_t           silk_internalSampleRate;
+    uint32_t           API_sampleRate;
+    uint32_t           prevPitchLag;
+} SILKDecoder_t;
+
 typedef struct {
     int32_t sLPC_Q14[MAX_SUB_FRAME_LENGTH + NSQ_LPC_BUF_LENGTH];
     int32_t RandState[DECISION_DELAY];
@@ -960,8 +973,8 @@ void    silk_biquad_alt_stride1(const int16_t* in, const int32_t* B_Q28, const i
 void    silk_biquad_alt_stride2_c(const int16_t* in, const int32_t* B_Q28, const int32_t* A_Q28, int32_t* S, int16_t* out, const int32_t len);
 void    silk_bwexpander_32(int32_t* ar, const int32_t d, int32_t chirp_Q16);
 void    silk_bwexpander(int16_t* ar, const int32_t d, int32_t chirp_Q16);
-void    silk_stereo_decode_pred(int32_t pred_Q13[]);
-void    silk_stereo_decode_mid_only(int32_t* decode_only_mid);
+void    silk_stereo_decode_pred(SILKDecoder_t* sd, int32_t pred_Q13[]);
+void    silk_stereo_decode_mid_only(SILKDecoder_t* sd, int32_t* decode_only_mid);
 void    silk_PLC_Reset(silk_decoder_state* psDec);
 void    silk_PLC(silk_decoder_state* psDec, silk_decoder_control* psDecCtrl, int16_t frame[], int32_t lost);
 void    silk_PLC_glue_frames(silk_decoder_state* psDec, int16_t frame[], int32_t length);
@@ -970,11 +983,11 @@ void    silk_LP_variable_cutoff(silk_LP_state* psLP, int16_t* frame, const int32
 void    silk_NLSF_unpack(int16_t ec_ix[], uint8_t pred_Q8[], const silk_NLSF_CB_struct* psNLSF_CB, const int32_t CB1_index);
 void    silk_NLSF_decode(int16_t* pNLSF_Q15, int8_t* NLSFIndices, const silk_NLSF_CB_struct* psNLSF_CB);
 int32_t silk_decoder_set_fs(silk_decoder_state* psDec, int32_t fs_kHz, int32_t fs_API_Hz);
-int32_t silk_decode_frame(silk_decoder_state* psDec, int16_t pOut[], int32_t* pN, int32_t lostFlag, int32_t condCoding);
-void    silk_decode_indices(silk_decoder_state* psDec, int32_t FrameIndex, int32_t decode_LBRR, int32_t condCoding);
+int32_t silk_decode_frame(SILKDecoder_t* sd, silk_decoder_state* psDec, int16_t pOut[], int32_t* pN, int32_t lostFlag, int32_t condCoding);
+void    silk_decode_indices(SILKDecoder_t* sd, silk_decoder_state* psDec, int32_t FrameIndex, int32_t decode_LBRR, int32_t condCoding);
 void    silk_decode_parameters(silk_decoder_state* psDec, silk_decoder_control* psDecCtrl, int32_t condCoding);
 void    silk_decode_core(silk_decoder_state* psDec, silk_decoder_control* psDecCtrl, int16_t xq[], const int16_t pulses[MAX_FRAME_LENGTH]);
-void    silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_t quantOffsetType, const int32_t frame_length);
+void    silk_decode_pulses(SILKDecoder_t* sd, int16_t pulses[], const int32_t signalType, const int32_t quantOffsetType, const int32_t frame_length);
 int32_t silk_init_decoder(silk_decoder_state* psDec);
 int32_t silk_NLSF_del_dec_quant(int8_t indices[], const int16_t x_Q10[], const int16_t w_Q5[], const uint8_t pred_coef_Q8[], const int16_t ec_ix[], const uint8_t ec_rates_Q5[],
                                 const int32_t quant_step_size_Q16, const int16_t inv_quant_step_size_Q6, const int32_t mu_Q20, const int16_t order);
@@ -984,10 +997,10 @@ int32_t silk_VAD_Init(silk_VAD_state* psSilk_VAD);
 void silk_stereo_MS_to_LR(stereo_dec_state* state, int16_t x1[], int16_t x2[], const int32_t pred_Q13[], int32_t fs_kHz, int32_t frame_length);
 int32_t  silk_stereo_find_predictor(int32_t* ratio_Q14, const int16_t x[], const int16_t y[], int32_t mid_res_amp_Q0[], int32_t length, int32_t smooth_coef_Q16);
 void     silk_stereo_quant_pred(int32_t pred_Q13[], int8_t ix[2][3]);
-void     silk_stereo_decode_pred(int32_t pred_Q13[]);
-void     silk_stereo_decode_mid_only(int32_t* decode_only_mid);
-void     silk_decode_signs(int16_t pulses[], int32_t length, const int32_t signalType, const int32_t quantOffsetType, const int32_t sum_pulses[MAX_NB_SHELL_BLOCKS]);
-void     silk_shell_decoder(int16_t* pulses0, const int32_t pulses4);
+void     silk_stereo_decode_pred(SILKDecoder_t* sd, int32_t pred_Q13[]);
+void     silk_stereo_decode_mid_only(SILKDecoder_t* sd, int32_t* decode_only_mid);
+void     silk_decode_signs(SILKDecoder_t* sd, int16_t pulses[], int32_t length, const int32_t signalType, const int32_t quantOffsetType, const int32_t sum_pulses[MAX_NB_SHELL_BLOCKS]);
+void     silk_shell_decoder(SILKDecoder_t* sd, int16_t* pulses0, const int32_t pulses4);
 void     silk_gains_quant(int8_t ind[MAX_NB_SUBFR], int32_t gain_Q16[MAX_NB_SUBFR], int8_t* prev_ind, const int32_t conditional, const int32_t nb_subfr);
 void     silk_gains_dequant(int32_t gain_Q16[MAX_NB_SUBFR], const int8_t ind[MAX_NB_SUBFR], int8_t* prev_ind, const int32_t conditional, const int32_t nb_subfr);
 int32_t  silk_gains_ID(const int8_t ind[MAX_NB_SUBFR], const int32_t nb_subfr);
@@ -1001,15 +1014,17 @@ void     silk_CNG(silk_decoder_state* psDec, silk_decoder_control* psDecCtrl, in
 void     silk_CNG_Reset(silk_decoder_state* psDec);
 int32_t  silk_Get_Decoder_Size(int32_t* decSizeBytes);
 
-int32_t  silk_InitDecoder();
-void     silk_setRawParams(uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate);
-uint32_t silk_getPrevPitchLag();
-int32_t  silk_Decode(int32_t lostFlag, int32_t newPacketFlag, int16_t* samplesOut, int32_t* nSamplesOut);
+SILKDecoder_t* SILKDecoder_AllocateBuffers(ec_ctx_t* ec);
+void     SILKDecoder_FreeBuffers(SILKDecoder_t* sd);
+int32_t  silk_InitDecoder(SILKDecoder_t* sd);
+void     silk_setRawParams(SILKDecoder_t* sd, uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate);
+uint32_t silk_getPrevPitchLag(SILKDecoder_t* sd);
+int32_t  silk_Decode(SILKDecoder_t* sd, int32_t lostFlag, int32_t newPacketFlag, int16_t* samplesOut, int32_t* nSamplesOut);
 void     silk_NLSF2A_find_poly(int32_t* out, const int32_t* cLSF, int32_t dd);
 void     silk_NLSF2A(int16_t* a_Q12, const int16_t* NLSF, const int32_t d);
 void     silk_CNG_exc(int32_t exc_Q14[], int32_t exc_buf_Q14[], int32_t length, int32_t* rand_seed);
 void     silk_decode_core(silk_decoder_state* psDec, silk_decoder_control* psDecCtrl, int16_t xq[], const int16_t pulses[MAX_FRAME_LENGTH]);
-int32_t  silk_decode_frame(silk_decoder_state* psDec, int16_t pOut[], int32_t* pN, int32_t lostFlag, int32_t condCoding);
+int32_t  silk_decode_frame(SILKDecoder_t* sd, silk_decoder_state* psDec, int16_t pOut[], int32_t* pN, int32_t lostFlag, int32_t condCoding);
 void     silk_decode_pitch(int16_t lagIndex, int8_t contourIndex, int32_t pitch_lags[], const int32_t Fs_kHz, const int32_t nb_subfr);
 int32_t  silk_inner_prod_aligned_scale(const int16_t* const inVec1, const int16_t* const inVec2, const int32_t scale, const int32_t len);
 int32_t  silk_lin2log(const int32_t inLin);
@@ -1208,6 +1208,11 @@ const int32_t sincos_lookup1[1024] = {
     0x5afe8a8b, 0x5a29727b, 0x5adb297d, 0x5a4d1960, 0x5ab7ba6c, 0x5a70b258, 0x5a943d5e,
 };
 
+/* {sin(2*j*PI/65536), cos(2*j*PI/65536)}, with j = 0 to 7, fine steps between the sincos_lookup values */
+const int32_t sincos_fine[16] = {
+    0x00000000, 0x7fffffff, 0x0003243f, 0x7ffffff6, 0x0006487f, 0x7fffffd9, 0x00096cbe, 0x7fffffa7, 0x000c90fe,
+    0x7fffff62, 0x000fb53d, 0x7fffff09, 0x0012d97c, 0x7ffffe9d, 0x0015fdbc, 0x7ffffe1c};
+
 const int32_t INVSQ_LOOKUP_I[64 + 1] = {
     92682, 91966, 91267, 90583, 89915, 89261, 88621, 87995, 87381, 86781, 86192, 85616, 85051,
     84497, 83953, 83420, 82897, 82384, 81880, 81385, 80899, 80422, 79953, 79492, 79039, 78594,
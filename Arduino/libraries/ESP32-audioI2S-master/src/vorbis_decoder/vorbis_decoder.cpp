@@ -23,7 +23,9 @@
 #include "vorbis_decoder.h"
 #include "lookup.h"
 #include "alloca.h"
+#include "../ogg_demuxer/ogg_demuxer.h"
 #include <vector>
+#include <new>
 using namespace std;
 
 #define __malloc_heap_psram(size) \
@@ -32,438 +34,407 @@ using namespace std;
     heap_caps_calloc_prefer(ch, size, 2, MALLOC_CAP_DEFAULT | MALLOC_CAP_SPIRAM, MALLOC_CAP_DEFAULT | MALLOC_CAP_INTERNAL)
 
 
-// global vars
-bool      s_f_vorbisNewSteamTitle = false;  // streamTitle
-bool      s_f_vorbisNewMetadataBlockPicture = false;
-bool      s_f_oggFirstPage = false;
-bool      s_f_oggContinuedPage = false;
-bool      s_f_oggLastPage = false;
-bool      s_f_parseOggDone = true;
-bool      s_f_lastSegmentTable = false;
-bool      s_f_vorbisStr_found = false;
-uint16_t  s_identificatonHeaderLength = 0;
-uint16_t  s_vorbisCommentHeaderLength = 0;
-uint16_t  s_setupHeaderLength = 0;
-uint8_t   s_pageNr = 0;
-uint16_t  s_oggHeaderSize = 0;
-uint8_t   s_vorbisChannels = 0;
-uint16_t  s_vorbisSamplerate = 0;
-uint16_t  s_lastSegmentTableLen = 0;
-uint8_t  *s_lastSegmentTable = NULL;
-uint32_t  s_vorbisBitRate = 0;
-uint32_t  s_vorbisSegmentLength = 0;
-uint32_t  s_vorbisBlockPicLenUntilFrameEnd = 0;
-uint32_t  s_vorbisCurrentFilePos = 0;
-uint32_t  s_vorbisAudioDataStart = 0;
-char     *s_vorbisChbuf = NULL;
-int32_t   s_vorbisValidSamples = 0;
-int32_t   s_commentBlockSegmentSize = 0;
-uint8_t   s_vorbisOldMode = 0;
-uint32_t  s_blocksizes[2];
-uint32_t  s_vorbisBlockPicPos = 0;
-uint32_t  s_vorbisBlockPicLen = 0;
-int32_t   s_vorbisRemainBlockPicLen = 0;
-int32_t   s_commentLength = 0;
-
-uint8_t   s_nrOfCodebooks = 0;
-uint8_t   s_nrOfFloors = 0;
-uint8_t   s_nrOfResidues = 0;
-uint8_t   s_nrOfMaps = 0;
-uint8_t   s_nrOfModes = 0;
-
-uint16_t *s_vorbisSegmentTable = NULL;
-uint16_t  s_oggPage3Len = 0; // length of the current audio segment
-uint8_t   s_vorbisSegmentTableSize = 0;
-int16_t   s_vorbisSegmentTableRdPtr = -1;
-int8_t    s_vorbisError = 0;
-float     s_vorbisCompressionRatio = 0;
-
-bitReader_t            s_bitReader;
-
-codebook_t            *s_codebooks = NULL;
-vorbis_info_floor_t  **s_floor_param = NULL;
-int8_t                *s_floor_type = NULL;
-vorbis_info_residue_t *s_residue_param = NULL;
-vorbis_info_mapping_t *s_map_param = NULL;
-vorbis_info_mode_t    *s_mode_param = NULL;
-vorbis_dsp_state_t    *s_dsp_state = NULL;
-
-vector<uint32_t>s_vorbisBlockPicItem;
-
-
-bool VORBISDecoder_AllocateBuffers(){
-    s_vorbisSegmentTable = (uint16_t*)__calloc_heap_psram(256, sizeof(uint16_t));
-    s_vorbisChbuf = (char*)__calloc_heap_psram(256, sizeof(char));
-    s_lastSegmentTable = (uint8_t*)__malloc_heap_psram(4096);
-    VORBISsetDefaults();
-    return true;
-}
-void VORBISDecoder_FreeBuffers(){
-    if(s_vorbisSegmentTable) {free(s_vorbisSegmentTable); s_vorbisSegmentTable = NULL;}
-    if(s_vorbisChbuf){free(s_vorbisChbuf); s_vorbisChbuf = NULL;}
-    if(s_lastSegmentTable){free(s_lastSegmentTable); s_lastSegmentTable = NULL;}
-
-    clearGlobalConfigurations();
-}
-void VORBISDecoder_ClearBuffers(){
-    if(s_vorbisChbuf) memset(s_vorbisChbuf, 0, 256);
-    bitReader_clear();
-    if(s_lastSegmentTable) memset(s_lastSegmentTable, 0, 4096);
-    if(s_vorbisSegmentTable) memset(s_vorbisSegmentTable, 0, 256);
-    s_vorbisSegmentTableSize = 0;
-    s_vorbisSegmentTableRdPtr = -1;}
-void VORBISsetDefaults(){
-    s_pageNr = 0;
-    s_f_vorbisNewSteamTitle = false;  // streamTitle
-    s_f_vorbisNewMetadataBlockPicture = false;
-    s_f_lastSegmentTable = false;
-    s_f_parseOggDone = false;
-    s_f_oggFirstPage = false;
-    s_f_oggContinuedPage = false;
-    s_f_oggLastPage = false;
-    s_f_vorbisStr_found = false;
-    if(s_dsp_state){vorbis_dsp_destroy(s_dsp_state); s_dsp_state = NULL;}
-    s_vorbisChannels = 0;
-    s_vorbisSamplerate = 0;
-    s_vorbisBitRate = 0;
-    s_vorbisSegmentLength = 0;
-    s_vorbisValidSamples = 0;
-    s_vorbisSegmentTableSize = 0;
-    s_vorbisCurrentFilePos = 0;
-    s_vorbisAudioDataStart = 0;
-    s_vorbisOldMode = 0xFF;
-    s_vorbisSegmentTableRdPtr = -1;
-    s_vorbisError = 0;
-    s_lastSegmentTableLen = 0;
-    s_vorbisBlockPicPos = 0;
-    s_vorbisBlockPicLen = 0;
-    s_vorbisBlockPicLenUntilFrameEnd = 0;
-    s_commentBlockSegmentSize = 0;
-    s_vorbisBlockPicItem.clear();
-    s_vorbisBlockPicItem.shrink_to_fit();
-
-    VORBISDecoder_ClearBuffers();
-}
-
-void clearGlobalConfigurations() { // mode, mapping, floor etc
-    if(s_nrOfCodebooks) {  // if we have a stream with changing codebooks, delete the old one
-        for(int32_t i = 0; i < s_nrOfCodebooks; i++) { vorbis_book_clear(s_codebooks + i); }
-        s_nrOfCodebooks = 0;
-    }
-    if(s_codebooks) {
-        free(s_codebooks);
-        s_codebooks = NULL;
-    }
-    if(s_dsp_state) {
-        vorbis_dsp_destroy(s_dsp_state);
-        s_dsp_state = NULL;
-    }
-    if(s_nrOfFloors) {
-        for(int32_t i = 0; i < s_nrOfFloors; i++) floor_free_info(s_floor_param[i]);
-        free(s_floor_param);
-        s_nrOfFloors = 0;
-    }
-    if(s_nrOfResidues) {
-        for(int32_t i = 0; i < s_nrOfResidues; i++) res_clear_info(s_residue_param + i);
-        s_nrOfResidues = 0;
-    }
-    if(s_nrOfMaps) {
-        for(int32_t i = 0; i < s_nrOfMaps; i++) { mapping_clear_info(s_map_param + i); }
-        s_nrOfMaps = 0;
-    }
-    if(s_floor_type) {
-        free(s_floor_type);
-        s_floor_type = NULL;
-    }
-    if(s_residue_param) {
-        free(s_residue_param);
-        s_residue_param = NULL;
-    }
-    if(s_map_param) {
-        free(s_map_param);
-        s_map_param = NULL;
-    }
-    if(s_mode_param) {
-        free(s_mode_param);
-        s_mode_param = NULL;
+VORBISDecoder_t* VORBISDecoder_AllocateBuffers(){
+    // every decoder instance owns its complete state, so several streams can be decoded at the same time
+    void* mem = __malloc_heap_psram(sizeof(VORBISDecoder_t));
+    if(!mem){
+        log_e("not enough memory to allocate vorbisdecoder buffers");
+        return NULL;
+    }
+    VORBISDecoder_t* vd = new (mem) VORBISDecoder_t();
+    vd->vorbisSegmentTable = (uint16_t*)__calloc_heap_psram(256, sizeof(uint16_t));
+    vd->vorbisChbuf = (char*)__calloc_heap_psram(256, sizeof(char));
+    vd->lastSegmentTable = (uint8_t*)__malloc_heap_psram(4096);
+    if(!vd->vorbisSegmentTable || !vd->vorbisChbuf || !vd->lastSegmentTable){
+        log_e("not enough memory to allocate vorbisdecoder buffers");
+        VORBISDecoder_FreeBuffers(vd);
+        return NULL;
+    }
+    VORBISsetDefaults(vd);
+    return vd;
+}
+void VORBISDecoder_FreeBuffers(VORBISDecoder_t* vd){
+    if(!vd) return;
+    if(vd->vorbisSegmentTable) {free(vd->vorbisSegmentTable); vd->vorbisSegmentTable = NULL;}
+    if(vd->vorbisChbuf){free(vd->vorbisChbuf); vd->vorbisChbuf = NULL;}
+    if(vd->lastSegmentTable){free(vd->lastSegmentTable); vd->lastSegmentTable = NULL;}
+
+    clearGlobalConfigurations(vd);
+    vd->~VORBISDecoder_t(); // releases the vector
+    free(vd);
+}
+void VORBISDecoder_ClearBuffers(VORBISDecoder_t* vd){
+    if(vd->vorbisChbuf) memset(vd->vorbisChbuf, 0, 256);
+    bitReader_clear(vd);
+    if(vd->lastSegmentTable) memset(vd->lastSegmentTable, 0, 4096);
+    if(vd->vorbisSegmentTable) memset(vd->vorbisSegmentTable, 0, 256);
+    vd->vorbisSegmentTableSize = 0;
+    vd->vorbisSegmentTableRdPtr = -1;
+    memset(&vd->oggCrc, 0, sizeof(oggCrc_t));}
+void VORBISsetDefaults(VORBISDecoder_t* vd){
+    vd->pageNr = 0;
+    vd->f_vorbisNewSteamTitle = false;  // streamTitle
+    vd->f_vorbisNewMetadataBlockPicture = false;
+    vd->f_lastSegmentTable = false;
+    vd->f_parseOggDone = false;
+    vd->f_oggFirstPage = false;
+    vd->f_oggContinuedPage = false;
+    vd->f_oggLastPage = false;
+    vd->f_oggLastPacketContinues = false;
+    vd->f_vorbisStr_found = false;
+    if(vd->dsp_state){vorbis_dsp_destroy(vd, vd->dsp_state); vd->dsp_state = NULL;}
+    vd->vorbisChannels = 0;
+    vd->vorbisSamplerate = 0;
+    vd->vorbisBitRate = 0;
+    vd->vorbisSegmentLength = 0;
+    vd->vorbisValidSamples = 0;
+    vd->vorbisSegmentTableSize = 0;
+    vd->vorbisCurrentFilePos = 0;
+    vd->vorbisAudioDataStart = 0;
+    vd->vorbisOldMode = 0xFF;
+    vd->vorbisSegmentTableRdPtr = -1;
+    vd->vorbisError = 0;
+    vd->lastSegmentTableLen = 0;
+    vd->vorbisBlockPicPos = 0;
+    vd->vorbisBlockPicLen = 0;
+    vd->vorbisBlockPicLenUntilFrameEnd = 0;
+    vd->commentBlockSegmentSize = 0;
+    vd->vorbisBlockPicItem.clear();
+    vd->vorbisBlockPicItem.shrink_to_fit();
+
+    VORBISDecoder_ClearBuffers(vd);
+}
+
+void clearGlobalConfigurations(VORBISDecoder_t* vd) { // mode, mapping, floor etc
+    if(vd->nrOfCodebooks) {  // if we have a stream with changing codebooks, delete the old one
+        for(int32_t i = 0; i < vd->nrOfCodebooks; i++) { vorbis_book_clear(vd->codebooks + i); }
+        vd->nrOfCodebooks = 0;
+    }
+    if(vd->codebooks) {
+        free(vd->codebooks);
+        vd->codebooks = NULL;
+    }
+    if(vd->dsp_state) {
+        vorbis_dsp_destroy(vd, vd->dsp_state);
+        vd->dsp_state = NULL;
+    }
+    if(vd->nrOfFloors) {
+        for(int32_t i = 0; i < vd->nrOfFloors; i++) floor_free_info(vd->floor_param[i]);
+        free(vd->floor_param);
+        vd->nrOfFloors = 0;
+    }
+    if(vd->nrOfResidues) {
+        for(int32_t i = 0; i < vd->nrOfResidues; i++) res_clear_info(vd->residue_param + i);
+        vd->nrOfResidues = 0;
+    }
+    if(vd->nrOfMaps) {
+        for(int32_t i = 0; i < vd->nrOfMaps; i++) { mapping_clear_info(vd->map_param + i); }
+        vd->nrOfMaps = 0;
+    }
+    if(vd->floor_type) {
+        free(vd->floor_type);
+        vd->floor_type = NULL;
+    }
+    if(vd->residue_param) {
+        free(vd->residue_param);
+        vd->residue_param = NULL;
+    }
+    if(vd->map_param) {
+        free(vd->map_param);
+        vd->map_param = NULL;
+    }
+    if(vd->mode_param) {
+        free(vd->mode_param);
+        vd->mode_param = NULL;
     }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t VORBISDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
+int32_t VORBISDecode(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
+    // the CRC of an Ogg page that does not fit into the input window is carried across the calls, see ogg_demuxer.cpp
+    OGGcrcFeed(&vd->oggCrc, inbuf, *bytesLeft);
+    int32_t ret = vorbisDecode(vd, inbuf, bytesLeft, outbuf);
+    OGGcrcConsumed(&vd->oggCrc, *bytesLeft, ret);
+    return ret;
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t vorbisDecode(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
 
     int32_t ret = 0;
     int32_t segmentLength = 0;
 
-    if(s_commentBlockSegmentSize) {
-        if(s_commentBlockSegmentSize > 8192) {
-            s_commentBlockSegmentSize -= 8192;
-            s_commentLength -= 8192;
+    if(vd->commentBlockSegmentSize) {
+        if(vd->commentBlockSegmentSize > 8192) {
+            vd->commentBlockSegmentSize -= 8192;
+            vd->commentLength -= 8192;
             *bytesLeft -= 8192;
-            s_vorbisCurrentFilePos += 8192;
+            vd->vorbisCurrentFilePos += 8192;
         }
         else {
-            *bytesLeft -= s_commentBlockSegmentSize;
-            s_vorbisCurrentFilePos += s_commentBlockSegmentSize;
-            s_commentLength -= s_commentBlockSegmentSize;
-            s_commentBlockSegmentSize = 0;
+            *bytesLeft -= vd->commentBlockSegmentSize;
+            vd->vorbisCurrentFilePos += vd->commentBlockSegmentSize;
+            vd->commentLength -= vd->commentBlockSegmentSize;
+            vd->commentBlockSegmentSize = 0;
         }
-        if(s_vorbisRemainBlockPicLen <= 0 && !s_f_vorbisNewMetadataBlockPicture) {
-            if(s_vorbisBlockPicItem.size() > 0) { // get blockpic data
+        if(vd->vorbisRemainBlockPicLen <= 0 && !vd->f_vorbisNewMetadataBlockPicture) {
+            if(vd->vorbisBlockPicItem.size() > 0) { // get blockpic data
                 // log_i("---------------------------------------------------------------------------");
-                // log_i("metadata blockpic found at pos %i, size %i bytes", s_vorbisBlockPicPos, s_vorbisBlockPicLen);
-                // for(int32_t i = 0; i < s_vorbisBlockPicItem.size(); i += 2) { log_i("segment %02i, pos %07i, len %05i", i / 2, s_vorbisBlockPicItem[i], s_vorbisBlockPicItem[i + 1]); }
+                // log_i("metadata blockpic found at pos %i, size %i bytes", vd->vorbisBlockPicPos, vd->vorbisBlockPicLen);
+                // for(int32_t i = 0; i < vd->vorbisBlockPicItem.size(); i += 2) { log_i("segment %02i, pos %07i, len %05i", i / 2, vd->vorbisBlockPicItem[i], vd->vorbisBlockPicItem[i + 1]); }
                 // log_i("---------------------------------------------------------------------------");
-                s_f_vorbisNewMetadataBlockPicture = true;
+                vd->f_vorbisNewMetadataBlockPicture = true;
             }
         }
         return VORBIS_PARSE_OGG_DONE;
     }
 
-    if(!s_vorbisSegmentTableSize) {
-        s_vorbisSegmentTableRdPtr = -1; // back to the parking position
-        ret = VORBISparseOGG(inbuf, bytesLeft);
-        s_f_parseOggDone = true;
-        if(!s_vorbisSegmentTableSize) { log_w("OggS without segments?"); }
+    int32_t rest = OGGcrcBadPageRest(&vd->oggCrc);
+    if(rest >= 0){ // the remaining packets of a corrupted page
+        *bytesLeft -= rest;
+        vd->vorbisCurrentFilePos += rest;
+        vd->vorbisSegmentTableSize = 0;
+        vd->vorbisSegmentTableRdPtr = -1;
+        vd->f_oggLastPacketContinues = false;
+        return VORBIS_PARSE_OGG_DONE;
+    }
+
+    if(!vd->vorbisSegmentTableSize) {
+        vd->vorbisSegmentTableRdPtr = -1; // back to the parking position
+        ret = VORBISparseOGG(vd, inbuf, bytesLeft);
+        vd->f_parseOggDone = true;
         return ret;
     }
 
-    // With the last segment of a table, we don't know whether it will be continued in the next Ogg page.
-    // So the last segment is saved. s_lastSegmentTableLen specifies the size of the last saved segment.
-    // If the next Ogg Page does not contain a 'continuedPage', the last segment is played first. However,
-    // if 'continuedPage' is set, the first segment of the new page is added to the saved segment and played.
-    if(!s_lastSegmentTableLen){
-        if(s_vorbisSegmentTableSize) {
-            s_vorbisSegmentTableRdPtr++;
-            s_vorbisSegmentTableSize--;
-            segmentLength = s_vorbisSegmentTable[s_vorbisSegmentTableRdPtr];
+    // A packet that continues on the next Ogg page is joined in place if the next page is in the buffer. Otherwise its
+    // first part is saved, vd->lastSegmentTableLen specifies the size of the saved part. If the next Ogg Page contains a
+    // 'continuedPage', its first segment is added to the saved part and played. If not, the saved part is played first.
+    if(!vd->lastSegmentTableLen || vd->f_oggContinuedPage){
+        if(vd->vorbisSegmentTableSize) {
+            vd->vorbisSegmentTableRdPtr++;
+            vd->vorbisSegmentTableSize--;
+            segmentLength = vd->vorbisSegmentTable[vd->vorbisSegmentTableRdPtr];
         }
     }
 
-    if(s_pageNr < 4)
-        if(VORBIS_specialIndexOf(inbuf, "vorbis", 10) == 1) s_pageNr++;
+    if(vd->pageNr < 4)
+        if(VORBIS_specialIndexOf(inbuf, "vorbis", 10) == 1) vd->pageNr++;
 
-    switch(s_pageNr) {
+    switch(vd->pageNr) {
         case 0:
             ret = VORBIS_PARSE_OGG_DONE; // do nothing
             break;
         case 1:
-            ret = vorbisDecodePage1(inbuf, bytesLeft, segmentLength); // blocksize, channels, samplerates
+            ret = vorbisDecodePage1(vd, inbuf, bytesLeft, segmentLength); // blocksize, channels, samplerates
             break;
         case 2:
-            ret = vorbisDecodePage2(inbuf, bytesLeft, segmentLength); // comments
+            ret = vorbisDecodePage2(vd, inbuf, bytesLeft, segmentLength); // comments
             break;
         case 3:
-            ret = vorbisDecodePage3(inbuf, bytesLeft, segmentLength); // codebooks
+            ret = vorbisDecodePage3(vd, inbuf, bytesLeft, segmentLength); // codebooks
             break;
         case 4:
-            ret = vorbisDecodePage4(inbuf, bytesLeft, segmentLength, outbuf); // decode audio
+            ret = vorbisDecodePage4(vd, inbuf, bytesLeft, segmentLength, outbuf); // decode audio
             break;
-        default: log_e("unknown page %s", s_pageNr); break;
+        default: log_e("unknown page %i", vd->pageNr); break;
     }
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage1(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
+int32_t vorbisDecodePage1(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
     int32_t ret = VORBIS_PARSE_OGG_DONE;
-    clearGlobalConfigurations(); // if a new codebook is required, delete the old one
+    clearGlobalConfigurations(vd); // if a new codebook is required, delete the old one
     int32_t idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
     if(idx == 1) {
         // log_i("first packet (identification segmentLength) %i", segmentLength);
-        s_identificatonHeaderLength = segmentLength;
-        ret = parseVorbisFirstPacket(inbuf, segmentLength);
+        vd->identificatonHeaderLength = segmentLength;
+        ret = parseVorbisFirstPacket(vd, inbuf, segmentLength);
     }
     else {
         ret = ERR_VORBIS_NOT_AUDIO; // #651
     }
 
     *bytesLeft -= segmentLength;
-    s_vorbisCurrentFilePos += segmentLength;
+    vd->vorbisCurrentFilePos += segmentLength;
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage2(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
+int32_t vorbisDecodePage2(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
     int32_t ret = VORBIS_PARSE_OGG_DONE;
     int32_t idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
     if(idx == 1) {
-        s_vorbisBlockPicItem.clear();
-        s_vorbisBlockPicItem.shrink_to_fit();
-        s_f_vorbisStr_found = true;
-        s_vorbisCommentHeaderLength = segmentLength;
-        ret = parseVorbisComment(inbuf, segmentLength);
-        s_commentBlockSegmentSize = segmentLength;
-         int32_t pLen = _min((int32_t)s_vorbisBlockPicLen, s_vorbisBlockPicLenUntilFrameEnd);
-        if(s_vorbisBlockPicLen && pLen > 0){
-            s_vorbisBlockPicItem.push_back(s_vorbisBlockPicPos);
-            s_vorbisBlockPicItem.push_back(pLen);
-        }
-        s_vorbisRemainBlockPicLen = s_vorbisBlockPicLen - pLen;
+        vd->vorbisBlockPicItem.clear();
+        vd->vorbisBlockPicItem.shrink_to_fit();
+        vd->f_vorbisStr_found = true;
+        vd->vorbisCommentHeaderLength = segmentLength;
+        ret = parseVorbisComment(vd, inbuf, segmentLength);
+        vd->commentBlockSegmentSize = segmentLength;
+         int32_t pLen = _min((int32_t)vd->vorbisBlockPicLen, (int32_t)vd->vorbisBlockPicLenUntilFrameEnd);
+        if(vd->vorbisBlockPicLen && pLen > 0){
+            vd->vorbisBlockPicItem.push_back(vd->vorbisBlockPicPos);
+            vd->vorbisBlockPicItem.push_back(pLen);
+        }
+        vd->vorbisRemainBlockPicLen = vd->vorbisBlockPicLen - pLen;
         ret = VORBIS_PARSE_OGG_DONE;
     }
     else {
-        s_commentBlockSegmentSize = segmentLength;
-        uint32_t pLen = min(s_vorbisRemainBlockPicLen, (int32_t)segmentLength);
-        if(s_vorbisRemainBlockPicLen && pLen > 0){
-            s_vorbisBlockPicItem.push_back(s_vorbisCurrentFilePos);
-            s_vorbisBlockPicItem.push_back(pLen);
+        vd->commentBlockSegmentSize = segmentLength;
+        uint32_t pLen = min(vd->vorbisRemainBlockPicLen, (int32_t)segmentLength);
+        if(vd->vorbisRemainBlockPicLen && pLen > 0){
+            vd->vorbisBlockPicItem.push_back(vd->vorbisCurrentFilePos);
+            vd->vorbisBlockPicItem.push_back(pLen);
         }
-        s_vorbisRemainBlockPicLen -= segmentLength;
+        vd->vorbisRemainBlockPicLen -= segmentLength;
         ret = VORBIS_PARSE_OGG_DONE;
     }
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
+int32_t vorbisDecodePage3(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
     int32_t ret = VORBIS_PARSE_OGG_DONE;
     int32_t idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
-    s_oggPage3Len = segmentLength;
+    vd->oggPage3Len = segmentLength;
     if(idx == 1) {
         // log_i("third packet (setup segmentLength) %i", segmentLength);
-        s_setupHeaderLength = segmentLength;
-        bitReader_setData(inbuf, segmentLength);
-        if(segmentLength == 4080) {
-            // that is 16*255 bytes and thus the maximum segment size
-            // it is possible that there is another block starting with 'OggS' in which there is information
-            // about codebooks. It is possible that there is another block starting with 'OggS' in which
-            // there is information about codebooks.
-            int32_t l = continuedOggPackets(inbuf + s_oggPage3Len);
-            *bytesLeft -= l;
-            s_vorbisCurrentFilePos += l;
-            s_oggPage3Len += l;
-            s_setupHeaderLength += l;
-            bitReader_setData(inbuf, s_oggPage3Len);
-            log_w("s_oggPage3Len %i", s_oggPage3Len);
-            s_pageNr++;
-        }
-        ret = parseVorbisCodebook();
+        if(vd->f_oggLastPacketContinues && !vd->vorbisSegmentTableSize) {
+            // the codebooks are continued in the next Ogg page, join both parts in place
+            uint8_t* packet = vorbisJoinContinuedPacket(vd, inbuf, bytesLeft, &segmentLength);
+            if(packet) inbuf = packet;
+            else log_e("setup header does not fit into %i bytes", *bytesLeft);
+            vd->oggPage3Len = segmentLength;
+        }
+        vd->setupHeaderLength = segmentLength;
+        bitReader_setData(vd, inbuf, segmentLength);
+        ret = parseVorbisCodebook(vd);
     }
     else { log_e("no \"vorbis\" something went wrong %i", segmentLength); }
-    s_pageNr = 4;
-    s_dsp_state = vorbis_dsp_create();
+    vd->pageNr = 4;
+    vd->dsp_state = vorbis_dsp_create(vd);
 
     *bytesLeft -= segmentLength;
-    s_vorbisCurrentFilePos += segmentLength;
+    vd->vorbisCurrentFilePos += segmentLength;
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage4(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf){
+int32_t vorbisDecodePage4(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf){
 
-    if(s_vorbisAudioDataStart == 0){
-        s_vorbisAudioDataStart = s_vorbisCurrentFilePos;
+    if(vd->vorbisAudioDataStart == 0){
+        vd->vorbisAudioDataStart = vd->vorbisCurrentFilePos;
     }
 
     int32_t ret = 0;
-    if(s_f_parseOggDone) { // first loop after VORBISparseOGG()
-        if(s_f_oggContinuedPage) {
-            if(s_lastSegmentTableLen > 0 || segmentLength > 0) {
-                if(s_lastSegmentTableLen + segmentLength > 1024) log_e("continued page too big");
-                memcpy(s_lastSegmentTable + s_lastSegmentTableLen, inbuf, segmentLength);
-                bitReader_setData(s_lastSegmentTable, s_lastSegmentTableLen + segmentLength);
-                ret = vorbis_dsp_synthesis(s_lastSegmentTable, s_lastSegmentTableLen + segmentLength, outbuf);
-                uint16_t outBuffSize = 2048 * 2;
-                s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                s_lastSegmentTableLen = 0;
-                if(!ret && !segmentLength) ret = VORBIS_CONTINUE;
-            }
-            else { // s_lastSegmentTableLen is 0 and segmentLength is 0
-                s_vorbisValidSamples = 0;
-                ret = VORBIS_CONTINUE;
-            }
-            s_f_oggContinuedPage = false;
-        }
-        else { // last segment without continued Page
-            if(s_lastSegmentTableLen) {
-                bitReader_setData(s_lastSegmentTable, s_lastSegmentTableLen);
-                ret = vorbis_dsp_synthesis(s_lastSegmentTable, s_lastSegmentTableLen, outbuf);
-                uint16_t outBuffSize = 2048 * 2;
-                s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                s_lastSegmentTableLen = 0;
-                if(ret == OV_ENOTAUDIO || ret == 0) ret = VORBIS_CONTINUE; // if no error send continue
+    uint16_t outBuffSize = 2048 * 2;
+    if(vd->f_parseOggDone && vd->f_oggContinuedPage) { // first loop after VORBISparseOGG(), rest of the saved packet
+        if(vd->lastSegmentTableLen > 0 && vd->lastSegmentTableLen + segmentLength <= 4096) {
+            memcpy(vd->lastSegmentTable + vd->lastSegmentTableLen, inbuf, segmentLength);
+            vd->lastSegmentTableLen += segmentLength;
+            if(!vd->vorbisSegmentTableSize && vd->f_oggLastPacketContinues) { // continued once more
+                vd->vorbisValidSamples = 0;
+                ret = 0;
             }
             else {
-                bitReader_setData(inbuf, segmentLength);
-                ret = vorbis_dsp_synthesis(inbuf, segmentLength, outbuf);
-                uint16_t outBuffSize = 2048 * 2;
-                s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                ret = 0;
+                bitReader_setData(vd, vd->lastSegmentTable, vd->lastSegmentTableLen);
+                ret = vorbis_dsp_synthesis(vd, vd->lastSegmentTable, vd->lastSegmentTableLen, outbuf);
+                vd->vorbisValidSamples = vorbis_dsp_pcmout(vd, outbuf, outBuffSize);
+                vd->lastSegmentTableLen = 0;
             }
         }
-    }
-    else { // not s_f_parseOggDone
-        if(s_vorbisSegmentTableSize || s_f_lastSegmentTable) {
-            // if(s_f_oggLastPage) log_i("last page");
-            bitReader_setData(inbuf, segmentLength);
-            ret = vorbis_dsp_synthesis(inbuf, segmentLength, outbuf);
-            uint16_t outBuffSize = 2048 * 2;
-            s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
+        else { // the first part is missing (e.g. after a jump in the file) or the packet is too big, drop it
+            if(vd->lastSegmentTableLen) log_e("continued page too big");
+            vd->lastSegmentTableLen = 0;
+            vd->vorbisValidSamples = 0;
+            ret = VORBIS_PARSE_OGG_DONE;
+        }
+        vd->f_oggContinuedPage = false;
+    }
+    else if(vd->f_parseOggDone && vd->lastSegmentTableLen) { // the page with the rest of the saved packet is missing
+        bitReader_setData(vd, vd->lastSegmentTable, vd->lastSegmentTableLen);
+        ret = vorbis_dsp_synthesis(vd, vd->lastSegmentTable, vd->lastSegmentTableLen, outbuf);
+        vd->vorbisValidSamples = vorbis_dsp_pcmout(vd, outbuf, outBuffSize);
+        vd->lastSegmentTableLen = 0;
+        if(ret == OV_ENOTAUDIO || ret == 0) ret = VORBIS_CONTINUE; // if no error send continue
+    }
+    else if(segmentLength && vd->f_oggLastPacketContinues && !vd->vorbisSegmentTableSize) { // last packet, continues
+        uint8_t* packet = vorbisJoinContinuedPacket(vd, inbuf, bytesLeft, &segmentLength);
+        if(packet) {
+            bitReader_setData(vd, packet, segmentLength);
+            ret = vorbis_dsp_synthesis(vd, packet, segmentLength, outbuf);
+            vd->vorbisValidSamples = vorbis_dsp_pcmout(vd, outbuf, outBuffSize);
             ret = 0;
         }
-        else { // last segment
-            if(segmentLength) {
-                memcpy(s_lastSegmentTable, inbuf, segmentLength);
-                s_lastSegmentTableLen = segmentLength;
-                s_vorbisValidSamples = 0;
-                ret = 0;
-            }
-            else {
-                s_lastSegmentTableLen = 0;
-                s_vorbisValidSamples = 0;
-                ret = VORBIS_PARSE_OGG_DONE;
-            }
+        else if(segmentLength <= 4096) { // next page is not in the buffer, save the first part
+            memcpy(vd->lastSegmentTable, inbuf, segmentLength);
+            vd->lastSegmentTableLen = segmentLength;
+            vd->vorbisValidSamples = 0;
+            ret = 0;
         }
-        s_f_oggFirstPage = false;
+        else {
+            log_e("continued page too big");
+            vd->vorbisValidSamples = 0;
+            ret = VORBIS_PARSE_OGG_DONE;
+        }
+    }
+    else if(segmentLength) { // complete packet, decode it in place
+        bitReader_setData(vd, inbuf, segmentLength);
+        ret = vorbis_dsp_synthesis(vd, inbuf, segmentLength, outbuf);
+        vd->vorbisValidSamples = vorbis_dsp_pcmout(vd, outbuf, outBuffSize);
+        ret = 0;
     }
-    s_f_parseOggDone = false;
-    if(s_f_oggLastPage && !s_vorbisSegmentTableSize) { VORBISsetDefaults(); }
+    else {
+        vd->vorbisValidSamples = 0;
+        ret = VORBIS_PARSE_OGG_DONE;
+    }
+    if(!vd->f_parseOggDone) vd->f_oggFirstPage = false;
+    vd->f_parseOggDone = false;
+    if(vd->f_oggLastPage && !vd->vorbisSegmentTableSize) { VORBISsetDefaults(vd); }
 
     if(ret != VORBIS_CONTINUE){ // nothing to do here, is playing from lastSegmentBuff
         *bytesLeft -= segmentLength;
-        s_vorbisCurrentFilePos += segmentLength;
+        vd->vorbisCurrentFilePos += segmentLength;
     }
     return ret;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-uint8_t VORBISGetChannels(){
-    return s_vorbisChannels;
+uint8_t VORBISGetChannels(VORBISDecoder_t* vd){
+    return vd->vorbisChannels;
 }
-uint32_t VORBISGetSampRate(){
-    return s_vorbisSamplerate;
+uint32_t VORBISGetSampRate(VORBISDecoder_t* vd){
+    return vd->vorbisSamplerate;
 }
 uint8_t VORBISGetBitsPerSample(){
     return 16;
 }
-uint32_t VORBISGetBitRate(){
-    return s_vorbisBitRate;
+uint32_t VORBISGetBitRate(VORBISDecoder_t* vd){
+    return vd->vorbisBitRate;
 }
-uint32_t VORBISGetAudioDataStart(){
-    return s_vorbisAudioDataStart;
+uint32_t VORBISGetAudioDataStart(VORBISDecoder_t* vd){
+    return vd->vorbisAudioDataStart;
 }
-uint16_t VORBISGetOutputSamps(){
-    return s_vorbisValidSamples; // 1024
+uint16_t VORBISGetOutputSamps(VORBISDecoder_t* vd){
+    return vd->vorbisValidSamples; // 1024
 }
-char* VORBISgetStreamTitle(){
-    if(s_f_vorbisNewSteamTitle){
-        s_f_vorbisNewSteamTitle = false;
-        return s_vorbisChbuf;
+char* VORBISgetStreamTitle(VORBISDecoder_t* vd){
+    if(vd->f_vorbisNewSteamTitle){
+        vd->f_vorbisNewSteamTitle = false;
+        return vd->vorbisChbuf;
     }
     return NULL;
 }
-vector<uint32_t> VORBISgetMetadataBlockPicture(){
-    if(s_f_vorbisNewMetadataBlockPicture){
-        s_f_vorbisNewMetadataBlockPicture = false;
-        return s_vorbisBlockPicItem;
+vector<uint32_t> VORBISgetMetadataBlockPicture(VORBISDecoder_t* vd){
+    if(vd->f_vorbisNewMetadataBlockPicture){
+        vd->f_vorbisNewMetadataBlockPicture = false;
+        return vd->vorbisBlockPicItem;
     }
-    if(s_vorbisBlockPicItem.size() > 0){
-        s_vorbisBlockPicItem.clear();
-        s_vorbisBlockPicItem.shrink_to_fit();
+    if(vd->vorbisBlockPicItem.size() > 0){
+        vd->vorbisBlockPicItem.clear();
+        vd->vorbisBlockPicItem.shrink_to_fit();
     }
-    return s_vorbisBlockPicItem;
+    return vd->vorbisBlockPicItem;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identification header
+int32_t parseVorbisFirstPacket(VORBISDecoder_t* vd, uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identification header
                                                             // https://xiph.org/vorbis/doc/Vorbis_I_spec.html#x1-820005
     // first bytes are: '.vorbis'
     uint16_t pos = 7;
@@ -496,19 +467,19 @@ int32_t parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identi
 
     uint8_t  blocksize   = *(inbuf + pos + 21);
 
-    s_blocksizes[0] = 1 << ( blocksize & 0x0F);
-    s_blocksizes[1] = 1 << ((blocksize & 0xF0) >> 4);
+    vd->blocksizes[0] = 1 << ( blocksize & 0x0F);
+    vd->blocksizes[1] = 1 << ((blocksize & 0xF0) >> 4);
 
-    if(s_blocksizes[0] < 64){
+    if(vd->blocksizes[0] < 64){
         log_e("blocksize[0] too low");
         return -1;
     }
-    if(s_blocksizes[1] < s_blocksizes[0]){
-        log_e("s_blocksizes[1] is smaller than s_blocksizes[0]");
+    if(vd->blocksizes[1] < vd->blocksizes[0]){
+        log_e("vd->blocksizes[1] is smaller than vd->blocksizes[0]");
         return -1;
     }
-    if(s_blocksizes[1] > 8192){
-        log_e("s_blocksizes[1] is too big");
+    if(vd->blocksizes[1] > 8192){
+        log_e("vd->blocksizes[1] is too big");
         return -1;
     }
 
@@ -516,21 +487,21 @@ int32_t parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identi
         log_e("nr of channels is not valid ch=%i", channels);
         return -1;
     }
-    s_vorbisChannels = channels;
+    vd->vorbisChannels = channels;
 
     if(sampleRate < 4096 || sampleRate > 64000){
         log_e("sampleRate is not valid sr=%i", sampleRate);
         return -1;
     }
-    s_vorbisSamplerate = sampleRate;
+    vd->vorbisSamplerate = sampleRate;
 
-    s_vorbisBitRate = br_nominal;
+    vd->vorbisBitRate = br_nominal;
 
     return VORBIS_PARSE_OGG_DONE;
 
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference https://xiph.org/vorbis/doc/v-comment.html
+int32_t parseVorbisComment(VORBISDecoder_t* vd, uint8_t *inbuf, int16_t nBytes){      // reference https://xiph.org/vorbis/doc/v-comment.html
 
     // first bytes are: '.vorbis'
     uint32_t pos = 7;
@@ -544,18 +515,18 @@ int32_t parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference ht
        return 0;
     }
 
-    memcpy(s_vorbisChbuf, inbuf + 11, vendorLength);
-    s_vorbisChbuf[vendorLength] = '\0';
+    memcpy(vd->vorbisChbuf, inbuf + 11, vendorLength);
+    vd->vorbisChbuf[vendorLength] = '\0';
     pos += 4 + vendorLength;
-    s_vorbisCommentHeaderLength -= (7 + 4 + vendorLength);
+    vd->vorbisCommentHeaderLength -= (7 + 4 + vendorLength);
 
     // log_i("vendorLength %x", vendorLength);
-    // log_i("vendorString %s", s_vorbisChbuf);
+    // log_i("vendorString %s", vd->vorbisChbuf);
 
     uint8_t nrOfComments = *(inbuf + pos);
     // log_i("nrOfComments %i", nrOfComments);
     pos += 4;
-    s_vorbisCommentHeaderLength -= 4;
+    vd->vorbisCommentHeaderLength -= 4;
 
     int32_t idx = 0;
     char* artist = NULL;
@@ -567,45 +538,45 @@ int32_t parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference ht
         commentLength += *(inbuf + pos + 2) << 16;
         commentLength += *(inbuf + pos + 1) << 8;
         commentLength += *(inbuf + pos);
-        s_commentLength = commentLength;
+        vd->commentLength = commentLength;
 
         uint8_t cl = min((uint32_t)254, commentLength);
-        memcpy(s_vorbisChbuf, inbuf + pos +  4, cl);
-        s_vorbisChbuf[cl] = '\0';
+        memcpy(vd->vorbisChbuf, inbuf + pos +  4, cl);
+        vd->vorbisChbuf[cl] = '\0';
 
-        // log_i("commentLength %i comment %s", commentLength, s_vorbisChbuf);
+        // log_i("commentLength %i comment %s", commentLength, vd->vorbisChbuf);
 
-        idx =        VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "artist=", 10);
-        if(idx != 0) idx =  VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "ARTIST=", 10);
-        if(idx == 0){ artist = strndup((const char*)(s_vorbisChbuf + 7), commentLength - 7); s_commentLength = 0;}
+        idx =        VORBIS_specialIndexOf((uint8_t*)vd->vorbisChbuf, "artist=", 10);
+        if(idx != 0) idx =  VORBIS_specialIndexOf((uint8_t*)vd->vorbisChbuf, "ARTIST=", 10);
+        if(idx == 0){ artist = strndup((const char*)(vd->vorbisChbuf + 7), commentLength - 7); vd->commentLength = 0;}
 
-        idx =        VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "title=", 10);
-        if(idx != 0) idx =  VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "TITLE=", 10);
-        if(idx == 0){ title = strndup((const char*)(s_vorbisChbuf + 6), commentLength - 6); s_commentLength = 0;}
+        idx =        VORBIS_specialIndexOf((uint8_t*)vd->vorbisChbuf, "title=", 10);
+        if(idx != 0) idx =  VORBIS_specialIndexOf((uint8_t*)vd->vorbisChbuf, "TITLE=", 10);
+        if(idx == 0){ title = strndup((const char*)(vd->vorbisChbuf + 6), commentLength - 6); vd->commentLength = 0;}
 
-        idx =        VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "metadata_block_picture=", 25);
-        if(idx != 0) idx =  VORBIS_specialIndexOf((uint8_t*)s_vorbisChbuf, "METADATA_BLOCK_PICTURE", 25);
+        idx =        VORBIS_specialIndexOf((uint8_t*)vd->vorbisChbuf, "metadata_block_picture=", 25);
+        if(idx != 0) idx =  VORBIS_specialIndexOf((uint8_t*)vd->vorbisChbuf, "METADATA_BLOCK_PICTURE", 25);
         if(idx == 0){
-            s_vorbisBlockPicLen = commentLength - 23;
-            s_vorbisBlockPicPos += s_vorbisCurrentFilePos + 4 +pos + 23;
-            s_vorbisBlockPicLenUntilFrameEnd = s_vorbisCommentHeaderLength - 4 - 23;
+            vd->vorbisBlockPicLen = commentLength - 23;
+            vd->vorbisBlockPicPos += vd->vorbisCurrentFilePos + 4 +pos + 23;
+            vd->vorbisBlockPicLenUntilFrameEnd = vd->vorbisCommentHeaderLength - 4 - 23;
         }
         pos += commentLength + 4;
-        s_vorbisCommentHeaderLength -= (4 + commentLength);
+        vd->vorbisCommentHeaderLength -= (4 + commentLength);
     }
     if(artist && title){
-        strcpy(s_vorbisChbuf, artist);
-        strcat(s_vorbisChbuf, " - ");
-        strcat(s_vorbisChbuf, title);
-        s_f_vorbisNewSteamTitle = true;
+        strcpy(vd->vorbisChbuf, artist);
+        strcat(vd->vorbisChbuf, " - ");
+        strcat(vd->vorbisChbuf, title);
+        vd->f_vorbisNewSteamTitle = true;
     }
     else if(artist){
-        strcpy(s_vorbisChbuf, artist);
-        s_f_vorbisNewSteamTitle = true;
+        strcpy(vd->vorbisChbuf, artist);
+        vd->f_vorbisNewSteamTitle = true;
     }
     else if(title){
-        strcpy(s_vorbisChbuf, title);
-        s_f_vorbisNewSteamTitle = true;
+        strcpy(vd->vorbisChbuf, title);
+        vd->f_vorbisNewSteamTitle = true;
     }
     if(artist){free(artist); artist = NULL;}
     if(title) {free(title);  title = NULL;}
@@ -613,96 +584,96 @@ int32_t parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference ht
     return VORBIS_PARSE_OGG_DONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseVorbisCodebook(){
+int32_t parseVorbisCodebook(VORBISDecoder_t* vd){
 
-    s_bitReader.headptr += 7;
-    s_bitReader.length = s_oggPage3Len;
+    vd->bitReaderState.headptr += 7;
+    vd->bitReaderState.length = vd->oggPage3Len;
 
     int32_t i;
     int32_t ret = 0;
 
-    s_nrOfCodebooks = bitReader(8) +1;
-    s_codebooks = (codebook_t*) __calloc_heap_psram(s_nrOfCodebooks, sizeof(*s_codebooks));
+    vd->nrOfCodebooks = bitReader(vd, 8) +1;
+    vd->codebooks = (codebook_t*) __calloc_heap_psram(vd->nrOfCodebooks, sizeof(*vd->codebooks));
 
-    for(i = 0; i < s_nrOfCodebooks; i++){
-        ret = vorbis_book_unpack(s_codebooks + i);
+    for(i = 0; i < vd->nrOfCodebooks; i++){
+        ret = vorbis_book_unpack(vd, vd->codebooks + i);
         if(ret) log_e("codebook %i returned err", i);
         if(ret) goto err_out;
     }
 
     /* time backend settings, not actually used */
-    i = bitReader(6);
+    i = bitReader(vd, 6);
     for(; i >= 0; i--){
-        ret = bitReader(16);
+        ret = bitReader(vd, 16);
         if(ret != 0){
             log_e("err while reading backend settings");
             goto err_out;
         }
     }
     /* floor backend settings */
-    s_nrOfFloors  = bitReader(6) + 1;
+    vd->nrOfFloors  = bitReader(vd, 6) + 1;
 
-    s_floor_param = (vorbis_info_floor_t **)__malloc_heap_psram(sizeof(*s_floor_param) * s_nrOfFloors);
-    s_floor_type  = (int8_t *)__malloc_heap_psram(sizeof(int8_t) * s_nrOfFloors);
-    for(i = 0; i < s_nrOfFloors; i++) {
-        s_floor_type[i] = bitReader(16);
-        if(s_floor_type[i] < 0 || s_floor_type[i] >= VI_FLOORB) {
+    vd->floor_param = (vorbis_info_floor_t **)__malloc_heap_psram(sizeof(*vd->floor_param) * vd->nrOfFloors);
+    vd->floor_type  = (int8_t *)__malloc_heap_psram(sizeof(int8_t) * vd->nrOfFloors);
+    for(i = 0; i < vd->nrOfFloors; i++) {
+        vd->floor_type[i] = bitReader(vd, 16);
+        if(vd->floor_type[i] < 0 || vd->floor_type[i] >= VI_FLOORB) {
             log_e("err while reading floors");
             goto err_out;
         }
-        if(s_floor_type[i]){
-            s_floor_param[i] = floor1_info_unpack();
+        if(vd->floor_type[i]){
+            vd->floor_param[i] = floor1_info_unpack(vd);
         }
         else{
-            s_floor_param[i] = floor0_info_unpack();
+            vd->floor_param[i] = floor0_info_unpack(vd);
         }
-        if(!s_floor_param[i]){
+        if(!vd->floor_param[i]){
             log_e("floor parameter not found");
             goto err_out;
         }
     }
 
     /* residue backend settings */
-    s_nrOfResidues = bitReader(6) + 1;
-    s_residue_param = (vorbis_info_residue_t *)__malloc_heap_psram(sizeof(*s_residue_param) * s_nrOfResidues);
-    for(i = 0; i < s_nrOfResidues; i++){
-         if(res_unpack(s_residue_param + i)){
+    vd->nrOfResidues = bitReader(vd, 6) + 1;
+    vd->residue_param = (vorbis_info_residue_t *)__malloc_heap_psram(sizeof(*vd->residue_param) * vd->nrOfResidues);
+    for(i = 0; i < vd->nrOfResidues; i++){
+         if(res_unpack(vd, vd->residue_param + i)){
             log_e("err while unpacking residues");
             goto err_out;
          }
     }
 
     // /* map backend settings */
-    s_nrOfMaps = bitReader(6) + 1;
-    s_map_param = (vorbis_info_mapping_t *)__malloc_heap_psram(sizeof(*s_map_param) * s_nrOfMaps);
-    for(i = 0; i < s_nrOfMaps; i++) {
-        if(bitReader(16) != 0) goto err_out;
-        if(mapping_info_unpack(s_map_param + i)){
+    vd->nrOfMaps = bitReader(vd, 6) + 1;
+    vd->map_param = (vorbis_info_mapping_t *)__malloc_heap_psram(sizeof(*vd->map_param) * vd->nrOfMaps);
+    for(i = 0; i < vd->nrOfMaps; i++) {
+        if(bitReader(vd, 16) != 0) goto err_out;
+        if(mapping_info_unpack(vd, vd->map_param + i)){
             log_e("err while unpacking mappings");
             goto err_out;
         }
     }
 
     /* mode settings */
-    s_nrOfModes = bitReader(6) + 1;
-    s_mode_param = (vorbis_info_mode_t *)__malloc_heap_psram(s_nrOfModes* sizeof(*s_mode_param));
-    for(i = 0; i < s_nrOfModes; i++) {
-        s_mode_param[i].blockflag = bitReader(1);
-        if(bitReader(16)) goto err_out;
-        if(bitReader(16)) goto err_out;
-        s_mode_param[i].mapping = bitReader(8);
-        if(s_mode_param[i].mapping >= s_nrOfMaps){
+    vd->nrOfModes = bitReader(vd, 6) + 1;
+    vd->mode_param = (vorbis_info_mode_t *)__malloc_heap_psram(vd->nrOfModes* sizeof(*vd->mode_param));
+    for(i = 0; i < vd->nrOfModes; i++) {
+        vd->mode_param[i].blockflag = bitReader(vd, 1);
+        if(bitReader(vd, 16)) goto err_out;
+        if(bitReader(vd, 16)) goto err_out;
+        vd->mode_param[i].mapping = bitReader(vd, 8);
+        if(vd->mode_param[i].mapping >= vd->nrOfMaps){
             log_e("too many modes");
             goto err_out;
         }
     }
 
-    if(bitReader(1) != 1){
+    if(bitReader(vd, 1) != 1){
         log_e("codebooks, end bit not found");
         goto err_out;
     }
-    // if(s_setupHeaderLength != s_bitReader.headptr - s_bitReader.data){
-    //     log_e("Error reading setup header, assumed %i bytes, read %i bytes", s_setupHeaderLength, s_bitReader.headptr - s_bitReader.data);
+    // if(vd->setupHeaderLength != vd->bitReaderState.headptr - vd->bitReaderState.data){
+    //     log_e("Error reading setup header, assumed %i bytes, read %i bytes", vd->setupHeaderLength, vd->bitReaderState.headptr - vd->bitReaderState.data);
     //     goto err_out;
     // }
     /* top level EOP check */
@@ -711,132 +682,81 @@ int32_t parseVorbisCodebook(){
 
 err_out:
 //    vorbis_info_clear(vi);
-    log_e("err in codebook!  at pos %d", s_bitReader.headptr - s_bitReader.data);
+    log_e("err in codebook!  at pos %d", (int)(vd->bitReaderState.headptr - vd->bitReaderState.data));
     return (OV_EBADHEADER);
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t VORBISparseOGG(uint8_t *inbuf, int32_t *bytesLeft){
+int32_t VORBISparseOGG(VORBISDecoder_t* vd, uint8_t *inbuf, int32_t *bytesLeft){
                                                            // reference https://www.xiph.org/ogg/doc/rfc3533.txt
-    int32_t ret = 0; (void)ret;
-
-    int32_t idx = VORBIS_specialIndexOf(inbuf, "OggS", 8192);
+    int32_t idx = OGGfindSyncWord(inbuf, *bytesLeft);
     if(idx != 0){
-        if(s_f_oggContinuedPage) return ERR_VORBIS_DECODER_ASYNC;
+        if(vd->f_oggContinuedPage || idx < 0) return ERR_VORBIS_DECODER_ASYNC;
         inbuf += idx;
         *bytesLeft -= idx;
-        s_vorbisCurrentFilePos += idx;
-    }
-
-    int16_t segmentTableWrPtr = -1;
-
-    uint8_t  version            = *(inbuf +  4); (void) version;
-    uint8_t  headerType         = *(inbuf +  5); (void) headerType;
-    uint64_t granulePosition    = (uint64_t)*(inbuf + 13) << 56;  // granule_position: an 8 Byte field containing -
-             granulePosition   += (uint64_t)*(inbuf + 12) << 48;  // position information. For an audio stream, it MAY
-             granulePosition   += (uint64_t)*(inbuf + 11) << 40;  // contain the total number of PCM samples encoded
-             granulePosition   += (uint64_t)*(inbuf + 10) << 32;  // after including all frames finished on this page.
-             granulePosition   += *(inbuf +  9) << 24;  // This is a hint for the decoder and gives it some timing
-             granulePosition   += *(inbuf +  8) << 16;  // and position information. A special value of -1 (in two's
-             granulePosition   += *(inbuf +  7) << 8;   // complement) indicates that no packets finish on this page.
-             granulePosition   += *(inbuf +  6); (void) granulePosition;
-    uint32_t bitstreamSerialNr  = *(inbuf + 17) << 24;  // bitstream_serial_number: a 4 Byte field containing the
-             bitstreamSerialNr += *(inbuf + 16) << 16;  // unique serial number by which the logical bitstream
-             bitstreamSerialNr += *(inbuf + 15) << 8;   // is identified.
-             bitstreamSerialNr += *(inbuf + 14); (void) bitstreamSerialNr;
-    uint32_t pageSequenceNr     = *(inbuf + 21) << 24;  // page_sequence_number: a 4 Byte field containing the sequence
-             pageSequenceNr    += *(inbuf + 20) << 16;  // number of the page so the decoder can identify page loss
-             pageSequenceNr    += *(inbuf + 19) << 8;   // This sequence number is increasing on each logical bitstream
-             pageSequenceNr    += *(inbuf + 18); (void) pageSequenceNr;
-    uint32_t CRCchecksum        = *(inbuf + 25) << 24;
-             CRCchecksum       += *(inbuf + 24) << 16;
-             CRCchecksum       += *(inbuf + 23) << 8;
-             CRCchecksum       += *(inbuf + 22); (void) CRCchecksum;
-    uint8_t  pageSegments       = *(inbuf + 26);        // giving the number of segment entries
-
-    // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
-    // 255: A second byte is needed.  The total length is first_byte + second byte
-    s_vorbisSegmentLength = 0;
-    segmentTableWrPtr = -1;
-
-    for(int32_t i = 0; i < pageSegments; i++){
-        int32_t n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            if(i == pageSegments) break;
-            n+= *(inbuf + 27 + i);
-        }
-        segmentTableWrPtr++;
-        s_vorbisSegmentTable[segmentTableWrPtr] = n;
-        s_vorbisSegmentLength += n;
-    }
-    s_vorbisSegmentTableSize = segmentTableWrPtr + 1;
-    s_vorbisCompressionRatio = (float)(960 * 2 * pageSegments)/s_vorbisSegmentLength;  // const 960 validBytes out
-
-    bool     continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
-    bool     firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
-    bool     lastPage      = headerType & 0x04; // set: this is the last page of a logical bitstream (eos)
-
-    uint16_t headerSize    = pageSegments + 27;
-
-    // log_i("headerSize %i, s_vorbisSegmentLength %i, s_vorbisSegmentTableSize %i", headerSize, s_vorbisSegmentLength, s_vorbisSegmentTableSize);
-    if(firstPage || continuedPage || lastPage){
-    // log_w("firstPage %i  continuedPage %i  lastPage %i", firstPage, continuedPage, lastPage);
+        vd->vorbisCurrentFilePos += idx;
+    }
+
+    oggPage_t page;
+    int32_t headerSize = OGGparsePage(inbuf, *bytesLeft, &page, vd->vorbisSegmentTable, &vd->oggCrc);
+    if(headerSize == ERR_OGG_CRC){ // the whole page is in the buffer, skip it
+        log_w("Ogg page %u: CRC error, page skipped", page.sequenceNr);
+        *bytesLeft -= page.headerSize + page.bodySize;
+        vd->vorbisCurrentFilePos += page.headerSize + page.bodySize;
+        vd->vorbisSegmentTableSize = 0;
+        vd->f_oggLastPacketContinues = false;
+        return VORBIS_PARSE_OGG_DONE;
     }
+    if(headerSize < 0) return ERR_VORBIS_DECODER_ASYNC;
+
+    vd->vorbisSegmentLength = page.bodySize;
+    vd->vorbisSegmentTableSize = page.packets;
+    if(!vd->vorbisSegmentTableSize) { log_w("OggS without segments?"); }
+    vd->vorbisCompressionRatio = (float)(960 * 2 * (page.headerSize - 27))/vd->vorbisSegmentLength;  // const 960 validBytes out
+
+    // log_i("headerSize %i, vd->vorbisSegmentLength %i, vd->vorbisSegmentTableSize %i", headerSize, vd->vorbisSegmentLength, vd->vorbisSegmentTableSize);
 
     *bytesLeft -= headerSize;
-    inbuf += headerSize;
-    s_vorbisCurrentFilePos += headerSize;
- //   if(s_pageNr < 4 && !continuedPage) s_pageNr++;
+    vd->vorbisCurrentFilePos += headerSize;
 
-    s_f_oggFirstPage = firstPage;
-    s_f_oggContinuedPage = continuedPage;
-    s_f_oggLastPage = lastPage;
-    s_oggHeaderSize = headerSize;
+    vd->f_oggFirstPage = OGGisFirstPage(&page);         // set: this is the first page of a logical bitstream (bos)
+    vd->f_oggContinuedPage = OGGisContinuedPage(&page); // set: page contains data of a packet continued from the previous page
+    vd->f_oggLastPage = OGGisLastPage(&page);           // set: this is the last page of a logical bitstream (eos)
+    vd->f_oggLastPacketContinues = page.lastPacketContinues;
+    vd->oggHeaderSize = headerSize;
 
-    if(firstPage) s_pageNr = 0;
+    if(vd->f_oggFirstPage) vd->pageNr = 0;
 
     return VORBIS_PARSE_OGG_DONE; // no error
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint16_t continuedOggPackets(uint8_t *inbuf){
-
-    // skip OggS header to pageSegments
-    // log_w("%c%c%c%c", *(inbuf+0), *(inbuf+1), *(inbuf+2), *(inbuf+3));
-    uint16_t segmentLength = 0;
-    uint8_t  headerType    = *(inbuf +  5);
-    uint8_t  pageSegments  = *(inbuf + 26);        // giving the number of segment entries
-
-    for(int32_t i = 0; i < pageSegments; i++){
-        int32_t n = *(inbuf + 27 + i);
-        while(*(inbuf + 27 + i) == 255){
-            i++;
-            if(i == pageSegments) break;
-            n+= *(inbuf + 27 + i);
-        }
-        segmentLength += n;
-    }
-    uint16_t headerSize = pageSegments + 27;
-    bool continuedPage = headerType & 0x01;
-
-    if(continuedPage){
-
-    //  codebook data are in 2 ogg packets
-    //  codebook data must no be interrupted by oggPH (ogg page header)
-    //  therefore shift codebook data2 left (oggPH size times) whith memmove
-    //  |oggPH| codebook data 1 |oggPH| codebook data 2 |oggPH|
-    //  |oppPH| codebook data 1 + 2              |unused|occPH|
-log_e("continued page");
-        memmove(inbuf , inbuf + headerSize, segmentLength);
-        return segmentLength + headerSize;
-        return 0;
-    }
-
-    return 0;
+uint8_t* vorbisJoinContinuedPacket(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t* segmentLength){
+
+    // the last packet of the page continues on the next page, the next page header is skipped and both parts are
+    // joined in place, the joined packet starts behind the gap. Returns NULL if the next page is not in the buffer
+    //  |part 1|oggPH|part 2|packet|...
+    //  |gap   |part 1 + 2  |packet|...
+    oggPage_t page;
+    uint8_t* packet = OGGjoinContinuedPacket(inbuf, *segmentLength, *bytesLeft, &page, vd->vorbisSegmentTable, &vd->oggCrc);
+    if(!packet) return NULL;
+
+    *bytesLeft -= page.headerSize;
+    vd->vorbisCurrentFilePos += page.headerSize;
+    *segmentLength += vd->vorbisSegmentTable[0];
+
+    vd->vorbisSegmentTableRdPtr = 0; // continue with the remaining packets of the next page
+    vd->vorbisSegmentTableSize = page.packets - 1;
+    vd->vorbisSegmentLength = page.bodySize;
+    vd->oggHeaderSize = page.headerSize;
+    vd->f_oggFirstPage = OGGisFirstPage(&page);
+    vd->f_oggContinuedPage = false;
+    vd->f_oggLastPage = OGGisLastPage(&page);
+    vd->f_oggLastPacketContinues = page.lastPacketContinues;
+    return packet;
 }
 //----------------------------------------------------------------------------------------------------------------------
 int32_t VORBISFindSyncWord(unsigned char *buf, int32_t nBytes){
     // assume we have a ogg wrapper
-    int32_t idx = VORBIS_specialIndexOf(buf, "OggS", nBytes);
+    int32_t idx = OGGfindSyncWord(buf, nBytes);
     if(idx >= 0){ // Magic Word found
     //    log_i("OggS found at %i", idx);
         return idx;
@@ -845,7 +765,7 @@ int32_t VORBISFindSyncWord(unsigned char *buf, int32_t nBytes){
     return ERR_VORBIS_OGG_SYNC_NOT_FOUND;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t vorbis_book_unpack(codebook_t *s) {
+int32_t vorbis_book_unpack(VORBISDecoder_t* vd, codebook_t *s) {
     char   *lengthlist = NULL;
     uint8_t quantvals = 0;
     int32_t i, j;
@@ -855,36 +775,36 @@ int32_t vorbis_book_unpack(codebook_t *s) {
     memset(s, 0, sizeof(*s));
 
     /* make sure alignment is correct */
-    if(bitReader(24) != 0x564342){
+    if(bitReader(vd, 24) != 0x564342){
         log_e("String \"BCV\" not found");
         goto _eofout;  // "BCV"
     }
 
     /* first the basic parameters */
-    ret = bitReader(16) ;
+    ret = bitReader(vd, 16) ;
     if(ret < 0) printf("error in vorbis_book_unpack, ret =%li\n", (long int)ret);
     if(ret > 255) printf("error in vorbis_book_unpack, ret =%li\n", (long int)ret);
     s->dim = (uint8_t)ret;
-    s->entries = bitReader(24);
+    s->entries = bitReader(vd, 24);
     if(s->entries == -1) {log_e("no entries in unpack codebooks ?");   goto _eofout;}
 
     /* codeword ordering.... length ordered or unordered? */
-    switch(bitReader(1)) {
+    switch(bitReader(vd, 1)) {
         case 0:
             /* unordered */
             lengthlist = (char *)__malloc_heap_psram(sizeof(*lengthlist) * s->entries);
 
             /* allocated but unused entries? */
-            if(bitReader(1)) {
+            if(bitReader(vd, 1)) {
                 /* yes, unused entries */
 
                 for(i = 0; i < s->entries; i++) {
-                    if(bitReader(1)) {
-                        int32_t num = bitReader(5);
+                    if(bitReader(vd, 1)) {
+                        int32_t num = bitReader(vd, 5);
                         if(num == -1) goto _eofout;
                         lengthlist[i] = num + 1;
                         s->used_entries++;
-                        if(num + 1 > s->dec_maxlength) s->dec_maxlength = num + 1;
+                        if((uint32_t)num + 1 > s->dec_maxlength) s->dec_maxlength = num + 1;
                     }
                     else
                         lengthlist[i] = 0;
@@ -894,24 +814,24 @@ int32_t vorbis_book_unpack(codebook_t *s) {
                 /* all entries used; no tagging */
                 s->used_entries = s->entries;
                 for(i = 0; i < s->entries; i++) {
-                    int32_t num = bitReader(5);
+                    int32_t num = bitReader(vd, 5);
                     if(num == -1) goto _eofout;
                     lengthlist[i] = num + 1;
 
-                    if(num + 1 > s->dec_maxlength) s->dec_maxlength = num + 1;
+                    if((uint32_t)num + 1 > s->dec_maxlength) s->dec_maxlength = num + 1;
                 }
             }
             break;
         case 1:
             /* ordered */
             {
-                int32_t length = bitReader(5) + 1;
+                int32_t length = bitReader(vd, 5) + 1;
 
                 s->used_entries = s->entries;
                 lengthlist = (char *)__malloc_heap_psram(sizeof(*lengthlist) * s->entries);
 
                 for(i = 0; i < s->entries;) {
-                    int32_t num = bitReader(_ilog(s->entries - i));
+                    int32_t num = bitReader(vd, _ilog(s->entries - i));
                     if(num == -1) goto _eofout;
                     for(j = 0; j < num && i < s->entries; j++, i++) lengthlist[i] = length;
                     s->dec_maxlength = length;
@@ -925,12 +845,12 @@ int32_t vorbis_book_unpack(codebook_t *s) {
     }
 
     /* Do we have a mapping to unpack? */
-    if((maptype = bitReader(4)) > 0) {
-        s->q_min = _float32_unpack(bitReader(32), &s->q_minp);
-        s->q_del = _float32_unpack(bitReader(32), &s->q_delp);
+    if((maptype = bitReader(vd, 4)) > 0) {
+        s->q_min = _float32_unpack(bitReader(vd, 32), &s->q_minp);
+        s->q_del = _float32_unpack(bitReader(vd, 32), &s->q_delp);
 
-        s->q_bits = bitReader(4) + 1;
-        s->q_seq =  bitReader(1);
+        s->q_bits = bitReader(vd, 4) + 1;
+        s->q_seq =  bitReader(vd, 1);
 
         s->q_del >>= s->q_bits;
         s->q_delp += s->q_bits;
@@ -944,7 +864,7 @@ int32_t vorbis_book_unpack(codebook_t *s) {
             s->dec_nodeb = _determine_node_bytes(s->used_entries, _ilog(s->entries) / 8 + 1);
             s->dec_leafw = _determine_leaf_words(s->dec_nodeb, _ilog(s->entries) / 8 + 1);
             s->dec_type = 0;
-            ret = _make_decode_table(s, lengthlist, quantvals, maptype);
+            ret = _make_decode_table(vd, s, lengthlist, quantvals, maptype);
             if(ret != 0) {
                  goto _errout;
             }
@@ -965,9 +885,9 @@ int32_t vorbis_book_unpack(codebook_t *s) {
                     /* use dec_type 1: vector of packed values */
                     /* need quantized values before  */
                     s->q_val = __malloc_heap_psram(sizeof(uint16_t) * quantvals);
-                    for(i = 0; i < quantvals; i++) ((uint16_t *)s->q_val)[i] = bitReader(s->q_bits);
+                    for(i = 0; i < quantvals; i++) ((uint16_t *)s->q_val)[i] = bitReader(vd, s->q_bits);
 
-                    if(oggpack_eop()) {
+                    if(oggpack_eop(vd)) {
                         if(s->q_val) {free(s->q_val), s->q_val = NULL;}
                         goto _eofout;
                     }
@@ -975,7 +895,7 @@ int32_t vorbis_book_unpack(codebook_t *s) {
                     s->dec_type = 1;
                     s->dec_nodeb = _determine_node_bytes(s->used_entries, (s->q_bits * s->dim + 8) / 8);
                     s->dec_leafw = _determine_leaf_words(s->dec_nodeb, (s->q_bits * s->dim + 8) / 8);
-                    ret = _make_decode_table(s, lengthlist, quantvals, maptype);
+                    ret = _make_decode_table(vd, s, lengthlist, quantvals, maptype);
                     if(ret) {
                         if(s->q_val) {free(s->q_val), s->q_val = NULL;}
                         goto _errout;
@@ -988,21 +908,21 @@ int32_t vorbis_book_unpack(codebook_t *s) {
                     /* need quantized values before */
                     if(s->q_bits <= 8) {
                         s->q_val = __malloc_heap_psram(quantvals);
-                        for(i = 0; i < quantvals; i++) ((uint8_t *)s->q_val)[i] = bitReader(s->q_bits);
+                        for(i = 0; i < quantvals; i++) ((uint8_t *)s->q_val)[i] = bitReader(vd, s->q_bits);
                     }
                     else {
                         s->q_val = __malloc_heap_psram(quantvals * 2);
-                        for(i = 0; i < quantvals; i++) ((uint16_t *)s->q_val)[i] = bitReader(s->q_bits);
+                        for(i = 0; i < quantvals; i++) ((uint16_t *)s->q_val)[i] = bitReader(vd, s->q_bits);
                     }
 
-                    if(oggpack_eop()) goto _eofout;
+                    if(oggpack_eop(vd)) goto _eofout;
 
                     s->q_pack = _ilog(quantvals - 1);
                     s->dec_type = 2;
                     s->dec_nodeb = _determine_node_bytes(s->used_entries, (_ilog(quantvals - 1) * s->dim + 8) / 8);
                     s->dec_leafw = _determine_leaf_words(s->dec_nodeb, (_ilog(quantvals - 1) * s->dim + 8) / 8);
 
-                    ret = _make_decode_table(s, lengthlist, quantvals, maptype);
+                    ret = _make_decode_table(vd, s, lengthlist, quantvals, maptype);
                     if(ret){
                         goto _errout;
                     }
@@ -1020,7 +940,7 @@ int32_t vorbis_book_unpack(codebook_t *s) {
                 s->dec_type = 1;
                 s->dec_nodeb = _determine_node_bytes(s->used_entries, (s->q_bits * s->dim + 8) / 8);
                 s->dec_leafw = _determine_leaf_words(s->dec_nodeb, (s->q_bits * s->dim + 8) / 8);
-                if(_make_decode_table(s, lengthlist, quantvals, maptype)) goto _errout;
+                if(_make_decode_table(vd, s, lengthlist, quantvals, maptype)) goto _errout;
             }
             else {
                 /* use dec_type 3: scalar offset into packed value array */
@@ -1028,7 +948,7 @@ int32_t vorbis_book_unpack(codebook_t *s) {
                 s->dec_type = 3;
                 s->dec_nodeb = _determine_node_bytes(s->used_entries, _ilog(s->used_entries - 1) / 8 + 1);
                 s->dec_leafw = _determine_leaf_words(s->dec_nodeb, _ilog(s->used_entries - 1) / 8 + 1);
-                if(_make_decode_table(s, lengthlist, quantvals, maptype)) goto _errout;
+                if(_make_decode_table(vd, s, lengthlist, quantvals, maptype)) goto _errout;
 
                 /* get the vals & pack them */
                 s->q_pack = (s->q_bits + 7) / 8 * s->dim;
@@ -1036,11 +956,11 @@ int32_t vorbis_book_unpack(codebook_t *s) {
 
                 if(s->q_bits <= 8) {
                     for(i = 0; i < s->used_entries * s->dim; i++)
-                        ((uint8_t *)(s->q_val))[i] = bitReader(s->q_bits);
+                        ((uint8_t *)(s->q_val))[i] = bitReader(vd, s->q_bits);
                 }
                 else {
                     for(i = 0; i < s->used_entries * s->dim; i++)
-                        ((uint16_t *)(s->q_val))[i] = bitReader(s->q_bits);
+                        ((uint16_t *)(s->q_val))[i] = bitReader(vd, s->q_bits);
                 }
             }
             break;
@@ -1048,7 +968,7 @@ int32_t vorbis_book_unpack(codebook_t *s) {
             log_e("maptype %i schould be 0, 1 or 2", maptype);
             goto _errout;
     }
-    if(oggpack_eop()) goto _eofout;
+    if(oggpack_eop(vd)) goto _eofout;
     if(lengthlist) {free(lengthlist); lengthlist = NULL;}
     if(s->q_val)   {free(s->q_val), s->q_val = NULL;}
     return 0; // ok
@@ -1064,10 +984,11 @@ _eofout:
 //----------------------------------------------------------------------------------------------------------------------
 int32_t VORBIS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact){
     int32_t result = -1;  // seek for str in buffer or in header up to baselen, not nullterninated
-    if (strlen(str) > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
-    for (int32_t i = 0; i < baselen - strlen(str); i++){
+    int32_t len = strlen(str);
+    if (len > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
+    for (int32_t i = 0; i < baselen - len; i++){
         result = i;
-        for (int32_t j = 0; j < strlen(str) + exact; j++){
+        for (int32_t j = 0; j < len + exact; j++){
             if (*(base + i + j) != *(str + j)){
                 result = -1;
                 break;
@@ -1086,42 +1007,42 @@ const uint32_t mask[] = {0x00000000, 0x00000001, 0x00000003, 0x00000007, 0x00000
                          0x0fffffff, 0x1fffffff, 0x3fffffff, 0x7fffffff, 0xffffffff};
 
 
-void bitReader_clear(){
-    s_bitReader.data = NULL;
-    s_bitReader.headptr = NULL;
-    s_bitReader.length = 0;
-    s_bitReader.headend = 0;
-    s_bitReader.headbit = 0;
+void bitReader_clear(VORBISDecoder_t* vd){
+    vd->bitReaderState.data = NULL;
+    vd->bitReaderState.headptr = NULL;
+    vd->bitReaderState.length = 0;
+    vd->bitReaderState.headend = 0;
+    vd->bitReaderState.headbit = 0;
 }
 
-void bitReader_setData(uint8_t *buff, uint16_t buffSize){
-    s_bitReader.data = buff;
-    s_bitReader.headptr = buff;
-    s_bitReader.length = buffSize;
-    s_bitReader.headend = buffSize * 8;
-    s_bitReader.headbit = 0;
+void bitReader_setData(VORBISDecoder_t* vd, uint8_t *buff, uint16_t buffSize){
+    vd->bitReaderState.data = buff;
+    vd->bitReaderState.headptr = buff;
+    vd->bitReaderState.length = buffSize;
+    vd->bitReaderState.headend = buffSize * 8;
+    vd->bitReaderState.headbit = 0;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 /* Read in bits without advancing the bitptr; bits <= 32 */
-int32_t bitReader_look(uint16_t nBits){
+int32_t bitReader_look(VORBISDecoder_t* vd, uint16_t nBits){
     uint32_t m = mask[nBits];
     int32_t  ret = 0;
 
-    nBits += s_bitReader.headbit;
+    nBits += vd->bitReaderState.headbit;
 
-    if(nBits >= s_bitReader.headend << 3) {
-        uint8_t       *ptr = s_bitReader.headptr;
+    if(nBits >= vd->bitReaderState.headend << 3) {
+        uint8_t       *ptr = vd->bitReaderState.headptr;
         if(nBits) {
-            ret = *ptr++ >> s_bitReader.headbit;
+            ret = *ptr++ >> vd->bitReaderState.headbit;
             if(nBits > 8) {
-                ret |= *ptr++ << (8 - s_bitReader.headbit);
+                ret |= *ptr++ << (8 - vd->bitReaderState.headbit);
                 if(nBits > 16) {
-                    ret |= *ptr++ << (16 - s_bitReader.headbit);
+                    ret |= *ptr++ << (16 - vd->bitReaderState.headbit);
                     if(nBits > 24) {
-                         ret |= *ptr++ << (24 - s_bitReader.headbit);
-                        if(nBits > 32 && s_bitReader.headbit) {
-                            ret |= *ptr << (32 - s_bitReader.headbit);
+                         ret |= *ptr++ << (24 - vd->bitReaderState.headbit);
+                        if(nBits > 32 && vd->bitReaderState.headbit) {
+                            ret |= *ptr << (32 - vd->bitReaderState.headbit);
                         }
                     }
                 }
@@ -1130,14 +1051,14 @@ int32_t bitReader_look(uint16_t nBits){
     }
     else {
         /* make this a switch jump-table */
-        ret = s_bitReader.headptr[0] >> s_bitReader.headbit;
+        ret = vd->bitReaderState.headptr[0] >> vd->bitReaderState.headbit;
         if(nBits > 8) {
-            ret |= s_bitReader.headptr[1] << (8 - s_bitReader.headbit);
+            ret |= vd->bitReaderState.headptr[1] << (8 - vd->bitReaderState.headbit);
             if(nBits > 16) {
-                ret |= s_bitReader.headptr[2] << (16 - s_bitReader.headbit);
+                ret |= vd->bitReaderState.headptr[2] << (16 - vd->bitReaderState.headbit);
                 if(nBits > 24) {
-                    ret |= s_bitReader.headptr[3] << (24 - s_bitReader.headbit);
-                    if(nBits > 32 && s_bitReader.headbit) ret |= s_bitReader.headptr[4] << (32 - s_bitReader.headbit);
+                    ret |= vd->bitReaderState.headptr[3] << (24 - vd->bitReaderState.headbit);
+                    if(nBits > 32 && vd->bitReaderState.headbit) ret |= vd->bitReaderState.headptr[4] << (32 - vd->bitReaderState.headbit);
                 }
             }
         }
@@ -1148,19 +1069,19 @@ int32_t bitReader_look(uint16_t nBits){
 }
 
 /* bits <= 32 */
-int32_t bitReader(uint16_t nBits) {
-    int32_t ret = bitReader_look(nBits);
-    if(bitReader_adv(nBits) < 0) return -1;
+int32_t bitReader(VORBISDecoder_t* vd, uint16_t nBits) {
+    int32_t ret = bitReader_look(vd, nBits);
+    if(bitReader_adv(vd, nBits) < 0) return -1;
     return (ret);
 }
 
 /* limited to 32 at a time */
-int8_t bitReader_adv(uint16_t nBits) {
-    nBits += s_bitReader.headbit;
-    s_bitReader.headbit = nBits & 7;
-    s_bitReader.headend -= (nBits >> 3);
-    s_bitReader.headptr += (nBits >> 3);
-    if(s_bitReader.headend < 1){
+int8_t bitReader_adv(VORBISDecoder_t* vd, uint16_t nBits) {
+    nBits += vd->bitReaderState.headbit;
+    vd->bitReaderState.headbit = nBits & 7;
+    vd->bitReaderState.headend -= (nBits >> 3);
+    vd->bitReaderState.headptr += (nBits >> 3);
+    if(vd->bitReaderState.headend < 1){
         return -1;
         log_e("error in bitreader");
     }
@@ -1222,13 +1143,13 @@ int32_t _determine_leaf_words(int32_t nodeb, int32_t leafwidth) {
     return 1;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype) {
+int32_t _make_decode_table(VORBISDecoder_t* vd, codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype) {
     uint32_t *work = nullptr;
 
     if(s->dec_nodeb == 4) {
         s->dec_table = __malloc_heap_psram((s->used_entries * 2 + 1) * sizeof(*work));
         /* +1 (rather than -2) is to accommodate 0 and 1 sized books, which are specialcased to nodeb==4 */
-        if(_make_words(lengthlist, s->entries, (uint32_t *)s->dec_table, quantvals, s, maptype)) return 1;
+        if(_make_words(vd, lengthlist, s->entries, (uint32_t *)s->dec_table, quantvals, s, maptype)) return 1;
 
         return 0;
     }
@@ -1236,7 +1157,7 @@ int32_t _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, i
     work = (uint32_t *)__calloc_heap_psram((uint32_t)(s->used_entries * 2 - 2) , sizeof(*work));
     if(!work) log_e("oom");
 
-    if(_make_words(lengthlist, s->entries, work, quantvals, s, maptype)) {
+    if(_make_words(vd, lengthlist, s->entries, work, quantvals, s, maptype)) {
         if(work) {free(work); work = NULL;}
         return 1;
     }
@@ -1244,11 +1165,11 @@ int32_t _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, i
     if(s->dec_leafw == 1) {
         switch(s->dec_nodeb) {
             case 1:
-                for(uint32_t i = 0; i < s->used_entries * 2 - 2; i++)
+                for(uint32_t i = 0; i < (uint32_t)(s->used_entries * 2 - 2); i++)
                     ((uint8_t *)s->dec_table)[i] = (uint16_t)((work[i] & 0x80000000UL) >> 24) | work[i];
                 break;
             case 2:
-                for(uint32_t i = 0; i < s->used_entries * 2 - 2; i++)
+                for(uint32_t i = 0; i < (uint32_t)(s->used_entries * 2 - 2); i++)
                     ((uint16_t *)s->dec_table)[i] = (uint16_t)((work[i] & 0x80000000UL) >> 16) | work[i];
                 break;
         }
@@ -1331,7 +1252,7 @@ int32_t _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, i
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* given a list of word lengths, number of used entries, and byte width of a leaf, generate the decode table */
-int32_t _make_words(char *l, uint16_t n, uint32_t *work, uint8_t quantvals, codebook_t *b, int32_t maptype) {
+int32_t _make_words(VORBISDecoder_t* vd, char *l, uint16_t n, uint32_t *work, uint8_t quantvals, codebook_t *b, int32_t maptype) {
 
     int32_t  i, j, count = 0;
     uint32_t top = 0;
@@ -1367,7 +1288,7 @@ int32_t _make_words(char *l, uint16_t n, uint32_t *work, uint8_t quantvals, code
                         top++;
                         work[chase * 2 + 1] = 0;
                     }
-                    work[chase * 2 + bit] = decpack(i, count++, quantvals, b, maptype) | 0x80000000;
+                    work[chase * 2 + bit] = decpack(vd, i, count++, quantvals, b, maptype) | 0x80000000;
                 }
 
                 /* Look to see if the next shorter marker points to the node above. if so, update it and repeat.  */
@@ -1395,7 +1316,7 @@ int32_t _make_words(char *l, uint16_t n, uint32_t *work, uint8_t quantvals, code
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-uint32_t decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t *b, int32_t maptype) {
+uint32_t decpack(VORBISDecoder_t* vd, int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t *b, int32_t maptype) {
     uint32_t ret = 0;
 
     switch(b->dec_type) {
@@ -1419,7 +1340,7 @@ uint32_t decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_
                 for(uint8_t j = 0; j < b->dim; j++) {
                     assert((b->q_bits * j) >= 0);
                     uint32_t shift = (uint32_t)b->q_bits * j;
-                    int32_t  _ret = bitReader(b->q_bits) << shift;
+                    int32_t  _ret = bitReader(vd, b->q_bits) << shift;
                     assert(_ret >= 0);
                     ret |= (uint32_t)_ret;
                 }
@@ -1462,17 +1383,17 @@ uint8_t _book_maptype1_quantvals(codebook_t *b) {
             acc *= vals;
             acc1 *= vals + 1;
         }
-        if(acc <= b->entries && acc1 > b->entries) { return (vals); }
+        if(acc <= (uint32_t)b->entries && acc1 > (uint32_t)b->entries) { return (vals); }
         else {
-            if(acc > b->entries) { vals--; }
+            if(acc > (uint32_t)b->entries) { vals--; }
             else { vals++; }
         }
     }
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t oggpack_eop() {
-    if(s_bitReader.headptr -s_bitReader.data  > s_setupHeaderLength){
-        log_i("s_bitReader.headptr %i, s_setupHeaderLength %i", s_bitReader.headptr, s_setupHeaderLength);
+int32_t oggpack_eop(VORBISDecoder_t* vd) {
+    if(vd->bitReaderState.headptr -vd->bitReaderState.data  > vd->setupHeaderLength){
+        log_i("vd->bitReaderState.headptr %i, vd->setupHeaderLength %i", vd->bitReaderState.headptr, vd->setupHeaderLength);
         log_i("ogg package 3 overflow");
          return -1;
     }
@@ -1488,28 +1409,28 @@ void vorbis_book_clear(codebook_t *b) {
     memset(b, 0, sizeof(*b));
 }
 //---------------------------------------------------------------------------------------------------------------------
- vorbis_info_floor_t* floor0_info_unpack() {
+ vorbis_info_floor_t* floor0_info_unpack(VORBISDecoder_t* vd) {
 
     int32_t               j;
 
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)__malloc_heap_psram(sizeof(*info));
-    info->order =    bitReader( 8);
-    info->rate =     bitReader(16);
-    info->barkmap =  bitReader(16);
-    info->ampbits =  bitReader( 6);
-    info->ampdB =    bitReader( 8);
-    info->numbooks = bitReader( 4) + 1;
+    info->order =    bitReader(vd, 8);
+    info->rate =     bitReader(vd, 16);
+    info->barkmap =  bitReader(vd, 16);
+    info->ampbits =  bitReader(vd, 6);
+    info->ampdB =    bitReader(vd, 8);
+    info->numbooks = bitReader(vd, 4) + 1;
 
     if(info->order < 1) goto err_out;
     if(info->rate < 1) goto err_out;
     if(info->barkmap < 1) goto err_out;
 
     for(j = 0; j < info->numbooks; j++) {
-        info->books[j] = bitReader(8);
-        if(info->books[j] >= s_nrOfCodebooks) goto err_out;
+        info->books[j] = bitReader(vd, 8);
+        if(info->books[j] >= vd->nrOfCodebooks) goto err_out;
     }
 
-    if(oggpack_eop()) goto err_out;
+    if(oggpack_eop(vd)) goto err_out;
     return (info);
 
 err_out:
@@ -1517,41 +1438,41 @@ err_out:
     return (NULL);
 }
 //---------------------------------------------------------------------------------------------------------------------
-vorbis_info_floor_t* floor1_info_unpack() {
+vorbis_info_floor_t* floor1_info_unpack(VORBISDecoder_t* vd) {
 
     int32_t j, k, count = 0, maxclass = -1, rangebits;
 
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)__calloc_heap_psram(1, sizeof(vorbis_info_floor_t));
     /* read partitions */
-    info->partitions = bitReader(5); /* only 0 to 31 legal */
+    info->partitions = bitReader(vd, 5); /* only 0 to 31 legal */
     info->partitionclass = (uint8_t *)__malloc_heap_psram(info->partitions * sizeof(*info->partitionclass));
     for(j = 0; j < info->partitions; j++) {
-        info->partitionclass[j] = bitReader(4); /* only 0 to 15 legal */
+        info->partitionclass[j] = bitReader(vd, 4); /* only 0 to 15 legal */
         if(maxclass < info->partitionclass[j]) maxclass = info->partitionclass[j];
     }
 
     /* read partition classes */
     info->_class = (floor1class_t *)__malloc_heap_psram((uint32_t)(maxclass + 1) * sizeof(*info->_class));
     for(j = 0; j < maxclass + 1; j++) {
-        info->_class[j].class_dim = bitReader(3) + 1; /* 1 to 8 */
-        info->_class[j].class_subs = bitReader(2);    /* 0,1,2,3 bits */
-        if(oggpack_eop() < 0) goto err_out;
+        info->_class[j].class_dim = bitReader(vd, 3) + 1; /* 1 to 8 */
+        info->_class[j].class_subs = bitReader(vd, 2);    /* 0,1,2,3 bits */
+        if(oggpack_eop(vd) < 0) goto err_out;
         if(info->_class[j].class_subs){
-            info->_class[j].class_book = bitReader(8);
+            info->_class[j].class_book = bitReader(vd, 8);
         }
         else{
             info->_class[j].class_book = 0;
         }
-        if(info->_class[j].class_book >= s_nrOfCodebooks) goto err_out;
+        if(info->_class[j].class_book >= vd->nrOfCodebooks) goto err_out;
         for(k = 0; k < (1 << info->_class[j].class_subs); k++) {
-            info->_class[j].class_subbook[k] = (uint8_t)bitReader(8) - 1;
-            if(info->_class[j].class_subbook[k] >= s_nrOfCodebooks && info->_class[j].class_subbook[k] != 0xff) goto err_out;
+            info->_class[j].class_subbook[k] = (uint8_t)bitReader(vd, 8) - 1;
+            if(info->_class[j].class_subbook[k] >= vd->nrOfCodebooks && info->_class[j].class_subbook[k] != 0xff) goto err_out;
         }
     }
 
     /* read the post list */
-    info->mult = bitReader(2) + 1; /* only 1,2,3,4 legal now */
-    rangebits = bitReader(4);
+    info->mult = bitReader(vd, 2) + 1; /* only 1,2,3,4 legal now */
+    rangebits = bitReader(vd, 4);
 
     for(j = 0, k = 0; j < info->partitions; j++) count += info->_class[info->partitionclass[j]].class_dim;
     info->postlist = (uint16_t *)__malloc_heap_psram((count + 2) * sizeof(*info->postlist));
@@ -1564,11 +1485,11 @@ vorbis_info_floor_t* floor1_info_unpack() {
         count += info->_class[info->partitionclass[j]].class_dim;
         if(count > VIF_POSIT) goto err_out;
         for(; k < count; k++) {
-            int32_t t = info->postlist[k + 2] = bitReader(rangebits);
+            int32_t t = info->postlist[k + 2] = bitReader(vd, rangebits);
             if(t >= (1 << rangebits)) goto err_out;
         }
     }
-    if(oggpack_eop()) goto err_out;
+    if(oggpack_eop(vd)) goto err_out;
     info->postlist[0] = 0;
     info->postlist[1] = 1 << rangebits;
     info->posts = count + 2;
@@ -1607,33 +1528,33 @@ err_out:
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* vorbis_info is for range checking */
-int32_t res_unpack(vorbis_info_residue_t *info){
+int32_t res_unpack(VORBISDecoder_t* vd, vorbis_info_residue_t *info){
     int32_t               j, k;
     memset(info, 0, sizeof(*info));
 
-    info->type =       bitReader(16);
+    info->type =       bitReader(vd, 16);
     if(info->type > 2 || info->type < 0) goto errout;
-    info->begin =      bitReader(24);
-    info->end =        bitReader(24);
-    info->grouping =   bitReader(24) + 1;
-    info->partitions = bitReader(6) + 1;
-    info->groupbook =  bitReader(8);
-    if(info->groupbook >= s_nrOfCodebooks) goto errout;
+    info->begin =      bitReader(vd, 24);
+    info->end =        bitReader(vd, 24);
+    info->grouping =   bitReader(vd, 24) + 1;
+    info->partitions = bitReader(vd, 6) + 1;
+    info->groupbook =  bitReader(vd, 8);
+    if(info->groupbook >= vd->nrOfCodebooks) goto errout;
 
     info->stagemasks = (uint8_t *)__malloc_heap_psram(info->partitions * sizeof(*info->stagemasks));
     info->stagebooks = (uint8_t *)__malloc_heap_psram(info->partitions * 8 * sizeof(*info->stagebooks));
 
     for(j = 0; j < info->partitions; j++) {
-        int32_t cascade = bitReader(3);
-        if(bitReader(1)) cascade |= (bitReader(5) << 3);
+        int32_t cascade = bitReader(vd, 3);
+        if(bitReader(vd, 1)) cascade |= (bitReader(vd, 5) << 3);
         info->stagemasks[j] = cascade;
     }
 
     for(j = 0; j < info->partitions; j++) {
         for(k = 0; k < 8; k++) {
             if((info->stagemasks[j] >> k) & 1) {
-                uint8_t book = bitReader(8);
-                if(book >= s_nrOfCodebooks) goto errout;
+                uint8_t book = bitReader(vd, 8);
+                if(book >= vd->nrOfCodebooks) goto errout;
                 info->stagebooks[j * 8 + k] = book;
                 if(k + 1 > info->stages) info->stages = k + 1;
             }
@@ -1642,7 +1563,7 @@ int32_t res_unpack(vorbis_info_residue_t *info){
         }
     }
 
-    if(oggpack_eop()) goto errout;
+    if(oggpack_eop(vd)) goto errout;
 
     return 0;
 errout:
@@ -1651,45 +1572,45 @@ errout:
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* also responsible for range checking */
-int32_t mapping_info_unpack(vorbis_info_mapping_t *info) {
+int32_t mapping_info_unpack(VORBISDecoder_t* vd, vorbis_info_mapping_t *info) {
     int32_t               i;
     memset(info, 0, sizeof(*info));
 
-    if(bitReader(1)) info->submaps = bitReader(4) + 1;
+    if(bitReader(vd, 1)) info->submaps = bitReader(vd, 4) + 1;
     else
         info->submaps = 1;
 
-    if(bitReader(1)) {
-        info->coupling_steps = bitReader(8) + 1;
+    if(bitReader(vd, 1)) {
+        info->coupling_steps = bitReader(vd, 8) + 1;
         info->coupling = (coupling_step_t *)__malloc_heap_psram(info->coupling_steps * sizeof(*info->coupling));
 
         for(i = 0; i < info->coupling_steps; i++) {
-            int32_t testM = info->coupling[i].mag = bitReader(ilog(s_vorbisChannels));
-            int32_t testA = info->coupling[i].ang = bitReader(ilog(s_vorbisChannels));
+            int32_t testM = info->coupling[i].mag = bitReader(vd, ilog(vd->vorbisChannels));
+            int32_t testA = info->coupling[i].ang = bitReader(vd, ilog(vd->vorbisChannels));
 
-            if(testM < 0 || testA < 0 || testM == testA || testM >= s_vorbisChannels || testA >= s_vorbisChannels) goto err_out;
+            if(testM < 0 || testA < 0 || testM == testA || testM >= vd->vorbisChannels || testA >= vd->vorbisChannels) goto err_out;
         }
     }
 
-    if(bitReader(2) > 0) goto err_out;
+    if(bitReader(vd, 2) > 0) goto err_out;
     /* 2,3:reserved */
 
     if(info->submaps > 1) {
-        info->chmuxlist = (uint8_t *)__malloc_heap_psram(sizeof(*info->chmuxlist) * s_vorbisChannels);
-        for(i = 0; i < s_vorbisChannels; i++) {
-            info->chmuxlist[i] = bitReader(4);
+        info->chmuxlist = (uint8_t *)__malloc_heap_psram(sizeof(*info->chmuxlist) * vd->vorbisChannels);
+        for(i = 0; i < vd->vorbisChannels; i++) {
+            info->chmuxlist[i] = bitReader(vd, 4);
             if(info->chmuxlist[i] >= info->submaps) goto err_out;
         }
     }
 
     info->submaplist = (submap_t *)__malloc_heap_psram(sizeof(*info->submaplist) * info->submaps);
     for(i = 0; i < info->submaps; i++) {
-        int32_t temp = bitReader(8);
+        int32_t temp = bitReader(vd, 8);
         (void)temp;
-        info->submaplist[i].floor = bitReader(8);
-        if(info->submaplist[i].floor >= s_nrOfFloors) goto err_out;
-        info->submaplist[i].residue = bitReader(8);
-        if(info->submaplist[i].residue >= s_nrOfResidues) goto err_out;
+        info->submaplist[i].floor = bitReader(vd, 8);
+        if(info->submaplist[i].floor >= vd->nrOfFloors) goto err_out;
+        info->submaplist[i].residue = bitReader(vd, 8);
+        if(info->submaplist[i].residue >= vd->nrOfResidues) goto err_out;
     }
 
     return 0;
@@ -1767,18 +1688,22 @@ void mapping_clear_info(vorbis_info_mapping_t *info) {
 //      ⏫⏫⏫    O G G      I M P L     A B O V E  ⏫⏫⏫
 //      ⏬⏬⏬ V O R B I S   I M P L     B E L O W  ⏬⏬⏬
 //---------------------------------------------------------------------------------------------------------------------
-vorbis_dsp_state_t *vorbis_dsp_create() {
+vorbis_dsp_state_t *vorbis_dsp_create(VORBISDecoder_t* vd) {
     int32_t i;
 
     vorbis_dsp_state_t *v = (vorbis_dsp_state_t *)__calloc_heap_psram(1, sizeof(vorbis_dsp_state_t));
 
-    v->work = (int32_t **)__malloc_heap_psram(s_vorbisChannels * sizeof(*v->work));
-    v->mdctright = (int32_t **)__malloc_heap_psram(s_vorbisChannels* sizeof(*v->mdctright));
+    v->work = (int32_t **)__malloc_heap_psram(vd->vorbisChannels * sizeof(*v->work));
+    v->mdctright = (int32_t **)__malloc_heap_psram(vd->vorbisChannels* sizeof(*v->mdctright));
 
-    for(i = 0; i < s_vorbisChannels; i++) {
-        v->work[i] = (int32_t *)__calloc_heap_psram(1, (s_blocksizes[1] >> 1) * sizeof(*v->work[i]));
-        v->mdctright[i] = (int32_t *)__calloc_heap_psram(1, (s_blocksizes[1] >> 2) * sizeof(*v->mdctright[i]));
+    for(i = 0; i < vd->vorbisChannels; i++) {
+        v->work[i] = (int32_t *)__calloc_heap_psram(1, (vd->blocksizes[1] >> 1) * sizeof(*v->work[i]));
+        v->mdctright[i] = (int32_t *)__calloc_heap_psram(1, (vd->blocksizes[1] >> 2) * sizeof(*v->mdctright[i]));
     }
+    v->mdcttrig[0] = mdct_trig_init(vd->blocksizes[0]);
+    v->mdcttrig[1] = mdct_trig_init(vd->blocksizes[1]);
+    v->ffttwiddle = mdct_fft_init(vd->blocksizes[1] >> 2);
+    v->mdctbuf = (int32_t *)__malloc_heap_psram((vd->blocksizes[1] >> 1) * sizeof(int32_t));
 
     v->lW = 0; /* previous window size */
     v->W = 0;  /* current window size  */
@@ -1789,64 +1714,69 @@ vorbis_dsp_state_t *vorbis_dsp_create() {
     return v;
 }
 //---------------------------------------------------------------------------------------------------------------------
-void vorbis_dsp_destroy(vorbis_dsp_state_t *v) {
+void vorbis_dsp_destroy(VORBISDecoder_t* vd, vorbis_dsp_state_t *v) {
     int32_t i;
     if(v) {
         if(v->work) {
-            for(i = 0; i < s_vorbisChannels; i++) {
+            for(i = 0; i < vd->vorbisChannels; i++) {
                 if(v->work[i]) {free(v->work[i]); v->work[i] = NULL;}
             }
             if(v->work){free(v->work); v->work = NULL;}
         }
         if(v->mdctright) {
-            for(i = 0; i < s_vorbisChannels; i++) {
+            for(i = 0; i < vd->vorbisChannels; i++) {
                 if(v->mdctright[i]){free(v->mdctright[i]); v->mdctright[i] = NULL;}
             }
             if(v->mdctright){free(v->mdctright); v->mdctright = NULL;}
         }
+        for(i = 0; i < 2; i++) {
+            if(v->mdcttrig[i]){free(v->mdcttrig[i]); v->mdcttrig[i] = NULL;}
+        }
+        if(v->ffttwiddle){free(v->ffttwiddle); v->ffttwiddle = NULL;}
+        if(v->mdctbuf){free(v->mdctbuf); v->mdctbuf = NULL;}
         free(v);
         v = NULL;
     }
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf) {
+int32_t vorbis_dsp_synthesis(VORBISDecoder_t* vd, uint8_t* inbuf, uint16_t len, int16_t* outbuf) {
 
     int32_t mode, i;
 
     /* Check the packet type */
-    if(bitReader(1) != 0)  {
+    if(bitReader(vd, 1) != 0)  {
         /* Oops.  This is not an audio data packet */
         return OV_ENOTAUDIO;
     }
 
     /* read our mode and pre/post windowsize */
-    mode = bitReader(ilog(s_nrOfModes));
-    if(mode == -1 || mode >= s_nrOfModes) return OV_EBADPACKET;
+    mode = bitReader(vd, ilog(vd->nrOfModes));
+    if(mode == -1 || mode >= vd->nrOfModes) return OV_EBADPACKET;
 
     /* shift information we still need from last window */
-    s_dsp_state->lW = s_dsp_state->W;
-    s_dsp_state->W = s_mode_param[mode].blockflag;
-    for(i = 0; i < s_vorbisChannels; i++){
-        mdct_shift_right(s_blocksizes[s_dsp_state->lW], s_dsp_state->work[i], s_dsp_state->mdctright[i]);
+    vd->dsp_state->lW = vd->dsp_state->W;
+    vd->dsp_state->W = vd->mode_param[mode].blockflag;
+    for(i = 0; i < vd->vorbisChannels; i++){
+        mdct_shift_right(vd->blocksizes[vd->dsp_state->lW], vd->dsp_state->work[i], vd->dsp_state->mdctright[i]);
     }
-    if(s_dsp_state->W) {
+    if(vd->dsp_state->W) {
         int32_t temp;
-        bitReader(1);
-        temp = bitReader(1);
+        bitReader(vd, 1);
+        temp = bitReader(vd, 1);
         if(temp == -1) return OV_EBADPACKET;
     }
 
     /* packet decode and portions of synthesis that rely on only this block */
     {
-        mapping_inverse(s_map_param + s_mode_param[mode].mapping);
+        mapping_inverse(vd, vd->map_param + vd->mode_param[mode].mapping);
 
-        if(s_dsp_state->out_begin == -1) {
-            s_dsp_state->out_begin = 0;
-            s_dsp_state->out_end = 0;
+        if(vd->dsp_state->out_begin == -1) {
+            vd->dsp_state->out_begin = 0;
+            vd->dsp_state->out_end = 0;
         }
         else {
-            s_dsp_state->out_begin = 0;
-            s_dsp_state->out_end = s_blocksizes[s_dsp_state->lW] / 4 + s_blocksizes[s_dsp_state->W] / 4;
+            vd->dsp_state->out_begin = 0;
+            vd->dsp_state->out_end = vd->blocksizes[vd->dsp_state->lW] / 4 + vd->blocksizes[vd->dsp_state->W] / 4;
         }
     }
 
@@ -1855,24 +1785,24 @@ int32_t vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf) {
 //---------------------------------------------------------------------------------------------------------------------
 void mdct_shift_right(int32_t n, int32_t *in, int32_t *right) {
     int32_t i;
+    in += (n >> 1) - 1;
     n >>= 2;
-    in += 1;
 
-    for(i = 0; i < n; i++) right[i] = in[i << 1];
+    for(i = 0; i < n; i++) right[i] = -in[-i];
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t mapping_inverse(vorbis_info_mapping_t *info) {
+int32_t mapping_inverse(VORBISDecoder_t* vd, vorbis_info_mapping_t *info) {
 
     int32_t     i, j;
-    int32_t n = s_blocksizes[s_dsp_state->W];
+    int32_t n = vd->blocksizes[vd->dsp_state->W];
 
-    int32_t **pcmbundle = (int32_t **)alloca(sizeof(*pcmbundle) * s_vorbisChannels);
-    int32_t      *zerobundle = (int32_t *)alloca(sizeof(*zerobundle) * s_vorbisChannels);
-    int32_t      *nonzero = (int32_t *)alloca(sizeof(*nonzero) * s_vorbisChannels);
-    int32_t **floormemo = (int32_t **)alloca(sizeof(*floormemo) * s_vorbisChannels);
+    int32_t **pcmbundle = (int32_t **)alloca(sizeof(*pcmbundle) * vd->vorbisChannels);
+    int32_t      *zerobundle = (int32_t *)alloca(sizeof(*zerobundle) * vd->vorbisChannels);
+    int32_t      *nonzero = (int32_t *)alloca(sizeof(*nonzero) * vd->vorbisChannels);
+    int32_t **floormemo = (int32_t **)alloca(sizeof(*floormemo) * vd->vorbisChannels);
 
     /* recover the spectral envelope; store it in the PCM vector for now */
-    for(i = 0; i < s_vorbisChannels; i++) {
+    for(i = 0; i < vd->vorbisChannels; i++) {
 
         int32_t submap = 0;
         int32_t floorno;
@@ -1880,21 +1810,21 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
         if(info->submaps > 1) submap = info->chmuxlist[i];
         floorno = info->submaplist[submap].floor;
 
-        if(s_floor_type[floorno]) {
+        if(vd->floor_type[floorno]) {
             /* floor 1 */
-            floormemo[i] = (int32_t *)alloca(sizeof(*floormemo[i]) * floor1_memosize(s_floor_param[floorno]));
-            floormemo[i] = floor1_inverse1(s_floor_param[floorno], floormemo[i]);
+            floormemo[i] = (int32_t *)alloca(sizeof(*floormemo[i]) * floor1_memosize(vd->floor_param[floorno]));
+            floormemo[i] = floor1_inverse1(vd, vd->floor_param[floorno], floormemo[i]);
         }
         else {
             /* floor 0 */
-            floormemo[i] = (int32_t *)alloca(sizeof(*floormemo[i]) * floor0_memosize(s_floor_param[floorno]));
-            floormemo[i] = floor0_inverse1(s_floor_param[floorno], floormemo[i]);
+            floormemo[i] = (int32_t *)alloca(sizeof(*floormemo[i]) * floor0_memosize(vd->floor_param[floorno]));
+            floormemo[i] = floor0_inverse1(vd, vd->floor_param[floorno], floormemo[i]);
         }
 
         if(floormemo[i]) nonzero[i] = 1;
         else
             nonzero[i] = 0;
-        memset(s_dsp_state->work[i], 0, sizeof(*s_dsp_state->work[i]) * n / 2);
+        memset(vd->dsp_state->work[i], 0, sizeof(*vd->dsp_state->work[i]) * n / 2);
     }
 
     /* channel coupling can 'dirty' the nonzero listing */
@@ -1908,16 +1838,16 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
     /* recover the residue into our working vectors */
     for(i = 0; i < info->submaps; i++) {
         uint8_t ch_in_bundle = 0;
-        for(j = 0; j < s_vorbisChannels; j++) {
+        for(j = 0; j < vd->vorbisChannels; j++) {
             if(!info->chmuxlist || info->chmuxlist[j] == i) {
                 if(nonzero[j]) zerobundle[ch_in_bundle] = 1;
                 else
                     zerobundle[ch_in_bundle] = 0;
-                pcmbundle[ch_in_bundle++] = s_dsp_state->work[j];
+                pcmbundle[ch_in_bundle++] = vd->dsp_state->work[j];
             }
         }
 
-        res_inverse(s_residue_param + info->submaplist[i].residue, pcmbundle, zerobundle, ch_in_bundle);
+        res_inverse(vd, vd->residue_param + info->submaplist[i].residue, pcmbundle, zerobundle, ch_in_bundle);
     }
 
     // for(j=0;j<vi->channels;j++)
@@ -1925,8 +1855,8 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
 
     /* channel coupling */
     for(i = info->coupling_steps - 1; i >= 0; i--) {
-        int32_t *pcmM = s_dsp_state->work[info->coupling[i].mag];
-        int32_t *pcmA = s_dsp_state->work[info->coupling[i].ang];
+        int32_t *pcmM = vd->dsp_state->work[info->coupling[i].mag];
+        int32_t *pcmA = vd->dsp_state->work[info->coupling[i].ang];
 
         for(j = 0; j < n / 2; j++) {
             int32_t mag = pcmM[j];
@@ -1957,21 +1887,21 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
 
     /* compute and apply spectral envelope */
 
-    for(i = 0; i < s_vorbisChannels; i++) {
-        int32_t *pcm = s_dsp_state->work[i];
+    for(i = 0; i < vd->vorbisChannels; i++) {
+        int32_t *pcm = vd->dsp_state->work[i];
         int32_t      submap = 0;
         int32_t      floorno;
 
         if(info->submaps > 1) submap = info->chmuxlist[i];
         floorno = info->submaplist[submap].floor;
 
-        if(s_floor_type[floorno]) {
+        if(vd->floor_type[floorno]) {
             /* floor 1 */
-            floor1_inverse2(s_floor_param[floorno], floormemo[i], pcm);
+            floor1_inverse2(vd, vd->floor_param[floorno], floormemo[i], pcm);
         }
         else {
             /* floor 0 */
-            floor0_inverse2(s_floor_param[floorno], floormemo[i], pcm);
+            floor0_inverse2(vd, vd->floor_param[floorno], floormemo[i], pcm);
         }
 
     }
@@ -1981,8 +1911,8 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
 
     /* transform the PCM data; takes PCM vector, vb; modifies PCM vector */
     /* only MDCT right now.... */
-    for(i = 0; i < s_vorbisChannels; i++){
-        mdct_backward(n, s_dsp_state->work[i]);
+    for(i = 0; i < vd->vorbisChannels; i++){
+        mdct_backward(vd, n, vd->dsp_state->work[i]);
     }
 
     // for(j=0;j<vi->channels;j++)
@@ -2002,22 +1932,22 @@ int32_t floor1_memosize(vorbis_info_floor_t *i) {
     return info->posts;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t *floor0_inverse1(vorbis_info_floor_t *i, int32_t *lsp) {
+int32_t *floor0_inverse1(VORBISDecoder_t* vd, vorbis_info_floor_t *i, int32_t *lsp) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)i;
     int32_t                 j;
 
-    int32_t ampraw = bitReader(info->ampbits);
+    int32_t ampraw = bitReader(vd, info->ampbits);
 
     if(ampraw > 0) { /* also handles the -1 out of data case */
         int32_t maxval = (1 << info->ampbits) - 1;
         int32_t     amp = ((ampraw * info->ampdB) << 4) / maxval;
-        int32_t     booknum = bitReader(_ilog(info->numbooks));
+        int32_t     booknum = bitReader(vd, _ilog(info->numbooks));
 
         if(booknum != -1 && booknum < info->numbooks) { /* be paranoid */
-            codebook_t        *b = s_codebooks + info->books[booknum];
+            codebook_t        *b = vd->codebooks + info->books[booknum];
             int32_t           last = 0;
 
-            if(vorbis_book_decodev_set(b, lsp, info->order, -24) == -1) goto eop;
+            if(vorbis_book_decodev_set(vd, b, lsp, info->order, -24) == -1) goto eop;
             for(j = 0; j < info->order;) {
                 for(uint8_t k = 0; j < info->order && k < b->dim; k++, j++) lsp[j] += last;
                 last = lsp[j - 1];
@@ -2031,18 +1961,18 @@ eop:
     return (NULL);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t *floor1_inverse1(vorbis_info_floor_t *in, int32_t *fit_value) {
+int32_t *floor1_inverse1(VORBISDecoder_t* vd, vorbis_info_floor_t *in, int32_t *fit_value) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)in;
 
     int32_t                 quant_look[4] = {256, 128, 86, 64};
     int32_t                 i, j, k;
     int32_t                 quant_q = quant_look[info->mult - 1];
-    codebook_t         *books = s_codebooks;
+    codebook_t         *books = vd->codebooks;
 
     /* unpack wrapped/predicted values from stream */
-    if(bitReader(1) == 1) {
-        fit_value[0] = bitReader(ilog(quant_q - 1));
-        fit_value[1] = bitReader(ilog(quant_q - 1));
+    if(bitReader(vd, 1) == 1) {
+        fit_value[0] = bitReader(vd, ilog(quant_q - 1));
+        fit_value[1] = bitReader(vd, ilog(quant_q - 1));
 
     /* partition by partition */
         for(i = 0, j = 2; i < info->partitions; i++) {
@@ -2054,7 +1984,7 @@ int32_t *floor1_inverse1(vorbis_info_floor_t *in, int32_t *fit_value) {
 
             /* decode the partition's first stage cascade value */
             if(csubbits) {
-                cval = vorbis_book_decode(books + info->_class[classv].class_book);
+                cval = vorbis_book_decode(vd, books + info->_class[classv].class_book);
                 if(cval == -1) goto eop;
             }
 
@@ -2062,7 +1992,7 @@ int32_t *floor1_inverse1(vorbis_info_floor_t *in, int32_t *fit_value) {
                 int32_t book = info->_class[classv].class_subbook[cval & (csub - 1)];
                 cval >>= csubbits;
                 if(book != 0xff) {
-                    if((fit_value[j + k] = vorbis_book_decode(books + book)) == -1) goto eop;
+                    if((fit_value[j + k] = vorbis_book_decode(vd, books + book)) == -1) goto eop;
                 }
                 else { fit_value[j + k] = 0; }
             }
@@ -2107,22 +2037,22 @@ eop:
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* returns the [original, not compacted] entry number or -1 on eof *********/
-int32_t vorbis_book_decode(codebook_t* book) {
+int32_t vorbis_book_decode(VORBISDecoder_t* vd, codebook_t* book) {
     if(book->dec_type) return -1;
-    return decode_packed_entry_number(book);
+    return decode_packed_entry_number(vd, book);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t decode_packed_entry_number(codebook_t *book) {
+int32_t decode_packed_entry_number(VORBISDecoder_t* vd, codebook_t *book) {
     uint32_t chase = 0;
     int32_t      read = book->dec_maxlength;
-    int32_t  lok = bitReader_look(read), i;
+    int32_t  lok = bitReader_look(vd, read), i;
 
     while(lok < 0 && read > 1){
-        lok = bitReader_look(--read);
+        lok = bitReader_look(vd, --read);
     }
 
     if(lok < 0) {
-        bitReader_adv(1); /* force eop */
+        bitReader_adv(vd, 1); /* force eop */
         return -1;
     }
 
@@ -2191,10 +2121,10 @@ int32_t decode_packed_entry_number(codebook_t *book) {
     }
 
     if(i < read) {
-        bitReader_adv(i + 1);
+        bitReader_adv(vd, i + 1);
         return chase;
     }
-    bitReader_adv(read + 1);
+    bitReader_adv(vd, read + 1);
     log_e("read %i", read);
     return (-1);
 }
@@ -2217,13 +2147,13 @@ int32_t render_point(int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t x)
 //---------------------------------------------------------------------------------------------------------------------
 /* unlike the others, we guard against n not being an integer number * of <dim> internally rather than in the upper
  layer (called only by * floor0) */
-int32_t vorbis_book_decodev_set(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
+int32_t vorbis_book_decodev_set(VORBISDecoder_t* vd, codebook_t *book, int32_t *a, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
         int32_t      i;
 
         for(i = 0; i < n;) {
-            if(decode_map(book, v, point)) return -1;
+            if(decode_map(vd, book, v, point)) return -1;
             for(uint8_t j = 0; i < n && j < book->dim; j++) a[i++] = v[j];
         }
     }
@@ -2236,11 +2166,11 @@ int32_t vorbis_book_decodev_set(codebook_t *book, int32_t *a, int32_t n, int32_t
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t decode_map(codebook_t *s, int32_t *v, int32_t point) {
+int32_t decode_map(VORBISDecoder_t* vd, codebook_t *s, int32_t *v, int32_t point) {
 
-    uint32_t entry = decode_packed_entry_number(s);
+    uint32_t entry = decode_packed_entry_number(vd, s);
 
-    if(oggpack_eop()) return (-1);
+    if(oggpack_eop(vd)) return (-1);
 
     /* according to decode type */
     switch(s->dec_type) {
@@ -2300,14 +2230,14 @@ int32_t decode_map(codebook_t *s, int32_t *v, int32_t point) {
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero, uint8_t ch) {
+int32_t res_inverse(VORBISDecoder_t* vd, vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero, uint8_t ch) {
     int32_t               j, k, s;
     uint8_t           m = 0, n = 0;
     uint8_t           used = 0;
-    codebook_t         *phrasebook = s_codebooks + info->groupbook;
+    codebook_t         *phrasebook = vd->codebooks + info->groupbook;
     uint32_t          samples_per_partition = info->grouping;
     uint8_t           partitions_per_word = phrasebook->dim;
-    uint32_t          pcmend = s_blocksizes[s_dsp_state->W];
+    uint32_t          pcmend = vd->blocksizes[vd->dsp_state->W];
 
 
     if(info->type < 2) {
@@ -2343,7 +2273,7 @@ int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero,
                                 }
                             }
                             for(n = 0; n < ch; n++) {
-                                int32_t temp = vorbis_book_decode(phrasebook);
+                                int32_t temp = vorbis_book_decode(vd, phrasebook);
                                 if(temp == -1) goto eopbreak;
                                 /* this can be done quickly in assembly due to the quotient
                                  always being at most six bits */
@@ -2360,14 +2290,14 @@ int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero,
                             for(j = 0; j < ch; j++) {
                                 uint32_t offset = info->begin + i * samples_per_partition;
                                 if(info->stagemasks[(int32_t)partword[j][i]] & (1 << s)) {
-                                    codebook_t *stagebook = s_codebooks + info->stagebooks[(partword[j][i] << 3) + s];
+                                    codebook_t *stagebook = vd->codebooks + info->stagebooks[(partword[j][i] << 3) + s];
                                     if(info->type) {
-                                        if(vorbis_book_decodev_add(stagebook, in[j] + offset,
+                                        if(vorbis_book_decodev_add(vd, stagebook, in[j] + offset,
                                                                    samples_per_partition, -8) == -1)
                                             goto eopbreak;
                                     }
                                     else {
-                                        if(vorbis_book_decodevs_add(stagebook, in[j] + offset,
+                                        if(vorbis_book_decodevs_add(vd, stagebook, in[j] + offset,
                                                                     samples_per_partition, -8) == -1)
                                             goto eopbreak;
                                     }
@@ -2407,7 +2337,7 @@ int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero,
                             partword[i + k] = partword[i + k + 1] * info->partitions;
 
                         /* fetch the partition word */
-                        temp = vorbis_book_decode(phrasebook);
+                        temp = vorbis_book_decode(vd, phrasebook);
                         if(temp == -1) goto eopbreak;
 
                         /* this can be done quickly in assembly due to the quotient always being at most six bits */
@@ -2421,8 +2351,8 @@ int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero,
                     /* now we decode residual values for the partitions */
                     for(k = 0; k < partitions_per_word && i < partvals; k++, i++)
                         if(info->stagemasks[(int32_t)partword[i]] & (1 << s)) {
-                            codebook_t *stagebook = s_codebooks + info->stagebooks[(partword[i] << 3) + s];
-                            if(vorbis_book_decodevv_add(stagebook, in, i * samples_per_partition + beginoff, ch,
+                            codebook_t *stagebook = vd->codebooks + info->stagebooks[(partword[i] << 3) + s];
+                            if(vorbis_book_decodevv_add(vd, stagebook, in, i * samples_per_partition + beginoff, ch,
                                                         samples_per_partition, -8) == -1)
                                 goto eopbreak;
                         }
@@ -2436,13 +2366,13 @@ eopbreak:
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* decode vector / dim granularity guarding is done in the upper layer */
-int32_t vorbis_book_decodev_add(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
+int32_t vorbis_book_decodev_add(VORBISDecoder_t* vd, codebook_t *book, int32_t *a, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
-        uint32_t i;
+        int32_t i;
 
         for(i = 0; i < n;) {
-            if(decode_map(book, v, point)) return -1;
+            if(decode_map(vd, book, v, point)) return -1;
             for(uint8_t j = 0; i < n && j < book->dim; j++) a[i++] += v[j];
         }
     }
@@ -2451,21 +2381,21 @@ int32_t vorbis_book_decodev_add(codebook_t *book, int32_t *a, int32_t n, int32_t
 //---------------------------------------------------------------------------------------------------------------------
 /* returns 0 on OK or -1 on eof */
 /* decode vector / dim granularity guarding is done in the upper layer */
-int32_t vorbis_book_decodevs_add(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
+int32_t vorbis_book_decodevs_add(VORBISDecoder_t* vd, codebook_t *book, int32_t *a, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t      step = n / book->dim;
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
         int32_t      j;
 
         for(j = 0; j < step; j++) {
-            if(decode_map(book, v, point)) return -1;
+            if(decode_map(vd, book, v, point)) return -1;
             for(uint8_t i = 0, o = j; i < book->dim; i++, o += step) a[o] += v[i];
         }
     }
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t floor0_inverse2(vorbis_info_floor_t *i, int32_t *lsp, int32_t *out) {
+int32_t floor0_inverse2(VORBISDecoder_t* vd, vorbis_info_floor_t *i, int32_t *lsp, int32_t *out) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)i;
 
 
@@ -2473,19 +2403,19 @@ int32_t floor0_inverse2(vorbis_info_floor_t *i, int32_t *lsp, int32_t *out) {
         int32_t amp = lsp[info->order];
 
         /* take the coefficients back to a spectral envelope curve */
-        vorbis_lsp_to_curve(out, s_blocksizes[s_dsp_state->W] / 2, info->barkmap, lsp, info->order, amp, info->ampdB,
+        vorbis_lsp_to_curve(out, vd->blocksizes[vd->dsp_state->W] / 2, info->barkmap, lsp, info->order, amp, info->ampdB,
                             info->rate >> 1);
         return (1);
     }
-    memset(out, 0, sizeof(*out) * s_blocksizes[s_dsp_state->W] / 2);
+    memset(out, 0, sizeof(*out) * vd->blocksizes[vd->dsp_state->W] / 2);
     return (0);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-int32_t floor1_inverse2(vorbis_info_floor_t *in, int32_t *fit_value, int32_t *out) {
+int32_t floor1_inverse2(VORBISDecoder_t* vd, vorbis_info_floor_t *in, int32_t *fit_value, int32_t *out) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)in;
 
-    int32_t               n = s_blocksizes[s_dsp_state->W] / 2;
+    int32_t               n = vd->blocksizes[vd->dsp_state->W] / 2;
     int32_t               j;
 
     if(fit_value) {
@@ -2769,385 +2699,208 @@ int32_t vorbis_invsqlook_i(int32_t a, int32_t e) {
     return (val >> e);
 }
 //---------------------------------------------------------------------------------------------------------------------
-/* partial; doesn't perform last-step deinterleave/unrolling. That can be done more efficiently during pcm output */
-void mdct_backward(int32_t n, int32_t *in) {
-    int32_t shift;
-    int32_t step;
-
-    for(shift = 4; !(n & (1 << shift)); shift++)
-        ;
-    shift = 13 - shift;
-    step = 2 << shift;
-
-    presymmetry(in, n >> 1, step);
-    mdct_butterflies(in, n >> 1, shift);
-    mdct_bitreverse(in, n, shift);
-    mdct_step7(in, n, step);
-    mdct_step8(in, n, step);
-}
-//---------------------------------------------------------------------------------------------------------------------
-void presymmetry(int32_t *in, int32_t n2, int32_t step) {
-    int32_t       *aX;
-    int32_t       *bX;
+/* sin and cos of 2pi * t / 65536 for 0 <= t < 49152, taken from the sincos_lookup grid (2pi / 8192) and rotated
+   by sincos_fine to the exact angle, used once per stream to build the MDCT and FFT tables */
+void mdct_sincos(int32_t t, int32_t *s, int32_t *c) {
+    int32_t        q = t >> 14; // quadrant
+    int32_t        r = t & 0x3fff;
+    int32_t        g, f, s0, c0;
+    bool           mirror = r > 8192;
     const int32_t *T;
-    int32_t            n4 = n2 >> 1;
-
-    aX = in + n2 - 3;
-    T = sincos_lookup0;
-
-    do {
-        int32_t r0 = aX[0];
-        int32_t r2 = aX[2];
-        XPROD31(r0, r2, T[0], T[1], &aX[0], &aX[2]);
-        T += step;
-        aX -= 4;
-    } while(aX >= in + n4);
-    do {
-        int32_t r0 = aX[0];
-        int32_t r2 = aX[2];
-        XPROD31(r0, r2, T[1], T[0], &aX[0], &aX[2]);
-        T -= step;
-        aX -= 4;
-    } while(aX >= in);
-
-    aX = in + n2 - 4;
-    bX = in;
-    T = sincos_lookup0;
-    do {
-        int32_t ri0 = aX[0];
-        int32_t ri2 = aX[2];
-        int32_t ro0 = bX[0];
-        int32_t ro2 = bX[2];
-
-        XNPROD31(ro2, ro0, T[1], T[0], &aX[0], &aX[2]);
-        T += step;
-        XNPROD31(ri2, ri0, T[0], T[1], &bX[0], &bX[2]);
-
-        aX -= 4;
-        bX += 4;
-    } while(aX >= in + n4);
-}
-//---------------------------------------------------------------------------------------------------------------------
-void mdct_butterflies(int32_t *x, int32_t points, int32_t shift) {
-    int32_t stages = 8 - shift;
-    int32_t i, j;
 
-    for(i = 0; --stages > 0; i++) {
-        for(j = 0; j < (1 << i); j++) mdct_butterfly_generic(x + (points >> i) * j, points >> i, 4 << (i + shift));
+    if(mirror) r = 16384 - r;
+    g = r >> 3;
+    f = r & 7;
+    T = (g & 1) ? sincos_lookup1 + (g - 1) : sincos_lookup0 + g;
+    if(f) XNPROD31(T[1], T[0], sincos_fine[f * 2 + 1], sincos_fine[f * 2], &c0, &s0);
+    else {
+        s0 = T[0];
+        c0 = T[1];
+    }
+    if(mirror) {
+        int32_t tmp = s0;
+        s0 = c0;
+        c0 = tmp;
+    }
+    switch(q) {
+        case 0: *s = s0;  *c = c0;  break;
+        case 1: *s = c0;  *c = -s0; break;
+        case 2: *s = -s0; *c = -c0; break;
+        default: *s = -c0; *c = s0; break;
+    }
+}
+//---------------------------------------------------------------------------------------------------------------------
+/* {sin, cos} pairs: 2pi(k + 1/8) / n for the pre- and post-rotation, k < n / 4 */
+int32_t *mdct_trig_init(int32_t n) {
+    int32_t *T = (int32_t *)__malloc_heap_psram((n >> 1) * sizeof(int32_t));
+    if(!T) return NULL;
+    for(int32_t k = 0; k < (n >> 2); k++) mdct_sincos((8 * k + 1) * (8192 / n), &T[2 * k], &T[2 * k + 1]);
+    return T;
+}
+//---------------------------------------------------------------------------------------------------------------------
+/* {sin, cos} pairs: 2pi t / points with t < 3/4 points, shared by all FFT sizes up to points */
+int32_t *mdct_fft_init(int32_t points) {
+    int32_t *W = (int32_t *)__malloc_heap_psram((points * 3 / 2) * sizeof(int32_t));
+    if(!W) return NULL;
+    for(int32_t t = 0; t < points * 3 / 4; t++) mdct_sincos(t * (65536 / points), &W[2 * t], &W[2 * t + 1]);
+    return W;
+}
+//---------------------------------------------------------------------------------------------------------------------
+/* inverse MDCT via a n/4 point complex FFT. Returns the n/2 samples y[n/4 ... 3n/4) of the n samples, the other
+   halves follow by symmetry. Windowing, overlap-add and the 16 bit output are done in one pass by mdct_unroll_lap */
+void mdct_backward(VORBISDecoder_t* vd, int32_t n, int32_t *in) {
+    const int32_t *T = vd->dsp_state->mdcttrig[n == (int32_t)vd->blocksizes[1]];
+    int32_t       *x = vd->dsp_state->mdctbuf;
+    int32_t        points = n >> 2;
+
+    mdct_prerotate(in, x, points, T);
+    mdct_fft(vd, x, points);
+    mdct_postrotate(vd, x, in, points, T);
+}
+//---------------------------------------------------------------------------------------------------------------------
+/* z[k] = (X[n/2 - 1 - 2k] + i X[2k]) * e^(i 2pi(k + 1/8) / n), stored in bit reversed order and merged with the
+   first FFT pass (radix 4, or radix 2 if points is an odd power of 2) */
+void mdct_prerotate(const int32_t *in, int32_t *x, int32_t points, const int32_t *T) {
+    const int32_t *iX = in + (points << 1) - 1;
+    int32_t        r, p, bit;
+
+    if(points & 0xAAAAAAAA) {
+        int32_t q = points >> 1;
+        for(r = 0, p = 0; r < q; r++) {
+            int32_t  z0r, z0i, z1r, z1i;
+            int32_t *x0 = x + (p << 2);
+            XNPROD31(iX[-(r << 1)], in[r << 1], T[(r << 1) + 1], T[r << 1], &z0r, &z0i);
+            XNPROD31(iX[-((r + q) << 1)], in[(r + q) << 1], T[((r + q) << 1) + 1], T[(r + q) << 1], &z1r, &z1i);
+            x0[0] = z0r + z1r;
+            x0[1] = z0i + z1i;
+            x0[2] = z0r - z1r;
+            x0[3] = z0i - z1i;
+            for(bit = points >> 2; p & bit; bit >>= 1) p ^= bit;
+            p |= bit;
+        }
     }
-
-    for(j = 0; j < points; j += 32) mdct_butterfly_32(x + j);
-}
-//---------------------------------------------------------------------------------------------------------------------
-/* N/stage point generic N stage butterfly (in place, 2 register) */
-void mdct_butterfly_generic(int32_t *x, int32_t points, int32_t step) {
-    const int32_t *T = sincos_lookup0;
-    int32_t       *x1 = x + points - 4;
-    int32_t       *x2 = x + (points >> 1) - 4;
-    int32_t        r0, r1, r2, r3;
-
-    do {
-        r0 = x1[0] - x1[1];
-        x1[0] += x1[1];
-        r1 = x1[3] - x1[2];
-        x1[2] += x1[3];
-        r2 = x2[1] - x2[0];
-        x1[1] = x2[1] + x2[0];
-        r3 = x2[3] - x2[2];
-        x1[3] = x2[3] + x2[2];
-        XPROD31(r1, r0, T[0], T[1], &x2[0], &x2[2]);
-        XPROD31(r2, r3, T[0], T[1], &x2[1], &x2[3]);
-        T += step;
-        x1 -= 4;
-        x2 -= 4;
-    } while(T < sincos_lookup0 + 1024);
-    do {
-        r0 = x1[0] - x1[1];
-        x1[0] += x1[1];
-        r1 = x1[2] - x1[3];
-        x1[2] += x1[3];
-        r2 = x2[0] - x2[1];
-        x1[1] = x2[1] + x2[0];
-        r3 = x2[3] - x2[2];
-        x1[3] = x2[3] + x2[2];
-        XNPROD31(r0, r1, T[0], T[1], &x2[0], &x2[2]);
-        XNPROD31(r3, r2, T[0], T[1], &x2[1], &x2[3]);
-        T -= step;
-        x1 -= 4;
-        x2 -= 4;
-    } while(T > sincos_lookup0);
-}
-//---------------------------------------------------------------------------------------------------------------------
-/* 32 point butterfly (in place, 4 register) */
-void mdct_butterfly_32(int32_t *x) {
-    int32_t r0, r1, r2, r3;
-
-    r0 = x[16] - x[17];
-    x[16] += x[17];
-    r1 = x[18] - x[19];
-    x[18] += x[19];
-    r2 = x[1] - x[0];
-    x[17] = x[1] + x[0];
-    r3 = x[3] - x[2];
-    x[19] = x[3] + x[2];
-    XNPROD31(r0, r1, cPI3_8, cPI1_8, &x[0], &x[2]);
-    XPROD31(r2, r3, cPI1_8, cPI3_8, &x[1], &x[3]);
-
-    r0 = x[20] - x[21];
-    x[20] += x[21];
-    r1 = x[22] - x[23];
-    x[22] += x[23];
-    r2 = x[5] - x[4];
-    x[21] = x[5] + x[4];
-    r3 = x[7] - x[6];
-    x[23] = x[7] + x[6];
-    x[4] = MULT31((r0 - r1), cPI2_8);
-    x[5] = MULT31((r3 + r2), cPI2_8);
-    x[6] = MULT31((r0 + r1), cPI2_8);
-    x[7] = MULT31((r3 - r2), cPI2_8);
-
-    r0 = x[24] - x[25];
-    x[24] += x[25];
-    r1 = x[26] - x[27];
-    x[26] += x[27];
-    r2 = x[9] - x[8];
-    x[25] = x[9] + x[8];
-    r3 = x[11] - x[10];
-    x[27] = x[11] + x[10];
-    XNPROD31(r0, r1, cPI1_8, cPI3_8, &x[8], &x[10]);
-    XPROD31(r2, r3, cPI3_8, cPI1_8, &x[9], &x[11]);
-
-    r0 = x[28] - x[29];
-    x[28] += x[29];
-    r1 = x[30] - x[31];
-    x[30] += x[31];
-    r2 = x[12] - x[13];
-    x[29] = x[13] + x[12];
-    r3 = x[15] - x[14];
-    x[31] = x[15] + x[14];
-    x[12] = r0;
-    x[13] = r3;
-    x[14] = r1;
-    x[15] = r2;
-
-    mdct_butterfly_16(x);
-    mdct_butterfly_16(x + 16);
-}
-//---------------------------------------------------------------------------------------------------------------------
-/* 16 point butterfly (in place, 4 register) */
-void mdct_butterfly_16(int32_t *x) {
-    int32_t r0, r1, r2, r3;
-
-    r0 = x[8] - x[9];
-    x[8] += x[9];
-    r1 = x[10] - x[11];
-    x[10] += x[11];
-    r2 = x[1] - x[0];
-    x[9] = x[1] + x[0];
-    r3 = x[3] - x[2];
-    x[11] = x[3] + x[2];
-    x[0] = MULT31((r0 - r1), cPI2_8);
-    x[1] = MULT31((r2 + r3), cPI2_8);
-    x[2] = MULT31((r0 + r1), cPI2_8);
-    x[3] = MULT31((r3 - r2), cPI2_8);
-
-    r2 = x[12] - x[13];
-    x[12] += x[13];
-    r3 = x[14] - x[15];
-    x[14] += x[15];
-    r0 = x[4] - x[5];
-    x[13] = x[5] + x[4];
-    r1 = x[7] - x[6];
-    x[15] = x[7] + x[6];
-    x[4] = r2;
-    x[5] = r1;
-    x[6] = r3;
-    x[7] = r0;
-
-    mdct_butterfly_8(x);
-    mdct_butterfly_8(x + 8);
-}
-//---------------------------------------------------------------------------------------------------------------------
-/* 8 point butterfly (in place) */
-void mdct_butterfly_8(int32_t *x) {
-    int32_t r0 = x[0] + x[1];
-    int32_t r1 = x[0] - x[1];
-    int32_t r2 = x[2] + x[3];
-    int32_t r3 = x[2] - x[3];
-    int32_t r4 = x[4] + x[5];
-    int32_t r5 = x[4] - x[5];
-    int32_t r6 = x[6] + x[7];
-    int32_t r7 = x[6] - x[7];
-
-    x[0] = r5 + r3;
-    x[1] = r7 - r1;
-    x[2] = r5 - r3;
-    x[3] = r7 + r1;
-    x[4] = r4 - r0;
-    x[5] = r6 - r2;
-    x[6] = r4 + r0;
-    x[7] = r6 + r2;
-}
-//---------------------------------------------------------------------------------------------------------------------
-void mdct_bitreverse(int32_t *x, int32_t n, int32_t shift) {
-    int32_t      bit = 0;
-    int32_t *w = x + (n >> 1);
-
-    do {
-        int32_t  b = bitrev12(bit++);
-        int32_t *xx = x + (b >> shift);
-        int32_t  r;
-
-        w -= 2;
-
-        if(w > xx) {
-            r = xx[0];
-            xx[0] = w[0];
-            w[0] = r;
-
-            r = xx[1];
-            xx[1] = w[1];
-            w[1] = r;
+    else {
+        int32_t q = points >> 2;
+        for(r = 0, p = 0; r < q; r++) {
+            int32_t  z0r, z0i, z1r, z1i, z2r, z2i, z3r, z3i, t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+            int32_t *x0 = x + (p << 3);
+            int32_t  k = r << 1;
+            XNPROD31(iX[-k], in[k], T[k + 1], T[k], &z0r, &z0i);
+            k += q << 1;
+            XNPROD31(iX[-k], in[k], T[k + 1], T[k], &z1r, &z1i);
+            k += q << 1;
+            XNPROD31(iX[-k], in[k], T[k + 1], T[k], &z2r, &z2i);
+            k += q << 1;
+            XNPROD31(iX[-k], in[k], T[k + 1], T[k], &z3r, &z3i);
+            t0r = z0r + z2r;
+            t0i = z0i + z2i;
+            t1r = z0r - z2r;
+            t1i = z0i - z2i;
+            t2r = z1r + z3r;
+            t2i = z1i + z3i;
+            t3r = z1r - z3r;
+            t3i = z1i - z3i;
+            x0[0] = t0r + t2r;
+            x0[1] = t0i + t2i;
+            x0[2] = t1r - t3i;
+            x0[3] = t1i + t3r;
+            x0[4] = t0r - t2r;
+            x0[5] = t0i - t2i;
+            x0[6] = t1r + t3i;
+            x0[7] = t1i - t3r;
+            for(bit = points >> 3; p & bit; bit >>= 1) p ^= bit;
+            p |= bit;
+        }
+    }
+}
+//---------------------------------------------------------------------------------------------------------------------
+/* one radix 4 pass of the inverse FFT, X[k] = A0 + W^k A1 + W^2k A2 + W^3k A3 for the sub-DFTs of size h, which
+   lie in the order A0, A2, A1, A3 */
+static inline void mdct_fft_bfly4(int32_t *x0, int32_t h, const int32_t *W1, const int32_t *W2, const int32_t *W3,
+                                  int32_t *X) {
+    int32_t *x1 = x0 + (h << 1);
+    int32_t *x2 = x1 + (h << 1);
+    int32_t *x3 = x2 + (h << 1);
+    int32_t  b1r, b1i, b2r, b2i, b3r, b3i, r0, r1, r2, r3;
+
+    if(W1 == W2) { // k = 0, all twiddles are 1
+        b2r = x1[0];
+        b2i = x1[1];
+        b1r = x2[0];
+        b1i = x2[1];
+        b3r = x3[0];
+        b3i = x3[1];
+    }
+    else {
+        XNPROD31(x1[0], x1[1], W2[1], W2[0], &b2r, &b2i);
+        XNPROD31(x2[0], x2[1], W1[1], W1[0], &b1r, &b1i);
+        XNPROD31(x3[0], x3[1], W3[1], W3[0], &b3r, &b3i);
+    }
+    r0 = x0[0] - b2r;
+    r1 = x0[1] - b2i;
+    r2 = b1r - b3r;
+    r3 = b1i - b3i;
+    b2r += x0[0];
+    b2i += x0[1];
+    b1r += b3r;
+    b1i += b3i;
+    X[0] = b2r + b1r;
+    X[1] = b2i + b1i;
+    X[2] = r0 - r3;
+    X[3] = r1 + r2;
+    X[4] = b2r - b1r;
+    X[5] = b2i - b1i;
+    X[6] = r0 + r3;
+    X[7] = r1 - r2;
+}
+//---------------------------------------------------------------------------------------------------------------------
+/* in place inverse FFT passes between mdct_prerotate (first pass) and mdct_postrotate (last pass) */
+void mdct_fft(VORBISDecoder_t* vd, int32_t *x, int32_t points) {
+    const int32_t *W = vd->dsp_state->ffttwiddle;
+    int32_t        wpoints = vd->blocksizes[1] >> 2; // size of the twiddle table
+    int32_t        h = (points & 0xAAAAAAAA) ? 2 : 4;
+    int32_t        k, X[8];
+    int32_t       *x0;
+
+    for(; (h << 2) < points; h <<= 2) {
+        int32_t step = (wpoints / (h << 2)) << 1;
+        for(k = 0; k < h; k++) {
+            const int32_t *W1 = W + k * step;
+            for(x0 = x + (k << 1); x0 < x + (points << 1); x0 += (h << 3)) {
+                mdct_fft_bfly4(x0, h, W1, W1 + k * step, W1 + 2 * k * step, X);
+                x0[0] = X[0];
+                x0[1] = X[1];
+                x0[(h << 1) + 0] = X[2];
+                x0[(h << 1) + 1] = X[3];
+                x0[(h << 2) + 0] = X[4];
+                x0[(h << 2) + 1] = X[5];
+                x0[(h << 1) * 3 + 0] = X[6];
+                x0[(h << 1) * 3 + 1] = X[7];
+            }
         }
-    } while(w > x);
-}
-//---------------------------------------------------------------------------------------------------------------------
-int32_t bitrev12(int32_t x) {
-    uint8_t bitrev[16] = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
-    return bitrev[x >> 8] | (bitrev[(x & 0x0f0) >> 4] << 4) | (((int32_t)bitrev[x & 0x00f]) << 8);
-}
-//---------------------------------------------------------------------------------------------------------------------
-void mdct_step7(int32_t *x, int32_t n, int32_t step) {
-    int32_t       *w0 = x;
-    int32_t       *w1 = x + (n >> 1);
-    const int32_t *T = (step >= 4) ? (sincos_lookup0 + (step >> 1)) : sincos_lookup1;
-    const int32_t *Ttop = T + 1024;
-    int32_t        r0, r1, r2, r3;
-
-    do {
-        w1 -= 2;
-
-        r0 = w0[0] + w1[0];
-        r1 = w1[1] - w0[1];
-        r2 = MULT32(r0, T[1]) + MULT32(r1, T[0]);
-        r3 = MULT32(r1, T[1]) - MULT32(r0, T[0]);
-        T += step;
-
-        r0 = (w0[1] + w1[1]) >> 1;
-        r1 = (w0[0] - w1[0]) >> 1;
-        w0[0] = r0 + r2;
-        w0[1] = r1 + r3;
-        w1[0] = r0 - r2;
-        w1[1] = r3 - r1;
-
-        w0 += 2;
-    } while(T < Ttop);
-    do {
-        w1 -= 2;
-
-        r0 = w0[0] + w1[0];
-        r1 = w1[1] - w0[1];
-        T -= step;
-        r2 = MULT32(r0, T[0]) + MULT32(r1, T[1]);
-        r3 = MULT32(r1, T[0]) - MULT32(r0, T[1]);
-
-        r0 = (w0[1] + w1[1]) >> 1;
-        r1 = (w0[0] - w1[0]) >> 1;
-        w0[0] = r0 + r2;
-        w0[1] = r1 + r3;
-        w1[0] = r0 - r2;
-        w1[1] = r3 - r1;
-
-        w0 += 2;
-    } while(w0 < w1);
+    }
 }
 //---------------------------------------------------------------------------------------------------------------------
-void mdct_step8(int32_t *x, int32_t n, int32_t step) {
-    const int32_t *T;
-    const int32_t *V;
-    int32_t       *iX = x + (n >> 1);
-    step >>= 2;
+/* last FFT pass, then y = conj-swapped Z[m] * e^(-i 2pi(m + 1/8) / n): the real part goes to out[2m], the imaginary
+   part to out[2(points - 1 - m) + 1] */
+void mdct_postrotate(VORBISDecoder_t* vd, int32_t *x, int32_t *out, int32_t points, const int32_t *T) {
+    const int32_t *W = vd->dsp_state->ffttwiddle;
+    int32_t        step = ((vd->blocksizes[1] >> 2) / points) << 1;
+    int32_t        h = points >> 2;
+    int32_t       *oX = out + (points << 1) - 1;
+    int32_t        k, q, m, X[8];
 
-    switch(step) {
-        default:
-            T = (step >= 4) ? (sincos_lookup0 + (step >> 1)) : sincos_lookup1;
-            do {
-                int32_t r0 = x[0];
-                int32_t r1 = -x[1];
-                XPROD31(r0, r1, T[0], T[1], x, x + 1);
-                T += step;
-                x += 2;
-            } while(x < iX);
-            break;
-
-        case 1: {
-            /* linear interpolation between table values: offset=0.5, step=1 */
-            int32_t t0, t1, v0, v1, r0, r1;
-            T = sincos_lookup0;
-            V = sincos_lookup1;
-            t0 = (*T++) >> 1;
-            t1 = (*T++) >> 1;
-            do {
-                r0 = x[0];
-                r1 = -x[1];
-                t0 += (v0 = (*V++) >> 1);
-                t1 += (v1 = (*V++) >> 1);
-                XPROD31(r0, r1, t0, t1, x, x + 1);
-
-                r0 = x[2];
-                r1 = -x[3];
-                v0 += (t0 = (*T++) >> 1);
-                v1 += (t1 = (*T++) >> 1);
-                XPROD31(r0, r1, v0, v1, x + 2, x + 3);
-
-                x += 4;
-            } while(x < iX);
-            break;
-        }
-
-        case 0: {
-            /* linear interpolation between table values: offset=0.25, step=0.5 */
-            int32_t t0, t1, v0, v1, q0, q1, r0, r1;
-            T = sincos_lookup0;
-            V = sincos_lookup1;
-            t0 = *T++;
-            t1 = *T++;
-            do {
-                v0 = *V++;
-                v1 = *V++;
-                t0 += (q0 = (v0 - t0) >> 2);
-                t1 += (q1 = (v1 - t1) >> 2);
-                r0 = x[0];
-                r1 = -x[1];
-                XPROD31(r0, r1, t0, t1, x, x + 1);
-                t0 = v0 - q0;
-                t1 = v1 - q1;
-                r0 = x[2];
-                r1 = -x[3];
-                XPROD31(r0, r1, t0, t1, x + 2, x + 3);
-
-                t0 = *T++;
-                t1 = *T++;
-                v0 += (q0 = (t0 - v0) >> 2);
-                v1 += (q1 = (t1 - v1) >> 2);
-                r0 = x[4];
-                r1 = -x[5];
-                XPROD31(r0, r1, v0, v1, x + 4, x + 5);
-                v0 = t0 - q0;
-                v1 = t1 - q1;
-                r0 = x[6];
-                r1 = -x[7];
-                XPROD31(r0, r1, v0, v1, x + 5, x + 6);
-
-                x += 8;
-            } while(x < iX);
-            break;
+    for(k = 0; k < h; k++) {
+        const int32_t *W1 = W + k * step;
+        mdct_fft_bfly4(x + (k << 1), h, W1, W1 + k * step, W1 + 2 * k * step, X);
+        for(q = 0, m = k; q < 8; q += 2, m += h) {
+            XNPROD31(X[q + 1], X[q], T[m << 1], T[(m << 1) + 1], &out[m << 1], &oX[-(m << 1)]);
         }
     }
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* decode vector / dim granularity guarding is done in the upper layer */
-int32_t vorbis_book_decodevv_add(codebook_t *book, int32_t **a, int32_t offset, uint8_t ch, int32_t n, int32_t point) {
+int32_t vorbis_book_decodevv_add(VORBISDecoder_t* vd, codebook_t *book, int32_t **a, int32_t offset, uint8_t ch, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
         int32_t  i;
@@ -3155,7 +2908,7 @@ int32_t vorbis_book_decodevv_add(codebook_t *book, int32_t **a, int32_t offset,
         int32_t  m = offset + n;
 
         for(i = offset; i < m;) {
-            if(decode_map(book, v, point)) return -1;
+            if(decode_map(vd, book, v, point)) return -1;
             for(uint8_t j = 0; i < m && j < book->dim; j++) {
                 a[chptr++][i] += v[j];
                 if(chptr == ch) {
@@ -3170,9 +2923,9 @@ int32_t vorbis_book_decodevv_add(codebook_t *book, int32_t **a, int32_t offset,
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* pcm==0 indicates we just want the pending samples, no more */
-int32_t vorbis_dsp_pcmout(int16_t *outBuff, int32_t outBuffSize) {
-    if(s_dsp_state->out_begin > -1 && s_dsp_state->out_begin < s_dsp_state->out_end) {
-        int32_t n = s_dsp_state->out_end - s_dsp_state->out_begin;
+int32_t vorbis_dsp_pcmout(VORBISDecoder_t* vd, int16_t *outBuff, int32_t outBuffSize) {
+    if(vd->dsp_state->out_begin > -1 && vd->dsp_state->out_begin < vd->dsp_state->out_end) {
+        int32_t n = vd->dsp_state->out_end - vd->dsp_state->out_begin;
 
         if(outBuff) {
             int32_t i;
@@ -3180,14 +2933,14 @@ int32_t vorbis_dsp_pcmout(int16_t *outBuff, int32_t outBuffSize) {
                 n = outBuffSize;
                 log_e("outBufferSize too small, must be min %i (int16_t) words", n);
             }
-            for(i = 0; i < s_vorbisChannels; i++){
-                mdct_unroll_lap(s_blocksizes[0], s_blocksizes[1],
-                                s_dsp_state->lW, s_dsp_state->W, s_dsp_state->work[i],
-                                s_dsp_state->mdctright[i], _vorbis_window(s_blocksizes[0] >> 1),
-                                _vorbis_window(s_blocksizes[1] >> 1),
-                                outBuff + i, s_vorbisChannels,
-                                s_dsp_state->out_begin,
-                                s_dsp_state->out_begin + n);
+            for(i = 0; i < vd->vorbisChannels; i++){
+                mdct_unroll_lap(vd->blocksizes[0], vd->blocksizes[1],
+                                vd->dsp_state->lW, vd->dsp_state->W, vd->dsp_state->work[i],
+                                vd->dsp_state->mdctright[i], _vorbis_window(vd->blocksizes[0] >> 1),
+                                _vorbis_window(vd->blocksizes[1] >> 1),
+                                outBuff + i, vd->vorbisChannels,
+                                vd->dsp_state->out_begin,
+                                vd->dsp_state->out_begin + n);
             }
         }
         return (n);
@@ -3221,7 +2974,7 @@ int32_t *_vorbis_window(int32_t left) {
 void mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t *in, int32_t *right, const int32_t *w0, const int32_t *w1, int16_t *out,
                      int32_t step, int32_t start, /* samples, this frame */
                      int32_t end /* samples, this frame */) {
-    int32_t       *l = in + (W && lW ? n1 >> 1 : n0 >> 1);
+    int32_t       *l = in + (W && lW ? n1 >> 2 : n0 >> 2);
     int32_t       *r = right + (lW ? n1 >> 2 : n0 >> 2);
     int32_t       *post;
     const int32_t *wR = (W && lW ? w1 + (n1 >> 1) : w0 + (n0 >> 1));
@@ -3251,14 +3004,13 @@ void mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t *in,
     off = (start < halfLap ? start : halfLap);
     post = r - n;
     r -= off;
-    l -= off * 2;
+    l -= off;
     start -= off;
     wR -= off;
     wL += off;
     end -= n;
     while(r > post) {
-        l -= 2;
-        *out = CLIP_TO_15((MULT31(*--r, *--wR) + MULT31(*l, *wL++)) >> 9);
+        *out = CLIP_TO_15((MULT31(*--r, *--wR) + MULT31(*--l, *wL++)) >> 9);
         out += step;
     }
 
@@ -3266,27 +3018,25 @@ void mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t *in,
     off = (start < halfLap ? start : halfLap);
     post = r + n;
     r += off;
-    l += off * 2;
+    l += off;
     start -= off;
     end -= n;
     wR -= off;
     wL += off;
     while(r < post) {
-        *out = CLIP_TO_15((MULT31(*r++, *--wR) - MULT31(*l, *wL++)) >> 9);
+        *out = CLIP_TO_15((MULT31(*r++, *--wR) - MULT31(*l++, *wL++)) >> 9);
         out += step;
-        l += 2;
     }
 
     /* preceeding direct-copy lapping from previous frame, if any */
     if(postLap) {
         n = (end < postLap ? end : postLap);
         off = (start < postLap ? start : postLap);
-        post = l + n * 2;
-        l += off * 2;
+        post = l + n;
+        l += off;
         while(l < post) {
-            *out = CLIP_TO_15((-*l) >> 9);
+            *out = CLIP_TO_15((-*l++) >> 9);
             out += step;
-            l += 2;
         }
     }
 }
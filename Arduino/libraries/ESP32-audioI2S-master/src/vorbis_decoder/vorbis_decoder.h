@@ -28,6 +28,7 @@
 
 #include "Arduino.h"
 #include <vector>
+#include "../ogg_demuxer/ogg_demuxer.h"
 using namespace std;
 #define VI_FLOORB       2
 #define VIF_POSIT      63
@@ -52,9 +53,6 @@ using namespace std;
 #define COS_LOOKUP_I_MASK    511
 #define COS_LOOKUP_I_SZ      128
 
-#define cPI3_8 (0x30fbc54d)
-#define cPI2_8 (0x5a82799a)
-#define cPI1_8 (0x7641af3d)
 
 enum : int8_t  {VORBIS_CONTINUE = 110,
                 VORBIS_PARSE_OGG_DONE = 100,
@@ -159,6 +157,9 @@ typedef struct _vorbis_dsp_state{  // vorbis_dsp_state buffers the current vorbi
 //    oggpack_buffer_t opb;
     int32_t        **work;
     int32_t        **mdctright;
+    int32_t         *mdcttrig[2]; // pre- and post-rotation of the short and long block MDCT
+    int32_t         *ffttwiddle;  // twiddles of the n/4 point FFT, for both blocksizes
+    int32_t         *mdctbuf;     // FFT work buffer, n/2 values
     int32_t              out_begin;
     int32_t              out_end;
     int32_t          lW;        // last window
@@ -216,62 +217,119 @@ inline int32_t CLIP_TO_15(int32_t x) {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+typedef struct VORBISDecoder_t {  // complete state of one decoder instance, see VORBISDecoder_AllocateBuffers()
+    bool                   f_vorbisNewSteamTitle = false; // streamTitle
+    bool                   f_vorbisNewMetadataBlockPicture = false;
+    bool                   f_oggFirstPage = false;
+    bool                   f_oggContinuedPage = false;
+    bool                   f_oggLastPage = false;
+    bool                   f_oggLastPacketContinues = false;
+    bool                   f_parseOggDone = true;
+    bool                   f_lastSegmentTable = false;
+    bool                   f_vorbisStr_found = false;
+    uint16_t               identificatonHeaderLength = 0;
+    uint16_t               vorbisCommentHeaderLength = 0;
+    uint16_t               setupHeaderLength = 0;
+    uint8_t                pageNr = 0;
+    uint16_t               oggHeaderSize = 0;
+    uint8_t                vorbisChannels = 0;
+    uint16_t               vorbisSamplerate = 0;
+    uint16_t               lastSegmentTableLen = 0;
+    uint8_t*               lastSegmentTable = NULL;
+    uint32_t               vorbisBitRate = 0;
+    uint32_t               vorbisSegmentLength = 0;
+    uint32_t               vorbisBlockPicLenUntilFrameEnd = 0;
+    uint32_t               vorbisCurrentFilePos = 0;
+    uint32_t               vorbisAudioDataStart = 0;
+    char*                  vorbisChbuf = NULL;
+    int32_t                vorbisValidSamples = 0;
+    int32_t                commentBlockSegmentSize = 0;
+    uint8_t                vorbisOldMode = 0;
+    uint32_t               blocksizes[2] = {0};
+    uint32_t               vorbisBlockPicPos = 0;
+    uint32_t               vorbisBlockPicLen = 0;
+    int32_t                vorbisRemainBlockPicLen = 0;
+    int32_t                commentLength = 0;
+    uint8_t                nrOfCodebooks = 0;
+    uint8_t                nrOfFloors = 0;
+    uint8_t                nrOfResidues = 0;
+    uint8_t                nrOfMaps = 0;
+    uint8_t                nrOfModes = 0;
+    uint16_t*              vorbisSegmentTable = NULL;
+    uint16_t               oggPage3Len = 0; // length of the current audio segment
+    uint8_t                vorbisSegmentTableSize = 0;
+    int16_t                vorbisSegmentTableRdPtr = -1;
+    int8_t                 vorbisError = 0;
+    float                  vorbisCompressionRatio = 0;
+    oggCrc_t               oggCrc = {}; // CRC of the current Ogg page if it is bigger than the input window
+    bitReader_t            bitReaderState = {};
+    codebook_t*            codebooks = NULL;
+    vorbis_info_floor_t**  floor_param = NULL;
+    int8_t*                floor_type = NULL;
+    vorbis_info_residue_t* residue_param = NULL;
+    vorbis_info_mapping_t* map_param = NULL;
+    vorbis_info_mode_t*    mode_param = NULL;
+    vorbis_dsp_state_t*    dsp_state = NULL;
+    vector<uint32_t>       vorbisBlockPicItem;
+}VORBISDecoder_t;
+
 // ogg impl
-bool                  VORBISDecoder_AllocateBuffers();
-void                  VORBISDecoder_FreeBuffers();
-void                  VORBISDecoder_ClearBuffers();
-void                  VORBISsetDefaults();
-void                  clearGlobalConfigurations();
-int32_t               VORBISDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-uint8_t               VORBISGetChannels();
-uint32_t              VORBISGetSampRate();
-uint32_t              VORBISGetAudioDataStart();
+VORBISDecoder_t*      VORBISDecoder_AllocateBuffers();
+void                  VORBISDecoder_FreeBuffers(VORBISDecoder_t* vd);
+void                  VORBISDecoder_ClearBuffers(VORBISDecoder_t* vd);
+void                  VORBISsetDefaults(VORBISDecoder_t* vd);
+void                  clearGlobalConfigurations(VORBISDecoder_t* vd);
+int32_t               VORBISDecode(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+int32_t               vorbisDecode(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+uint8_t               VORBISGetChannels(VORBISDecoder_t* vd);
+uint32_t              VORBISGetSampRate(VORBISDecoder_t* vd);
+uint32_t              VORBISGetAudioDataStart(VORBISDecoder_t* vd);
 uint8_t               VORBISGetBitsPerSample();
-uint32_t              VORBISGetBitRate();
-uint16_t              VORBISGetOutputSamps();
-char*                 VORBISgetStreamTitle();
-vector<uint32_t>      VORBISgetMetadataBlockPicture();
+uint32_t              VORBISGetBitRate(VORBISDecoder_t* vd);
+uint16_t              VORBISGetOutputSamps(VORBISDecoder_t* vd);
+char*                 VORBISgetStreamTitle(VORBISDecoder_t* vd);
+vector<uint32_t>      VORBISgetMetadataBlockPicture(VORBISDecoder_t* vd);
 int32_t               VORBISFindSyncWord(unsigned char* buf, int32_t nBytes);
-int32_t               VORBISparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
-int32_t               vorbisDecodePage1(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t               vorbisDecodePage2(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t               vorbisDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t               vorbisDecodePage4(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf);
-int32_t               parseVorbisComment(uint8_t* inbuf, int16_t nBytes);
-int32_t               parseVorbisCodebook();
-int32_t               parseVorbisFirstPacket(uint8_t* inbuf, int16_t nBytes);
-uint16_t              continuedOggPackets(uint8_t* inbuf);
-int32_t               vorbis_book_unpack(codebook_t* s);
-uint32_t              decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t* b, int32_t maptype);
-int32_t               oggpack_eop();
-vorbis_info_floor_t*  floor0_info_unpack();
-vorbis_info_floor_t*  floor1_info_unpack();
-int32_t               res_unpack(vorbis_info_residue_t* info);
-int32_t               mapping_info_unpack(vorbis_info_mapping_t* info);
+int32_t               VORBISparseOGG(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft);
+int32_t               vorbisDecodePage1(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+int32_t               vorbisDecodePage2(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+int32_t               vorbisDecodePage3(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+int32_t               vorbisDecodePage4(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf);
+int32_t               parseVorbisComment(VORBISDecoder_t* vd, uint8_t* inbuf, int16_t nBytes);
+int32_t               parseVorbisCodebook(VORBISDecoder_t* vd);
+int32_t               parseVorbisFirstPacket(VORBISDecoder_t* vd, uint8_t* inbuf, int16_t nBytes);
+uint8_t*              vorbisJoinContinuedPacket(VORBISDecoder_t* vd, uint8_t* inbuf, int32_t* bytesLeft, uint32_t* segmentLength);
+int32_t               vorbis_book_unpack(VORBISDecoder_t* vd, codebook_t* s);
+uint32_t              decpack(VORBISDecoder_t* vd, int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t* b, int32_t maptype);
+int32_t               oggpack_eop(VORBISDecoder_t* vd);
+vorbis_info_floor_t*  floor0_info_unpack(VORBISDecoder_t* vd);
+vorbis_info_floor_t*  floor1_info_unpack(VORBISDecoder_t* vd);
+int32_t               res_unpack(VORBISDecoder_t* vd, vorbis_info_residue_t* info);
+int32_t               mapping_info_unpack(VORBISDecoder_t* vd, vorbis_info_mapping_t* info);
 void                  vorbis_mergesort(uint8_t* index, uint16_t* vals, uint16_t n);
 void                  floor_free_info(vorbis_info_floor_t* i);
 void                  res_clear_info(vorbis_info_residue_t* info);
 void                  mapping_clear_info(vorbis_info_mapping_t* info);
 // vorbis decoder impl
-int32_t               vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf);
-vorbis_dsp_state_t*   vorbis_dsp_create();
-void                  vorbis_dsp_destroy(vorbis_dsp_state_t* v);
+int32_t               vorbis_dsp_synthesis(VORBISDecoder_t* vd, uint8_t* inbuf, uint16_t len, int16_t* outbuf);
+vorbis_dsp_state_t*   vorbis_dsp_create(VORBISDecoder_t* vd);
+void                  vorbis_dsp_destroy(VORBISDecoder_t* vd, vorbis_dsp_state_t* v);
 void                  mdct_shift_right(int32_t n, int32_t* in, int32_t* right);
-int32_t               mapping_inverse(vorbis_info_mapping_t* info);
+int32_t               mapping_inverse(VORBISDecoder_t* vd, vorbis_info_mapping_t* info);
 int32_t               floor0_memosize(vorbis_info_floor_t* i);
 int32_t               floor1_memosize(vorbis_info_floor_t* i);
-int32_t*              floor0_inverse1(vorbis_info_floor_t* i, int32_t* lsp);
-int32_t*              floor1_inverse1(vorbis_info_floor_t* in, int32_t* fit_value);
-int32_t               vorbis_book_decode(codebook_t* book);
-int32_t               decode_packed_entry_number(codebook_t* book);
+int32_t*              floor0_inverse1(VORBISDecoder_t* vd, vorbis_info_floor_t* i, int32_t* lsp);
+int32_t*              floor1_inverse1(VORBISDecoder_t* vd, vorbis_info_floor_t* in, int32_t* fit_value);
+int32_t               vorbis_book_decode(VORBISDecoder_t* vd, codebook_t* book);
+int32_t               decode_packed_entry_number(VORBISDecoder_t* vd, codebook_t* book);
 int32_t               render_point(int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t x);
-int32_t               vorbis_book_decodev_set(codebook_t* book, int32_t* a, int32_t n, int32_t point);
-int32_t               decode_map(codebook_t* s, int32_t* v, int32_t point);
-int32_t               res_inverse(vorbis_info_residue_t* info, int32_t** in, int32_t* nonzero, uint8_t ch);
-int32_t               vorbis_book_decodev_add(codebook_t* book, int32_t* a, int32_t n, int32_t point);
-int32_t               vorbis_book_decodevs_add(codebook_t* book, int32_t* a, int32_t n, int32_t point);
-int32_t               floor0_inverse2(vorbis_info_floor_t* i, int32_t* lsp, int32_t* out);
-int32_t               floor1_inverse2(vorbis_info_floor_t* in, int32_t* fit_value, int32_t* out);
+int32_t               vorbis_book_decodev_set(VORBISDecoder_t* vd, codebook_t* book, int32_t* a, int32_t n, int32_t point);
+int32_t               decode_map(VORBISDecoder_t* vd, codebook_t* s, int32_t* v, int32_t point);
+int32_t               res_inverse(VORBISDecoder_t* vd, vorbis_info_residue_t* info, int32_t** in, int32_t* nonzero, uint8_t ch);
+int32_t               vorbis_book_decodev_add(VORBISDecoder_t* vd, codebook_t* book, int32_t* a, int32_t n, int32_t point);
+int32_t               vorbis_book_decodevs_add(VORBISDecoder_t* vd, codebook_t* book, int32_t* a, int32_t n, int32_t point);
+int32_t               floor0_inverse2(VORBISDecoder_t* vd, vorbis_info_floor_t* i, int32_t* lsp, int32_t* out);
+int32_t               floor1_inverse2(VORBISDecoder_t* vd, vorbis_info_floor_t* in, int32_t* fit_value, int32_t* out);
 void                  render_line(int32_t n, int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t* d);
 void                  vorbis_lsp_to_curve(int32_t* curve, int32_t n, int32_t ln, int32_t* lsp, int32_t m, int32_t amp, int32_t ampoffset, int32_t nyq);
 int32_t               toBARK(int32_t n);
@@ -279,36 +337,32 @@ int32_t               vorbis_coslook_i(int32_t a);
 int32_t               vorbis_coslook2_i(int32_t a);
 int32_t               vorbis_fromdBlook_i(int32_t a);
 int32_t               vorbis_invsqlook_i(int32_t a, int32_t e);
-void                  mdct_backward(int32_t n, int32_t* in);
-void                  presymmetry(int32_t* in, int32_t n2, int32_t step);
-void                  mdct_butterflies(int32_t* x, int32_t points, int32_t shift);
-void                  mdct_butterfly_generic(int32_t* x, int32_t points, int32_t step);
-void                  mdct_butterfly_32(int32_t* x);
-void                  mdct_butterfly_16(int32_t* x);
-void                  mdct_butterfly_8(int32_t* x);
-void                  mdct_bitreverse(int32_t* x, int32_t n, int32_t shift);
-int32_t               bitrev12(int32_t x);
-void                  mdct_step7(int32_t* x, int32_t n, int32_t step);
-void                  mdct_step8(int32_t* x, int32_t n, int32_t step);
-int32_t               vorbis_book_decodevv_add(codebook_t* book, int32_t** a, int32_t offset, uint8_t ch, int32_t n, int32_t point);
-int32_t               vorbis_dsp_pcmout(int16_t* outBuff, int32_t outBuffSize);
+void                  mdct_sincos(int32_t t, int32_t* s, int32_t* c);
+int32_t*              mdct_trig_init(int32_t n);
+int32_t*              mdct_fft_init(int32_t points);
+void                  mdct_backward(VORBISDecoder_t* vd, int32_t n, int32_t* in);
+void                  mdct_prerotate(const int32_t* in, int32_t* x, int32_t points, const int32_t* T);
+void                  mdct_fft(VORBISDecoder_t* vd, int32_t* x, int32_t points);
+void                  mdct_postrotate(VORBISDecoder_t* vd, int32_t* x, int32_t* out, int32_t points, const int32_t* T);
+int32_t               vorbis_book_decodevv_add(VORBISDecoder_t* vd, codebook_t* book, int32_t** a, int32_t offset, uint8_t ch, int32_t n, int32_t point);
+int32_t               vorbis_dsp_pcmout(VORBISDecoder_t* vd, int16_t* outBuff, int32_t outBuffSize);
 void                  mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t* in, int32_t* right, const int32_t* w0, const int32_t* w1, int16_t* out, int32_t step, int32_t start, /* samples, this frame */
                                 int32_t end /* samples, this frame */);
 
 // some helper functions
 int32_t  VORBIS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
-void     bitReader_clear();
-void     bitReader_setData(uint8_t *buff, uint16_t buffSize);
-int32_t  bitReader(uint16_t bits);
-int32_t  bitReader_look(uint16_t nBits);
-int8_t   bitReader_adv(uint16_t bits);
+void     bitReader_clear(VORBISDecoder_t* vd);
+void     bitReader_setData(VORBISDecoder_t* vd, uint8_t *buff, uint16_t buffSize);
+int32_t  bitReader(VORBISDecoder_t* vd, uint16_t bits);
+int32_t  bitReader_look(VORBISDecoder_t* vd, uint16_t nBits);
+int8_t   bitReader_adv(VORBISDecoder_t* vd, uint16_t bits);
 uint8_t  _ilog(uint32_t v);
 int32_t  ilog(uint32_t v);
 int32_t  _float32_unpack(int32_t val, int32_t *point);
 int32_t  _determine_node_bytes(uint32_t used, uint8_t leafwidth);
 int32_t  _determine_leaf_words(int32_t nodeb, int32_t leafwidth);
-int32_t  _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype);
-int32_t  _make_words(char *l, uint16_t n, uint32_t *r, uint8_t quantvals, codebook_t *b, int32_t maptype);
+int32_t  _make_decode_table(VORBISDecoder_t* vd, codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype);
+int32_t  _make_words(VORBISDecoder_t* vd, char *l, uint16_t n, uint32_t *r, uint8_t quantvals, codebook_t *b, int32_t maptype);
 uint8_t  _book_maptype1_quantvals(codebook_t *b);
 void     vorbis_book_clear(codebook_t *b);
 int32_t *_vorbis_window(int32_t left);